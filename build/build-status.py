@@ -0,0 +1,8 @@
+#! /usr/bin/env python
+
+# Programs that are runnable.
+ns3_runnable_programs = ['build/src/bridge/examples/ns3.25-csma-bridge-debug', 'build/src/bridge/examples/ns3.25-csma-bridge-one-hop-debug', 'build/src/config-store/examples/ns3.25-config-store-save-debug', 'build/src/core/examples/ns3.25-main-callback-debug', 'build/src/core/examples/ns3.25-sample-simulator-debug', 'build/src/core/examples/ns3.25-main-ptr-debug', 'build/src/core/examples/ns3.25-main-random-variable-debug', 'build/src/core/examples/ns3.25-main-random-variable-stream-debug', 'build/src/core/examples/ns3.25-sample-random-variable-debug', 'build/src/core/examples/ns3.25-sample-random-variable-stream-debug', 'build/src/core/examples/ns3.25-command-line-example-debug', 'build/src/core/examples/ns3.25-hash-example-debug', 'build/src/core/examples/ns3.25-main-test-sync-debug', 'build/src/csma/examples/ns3.25-csma-one-subnet-debug', 'build/src/csma/examples/ns3.25-csma-broadcast-debug', 'build/src/csma/examples/ns3.25-csma-packet-socket-debug', 'build/src/csma/examples/ns3.25-csma-multicast-debug', 'build/src/csma/examples/ns3.25-csma-raw-ip-socket-debug', 'build/src/csma/examples/ns3.25-csma-ping-debug', 'build/src/energy/examples/ns3.25-li-ion-energy-source-debug', 'build/src/energy/examples/ns3.25-rv-battery-model-test-debug', 'build/src/energy/examples/ns3.25-basic-energy-model-test-debug', 'build/src/internet/examples/ns3.25-main-simple-debug', 'build/src/mipv6/examples/ns3.25-mipv6-single-debug', 'build/src/mipv6/examples/ns3.25-mipv6-multiple-debug', 'build/src/mipv6/examples/ns3.25-mipv6-wifi-wimax-debug', 'build/src/mipv6/examples/ns3.25-mipv6-mcoa-goodput-debug', 'build/src/mipv6/examples/ns3.25-mipv6-sweep-debug', 'build/src/mobility/examples/ns3.25-main-grid-topology-debug', 'build/src/mobility/examples/ns3.25-main-random-topology-debug', 'build/src/mobility/examples/ns3.25-main-random-walk-debug', 'build/src/mobility/examples/ns3.25-mobility-trace-example-debug', 'build/src/mobility/examples/ns3.25-ns2-mobility-trace-debug', 'build/src/mobility/examples/ns3.25-bonnmotion-ns2-example-debug', 'build/src/mpi/examples/ns3.25-third-distributed-debug', 'build/src/network/examples/ns3.25-main-packet-header-debug', 'build/src/network/examples/ns3.25-main-packet-tag-debug', 'build/src/network/examples/ns3.25-packet-socket-apps-debug', 'build/src/point-to-point/examples/ns3.25-main-attribute-value-debug', 'build/src/propagation/examples/ns3.25-main-propagation-loss-debug', 'build/src/propagation/examples/ns3.25-jakes-propagation-model-example-debug', 'build/src/stats/examples/ns3.25-gnuplot-example-debug', 'build/src/stats/examples/ns3.25-double-probe-example-debug', 'build/src/stats/examples/ns3.25-time-probe-example-debug', 'build/src/stats/examples/ns3.25-gnuplot-aggregator-example-debug', 'build/src/stats/examples/ns3.25-gnuplot-helper-example-debug', 'build/src/stats/examples/ns3.25-file-aggregator-example-debug', 'build/src/stats/examples/ns3.25-file-helper-example-debug', 'build/src/traffic-control/examples/ns3.25-codel-vs-pfifo-basic-test-debug', 'build/src/traffic-control/examples/ns3.25-codel-vs-pfifo-asymmetric-debug', 'build/src/wifi/examples/ns3.25-wifi-phy-test-debug', 'build/src/wifi/examples/ns3.25-test-interference-helper-debug', 'build/src/wifi/examples/ns3.25-ideal-wifi-manager-example-debug', 'build/src/wifi/examples/ns3.25-minstrel-ht-wifi-manager-example-debug', 'build/src/wimax/examples/ns3.25-wimax-ipv4-debug', 'build/src/wimax/examples/ns3.25-wimax-multicast-debug', 'build/src/wimax/examples/ns3.25-wimax-simple-debug', 'build/examples/tcp/ns3.25-tcp-large-transfer-debug', 'build/examples/tcp/ns3.25-tcp-nsc-lfn-debug', 'build/examples/tcp/ns3.25-tcp-nsc-zoo-debug', 'build/examples/tcp/ns3.25-tcp-star-server-debug', 'build/examples/tcp/ns3.25-tcp-bulk-send-debug', 'build/examples/tcp/ns3.25-tcp-pcap-nanosec-example-debug', 'build/examples/energy/ns3.25-energy-model-example-debug', 'build/examples/energy/ns3.25-energy-model-with-harvesting-example-debug', 'build/examples/routing/ns3.25-dynamic-global-routing-debug', 'build/examples/routing/ns3.25-static-routing-slash32-debug', 'build/examples/routing/ns3.25-global-routing-slash32-debug', 'build/examples/routing/ns3.25-global-injection-slash32-debug', 'build/examples/routing/ns3.25-simple-alternate-routing-debug', 'build/examples/routing/ns3.25-mixed-global-routing-debug', 'build/examples/routing/ns3.25-simple-routing-ping6-debug', 'build/examples/routing/ns3.25-ripng-simple-network-debug', 'build/examples/routing/ns3.25-rip-simple-network-debug', 'build/examples/routing/ns3.25-global-routing-multi-switch-plus-router-debug', 'build/examples/stats/ns3.25-wifi-example-sim-debug', 'build/examples/udp-client-server/ns3.25-udp-client-server-debug', 'build/examples/udp-client-server/ns3.25-udp-trace-client-server-debug', 'build/examples/error-model/ns3.25-simple-error-model-debug', 'build/examples/wireless/ns3.25-wifi-adhoc-debug', 'build/examples/wireless/ns3.25-wifi-clear-channel-cmu-debug', 'build/examples/wireless/ns3.25-wifi-ap-debug', 'build/examples/wireless/ns3.25-wifi-wired-bridging-debug', 'build/examples/wireless/ns3.25-wifi-simple-adhoc-debug', 'build/examples/wireless/ns3.25-wifi-simple-infra-debug', 'build/examples/wireless/ns3.25-wifi-simple-interference-debug', 'build/examples/wireless/ns3.25-wifi-blockack-debug', 'build/examples/wireless/ns3.25-ofdm-validation-debug', 'build/examples/wireless/ns3.25-ofdm-ht-validation-debug', 'build/examples/wireless/ns3.25-ofdm-vht-validation-debug', 'build/examples/wireless/ns3.25-ht-wifi-network-debug', 'build/examples/wireless/ns3.25-vht-wifi-network-debug', 'build/examples/wireless/ns3.25-wifi-timing-attributes-debug', 'build/examples/wireless/ns3.25-wifi-sleep-debug', 'build/examples/wireless/ns3.25-wifi-aggregation-debug', 'build/examples/wireless/ns3.25-simple-ht-hidden-stations-debug', 'build/examples/wireless/ns3.25-80211n-mimo-debug', 'build/examples/wireless/ns3.25-mixed-bg-network-debug', 'build/examples/wireless/ns3.25-wifi-tcp-debug', 'build/examples/tutorial/ns3.25-hello-simulator-debug', 'build/examples/tutorial/ns3.25-first-debug', 'build/examples/tutorial/ns3.25-second-debug', 'build/examples/tutorial/ns3.25-third-debug', 'build/examples/tutorial/ns3.25-fourth-debug', 'build/examples/tutorial/ns3.25-fifth-debug', 'build/examples/tutorial/ns3.25-sixth-debug', 'build/examples/tutorial/ns3.25-seventh-debug', 'build/examples/udp/ns3.25-udp-echo-debug', 'build/examples/socket/ns3.25-socket-bound-static-routing-debug', 'build/examples/socket/ns3.25-socket-bound-tcp-static-routing-debug', 'build/examples/socket/ns3.25-socket-options-ipv4-debug', 'build/examples/socket/ns3.25-socket-options-ipv6-debug', 'build/examples/realtime/ns3.25-realtime-udp-echo-debug', 'build/examples/naming/ns3.25-object-names-debug', 'build/examples/ipv6/ns3.25-icmpv6-redirect-debug', 'build/examples/ipv6/ns3.25-ping6-debug', 'build/examples/ipv6/ns3.25-radvd-debug', 'build/examples/ipv6/ns3.25-radvd-two-prefix-debug', 'build/examples/ipv6/ns3.25-test-ipv6-debug', 'build/examples/ipv6/ns3.25-fragmentation-ipv6-debug', 'build/examples/ipv6/ns3.25-fragmentation-ipv6-two-MTU-debug', 'build/examples/ipv6/ns3.25-loose-routing-ipv6-debug', 'build/examples/traffic-control/ns3.25-traffic-control-debug', 'build/scratch/ns3.25-lena-ipv6-2-debug', 'build/scratch/ns3.25-dup-debug', 'build/scratch/ns3.25-third-debug', 'build/scratch/ns3.25-lena-ipv6-1-debug', 'build/scratch/ns3.25-lena-simple-epc-debug', 'build/scratch/ns3.25-lena-ipv6-3-debug', 'build/scratch/ns3.25-lena-ipv4-debug', 'build/scratch/ns3.25-second-debug', 'build/scratch/subdir/ns3.25-subdir-debug', 'build/scratch/ns3.25-test-radvd-debug', 'build/scratch/ns3.25-scratch-simulator-debug']
+
+# Scripts that are runnable.
+ns3_runnable_scripts = ['csma-bridge.py', 'sample-simulator.py', 'simple-routing-ping6.py', 'wifi-ap.py', 'first.py', 'second.py', 'third.py', 'realtime-udp-echo.py']
+
@@ -0,0 +1,76 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef CHUNK_SUCCESS_RATE_TABLE_H
+#define CHUNK_SUCCESS_RATE_TABLE_H
+
+#include <stdint.h>
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * \ingroup wifi
+ * \brief A table of the coded bit error rate of a modulation and coding
+ * scheme, giving the success rate of a chunk of bits by interpolation.
+ *
+ * The error rate models give the success rate of a chunk of n bits as
+ * (1 - pe)^n, where pe, the probability that a bit is in error after
+ * decoding, only depends on the signal to noise ratio (or Eb/No) for a
+ * given modulation and code. The table samples pe on a grid of ratios
+ * evenly spaced in dB, and stores ln (-ln (1 - pe)), which is nearly
+ * linear in dB, so that the interpolated success rate is within 2e-5 of
+ * the computed one. Where pe is above 0.1, and the chunks are almost
+ * surely lost, it is computed instead.
+ */
+class ChunkSuccessRateTable
+{
+public:
+  ChunkSuccessRateTable ();
+
+  /**
+   * \returns the number of points of the grid
+   */
+  static uint32_t GetNPoints (void);
+  /**
+   * \param i a point of the grid
+   * \returns its ratio (linear)
+   */
+  static double GetRatio (uint32_t i);
+  /**
+   * \returns true if no point was added
+   */
+  bool IsEmpty (void) const;
+  /**
+   * \param pe the bit error rate at the next point of the grid
+   */
+  void Add (double pe);
+  /**
+   * \param ratio a ratio (linear)
+   * \param nbits the number of bits of the chunk
+   * \param rate the probability that the chunk is received without error
+   * \returns true if the ratio is within the grid, and the bit error rate
+   * is at most 0.1 at the points around it, so that rate was interpolated
+   */
+  bool GetSuccessRate (double ratio, uint32_t nbits, double &rate) const;
+
+private:
+  std::vector<double> m_logLogs;  //!< ln (-ln (1 - pe)) at each point of the grid
+};
+
+} //namespace ns3
+
+#endif /* CHUNK_SUCCESS_RATE_TABLE_H */
@@ -0,0 +1,158 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2005,2006 INRIA
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Mathieu Lacage <mathieu.lacage@sophia.inria.fr>
+ */
+
+#ifndef DEFAULT_SIMULATOR_IMPL_H
+#define DEFAULT_SIMULATOR_IMPL_H
+
+#include "simulator-impl.h"
+#include "scheduler.h"
+#include "event-impl.h"
+#include "system-thread.h"
+#include "ns3/system-mutex.h"
+#include "mpsc-ring.h"
+
+#include "ptr.h"
+
+#include <list>
+
+/**
+ * \file
+ * \ingroup simulator
+ * Declaration of class ns3::DefaultSimulatorImpl.
+ */
+
+namespace ns3 {
+
+/**
+ * \ingroup simulator
+ *
+ * The default single process simulator implementation.
+ */
+class DefaultSimulatorImpl : public SimulatorImpl
+{
+public:
+  /**
+   *  Register this type.
+   *  \return The object TypeId.
+   */
+  static TypeId GetTypeId (void);
+
+  /** Constructor. */
+  DefaultSimulatorImpl ();
+  /** Destructor. */
+  ~DefaultSimulatorImpl ();
+
+  // Inherited
+  virtual void Destroy ();
+  virtual bool IsFinished (void) const;
+  virtual void Stop (void);
+  virtual void Stop (Time const &delay);
+  virtual EventId Schedule (Time const &delay, EventImpl *event);
+  virtual void ScheduleWithContext (uint32_t context, Time const &delay, EventImpl *event);
+  virtual EventId ScheduleNow (EventImpl *event);
+  virtual EventId ScheduleDestroy (EventImpl *event);
+  virtual void Remove (const EventId &id);
+  virtual void Cancel (const EventId &id);
+  virtual bool IsExpired (const EventId &id) const;
+  virtual void Run (void);
+  virtual Time Now (void) const;
+  virtual Time GetDelayLeft (const EventId &id) const;
+  virtual Time GetMaximumSimulationTime (void) const;
+  virtual void SetScheduler (ObjectFactory schedulerFactory);
+  virtual uint32_t GetSystemId (void) const; 
+  virtual uint32_t GetContext (void) const;
+
+private:
+  virtual void DoDispose (void);
+
+  /** Process the next event. */
+  void ProcessOneEvent (void);
+  /** Move events from a different context into the main event queue. */
+  void ProcessEventsWithContext (void);
+ 
+  /** Wrap an event with its execution context. */
+  struct EventWithContext {
+    /** The event context. */
+    uint32_t context;
+    /** Event timestamp. */
+    uint64_t timestamp;
+    /** The event implementation. */
+    EventImpl *event;
+  };
+  /**
+   * Insert an event from a different context in the main event queue.
+   *
+   * \param [in] event The event.
+   */
+  void InsertEventWithContext (const EventWithContext &event);
+  /** Capacity of the ring of events from a different context. */
+  static const uint32_t EVENTS_WITH_CONTEXT_RING = 1024;
+  /**
+   * The events from a different context. Other threads push to it
+   * without a lock, they are moved to the main event queue after
+   * each event.
+   */
+  MpscRing<struct EventWithContext> m_eventsWithContextRing;
+  /** Container type for the events from a different context. */
+  typedef std::list<struct EventWithContext> EventsWithContext;
+  /**
+   * The container of events from a different context, used when the
+   * ring is full.
+   */
+  EventsWithContext m_eventsWithContext;
+  /**
+   * Flag \c true if m_eventsWithContext holds events. While it is set,
+   * other threads keep adding to m_eventsWithContext, so that the
+   * events of a thread are inserted in order.
+   */
+  bool m_eventsWithContextOverflow;
+  /** Mutex to control access to the list of events with context. */
+  SystemMutex m_eventsWithContextMutex;
+
+  /** Container type for the events to run at Simulator::Destroy() */
+  typedef std::list<EventId> DestroyEvents;
+  /** The container of events to run at Destroy. */
+  DestroyEvents m_destroyEvents;
+  /** Flag calling for the end of the simulation. */
+  bool m_stop;
+  /** The event priority queue. */
+  Ptr<Scheduler> m_events;
+
+  /** Next event unique id. */
+  uint32_t m_uid;
+  /** Unique id of the current event. */
+  uint32_t m_currentUid;
+  /** Timestamp of the current event. */
+  uint64_t m_currentTs;
+  /** Execution context of the current event. */
+  uint32_t m_currentContext;
+  /**
+   * Number of events that have been inserted but not yet scheduled,
+   *  not counting the Destroy events; this is used for validation
+   */
+  int m_unscheduledEvents;
+
+  /** Main execution thread. */
+  SystemThread::ThreadId m_main;
+};
+
+} // namespace ns3
+
+#endif /* DEFAULT_SIMULATOR_IMPL_H */
@@ -0,0 +1,109 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#ifndef IPV6_GLOBAL_ROUTING_HELPER_H
+#define IPV6_GLOBAL_ROUTING_HELPER_H
+
+#include "ns3/node-container.h"
+#include "ns3/ipv6-routing-helper.h"
+
+namespace ns3 {
+
+/**
+ * \brief Helper class that computes the shortest paths between all the
+ * IPv6 nodes of the simulation and installs them as static routes.
+ *
+ * The topology is the graph of the channels: two interfaces are
+ * neighbors when their devices are attached to the same channel and
+ * both interfaces are up. The cost of a link is the metric of the
+ * outgoing interface. Each node gets a network route to the global
+ * prefixes which are not on one of its own links, towards the link-local
+ * address of the first hop. The routes to the two halves of a prefix
+ * which go through the same next hop are merged into a route to the
+ * prefix, unless the prefix is a network of its own, so that contiguous
+ * networks behind a router take a single route. Nodes which forward on
+ * none of their interfaces are hosts: they get routes, but are not used
+ * as transit.
+ *
+ * The routes are installed in the Ipv6StaticRouting of each node, either
+ * the main routing protocol or the one of an Ipv6ListRouting, so this
+ * helper can be used with the default InternetStackHelper.
+ */
+class Ipv6GlobalRoutingHelper : public Ipv6RoutingHelper
+{
+public:
+  /**
+   * \brief Constructor.
+   */
+  Ipv6GlobalRoutingHelper ();
+
+  /**
+   * \brief Construct an Ipv6GlobalRoutingHelper from another previously
+   * initialized instance (Copy Constructor).
+   */
+  Ipv6GlobalRoutingHelper (const Ipv6GlobalRoutingHelper &);
+
+  /**
+   * \returns pointer to clone of this Ipv6GlobalRoutingHelper
+   *
+   * This method is mainly for internal use by the other helpers;
+   * clients are expected to free the dynamic memory allocated by this method
+   */
+  Ipv6GlobalRoutingHelper* Copy (void) const;
+
+  /**
+   * \param node the node on which the routing protocol will run
+   * \returns a newly-created Ipv6StaticRouting, filled by
+   * PopulateRoutingTables ()
+   *
+   * This method will be called by ns3::InternetStackHelper::Install
+   */
+  virtual Ptr<Ipv6RoutingProtocol> Create (Ptr<Node> node) const;
+
+  /**
+   * \brief Compute the shortest paths over the current topology and
+   * install the routes in all the nodes of the simulation.
+   *
+   * The routes installed by a previous call are forgotten: this is
+   * meant to be called once, after the addresses are assigned. They are
+   * also forgotten when the simulator is destroyed.
+   */
+  static void PopulateRoutingTables (void);
+
+  /**
+   * \brief Compute the shortest paths over the current topology, and
+   * update the routes installed by PopulateRoutingTables () or by a
+   * previous call.
+   *
+   * Only the routes whose next hop, interface or metric changed are
+   * removed and added again, so this can be called whenever an
+   * interface goes up or down, or a metric changes. The routes the
+   * static routing dropped when their interface went down are installed
+   * again, even if the shortest paths are the same as before.
+   */
+  static void RecomputeRoutingTables (void);
+
+private:
+  /**
+   * \brief Assignment operator declared private and not implemented to disallow
+   * assignment and prevent the compiler from happily inserting its own.
+   * \return
+   */
+  Ipv6GlobalRoutingHelper &operator = (const Ipv6GlobalRoutingHelper &);
+};
+
+} // namespace ns3
+
+#endif /* IPV6_GLOBAL_ROUTING_HELPER_H */
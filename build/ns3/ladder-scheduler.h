@@ -0,0 +1,176 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef LADDER_SCHEDULER_H
+#define LADDER_SCHEDULER_H
+
+#include "scheduler.h"
+#include <stdint.h>
+#include <vector>
+
+class LadderSchedulerMemoryTestCase;
+
+/**
+ * \file
+ * \ingroup scheduler
+ * Declaration of ns3::LadderScheduler class.
+ */
+
+namespace ns3 {
+
+/**
+ * \ingroup scheduler
+ * \brief a ladder queue event scheduler
+ *
+ * This event scheduler is a direct implementation of the algorithm
+ * known as a ladder queue, described in "Ladder Queue: An O(1)
+ * Priority Queue Structure for Large-Scale Discrete Event Simulation",
+ * W. T. Tang, R. S. M. Goh and I. L.-J. Thng, ACM TOMACS 15(3), 2005.
+ *
+ * Events are held in three tiers:
+ *  - Top: an unsorted list of the events later than all the others,
+ *    only the minimum and maximum timestamps are tracked.
+ *  - the ladder: up to eight rungs of buckets. When the events of the
+ *    Top are needed, they are spread over the buckets of a first rung,
+ *    one bucket per event on average. A bucket holding more than 50
+ *    events when it is reached spawns a finer rung covering the bucket
+ *    instead of being sorted, so that the width of the buckets adapts
+ *    to the local density of the timestamps.
+ *  - Bottom: the sorted list of the earliest events, from which the
+ *    events are removed. Events with the same timestamp stay in the
+ *    order of their uid.
+ *
+ * Unlike CalendarScheduler, there is no global resize: a burst of
+ * close events only refines the part of the ladder it falls into.
+ * Insert and RemoveNext are O(1) amortized; Remove searches the
+ * bucket (or the Top or Bottom list) holding the event.
+ */
+class LadderScheduler : public Scheduler
+{
+public:
+  /**
+   *  Register this type.
+   *  \return The object TypeId.
+   */
+  static TypeId GetTypeId (void);
+
+  /** Constructor. */
+  LadderScheduler ();
+  /** Destructor. */
+  virtual ~LadderScheduler ();
+
+  // Inherited
+  virtual void Insert (const Scheduler::Event &ev);
+  virtual bool IsEmpty (void) const;
+  virtual Scheduler::Event PeekNext (void) const;
+  virtual Scheduler::Event RemoveNext (void);
+  virtual void Remove (const Scheduler::Event &ev);
+
+private:
+  friend class ::LadderSchedulerMemoryTestCase;
+
+  /** Maximum number of rungs. */
+  static const uint32_t MAX_RUNGS = 8;
+  /** A bucket or Bottom list larger than this spawns a new rung. */
+  static const uint32_t THRESHOLD = 50;
+
+  /** A rung of the ladder. */
+  struct Rung
+  {
+    uint64_t start;     /**< Timestamp of the start of the first bucket. */
+    uint64_t width;     /**< Width of the buckets. */
+    uint32_t current;   /**< Index of the first bucket not yet consumed. */
+    uint32_t nBuckets;  /**< Number of buckets in use. */
+    uint32_t count;     /**< Number of events in the rung. */
+    /** The buckets, unsorted. */
+    std::vector<std::vector<Scheduler::Event> > buckets;
+  };
+
+  /**
+   * Get the timestamp of the start of the current bucket of a rung:
+   * the rung holds no event earlier than this.
+   *
+   * \param [in] rung The rung.
+   * \returns The timestamp.
+   */
+  static uint64_t GetCurrent (const Rung &rung);
+  /**
+   * Find the rung an event belongs to.
+   *
+   * \param [in] ts The timestamp of the event.
+   * \returns The index of the rung, or m_nRungs if the event belongs
+   *          to the Bottom list.
+   */
+  uint32_t FindRung (uint64_t ts) const;
+  /**
+   * Spread events over the buckets of a new rung.
+   *
+   * \param [in] begin The first event.
+   * \param [in] end Past the last event.
+   * \param [in] start The start of the range of the new rung.
+   * \param [in] limit The end of the range of the new rung: all
+   *             the events are earlier than this.
+   * \returns The timestamp of the end of the last bucket.
+   */
+  uint64_t SpawnRung (const Scheduler::Event *begin, const Scheduler::Event *end,
+                      uint64_t start, uint64_t limit);
+  /**
+   * Insert an event in the Bottom list, keeping it sorted.
+   *
+   * \param [in] ev The event.
+   */
+  void InsertBottom (const Scheduler::Event &ev);
+  /**
+   * Sort events and make them the Bottom list.
+   *
+   * \param [in] events The events.
+   */
+  void SetBottom (std::vector<Scheduler::Event> &events);
+  /**
+   * Move the events of the Top to the ladder, or to the Bottom list if
+   * there are few of them.
+   */
+  void TransferTop (void);
+  /** Refill the Bottom list if it is empty. */
+  void FillBottom (void);
+
+  /** The Top list. */
+  std::vector<Scheduler::Event> m_top;
+  /** The earliest timestamp in the Top list. */
+  uint64_t m_topMin;
+  /** The latest timestamp in the Top list. */
+  uint64_t m_topMax;
+  /** Events at or after this timestamp go to the Top list. */
+  uint64_t m_topStart;
+  /** The rungs, m_rungs[0] is the coarsest. */
+  std::vector<Rung> m_rungs;
+  /** The number of rungs in use. */
+  uint32_t m_nRungs;
+  /**
+   * The Bottom list, sorted from m_bottomHead on. The events before
+   * m_bottomHead have been removed; they are dropped once they are more
+   * than the events left.
+   */
+  std::vector<Scheduler::Event> m_bottom;
+  /** The index of the first event of the Bottom list. */
+  uint32_t m_bottomHead;
+  /** The number of events in the scheduler. */
+  uint32_t m_size;
+};
+
+} // namespace ns3
+
+#endif /* LADDER_SCHEDULER_H */
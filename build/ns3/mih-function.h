@@ -0,0 +1,149 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MIH_FUNCTION_H
+#define MIH_FUNCTION_H
+
+#include <string>
+#include <vector>
+#include "ns3/object.h"
+#include "ns3/net-device.h"
+#include "ns3/traced-callback.h"
+
+namespace ns3 {
+
+class MihLinkAdapter;
+
+/**
+ * \brief MihFunction is a media independent event service, in the manner
+ * of the IEEE 802.21 event service. The link adapters of the devices of
+ * a node (see MihLinkAdapter) report to it, and the upper layers
+ * subscribe to its LinkEvent trace instead of to the traces of each
+ * technology:
+ *  - LINK_UP: a device associated with, registered with or connected to
+ *    its point of attachment,
+ *  - LINK_DOWN: it lost its point of attachment,
+ *  - LINK_GOING_DOWN: the link is up but its signal fell below the going
+ *    down threshold of the adapter,
+ *  - LINK_PARAMETERS_REPORT: the signal of the link crossed one of the
+ *    report thresholds of the adapter, or recovered after the link was
+ *    going down.
+ *
+ * The Mipv6Mn of the node subscribes to it when both are aggregated to
+ * the node (see MihHelper).
+ */
+class MihFunction : public Object
+{
+public:
+  /**
+   * Link events.
+   */
+  enum LinkEvent_e
+  {
+    LINK_UP = 0,
+    LINK_DOWN,
+    LINK_GOING_DOWN,
+    LINK_PARAMETERS_REPORT
+  };
+
+  /**
+   * \brief typeid
+   */
+  static TypeId GetTypeId ();
+
+  /**
+   * \brief constructor
+   */
+  MihFunction ();
+
+  /**
+   * \brief destructor
+   */
+  virtual ~MihFunction ();
+
+  /**
+   * \brief add the link adapter of a device, attached to this function.
+   * \param adapter the adapter
+   */
+  void AddLink (Ptr<MihLinkAdapter> adapter);
+
+  /**
+   * \brief get the number of links.
+   * \returns the number of links
+   */
+  uint32_t GetNLinks () const;
+
+  /**
+   * \brief get a link adapter.
+   * \param index the index of the adapter
+   * \returns the adapter
+   */
+  Ptr<MihLinkAdapter> GetLink (uint32_t index) const;
+
+  /**
+   * \brief get the link adapter of a device.
+   * \param device the device
+   * \returns the adapter, or 0 if the device has none
+   */
+  Ptr<MihLinkAdapter> GetLink (Ptr<NetDevice> device) const;
+
+  /**
+   * \brief notify an event of a link to the subscribers, called by the
+   * link adapters.
+   * \param event the event
+   * \param device the device of the link
+   * \param signal the last signal of the link, in the unit of its adapter
+   */
+  void NotifyLinkEvent (uint8_t event, Ptr<NetDevice> device, double signal);
+
+  /**
+   * \brief get the name of an event.
+   * \param event the event
+   * \returns the name
+   */
+  static std::string GetEventName (uint8_t event);
+
+  /**
+   * TracedCallback signature for link events.
+   *
+   * \param [in] event The event.
+   * \param [in] device The device of the link.
+   * \param [in] signal The last signal of the link, NaN if none was reported.
+   */
+  typedef void (* LinkEventTracedCallback)
+    (uint8_t event, Ptr<NetDevice> device, double signal);
+
+protected:
+  /**
+   * \brief Dispose this object.
+   */
+  virtual void DoDispose ();
+
+private:
+  /**
+   * \brief the link adapters.
+   */
+  std::vector<Ptr<MihLinkAdapter> > m_links;
+
+  /**
+   * \brief Callback to trace the link events.
+   */
+  TracedCallback<uint8_t, Ptr<NetDevice>, double> m_linkEventTrace;
+};
+
+} /* namespace ns3 */
+
+#endif /* MIH_FUNCTION_H */
@@ -0,0 +1,283 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MIH_LINK_ADAPTER_H
+#define MIH_LINK_ADAPTER_H
+
+#include <vector>
+#include "ns3/object.h"
+#include "ns3/net-device.h"
+#include "ns3/packet.h"
+#include "ns3/mac48-address.h"
+#include "ns3/wifi-phy.h"
+#include "mih-function.h"
+
+namespace ns3 {
+
+class StaWifiMac;
+
+/**
+ * \brief MihLinkAdapter turns the traces of a device into the link events
+ * of a MihFunction. The subclasses connect to the traces of one
+ * technology and call LinkUp (), LinkDown () and ReportSignal (); the
+ * going down and report thresholds are applied here, in the same way for
+ * all of them:
+ *  - LINK_GOING_DOWN is notified once when the signal of a link which is
+ *    up falls below GoingDownThreshold, and again only after the signal
+ *    went back above the threshold plus Hysteresis, or the link went up
+ *    again,
+ *  - LINK_PARAMETERS_REPORT is notified when two successive signals are
+ *    on both sides of a report threshold, and when the signal of a link
+ *    going down recovers.
+ */
+class MihLinkAdapter : public Object
+{
+public:
+  /**
+   * \brief typeid
+   */
+  static TypeId GetTypeId ();
+
+  /**
+   * \brief constructor
+   */
+  MihLinkAdapter ();
+
+  /**
+   * \brief destructor
+   */
+  virtual ~MihLinkAdapter ();
+
+  /**
+   * \brief connect to the traces of a device.
+   * \param mih the function notified of the events of the link
+   * \param device the device
+   * \returns whether the adapter supports the device, nothing is
+   * connected otherwise
+   */
+  bool Attach (Ptr<MihFunction> mih, Ptr<NetDevice> device);
+
+  /**
+   * \returns the device, or 0 if not attached
+   */
+  Ptr<NetDevice> GetDevice () const;
+
+  /**
+   * \returns whether the link is up
+   */
+  bool IsLinkUp () const;
+
+  /**
+   * \returns whether the link is going down
+   */
+  bool IsGoingDown () const;
+
+  /**
+   * \returns the last signal reported, NaN if none
+   */
+  double GetSignal () const;
+
+  /**
+   * \returns how far the last signal reported is above the going down
+   * threshold, NaN if none; unlike the signals, the margins of links of
+   * different technologies can be compared
+   */
+  double GetSignalMargin () const;
+
+  /**
+   * \param threshold the going down threshold, in the unit of the signal
+   */
+  void SetGoingDownThreshold (double threshold);
+
+  /**
+   * \returns the going down threshold
+   */
+  double GetGoingDownThreshold () const;
+
+  /**
+   * \brief add a threshold whose crossing is reported.
+   * \param threshold the threshold, in the unit of the signal
+   */
+  void AddReportThreshold (double threshold);
+
+protected:
+  /**
+   * \brief connect to the traces of a device.
+   * \param device the device
+   * \returns whether the adapter supports the device
+   */
+  virtual bool DoAttach (Ptr<NetDevice> device) = 0;
+
+  /**
+   * \brief Dispose this object.
+   */
+  virtual void DoDispose ();
+
+  /**
+   * \brief the link went up.
+   */
+  void LinkUp ();
+
+  /**
+   * \brief the link went down.
+   */
+  void LinkDown ();
+
+  /**
+   * \brief a new sample of the signal of the link.
+   * \param signal the signal
+   */
+  void ReportSignal (double signal);
+
+private:
+  /**
+   * \brief notify an event to the function.
+   * \param event the event
+   */
+  void Notify (uint8_t event);
+
+  /**
+   * \brief the function notified of the events.
+   */
+  Ptr<MihFunction> m_mih;
+
+  /**
+   * \brief the device.
+   */
+  Ptr<NetDevice> m_device;
+
+  /**
+   * \brief whether the link is up.
+   */
+  bool m_linkUp;
+
+  /**
+   * \brief whether LINK_GOING_DOWN was notified.
+   */
+  bool m_goingDown;
+
+  /**
+   * \brief the last signal, NaN if none.
+   */
+  double m_signal;
+
+  /**
+   * \brief the going down threshold.
+   */
+  double m_goingDownThreshold;
+
+  /**
+   * \brief the hysteresis of the going down threshold.
+   */
+  double m_hysteresis;
+
+  /**
+   * \brief the report thresholds.
+   */
+  std::vector<double> m_reportThresholds;
+};
+
+/**
+ * \brief The link adapter of a wifi station: the link is up while the
+ * station is associated, and the signal is the power (dBm) of the beacons
+ * of its access point.
+ */
+class MihWifiLinkAdapter : public MihLinkAdapter
+{
+public:
+  /**
+   * \brief typeid
+   */
+  static TypeId GetTypeId ();
+
+  MihWifiLinkAdapter ();
+  virtual ~MihWifiLinkAdapter ();
+
+protected:
+  virtual bool DoAttach (Ptr<NetDevice> device);
+  virtual void DoDispose ();
+
+private:
+  /**
+   * \brief the station associated.
+   * \param bssid the access point
+   */
+  void Assoc (Mac48Address bssid);
+
+  /**
+   * \brief the station lost its association.
+   * \param bssid the access point
+   */
+  void DeAssoc (Mac48Address bssid);
+
+  /**
+   * \brief a frame has been received by the PHY.
+   * \param packet the frame
+   * \param channelFreqMhz the frequency of the channel
+   * \param channelNumber the channel
+   * \param rate the rate
+   * \param preamble the preamble
+   * \param txVector the TX vector
+   * \param aMpdu the A-MPDU information
+   * \param signalNoise the signal and noise power, in dBm
+   */
+  void PhyRxSniffer (Ptr<const Packet> packet, uint16_t channelFreqMhz,
+                     uint16_t channelNumber, uint32_t rate, WifiPreamble preamble,
+                     WifiTxVector txVector, struct mpduInfo aMpdu,
+                     struct signalNoiseDbm signalNoise);
+
+  /**
+   * \brief the MAC of the station.
+   */
+  Ptr<StaWifiMac> m_mac;
+};
+
+/**
+ * \brief The link adapter of a WiMAX subscriber station: the link is up
+ * while the station is registered with its base station, and the signal
+ * is the SNR (dB) of the downlink bursts.
+ */
+class MihWimaxLinkAdapter : public MihLinkAdapter
+{
+public:
+  /**
+   * \brief typeid
+   */
+  static TypeId GetTypeId ();
+
+  MihWimaxLinkAdapter ();
+  virtual ~MihWimaxLinkAdapter ();
+
+protected:
+  virtual bool DoAttach (Ptr<NetDevice> device);
+
+private:
+  /**
+   * \brief the link of the device changed.
+   */
+  void LinkChanged ();
+
+  /**
+   * \brief a burst is being received.
+   * \param snr the SNR, in dB
+   * \param direction the direction of the burst
+   */
+  void RxSnr (double snr, uint8_t direction);
+};
+
+} /* namespace ns3 */
+
+#endif /* MIH_LINK_ADAPTER_H */
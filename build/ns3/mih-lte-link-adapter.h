@@ -0,0 +1,73 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MIH_LTE_LINK_ADAPTER_H
+#define MIH_LTE_LINK_ADAPTER_H
+
+#include "mih-link-adapter.h"
+
+namespace ns3 {
+
+/**
+ * \brief The link adapter of an LTE UE: the link is up once the RRC
+ * connection is established, and the signal is the RSRP (dBm) of the
+ * serving cell. It is only built with the lte module.
+ */
+class MihLteLinkAdapter : public MihLinkAdapter
+{
+public:
+  /**
+   * \brief typeid
+   */
+  static TypeId GetTypeId ();
+
+  MihLteLinkAdapter ();
+  virtual ~MihLteLinkAdapter ();
+
+protected:
+  virtual bool DoAttach (Ptr<NetDevice> device);
+
+private:
+  /**
+   * \brief the RRC connection is established, or a handover succeeded.
+   * \param imsi the IMSI of the UE
+   * \param cellId the cell
+   * \param rnti the RNTI of the UE
+   */
+  void Connected (uint64_t imsi, uint16_t cellId, uint16_t rnti);
+
+  /**
+   * \brief the RRC connection could not be established, or a handover
+   * failed.
+   * \param imsi the IMSI of the UE
+   * \param cellId the cell
+   * \param rnti the RNTI of the UE
+   */
+  void Disconnected (uint64_t imsi, uint16_t cellId, uint16_t rnti);
+
+  /**
+   * \brief a measurement of the serving cell.
+   * \param cellId the cell
+   * \param rnti the RNTI of the UE
+   * \param rsrp the RSRP, in W
+   * \param sinr the SINR, linear
+   */
+  void RsrpSinr (uint16_t cellId, uint16_t rnti, double rsrp, double sinr);
+};
+
+} /* namespace ns3 */
+
+#endif /* MIH_LTE_LINK_ADAPTER_H */
@@ -0,0 +1,207 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2017 Jadavpur University, India
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Manoj Kumar Rana <manoj24.rana@gmail.com>
+ */
+
+#ifndef MIPV6_HA_H
+#define MIPV6_HA_H
+
+#include "mipv6-agent.h"
+#include "bcache.h"
+#include "proxy-nd-table.h"
+#include "mipv6-header.h"
+
+class McoaOptionTestCase;
+
+namespace ns3 {
+class Packet;
+
+class Mipv6Ha : public Mipv6Agent
+{
+  /// allow McoaOptionTestCase access
+  friend class ::McoaOptionTestCase;
+
+public:
+  /**
+   * \brief The interface ID.
+   * \return type ID
+   */
+  static TypeId GetTypeId (void);
+  /**
+   * \brief Constructor.
+   */
+  Mipv6Ha ();
+  /**
+   * \brief Destructor.
+   */
+  virtual ~Mipv6Ha ();
+
+  /**
+   * \brief all the home link  addresses are returned.
+   * \returns home address list 
+   */
+  std::list<Ipv6Address> HomeAgentAddressList ();
+
+  /**
+   * \brief perform DAD on behalf of MN for its HoA in home network.
+   * \param target target address
+   * \param interface interface in which HoA is defined 
+   */
+  void DoDADForOffLinkAddress (Ipv6Address target, Ptr<Ipv6Interface> interface);
+
+  /**
+   * \brief performing binding process after DAD completion.
+   * \param interface interface at which BU is received
+   * \param ba formed BA
+   * \param homeaddr home address of the MN
+   */
+  void FunctionDadTimeoutForOffLinkAddress (Ptr<Ipv6Interface> interface, Ptr<Packet> ba, Ipv6Address homeaddr);
+
+  /**
+   * \brief Indication from the ICMPv6L4Protocol, if any corresponding NA is received and DAD fails.
+   * \param addr the target address
+   */
+  void DADFailureIndication (Ipv6Address addr);
+
+  /**
+   * \brief lookup for home address of MN in the proxy ND table
+   * \param addr home address
+   * \returns status
+   */
+  bool IsAddress (Ipv6Address addr);
+
+  /**
+   * \brief handle NS during DAD
+   * \param packet the NS packet
+   * \param interface where received
+   * \param src the source address
+   * \param target the target address
+   */
+  void HandleNS (Ptr<Packet> packet, Ptr<Ipv6Interface> interface, Ipv6Address src, Ipv6Address target);
+
+  /**
+   * TracedCallback signature for BU reception event.
+   *
+   * \param [in] packet The bu packet.
+   * \param [in] src The source address
+   * \param [in] dst The destination address
+   * \param [in] interface the interface in which the bu received
+   */
+  typedef void (* RxBuTracedCallback)
+    (Ptr<Packet> packet, Ipv6Address src, Ipv6Address dst, Ptr<Ipv6Interface> interface);
+
+protected:
+  virtual void NotifyNewAggregate ();
+
+  /**
+   * \brief build BA in response of BU
+   * \param bu the BU packet
+   * \param hoa the home address
+   * \param status the staus of BU reception
+   * \param bids the binding identifier options of the BU, echoed in the BA
+   * \return a ba packet
+   */
+  Ptr<Packet> BuildBA (Ipv6MobilityBindingUpdateHeader bu, Ipv6Address hoa, uint8_t status,
+                       const std::list<Ipv6MobilityOptionBindingIdentifierHeader> &bids);
+
+  /**
+   * \brief handle BU
+   * \param packet the BU packet
+   * \param src the source address
+   * \param dst the destination address
+   * \param interface the interface at which BU is received
+   * \return status
+   */
+  virtual uint8_t HandleBU (Ptr<Packet> packet, const Ipv6Address &src, const Ipv6Address &dst, Ptr<Ipv6Interface> interface);
+
+  /**
+   * \brief setup tunnel for a bcache entry
+   * \param bce BCache entry
+   * \return status whether tunnel is set up or not
+   */
+  bool SetupTunnelAndRouting (BCache::Entry *bce);
+
+  /**
+   * \brief clear tunnel for a bcache entry
+   * \param bce BCache entry
+   * \return status whether tunnel is cleared or not
+   */
+  bool ClearTunnelAndRouting (BCache::Entry *bce);
+
+  /**
+   * \brief collect the binding identifier and flow identification options of a BU
+   * \param bu the BU header
+   * \param bids list filled with binding identifier options
+   * \param flows list filled with flow identification options
+   */
+  void ParseMcoaOptions (Ipv6MobilityBindingUpdateHeader bu,
+                         std::list<Ipv6MobilityOptionBindingIdentifierHeader> &bids,
+                         std::list<Ipv6MobilityOptionFlowIdentificationHeader> &flows);
+
+  /**
+   * \brief register the care-of addresses and flow bindings of a BU in a bcache entry
+   *
+   * A binding identifier with the overwrite (O) flag replaces the
+   * care-of addresses of the entry with the ones of the BU (RFC 5648).
+   * \param bce BCache entry
+   * \param src the source address of the BU
+   * \param lifetime the lifetime of the BU
+   * \param bids binding identifier options
+   * \param flows flow identification options
+   */
+  void UpdateMcoaBindings (BCache::Entry *bce, Ipv6Address src, uint16_t lifetime,
+                           const std::list<Ipv6MobilityOptionBindingIdentifierHeader> &bids,
+                           const std::list<Ipv6MobilityOptionFlowIdentificationHeader> &flows);
+
+  /**
+   * \brief select the tunnel remote address of a packet from the flow bindings
+   * \param packet the packet to be tunnelled
+   * \return the care-of address the packet flow is bound to, or any address
+   */
+  Ipv6Address SelectTunnelRemote (Ptr<const Packet> packet);
+
+  /**
+   * \brief get the home link interface for a binding
+   * \param haa the HA address the BU was sent to
+   * \param interface the interface at which the BU is received
+   * \return the interface index
+   */
+  uint32_t GetHomeInterface (Ipv6Address haa, Ptr<Ipv6Interface> interface);
+
+
+private:
+  /**
+   * \brief the binding cache associated with this HA.
+   */
+  Ptr<BCache> m_bCache;
+
+  /**
+   * \brief the home addresses defended on the home link.
+   */
+  Ptr<ProxyNdTable> m_proxyNd;
+
+  /**
+   * \brief Callback to trace RX (reception) bu packets.
+   */ 
+  TracedCallback<Ptr<Packet>, Ipv6Address, Ipv6Address, Ptr<Ipv6Interface> > m_rxbuTrace;
+};
+
+} /* namespace ns3 */
+
+#endif /* MIPV6_HA_H */
+
@@ -0,0 +1,31 @@
+
+#ifdef NS3_MODULE_COMPILATION
+# error "Do not include ns3 module aggregator headers from other modules; these are meant only for end user scripts."
+#endif
+
+#ifndef NS3_MODULE_MIPV6
+    
+
+// Module headers:
+#include "bcache.h"
+#include "blist.h"
+#include "mih-function.h"
+#include "mih-helper.h"
+#include "mih-link-adapter.h"
+#include "mipv6-agent.h"
+#include "mipv6-cn.h"
+#include "mipv6-demux.h"
+#include "mipv6-ha.h"
+#include "mipv6-header.h"
+#include "mipv6-helper.h"
+#include "mipv6-l4-protocol.h"
+#include "mipv6-mn.h"
+#include "mipv6-mobility.h"
+#include "mipv6-option-demux.h"
+#include "mipv6-option-header.h"
+#include "mipv6-option.h"
+#include "mipv6-stats.h"
+#include "mipv6-tun-l4-protocol.h"
+#include "proxy-nd-table.h"
+#include "tunnel-net-device.h"
+#endif
@@ -0,0 +1,449 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2017 Jadavpur University, India
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MIPV6_STATS_H
+#define MIPV6_STATS_H
+
+#include <map>
+#include <vector>
+#include <string>
+#include "ns3/object.h"
+#include "ns3/nstime.h"
+#include "ns3/node.h"
+#include "ns3/node-container.h"
+#include "ns3/net-device.h"
+#include "ns3/packet.h"
+#include "ns3/ipv6-address.h"
+#include "ns3/ipv6-header.h"
+#include "ns3/ipv6-interface.h"
+#include "ns3/data-calculator.h"
+#include "ns3/data-collector.h"
+
+namespace ns3 {
+
+/**
+ * \brief Mipv6HandoffCalculator keeps the handoff statistics of a mobile
+ * node or of a home agent: one fixed-size histogram per handoff phase,
+ * holding the delay from the start of the handoff to the phase, and the
+ * mobility signaling counters. It is a DataCalculator, so it can be
+ * added to a DataCollector and written by any DataOutputInterface.
+ */
+class Mipv6HandoffCalculator : public DataCalculator
+{
+public:
+  /**
+   * Handoff phases, in the order they normally happen.
+   */
+  enum Phase_e
+  {
+    L2_DOWN = 0,
+    L2_UP,
+    RA_RECEIVED,
+    COA_READY,
+    BU_SENT,
+    BA_RECEIVED,
+    FIRST_DATA,
+    PHASE_COUNT
+  };
+
+  /**
+   * \brief typeid
+   */
+  static TypeId GetTypeId ();
+
+  /**
+   * \brief constructor
+   */
+  Mipv6HandoffCalculator ();
+
+  /**
+   * \brief destructor
+   */
+  virtual ~Mipv6HandoffCalculator ();
+
+  /**
+   * \brief set the histogram layout. Existing samples are discarded.
+   * \param width the width of a bin
+   * \param nBins the number of bins, an overflow bin is added
+   */
+  void SetBins (Time width, uint32_t nBins);
+
+  /**
+   * \brief add a sample to the histogram of a phase.
+   * \param phase the phase
+   * \param delay the delay from the start of the handoff to the phase
+   */
+  void AddSample (uint8_t phase, Time delay);
+
+  /**
+   * \brief account a mobility signaling packet.
+   * \param bytes the size of the packet
+   */
+  void AddSignaling (uint32_t bytes);
+
+  /**
+   * \brief get the number of samples of a phase.
+   * \param phase the phase
+   * \returns the number of samples
+   */
+  uint32_t GetCount (uint8_t phase) const;
+
+  /**
+   * \brief get the mean delay of a phase.
+   * \param phase the phase
+   * \returns the mean delay
+   */
+  Time GetMean (uint8_t phase) const;
+
+  /**
+   * \brief get the maximum delay of a phase.
+   * \param phase the phase
+   * \returns the maximum delay
+   */
+  Time GetMax (uint8_t phase) const;
+
+  /**
+   * \brief get the number of samples in a bin.
+   * \param phase the phase
+   * \param bin the bin index, the last one is the overflow bin
+   * \returns the number of samples
+   */
+  uint32_t GetBinCount (uint8_t phase, uint32_t bin) const;
+
+  /**
+   * \brief get the number of bins, including the overflow bin.
+   * \returns the number of bins
+   */
+  uint32_t GetNBins () const;
+
+  /**
+   * \brief account a handoff which ended without data received through
+   * its binding.
+   */
+  void AddIncomplete ();
+
+  /**
+   * \brief get the number of completed handoffs.
+   * \returns the number of handoffs
+   */
+  uint32_t GetNHandoffs () const;
+
+  /**
+   * \brief get the number of handoffs which ended without data received
+   * through their binding. Their phases are accounted as well.
+   * \returns the number of handoffs
+   */
+  uint32_t GetNIncomplete () const;
+
+  /**
+   * \brief get the number of mobility signaling packets.
+   * \returns the number of packets
+   */
+  uint32_t GetSignalingPackets () const;
+
+  /**
+   * \brief get the number of mobility signaling bytes.
+   * \returns the number of bytes
+   */
+  uint64_t GetSignalingBytes () const;
+
+  /**
+   * \brief get the name of a phase.
+   * \param phase the phase
+   * \returns the name
+   */
+  static std::string GetPhaseName (uint8_t phase);
+
+  /**
+   * \brief output the statistics.
+   * \param callback the output callback
+   */
+  virtual void Output (DataOutputCallback &callback) const;
+
+private:
+  /**
+   * \brief the width of a bin.
+   */
+  Time m_binWidth;
+
+  /**
+   * \brief the number of bins, without the overflow bin.
+   */
+  uint32_t m_nBins;
+
+  /**
+   * \brief the histograms, one per phase.
+   */
+  std::vector<uint32_t> m_bins[PHASE_COUNT];
+
+  /**
+   * \brief the number of samples, one per phase.
+   */
+  uint32_t m_count[PHASE_COUNT];
+
+  /**
+   * \brief the sum of the delays, one per phase.
+   */
+  Time m_sum[PHASE_COUNT];
+
+  /**
+   * \brief the maximum delay, one per phase.
+   */
+  Time m_max[PHASE_COUNT];
+
+  /**
+   * \brief the number of incomplete handoffs.
+   */
+  uint32_t m_incomplete;
+
+  /**
+   * \brief the number of mobility signaling packets.
+   */
+  uint32_t m_signalingPackets;
+
+  /**
+   * \brief the number of mobility signaling bytes.
+   */
+  uint64_t m_signalingBytes;
+};
+
+/**
+ * \brief Mipv6Stats timestamps the phases of every handoff of the mobile
+ * nodes it is installed on: L2 link down and up, RA reception, CoA ready,
+ * BU sent, BA received and the first data packet received through the
+ * tunnel. Completed handoffs are accumulated per mobile node and per home
+ * agent. A handoff which ends without data through its binding, because
+ * the MN moves or updates its binding again, is accounted as incomplete,
+ * and so are the handoffs still in progress when Flush () is called.
+ * Nothing is hooked until InstallMn ()/InstallHa () is called, so
+ * simulations that do not use it pay nothing.
+ */
+class Mipv6Stats : public Object
+{
+public:
+  /**
+   * \brief typeid
+   */
+  static TypeId GetTypeId ();
+
+  /**
+   * \brief constructor
+   */
+  Mipv6Stats ();
+
+  /**
+   * \brief destructor
+   */
+  virtual ~Mipv6Stats ();
+
+  /**
+   * \brief collect the handoffs of a mobile node.
+   * \param node the node, with a Mipv6Mn aggregated
+   */
+  void InstallMn (Ptr<Node> node);
+
+  /**
+   * \brief collect the handoffs of mobile nodes.
+   * \param nodes the nodes, with a Mipv6Mn aggregated
+   */
+  void InstallMn (NodeContainer nodes);
+
+  /**
+   * \brief collect the binding updates received by a home agent.
+   * \param node the node, with a Mipv6Ha aggregated
+   */
+  void InstallHa (Ptr<Node> node);
+
+  /**
+   * \brief get the statistics of a mobile node.
+   * \param nodeId the node id
+   * \returns the statistics, or 0 if the node is not monitored
+   */
+  Ptr<Mipv6HandoffCalculator> GetMnStats (uint32_t nodeId) const;
+
+  /**
+   * \brief get the statistics of a home agent.
+   * \param ha the home agent address
+   * \returns the statistics, or 0 if no handoff used the home agent
+   */
+  Ptr<Mipv6HandoffCalculator> GetHaStats (Ipv6Address ha) const;
+
+  /**
+   * \brief record a phase of the handoff of a mobile node. The phases are
+   * recorded from the traces hooked by InstallMn (), this is for the
+   * phases detected otherwise.
+   * \param nodeId the node id
+   * \param phase the phase
+   */
+  void Record (uint32_t nodeId, uint8_t phase);
+
+  /**
+   * \brief account the handoffs in progress as incomplete, e.g. at the
+   * end of the simulation.
+   */
+  void Flush ();
+
+  /**
+   * \brief add the statistics of all the nodes and home agents to a
+   * collector, after flushing the handoffs in progress.
+   * \param collector the data collector
+   */
+  void Export (DataCollector &collector);
+
+protected:
+  /**
+   * \brief Dispose this object.
+   */
+  virtual void DoDispose ();
+
+private:
+  /**
+   * \brief the handoff in progress of a mobile node.
+   */
+  struct Handoff
+  {
+    Handoff () : active (false) {}
+    bool active;                                          //!< a handoff is in progress
+    Time start;                                           //!< start of the handoff
+    Time time[Mipv6HandoffCalculator::PHASE_COUNT];       //!< time of each phase
+    bool seen[Mipv6HandoffCalculator::PHASE_COUNT];       //!< whether each phase happened
+    Ipv6Address ha;                                       //!< home agent which acknowledged the binding
+  };
+
+  /**
+   * \brief add the phases of a handoff to the statistics of its mobile
+   * node and home agent, and end it.
+   * \param nodeId the node id
+   * \param h the handoff
+   */
+  void Commit (uint32_t nodeId, Handoff &h);
+
+  /**
+   * \brief get the node id from a trace context.
+   * \param context the context
+   * \returns the node id
+   */
+  static uint32_t GetNodeId (std::string context);
+
+  /**
+   * \brief get (or create) the statistics of a mobile node.
+   * \param nodeId the node id
+   * \returns the statistics
+   */
+  Ptr<Mipv6HandoffCalculator> FindMnStats (uint32_t nodeId);
+
+  /**
+   * \brief get (or create) the statistics of a home agent.
+   * \param ha the home agent address
+   * \returns the statistics
+   */
+  Ptr<Mipv6HandoffCalculator> FindHaStats (Ipv6Address ha);
+
+  /**
+   * \brief link state change of a mobile node device.
+   * \param device the device
+   */
+  void LinkChanged (Ptr<NetDevice> device);
+
+  /**
+   * \brief an RA with a new prefix has been received by a mobile node.
+   * \param context the node id
+   * \param router the router address
+   * \param interface the interface index
+   */
+  void RxRa (std::string context, Ipv6Address router, uint32_t interface);
+
+  /**
+   * \brief a new CoA is usable by a mobile node.
+   * \param context the node id
+   * \param coa the care-of address
+   */
+  void NewCoa (std::string context, Ipv6Address coa);
+
+  /**
+   * \brief a BU has been sent by a mobile node.
+   * \param context the node id
+   * \param packet the BU
+   * \param src the source address
+   * \param dst the destination address
+   */
+  void TxBu (std::string context, Ptr<Packet> packet, Ipv6Address src, Ipv6Address dst);
+
+  /**
+   * \brief a BA has been received by a mobile node.
+   * \param context the node id
+   * \param packet the BA
+   * \param src the source address
+   * \param dst the destination address
+   * \param interface the interface
+   */
+  void RxBa (std::string context, Ptr<Packet> packet, Ipv6Address src, Ipv6Address dst, Ptr<Ipv6Interface> interface);
+
+  /**
+   * \brief a data packet has been received by a mobile node through the tunnel.
+   * \param context the node id
+   * \param packet the packet
+   * \param inner the inner header
+   * \param outer the outer header
+   * \param interface the interface
+   */
+  void RxTunnel (std::string context, Ptr<Packet> packet, Ipv6Header inner, Ipv6Header outer, Ptr<Ipv6Interface> interface);
+
+  /**
+   * \brief a BU has been received by a home agent.
+   * \param packet the BU
+   * \param src the source address
+   * \param dst the destination address
+   * \param interface the interface
+   */
+  void RxBuHa (Ptr<Packet> packet, Ipv6Address src, Ipv6Address dst, Ptr<Ipv6Interface> interface);
+
+  /**
+   * \brief whether the collection is enabled.
+   */
+  bool m_enabled;
+
+  /**
+   * \brief the width of a histogram bin.
+   */
+  Time m_binWidth;
+
+  /**
+   * \brief the number of histogram bins.
+   */
+  uint32_t m_nBins;
+
+  /**
+   * \brief the handoffs in progress, keyed by node id.
+   */
+  std::map<uint32_t, Handoff> m_handoffs;
+
+  /**
+   * \brief the mobile node statistics, keyed by node id.
+   */
+  std::map<uint32_t, Ptr<Mipv6HandoffCalculator> > m_mnStats;
+
+  /**
+   * \brief the home agent statistics, keyed by home agent address.
+   */
+  std::map<Ipv6Address, Ptr<Mipv6HandoffCalculator> > m_haStats;
+};
+
+} /* namespace ns3 */
+
+#endif /* MIPV6_STATS_H */
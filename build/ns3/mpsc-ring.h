@@ -0,0 +1,224 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MPSC_RING_H
+#define MPSC_RING_H
+
+#include <stdint.h>
+#include "assert.h"
+
+/**
+ * \file
+ * \ingroup thread
+ * ns3::MpscRing declaration and template implementation.
+ */
+
+namespace ns3 {
+
+/**
+ * \ingroup thread
+ * \brief A bounded lock-free queue with many producers and one consumer.
+ *
+ * Each cell of the ring carries a sequence number telling whether it
+ * is free for the producer of a given position or filled for the
+ * consumer (D. Vyukov's bounded queue). Producers claim a position with
+ * a compare and swap on the tail and publish the item by advancing the
+ * sequence number of the cell; the consumer owns the head and needs no
+ * read-modify-write at all.
+ *
+ * Push fails when the ring is full: the caller is expected to fall back
+ * to a slower path rather than to spin. Pop may also fail while a
+ * producer which claimed the next position has not yet published its
+ * item; the item is then returned by a later Pop.
+ *
+ * \tparam T \explicit The item type, copied in and out of the ring.
+ */
+template <typename T>
+class MpscRing
+{
+public:
+  /**
+   * Constructor.
+   *
+   * \param [in] capacity The number of cells, a power of two.
+   */
+  MpscRing (uint32_t capacity);
+  /** Destructor. */
+  ~MpscRing ();
+
+  /**
+   * Add an item, from any thread.
+   *
+   * \param [in] item The item.
+   * \returns \c false if the ring is full.
+   */
+  bool Push (const T &item);
+  /**
+   * Remove the oldest item, from the consumer thread only.
+   *
+   * \param [out] item The item.
+   * \returns \c false if there is no item ready.
+   */
+  bool Pop (T &item);
+  /**
+   * Check for an item ready, from the consumer thread only.
+   *
+   * \returns \c true if Pop would fail.
+   */
+  bool IsEmpty (void) const;
+  /**
+   * Check that every position claimed by a producer has been popped,
+   * from the consumer thread only. Unlike IsEmpty, this is \c false
+   * while a producer has claimed a position but not yet published its
+   * item.
+   *
+   * \returns \c true if no item is pending.
+   */
+  bool IsDrained (void) const;
+
+private:
+  /** A cell of the ring. */
+  struct Cell
+  {
+    uint64_t sequence;  /**< Position the cell is ready for. */
+    T item;             /**< The item. */
+  };
+
+  /**
+   * Copy constructor, not implemented.
+   * \param [in] o The ring to copy.
+   */
+  MpscRing (const MpscRing &o);
+  /**
+   * Assignment operator, not implemented.
+   * \param [in] o The ring to copy.
+   * \returns The ring.
+   */
+  MpscRing & operator = (const MpscRing &o);
+
+  /** The cells. */
+  Cell *m_cells;
+  /** The number of cells minus one. */
+  uint64_t m_mask;
+  /** Keep the tail out of the cache line of the fields above. */
+  char m_pad0[64];
+  /** The next position to produce, shared by the producers. */
+  uint64_t m_tail;
+  /** Keep the head out of the cache line of the tail. */
+  char m_pad1[64];
+  /** The next position to consume, owned by the consumer. */
+  uint64_t m_head;
+};
+
+} // namespace ns3
+
+
+/********************************************************************
+ *  Implementation of the templates declared above.
+ ********************************************************************/
+
+namespace ns3 {
+
+template <typename T>
+MpscRing<T>::MpscRing (uint32_t capacity)
+  : m_cells (new Cell[capacity]),
+    m_mask (capacity - 1),
+    m_tail (0),
+    m_head (0)
+{
+  NS_ASSERT_MSG (capacity != 0 && (capacity & (capacity - 1)) == 0,
+                 "MpscRing capacity must be a power of two");
+  for (uint32_t i = 0; i < capacity; i++)
+    {
+      m_cells[i].sequence = i;
+    }
+}
+
+template <typename T>
+MpscRing<T>::~MpscRing ()
+{
+  delete [] m_cells;
+}
+
+template <typename T>
+bool
+MpscRing<T>::Push (const T &item)
+{
+  uint64_t pos = __atomic_load_n (&m_tail, __ATOMIC_RELAXED);
+  for (;;)
+    {
+      Cell *cell = &m_cells[pos & m_mask];
+      uint64_t sequence = __atomic_load_n (&cell->sequence, __ATOMIC_ACQUIRE);
+      int64_t diff = (int64_t)(sequence - pos);
+      if (diff == 0)
+        {
+          // the cell is free: claim the position. On failure, pos is
+          // updated to the current tail.
+          if (__atomic_compare_exchange_n (&m_tail, &pos, pos + 1, true,
+                                           __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+            {
+              cell->item = item;
+              __atomic_store_n (&cell->sequence, pos + 1, __ATOMIC_RELEASE);
+              return true;
+            }
+        }
+      else if (diff < 0)
+        {
+          // the cell still holds the item of the previous lap: full.
+          return false;
+        }
+      else
+        {
+          // another producer took the position.
+          pos = __atomic_load_n (&m_tail, __ATOMIC_RELAXED);
+        }
+    }
+}
+
+template <typename T>
+bool
+MpscRing<T>::Pop (T &item)
+{
+  Cell *cell = &m_cells[m_head & m_mask];
+  if (__atomic_load_n (&cell->sequence, __ATOMIC_ACQUIRE) != m_head + 1)
+    {
+      return false;
+    }
+  item = cell->item;
+  // free the cell for the producer of the next lap.
+  __atomic_store_n (&cell->sequence, m_head + m_mask + 1, __ATOMIC_RELEASE);
+  m_head++;
+  return true;
+}
+
+template <typename T>
+bool
+MpscRing<T>::IsEmpty (void) const
+{
+  const Cell *cell = &m_cells[m_head & m_mask];
+  return __atomic_load_n (&cell->sequence, __ATOMIC_ACQUIRE) != m_head + 1;
+}
+
+template <typename T>
+bool
+MpscRing<T>::IsDrained (void) const
+{
+  return __atomic_load_n (&m_tail, __ATOMIC_ACQUIRE) == m_head;
+}
+
+} // namespace ns3
+
+#endif /* MPSC_RING_H */
@@ -0,0 +1,308 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2017 Jadavpur University, India
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef PROXY_ND_TABLE_H
+#define PROXY_ND_TABLE_H
+
+#include <map>
+#include "ns3/object.h"
+#include "ns3/node.h"
+#include "ns3/packet.h"
+#include "ns3/ipv6-address.h"
+#include "ns3/ipv6-header.h"
+#include "ns3/icmpv6-header.h"
+#include "ns3/ndisc-cache.h"
+#include "ns3/sgi-hashmap.h"
+
+namespace ns3 {
+
+/**
+ * \brief ProxyNdTable class is associated with Mipv6Ha class. It holds the
+ * home addresses the HA defends on the home link on behalf of the registered
+ * MNs (RFC 6275, section 10.4.1), keyed by the home link interface and the
+ * home address, so that an address may be defended on several links. The
+ * solicited-node multicast groups of these addresses are joined once per
+ * binding, and each entry keeps a precomputed NA so that an NS is answered
+ * without rebuilding the whole message.
+ */
+class ProxyNdTable : public Object
+{
+public:
+  class Entry;
+
+  /**
+   * \brief typeid
+   */
+  static TypeId GetTypeId ();
+
+  /**
+   * \brief constructor
+   */
+  ProxyNdTable ();
+
+  /**
+   * \brief destructor
+   */
+  ~ProxyNdTable ();
+
+  /**
+   * \brief get node.
+   * \returns the node pointer
+   */
+  Ptr<Node> GetNode () const;
+
+  /**
+   * \brief set node.
+   * \param node the node pointer
+   */
+  void SetNode (Ptr<Node> node);
+
+  /**
+   * \brief start defending an address on an interface. If the address is
+   * already defended there its entry is updated, otherwise its solicited-node
+   * group is joined on the interface.
+   * \param target the address to defend (MN's home address)
+   * \param source the address used as source of the NAs (HA address)
+   * \param interface the home link interface index
+   * \returns the entry of the address
+   */
+  ProxyNdTable::Entry * Add (Ipv6Address target, Ipv6Address source, uint32_t interface);
+
+  /**
+   * \brief stop defending an address on an interface. The solicited-node
+   * group is left when no other defended address uses it.
+   * \param target the defended address
+   * \param interface the home link interface index
+   */
+  void Remove (Ipv6Address target, uint32_t interface);
+
+  /**
+   * \brief lookup the entry of an address defended on an interface.
+   * \param target the address
+   * \param interface the home link interface index
+   * \returns the entry, or 0 if the address is not defended there
+   */
+  ProxyNdTable::Entry * Lookup (Ipv6Address target, uint32_t interface);
+
+  /**
+   * \brief check whether an address is defended on any interface.
+   * \param target the address
+   * \returns true if so
+   */
+  bool IsDefended (Ipv6Address target) const;
+
+  /**
+   * \brief get the number of defended addresses.
+   * \returns the number of entries
+   */
+  uint32_t GetNEntries () const;
+
+  /**
+   * \brief stop defending all the addresses.
+   */
+  void Flush ();
+
+  /**
+   * Entry for a defended address
+   */
+  class Entry
+  {
+  public:
+    /**
+     * \brief constructor
+     * \param target the defended address
+     * \param source the source address of the NAs
+     * \param interface the home link interface index
+     * \param lla the link-layer address advertised for the target
+     * \param router whether the R flag is set in the NAs
+     */
+    Entry (Ipv6Address target, Ipv6Address source, uint32_t interface, Address lla, bool router);
+
+    /**
+     * \brief get the defended address.
+     * \returns the target address
+     */
+    Ipv6Address GetTarget () const;
+
+    /**
+     * \brief get the solicited-node multicast address of the target.
+     * \returns the solicited-node multicast address
+     */
+    Ipv6Address GetSolicitedAddress () const;
+
+    /**
+     * \brief get the home link interface index.
+     * \returns the interface index
+     */
+    uint32_t GetInterface () const;
+
+    /**
+     * \brief set the UID of the DAD NS sent by the HA for the target.
+     * \param uid the packet UID
+     */
+    void SetNsDadUid (uint32_t uid);
+
+    /**
+     * \brief get the UID of the DAD NS sent by the HA for the target.
+     * \returns the packet UID
+     */
+    uint32_t GetNsDadUid () const;
+
+    /**
+     * \brief forge an NA for the target from the precomputed template.
+     * \param dst the destination address of the NA
+     * \param solicited whether the S flag is set
+     * \returns the NA packet and its IPv6 header
+     */
+    NdiscCache::Ipv6PayloadHeaderPair ForgeNA (Ipv6Address dst, bool solicited) const;
+
+  private:
+    /**
+     * \brief the defended address.
+     */
+    Ipv6Address m_target;
+
+    /**
+     * \brief the solicited-node multicast address of the target.
+     */
+    Ipv6Address m_solicited;
+
+    /**
+     * \brief the source address of the NAs.
+     */
+    Ipv6Address m_source;
+
+    /**
+     * \brief the home link interface index.
+     */
+    uint32_t m_interface;
+
+    /**
+     * \brief the UID of the DAD NS sent for the target.
+     */
+    uint32_t m_nsDadUid;
+
+    /**
+     * \brief NA header template (target, O and R flags).
+     */
+    Icmpv6NA m_na;
+
+    /**
+     * \brief target link-layer address option, already serialized.
+     */
+    Ptr<Packet> m_option;
+
+    /**
+     * \brief IPv6 header template.
+     */
+    Ipv6Header m_ipHeader;
+  };
+
+protected:
+  /**
+   * \brief Dispose this object.
+   */
+  void DoDispose ();
+
+private:
+  /**
+   * \brief interface / defended address key.
+   */
+  typedef std::pair<uint32_t, Ipv6Address> ProxyNdKey_t;
+
+  /**
+   * \brief hash of an interface / defended address key.
+   */
+  class ProxyNdKeyHash : public std::unary_function<ProxyNdKey_t, size_t>
+  {
+  public:
+    /**
+     * \brief Unary operator to hash a key.
+     * \param key the key
+     * \returns the hash
+     */
+    size_t operator () (ProxyNdKey_t const &key) const
+    {
+      return Ipv6AddressHash () (key.second) ^ key.first;
+    }
+  };
+
+  /**
+   * \brief container of the defended addresses. The entries are held by
+   * value, their addresses are stable until they are removed.
+   */
+  typedef sgi::hash_map<ProxyNdKey_t, ProxyNdTable::Entry, ProxyNdKeyHash> ProxyNdTableEntries_t;
+
+  /**
+   * \brief container iterator of the defended addresses.
+   */
+  typedef ProxyNdTableEntries_t::iterator ProxyNdTableEntriesI;
+
+  /**
+   * \brief number of interfaces each address is defended on.
+   */
+  typedef sgi::hash_map<Ipv6Address, uint32_t, Ipv6AddressHash> ProxyNdTargets_t;
+
+  /**
+   * \brief solicited-node group / interface key.
+   */
+  typedef std::pair<Ipv6Address, uint32_t> SolicitedGroupKey_t;
+
+  /**
+   * \brief container of the joined solicited-node groups and their reference counts.
+   */
+  typedef std::map<SolicitedGroupKey_t, uint32_t> SolicitedGroups_t;
+
+  /**
+   * \brief join a solicited-node group on an interface.
+   * \param group the group
+   * \param interface the interface index
+   */
+  void JoinGroup (Ipv6Address group, uint32_t interface);
+
+  /**
+   * \brief leave a solicited-node group on an interface.
+   * \param group the group
+   * \param interface the interface index
+   */
+  void LeaveGroup (Ipv6Address group, uint32_t interface);
+
+  /**
+   * \brief the defended addresses.
+   */
+  ProxyNdTableEntries_t m_entries;
+
+  /**
+   * \brief the interface count of the defended addresses.
+   */
+  ProxyNdTargets_t m_targets;
+
+  /**
+   * \brief the joined solicited-node groups.
+   */
+  SolicitedGroups_t m_groups;
+
+  /**
+   * \brief the node.
+   */
+  Ptr<Node> m_node;
+};
+
+} /* namespace ns3 */
+
+#endif /* PROXY_ND_TABLE_H */
@@ -0,0 +1,121 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef SNR_TO_BLOCK_ERROR_RATE_TABLE_H
+#define SNR_TO_BLOCK_ERROR_RATE_TABLE_H
+
+#include <string>
+#include <vector>
+#include <stdint.h>
+#include "ns3/ptr.h"
+#include "ns3/simple-ref-count.h"
+#include "ns3/snr-to-block-error-rate-record.h"
+
+namespace ns3 {
+
+/**
+ * \ingroup wimax
+ * \brief The SNR to block error rate traces of the seven modulations,
+ * shared by all the SNRToBlockErrorRateManager which load the same traces.
+ *
+ * A table is immutable once loaded, and lives as long as a manager
+ * refers to it. Each trace is indexed by a uniform grid of SNR bins, no
+ * wider than the smallest SNR step of the trace, which gives the trace
+ * interval of an SNR without searching for it.
+ */
+class SNRToBlockErrorRateTable : public SimpleRefCount<SNRToBlockErrorRateTable>
+{
+public:
+  /// The number of modulations.
+  static const uint8_t N_MODULATIONS = 7;
+
+  /**
+   * \param prefix the path of the trace files, up to the modulation number
+   * \returns the table read from the files prefix0.txt to prefix6.txt, or
+   * the default table if one of them cannot be read
+   */
+  static Ptr<const SNRToBlockErrorRateTable> Get (std::string prefix);
+  /**
+   * \returns the table of the traces of default-traces.h
+   */
+  static Ptr<const SNRToBlockErrorRateTable> GetDefault (void);
+
+  ~SNRToBlockErrorRateTable ();
+
+  /**
+   * \param snr the SNR value
+   * \param modulation one of the seven MCS
+   * \returns the record of the trace interpolated at this SNR, or its
+   * first or last record outside of the trace
+   */
+  SNRToBlockErrorRateRecord GetRecord (double snr, uint8_t modulation) const;
+  /**
+   * \param snr the SNR value
+   * \param modulation one of the seven MCS
+   * \returns the block error rate interpolated at this SNR, 1 below the
+   * trace and 0 above it
+   */
+  double GetBlockErrorRate (double snr, uint8_t modulation) const;
+
+private:
+  /// A line of a trace.
+  struct Point
+  {
+    double snr;             //!< The SNR.
+    double bitErrorRate;    //!< The bit error rate.
+    double blockErrorRate;  //!< The block error rate.
+    double sigma2;          //!< The standard deviation.
+    double i1;              //!< The lower boundary of the confidence interval.
+    double i2;              //!< The upper boundary of the confidence interval.
+  };
+  /// The trace of a modulation.
+  struct Trace
+  {
+    std::vector<Point> points;    //!< The lines, by increasing SNR.
+    double step;                  //!< The width of the SNR bins.
+    std::vector<uint32_t> bins;   //!< The first point above the start of each bin.
+  };
+
+  /**
+   * \param key the key of the table in the tables in use
+   */
+  SNRToBlockErrorRateTable (std::string key);
+  /**
+   * \param prefix the path of the trace files, up to the modulation number
+   * \returns true if all the files were read
+   */
+  bool LoadFiles (std::string prefix);
+  /// Load the traces of default-traces.h.
+  void LoadDefault (void);
+  /**
+   * \brief Index the points of a trace.
+   * \param trace the trace
+   */
+  static void Index (Trace &trace);
+  /**
+   * \param trace the trace
+   * \param snr an SNR strictly between the first and the last points
+   * \returns the index of the first point whose SNR is above snr
+   */
+  static uint32_t FindUpper (const Trace &trace, double snr);
+
+  std::string m_key;                   //!< The key of the table.
+  Trace m_traces[N_MODULATIONS];       //!< The traces, by modulation.
+};
+
+} // namespace ns3
+
+#endif /* SNR_TO_BLOCK_ERROR_RATE_TABLE_H */
@@ -0,0 +1,131 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#ifndef SPATIAL_INDEX_H
+#define SPATIAL_INDEX_H
+
+#include <map>
+#include <set>
+#include <vector>
+#include <stdint.h>
+#include "ns3/ptr.h"
+#include "ns3/nstime.h"
+#include "ns3/vector.h"
+#include "ns3/mobility-model.h"
+#include "ns3/mobility-store.h"
+
+namespace ns3 {
+
+/**
+ * \ingroup mobility
+ * \brief A uniform grid of the positions of mobility models, to find
+ * the ones near a position without looking at all of them.
+ *
+ * Each entry is an identifier chosen by the user, e.g. the index of a
+ * PHY in the list of a channel, and the mobility model giving its
+ * position. The grid cells are squares in the x-y plane. The positions
+ * are kept by a MobilityStore: an entry is moved to its new cell with
+ * the other course changes of the same time step, at the latest when
+ * the grid is searched, and the entries which were moving at their last
+ * course change are moved again, lazily, when the grid is searched at a
+ * later time. The entries without a mobility model are always found.
+ */
+class SpatialIndex
+{
+public:
+  SpatialIndex ();
+  ~SpatialIndex ();
+
+  /**
+   * \param size the side of the grid cells, in meters
+   *
+   * Must be set before any entry is added.
+   */
+  void SetCellSize (double size);
+  /**
+   * \param id the identifier of the entry
+   * \param mobility its mobility model, or 0
+   */
+  void Add (uint32_t id, Ptr<MobilityModel> mobility);
+  /**
+   * \returns the number of entries
+   */
+  uint32_t GetN (void) const;
+  /**
+   * \brief Find the entries which may be within a distance of a position.
+   * \param position the position
+   * \param range the distance, in meters
+   * \param ids the identifiers of the entries in the grid cells overlapping
+   * the square of side 2 * range around the position, and of the entries
+   * without mobility model, in increasing order
+   */
+  void GetCandidates (const Vector &position, double range, std::vector<uint32_t> &ids);
+  /// Remove all the entries, and stop following their mobility models.
+  void Clear (void);
+
+private:
+  /**
+   * \brief Copy constructor, not implemented: the index follows the
+   * mobility models of its entries.
+   * \param o the other index
+   */
+  SpatialIndex (const SpatialIndex &o);
+  /**
+   * \brief Assignment operator, not implemented.
+   * \param o the other index
+   * \returns the index
+   */
+  SpatialIndex &operator = (const SpatialIndex &o);
+
+  /// The coordinates of a grid cell.
+  typedef std::pair<int64_t, int64_t> Cell;
+  /// An entry.
+  struct Entry
+  {
+    uint32_t id;                    //!< The identifier.
+    uint32_t position;              //!< The index of the entry in the store.
+    Cell cell;                      //!< The grid cell.
+    bool moving;                    //!< Whether the velocity was not zero at the last course change.
+  };
+
+  /**
+   * \param position a position
+   * \returns its grid cell
+   */
+  Cell GetCell (const Vector &position) const;
+  /**
+   * \brief Move an entry to the grid cell of its current position.
+   * \param index the index of the entry
+   */
+  void Update (uint32_t index);
+  /**
+   * \brief Move the entries which changed course.
+   * \param positions their indices in the store
+   */
+  void CourseChanged (const std::vector<uint32_t> &positions);
+
+  double m_cellSize;                                      //!< The side of the cells.
+  std::vector<Entry> m_entries;                           //!< The entries.
+  std::map<Cell, std::vector<uint32_t> > m_cells;         //!< The entries of each non-empty cell, by index.
+  Ptr<MobilityStore> m_store;                             //!< The positions of the entries with a mobility model.
+  std::vector<uint32_t> m_byPosition;                     //!< The index of each entry of the store.
+  std::set<uint32_t> m_moving;                            //!< The moving entries, by index.
+  std::vector<uint32_t> m_unplaced;                       //!< The entries without mobility model, by index.
+  Time m_lastUpdate;                                      //!< When the moving entries were last moved.
+};
+
+} // namespace ns3
+
+#endif /* SPATIAL_INDEX_H */
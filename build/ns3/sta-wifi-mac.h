@@ -0,0 +1,294 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2006, 2009 INRIA
+ * Copyright (c) 2009 MIRKO BANCHI
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Authors: Mathieu Lacage <mathieu.lacage@sophia.inria.fr>
+ *          Mirko Banchi <mk.banchi@gmail.com>
+ */
+#ifndef STA_WIFI_MAC_H
+#define STA_WIFI_MAC_H
+
+#include "regular-wifi-mac.h"
+#include "ns3/event-id.h"
+#include "ns3/packet.h"
+#include "ns3/traced-callback.h"
+#include "supported-rates.h"
+#include "amsdu-subframe-header.h"
+#include "capability-information.h"
+#include "wifi-phy.h"
+#include <map>
+
+namespace ns3  {
+
+class MgtAddBaRequestHeader;
+
+/**
+ * \ingroup wifi
+ *
+ * The Wifi MAC high model for a non-AP STA in a BSS.
+ */
+class StaWifiMac : public RegularWifiMac
+{
+public:
+  static TypeId GetTypeId (void);
+
+  StaWifiMac ();
+  virtual ~StaWifiMac ();
+
+  /**
+   * \param packet the packet to send.
+   * \param to the address to which the packet should be sent.
+   *
+   * The packet should be enqueued in a tx queue, and should be
+   * dequeued as soon as the channel access function determines that
+   * access is granted to this MAC.
+   */
+  virtual void Enqueue (Ptr<const Packet> packet, Mac48Address to);
+
+  /**
+   * \param missed the number of beacons which must be missed
+   * before a new association sequence is started.
+   */
+  void SetMaxMissedBeacons (uint32_t missed);
+  /**
+   * \param timeout
+   *
+   * If no probe response is received within the specified
+   * timeout, the station sends a new probe request.
+   */
+  void SetProbeRequestTimeout (Time timeout);
+  /**
+   * \param timeout
+   *
+   * If no association response is received within the specified
+   * timeout, the station sends a new association request.
+   */
+  void SetAssocRequestTimeout (Time timeout);
+
+  /**
+   * Start an active association sequence immediately.
+   */
+  void StartActiveAssociation (void);
+
+  virtual void SetWifiPhy (Ptr<WifiPhy> phy);
+  virtual void ResetWifiPhy (void);
+
+  /**
+   * TracedCallback signature for handoffs.
+   *
+   * \param [in] oldBssid The BSSID of the AP the STA lost or left.
+   * \param [in] newBssid The BSSID of the AP the STA associated with.
+   * \param [in] latency The time since the last beacon of the old AP,
+   *             or since the STA left it to roam.
+   */
+  typedef void (* HandoffTracedCallback)
+    (Mac48Address oldBssid, Mac48Address newBssid, Time latency);
+
+
+private:
+  /**
+   * The current MAC state of the STA.
+   */
+  enum MacState
+  {
+    ASSOCIATED,
+    WAIT_PROBE_RESP,
+    WAIT_ASSOC_RESP,
+    BEACON_MISSED,
+    REFUSED
+  };
+
+  /**
+   * An AP heard in a beacon or a probe response.
+   */
+  struct ApCandidate
+  {
+    double signal;     //!< The signal of its last frame, in dBm.
+    uint16_t channel;  //!< Its channel number.
+    Time lastSeen;     //!< When its last frame was received.
+  };
+  /// The cached APs, by BSSID.
+  typedef std::map<Mac48Address, ApCandidate> ApCandidates;
+
+  /**
+   * Enable or disable active probing.
+   *
+   * \param enable enable or disable active probing
+   */
+  void SetActiveProbing (bool enable);
+  /**
+   * Return whether active probing is enabled.
+   *
+   * \return true if active probing is enabled, false otherwise
+   */
+  bool GetActiveProbing (void) const;
+  /**
+   * Enable or disable the cache of the APs heard. The signal of the
+   * frames is only sniffed from the phy while it is enabled.
+   *
+   * \param enable enable or disable the cache
+   */
+  void SetCandidateCache (bool enable);
+  /**
+   * Return whether the cache of the APs heard is enabled.
+   *
+   * \return true if the cache is enabled, false otherwise
+   */
+  bool GetCandidateCache (void) const;
+
+  virtual void Receive (Ptr<Packet> packet, const WifiMacHeader *hdr);
+
+  /**
+   * Forward a probe request packet to the DCF. The standard is not clear on the correct
+   * queue for management frames if QoS is supported. We always use the DCF.
+   */
+  void SendProbeRequest (void);
+  /**
+   * Forward an association request packet to the DCF. The standard is not clear on the correct
+   * queue for management frames if QoS is supported. We always use the DCF.
+   */
+  void SendAssociationRequest (void);
+  /**
+   * Try to ensure that we are associated with an AP by taking an appropriate action
+   * depending on the current association status.
+   */
+  void TryToEnsureAssociated (void);
+  /**
+   * This method is called after the association timeout occurred. We switch the state to
+   * WAIT_ASSOC_RESP and re-send an association request.
+   */
+  void AssocRequestTimeout (void);
+  /**
+   * This method is called after the probe request timeout occurred. We switch the state to
+   * WAIT_PROBE_RESP and re-send a probe request.
+   */
+  void ProbeRequestTimeout (void);
+  /**
+   * Return whether we are associated with an AP.
+   *
+   * \return true if we are associated with an AP, false otherwise
+   */
+  bool IsAssociated (void) const;
+  /**
+   * Return whether we are waiting for an association response from an AP.
+   *
+   * \return true if we are waiting for an association response from an AP, false otherwise
+   */
+  bool IsWaitAssocResp (void) const;
+  /**
+   * This method is called after we have not received a beacon from the AP
+   */
+  void MissedBeacons (void);
+  /**
+   * Restarts the beacon timer.
+   *
+   * \param delay the delay before the watchdog fires
+   */
+  void RestartBeaconWatchdog (Time delay);
+  /**
+   * Return an instance of SupportedRates that contains all rates that we support
+   * including HT rates.
+   *
+   * \return SupportedRates all rates that we support
+   */
+  SupportedRates GetSupportedRates (void) const;
+  /**
+   * Record the signal of a frame received by the PHY, before it is
+   * forwarded up to Receive.
+   *
+   * \param packet the frame
+   * \param channelFreqMhz the frequency of the channel
+   * \param channelNumber the channel number
+   * \param rate the data rate
+   * \param preamble the preamble
+   * \param txVector the TXVECTOR of the frame
+   * \param aMpdu the A-MPDU information
+   * \param signalNoise the signal and noise levels
+   */
+  void PhyRxSniffer (Ptr<const Packet> packet, uint16_t channelFreqMhz,
+                     uint16_t channelNumber, uint32_t rate, WifiPreamble preamble,
+                     WifiTxVector txVector, struct mpduInfo aMpdu,
+                     struct signalNoiseDbm signalNoise);
+  /**
+   * Cache the AP which sent the frame being received.
+   *
+   * \param bssid the BSSID of the AP
+   */
+  void UpdateCandidate (Mac48Address bssid);
+  /**
+   * Find the AP with the strongest signal among those heard recently.
+   * The APs which were not heard for CandidateLifetime are removed.
+   *
+   * \param exclude an AP which is not a candidate
+   * \param bssid the BSSID of the best AP
+   * \return true if an AP was found, false otherwise
+   */
+  bool GetBestCandidate (Mac48Address exclude, Mac48Address &bssid);
+  /**
+   * Roam to a cached AP if the signal of the AP has fallen below
+   * RoamingThreshold and the cached AP is RoamingHysteresis stronger.
+   */
+  void CheckRoaming (void);
+  /**
+   * Send an association request to a cached AP, switching to its
+   * channel if needed.
+   *
+   * \param bssid the BSSID of the AP
+   */
+  void Reassociate (Mac48Address bssid);
+  /**
+   * Set the current MAC state.
+   *
+   * \param value the new state
+   */
+  void SetState (enum MacState value);
+  /**
+   * Return the Capability information of the current STA.
+   *
+   * \return the Capability information that we support
+   */
+  CapabilityInformation GetCapabilities (void) const;
+
+  enum MacState m_state;
+  Time m_probeRequestTimeout;
+  Time m_assocRequestTimeout;
+  EventId m_probeRequestEvent;
+  EventId m_assocRequestEvent;
+  EventId m_beaconWatchdog;
+  Time m_beaconWatchdogEnd;
+  uint32_t m_maxMissedBeacons;
+  bool m_activeProbing;
+  bool m_candidateCache;
+  Time m_candidateLifetime;
+  double m_roamingThreshold;
+  double m_roamingHysteresis;
+  ApCandidates m_candidates;
+  double m_rxSignal;           //!< The signal of the last frame received, in dBm.
+  uint16_t m_rxChannel;        //!< The channel of the last frame received.
+  Time m_lastBeacon;           //!< When the last beacon of the AP was received.
+  bool m_handoff;              //!< Whether the STA lost or left an AP.
+  Mac48Address m_handoffBssid; //!< The AP it lost or left.
+  Time m_handoffStart;         //!< When the link with that AP was lost.
+
+  TracedCallback<Mac48Address> m_assocLogger;
+  TracedCallback<Mac48Address> m_deAssocLogger;
+  TracedCallback<Mac48Address, Mac48Address, Time> m_handoffLogger;
+};
+
+} //namespace ns3
+
+#endif /* STA_WIFI_MAC_H */
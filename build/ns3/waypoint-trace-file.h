@@ -0,0 +1,140 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef WAYPOINT_TRACE_FILE_H
+#define WAYPOINT_TRACE_FILE_H
+
+#include <string>
+#include <vector>
+#include <stdint.h>
+#include "ns3/simple-ref-count.h"
+#include "ns3/waypoint.h"
+
+namespace ns3 {
+
+/**
+ * \ingroup mobility
+ * \brief A binary file of the waypoints of many nodes, read through a
+ * read-only memory map.
+ *
+ * The file holds, in the byte order of the host which wrote it:
+ *  - a header: the 8 characters "NS3WAYPT", a 32-bit byte order mark
+ *    0x01020304 and the 32-bit number of nodes;
+ *  - an index: for each node, the 64-bit index of its first waypoint and
+ *    its 64-bit number of waypoints;
+ *  - the waypoints, as Record, those of each node contiguous and in
+ *    increasing time.
+ *
+ * Opening a file only maps it: the waypoints are read from the page
+ * cache when they are used, so that large traces start at once and only
+ * use the memory of the pages being read. The files are written by Write,
+ * or converted from ns-2 and CSV traces by WaypointTraceHelper.
+ */
+class WaypointTraceFile : public SimpleRefCount<WaypointTraceFile>
+{
+public:
+  /// A waypoint, as stored in the file.
+  struct Record
+  {
+    int64_t time;  //!< The time, in nanoseconds.
+    double x;      //!< The x coordinate, in meters.
+    double y;      //!< The y coordinate, in meters.
+    double z;      //!< The z coordinate, in meters.
+  };
+
+  WaypointTraceFile ();
+  ~WaypointTraceFile ();
+
+  /**
+   * \brief Map a waypoint file, closing the file mapped before.
+   * \param filename the name of the file
+   * \returns false if the file cannot be mapped or is not a valid
+   * waypoint file of this host
+   */
+  bool Open (std::string filename);
+  /// Unmap the file.
+  void Close (void);
+  /**
+   * \returns whether a file is mapped
+   */
+  bool IsOpen (void) const;
+  /**
+   * \returns the number of nodes of the file
+   */
+  uint32_t GetNNodes (void) const;
+  /**
+   * \param node a node of the file
+   * \returns its number of waypoints
+   */
+  uint64_t GetNWaypoints (uint32_t node) const;
+  /**
+   * \param node a node of the file
+   * \returns its waypoints, in increasing time, valid until the file is
+   * closed
+   */
+  const Record * GetWaypoints (uint32_t node) const;
+  /**
+   * \param node a node of the file
+   * \param index the index of one of its waypoints
+   * \returns the waypoint
+   */
+  Waypoint GetWaypoint (uint32_t node, uint64_t index) const;
+
+  /**
+   * \brief Write a waypoint file.
+   * \param filename the name of the file
+   * \param waypoints the waypoints of each node, in increasing time
+   * \returns false if the file cannot be written
+   */
+  static bool Write (std::string filename, const std::vector<std::vector<Waypoint> > &waypoints);
+
+private:
+  /**
+   * \brief Copy constructor, not implemented: the file is mapped once.
+   * \param o the other file
+   */
+  WaypointTraceFile (const WaypointTraceFile &o);
+  /**
+   * \brief Assignment operator, not implemented.
+   * \param o the other file
+   * \returns the file
+   */
+  WaypointTraceFile &operator = (const WaypointTraceFile &o);
+
+  /// The header of a file.
+  struct Header
+  {
+    char magic[8];       //!< "NS3WAYPT".
+    uint32_t byteOrder;  //!< 0x01020304 in the byte order of the file.
+    uint32_t nNodes;     //!< The number of nodes.
+  };
+  /// The waypoints of a node.
+  struct IndexEntry
+  {
+    uint64_t first;      //!< The index of the first waypoint.
+    uint64_t count;      //!< The number of waypoints.
+  };
+
+  void *m_map;                  //!< The mapped file, or 0.
+  uint64_t m_size;              //!< The size of the mapped file.
+  uint32_t m_nNodes;            //!< The number of nodes.
+  const IndexEntry *m_index;    //!< The index.
+  const Record *m_records;      //!< The waypoints.
+};
+
+} // namespace ns3
+
+#endif /* WAYPOINT_TRACE_FILE_H */
@@ -0,0 +1,117 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef WAYPOINT_TRACE_HELPER_H
+#define WAYPOINT_TRACE_HELPER_H
+
+#include <string>
+#include <stdint.h>
+#include "ns3/ptr.h"
+#include "ns3/node.h"
+#include "ns3/node-container.h"
+#include "ns3/waypoint-trace-file.h"
+
+namespace ns3 {
+
+class WaypointMobilityModel;
+
+/**
+ * \ingroup mobility
+ * \brief Helper class which moves nodes along the waypoints of a
+ * WaypointTraceFile, and converts ns-2 and CSV traces to such files.
+ *
+ * Each node gets a WaypointMobilityModel, which is given its waypoints
+ * one at a time, as it moves: a node is always given the waypoint after
+ * the one it is moving to, and nothing more. Unlike Ns2MobilityHelper,
+ * which parses the whole trace and schedules all its movements when it
+ * is installed, installing the nodes costs a few events per node, and
+ * the memory used by the nodes does not depend on the length of the
+ * trace. The mapped file is kept until the last node is done with it.
+ *
+ * Usage:
+ \code
+   WaypointTraceHelper::ConvertNs2 ("movements.ns2", "movements.wpt");
+   WaypointTraceHelper waypoints ("movements.wpt");
+   waypoints.Install (nodes);
+ \endcode
+ */
+class WaypointTraceHelper
+{
+public:
+  /**
+   * \param filename the name of a waypoint file
+   */
+  WaypointTraceHelper (std::string filename);
+
+  /**
+   * \returns the number of nodes of the file
+   */
+  uint32_t GetNNodes (void) const;
+  /**
+   * \brief Move the nodes of the global NodeList whose identifier is a
+   * node of the file.
+   */
+  void Install (void) const;
+  /**
+   * \brief Move the nodes of a container, the i-th node along the
+   * waypoints of the i-th node of the file.
+   * \param nodes the nodes
+   */
+  void Install (NodeContainer nodes) const;
+  /**
+   * \brief Move a node.
+   * \param node the node
+   * \param index the node of the file it follows
+   */
+  void Install (Ptr<Node> node, uint32_t index) const;
+
+  /**
+   * \brief Convert an ns-2 movement trace to a waypoint file.
+   * \param ns2File the name of the ns-2 trace, in the format read by
+   * Ns2MobilityHelper
+   * \param waypointFile the name of the waypoint file
+   *
+   * A movement interrupted by the next one of its node ends where the node
+   * was at that time, and a position set at a given time is reached one
+   * nanosecond later.
+   */
+  static void ConvertNs2 (std::string ns2File, std::string waypointFile);
+  /**
+   * \brief Convert a CSV trace to a waypoint file.
+   * \param csvFile the name of the CSV trace, with one waypoint per line,
+   * as "node,time,x,y" or "node,time,x,y,z", the time in seconds; the
+   * empty lines, the lines starting with '#' and a header line are skipped
+   * \param waypointFile the name of the waypoint file
+   */
+  static void ConvertCsv (std::string csvFile, std::string waypointFile);
+
+private:
+  /**
+   * \brief Give a node its next waypoints.
+   * \param file the waypoint file
+   * \param model the mobility model of the node
+   * \param index the node of the file it follows
+   * \param next the index of the next waypoint of the node
+   */
+  static void Feed (Ptr<WaypointTraceFile> file, Ptr<WaypointMobilityModel> model,
+                    uint32_t index, uint64_t next);
+
+  Ptr<WaypointTraceFile> m_file;  //!< The waypoint file.
+};
+
+} // namespace ns3
+
+#endif /* WAYPOINT_TRACE_HELPER_H */
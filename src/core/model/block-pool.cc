@@ -0,0 +1,165 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "block-pool.h"
+#include "ns3/core-config.h"
+#include <new>
+#ifdef HAVE_PTHREAD_H
+#include <pthread.h>
+#endif
+
+/**
+ * \file
+ * \ingroup core
+ * ns3::BlockPool implementation.
+ */
+
+namespace ns3 {
+
+#ifdef HAVE_PTHREAD_H
+/**
+ * The key whose destructor releases the states of an exiting thread.
+ * Its value is the last state registered by the thread, chained to
+ * the previous ones.
+ */
+static pthread_key_t g_blockPoolKey;
+/** Create g_blockPoolKey once. */
+static pthread_once_t g_blockPoolKeyOnce = PTHREAD_ONCE_INIT;
+#endif /* HAVE_PTHREAD_H */
+
+BlockPool::Cleanup::Cleanup (State *state)
+  : m_state (state)
+{
+}
+
+BlockPool::Cleanup::~Cleanup ()
+{
+  Release (m_state);
+}
+
+void
+BlockPool::Release (State *state)
+{
+  state->released = true;
+  for (std::size_t i = 0; i < MAX_CLASSES; i++)
+    {
+      while (state->free[i] != 0)
+        {
+          Block *block = state->free[i];
+          state->free[i] = block->next;
+          ::operator delete (block);
+        }
+      state->count[i] = 0;
+    }
+}
+
+void
+BlockPool::ReleaseThread (void *states)
+{
+  for (State *state = static_cast<State *> (states); state != 0; state = state->next)
+    {
+      Release (state);
+    }
+}
+
+void
+BlockPool::CreateKey (void)
+{
+#ifdef HAVE_PTHREAD_H
+  pthread_key_create (&g_blockPoolKey, &BlockPool::ReleaseThread);
+#endif /* HAVE_PTHREAD_H */
+}
+
+void
+BlockPool::Register (State *state)
+{
+  state->registered = true;
+#ifdef HAVE_PTHREAD_H
+  pthread_once (&g_blockPoolKeyOnce, &BlockPool::CreateKey);
+  state->next = static_cast<State *> (pthread_getspecific (g_blockPoolKey));
+  pthread_setspecific (g_blockPoolKey, state);
+#endif /* HAVE_PTHREAD_H */
+}
+
+void *
+BlockPool::Allocate (State *state, std::size_t classes, std::size_t size)
+{
+  state->allocations++;
+  std::size_t sizeClass = (size - 1) / GRANULE;
+  if (size == 0 || sizeClass >= classes)
+    {
+      return ::operator new (size);
+    }
+  Block *block = state->free[sizeClass];
+  if (block == 0)
+    {
+      return ::operator new ((sizeClass + 1) * GRANULE);
+    }
+  state->free[sizeClass] = block->next;
+  state->count[sizeClass]--;
+  state->reuses++;
+  return block;
+}
+
+void
+BlockPool::Deallocate (State *state, std::size_t classes, void *p, std::size_t size)
+{
+  if (p == 0)
+    {
+      return;
+    }
+  state->deallocations++;
+  std::size_t sizeClass = (size - 1) / GRANULE;
+  if (size == 0 || sizeClass >= classes
+      || state->count[sizeClass] >= MAX_FREE
+      || state->released)
+    {
+      ::operator delete (p);
+      return;
+    }
+  if (!state->registered)
+    {
+      Register (state);
+    }
+  Block *block = static_cast<Block *> (p);
+  block->next = state->free[sizeClass];
+  state->free[sizeClass] = block;
+  state->count[sizeClass]++;
+}
+
+std::size_t
+BlockPool::GetCapacity (std::size_t classes, std::size_t size)
+{
+  std::size_t sizeClass = (size - 1) / GRANULE;
+  if (size == 0 || sizeClass >= classes)
+    {
+      return size;
+    }
+  return (sizeClass + 1) * GRANULE;
+}
+
+uint64_t
+BlockPool::GetFree (const State *state)
+{
+  uint64_t free = 0;
+  for (std::size_t i = 0; i < MAX_CLASSES; i++)
+    {
+      free += state->count[i];
+    }
+  return free;
+}
+
+} // namespace ns3
@@ -0,0 +1,159 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef BLOCK_POOL_H
+#define BLOCK_POOL_H
+
+#include <stdint.h>
+#include <cstddef>
+
+/**
+ * \file
+ * \ingroup core
+ * ns3::BlockPool declaration.
+ */
+
+namespace ns3 {
+
+/**
+ * \ingroup core
+ * \brief Free lists of small memory blocks, in 16-byte size classes.
+ *
+ * A released block is kept in the free list of its size class and
+ * reused by the next allocation of the same class, so that objects
+ * created and destroyed at a high rate do not go through malloc and
+ * free. Blocks larger than the size classes of the pool are not pooled.
+ *
+ * The free lists are per thread, so that they need no lock: a user of
+ * the pool keeps a zero-initialized thread-local State, and passes it
+ * with its number of size classes to every call. The free blocks of a
+ * thread go back to the heap when it exits, and those of the main
+ * thread at the end of the program, through a static Cleanup object.
+ * Blocks released after that are not pooled.
+ */
+class BlockPool
+{
+public:
+  /** Size classes are multiples of this. */
+  static const std::size_t GRANULE = 16;
+  /** Maximum number of size classes of a pool. */
+  static const std::size_t MAX_CLASSES = 16;
+  /** Maximum number of free blocks kept per size class and per thread. */
+  static const uint32_t MAX_FREE = 4096;
+
+  /** A free block, chained in the free list of its size class. */
+  struct Block
+  {
+    Block *next;  //!< The next free block.
+  };
+
+  /**
+   * The free lists and the statistics of a thread. It must be
+   * zero-initialized, as thread-local variables are.
+   */
+  struct State
+  {
+    Block *free[MAX_CLASSES];    //!< The free lists, one per size class.
+    uint32_t count[MAX_CLASSES]; //!< The length of each free list.
+    uint64_t allocations;        //!< Number of blocks allocated.
+    uint64_t reuses;             //!< Number of allocations served by a free list.
+    uint64_t deallocations;      //!< Number of blocks released.
+    State *next;                 //!< The next state to release when the thread exits.
+    bool registered;             //!< The release at thread exit is registered.
+    bool released;               //!< The free lists were released, blocks go back to the heap.
+  };
+
+  /**
+   * \brief Release the state of the main thread at exit.
+   *
+   * The thread keys are not destroyed when the process exits, so the
+   * blocks of the thread running the static destructors are released
+   * by a static object of this class.
+   */
+  class Cleanup
+  {
+  public:
+    /**
+     * \param [in] state The state of the thread constructing this object.
+     */
+    Cleanup (State *state);
+    /** Release the state. */
+    ~Cleanup ();
+  private:
+    State *m_state;  //!< The state to release.
+  };
+
+  /**
+   * Allocate a block.
+   *
+   * \param [in] state The state of the calling thread.
+   * \param [in] classes The number of size classes of the pool, at most
+   *             MAX_CLASSES: blocks of up to classes * GRANULE bytes are
+   *             pooled.
+   * \param [in] size The size of the block.
+   * \returns The block, of GetCapacity (classes, size) bytes.
+   */
+  static void * Allocate (State *state, std::size_t classes, std::size_t size);
+  /**
+   * Release a block.
+   *
+   * \param [in] state The state of the calling thread.
+   * \param [in] classes The number of size classes of the pool.
+   * \param [in] p The block.
+   * \param [in] size The size given to Allocate, or the capacity
+   *             of the block.
+   */
+  static void Deallocate (State *state, std::size_t classes, void *p, std::size_t size);
+  /**
+   * \param [in] classes The number of size classes of the pool.
+   * \param [in] size The size of a block.
+   * \returns The number of bytes usable in a block allocated for size
+   *          bytes.
+   */
+  static std::size_t GetCapacity (std::size_t classes, std::size_t size);
+  /**
+   * \param [in] state The state of a thread.
+   * \returns The number of blocks in its free lists.
+   */
+  static uint64_t GetFree (const State *state);
+
+private:
+  /**
+   * Give the free blocks of a state back to the heap.
+   *
+   * \param [in] state The state.
+   */
+  static void Release (State *state);
+  /**
+   * Release the states of an exiting thread.
+   *
+   * \param [in] states The last state registered by the thread.
+   */
+  static void ReleaseThread (void *states);
+  /**
+   * Release a state when its thread exits, before its first block is
+   * kept in a free list.
+   *
+   * \param [in] state The state of the calling thread.
+   */
+  static void Register (State *state);
+  /** Create the key releasing the states of the exiting threads. */
+  static void CreateKey (void);
+};
+
+} // namespace ns3
+
+#endif /* BLOCK_POOL_H */
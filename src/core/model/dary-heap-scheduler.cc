@@ -0,0 +1,229 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "dary-heap-scheduler.h"
+#include "event-impl.h"
+#include "assert.h"
+#include "log.h"
+
+/**
+ * \file
+ * \ingroup scheduler
+ * Implementation of ns3::DaryHeapScheduler class.
+ */
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("DaryHeapScheduler");
+
+NS_OBJECT_ENSURE_REGISTERED (DaryHeapScheduler);
+
+/** Marks the end of the free slot list. */
+static const uint32_t NO_SLOT = 0xffffffff;
+
+TypeId
+DaryHeapScheduler::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::DaryHeapScheduler")
+    .SetParent<Scheduler> ()
+    .SetGroupName ("Core")
+    .AddConstructor<DaryHeapScheduler> ()
+  ;
+  return tid;
+}
+
+DaryHeapScheduler::DaryHeapScheduler ()
+  : m_freeSlot (NO_SLOT)
+{
+  NS_LOG_FUNCTION (this);
+}
+
+DaryHeapScheduler::~DaryHeapScheduler ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+bool
+DaryHeapScheduler::IsLess (const Node &a, const Node &b)
+{
+  return a.ts < b.ts || (a.ts == b.ts && a.uid < b.uid);
+}
+
+void
+DaryHeapScheduler::SiftUp (uint32_t index, Node node)
+{
+  NS_LOG_FUNCTION (this << index);
+  while (index > 0)
+    {
+      uint32_t parent = (index - 1) / ARITY;
+      if (!IsLess (node, m_heap[parent]))
+        {
+          break;
+        }
+      m_heap[index] = m_heap[parent];
+      index = parent;
+    }
+  m_heap[index] = node;
+}
+
+void
+DaryHeapScheduler::SiftDown (uint32_t index, Node node)
+{
+  NS_LOG_FUNCTION (this << index);
+  uint32_t size = m_heap.size ();
+  while (true)
+    {
+      uint32_t first = index * ARITY + 1;
+      if (first >= size)
+        {
+          break;
+        }
+      uint32_t last = first + ARITY;
+      if (last > size)
+        {
+          last = size;
+        }
+      uint32_t smallest = first;
+      for (uint32_t child = first + 1; child < last; child++)
+        {
+          if (IsLess (m_heap[child], m_heap[smallest]))
+            {
+              smallest = child;
+            }
+        }
+      if (!IsLess (m_heap[smallest], node))
+        {
+          break;
+        }
+      m_heap[index] = m_heap[smallest];
+      index = smallest;
+    }
+  m_heap[index] = node;
+}
+
+void
+DaryHeapScheduler::RemoveAt (uint32_t index)
+{
+  NS_LOG_FUNCTION (this << index);
+  Node last = m_heap.back ();
+  m_heap.pop_back ();
+  if (index == m_heap.size ())
+    {
+      return;
+    }
+  if (index > 0 && IsLess (last, m_heap[(index - 1) / ARITY]))
+    {
+      SiftUp (index, last);
+    }
+  else
+    {
+      SiftDown (index, last);
+    }
+}
+
+uint32_t
+DaryHeapScheduler::AllocateSlot (const Scheduler::Event &ev)
+{
+  NS_LOG_FUNCTION (this << &ev);
+  uint32_t slot;
+  if (m_freeSlot != NO_SLOT)
+    {
+      slot = m_freeSlot;
+      m_freeSlot = m_slots[slot].next;
+    }
+  else
+    {
+      slot = m_slots.size ();
+      m_slots.push_back (Slot ());
+    }
+  m_slots[slot].impl = ev.impl;
+  m_slots[slot].context = ev.key.m_context;
+  return slot;
+}
+
+Scheduler::Event
+DaryHeapScheduler::GetEvent (const Node &node) const
+{
+  const Slot &slot = m_slots[node.slot];
+  Scheduler::Event ev;
+  ev.impl = slot.impl;
+  ev.key.m_ts = node.ts;
+  ev.key.m_uid = node.uid;
+  ev.key.m_context = slot.context;
+  return ev;
+}
+
+void
+DaryHeapScheduler::Insert (const Event &ev)
+{
+  NS_LOG_FUNCTION (this << &ev);
+  Node node;
+  node.ts = ev.key.m_ts;
+  node.uid = ev.key.m_uid;
+  node.slot = AllocateSlot (ev);
+  m_heap.push_back (node);
+  SiftUp (m_heap.size () - 1, node);
+}
+
+bool
+DaryHeapScheduler::IsEmpty (void) const
+{
+  NS_LOG_FUNCTION (this);
+  return m_heap.empty ();
+}
+
+Scheduler::Event
+DaryHeapScheduler::PeekNext (void) const
+{
+  NS_LOG_FUNCTION (this);
+  NS_ASSERT (!m_heap.empty ());
+  return GetEvent (m_heap[0]);
+}
+
+Scheduler::Event
+DaryHeapScheduler::RemoveNext (void)
+{
+  NS_LOG_FUNCTION (this);
+  NS_ASSERT (!m_heap.empty ());
+  Node top = m_heap[0];
+  Event next = GetEvent (top);
+  m_slots[top.slot].next = m_freeSlot;
+  m_freeSlot = top.slot;
+  RemoveAt (0);
+  return next;
+}
+
+void
+DaryHeapScheduler::Remove (const Event &ev)
+{
+  NS_LOG_FUNCTION (this << &ev);
+  uint32_t uid = ev.key.m_uid;
+  for (uint32_t i = 0; i < m_heap.size (); i++)
+    {
+      if (uid == m_heap[i].uid)
+        {
+          uint32_t slot = m_heap[i].slot;
+          NS_ASSERT (m_slots[slot].impl == ev.impl);
+          m_slots[slot].next = m_freeSlot;
+          m_freeSlot = slot;
+          RemoveAt (i);
+          return;
+        }
+    }
+  NS_ASSERT (false);
+}
+
+} // namespace ns3
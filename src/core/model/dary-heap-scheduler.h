@@ -0,0 +1,143 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef DARY_HEAP_SCHEDULER_H
+#define DARY_HEAP_SCHEDULER_H
+
+#include "scheduler.h"
+#include <stdint.h>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup scheduler
+ * Declaration of ns3::DaryHeapScheduler class.
+ */
+
+namespace ns3 {
+
+/**
+ * \ingroup scheduler
+ * \brief a 4-ary heap event scheduler
+ *
+ * Same algorithm as HeapScheduler, with two changes aimed at the
+ * memory traffic of the sifts:
+ *  - each node has four children instead of two, which halves the
+ *    depth of the heap. The four children are contiguous, so a
+ *    top-down step reads one cache line.
+ *  - the heap only holds a 16 byte node: the timestamp, the uid and
+ *    the index of a slot holding the rest of the event (the EventImpl
+ *    and the context). Four nodes fit in a 64 byte cache line and the
+ *    slots never move while the heap is reordered. Free slots are
+ *    chained and reused, so the steady state does no allocation.
+ *
+ * Indexes start at 0: the children of node i are 4i+1 to 4i+4.
+ */
+class DaryHeapScheduler : public Scheduler
+{
+public:
+  /**
+   *  Register this type.
+   *  \return The object TypeId.
+   */
+  static TypeId GetTypeId (void);
+
+  /** Constructor. */
+  DaryHeapScheduler ();
+  /** Destructor. */
+  virtual ~DaryHeapScheduler ();
+
+  // Inherited
+  virtual void Insert (const Scheduler::Event &ev);
+  virtual bool IsEmpty (void) const;
+  virtual Scheduler::Event PeekNext (void) const;
+  virtual Scheduler::Event RemoveNext (void);
+  virtual void Remove (const Scheduler::Event &ev);
+
+private:
+  /** The number of children of a node. */
+  static const uint32_t ARITY = 4;
+
+  /** Heap node: the sort key and the slot of the event. */
+  struct Node
+  {
+    uint64_t ts;     /**< Event time stamp. */
+    uint32_t uid;    /**< Event unique id. */
+    uint32_t slot;   /**< Index of the event in m_slots. */
+  };
+
+  /** The part of an event which does not take part in the ordering. */
+  struct Slot
+  {
+    EventImpl *impl;   /**< Pointer to the event implementation. */
+    uint32_t context;  /**< Event context. */
+    uint32_t next;     /**< Next free slot, when this one is free. */
+  };
+
+  /**
+   * Compare (less than) two nodes.
+   *
+   * \param [in] a The first node.
+   * \param [in] b The second node.
+   * \returns \c true if \p a is earlier than \p b.
+   */
+  static inline bool IsLess (const Node &a, const Node &b);
+  /**
+   * Move a node up from a position until its parent is earlier.
+   *
+   * \param [in] index The position of the hole.
+   * \param [in] node The node to place.
+   */
+  void SiftUp (uint32_t index, Node node);
+  /**
+   * Move a node down from a position until its children are later.
+   *
+   * \param [in] index The position of the hole.
+   * \param [in] node The node to place.
+   */
+  void SiftDown (uint32_t index, Node node);
+  /**
+   * Remove the node at a position and restore the heap order.
+   *
+   * \param [in] index The position of the node.
+   */
+  void RemoveAt (uint32_t index);
+  /**
+   * Store an event in a free slot.
+   *
+   * \param [in] ev The event.
+   * \returns The slot index.
+   */
+  uint32_t AllocateSlot (const Scheduler::Event &ev);
+  /**
+   * Rebuild the event held by a node.
+   *
+   * \param [in] node The node.
+   * \returns The event.
+   */
+  Scheduler::Event GetEvent (const Node &node) const;
+
+  /** The heap. */
+  std::vector<Node> m_heap;
+  /** The event slots. */
+  std::vector<Slot> m_slots;
+  /** The head of the free slot list. */
+  uint32_t m_freeSlot;
+};
+
+} // namespace ns3
+
+#endif /* DARY_HEAP_SCHEDULER_H */
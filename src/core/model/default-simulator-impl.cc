@@ -58,6 +58,7 @@ DefaultSimulatorImpl::GetTypeId (void)
 }
 
 DefaultSimulatorImpl::DefaultSimulatorImpl ()
+  : m_eventsWithContextRing (EVENTS_WITH_CONTEXT_RING)
 {
   NS_LOG_FUNCTION (this);
   m_stop = false;
@@ -71,7 +72,7 @@ DefaultSimulatorImpl::DefaultSimulatorImpl ()
   m_currentTs = 0;
   m_currentContext = 0xffffffff;
   m_unscheduledEvents = 0;
-  m_eventsWithContextEmpty = true;
+  m_eventsWithContextOverflow = false;
   m_main = SystemThread::Self();
 }
 
@@ -158,33 +159,52 @@ DefaultSimulatorImpl::IsFinished (void) const
   return m_events->IsEmpty () || m_stop;
 }
 
+void
+DefaultSimulatorImpl::InsertEventWithContext (const EventWithContext &event)
+{
+  Scheduler::Event ev;
+  ev.impl = event.event;
+  ev.key.m_ts = m_currentTs + event.timestamp;
+  ev.key.m_context = event.context;
+  ev.key.m_uid = m_uid;
+  m_uid++;
+  m_unscheduledEvents++;
+  m_events->Insert (ev);
+}
+
 void
 DefaultSimulatorImpl::ProcessEventsWithContext (void)
 {
-  if (m_eventsWithContextEmpty)
+  // The ring first: the events of a thread are only in the list if
+  // they are later than its events in the ring.
+  EventWithContext event;
+  while (m_eventsWithContextRing.Pop (event))
+    {
+      InsertEventWithContext (event);
+    }
+  if (!__atomic_load_n (&m_eventsWithContextOverflow, __ATOMIC_ACQUIRE))
     {
       return;
     }
-
   // swap queues
   EventsWithContext eventsWithContext;
   {
     CriticalSection cs (m_eventsWithContextMutex);
+    // A thread may have claimed a cell of the ring, not yet filled
+    // when the ring was drained above, before adding its next events
+    // to the list: the list waits until every claimed cell has been
+    // drained. Meanwhile all the threads keep adding to the list.
+    if (!m_eventsWithContextRing.IsDrained ())
+      {
+        return;
+      }
     m_eventsWithContext.swap(eventsWithContext);
-    m_eventsWithContextEmpty = true;
+    __atomic_store_n (&m_eventsWithContextOverflow, false, __ATOMIC_RELEASE);
   }
   while (!eventsWithContext.empty ())
     {
-       EventWithContext event = eventsWithContext.front ();
+       InsertEventWithContext (eventsWithContext.front ());
        eventsWithContext.pop_front ();
-       Scheduler::Event ev;
-       ev.impl = event.event;
-       ev.key.m_ts = m_currentTs + event.timestamp;
-       ev.key.m_context = event.context;
-       ev.key.m_uid = m_uid;
-       m_uid++;
-       m_unscheduledEvents++;
-       m_events->Insert (ev);
     }
 }
 
@@ -269,11 +289,13 @@ DefaultSimulatorImpl::ScheduleWithContext (uint32_t context, Time const &delay,
       // Current time added in ProcessEventsWithContext()
       ev.timestamp = delay.GetTimeStep ();
       ev.event = event;
-      {
-        CriticalSection cs (m_eventsWithContextMutex);
-        m_eventsWithContext.push_back(ev);
-        m_eventsWithContextEmpty = false;
-      }
+      if (__atomic_load_n (&m_eventsWithContextOverflow, __ATOMIC_ACQUIRE)
+          || !m_eventsWithContextRing.Push (ev))
+        {
+          CriticalSection cs (m_eventsWithContextMutex);
+          m_eventsWithContext.push_back(ev);
+          __atomic_store_n (&m_eventsWithContextOverflow, true, __ATOMIC_RELEASE);
+        }
     }
 }
 
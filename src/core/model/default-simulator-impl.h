@@ -26,6 +26,7 @@
 #include "event-impl.h"
 #include "system-thread.h"
 #include "ns3/system-mutex.h"
+#include "mpsc-ring.h"
 
 #include "ptr.h"
 
@@ -95,15 +96,33 @@ private:
     /** The event implementation. */
     EventImpl *event;
   };
+  /**
+   * Insert an event from a different context in the main event queue.
+   *
+   * \param [in] event The event.
+   */
+  void InsertEventWithContext (const EventWithContext &event);
+  /** Capacity of the ring of events from a different context. */
+  static const uint32_t EVENTS_WITH_CONTEXT_RING = 1024;
+  /**
+   * The events from a different context. Other threads push to it
+   * without a lock, they are moved to the main event queue after
+   * each event.
+   */
+  MpscRing<struct EventWithContext> m_eventsWithContextRing;
   /** Container type for the events from a different context. */
   typedef std::list<struct EventWithContext> EventsWithContext;
-  /** The container of events from a different context. */
+  /**
+   * The container of events from a different context, used when the
+   * ring is full.
+   */
   EventsWithContext m_eventsWithContext;
   /**
-   * Flag \c true if all events with context have been moved to the
-   * primary event queue.
+   * Flag \c true if m_eventsWithContext holds events. While it is set,
+   * other threads keep adding to m_eventsWithContext, so that the
+   * events of a thread are inserted in order.
    */
-  bool m_eventsWithContextEmpty;
+  bool m_eventsWithContextOverflow;
   /** Mutex to control access to the list of events with context. */
   SystemMutex m_eventsWithContextMutex;
 
@@ -19,6 +19,7 @@
  */
 
 #include "event-impl.h"
+#include "block-pool.h"
 #include "log.h"
 
 /**
@@ -31,6 +32,30 @@ namespace ns3 {
 
 NS_LOG_COMPONENT_DEFINE ("EventImpl");
 
+/** Number of size classes of the event pool: events larger than 128 bytes are not pooled. */
+static const std::size_t EVENT_POOL_CLASSES = 8;
+
+/**
+ * The free lists of the events, per thread, so that the realtime and
+ * distributed simulators, which create events from several threads,
+ * need no lock.
+ */
+static __thread BlockPool::State g_eventPool;
+/** Releases the event pool of the main thread at exit. */
+static BlockPool::Cleanup g_eventPoolCleanup (&g_eventPool);
+
+void *
+EventImpl::operator new (std::size_t size)
+{
+  return BlockPool::Allocate (&g_eventPool, EVENT_POOL_CLASSES, size);
+}
+
+void
+EventImpl::operator delete (void *p, std::size_t size)
+{
+  BlockPool::Deallocate (&g_eventPool, EVENT_POOL_CLASSES, p, size);
+}
+
 EventImpl::~EventImpl ()
 {
   NS_LOG_FUNCTION (this);
@@ -21,6 +21,7 @@
 #define EVENT_IMPL_H
 
 #include <stdint.h>
+#include <cstddef>
 #include "simple-ref-count.h"
 
 /**
@@ -40,6 +41,11 @@ namespace ns3 {
  * when it reaches the time associated to this event. Most subclasses
  * are usually created by one of the many Simulator::Schedule
  * methods.
+ *
+ * Events are allocated from the size-classed free lists of a BlockPool
+ * (one per thread) rather than directly from the heap: the memory of a
+ * released event is kept and reused by the next event of the same size
+ * class.
  */
 class EventImpl : public SimpleRefCount<EventImpl>
 {
@@ -66,6 +72,21 @@ public:
    */
   bool IsCancelled (void);
 
+  /**
+   * Allocate an event from the free list of its size class.
+   *
+   * \param [in] size The size of the event.
+   * \returns The memory of the event.
+   */
+  static void * operator new (std::size_t size);
+  /**
+   * Return the memory of an event to the free list of its size class.
+   *
+   * \param [in] p The memory of the event.
+   * \param [in] size The size of the event.
+   */
+  static void operator delete (void *p, std::size_t size);
+
 protected:
   /**
    * Implementation for Invoke().
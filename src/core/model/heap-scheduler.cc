@@ -236,6 +236,13 @@ HeapScheduler::Remove (const Event &ev)
           NS_ASSERT (m_heap[i].impl == ev.impl);
           Exch (i, Last ());
           m_heap.pop_back ();
+          // the event moved into the hole may be earlier than its parent
+          while (i < m_heap.size () && !IsRoot (i)
+                 && IsLessStrictly (i, Parent (i)))
+            {
+              Exch (i, Parent (i));
+              i = Parent (i);
+            }
           TopDown (i);
           return;
         }
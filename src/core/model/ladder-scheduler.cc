@@ -0,0 +1,329 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ladder-scheduler.h"
+#include "event-impl.h"
+#include "assert.h"
+#include "log.h"
+#include <algorithm>
+
+/**
+ * \file
+ * \ingroup scheduler
+ * Implementation of ns3::LadderScheduler class.
+ */
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("LadderScheduler");
+
+NS_OBJECT_ENSURE_REGISTERED (LadderScheduler);
+
+TypeId
+LadderScheduler::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::LadderScheduler")
+    .SetParent<Scheduler> ()
+    .SetGroupName ("Core")
+    .AddConstructor<LadderScheduler> ()
+  ;
+  return tid;
+}
+
+LadderScheduler::LadderScheduler ()
+  : m_topMin (~(uint64_t)0),
+    m_topMax (0),
+    m_topStart (0),
+    m_rungs (MAX_RUNGS),
+    m_nRungs (0),
+    m_bottomHead (0),
+    m_size (0)
+{
+  NS_LOG_FUNCTION (this);
+}
+
+LadderScheduler::~LadderScheduler ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+uint64_t
+LadderScheduler::GetCurrent (const Rung &rung)
+{
+  return rung.start + rung.current * rung.width;
+}
+
+uint32_t
+LadderScheduler::FindRung (uint64_t ts) const
+{
+  for (uint32_t i = 0; i < m_nRungs; i++)
+    {
+      if (ts >= GetCurrent (m_rungs[i]))
+        {
+          return i;
+        }
+    }
+  return m_nRungs;
+}
+
+uint64_t
+LadderScheduler::SpawnRung (const Scheduler::Event *begin, const Scheduler::Event *end,
+                            uint64_t start, uint64_t limit)
+{
+  NS_LOG_FUNCTION (this << (end - begin) << start << limit);
+  NS_ASSERT (m_nRungs < MAX_RUNGS);
+  NS_ASSERT (limit > start);
+  uint64_t span = limit - start;
+  uint64_t nBuckets = std::min<uint64_t> (end - begin, span);
+  Rung &rung = m_rungs[m_nRungs];
+  rung.start = start;
+  rung.width = (span + nBuckets - 1) / nBuckets;
+  rung.current = 0;
+  rung.nBuckets = nBuckets;
+  rung.count = end - begin;
+  if (rung.buckets.size () < nBuckets)
+    {
+      rung.buckets.resize (nBuckets);
+    }
+  for (const Scheduler::Event *i = begin; i != end; i++)
+    {
+      uint64_t bucket = (i->key.m_ts - start) / rung.width;
+      NS_ASSERT (bucket < nBuckets);
+      rung.buckets[bucket].push_back (*i);
+    }
+  m_nRungs++;
+  return start + rung.width * nBuckets;
+}
+
+void
+LadderScheduler::InsertBottom (const Scheduler::Event &ev)
+{
+  NS_LOG_FUNCTION (this << &ev);
+  // Events are mostly scheduled later than the ones already there:
+  // search from the end.
+  std::vector<Scheduler::Event>::iterator head = m_bottom.begin () + m_bottomHead;
+  std::vector<Scheduler::Event>::iterator i = m_bottom.end ();
+  while (i != head && ev.key < (i - 1)->key)
+    {
+      --i;
+    }
+  m_bottom.insert (i, ev);
+
+  uint32_t n = m_bottom.size () - m_bottomHead;
+  if (n > THRESHOLD && m_nRungs < MAX_RUNGS
+      && m_bottom[m_bottomHead].key.m_ts != m_bottom.back ().key.m_ts)
+    {
+      // the Bottom list grows: move it to a rung below the others.
+      uint64_t limit = m_nRungs > 0 ? GetCurrent (m_rungs[m_nRungs - 1]) : m_topStart;
+      SpawnRung (&m_bottom[m_bottomHead], &m_bottom[0] + m_bottom.size (),
+                 m_bottom[m_bottomHead].key.m_ts, limit);
+      m_bottom.clear ();
+      m_bottomHead = 0;
+    }
+}
+
+void
+LadderScheduler::SetBottom (std::vector<Scheduler::Event> &events)
+{
+  NS_LOG_FUNCTION (this << events.size ());
+  NS_ASSERT (m_bottomHead == m_bottom.size ());
+  std::sort (events.begin (), events.end ());
+  m_bottom.assign (events.begin (), events.end ());
+  m_bottomHead = 0;
+  events.clear ();
+}
+
+void
+LadderScheduler::TransferTop (void)
+{
+  NS_LOG_FUNCTION (this << m_top.size ());
+  NS_ASSERT (m_nRungs == 0);
+  if (m_top.size () <= THRESHOLD)
+    {
+      m_topStart = m_topMax + 1;
+      SetBottom (m_top);
+    }
+  else
+    {
+      m_topStart = SpawnRung (&m_top[0], &m_top[0] + m_top.size (),
+                              m_topMin, m_topMax + 1);
+      m_top.clear ();
+    }
+  m_topMin = ~(uint64_t)0;
+  m_topMax = 0;
+}
+
+void
+LadderScheduler::FillBottom (void)
+{
+  NS_LOG_FUNCTION (this);
+  while (m_bottomHead == m_bottom.size ())
+    {
+      if (m_nRungs == 0)
+        {
+          if (m_top.empty ())
+            {
+              return;
+            }
+          TransferTop ();
+          continue;
+        }
+      Rung &rung = m_rungs[m_nRungs - 1];
+      if (rung.count == 0)
+        {
+          m_nRungs--;
+          continue;
+        }
+      while (rung.buckets[rung.current].empty ())
+        {
+          rung.current++;
+        }
+      std::vector<Scheduler::Event> &bucket = rung.buckets[rung.current];
+      uint64_t start = GetCurrent (rung);
+      rung.current++;
+      rung.count -= bucket.size ();
+      if (bucket.size () > THRESHOLD && rung.width > 1 && m_nRungs < MAX_RUNGS)
+        {
+          SpawnRung (&bucket[0], &bucket[0] + bucket.size (),
+                     start, start + rung.width);
+          // large buckets are rare: do not keep their memory.
+          std::vector<Scheduler::Event> ().swap (bucket);
+        }
+      else
+        {
+          SetBottom (bucket);
+        }
+    }
+}
+
+void
+LadderScheduler::Insert (const Event &ev)
+{
+  NS_LOG_FUNCTION (this << &ev);
+  uint64_t ts = ev.key.m_ts;
+  m_size++;
+  if (ts >= m_topStart)
+    {
+      m_top.push_back (ev);
+      m_topMin = std::min (m_topMin, ts);
+      m_topMax = std::max (m_topMax, ts);
+      return;
+    }
+  uint32_t r = FindRung (ts);
+  if (r < m_nRungs)
+    {
+      Rung &rung = m_rungs[r];
+      uint64_t bucket = (ts - rung.start) / rung.width;
+      NS_ASSERT (bucket < rung.nBuckets);
+      rung.buckets[bucket].push_back (ev);
+      rung.count++;
+      return;
+    }
+  InsertBottom (ev);
+}
+
+bool
+LadderScheduler::IsEmpty (void) const
+{
+  NS_LOG_FUNCTION (this);
+  return m_size == 0;
+}
+
+Scheduler::Event
+LadderScheduler::PeekNext (void) const
+{
+  NS_LOG_FUNCTION (this);
+  NS_ASSERT (!IsEmpty ());
+  // Refilling the Bottom list does not change the set of events.
+  const_cast<LadderScheduler *> (this)->FillBottom ();
+  return m_bottom[m_bottomHead];
+}
+
+Scheduler::Event
+LadderScheduler::RemoveNext (void)
+{
+  NS_LOG_FUNCTION (this);
+  NS_ASSERT (!IsEmpty ());
+  FillBottom ();
+  m_size--;
+  Scheduler::Event ev = m_bottom[m_bottomHead++];
+  if (m_bottomHead > m_bottom.size () / 2)
+    {
+      // a late event may stay in the Bottom list while earlier ones keep
+      // coming and going: drop the consumed events, which costs less
+      // than the events removed since the last time.
+      m_bottom.erase (m_bottom.begin (), m_bottom.begin () + m_bottomHead);
+      m_bottomHead = 0;
+    }
+  return ev;
+}
+
+void
+LadderScheduler::Remove (const Event &ev)
+{
+  NS_LOG_FUNCTION (this << &ev);
+  uint64_t ts = ev.key.m_ts;
+  uint32_t uid = ev.key.m_uid;
+  std::vector<Scheduler::Event> *list;
+  std::vector<Scheduler::Event>::iterator i;
+  uint32_t r = m_nRungs;
+  if (ts >= m_topStart)
+    {
+      list = &m_top;
+      i = list->begin ();
+    }
+  else
+    {
+      r = FindRung (ts);
+      if (r < m_nRungs)
+        {
+          Rung &rung = m_rungs[r];
+          list = &rung.buckets[(ts - rung.start) / rung.width];
+          i = list->begin ();
+        }
+      else
+        {
+          list = &m_bottom;
+          i = list->begin () + m_bottomHead;
+        }
+    }
+  for (; i != list->end (); i++)
+    {
+      if (i->key.m_uid == uid)
+        {
+          NS_ASSERT (i->impl == ev.impl);
+          if (list == &m_bottom)
+            {
+              // keep the Bottom list sorted.
+              list->erase (i);
+            }
+          else
+            {
+              *i = list->back ();
+              list->pop_back ();
+              if (r < m_nRungs)
+                {
+                  m_rungs[r].count--;
+                }
+            }
+          m_size--;
+          return;
+        }
+    }
+  NS_ASSERT (false);
+}
+
+} // namespace ns3
@@ -102,6 +102,7 @@ Object::Object ()
 {
   NS_LOG_FUNCTION (this);
   m_aggregates->n = 1;
+  m_aggregates->cache = 0;
   m_aggregates->buffer[0] = this;
 }
 Object::~Object () 
@@ -120,11 +121,16 @@ Object::~Object ()
           m_aggregates->n--;
         }
     }
+  // the cache may point to this object
+  if (m_aggregates->cache != 0)
+    {
+      std::memset (m_aggregates->cache, 0, sizeof (struct LookupCache));
+    }
   // finally, if all objects have been removed from the list,
   // delete the aggregate list
   if (m_aggregates->n == 0)
     {
-      std::free (m_aggregates);
+      FreeAggregates (m_aggregates);
     }
   m_aggregates = 0;
 }
@@ -136,6 +142,7 @@ Object::Object (const Object &o)
     m_getObjectCount (0)
 {
   m_aggregates->n = 1;
+  m_aggregates->cache = 0;
   m_aggregates->buffer[0] = this;
 }
 void
@@ -151,6 +158,14 @@ Object::DoGetObject (TypeId tid) const
   NS_LOG_FUNCTION (this << tid);
   NS_ASSERT (CheckLoose ());
 
+  uint16_t uid = tid.GetUid ();
+  uint32_t slot = uid % LOOKUP_CACHE_SIZE;
+  struct LookupCache *cache = m_aggregates->cache;
+  if (cache != 0 && cache->uid[slot] == uid)
+    {
+      return const_cast<Object *> (cache->object[slot]);
+    }
+
   uint32_t n = m_aggregates->n;
   TypeId objectTid = Object::GetTypeId ();
   for (uint32_t i = 0; i < n; i++)
@@ -173,6 +188,18 @@ Object::DoGetObject (TypeId tid) const
           current->m_getObjectCount++;
           // then, update the sort
           UpdateSortedArray (m_aggregates, i);
+          // remember the match for the next lookup of this TypeId.
+          // A lone object is served by the dynamic_cast in GetObject.
+          if (n > 1)
+            {
+              if (cache == 0)
+                {
+                  cache = (struct LookupCache *)std::calloc (1, sizeof (struct LookupCache));
+                  m_aggregates->cache = cache;
+                }
+              cache->uid[slot] = uid;
+              cache->object[slot] = current;
+            }
           // finally, return the match
           return const_cast<Object *> (current);
         }
@@ -264,6 +291,7 @@ Object::AggregateObject (Ptr<Object> o)
   struct Aggregates *aggregates = 
     (struct Aggregates *)std::malloc (sizeof(struct Aggregates)+(total-1)*sizeof(Object*));
   aggregates->n = total;
+  aggregates->cache = 0;
 
   // copy our buffer to the new buffer
   std::memcpy (&aggregates->buffer[0], 
@@ -307,8 +335,15 @@ Object::AggregateObject (Ptr<Object> o)
     }
 
   // Now that we are done with them, we can free our old aggregate buffers
-  std::free (a);
-  std::free (b);
+  FreeAggregates (a);
+  FreeAggregates (b);
+}
+void
+Object::FreeAggregates (struct Aggregates *aggregates)
+{
+  NS_LOG_FUNCTION (aggregates);
+  std::free (aggregates->cache);
+  std::free (aggregates);
 }
 /**
  * This function must be implemented in the stack that needs to notify
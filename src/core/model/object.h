@@ -316,6 +316,23 @@ private:
   friend class AggregateIterator;
   friend struct ObjectDeleter;
 
+  /** The number of entries of a LookupCache. */
+  static const uint32_t LOOKUP_CACHE_SIZE = 8;
+
+  /**
+   * Results of the previous DoGetObject() calls on an aggregate.
+   *
+   * The cache is direct-mapped on the TypeId uid, so a repeated
+   * lookup costs one comparison instead of a walk over the aggregates
+   * and their TypeId parents.  A uid of 0 marks an empty slot.
+   */
+  struct LookupCache {
+    /** The TypeId uids of the cached lookups. */
+    uint16_t uid[LOOKUP_CACHE_SIZE];
+    /** The Objects found for each cached uid. */
+    Object *object[LOOKUP_CACHE_SIZE];
+  };
+
   /**
    * The list of Objects aggregated to this one.
    *
@@ -331,10 +348,19 @@ private:
   struct Aggregates {
     /** The number of entries in \c buffer. */
     uint32_t n;
+    /** The lookup cache, allocated on the first lookup which needs it. */
+    struct LookupCache *cache;
     /** The array of Objects. */
     Object *buffer[1];
   };
 
+  /**
+   * Free an aggregate list and its lookup cache.
+   *
+   * \param [in] aggregates The list of aggregated Objects.
+   */
+  static void FreeAggregates (struct Aggregates *aggregates);
+
   /**
    * Find an Object of TypeId tid in the aggregates of this Object.
    *
@@ -454,6 +480,18 @@ template <typename T>
 Ptr<T> 
 Object::GetObject () const
 {
+  // A type already looked up on this aggregate is served by the cache,
+  // without a failed dynamic_cast nor a walk over the aggregates.
+  struct LookupCache *cache = m_aggregates->cache;
+  if (cache != 0)
+    {
+      uint16_t uid = T::GetTypeId ().GetUid ();
+      uint32_t slot = uid % LOOKUP_CACHE_SIZE;
+      if (cache->uid[slot] == uid)
+        {
+          return Ptr<T> (static_cast<T *> (cache->object[slot]));
+        }
+    }
   // This is an optimization: if the cast works (which is likely),
   // things will be pretty fast.
   T *result = dynamic_cast<T *> (m_aggregates->buffer[0]);
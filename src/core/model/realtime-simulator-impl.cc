@@ -34,6 +34,7 @@
 
 
 #include <cmath>
+#include <algorithm>
 
 
 /**
@@ -75,6 +76,7 @@ RealtimeSimulatorImpl::GetTypeId (void)
 
 
 RealtimeSimulatorImpl::RealtimeSimulatorImpl ()
+  : m_eventsWithContextRing (EVENTS_WITH_CONTEXT_RING)
 {
   NS_LOG_FUNCTION (this);
 
@@ -90,6 +92,7 @@ RealtimeSimulatorImpl::RealtimeSimulatorImpl ()
   m_currentTs = 0;
   m_currentContext = 0xffffffff;
   m_unscheduledEvents = 0;
+  m_eventsWithContextOverflow = false;
 
   m_main = SystemThread::Self();
 
@@ -107,6 +110,10 @@ void
 RealtimeSimulatorImpl::DoDispose (void)
 {
   NS_LOG_FUNCTION (this);
+  {
+    CriticalSection cs (m_mutex);
+    ProcessEventsWithContext ();
+  }
   while (!m_events->IsEmpty ())
     {
       Scheduler::Event next = m_events->RemoveNext ();
@@ -208,6 +215,16 @@ RealtimeSimulatorImpl::ProcessOneEvent (void)
 
       { 
         CriticalSection cs (m_mutex);
+        //
+        // This resets the synchronizer so that any future event will cause
+        // it to interrupt. It is done before the events scheduled by other
+        // threads are moved to the event list: as they push their events
+        // without taking the critical section, an event pushed after this
+        // point either is moved below or interrupts the wait.
+        //
+        m_synchronizer->SetCondition (false);
+        ProcessEventsWithContext ();
+
         //
         // Since we are in realtime mode, the time to delay has got to be the 
         // difference between the current realtime and the timestamp of the next 
@@ -253,10 +270,9 @@ RealtimeSimulatorImpl::ProcessOneEvent (void)
         // We've figured out how long we need to delay in order to pace the 
         // simulation time with the real time.  We're going to sleep, but need
         // to work with the synchronizer to make sure we're awakened if something 
-        // external happens (like a packet is received).  This next line resets
-        // the synchronizer so that any future event will cause it to interrupt.
+        // external happens (like a packet is received).  The synchronizer was
+        // reset above for that.
         //
-        m_synchronizer->SetCondition (false);
       }
 
       //
@@ -405,6 +421,56 @@ RealtimeSimulatorImpl::IsFinished (void) const
   return rc;
 }
 
+void
+RealtimeSimulatorImpl::InsertEventWithContext (const EventWithContext &event)
+{
+  Scheduler::Event ev;
+  ev.impl = event.event;
+  // The simulator may have run an event due after the timestamp taken
+  // by the other thread: the event cannot be earlier than now.
+  ev.key.m_ts = std::max (event.timestamp, m_currentTs);
+  ev.key.m_context = event.context;
+  ev.key.m_uid = m_uid;
+  m_uid++;
+  m_unscheduledEvents++;
+  m_events->Insert (ev);
+}
+
+void
+RealtimeSimulatorImpl::ProcessEventsWithContext (void)
+{
+  // The ring first: the events of a thread are only in the list if
+  // they are later than its events in the ring.
+  EventWithContext event;
+  while (m_eventsWithContextRing.Pop (event))
+    {
+      InsertEventWithContext (event);
+    }
+  if (!__atomic_load_n (&m_eventsWithContextOverflow, __ATOMIC_ACQUIRE))
+    {
+      return;
+    }
+  EventsWithContext eventsWithContext;
+  {
+    CriticalSection cs (m_eventsWithContextMutex);
+    // A thread may have claimed a cell of the ring, not yet filled
+    // when the ring was drained above, before adding its next events
+    // to the list: the list waits until every claimed cell has been
+    // drained. Meanwhile all the threads keep adding to the list.
+    if (!m_eventsWithContextRing.IsDrained ())
+      {
+        return;
+      }
+    m_eventsWithContext.swap (eventsWithContext);
+    __atomic_store_n (&m_eventsWithContextOverflow, false, __ATOMIC_RELEASE);
+  }
+  while (!eventsWithContext.empty ())
+    {
+      InsertEventWithContext (eventsWithContext.front ());
+      eventsWithContext.pop_front ();
+    }
+}
+
 //
 // Peeks into event list.  Should be called with critical section locked.
 //
@@ -429,7 +495,7 @@ RealtimeSimulatorImpl::Run (void)
   m_main = SystemThread::Self();
 
   m_stop = false;
-  m_running = true;
+  __atomic_store_n (&m_running, true, __ATOMIC_RELEASE);
   m_synchronizer->SetOrigin (m_currentTs);
 
   // Sleep until signalled
@@ -442,6 +508,8 @@ RealtimeSimulatorImpl::Run (void)
       {
         CriticalSection cs (m_mutex);
 
+        m_synchronizer->SetCondition (false);
+        ProcessEventsWithContext ();
         if (!m_events->IsEmpty ())
           {
             process = true;
@@ -476,13 +544,13 @@ RealtimeSimulatorImpl::Run (void)
                    "RealtimeSimulatorImpl::Run(): Empty queue and unprocessed events");
   }
 
-  m_running = false;
+  __atomic_store_n (&m_running, false, __ATOMIC_RELEASE);
 }
 
 bool
 RealtimeSimulatorImpl::Running (void) const
 {
-  return m_running;
+  return __atomic_load_n (&m_running, __ATOMIC_ACQUIRE);
 }
 
 bool
@@ -543,6 +611,26 @@ RealtimeSimulatorImpl::ScheduleWithContext (uint32_t context, Time const &delay,
 {
   NS_LOG_FUNCTION (this << context << delay << impl);
 
+  if (Running () && !SystemThread::Equals (m_main))
+    {
+      // Another thread, typically reading packets from a device: do not
+      // take the critical section, the simulator thread moves the event
+      // to the event list.
+      EventWithContext ev;
+      ev.context = context;
+      ev.timestamp = m_synchronizer->GetCurrentRealtime () + delay.GetTimeStep ();
+      ev.event = impl;
+      if (__atomic_load_n (&m_eventsWithContextOverflow, __ATOMIC_ACQUIRE)
+          || !m_eventsWithContextRing.Push (ev))
+        {
+          CriticalSection cs (m_eventsWithContextMutex);
+          m_eventsWithContext.push_back (ev);
+          __atomic_store_n (&m_eventsWithContextOverflow, true, __ATOMIC_RELEASE);
+        }
+      m_synchronizer->Signal ();
+      return;
+    }
+
   {
     CriticalSection cs (m_mutex);
     uint64_t ts;
@@ -557,7 +645,7 @@ RealtimeSimulatorImpl::ScheduleWithContext (uint32_t context, Time const &delay,
         // If the simulator is running, we're pacing and have a meaningful 
         // realtime clock.  If we're not, then m_currentTs is where we stopped.
         // 
-        ts = m_running ? m_synchronizer->GetCurrentRealtime () : m_currentTs;
+        ts = Running () ? m_synchronizer->GetCurrentRealtime () : m_currentTs;
         ts += delay.GetTimeStep ();
       }
 
@@ -643,7 +731,7 @@ RealtimeSimulatorImpl::ScheduleRealtimeNowWithContext (uint32_t context, EventIm
     // If the simulator is running, we're pacing and have a meaningful 
     // realtime clock.  If we're not, then m_currentTs is were we stopped.
     // 
-    uint64_t ts = m_running ? m_synchronizer->GetCurrentRealtime () : m_currentTs;
+    uint64_t ts = Running () ? m_synchronizer->GetCurrentRealtime () : m_currentTs;
     NS_ASSERT_MSG (ts >= m_currentTs, 
                    "RealtimeSimulatorImpl::ScheduleRealtimeNowWithContext(): schedule for time < m_currentTs");
     Scheduler::Event ev;
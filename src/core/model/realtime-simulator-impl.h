@@ -30,6 +30,7 @@
 #include "assert.h"
 #include "log.h"
 #include "system-mutex.h"
+#include "mpsc-ring.h"
 
 #include <list>
 
@@ -172,16 +173,64 @@ private:
   uint64_t NextTs (void) const;
   /** Process the next event. */
   void ProcessOneEvent (void);
+  /**
+   * Move the events scheduled by other threads into the event list.
+   * Should be called with #m_mutex locked.
+   */
+  void ProcessEventsWithContext (void);
   /** Destructor implementation. */
   virtual void DoDispose (void);
 
+  /** Wrap an event scheduled by another thread with its execution context. */
+  struct EventWithContext {
+    /** The event context. */
+    uint32_t context;
+    /** Event timestamp. */
+    uint64_t timestamp;
+    /** The event implementation. */
+    EventImpl *event;
+  };
+  /**
+   * Insert an event scheduled by another thread in the event list.
+   * Should be called with #m_mutex locked.
+   *
+   * \param [in] event The event.
+   */
+  void InsertEventWithContext (const EventWithContext &event);
+  /** Capacity of the ring of events scheduled by other threads. */
+  static const uint32_t EVENTS_WITH_CONTEXT_RING = 1024;
+  /**
+   * The events scheduled by other threads with ScheduleWithContext while
+   * the simulator runs. They are pushed without taking #m_mutex and
+   * moved to the event list by the simulator thread.
+   */
+  MpscRing<struct EventWithContext> m_eventsWithContextRing;
+  /** Container type for the events scheduled by other threads. */
+  typedef std::list<struct EventWithContext> EventsWithContext;
+  /**
+   * The container of events scheduled by other threads, used when the
+   * ring is full.
+   */
+  EventsWithContext m_eventsWithContext;
+  /**
+   * Flag \c true if m_eventsWithContext holds events. While it is set,
+   * other threads keep adding to m_eventsWithContext, so that the
+   * events of a thread are inserted in order.
+   */
+  bool m_eventsWithContextOverflow;
+  /** Mutex to control access to the list of events with context. */
+  SystemMutex m_eventsWithContextMutex;
+
   /** Container type for events to be run at destroy time. */
   typedef std::list<EventId> DestroyEvents;
   /** Container for events to be run at destroy time. */
   DestroyEvents m_destroyEvents;
   /** Has the stopping condition been reached? */
   bool m_stop;
-  /** Is the simulator currently running. */
+  /**
+   * Is the simulator currently running.
+   * Accessed atomically, as the threads scheduling events read it.
+   */
   bool m_running;
 
   /**
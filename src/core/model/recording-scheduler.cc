@@ -0,0 +1,258 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "recording-scheduler.h"
+#include "object-factory.h"
+#include "string.h"
+#include "abort.h"
+#include "assert.h"
+#include "log.h"
+#include <cstring>
+
+/**
+ * \file
+ * \ingroup scheduler
+ * Implementation of ns3::RecordingScheduler and ns3::SchedulerTraceReader
+ * classes.
+ */
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("RecordingScheduler");
+
+NS_OBJECT_ENSURE_REGISTERED (RecordingScheduler);
+
+/** The magic number at the start of a trace file. */
+static const char TRACE_MAGIC[8] = { 'n', 's', '3', 'e', 'v', 't', 'r', 'c' };
+/** The version of the trace format. */
+static const uint8_t TRACE_VERSION = 1;
+/** The size of the blocks written to the trace file. */
+static const uint32_t TRACE_BLOCK = 65536;
+
+TypeId
+RecordingScheduler::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::RecordingScheduler")
+    .SetParent<Scheduler> ()
+    .SetGroupName ("Core")
+    .AddConstructor<RecordingScheduler> ()
+    .AddAttribute ("Scheduler",
+                   "The type of the scheduler whose operations are recorded.",
+                   StringValue ("ns3::MapScheduler"),
+                   MakeStringAccessor (&RecordingScheduler::m_schedulerType),
+                   MakeStringChecker ())
+    .AddAttribute ("FileName",
+                   "The name of the trace file.",
+                   StringValue ("scheduler-trace.bin"),
+                   MakeStringAccessor (&RecordingScheduler::m_fileName),
+                   MakeStringChecker ())
+  ;
+  return tid;
+}
+
+RecordingScheduler::RecordingScheduler ()
+  : m_now (0),
+    m_lastUid (0)
+{
+  NS_LOG_FUNCTION (this);
+}
+
+RecordingScheduler::~RecordingScheduler ()
+{
+  NS_LOG_FUNCTION (this);
+  if (m_file.is_open ())
+    {
+      Flush ();
+      m_file.close ();
+    }
+}
+
+void
+RecordingScheduler::NotifyConstructionCompleted (void)
+{
+  NS_LOG_FUNCTION (this);
+  ObjectFactory factory (m_schedulerType);
+  m_scheduler = factory.Create<Scheduler> ();
+  NS_ABORT_MSG_IF (m_scheduler == 0, m_schedulerType << " is not a scheduler");
+  m_file.open (m_fileName.c_str (), std::ios::out | std::ios::binary | std::ios::trunc);
+  NS_ABORT_MSG_UNLESS (m_file.is_open (), "Unable to open " << m_fileName);
+  m_file.write (TRACE_MAGIC, sizeof (TRACE_MAGIC));
+  m_file.put (TRACE_VERSION);
+  m_buffer.reserve (TRACE_BLOCK + 32);
+  Scheduler::NotifyConstructionCompleted ();
+}
+
+void
+RecordingScheduler::WriteVarint (uint64_t v)
+{
+  while (v >= 0x80)
+    {
+      m_buffer.push_back ((v & 0x7f) | 0x80);
+      v >>= 7;
+    }
+  m_buffer.push_back (v);
+}
+
+void
+RecordingScheduler::Record (uint8_t op, const Scheduler::Event &ev)
+{
+  int64_t dt = ev.key.m_ts - m_now;
+  int64_t duid = (int64_t)ev.key.m_uid - m_lastUid;
+  m_buffer.push_back (op);
+  WriteVarint (((uint64_t)dt << 1) ^ (uint64_t)(dt >> 63));
+  WriteVarint (((uint64_t)duid << 1) ^ (uint64_t)(duid >> 63));
+  if (op == SchedulerTraceReader::INSERT)
+    {
+      WriteVarint ((uint64_t)ev.key.m_context + 1);
+    }
+  m_lastUid = ev.key.m_uid;
+  if (m_buffer.size () >= TRACE_BLOCK)
+    {
+      Flush ();
+    }
+}
+
+void
+RecordingScheduler::Flush (void)
+{
+  NS_LOG_FUNCTION (this << m_buffer.size ());
+  if (!m_buffer.empty ())
+    {
+      m_file.write (reinterpret_cast<const char *> (&m_buffer[0]), m_buffer.size ());
+      m_buffer.clear ();
+    }
+  m_file.flush ();
+}
+
+void
+RecordingScheduler::Insert (const Event &ev)
+{
+  NS_LOG_FUNCTION (this << &ev);
+  Record (SchedulerTraceReader::INSERT, ev);
+  m_scheduler->Insert (ev);
+}
+
+bool
+RecordingScheduler::IsEmpty (void) const
+{
+  NS_LOG_FUNCTION (this);
+  return m_scheduler->IsEmpty ();
+}
+
+Scheduler::Event
+RecordingScheduler::PeekNext (void) const
+{
+  NS_LOG_FUNCTION (this);
+  return m_scheduler->PeekNext ();
+}
+
+Scheduler::Event
+RecordingScheduler::RemoveNext (void)
+{
+  NS_LOG_FUNCTION (this);
+  Scheduler::Event ev = m_scheduler->RemoveNext ();
+  Record (SchedulerTraceReader::REMOVE_NEXT, ev);
+  m_now = ev.key.m_ts;
+  return ev;
+}
+
+void
+RecordingScheduler::Remove (const Event &ev)
+{
+  NS_LOG_FUNCTION (this << &ev);
+  Record (SchedulerTraceReader::REMOVE, ev);
+  m_scheduler->Remove (ev);
+}
+
+
+SchedulerTraceReader::SchedulerTraceReader ()
+  : m_now (0),
+    m_lastUid (0)
+{
+  NS_LOG_FUNCTION (this);
+}
+
+bool
+SchedulerTraceReader::Open (std::string fileName)
+{
+  NS_LOG_FUNCTION (this << fileName);
+  m_file.open (fileName.c_str (), std::ios::in | std::ios::binary);
+  char magic[sizeof (TRACE_MAGIC)];
+  m_file.read (magic, sizeof (magic));
+  int version = m_file.get ();
+  m_now = 0;
+  m_lastUid = 0;
+  return m_file.good ()
+         && std::memcmp (magic, TRACE_MAGIC, sizeof (magic)) == 0
+         && version == TRACE_VERSION;
+}
+
+bool
+SchedulerTraceReader::ReadVarint (uint64_t &v)
+{
+  v = 0;
+  for (uint32_t shift = 0; shift < 64; shift += 7)
+    {
+      int c = m_file.get ();
+      if (c == std::char_traits<char>::eof ())
+        {
+          return false;
+        }
+      v |= (uint64_t)(c & 0x7f) << shift;
+      if ((c & 0x80) == 0)
+        {
+          return true;
+        }
+    }
+  return false;
+}
+
+bool
+SchedulerTraceReader::Read (Record &record)
+{
+  int op = m_file.get ();
+  if (op != INSERT && op != REMOVE_NEXT && op != REMOVE)
+    {
+      return false;
+    }
+  uint64_t dt;
+  uint64_t duid;
+  if (!ReadVarint (dt) || !ReadVarint (duid))
+    {
+      return false;
+    }
+  record.op = op;
+  record.ts = m_now + ((dt >> 1) ^ -(int64_t)(dt & 1));
+  record.uid = m_lastUid + ((duid >> 1) ^ -(int64_t)(duid & 1));
+  record.context = 0;
+  if (op == INSERT)
+    {
+      uint64_t context;
+      if (!ReadVarint (context))
+        {
+          return false;
+        }
+      record.context = context - 1;
+    }
+  m_lastUid = record.uid;
+  if (op == REMOVE_NEXT)
+    {
+      m_now = record.ts;
+    }
+  return true;
+}
+
+} // namespace ns3
@@ -0,0 +1,182 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef RECORDING_SCHEDULER_H
+#define RECORDING_SCHEDULER_H
+
+#include "scheduler.h"
+#include "ptr.h"
+#include <stdint.h>
+#include <string>
+#include <fstream>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup scheduler
+ * Declaration of ns3::RecordingScheduler and ns3::SchedulerTraceReader
+ * classes.
+ */
+
+namespace ns3 {
+
+/**
+ * \ingroup scheduler
+ * \brief a scheduler which records the operations of another one
+ *
+ * Every Insert, RemoveNext and Remove is forwarded to the scheduler
+ * given by the "Scheduler" attribute and appended to the binary file
+ * given by the "FileName" attribute. The file can be replayed against
+ * any scheduler with SchedulerTraceReader, e.g. by
+ * utils/bench-scheduler-replay, to compare schedulers on the exact
+ * workload of a real simulation:
+ *
+ * \code
+ *   ./waf --run "mipv6-multiple --SchedulerType=ns3::RecordingScheduler"
+ * \endcode
+ *
+ * The file starts with the 8 bytes "ns3evtrc" and a version byte,
+ * followed by one record per operation:
+ *  - the operation: 'I' (Insert), 'N' (RemoveNext) or 'R' (Remove),
+ *  - the timestamp, relative to the last event removed by RemoveNext,
+ *  - the uid, relative to the uid of the previous record,
+ *  - for Insert only, the context plus one.
+ *
+ * The timestamp and uid differences are zigzag encoded, then all the
+ * fields are written as little-endian base 128 varints: a record
+ * usually takes 4 to 8 bytes. Records are buffered and written in
+ * blocks, so the recorder adds little to the run time.
+ */
+class RecordingScheduler : public Scheduler
+{
+public:
+  /**
+   *  Register this type.
+   *  \return The object TypeId.
+   */
+  static TypeId GetTypeId (void);
+
+  /** Constructor. */
+  RecordingScheduler ();
+  /** Destructor. */
+  virtual ~RecordingScheduler ();
+
+  // Inherited
+  virtual void Insert (const Scheduler::Event &ev);
+  virtual bool IsEmpty (void) const;
+  virtual Scheduler::Event PeekNext (void) const;
+  virtual Scheduler::Event RemoveNext (void);
+  virtual void Remove (const Scheduler::Event &ev);
+
+protected:
+  virtual void NotifyConstructionCompleted (void);
+
+private:
+  /**
+   * Append a record to the buffer.
+   *
+   * \param [in] op The operation.
+   * \param [in] ev The event.
+   */
+  void Record (uint8_t op, const Scheduler::Event &ev);
+  /**
+   * Append a varint to the buffer.
+   *
+   * \param [in] v The value.
+   */
+  void WriteVarint (uint64_t v);
+  /** Write the buffer to the file. */
+  void Flush (void);
+
+  /** The name of the type of the scheduler doing the work. */
+  std::string m_schedulerType;
+  /** The name of the trace file. */
+  std::string m_fileName;
+  /** The scheduler doing the work. */
+  Ptr<Scheduler> m_scheduler;
+  /** The trace file. */
+  std::ofstream m_file;
+  /** The records not yet written. */
+  std::vector<uint8_t> m_buffer;
+  /** The timestamp of the last event removed by RemoveNext. */
+  uint64_t m_now;
+  /** The uid of the previous record. */
+  uint32_t m_lastUid;
+};
+
+/**
+ * \ingroup scheduler
+ * \brief reader of the files written by RecordingScheduler
+ */
+class SchedulerTraceReader
+{
+public:
+  /** The operations of a record. */
+  enum Operation
+  {
+    INSERT = 'I',       //!< Scheduler::Insert
+    REMOVE_NEXT = 'N',  //!< Scheduler::RemoveNext
+    REMOVE = 'R'        //!< Scheduler::Remove
+  };
+
+  /** A record. */
+  struct Record
+  {
+    uint8_t op;        //!< The operation.
+    uint64_t ts;       //!< The absolute event timestamp.
+    uint32_t uid;      //!< The event uid.
+    uint32_t context;  //!< The event context, for INSERT.
+  };
+
+  /** Constructor. */
+  SchedulerTraceReader ();
+
+  /**
+   * Open a trace file and check its header.
+   *
+   * \param [in] fileName The name of the file.
+   * \returns \c true if the file is a scheduler trace.
+   */
+  bool Open (std::string fileName);
+  /**
+   * Read the next record.
+   *
+   * \param [out] record The record.
+   * \returns \c false at the end of the file, or if the file is
+   *          truncated or corrupted.
+   */
+  bool Read (Record &record);
+
+private:
+  /**
+   * Read a varint.
+   *
+   * \param [out] v The value.
+   * \returns \c false at the end of the file.
+   */
+  bool ReadVarint (uint64_t &v);
+
+  /** The trace file. */
+  std::ifstream m_file;
+  /** The timestamp of the last RemoveNext record. */
+  uint64_t m_now;
+  /** The uid of the previous record. */
+  uint32_t m_lastUid;
+};
+
+} // namespace ns3
+
+#endif /* RECORDING_SCHEDULER_H */
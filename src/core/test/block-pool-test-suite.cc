@@ -0,0 +1,122 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/test.h"
+#include "ns3/block-pool.h"
+#include "ns3/core-config.h"
+#ifdef HAVE_PTHREAD_H
+#include "ns3/system-thread.h"
+#endif
+#include <cstring>
+
+using namespace ns3;
+
+class BlockPoolReuseTestCase : public TestCase
+{
+public:
+  BlockPoolReuseTestCase ();
+  virtual void DoRun (void);
+};
+
+BlockPoolReuseTestCase::BlockPoolReuseTestCase ()
+  : TestCase ("Check that the blocks are reused by size class, and released by Cleanup")
+{
+}
+
+void
+BlockPoolReuseTestCase::DoRun (void)
+{
+  BlockPool::State state;
+  std::memset (&state, 0, sizeof (state));
+  // the state is released here, not when the thread exits
+  state.registered = true;
+
+  NS_TEST_EXPECT_MSG_EQ (BlockPool::GetCapacity (8, 1), 16, "smallest size class");
+  NS_TEST_EXPECT_MSG_EQ (BlockPool::GetCapacity (8, 17), 32, "rounded to the size class");
+  NS_TEST_EXPECT_MSG_EQ (BlockPool::GetCapacity (8, 129), 129, "large blocks are not pooled");
+
+  void *p = BlockPool::Allocate (&state, 8, 20);
+  void *q = BlockPool::Allocate (&state, 8, 200);
+  BlockPool::Deallocate (&state, 8, p, 20);
+  BlockPool::Deallocate (&state, 8, q, 200);
+  NS_TEST_EXPECT_MSG_EQ (BlockPool::GetFree (&state), 1, "only the small block is kept");
+  NS_TEST_EXPECT_MSG_EQ (BlockPool::Allocate (&state, 8, 30), p, "the block is reused in its size class");
+  NS_TEST_EXPECT_MSG_EQ (state.reuses, 1, "one allocation from the free list");
+  BlockPool::Deallocate (&state, 8, p, 30);
+
+  {
+    BlockPool::Cleanup cleanup (&state);
+  }
+  NS_TEST_EXPECT_MSG_EQ (BlockPool::GetFree (&state), 0, "the free lists are released");
+  p = BlockPool::Allocate (&state, 8, 20);
+  BlockPool::Deallocate (&state, 8, p, 20);
+  NS_TEST_EXPECT_MSG_EQ (BlockPool::GetFree (&state), 0, "blocks are not pooled after the release");
+}
+
+#ifdef HAVE_PTHREAD_H
+class BlockPoolThreadTestCase : public TestCase
+{
+public:
+  BlockPoolThreadTestCase ();
+  virtual void DoRun (void);
+private:
+  /** Release a few blocks from another thread, which then exits. */
+  void ReleaseBlocks (void);
+  BlockPool::State m_state;  //!< The state of the other thread.
+  uint64_t m_free;           //!< Its free blocks before it exits.
+};
+
+BlockPoolThreadTestCase::BlockPoolThreadTestCase ()
+  : TestCase ("Check that the free blocks of a thread are released when it exits")
+{
+}
+
+void
+BlockPoolThreadTestCase::ReleaseBlocks (void)
+{
+  for (uint32_t i = 0; i < 10; i++)
+    {
+      BlockPool::Deallocate (&m_state, 8, BlockPool::Allocate (&m_state, 8, 16 * (i % 8) + 1), 16 * (i % 8) + 1);
+    }
+  m_free = BlockPool::GetFree (&m_state);
+}
+
+void
+BlockPoolThreadTestCase::DoRun (void)
+{
+  std::memset (&m_state, 0, sizeof (m_state));
+  m_free = 0;
+  Ptr<SystemThread> thread = Create<SystemThread> (MakeCallback (&BlockPoolThreadTestCase::ReleaseBlocks, this));
+  thread->Start ();
+  thread->Join ();
+  NS_TEST_EXPECT_MSG_EQ (m_free, 8, "the thread kept a block per size class");
+  NS_TEST_EXPECT_MSG_EQ (m_state.released, true, "the free lists of the thread are released");
+  NS_TEST_EXPECT_MSG_EQ (BlockPool::GetFree (&m_state), 0, "no block is left");
+}
+#endif /* HAVE_PTHREAD_H */
+
+class BlockPoolTestSuite : public TestSuite
+{
+public:
+  BlockPoolTestSuite ()
+    : TestSuite ("block-pool", UNIT)
+  {
+    AddTestCase (new BlockPoolReuseTestCase (), TestCase::QUICK);
+#ifdef HAVE_PTHREAD_H
+    AddTestCase (new BlockPoolThreadTestCase (), TestCase::QUICK);
+#endif
+  }
+} g_blockPoolTestSuite;
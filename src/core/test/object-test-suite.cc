@@ -357,6 +357,22 @@ AggregateObjectTestCase::DoRun (void)
 
   baseA = baseB->GetObject<BaseA> ();
   NS_TEST_ASSERT_MSG_NE (baseA, 0, "Unable to GetObject on released object");
+
+  //
+  // Repeated lookups are served by the aggregate lookup cache.  Make sure
+  // the cached result is the right object, and that the cache does not
+  // hide an object aggregated after the lookup.
+  //
+  for (uint32_t i = 0; i < 3; i++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (baseA->GetObject<BaseB> (), baseB, "Wrong cached GetObject (through baseA) for BaseB Object");
+    }
+  NS_TEST_ASSERT_MSG_EQ (baseA->GetObject<DerivedB> (), 0, "Unexpectedly found a DerivedB through baseA");
+
+  Ptr<DerivedA> derivedA = CreateObject<DerivedA> ();
+  baseA->AggregateObject (derivedA);
+  NS_TEST_ASSERT_MSG_EQ (baseB->GetObject<DerivedA> (), derivedA, "Cannot GetObject (through baseB) for DerivedA Object aggregated after a lookup");
+  NS_TEST_ASSERT_MSG_EQ (derivedA->GetObject<BaseB> (), baseB, "Wrong GetObject (through derivedA) for BaseB Object");
 }
 
 // ===========================================================================
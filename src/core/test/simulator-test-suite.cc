@@ -23,6 +23,19 @@
 #include "ns3/heap-scheduler.h"
 #include "ns3/map-scheduler.h"
 #include "ns3/calendar-scheduler.h"
+#include "ns3/dary-heap-scheduler.h"
+#include "ns3/ladder-scheduler.h"
+#include "ns3/recording-scheduler.h"
+#include "ns3/string.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/config.h"
+#include "ns3/core-config.h"
+#ifdef HAVE_PTHREAD_H
+#include "ns3/system-thread.h"
+#endif
+#include <vector>
+#include <algorithm>
+#include <utility>
 
 using namespace ns3;
 
@@ -168,6 +181,323 @@ SimulatorEventsTestCase::DoRun (void)
   NS_TEST_EXPECT_MSG_EQ (m_destroy, true, "Event should have run");
 }
 
+class SimulatorOrderTestCase : public TestCase
+{
+public:
+  SimulatorOrderTestCase (ObjectFactory schedulerFactory);
+  virtual void DoRun (void);
+  void Event (uint32_t seq);
+  void ScheduleOne (void);
+  ObjectFactory m_schedulerFactory;
+  Ptr<UniformRandomVariable> m_rng;
+  std::vector<EventId> m_ids;
+  uint32_t m_scheduled;
+  uint32_t m_run;
+  uint32_t m_removed;
+  uint32_t m_lastSeq;
+  Time m_last;
+  bool m_ordered;
+};
+
+SimulatorOrderTestCase::SimulatorOrderTestCase (ObjectFactory schedulerFactory)
+  : TestCase ("Check the order of many events with " +
+              schedulerFactory.GetTypeId ().GetName ()),
+    m_schedulerFactory (schedulerFactory)
+{
+}
+
+void
+SimulatorOrderTestCase::ScheduleOne (void)
+{
+  // a mix of close, equal and far timestamps, to make the schedulers
+  // which bucket the events split and merge their buckets.
+  Time delay;
+  double p = m_rng->GetValue ();
+  if (p < 0.6)
+    {
+      delay = NanoSeconds (m_rng->GetInteger (0, 1000));
+    }
+  else if (p < 0.8)
+    {
+      delay = MicroSeconds (m_rng->GetInteger (0, 5));
+    }
+  else if (p < 0.95)
+    {
+      delay = MilliSeconds (m_rng->GetInteger (1, 1000));
+    }
+  else
+    {
+      delay = Seconds (100);
+    }
+  m_ids.push_back (Simulator::Schedule (delay, &SimulatorOrderTestCase::Event, this, m_scheduled));
+  m_scheduled++;
+}
+
+void
+SimulatorOrderTestCase::Event (uint32_t seq)
+{
+  // events at the same time run in the order they were scheduled.
+  if (Simulator::Now () < m_last
+      || (Simulator::Now () == m_last && seq < m_lastSeq))
+    {
+      m_ordered = false;
+    }
+  m_last = Simulator::Now ();
+  m_lastSeq = seq;
+  m_run++;
+  if (m_scheduled < 20000)
+    {
+      ScheduleOne ();
+      ScheduleOne ();
+    }
+  EventId &id = m_ids[m_rng->GetInteger (0, m_ids.size () - 1)];
+  if (!id.IsExpired ())
+    {
+      Simulator::Remove (id);
+      m_removed++;
+    }
+}
+
+void
+SimulatorOrderTestCase::DoRun (void)
+{
+  m_rng = CreateObject<UniformRandomVariable> ();
+  m_ids.clear ();
+  m_scheduled = 0;
+  m_run = 0;
+  m_removed = 0;
+  m_lastSeq = 0;
+  m_last = Seconds (0);
+  m_ordered = true;
+
+  Simulator::SetScheduler (m_schedulerFactory);
+  for (uint32_t i = 0; i < 2000; i++)
+    {
+      ScheduleOne ();
+    }
+  Simulator::Run ();
+  NS_TEST_EXPECT_MSG_EQ (m_ordered, true, "Events did not run in order");
+  NS_TEST_EXPECT_MSG_EQ (m_run + m_removed, m_scheduled, "Events were lost");
+  Simulator::Destroy ();
+}
+
+class SchedulerTraceTestCase : public TestCase
+{
+public:
+  SchedulerTraceTestCase ();
+  virtual void DoRun (void);
+  void Eventfoo0 (void) {}
+};
+
+SchedulerTraceTestCase::SchedulerTraceTestCase ()
+  : TestCase ("Check that RecordingScheduler traces can be read back")
+{
+}
+
+void
+SchedulerTraceTestCase::DoRun (void)
+{
+  std::string fileName = CreateTempDirFilename ("scheduler-trace.bin");
+  ObjectFactory factory ("ns3::RecordingScheduler");
+  factory.Set ("FileName", StringValue (fileName));
+  Simulator::SetScheduler (factory);
+
+  Simulator::Schedule (Seconds (2), &SchedulerTraceTestCase::Eventfoo0, this);
+  EventId id = Simulator::Schedule (Seconds (1), &SchedulerTraceTestCase::Eventfoo0, this);
+  Simulator::ScheduleWithContext (7, Seconds (3), &SchedulerTraceTestCase::Eventfoo0, this);
+  Simulator::Remove (id);
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  SchedulerTraceReader reader;
+  NS_TEST_ASSERT_MSG_EQ (reader.Open (fileName), true, "Could not open the trace");
+  uint8_t ops[] = { SchedulerTraceReader::INSERT, SchedulerTraceReader::INSERT,
+                    SchedulerTraceReader::INSERT, SchedulerTraceReader::REMOVE,
+                    SchedulerTraceReader::REMOVE_NEXT, SchedulerTraceReader::REMOVE_NEXT };
+  uint64_t ts[] = { 2, 1, 3, 1, 2, 3 };
+  SchedulerTraceReader::Record record;
+  for (uint32_t i = 0; i < sizeof (ops) / sizeof (ops[0]); i++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (reader.Read (record), true, "Record " << i << " is missing");
+      NS_TEST_EXPECT_MSG_EQ ((uint32_t)record.op, (uint32_t)ops[i], "Wrong operation");
+      NS_TEST_EXPECT_MSG_EQ (record.ts, Seconds (ts[i]).GetTimeStep (), "Wrong timestamp");
+    }
+  NS_TEST_EXPECT_MSG_EQ (reader.Read (record), false, "Unexpected record");
+}
+
+class LadderSchedulerMemoryTestCase : public TestCase
+{
+public:
+  LadderSchedulerMemoryTestCase ();
+  virtual void DoRun (void);
+};
+
+LadderSchedulerMemoryTestCase::LadderSchedulerMemoryTestCase ()
+  : TestCase ("Check that a late event does not make the ladder Bottom list grow")
+{
+}
+
+void
+LadderSchedulerMemoryTestCase::DoRun (void)
+{
+  Ptr<LadderScheduler> scheduler = CreateObject<LadderScheduler> ();
+  Scheduler::Event ev;
+  ev.impl = 0;
+  ev.key.m_context = 0;
+  ev.key.m_uid = 0;
+  ev.key.m_ts = 1000000000;
+  scheduler->Insert (ev);
+  ev.key.m_uid = 1;
+  ev.key.m_ts = 1;
+  scheduler->Insert (ev);
+
+  // hold: each event removed schedules the next one, ahead of the late
+  // event, which stays in the Bottom list
+  uint32_t maxCapacity = 0;
+  for (uint32_t i = 2; i < 200000; i++)
+    {
+      ev = scheduler->RemoveNext ();
+      NS_TEST_ASSERT_MSG_EQ (ev.key.m_uid, i - 1, "Wrong event removed");
+      ev.key.m_uid = i;
+      ev.key.m_ts += 10;
+      scheduler->Insert (ev);
+      maxCapacity = std::max<uint32_t> (maxCapacity, scheduler->m_bottom.capacity ());
+    }
+  NS_TEST_EXPECT_MSG_LT (maxCapacity, 4 * LadderScheduler::THRESHOLD, "The Bottom list grew");
+  scheduler->RemoveNext ();
+  NS_TEST_EXPECT_MSG_EQ (scheduler->RemoveNext ().key.m_uid, 0, "The late event was lost");
+  NS_TEST_EXPECT_MSG_EQ (scheduler->IsEmpty (), true, "Events were left");
+}
+
+#ifdef HAVE_PTHREAD_H
+class SimulatorCrossContextTestCase : public TestCase
+{
+public:
+  SimulatorCrossContextTestCase (const std::string &simulatorType);
+  virtual void DoRun (void);
+  void Start (bool join);
+  void Poll (void);
+  void Event (uint32_t thread, uint32_t seq);
+  static void Producer (std::pair<SimulatorCrossContextTestCase *, uint32_t> context);
+  enum {
+    THREADS = 4,
+    EVENTS = 2000
+  };
+  std::string m_simulatorType;
+  std::vector<Ptr<SystemThread> > m_threads;
+  uint32_t m_phase;
+  uint32_t m_done;
+  uint32_t m_received;
+  uint32_t m_next[THREADS];
+  bool m_ordered;
+};
+
+SimulatorCrossContextTestCase::SimulatorCrossContextTestCase (const std::string &simulatorType)
+  : TestCase ("Check the order of the events scheduled by other threads in " + simulatorType),
+    m_simulatorType (simulatorType)
+{
+}
+
+void
+SimulatorCrossContextTestCase::Producer (std::pair<SimulatorCrossContextTestCase *, uint32_t> context)
+{
+  SimulatorCrossContextTestCase *me = context.first;
+  uint32_t thread = context.second;
+  for (uint32_t i = 0; i < EVENTS; i++)
+    {
+      Simulator::ScheduleWithContext (thread, Seconds (0),
+                                      &SimulatorCrossContextTestCase::Event, me,
+                                      thread, me->m_phase * EVENTS + i);
+    }
+  __atomic_add_fetch (&me->m_done, 1, __ATOMIC_RELEASE);
+}
+
+void
+SimulatorCrossContextTestCase::Start (bool join)
+{
+  m_done = 0;
+  for (uint32_t i = 0; i < THREADS; i++)
+    {
+      m_threads.push_back (Create<SystemThread> (MakeBoundCallback (
+          &SimulatorCrossContextTestCase::Producer,
+          std::pair<SimulatorCrossContextTestCase *, uint32_t> (this, i))));
+      m_threads.back ()->Start ();
+    }
+  if (join)
+    {
+      // the simulator thread does not drain the ring meanwhile: most
+      // of the events go through the overflow list.
+      for (uint32_t i = 0; i < THREADS; i++)
+        {
+          m_threads[i]->Join ();
+        }
+      m_threads.clear ();
+    }
+}
+
+void
+SimulatorCrossContextTestCase::Poll (void)
+{
+  if (!m_threads.empty () && __atomic_load_n (&m_done, __ATOMIC_ACQUIRE) == THREADS)
+    {
+      for (uint32_t i = 0; i < THREADS; i++)
+        {
+          m_threads[i]->Join ();
+        }
+      m_threads.clear ();
+    }
+  if (m_received == THREADS * EVENTS && m_phase == 0)
+    {
+      // the simulator thread now drains the ring while the threads
+      // schedule their events.
+      m_phase = 1;
+      Start (false);
+    }
+  else if (m_received == 2 * THREADS * EVENTS && m_threads.empty ())
+    {
+      // the realtime simulator does not stop by itself.
+      Simulator::Stop ();
+      return;
+    }
+  Simulator::Schedule (MilliSeconds (1), &SimulatorCrossContextTestCase::Poll, this);
+}
+
+void
+SimulatorCrossContextTestCase::Event (uint32_t thread, uint32_t seq)
+{
+  // the events of a thread run in the order it scheduled them.
+  if (seq != m_next[thread])
+    {
+      m_ordered = false;
+    }
+  m_next[thread] = seq + 1;
+  m_received++;
+}
+
+void
+SimulatorCrossContextTestCase::DoRun (void)
+{
+  Config::SetGlobal ("SimulatorImplementationType", StringValue ("ns3::" + m_simulatorType));
+  m_phase = 0;
+  m_done = 0;
+  m_received = 0;
+  m_ordered = true;
+  for (uint32_t i = 0; i < THREADS; i++)
+    {
+      m_next[i] = 0;
+    }
+
+  Simulator::Schedule (Seconds (0), &SimulatorCrossContextTestCase::Start, this, true);
+  Simulator::Schedule (MilliSeconds (1), &SimulatorCrossContextTestCase::Poll, this);
+  Simulator::Run ();
+  Simulator::Destroy ();
+  Config::SetGlobal ("SimulatorImplementationType", StringValue ("ns3::DefaultSimulatorImpl"));
+
+  NS_TEST_EXPECT_MSG_EQ (m_ordered, true, "Events of a thread did not run in order");
+  NS_TEST_EXPECT_MSG_EQ (m_received, 2 * THREADS * EVENTS, "Events were lost");
+}
+#endif /* HAVE_PTHREAD_H */
+
 class SimulatorTemplateTestCase : public TestCase
 {
 public:
@@ -475,5 +805,28 @@ public:
     AddTestCase (new SimulatorEventsTestCase (factory), TestCase::QUICK);
     factory.SetTypeId (CalendarScheduler::GetTypeId ());
     AddTestCase (new SimulatorEventsTestCase (factory), TestCase::QUICK);
+    factory.SetTypeId (DaryHeapScheduler::GetTypeId ());
+    AddTestCase (new SimulatorEventsTestCase (factory), TestCase::QUICK);
+    factory.SetTypeId (LadderScheduler::GetTypeId ());
+    AddTestCase (new SimulatorEventsTestCase (factory), TestCase::QUICK);
+
+    factory.SetTypeId (MapScheduler::GetTypeId ());
+    AddTestCase (new SimulatorOrderTestCase (factory), TestCase::QUICK);
+    factory.SetTypeId (HeapScheduler::GetTypeId ());
+    AddTestCase (new SimulatorOrderTestCase (factory), TestCase::QUICK);
+    factory.SetTypeId (CalendarScheduler::GetTypeId ());
+    AddTestCase (new SimulatorOrderTestCase (factory), TestCase::QUICK);
+    factory.SetTypeId (DaryHeapScheduler::GetTypeId ());
+    AddTestCase (new SimulatorOrderTestCase (factory), TestCase::QUICK);
+    factory.SetTypeId (LadderScheduler::GetTypeId ());
+    AddTestCase (new SimulatorOrderTestCase (factory), TestCase::QUICK);
+    AddTestCase (new LadderSchedulerMemoryTestCase (), TestCase::QUICK);
+    AddTestCase (new SchedulerTraceTestCase (), TestCase::QUICK);
+#ifdef HAVE_PTHREAD_H
+    AddTestCase (new SimulatorCrossContextTestCase ("DefaultSimulatorImpl"), TestCase::QUICK);
+#ifdef HAVE_RT
+    AddTestCase (new SimulatorCrossContextTestCase ("RealtimeSimulatorImpl"), TestCase::QUICK);
+#endif
+#endif
   }
 } g_simulatorTestSuite;
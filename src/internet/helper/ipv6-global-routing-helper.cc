@@ -0,0 +1,602 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <vector>
+
+#include "ipv6-global-routing-helper.h"
+#include "ipv6-static-routing-helper.h"
+#include "ns3/ipv6.h"
+#include "ns3/ipv6-static-routing.h"
+#include "ns3/ipv6-interface-address.h"
+#include "ns3/ipv6-routing-table-entry.h"
+#include "ns3/node-list.h"
+#include "ns3/simulator.h"
+#include "ns3/channel.h"
+#include "ns3/log.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("Ipv6GlobalRoutingHelper");
+
+/** A global prefix, on the link of one or more nodes. */
+struct Ipv6GlobalNetwork
+{
+  Ipv6Address network;   //!< The network address.
+  uint8_t prefixLength;  //!< The prefix length.
+
+  /**
+   * \param o The other network.
+   * \returns True if this network is ordered before o.
+   */
+  bool operator < (const Ipv6GlobalNetwork &o) const
+  {
+    return network < o.network
+           || (network == o.network && prefixLength < o.prefixLength);
+  }
+  /**
+   * \param o The other network.
+   * \returns True if the networks are the same.
+   */
+  bool operator == (const Ipv6GlobalNetwork &o) const
+  {
+    return network == o.network && prefixLength == o.prefixLength;
+  }
+};
+
+/** A link from a node to one of its neighbors. */
+struct Ipv6GlobalLink
+{
+  uint32_t to;          //!< The neighbor.
+  uint32_t cost;        //!< The metric of the outgoing interface.
+  uint32_t ifIndex;     //!< The outgoing interface.
+  Ipv6Address nextHop;  //!< The link-local address of the neighbor.
+};
+
+/**
+ * The topology, with the links and the networks of each node stored
+ * contiguously: those of node i are in [first[i], first[i + 1]).
+ */
+struct Ipv6GlobalTopology
+{
+  std::vector<uint32_t> firstLink;            //!< The first link of each node.
+  std::vector<Ipv6GlobalLink> links;          //!< The links.
+  std::vector<uint32_t> firstNetwork;         //!< The first network of each node.
+  std::vector<uint32_t> nodeNetworks;         //!< The networks of the nodes, by index.
+  std::vector<Ipv6GlobalNetwork> networks;    //!< The networks, sorted.
+  std::vector<bool> transit;                  //!< Whether each node forwards.
+  std::vector<Ptr<Ipv6StaticRouting> > routing;  //!< The static routing of each node, or 0.
+};
+
+/** A route installed by the helper. */
+struct Ipv6GlobalRoute
+{
+  Ipv6GlobalNetwork destination;  //!< The destination network.
+  uint32_t ifIndex;               //!< The outgoing interface.
+  Ipv6Address nextHop;            //!< The link-local address of the next hop.
+  uint32_t metric;                //!< The cost of the path.
+
+  /**
+   * \param o The other route.
+   * \returns True if this route is ordered before o.
+   */
+  bool operator < (const Ipv6GlobalRoute &o) const
+  {
+    return destination < o.destination;
+  }
+};
+
+/** The routes of a node, sorted by destination. */
+typedef std::vector<Ipv6GlobalRoute> Ipv6GlobalRoutes;
+
+/** The routes installed in a node. */
+struct Ipv6GlobalInstalled
+{
+  Ipv6GlobalRoutes routes;  //!< The routes, sorted.
+  uint32_t tableSize;       //!< The number of routes of the static routing once they were installed.
+};
+
+/**
+ * The routes installed in each node, indexed by node id, until the
+ * simulator is destroyed along with the nodes.
+ */
+static std::vector<Ipv6GlobalInstalled> g_ipv6GlobalRoutes;
+/** Whether the routes installed are forgotten when the simulator is destroyed. */
+static bool g_ipv6GlobalRoutesDestroy = false;
+
+/**
+ * \brief Forget the routes installed.
+ */
+static void
+ClearInstalledRoutes (void)
+{
+  g_ipv6GlobalRoutes.clear ();
+  g_ipv6GlobalRoutesDestroy = false;
+}
+
+/**
+ * \param a A route.
+ * \param b Another route.
+ * \returns True if a is ordered before b, by all their fields.
+ */
+static bool
+IsRouteBefore (const Ipv6GlobalRoute &a, const Ipv6GlobalRoute &b)
+{
+  if (a.destination < b.destination || b.destination < a.destination)
+    {
+      return a.destination < b.destination;
+    }
+  if (a.ifIndex != b.ifIndex)
+    {
+      return a.ifIndex < b.ifIndex;
+    }
+  if (a.nextHop != b.nextHop)
+    {
+      return a.nextHop < b.nextHop;
+    }
+  return a.metric < b.metric;
+}
+
+/**
+ * \param ipv6 The stack of a node.
+ * \param interface An interface of the node.
+ * \param address The link-local address found.
+ * \returns True if the interface has a link-local address.
+ */
+static bool
+GetLinkLocalAddress (Ptr<Ipv6> ipv6, uint32_t interface, Ipv6Address &address)
+{
+  for (uint32_t i = 0; i < ipv6->GetNAddresses (interface); i++)
+    {
+      Ipv6InterfaceAddress ifAddr = ipv6->GetAddress (interface, i);
+      if (ifAddr.GetScope () == Ipv6InterfaceAddress::LINKLOCAL)
+        {
+          address = ifAddr.GetAddress ();
+          return true;
+        }
+    }
+  return false;
+}
+
+/**
+ * \brief Build the topology from the interfaces which are up.
+ * \param topology The topology built.
+ */
+static void
+BuildTopology (Ipv6GlobalTopology &topology)
+{
+  uint32_t nNodes = NodeList::GetNNodes ();
+  std::vector<std::pair<uint32_t, Ipv6GlobalNetwork> > attachments;
+  Ipv6StaticRoutingHelper staticRouting;
+
+  topology.firstLink.assign (1, 0);
+  topology.links.clear ();
+  topology.transit.assign (nNodes, false);
+  topology.routing.assign (nNodes, 0);
+  for (uint32_t i = 0; i < nNodes; i++)
+    {
+      Ptr<Ipv6> ipv6 = NodeList::GetNode (i)->GetObject<Ipv6> ();
+      if (ipv6 != 0)
+        {
+          topology.routing[i] = staticRouting.GetStaticRouting (ipv6);
+          for (uint32_t j = 0; j < ipv6->GetNInterfaces (); j++)
+            {
+              if (!ipv6->IsUp (j))
+                {
+                  continue;
+                }
+              if (ipv6->IsForwarding (j))
+                {
+                  topology.transit[i] = true;
+                }
+              for (uint32_t k = 0; k < ipv6->GetNAddresses (j); k++)
+                {
+                  Ipv6InterfaceAddress ifAddr = ipv6->GetAddress (j, k);
+                  if (ifAddr.GetScope () == Ipv6InterfaceAddress::GLOBAL)
+                    {
+                      Ipv6GlobalNetwork network;
+                      network.network = ifAddr.GetAddress ().CombinePrefix (ifAddr.GetPrefix ());
+                      network.prefixLength = ifAddr.GetPrefix ().GetPrefixLength ();
+                      attachments.push_back (std::make_pair (i, network));
+                    }
+                }
+              Ptr<NetDevice> device = ipv6->GetNetDevice (j);
+              Ptr<Channel> channel = device->GetChannel ();
+              if (channel == 0)
+                {
+                  continue;
+                }
+              for (uint32_t k = 0; k < channel->GetNDevices (); k++)
+                {
+                  Ptr<NetDevice> peer = channel->GetDevice (k);
+                  if (peer == device)
+                    {
+                      continue;
+                    }
+                  Ptr<Ipv6> peerIpv6 = peer->GetNode ()->GetObject<Ipv6> ();
+                  if (peerIpv6 == 0)
+                    {
+                      continue;
+                    }
+                  int32_t peerInterface = peerIpv6->GetInterfaceForDevice (peer);
+                  Ipv6GlobalLink link;
+                  if (peerInterface < 0 || !peerIpv6->IsUp (peerInterface)
+                      || !GetLinkLocalAddress (peerIpv6, peerInterface, link.nextHop))
+                    {
+                      continue;
+                    }
+                  link.to = peer->GetNode ()->GetId ();
+                  link.cost = ipv6->GetMetric (j);
+                  link.ifIndex = j;
+                  topology.links.push_back (link);
+                }
+            }
+        }
+      topology.firstLink.push_back (topology.links.size ());
+    }
+
+  topology.networks.clear ();
+  for (uint32_t i = 0; i < attachments.size (); i++)
+    {
+      topology.networks.push_back (attachments[i].second);
+    }
+  std::sort (topology.networks.begin (), topology.networks.end ());
+  topology.networks.erase (std::unique (topology.networks.begin (), topology.networks.end ()),
+                           topology.networks.end ());
+
+  // the attachments are in node order
+  topology.firstNetwork.assign (nNodes + 1, 0);
+  topology.nodeNetworks.clear ();
+  uint32_t a = 0;
+  for (uint32_t i = 0; i < nNodes; i++)
+    {
+      topology.firstNetwork[i] = topology.nodeNetworks.size ();
+      for (; a < attachments.size () && attachments[a].first == i; a++)
+        {
+          topology.nodeNetworks.push_back (std::lower_bound (topology.networks.begin (),
+                                                             topology.networks.end (),
+                                                             attachments[a].second)
+                                           - topology.networks.begin ());
+        }
+    }
+  topology.firstNetwork[nNodes] = topology.nodeNetworks.size ();
+
+  NS_LOG_INFO (nNodes << " nodes, " << topology.links.size () << " links, "
+                      << topology.networks.size () << " networks");
+}
+
+/**
+ * \brief Compute the routes of a node with Dijkstra's algorithm.
+ *
+ * The nodes are visited by increasing distance, so the first node
+ * found on a network is the nearest one.
+ *
+ * \param topology The topology.
+ * \param source The node.
+ * \param seen For each network, the last node for which a route to
+ * it was found.
+ * \param routes The routes computed.
+ */
+static void
+ComputeRoutes (const Ipv6GlobalTopology &topology, uint32_t source,
+               std::vector<uint32_t> &seen, Ipv6GlobalRoutes &routes)
+{
+  typedef std::pair<uint32_t, uint32_t> Candidate;  // distance, node
+  const uint32_t infinity = std::numeric_limits<uint32_t>::max ();
+  uint32_t nNodes = topology.transit.size ();
+  std::vector<uint32_t> distance (nNodes, infinity);
+  std::vector<uint32_t> firstHop (nNodes, 0);
+  std::priority_queue<Candidate, std::vector<Candidate>, std::greater<Candidate> > candidates;
+
+  for (uint32_t n = topology.firstNetwork[source]; n < topology.firstNetwork[source + 1]; n++)
+    {
+      seen[topology.nodeNetworks[n]] = source;
+    }
+
+  routes.clear ();
+  distance[source] = 0;
+  candidates.push (Candidate (0, source));
+  while (!candidates.empty ())
+    {
+      uint32_t d = candidates.top ().first;
+      uint32_t node = candidates.top ().second;
+      candidates.pop ();
+      if (d > distance[node])
+        {
+          continue;
+        }
+      if (node != source)
+        {
+          const Ipv6GlobalLink &link = topology.links[firstHop[node]];
+          for (uint32_t n = topology.firstNetwork[node]; n < topology.firstNetwork[node + 1]; n++)
+            {
+              uint32_t network = topology.nodeNetworks[n];
+              if (seen[network] != source)
+                {
+                  seen[network] = source;
+                  Ipv6GlobalRoute route;
+                  route.destination = topology.networks[network];
+                  route.ifIndex = link.ifIndex;
+                  route.nextHop = link.nextHop;
+                  route.metric = d;
+                  routes.push_back (route);
+                }
+            }
+          if (!topology.transit[node])
+            {
+              continue;
+            }
+        }
+      for (uint32_t l = topology.firstLink[node]; l < topology.firstLink[node + 1]; l++)
+        {
+          const Ipv6GlobalLink &link = topology.links[l];
+          uint32_t candidate = d + link.cost;
+          if (candidate < distance[link.to])
+            {
+              distance[link.to] = candidate;
+              firstHop[link.to] = (node == source) ? l : firstHop[node];
+              candidates.push (Candidate (candidate, link.to));
+            }
+        }
+    }
+  std::sort (routes.begin (), routes.end ());
+}
+
+/**
+ * \param low A network.
+ * \param high Another network, with the same prefix length.
+ * \returns True if they are the lower and the upper half of the same
+ * network.
+ */
+static bool
+AreHalves (const Ipv6GlobalNetwork &low, const Ipv6GlobalNetwork &high)
+{
+  uint8_t a[16];
+  uint8_t b[16];
+  low.network.GetBytes (a);
+  high.network.GetBytes (b);
+  uint32_t bit = low.prefixLength - 1;
+  uint8_t mask = 0x80 >> (bit % 8);
+  if ((a[bit / 8] & mask) != 0 || (a[bit / 8] | mask) != b[bit / 8])
+    {
+      return false;
+    }
+  for (uint32_t k = 0; k < 16; k++)
+    {
+      if (k != bit / 8 && a[k] != b[k])
+        {
+          return false;
+        }
+    }
+  return true;
+}
+
+/**
+ * \brief Replace the routes to the two halves of a network by a route
+ * to the network, when they have the same next hop and the network is
+ * not a destination of its own, from the longest prefixes up.
+ *
+ * The halves cover the network, and the routes to the more specific
+ * networks are kept, so the longest prefix match still gives the same
+ * next hop for every address.
+ *
+ * \param networks The networks of the topology, sorted.
+ * \param routes The routes of a node, sorted, aggregated in place.
+ */
+static void
+AggregateRoutes (const std::vector<Ipv6GlobalNetwork> &networks, Ipv6GlobalRoutes &routes)
+{
+  // the routes of each length stay sorted, and the merged ones are
+  // merged into those of the shorter length in turn
+  std::vector<Ipv6GlobalRoutes> byLength (129);
+  for (uint32_t i = 0; i < routes.size (); i++)
+    {
+      byLength[routes[i].destination.prefixLength].push_back (routes[i]);
+    }
+  std::vector<uint32_t> sorted (129);
+  for (uint32_t length = 0; length <= 128; length++)
+    {
+      sorted[length] = byLength[length].size ();
+    }
+  routes.clear ();
+  for (uint32_t length = 128; length > 0; length--)
+    {
+      Ipv6GlobalRoutes &level = byLength[length];
+      std::inplace_merge (level.begin (), level.begin () + sorted[length], level.end ());
+      for (uint32_t i = 0; i < level.size (); i++)
+        {
+          if (i + 1 < level.size ()
+              && level[i].ifIndex == level[i + 1].ifIndex
+              && level[i].nextHop == level[i + 1].nextHop
+              && AreHalves (level[i].destination, level[i + 1].destination))
+            {
+              Ipv6GlobalRoute parent = level[i];
+              parent.destination.prefixLength = length - 1;
+              if (!std::binary_search (networks.begin (), networks.end (), parent.destination))
+                {
+                  parent.metric = std::max (level[i].metric, level[i + 1].metric);
+                  byLength[length - 1].push_back (parent);
+                  i++;
+                  continue;
+                }
+            }
+          routes.push_back (level[i]);
+        }
+    }
+  routes.insert (routes.end (), byLength[0].begin (), byLength[0].end ());
+  std::sort (routes.begin (), routes.end ());
+}
+
+/**
+ * \brief Forget the installed routes which are no longer in the static
+ * routing, e.g. because their interface went down since they were
+ * installed, so that they are installed again.
+ *
+ * The table is only read when its size changed since the routes were
+ * installed, as reading it takes a time quadratic in its size.
+ *
+ * \param routing The static routing of the node.
+ * \param installed The routes installed in the node.
+ */
+static void
+CheckInstalledRoutes (Ptr<Ipv6StaticRouting> routing, Ipv6GlobalInstalled &installed)
+{
+  if (installed.routes.empty () || routing->GetNRoutes () == installed.tableSize)
+    {
+      return;
+    }
+  Ipv6GlobalRoutes present;
+  for (uint32_t i = 0; i < routing->GetNRoutes (); i++)
+    {
+      Ipv6RoutingTableEntry entry = routing->GetRoute (i);
+      if (entry.IsGateway ())
+        {
+          Ipv6GlobalRoute route;
+          route.destination.network = entry.GetDest ();
+          route.destination.prefixLength = entry.GetDestNetworkPrefix ().GetPrefixLength ();
+          route.ifIndex = entry.GetInterface ();
+          route.nextHop = entry.GetGateway ();
+          route.metric = routing->GetMetric (i);
+          present.push_back (route);
+        }
+    }
+  std::sort (present.begin (), present.end (), IsRouteBefore);
+  Ipv6GlobalRoutes kept;
+  for (uint32_t i = 0; i < installed.routes.size (); i++)
+    {
+      if (std::binary_search (present.begin (), present.end (), installed.routes[i], IsRouteBefore))
+        {
+          kept.push_back (installed.routes[i]);
+        }
+    }
+  NS_LOG_LOGIC (installed.routes.size () - kept.size () << " routes lost since they were installed");
+  installed.routes.swap (kept);
+}
+
+/**
+ * \brief Update the routes of a node, leaving the unchanged ones alone.
+ * \param routing The static routing of the node.
+ * \param installed The routes installed, sorted.
+ * \param routes The new routes, sorted.
+ */
+static void
+UpdateRoutes (Ptr<Ipv6StaticRouting> routing, const Ipv6GlobalRoutes &installed,
+              const Ipv6GlobalRoutes &routes)
+{
+  Ipv6GlobalRoutes::const_iterator i = installed.begin ();
+  Ipv6GlobalRoutes::const_iterator j = routes.begin ();
+  while (i != installed.end () || j != routes.end ())
+    {
+      bool remove = j == routes.end () || (i != installed.end () && *i < *j);
+      bool add = i == installed.end () || (j != routes.end () && *j < *i);
+      if (!remove && !add)
+        {
+          // same destination
+          if (i->ifIndex != j->ifIndex || i->nextHop != j->nextHop || i->metric != j->metric)
+            {
+              remove = true;
+              add = true;
+            }
+          else
+            {
+              i++;
+              j++;
+              continue;
+            }
+        }
+      if (remove)
+        {
+          routing->RemoveRoute (i->destination.network, Ipv6Prefix (i->destination.prefixLength),
+                                i->ifIndex, Ipv6Address::GetZero ());
+          i++;
+        }
+      if (add)
+        {
+          routing->AddNetworkRouteTo (j->destination.network, Ipv6Prefix (j->destination.prefixLength),
+                                      j->nextHop, j->ifIndex, j->metric);
+          j++;
+        }
+    }
+}
+
+Ipv6GlobalRoutingHelper::Ipv6GlobalRoutingHelper ()
+{
+}
+
+Ipv6GlobalRoutingHelper::Ipv6GlobalRoutingHelper (const Ipv6GlobalRoutingHelper &o)
+{
+}
+
+Ipv6GlobalRoutingHelper*
+Ipv6GlobalRoutingHelper::Copy (void) const
+{
+  return new Ipv6GlobalRoutingHelper (*this);
+}
+
+Ptr<Ipv6RoutingProtocol>
+Ipv6GlobalRoutingHelper::Create (Ptr<Node> node) const
+{
+  return CreateObject<Ipv6StaticRouting> ();
+}
+
+void
+Ipv6GlobalRoutingHelper::PopulateRoutingTables (void)
+{
+  g_ipv6GlobalRoutes.clear ();
+  RecomputeRoutingTables ();
+}
+
+void
+Ipv6GlobalRoutingHelper::RecomputeRoutingTables (void)
+{
+  Ipv6GlobalTopology topology;
+  BuildTopology (topology);
+
+  uint32_t nNodes = topology.transit.size ();
+  std::vector<uint32_t> seen (topology.networks.size (), std::numeric_limits<uint32_t>::max ());
+  Ipv6GlobalRoutes routes;
+  if (!g_ipv6GlobalRoutesDestroy)
+    {
+      Simulator::ScheduleDestroy (&ClearInstalledRoutes);
+      g_ipv6GlobalRoutesDestroy = true;
+    }
+  Ipv6GlobalInstalled none;
+  none.tableSize = 0;
+  g_ipv6GlobalRoutes.resize (nNodes, none);
+  for (uint32_t i = 0; i < nNodes; i++)
+    {
+      if (topology.routing[i] == 0)
+        {
+          if (topology.firstLink[i] != topology.firstLink[i + 1])
+            {
+              NS_LOG_WARN ("Node " << i << " has no Ipv6StaticRouting: no routes installed");
+            }
+          continue;
+        }
+      ComputeRoutes (topology, i, seen, routes);
+      AggregateRoutes (topology.networks, routes);
+      Ipv6GlobalInstalled &installed = g_ipv6GlobalRoutes[i];
+      CheckInstalledRoutes (topology.routing[i], installed);
+      UpdateRoutes (topology.routing[i], installed.routes, routes);
+      installed.routes.swap (routes);
+      installed.tableSize = topology.routing[i]->GetNRoutes ();
+    }
+}
+
+} // namespace ns3
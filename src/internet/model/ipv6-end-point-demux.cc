@@ -26,6 +26,55 @@ namespace ns3 {
 
 NS_LOG_COMPONENT_DEFINE ("Ipv6EndPointDemux");
 
+Ipv6EndPointDemux::FourTuple::FourTuple (Ipv6Address localAddress, uint16_t localPort,
+                                          Ipv6Address peerAddress, uint16_t peerPort)
+  : localAddress (localAddress),
+    peerAddress (peerAddress),
+    localPort (localPort),
+    peerPort (peerPort)
+{
+}
+
+bool Ipv6EndPointDemux::FourTuple::operator == (const FourTuple &o) const
+{
+  return localPort == o.localPort && peerPort == o.peerPort
+         && localAddress == o.localAddress && peerAddress == o.peerAddress;
+}
+
+size_t Ipv6EndPointDemux::FourTupleHash::operator () (const FourTuple &t) const
+{
+  Ipv6AddressHash hash;
+  size_t h = hash (t.localAddress) ^ (hash (t.peerAddress) * 31);
+  return h ^ ((static_cast<size_t> (t.localPort) << 16) | t.peerPort);
+}
+
+/**
+ * \brief Check the device an end point is bound to, if any.
+ * \param endP the end point
+ * \param incomingInterface the interface the packet was received on
+ * \return true if the end point may receive packets from the interface
+ */
+static bool
+MatchesBoundDevice (Ipv6EndPoint *endP, Ptr<Ipv6Interface> incomingInterface)
+{
+  if (endP->GetBoundNetDevice ())
+    {
+      if (!incomingInterface)
+        {
+          return false;
+        }
+      if (endP->GetBoundNetDevice () != incomingInterface->GetDevice ())
+        {
+          NS_LOG_LOGIC ("Skipping endpoint " << &endP
+                                             << " because endpoint is bound to specific device and"
+                                             << endP->GetBoundNetDevice ()
+                                             << " does not match packet device " << incomingInterface->GetDevice ());
+          return false;
+        }
+    }
+  return true;
+}
+
 Ipv6EndPointDemux::Ipv6EndPointDemux ()
   : m_ephemeral (49152),
     m_portFirst (49152),
@@ -40,36 +89,27 @@ Ipv6EndPointDemux::~Ipv6EndPointDemux ()
   for (EndPointsI i = m_endPoints.begin (); i != m_endPoints.end (); i++)
     {
       Ipv6EndPoint *endPoint = *i;
+      endPoint->m_demux = 0;
       delete endPoint;
     }
   m_endPoints.clear ();
+  m_connected.clear ();
+  m_wildcards.clear ();
+  m_localCounts.clear ();
+  m_portCounts.clear ();
 }
 
 bool Ipv6EndPointDemux::LookupPortLocal (uint16_t port)
 {
   NS_LOG_FUNCTION (this << port);
-  for (EndPointsI i = m_endPoints.begin (); i != m_endPoints.end (); i++)
-    {
-      if ((*i)->GetLocalPort  () == port)
-        {
-          return true;
-        }
-    }
-  return false;
+  return m_portCounts.find (port) != m_portCounts.end ();
 }
 
 bool Ipv6EndPointDemux::LookupLocal (Ipv6Address addr, uint16_t port)
 {
   NS_LOG_FUNCTION (this << addr << port);
-  for (EndPointsI i = m_endPoints.begin (); i != m_endPoints.end (); i++)
-    {
-      if ((*i)->GetLocalPort () == port
-          && (*i)->GetLocalAddress () == addr)
-        {
-          return true;
-        }
-    }
-  return false;
+  FourTuple local (addr, port, Ipv6Address::GetAny (), 0);
+  return m_localCounts.find (local) != m_localCounts.end ();
 }
 
 Ipv6EndPoint* Ipv6EndPointDemux::Allocate ()
@@ -81,10 +121,7 @@ Ipv6EndPoint* Ipv6EndPointDemux::Allocate ()
       NS_LOG_WARN ("Ephemeral port allocation failed.");
       return 0;
     }
-  Ipv6EndPoint *endPoint = new Ipv6EndPoint (Ipv6Address::GetAny (), port);
-  m_endPoints.push_back (endPoint);
-  NS_LOG_DEBUG ("Now have >>" << m_endPoints.size () << "<< endpoints.");
-  return endPoint;
+  return Insert (new Ipv6EndPoint (Ipv6Address::GetAny (), port));
 }
 
 Ipv6EndPoint* Ipv6EndPointDemux::Allocate (Ipv6Address address)
@@ -96,10 +133,7 @@ Ipv6EndPoint* Ipv6EndPointDemux::Allocate (Ipv6Address address)
       NS_LOG_WARN ("Ephemeral port allocation failed.");
       return 0;
     }
-  Ipv6EndPoint *endPoint = new Ipv6EndPoint (address, port);
-  m_endPoints.push_back (endPoint);
-  NS_LOG_DEBUG ("Now have >>" << m_endPoints.size () << "<< endpoints.");
-  return endPoint;
+  return Insert (new Ipv6EndPoint (address, port));
 }
 
 Ipv6EndPoint* Ipv6EndPointDemux::Allocate (uint16_t port)
@@ -117,49 +151,60 @@ Ipv6EndPoint* Ipv6EndPointDemux::Allocate (Ipv6Address address, uint16_t port)
       NS_LOG_WARN ("Duplicate address/port; failing.");
       return 0;
     }
-  Ipv6EndPoint *endPoint = new Ipv6EndPoint (address, port);
-  m_endPoints.push_back (endPoint);
-  NS_LOG_DEBUG ("Now have >>" << m_endPoints.size () << "<< endpoints.");
-  return endPoint;
+  return Insert (new Ipv6EndPoint (address, port));
 }
 
 Ipv6EndPoint* Ipv6EndPointDemux::Allocate (Ipv6Address localAddress, uint16_t localPort,
                                            Ipv6Address peerAddress, uint16_t peerPort)
 {
   NS_LOG_FUNCTION (this << localAddress << localPort << peerAddress << peerPort);
-  for (EndPointsI i = m_endPoints.begin (); i != m_endPoints.end (); i++)
+  Ipv6EndPoint *endPoint = new Ipv6EndPoint (localAddress, localPort);
+  endPoint->SetPeer (peerAddress, peerPort);
+
+  bool duplicate = false;
+  if (IsFullySpecified (endPoint))
+    {
+      FourTuple key (localAddress, localPort, peerAddress, peerPort);
+      duplicate = m_connected.find (key) != m_connected.end ();
+    }
+  else
     {
-      if ((*i)->GetLocalPort () == localPort
-          && (*i)->GetLocalAddress () == localAddress
-          && (*i)->GetPeerPort () == peerPort
-          && (*i)->GetPeerAddress () == peerAddress)
+      PortMap::iterator wildcards = m_wildcards.find (localPort);
+      if (wildcards != m_wildcards.end ())
         {
-          NS_LOG_WARN ("No way we can allocate this end-point.");
-          /* no way we can allocate this end-point. */
-          return 0;
+          for (EndPointsI i = wildcards->second.begin (); i != wildcards->second.end (); i++)
+            {
+              if ((*i)->GetLocalAddress () == localAddress
+                  && (*i)->GetPeerPort () == peerPort
+                  && (*i)->GetPeerAddress () == peerAddress)
+                {
+                  duplicate = true;
+                  break;
+                }
+            }
         }
     }
-  Ipv6EndPoint *endPoint = new Ipv6EndPoint (localAddress, localPort);
-  endPoint->SetPeer (peerAddress, peerPort);
-  m_endPoints.push_back (endPoint);
-
-  NS_LOG_DEBUG ("Now have >>" << m_endPoints.size () << "<< endpoints.");
-
-  return endPoint;
+  if (duplicate)
+    {
+      NS_LOG_WARN ("No way we can allocate this end-point.");
+      /* no way we can allocate this end-point. */
+      delete endPoint;
+      return 0;
+    }
+  return Insert (endPoint);
 }
 
 void Ipv6EndPointDemux::DeAllocate (Ipv6EndPoint *endPoint)
 {
   NS_LOG_FUNCTION_NOARGS ();
-  for (EndPointsI i = m_endPoints.begin (); i != m_endPoints.end (); i++)
+  if (endPoint->m_demux != this)
     {
-      if (*i == endPoint)
-        {
-          delete endPoint;
-          m_endPoints.erase (i);
-          break;
-        }
+      return;
     }
+  RemoveFromIndex (endPoint);
+  m_endPoints.erase (endPoint->m_demuxIt);
+  endPoint->m_demux = 0;
+  delete endPoint;
 }
 
 /*
@@ -179,7 +224,34 @@ Ipv6EndPointDemux::EndPoints Ipv6EndPointDemux::Lookup (Ipv6Address daddr, uint1
   EndPoints retval4; /* Exact match on all 4 */
 
   NS_LOG_DEBUG ("Looking up endpoint for destination address " << daddr);
-  for (EndPointsI i = m_endPoints.begin (); i != m_endPoints.end (); i++)
+
+  /* The fully specified end points can only match exactly */
+  FourTupleMap::iterator connected = m_connected.find (FourTuple (daddr, dport, saddr, sport));
+  if (connected != m_connected.end ())
+    {
+      for (EndPointsI i = connected->second.begin (); i != connected->second.end (); i++)
+        {
+          Ipv6EndPoint* endP = *i;
+          if (!endP->IsRxEnabled ())
+            {
+              NS_LOG_LOGIC ("Skipping endpoint " << &endP
+                            << " because endpoint can not receive packets");
+              continue;
+            }
+          if (!MatchesBoundDevice (endP, incomingInterface))
+            {
+              continue;
+            }
+          retval4.push_back (endP);
+        }
+    }
+
+  PortMap::iterator wildcards = m_wildcards.find (dport);
+  if (wildcards == m_wildcards.end ())
+    {
+      return retval4;
+    }
+  for (EndPointsI i = wildcards->second.begin (); i != wildcards->second.end (); i++)
     {
       Ipv6EndPoint* endP = *i;
 
@@ -195,31 +267,11 @@ Ipv6EndPointDemux::EndPoints Ipv6EndPointDemux::Lookup (Ipv6Address daddr, uint1
           continue;
         }
 
-      if (endP->GetLocalPort () != dport)
+      if (!MatchesBoundDevice (endP, incomingInterface))
         {
-          NS_LOG_LOGIC ("Skipping endpoint " << &endP
-                                             << " because endpoint dport "
-                                             << endP->GetLocalPort ()
-                                             << " does not match packet dport " << dport);
           continue;
         }
 
-      if (endP->GetBoundNetDevice ())
-        {
-          if (!incomingInterface)
-            {
-              continue;
-            }
-          if (endP->GetBoundNetDevice () != incomingInterface->GetDevice ())
-            {
-              NS_LOG_LOGIC ("Skipping endpoint " << &endP
-                                                 << " because endpoint is bound to specific device and"
-                                                 << endP->GetBoundNetDevice ()
-                                                 << " does not match packet device " << incomingInterface->GetDevice ());
-              continue;
-            }
-        }
-
       /*    Ipv6Address incomingInterfaceAddr = incomingInterface->GetAddress (); */
       NS_LOG_DEBUG ("dest addr " << daddr);
 
@@ -296,14 +348,21 @@ Ipv6EndPoint* Ipv6EndPointDemux::SimpleLookup (Ipv6Address dst, uint16_t dport,
   uint32_t genericity = 3;
   Ipv6EndPoint *generic = 0;
 
-  for (EndPointsI i = m_endPoints.begin (); i != m_endPoints.end (); i++)
+  FourTupleMap::iterator connected = m_connected.find (FourTuple (dst, dport, src, sport));
+  if (connected != m_connected.end ())
     {
-      uint32_t tmp = 0;
+      /* this is an exact match. */
+      return connected->second.front ();
+    }
 
-      if ((*i)->GetLocalPort () != dport)
-        {
-          continue;
-        }
+  PortMap::iterator wildcards = m_wildcards.find (dport);
+  if (wildcards == m_wildcards.end ())
+    {
+      return 0;
+    }
+  for (EndPointsI i = wildcards->second.begin (); i != wildcards->second.end (); i++)
+    {
+      uint32_t tmp = 0;
 
       if ((*i)->GetLocalAddress () == dst && (*i)->GetPeerPort () == sport
           && (*i)->GetPeerAddress () == src)
@@ -330,7 +389,6 @@ Ipv6EndPoint* Ipv6EndPointDemux::SimpleLookup (Ipv6Address dst, uint16_t dport,
     }
   return generic;
 }
-
 uint16_t Ipv6EndPointDemux::AllocateEphemeralPort ()
 {
   NS_LOG_FUNCTION_NOARGS ();
@@ -358,5 +416,84 @@ Ipv6EndPointDemux::EndPoints Ipv6EndPointDemux::GetEndPoints () const
   return m_endPoints;
 }
 
+Ipv6EndPoint* Ipv6EndPointDemux::Insert (Ipv6EndPoint *endPoint)
+{
+  NS_LOG_FUNCTION (this << endPoint);
+  endPoint->m_demux = this;
+  endPoint->m_demuxIt = m_endPoints.insert (m_endPoints.end (), endPoint);
+  AddToIndex (endPoint);
+  NS_LOG_DEBUG ("Now have >>" << m_endPoints.size () << "<< endpoints.");
+  return endPoint;
+}
+
+bool Ipv6EndPointDemux::IsFullySpecified (Ipv6EndPoint *endPoint)
+{
+  return endPoint->GetLocalAddress () != Ipv6Address::GetAny ()
+         && endPoint->GetPeerAddress () != Ipv6Address::GetAny ()
+         && endPoint->GetPeerPort () != 0;
+}
+
+void Ipv6EndPointDemux::AddToIndex (Ipv6EndPoint *endPoint)
+{
+  NS_LOG_FUNCTION (this << endPoint);
+  uint16_t port = endPoint->GetLocalPort ();
+  m_localCounts[FourTuple (endPoint->GetLocalAddress (), port, Ipv6Address::GetAny (), 0)]++;
+  m_portCounts[port]++;
+
+  EndPoints *entry;
+  if (IsFullySpecified (endPoint))
+    {
+      entry = &m_connected[FourTuple (endPoint->GetLocalAddress (), port,
+                                      endPoint->GetPeerAddress (), endPoint->GetPeerPort ())];
+    }
+  else
+    {
+      entry = &m_wildcards[port];
+    }
+  endPoint->m_indexIt = entry->insert (entry->end (), endPoint);
+}
+
+void Ipv6EndPointDemux::RemoveFromIndex (Ipv6EndPoint *endPoint)
+{
+  NS_LOG_FUNCTION (this << endPoint);
+  uint16_t port = endPoint->GetLocalPort ();
+  LocalCountMap::iterator local = m_localCounts.find (FourTuple (endPoint->GetLocalAddress (), port,
+                                                                 Ipv6Address::GetAny (), 0));
+  NS_ASSERT (local != m_localCounts.end ());
+  if (--local->second == 0)
+    {
+      m_localCounts.erase (local);
+    }
+  PortCountMap::iterator ports = m_portCounts.find (port);
+  NS_ASSERT (ports != m_portCounts.end ());
+  if (--ports->second == 0)
+    {
+      m_portCounts.erase (ports);
+    }
+
+  if (IsFullySpecified (endPoint))
+    {
+      FourTupleMap::iterator connected = m_connected.find (FourTuple (endPoint->GetLocalAddress (), port,
+                                                                      endPoint->GetPeerAddress (),
+                                                                      endPoint->GetPeerPort ()));
+      NS_ASSERT (connected != m_connected.end ());
+      connected->second.erase (endPoint->m_indexIt);
+      if (connected->second.empty ())
+        {
+          m_connected.erase (connected);
+        }
+    }
+  else
+    {
+      PortMap::iterator wildcards = m_wildcards.find (port);
+      NS_ASSERT (wildcards != m_wildcards.end ());
+      wildcards->second.erase (endPoint->m_indexIt);
+      if (wildcards->second.empty ())
+        {
+          m_wildcards.erase (wildcards);
+        }
+    }
+}
+
 } /* namespace ns3 */
 
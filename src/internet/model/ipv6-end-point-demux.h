@@ -24,6 +24,7 @@
 #include <stdint.h>
 #include <list>
 #include "ns3/ipv6-address.h"
+#include "ns3/sgi-hashmap.h"
 #include "ipv6-interface.h"
 
 namespace ns3 {
@@ -33,6 +34,14 @@ class Ipv6EndPoint;
 /**
  * \class Ipv6EndPointDemux
  * \brief Demultiplexor for end points.
+ *
+ * The end points whose four-tuple is fully specified (connected TCP
+ * sockets, connected UDP sockets bound to an address) are indexed by
+ * their four-tuple. The other ones, which hold a wildcard, are indexed
+ * by their local port. A lookup thus reads one entry of each table
+ * instead of scanning all the end points. The end points tell the demux
+ * when their addresses or ports change, so that it moves them to their
+ * new place.
  */
 class Ipv6EndPointDemux
 {
@@ -146,12 +155,102 @@ public:
   EndPoints GetEndPoints () const;
 
 private:
+  friend class Ipv6EndPoint;
+
+  /**
+   * \brief The four-tuple of an end point.
+   */
+  struct FourTuple
+  {
+    /**
+     * \brief Constructor.
+     * \param localAddress the local address
+     * \param localPort the local port
+     * \param peerAddress the peer address
+     * \param peerPort the peer port
+     */
+    FourTuple (Ipv6Address localAddress, uint16_t localPort,
+               Ipv6Address peerAddress, uint16_t peerPort);
+    /**
+     * \brief Comparison operator.
+     * \param o the other four-tuple
+     * \return true if the four-tuples are equal
+     */
+    bool operator == (const FourTuple &o) const;
+
+    Ipv6Address localAddress; //!< The local address.
+    Ipv6Address peerAddress;  //!< The peer address.
+    uint16_t localPort;       //!< The local port.
+    uint16_t peerPort;        //!< The peer port.
+  };
+
+  /**
+   * \brief Hash function of the four-tuples.
+   */
+  struct FourTupleHash
+  {
+    /**
+     * \brief Hash a four-tuple.
+     * \param t the four-tuple
+     * \return the hash
+     */
+    size_t operator () (const FourTuple &t) const;
+  };
+
+  /**
+   * \brief End points indexed by four-tuple.
+   */
+  typedef sgi::hash_map<FourTuple, EndPoints, FourTupleHash> FourTupleMap;
+
+  /**
+   * \brief End points indexed by local port.
+   */
+  typedef sgi::hash_map<uint16_t, EndPoints> PortMap;
+
+  /**
+   * \brief Number of end points per local address and port. The peer
+   * fields of the key are not used.
+   */
+  typedef sgi::hash_map<FourTuple, uint32_t, FourTupleHash> LocalCountMap;
+
+  /**
+   * \brief Number of end points per local port.
+   */
+  typedef sgi::hash_map<uint16_t, uint32_t> PortCountMap;
+
   /**
    * \brief Allocate a ephemeral port.
    * \return a port
    */
   uint16_t AllocateEphemeralPort ();
 
+  /**
+   * \brief Add a new end point to the demux.
+   * \param endPoint the end point
+   * \return the end point
+   */
+  Ipv6EndPoint * Insert (Ipv6EndPoint *endPoint);
+
+  /**
+   * \brief Index an end point under its current four-tuple.
+   * \param endPoint the end point
+   */
+  void AddToIndex (Ipv6EndPoint *endPoint);
+
+  /**
+   * \brief Remove an end point from the index, before its four-tuple
+   * changes or before it is deleted.
+   * \param endPoint the end point
+   */
+  void RemoveFromIndex (Ipv6EndPoint *endPoint);
+
+  /**
+   * \brief Check if an end point is indexed by four-tuple.
+   * \param endPoint the end point
+   * \return true if no field of the four-tuple is a wildcard
+   */
+  static bool IsFullySpecified (Ipv6EndPoint *endPoint);
+
   /**
    * \brief The ephemeral port.
    */
@@ -171,6 +270,26 @@ private:
    * \brief A list of IPv6 end points.
    */
   EndPoints m_endPoints;
+
+  /**
+   * \brief The fully specified end points.
+   */
+  FourTupleMap m_connected;
+
+  /**
+   * \brief The end points with a wildcard, by local port.
+   */
+  PortMap m_wildcards;
+
+  /**
+   * \brief The number of end points per local address and port.
+   */
+  LocalCountMap m_localCounts;
+
+  /**
+   * \brief The number of end points per local port.
+   */
+  PortCountMap m_portCounts;
 };
 
 } /* namespace ns3 */
@@ -22,6 +22,7 @@
 #define IPV6_END_POINT_H
 
 #include <stdint.h>
+#include <list>
 
 #include "ns3/ipv6-address.h"
 #include "ns3/callback.h"
@@ -34,6 +35,7 @@ namespace ns3
 
 class Header;
 class Packet;
+class Ipv6EndPointDemux;
 
 /**
  * \brief A representation of an internet IPv6 endpoint/connection
@@ -234,6 +236,24 @@ private:
    * \brief true if the endpoint can receive packets.
    */
   bool m_rxEnabled;
+
+  friend class Ipv6EndPointDemux;
+
+  /**
+   * \brief The demux which indexes this end point, if any. It is told
+   * when the four-tuple changes.
+   */
+  Ipv6EndPointDemux *m_demux;
+
+  /**
+   * \brief The position of this end point in the list of the demux.
+   */
+  std::list<Ipv6EndPoint *>::iterator m_demuxIt;
+
+  /**
+   * \brief The position of this end point in its index entry of the demux.
+   */
+  std::list<Ipv6EndPoint *>::iterator m_indexIt;
 };
 
 } /* namespace ns3 */
@@ -201,6 +201,11 @@ void Ipv6Interface::SetDown ()
 {
   NS_LOG_FUNCTION_NOARGS ();
   m_ifup = false;
+
+  for (Ipv6InterfaceAddressListCI it = m_addresses.begin (); it != m_addresses.end (); ++it)
+    {
+      NotifyAddressRemoved (it->first.GetAddress ());
+    }
   m_addresses.clear ();
   m_ndCache->Flush ();
 }
@@ -236,6 +241,12 @@ bool Ipv6Interface::AddAddress (Ipv6InterfaceAddress iface)
       Ipv6Address solicited = Ipv6Address::MakeSolicitedAddress (iface.GetAddress ());
       m_addresses.push_back (std::make_pair (iface, solicited));
 
+      Ptr<Ipv6L3Protocol> ipv6 = m_node->GetObject<Ipv6L3Protocol> ();
+      if (ipv6)
+        {
+          ipv6->NotifyAddressAdded (this, addr);
+        }
+
       if (!addr.IsAny () || !addr.IsLocalhost ())
         {
           /* DAD handling */
@@ -327,6 +338,7 @@ Ipv6InterfaceAddress Ipv6Interface::RemoveAddress (uint32_t index)
         {
           Ipv6InterfaceAddress iface = it->first;
           m_addresses.erase (it);
+          NotifyAddressRemoved (iface.GetAddress ());
           return iface;
         }
 
@@ -355,12 +367,29 @@ Ipv6Interface::RemoveAddress(Ipv6Address address)
         {
           Ipv6InterfaceAddress iface = it->first;
           m_addresses.erase(it);
+          NotifyAddressRemoved (iface.GetAddress ());
           return iface;
         }
     }
   return Ipv6InterfaceAddress();
 }
 
+void Ipv6Interface::NotifyAddressRemoved (Ipv6Address address)
+{
+  NS_LOG_FUNCTION (this << address);
+
+  if (m_node == 0)
+    {
+      return;
+    }
+
+  Ptr<Ipv6L3Protocol> ipv6 = m_node->GetObject<Ipv6L3Protocol> ();
+  if (ipv6)
+    {
+      ipv6->NotifyAddressRemoved (this, address);
+    }
+}
+
 Ipv6InterfaceAddress Ipv6Interface::GetAddressMatchingDestination (Ipv6Address dst)
 {
   NS_LOG_FUNCTION (this << dst);
@@ -298,6 +298,12 @@ private:
    */
   void DoSetup ();
 
+  /**
+   * \brief Tell the IPv6 stack that an address has been removed.
+   * \param address the removed address
+   */
+  void NotifyAddressRemoved (Ipv6Address address);
+
   /**
    * \brief The addresses assigned to this interface.
    */
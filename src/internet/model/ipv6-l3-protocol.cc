@@ -152,6 +152,7 @@ void Ipv6L3Protocol::DoDispose ()
     }
   m_interfaces.clear ();
   m_reverseInterfacesContainer.clear ();
+  m_localAddresses.clear ();
 
   /* remove raw sockets */
   for (SocketList::iterator it = m_sockets.begin (); it != m_sockets.end (); ++it)
@@ -219,21 +220,22 @@ uint32_t Ipv6L3Protocol::AddIpv6Interface (Ptr<Ipv6Interface> interface)
   m_interfaces.push_back (interface);
   m_reverseInterfacesContainer[interface->GetDevice ()] = index;
   m_nInterfaces++;
+
+  /* index the addresses configured before the interface was registered */
+  for (uint32_t i = 0; i < interface->GetNAddresses (); i++)
+    {
+      m_localAddresses[interface->GetAddress (i).GetAddress ()].push_back (index);
+    }
   return index;
 }
 
 Ptr<Ipv6Interface> Ipv6L3Protocol::GetInterface (uint32_t index) const
 {
   NS_LOG_FUNCTION (this << index);
-  uint32_t tmp = 0;
 
-  for (Ipv6InterfaceList::const_iterator it = m_interfaces.begin (); it != m_interfaces.end (); it++)
+  if (index < m_interfaces.size ())
     {
-      if (index == tmp)
-        {
-          return *it;
-        }
-      tmp++;
+      return m_interfaces[index];
     }
   return 0;
 }
@@ -1048,30 +1050,11 @@ void Ipv6L3Protocol::Receive (Ptr<NetDevice> device, Ptr<const Packet> p, uint16
     }
 
 
-  for (uint32_t j = 0; j < GetNInterfaces (); j++)
+  if (IsLocalAddress (hdr.GetDestinationAddress (), interface))
     {
-      if (j == interface || !m_strongEndSystemModel)
-        {
-          for (uint32_t i = 0; i < GetNAddresses (j); i++)
-            {
-              Ipv6InterfaceAddress iaddr = GetAddress (j, i);
-              Ipv6Address addr = iaddr.GetAddress ();
-              if (addr.IsEqual (hdr.GetDestinationAddress ()))
-                {
-                  if (j == interface)
-                    {
-                      NS_LOG_LOGIC ("For me (destination " << addr << " match)");
-                    }
-                  else
-                    {
-                      NS_LOG_LOGIC ("For me (destination " << addr << " match) on another interface " << hdr.GetDestinationAddress ());
-                    }
-                  LocalDeliver (packet, hdr, interface);
-                  return;
-                }
-              NS_LOG_LOGIC ("Address " << addr << " not a match");
-            }
-        }
+      NS_LOG_LOGIC ("For me (destination " << hdr.GetDestinationAddress () << " match)");
+      LocalDeliver (packet, hdr, interface);
+      return;
     }
 
   if (!m_routingProtocol->RouteInput (packet, hdr, device,
@@ -1622,6 +1605,73 @@ bool Ipv6L3Protocol::IsRegisteredMulticastAddress (Ipv6Address address) const
   return true;
 }
 
+void Ipv6L3Protocol::NotifyAddressAdded (Ptr<Ipv6Interface> interface, Ipv6Address address)
+{
+  NS_LOG_FUNCTION (this << interface << address);
+
+  int32_t index = GetInterfaceForDevice (interface->GetDevice ());
+  if (index < 0 || m_interfaces[index] != interface)
+    {
+      /* will be indexed by AddIpv6Interface */
+      return;
+    }
+  m_localAddresses[address].push_back (index);
+}
+
+void Ipv6L3Protocol::NotifyAddressRemoved (Ptr<Ipv6Interface> interface, Ipv6Address address)
+{
+  NS_LOG_FUNCTION (this << interface << address);
+
+  int32_t index = GetInterfaceForDevice (interface->GetDevice ());
+  if (index >= 0 && !m_addressRemoved.IsNull ())
+    {
+      m_addressRemoved (address, index);
+    }
+
+  Ipv6LocalAddressIter_t iter = m_localAddresses.find (address);
+  if (index < 0 || iter == m_localAddresses.end ())
+    {
+      return;
+    }
+
+  for (std::list<uint32_t>::iterator it = iter->second.begin (); it != iter->second.end (); ++it)
+    {
+      if (*it == static_cast<uint32_t> (index))
+        {
+          iter->second.erase (it);
+          break;
+        }
+    }
+  if (iter->second.empty ())
+    {
+      m_localAddresses.erase (iter);
+    }
+}
+
+bool Ipv6L3Protocol::IsLocalAddress (Ipv6Address address, uint32_t interface) const
+{
+  NS_LOG_FUNCTION (this << address << interface);
+
+  Ipv6LocalAddressCIter_t iter = m_localAddresses.find (address);
+  if (iter == m_localAddresses.end ())
+    {
+      return false;
+    }
+  if (!m_strongEndSystemModel)
+    {
+      return true;
+    }
+
+  for (std::list<uint32_t>::const_iterator it = iter->second.begin (); it != iter->second.end (); ++it)
+    {
+      if (*it == interface)
+        {
+          return true;
+        }
+    }
+  return false;
+}
+
 //MIPv6 Extension Starts
 
 void Ipv6L3Protocol::SetNSCallback2 (Callback<bool, Ipv6Address> ns)
@@ -1636,6 +1686,12 @@ void Ipv6L3Protocol::SetPrefixCallback (Callback<void, Ipv6Address, uint32_t> ip
   m_RouterPrefix = ip;
 }
 
+void Ipv6L3Protocol::SetAddressRemovedCallback (Callback<void, Ipv6Address, uint32_t> removed)
+{
+  NS_LOG_FUNCTION (this);
+  m_addressRemoved = removed;
+}
+
 //MIPv6 Extension Ends
 
 } /* namespace ns3 */
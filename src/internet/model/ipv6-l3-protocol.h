@@ -29,6 +29,7 @@
 #include "ns3/ipv6-address.h"
 #include "ns3/ipv6-header.h"
 #include "ns3/ipv6-pmtu-cache.h"
+#include "ns3/sgi-hashmap.h"
 
 class Ipv6L3ProtocolTestCase;
 
@@ -447,6 +448,33 @@ public:
    */
   bool IsRegisteredMulticastAddress (Ipv6Address address, uint32_t interface) const;
 
+  /**
+   * \brief Notify that an address has been added to an interface.
+   *
+   * Called by Ipv6Interface to keep the local address index used by
+   * Receive () in sync. Interfaces not yet registered with this stack
+   * are indexed when AddIpv6Interface () is called.
+   * \param interface the interface
+   * \param address the address
+   */
+  void NotifyAddressAdded (Ptr<Ipv6Interface> interface, Ipv6Address address);
+
+  /**
+   * \brief Notify that an address has been removed from an interface.
+   * \param interface the interface
+   * \param address the address
+   */
+  void NotifyAddressRemoved (Ptr<Ipv6Interface> interface, Ipv6Address address);
+
+  /**
+   * \brief Checks if an unicast address is assigned to this node.
+   * \param address the address
+   * \param interface the incoming interface
+   * \return true if the address belongs to the interface, or to any interface
+   * when the weak end system model is in use
+   */
+  bool IsLocalAddress (Ipv6Address address, uint32_t interface) const;
+
 //MIPv6 Extension Starts
 
   /**
@@ -475,6 +503,12 @@ public:
    */
   void SetPrefixCallback (Callback<void, Ipv6Address, uint32_t> ip);
 
+  /**
+   * Set Callback for delivering the removed addresses and their interface index
+   * to a mobile node.
+   */
+  void SetAddressRemovedCallback (Callback<void, Ipv6Address, uint32_t> removed);
+
 //MIPv6 Extension Ends
 
 protected:
@@ -763,6 +797,12 @@ private:
    */
   bool m_sendIcmpv6Redirect;
 
+  /**
+   * \brief Tells the mipv6 layer of a mobile node that an address, e.g. a
+   * care-of address, has been removed from an interface.
+   */
+  Callback<void, Ipv6Address, uint32_t> m_addressRemoved;
+
   /**
    * \brief IPv6 multicast addresses / interface key.
    */
@@ -807,6 +847,27 @@ private:
    * \brief List of multicast IP addresses of interest for all the interfaces.
    */
   Ipv6RegisteredMulticastAddressNoInterface_t m_multicastAddressesNoInterface;
+
+  /**
+   * \brief Container of the local unicast addresses and the interfaces they are assigned to.
+   */
+  typedef sgi::hash_map<Ipv6Address, std::list<uint32_t>, Ipv6AddressHash> Ipv6LocalAddress_t;
+
+  /**
+   * \brief Container Iterator of the local unicast addresses.
+   */
+  typedef sgi::hash_map<Ipv6Address, std::list<uint32_t>, Ipv6AddressHash>::iterator Ipv6LocalAddressIter_t;
+
+  /**
+   * \brief Container Const Iterator of the local unicast addresses.
+   */
+  typedef sgi::hash_map<Ipv6Address, std::list<uint32_t>, Ipv6AddressHash>::const_iterator Ipv6LocalAddressCIter_t;
+
+  /**
+   * \brief Index of the addresses assigned to the interfaces, used to find
+   * out if a packet is for this node without scanning every interface.
+   */
+  Ipv6LocalAddress_t m_localAddresses;
 };
 
 } /* namespace ns3 */
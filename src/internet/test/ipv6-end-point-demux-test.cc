@@ -0,0 +1,131 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/test.h"
+#include "ns3/ipv6-address.h"
+#include "../model/ipv6-end-point.h"
+#include "../model/ipv6-end-point-demux.h"
+
+using namespace ns3;
+
+/**
+ * \brief Ipv6EndPointDemux lookups, with wildcard and connected end points.
+ */
+class Ipv6EndPointDemuxTestCase : public TestCase
+{
+public:
+  Ipv6EndPointDemuxTestCase ();
+
+private:
+  virtual void DoRun (void);
+  /**
+   * \brief Look up a received packet.
+   * \param demux the demux
+   * \param dst the destination address
+   * \param dport the destination port
+   * \param src the source address
+   * \param sport the source port
+   * \return the single end point found, or 0
+   */
+  Ipv6EndPoint * LookupOne (Ipv6EndPointDemux &demux, Ipv6Address dst, uint16_t dport,
+                            Ipv6Address src, uint16_t sport);
+};
+
+Ipv6EndPointDemuxTestCase::Ipv6EndPointDemuxTestCase ()
+  : TestCase ("Ipv6EndPointDemux lookups")
+{
+}
+
+Ipv6EndPoint *
+Ipv6EndPointDemuxTestCase::LookupOne (Ipv6EndPointDemux &demux, Ipv6Address dst, uint16_t dport,
+                                      Ipv6Address src, uint16_t sport)
+{
+  Ipv6EndPointDemux::EndPoints endPoints = demux.Lookup (dst, dport, src, sport, 0);
+  if (endPoints.size () != 1)
+    {
+      return 0;
+    }
+  return endPoints.front ();
+}
+
+void
+Ipv6EndPointDemuxTestCase::DoRun (void)
+{
+  Ipv6EndPointDemux demux;
+  Ipv6Address server ("2001:1::1");
+  Ipv6Address client1 ("2001:2::1");
+  Ipv6Address client2 ("2001:2::2");
+
+  Ipv6EndPoint *listener = demux.Allocate (80);
+  NS_TEST_ASSERT_MSG_NE (listener, 0, "Allocation failed");
+  NS_TEST_ASSERT_MSG_EQ (demux.Allocate (80), 0, "Duplicate allocation");
+  NS_TEST_ASSERT_MSG_EQ (demux.LookupPortLocal (80), true, "Port not found");
+  NS_TEST_ASSERT_MSG_EQ (demux.LookupPortLocal (81), false, "Unexpected port");
+  NS_TEST_ASSERT_MSG_EQ (demux.LookupLocal (Ipv6Address::GetAny (), 80), true, "Address and port not found");
+
+  // the listener gets the packets of unknown peers
+  NS_TEST_ASSERT_MSG_EQ (LookupOne (demux, server, 80, client1, 1000), listener, "Wrong end point");
+  NS_TEST_ASSERT_MSG_EQ (demux.Lookup (server, 81, client1, 1000, 0).size (), 0, "Unexpected end point");
+
+  // accepted connections get the packets of their peer only
+  Ipv6EndPoint *connection1 = demux.Allocate (server, 80, client1, 1000);
+  Ipv6EndPoint *connection2 = demux.Allocate (server, 80, client2, 1000);
+  NS_TEST_ASSERT_MSG_EQ (demux.Allocate (server, 80, client1, 1000), 0, "Duplicate allocation");
+  NS_TEST_ASSERT_MSG_EQ (LookupOne (demux, server, 80, client1, 1000), connection1, "Wrong end point");
+  NS_TEST_ASSERT_MSG_EQ (LookupOne (demux, server, 80, client2, 1000), connection2, "Wrong end point");
+  NS_TEST_ASSERT_MSG_EQ (LookupOne (demux, server, 80, client1, 1001), listener, "Wrong end point");
+  NS_TEST_ASSERT_MSG_EQ (demux.SimpleLookup (server, 80, client2, 1000), connection2, "Wrong end point");
+  NS_TEST_ASSERT_MSG_EQ (demux.SimpleLookup (server, 80, client2, 1001), listener, "Wrong end point");
+  NS_TEST_ASSERT_MSG_EQ (demux.LookupLocal (server, 80), true, "Address and port not found");
+
+  connection1->SetRxEnabled (false);
+  NS_TEST_ASSERT_MSG_EQ (LookupOne (demux, server, 80, client1, 1000), listener, "Wrong end point");
+
+  // a UDP socket connected after its bind moves to its four-tuple
+  Ipv6EndPoint *udp = demux.Allocate (server, 5000);
+  NS_TEST_ASSERT_MSG_EQ (LookupOne (demux, server, 5000, client1, 7), udp, "Wrong end point");
+  udp->SetPeer (client2, 7);
+  NS_TEST_ASSERT_MSG_EQ (demux.Lookup (server, 5000, client1, 7, 0).size (), 0, "Unexpected end point");
+  NS_TEST_ASSERT_MSG_EQ (LookupOne (demux, server, 5000, client2, 7), udp, "Wrong end point");
+  udp->SetLocalAddress (Ipv6Address ("2001:1::2"));
+  NS_TEST_ASSERT_MSG_EQ (demux.Lookup (server, 5000, client2, 7, 0).size (), 0, "Unexpected end point");
+  NS_TEST_ASSERT_MSG_EQ (demux.LookupLocal (server, 5000), false, "Unexpected address and port");
+  NS_TEST_ASSERT_MSG_EQ (LookupOne (demux, Ipv6Address ("2001:1::2"), 5000, client2, 7), udp, "Wrong end point");
+
+  demux.DeAllocate (connection2);
+  NS_TEST_ASSERT_MSG_EQ (LookupOne (demux, server, 80, client2, 1000), listener, "Wrong end point");
+  demux.DeAllocate (listener);
+  demux.DeAllocate (connection1);
+  NS_TEST_ASSERT_MSG_EQ (demux.LookupPortLocal (80), false, "Unexpected port");
+  NS_TEST_ASSERT_MSG_EQ (demux.GetEndPoints ().size (), 1, "Wrong number of end points");
+
+  // the ephemeral ports skip the ports in use
+  Ipv6EndPoint *ephemeral1 = demux.Allocate ();
+  Ipv6EndPoint *ephemeral2 = demux.Allocate ();
+  NS_TEST_ASSERT_MSG_NE (ephemeral1->GetLocalPort (), ephemeral2->GetLocalPort (), "Same ephemeral port");
+}
+
+//-----------------------------------------------------------------------------
+class Ipv6EndPointDemuxTestSuite : public TestSuite
+{
+public:
+  Ipv6EndPointDemuxTestSuite () : TestSuite ("ipv6-end-point-demux", UNIT)
+  {
+    AddTestCase (new Ipv6EndPointDemuxTestCase (), TestCase::QUICK);
+  }
+};
+
+static Ipv6EndPointDemuxTestSuite g_ipv6EndPointDemuxTestSuite;
@@ -0,0 +1,300 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <vector>
+
+#include "ns3/test.h"
+#include "ns3/simulator.h"
+#include "ns3/node-container.h"
+#include "ns3/net-device-container.h"
+#include "ns3/simple-net-device-helper.h"
+#include "ns3/internet-stack-helper.h"
+#include "ns3/ipv6-address-helper.h"
+#include "ns3/ipv6-static-routing-helper.h"
+#include "ns3/ipv6-routing-table-entry.h"
+#include "ns3/ipv6-global-routing-helper.h"
+#include "ns3/ipv6.h"
+
+using namespace ns3;
+
+/**
+ * \brief Ipv6GlobalRoutingHelper routes on a ring of four routers, before
+ * and after a link goes down.
+ *
+ * The routers 0, 1, 2 and 3 are linked by 2001:1::/64, 2001:2::/64,
+ * 2001:3::/64 and 2001:4::/64, and router 2 has a stub network,
+ * 2001:100::/64. The link from router 0 to router 3 costs 5.
+ */
+class Ipv6GlobalRoutingTestCase : public TestCase
+{
+public:
+  Ipv6GlobalRoutingTestCase ();
+
+private:
+  virtual void DoRun (void);
+  /**
+   * \brief Check the route of a node to a network.
+   * \param node the node
+   * \param network the destination network, with a /64 prefix
+   * \param ifIndex the expected interface
+   * \param nextHop the expected next hop
+   * \param metric the expected metric
+   */
+  void CheckRoute (Ptr<Node> node, Ipv6Address network, uint32_t ifIndex,
+                   Ipv6Address nextHop, uint32_t metric);
+  /**
+   * \param node the node
+   * \returns the number of routes with a gateway of the node
+   */
+  uint32_t CountGatewayRoutes (Ptr<Node> node);
+};
+
+Ipv6GlobalRoutingTestCase::Ipv6GlobalRoutingTestCase ()
+  : TestCase ("Ipv6GlobalRoutingHelper routes on a ring")
+{
+}
+
+void
+Ipv6GlobalRoutingTestCase::CheckRoute (Ptr<Node> node, Ipv6Address network, uint32_t ifIndex,
+                                       Ipv6Address nextHop, uint32_t metric)
+{
+  Ipv6StaticRoutingHelper helper;
+  Ptr<Ipv6StaticRouting> routing = helper.GetStaticRouting (node->GetObject<Ipv6> ());
+  uint32_t found = 0;
+  for (uint32_t i = 0; i < routing->GetNRoutes (); i++)
+    {
+      Ipv6RoutingTableEntry route = routing->GetRoute (i);
+      if (route.GetDest () == network && route.GetDestNetworkPrefix () == Ipv6Prefix (64))
+        {
+          found++;
+          NS_TEST_EXPECT_MSG_EQ (route.GetInterface (), ifIndex, "Wrong interface to " << network);
+          NS_TEST_EXPECT_MSG_EQ (route.GetGateway (), nextHop, "Wrong next hop to " << network);
+          NS_TEST_EXPECT_MSG_EQ (routing->GetMetric (i), metric, "Wrong metric to " << network);
+        }
+    }
+  NS_TEST_EXPECT_MSG_EQ (found, 1, "Wrong number of routes to " << network);
+}
+
+uint32_t
+Ipv6GlobalRoutingTestCase::CountGatewayRoutes (Ptr<Node> node)
+{
+  Ipv6StaticRoutingHelper helper;
+  Ptr<Ipv6StaticRouting> routing = helper.GetStaticRouting (node->GetObject<Ipv6> ());
+  uint32_t count = 0;
+  for (uint32_t i = 0; i < routing->GetNRoutes (); i++)
+    {
+      if (routing->GetRoute (i).IsGateway ())
+        {
+          count++;
+        }
+    }
+  return count;
+}
+
+void
+Ipv6GlobalRoutingTestCase::DoRun (void)
+{
+  NodeContainer routers;
+  routers.Create (4);
+  InternetStackHelper internet;
+  internet.SetIpv4StackInstall (false);
+  internet.Install (routers);
+
+  SimpleNetDeviceHelper simple;
+  Ipv6AddressHelper address;
+  for (uint32_t i = 0; i < 4; i++)
+    {
+      NetDeviceContainer devices = simple.Install (NodeContainer (routers.Get (i), routers.Get ((i + 1) % 4)));
+      uint8_t network[16] = { 0x20, 0x01, 0, (uint8_t)(i + 1) };
+      address.SetBase (Ipv6Address (network), Ipv6Prefix (64));
+      address.Assign (devices);
+    }
+  address.SetBase (Ipv6Address ("2001:100::"), Ipv6Prefix (64));
+  address.Assign (simple.Install (routers.Get (2)));
+
+  std::vector<Ptr<Ipv6> > ipv6;
+  for (uint32_t i = 0; i < 4; i++)
+    {
+      ipv6.push_back (routers.Get (i)->GetObject<Ipv6> ());
+      for (uint32_t j = 1; j < ipv6[i]->GetNInterfaces (); j++)
+        {
+          ipv6[i]->SetForwarding (j, true);
+        }
+    }
+  ipv6[0]->SetMetric (2, 5);
+
+  // the interfaces of router 1 and 3 towards router 0
+  Ipv6Address linkLocal1 = ipv6[1]->GetAddress (1, 0).GetAddress ();
+  Ipv6Address linkLocal3 = ipv6[3]->GetAddress (2, 0).GetAddress ();
+  NS_TEST_ASSERT_MSG_EQ (linkLocal1.IsLinkLocal (), true, "Not a link-local address");
+  NS_TEST_ASSERT_MSG_EQ (linkLocal3.IsLinkLocal (), true, "Not a link-local address");
+
+  Ipv6GlobalRoutingHelper::PopulateRoutingTables ();
+  CheckRoute (routers.Get (0), Ipv6Address ("2001:2::"), 1, linkLocal1, 1);
+  CheckRoute (routers.Get (0), Ipv6Address ("2001:3::"), 1, linkLocal1, 2);
+  CheckRoute (routers.Get (0), Ipv6Address ("2001:100::"), 1, linkLocal1, 2);
+  NS_TEST_EXPECT_MSG_EQ (CountGatewayRoutes (routers.Get (0)), 3, "Wrong number of routes");
+  NS_TEST_EXPECT_MSG_EQ (CountGatewayRoutes (routers.Get (2)), 2, "Wrong number of routes");
+
+  // nothing changed: the routes are left alone
+  Ipv6GlobalRoutingHelper::RecomputeRoutingTables ();
+  NS_TEST_EXPECT_MSG_EQ (CountGatewayRoutes (routers.Get (0)), 3, "Wrong number of routes");
+
+  ipv6[0]->SetDown (1);
+  Ipv6GlobalRoutingHelper::RecomputeRoutingTables ();
+  CheckRoute (routers.Get (0), Ipv6Address ("2001:1::"), 2, linkLocal3, 7);
+  CheckRoute (routers.Get (0), Ipv6Address ("2001:2::"), 2, linkLocal3, 6);
+  CheckRoute (routers.Get (0), Ipv6Address ("2001:3::"), 2, linkLocal3, 5);
+  CheckRoute (routers.Get (0), Ipv6Address ("2001:100::"), 2, linkLocal3, 6);
+  NS_TEST_EXPECT_MSG_EQ (CountGatewayRoutes (routers.Get (0)), 4, "Wrong number of routes");
+
+  // the interface lost its global address when it went down
+  ipv6[0]->SetUp (1);
+  Ipv6GlobalRoutingHelper::RecomputeRoutingTables ();
+  CheckRoute (routers.Get (0), Ipv6Address ("2001:1::"), 1, linkLocal1, 1);
+  CheckRoute (routers.Get (0), Ipv6Address ("2001:100::"), 1, linkLocal1, 2);
+  NS_TEST_EXPECT_MSG_EQ (CountGatewayRoutes (routers.Get (0)), 4, "Wrong number of routes");
+
+  // the interface goes down and up between two updates: the shortest
+  // paths are the same, but the routes dropped meanwhile are back
+  ipv6[0]->SetDown (1);
+  ipv6[0]->SetUp (1);
+  NS_TEST_EXPECT_MSG_EQ (CountGatewayRoutes (routers.Get (0)), 0, "Routes of a down interface kept");
+  Ipv6GlobalRoutingHelper::RecomputeRoutingTables ();
+  CheckRoute (routers.Get (0), Ipv6Address ("2001:1::"), 1, linkLocal1, 1);
+  CheckRoute (routers.Get (0), Ipv6Address ("2001:2::"), 1, linkLocal1, 1);
+  CheckRoute (routers.Get (0), Ipv6Address ("2001:100::"), 1, linkLocal1, 2);
+  NS_TEST_EXPECT_MSG_EQ (CountGatewayRoutes (routers.Get (0)), 4, "Wrong number of routes");
+
+  Simulator::Destroy ();
+}
+
+/**
+ * \brief Ipv6GlobalRoutingHelper merges the routes to contiguous networks.
+ *
+ * The routers 0, 1 and 2 are in a line, linked by 2001:1::/64 and
+ * 2001:2::/64, and router 2 has three stub networks, 2001:100:0:0::/64,
+ * 2001:100:0:1::/64 and 2001:100:0:2::/64. The scenario is built twice,
+ * to check that the routes installed in the first one are not taken for
+ * installed in the second one, whose nodes have the same ids.
+ */
+class Ipv6GlobalRoutingAggregationTestCase : public TestCase
+{
+public:
+  Ipv6GlobalRoutingAggregationTestCase ();
+
+private:
+  virtual void DoRun (void);
+  /**
+   * \param node the node
+   * \param network the destination network
+   * \param prefixLength its prefix length
+   * \returns the number of routes of the node to the network
+   */
+  uint32_t CountRoutes (Ptr<Node> node, Ipv6Address network, uint8_t prefixLength);
+};
+
+Ipv6GlobalRoutingAggregationTestCase::Ipv6GlobalRoutingAggregationTestCase ()
+  : TestCase ("Ipv6GlobalRoutingHelper merges the routes to contiguous networks")
+{
+}
+
+uint32_t
+Ipv6GlobalRoutingAggregationTestCase::CountRoutes (Ptr<Node> node, Ipv6Address network, uint8_t prefixLength)
+{
+  Ipv6StaticRoutingHelper helper;
+  Ptr<Ipv6StaticRouting> routing = helper.GetStaticRouting (node->GetObject<Ipv6> ());
+  uint32_t count = 0;
+  for (uint32_t i = 0; i < routing->GetNRoutes (); i++)
+    {
+      Ipv6RoutingTableEntry route = routing->GetRoute (i);
+      if (route.IsGateway () && route.GetDest () == network
+          && route.GetDestNetworkPrefix () == Ipv6Prefix (prefixLength))
+        {
+          count++;
+        }
+    }
+  return count;
+}
+
+void
+Ipv6GlobalRoutingAggregationTestCase::DoRun (void)
+{
+  for (uint32_t run = 0; run < 2; run++)
+    {
+      NodeContainer routers;
+      routers.Create (3);
+      InternetStackHelper internet;
+      internet.SetIpv4StackInstall (false);
+      internet.Install (routers);
+
+      SimpleNetDeviceHelper simple;
+      Ipv6AddressHelper address;
+      for (uint32_t i = 0; i < 2; i++)
+        {
+          uint8_t network[16] = { 0x20, 0x01, 0, (uint8_t)(i + 1) };
+          address.SetBase (Ipv6Address (network), Ipv6Prefix (64));
+          address.Assign (simple.Install (NodeContainer (routers.Get (i), routers.Get (i + 1))));
+        }
+      for (uint32_t i = 0; i < 3; i++)
+        {
+          uint8_t network[16] = { 0x20, 0x01, 0x01, 0x00, 0, 0, 0, (uint8_t) i };
+          address.SetBase (Ipv6Address (network), Ipv6Prefix (64));
+          address.Assign (simple.Install (routers.Get (2)));
+        }
+      for (uint32_t i = 0; i < 3; i++)
+        {
+          Ptr<Ipv6> ipv6 = routers.Get (i)->GetObject<Ipv6> ();
+          for (uint32_t j = 1; j < ipv6->GetNInterfaces (); j++)
+            {
+              ipv6->SetForwarding (j, true);
+            }
+        }
+
+      // the first run installs the routes, the second one only updates
+      // them, as if they were installed
+      if (run == 0)
+        {
+          Ipv6GlobalRoutingHelper::PopulateRoutingTables ();
+        }
+      else
+        {
+          Ipv6GlobalRoutingHelper::RecomputeRoutingTables ();
+        }
+      NS_TEST_EXPECT_MSG_EQ (CountRoutes (routers.Get (0), Ipv6Address ("2001:100::"), 63), 1,
+                             "No route to the first two stub networks in run " << run);
+      NS_TEST_EXPECT_MSG_EQ (CountRoutes (routers.Get (0), Ipv6Address ("2001:100:0:2::"), 64), 1,
+                             "No route to the third stub network in run " << run);
+      NS_TEST_EXPECT_MSG_EQ (CountRoutes (routers.Get (0), Ipv6Address ("2001:2::"), 64), 1,
+                             "No route to the second link in run " << run);
+      NS_TEST_EXPECT_MSG_EQ (CountRoutes (routers.Get (0), Ipv6Address ("2001:100::"), 64), 0,
+                             "Route to a merged network in run " << run);
+      Simulator::Destroy ();
+    }
+}
+
+//-----------------------------------------------------------------------------
+class Ipv6GlobalRoutingTestSuite : public TestSuite
+{
+public:
+  Ipv6GlobalRoutingTestSuite () : TestSuite ("ipv6-global-routing", UNIT)
+  {
+    AddTestCase (new Ipv6GlobalRoutingTestCase (), TestCase::QUICK);
+    AddTestCase (new Ipv6GlobalRoutingAggregationTestCase (), TestCase::QUICK);
+  }
+};
+
+static Ipv6GlobalRoutingTestSuite g_ipv6GlobalRoutingTestSuite;
@@ -123,6 +123,11 @@ Ipv6L3ProtocolTestCase::DoRun ()
   num = interface->GetNAddresses ();
   NS_TEST_ASSERT_MSG_EQ (num, 2, "Number of addresses should be 2??");
 
+  NS_TEST_ASSERT_MSG_EQ (ipv6->IsLocalAddress ("2001:ffff:5678:9001::2", 2), true,
+                         "Address should be indexed on interface 2");
+  NS_TEST_ASSERT_MSG_EQ (ipv6->IsLocalAddress ("2001:ffff:5678:9001::2", 1), false,
+                         "Address should not be local to interface 1 (strong end system model)");
+
   Ipv6InterfaceAddress output = interface->GetAddress (1);
   NS_TEST_ASSERT_MSG_EQ (ifaceAddr1, output,
                          "Should be the interface address 1?");
@@ -136,6 +141,8 @@ Ipv6L3ProtocolTestCase::DoRun ()
 
   index = ipv6->GetInterfaceForAddress ("2001:ffff:5678:9000::1"); /* address we just remove */
   NS_TEST_ASSERT_MSG_EQ (index, (uint32_t) -1, "Address should not be found??");
+  NS_TEST_ASSERT_MSG_EQ (ipv6->IsLocalAddress ("2001:ffff:5678:9000::1", 1), false,
+                         "Removed address should not be indexed");
 
   /* Test Ipv6Interface()::RemoveAddress(address) */
   output = interface->RemoveAddress (Ipv6Address ("2001:1234:5678:9000::1"));
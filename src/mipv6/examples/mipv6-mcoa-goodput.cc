@@ -0,0 +1,278 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2017 Jadavpur University, India
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Manoj Kumar Rana <manoj24.rana@gmail.com>
+ */
+
+/*
+ * Aggregate goodput of a multi-homed MN (RFC 5648 / RFC 6089).
+ *
+ * The MN is attached to a WiFi AR and to a WiMAX AR at the same time. The
+ * CN sends two UDP flows to the HoA. With --mcoa=1 the MN registers both
+ * CoAs with binding identifiers and binds the second flow to the WiMAX CoA,
+ * so that the HA splits the downlink over both access networks. With
+ * --mcoa=0 the last registered CoA carries both flows.
+ *
+ *   CN ---+--- MID ---+--- AR1 (WiFi)  ~~~ MN
+ *         |           |                    |
+ *         HA          +--- AR2 (WiMAX) ~~~-+
+ */
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/internet-module.h"
+#include "ns3/applications-module.h"
+#include "ns3/mobility-module.h"
+#include "ns3/wifi-module.h"
+#include "ns3/csma-module.h"
+#include "ns3/wimax-module.h"
+#include "ns3/ipv6-static-routing.h"
+#include "ns3/mipv6-module.h"
+#include "ns3/radvd.h"
+#include "ns3/radvd-interface.h"
+#include "ns3/radvd-prefix.h"
+#include <iostream>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("Mipv6McoaGoodput");
+
+static uint64_t g_rxBytes[3];
+
+static void
+Ipv6Rx (Ptr<const Packet> packet, Ptr<Ipv6> ipv6, uint32_t interface)
+{
+  if (interface < 3)
+    {
+      g_rxBytes[interface] += packet->GetSize ();
+    }
+}
+
+static Ptr<Radvd>
+InstallRadvd (Ptr<Node> router, uint32_t ifIndex, Ipv6Address prefix, double start)
+{
+  Ptr<Radvd> radvd = CreateObject<Radvd> ();
+  Ptr<RadvdInterface> routerInterface = Create<RadvdInterface> (ifIndex, 1500, 50);
+  Ptr<RadvdPrefix> routerPrefix = Create<RadvdPrefix> (prefix, 64, 1.5, 2.0);
+  routerInterface->AddPrefix (routerPrefix);
+  radvd->AddConfiguration (routerInterface);
+  router->AddApplication (radvd);
+  radvd->SetStartTime (Seconds (start));
+  radvd->SetStopTime (Seconds (100.0));
+  return radvd;
+}
+
+int main (int argc, char *argv[])
+{
+  bool mcoa = true;
+  double start = 8.0;
+  double stop = 18.0;
+  uint32_t packetSize = 1024;
+  double interval = 0.002;
+
+  CommandLine cmd;
+  cmd.AddValue ("mcoa", "Register both CoAs and bind flow 2 to the WiMAX CoA", mcoa);
+  cmd.AddValue ("start", "Start time of the UDP flows (s)", start);
+  cmd.AddValue ("stop", "Stop time of the UDP flows (s)", stop);
+  cmd.AddValue ("packetSize", "UDP payload size (bytes)", packetSize);
+  cmd.AddValue ("interval", "Inter-packet interval of each flow (s)", interval);
+  cmd.Parse (argc, argv);
+
+  Config::SetDefault ("ns3::Mipv6Mn::EnableMcoa", BooleanValue (mcoa));
+
+  NodeContainer ars, ha, sta, cn, mid;
+  ars.Create (2);
+  ha.Create (1);
+  sta.Create (1);
+  cn.Create (1);
+  mid.Create (1);
+
+  InternetStackHelper internet;
+  internet.Install (ars);
+  internet.Install (mid);
+  internet.Install (ha);
+  internet.Install (cn);
+  internet.Install (sta);
+
+  NodeContainer backbone1 (mid.Get (0), ars.Get (0), ars.Get (1));
+  NodeContainer backbone2 (cn.Get (0), mid.Get (0), ha.Get (0));
+
+  CsmaHelper csma;
+  csma.SetChannelAttribute ("DataRate", DataRateValue (DataRate ("50Mbps")));
+  csma.SetChannelAttribute ("Delay", TimeValue (MicroSeconds (10)));
+  csma.SetDeviceAttribute ("Mtu", UintegerValue (1400));
+  NetDeviceContainer backbone1Devs = csma.Install (backbone1);
+  NetDeviceContainer backbone2Devs = csma.Install (backbone2);
+
+  Ipv6AddressHelper ipv6;
+  ipv6.SetBase (Ipv6Address ("2001:db80::"), Ipv6Prefix (64));
+  Ipv6InterfaceContainer backbone1Ifs = ipv6.Assign (backbone1Devs);
+  ipv6.SetBase (Ipv6Address ("5001:db80::"), Ipv6Prefix (64));
+  Ipv6InterfaceContainer backbone2Ifs = ipv6.Assign (backbone2Devs);
+
+  for (uint32_t i = 0; i < 3; i++)
+    {
+      backbone1Ifs.SetForwarding (i, true);
+      backbone2Ifs.SetForwarding (i, true);
+      backbone1Ifs.SetDefaultRouteInAllNodes (i);
+      backbone2Ifs.SetDefaultRouteInAllNodes (i);
+    }
+
+  MobilityHelper mobility;
+  Ptr<ListPositionAllocator> positionAlloc = CreateObject<ListPositionAllocator> ();
+  positionAlloc->Add (Vector (0.0, -20.0, 0.0));   //MID
+  positionAlloc->Add (Vector (-50.0, 20.0, 0.0));  //AR1
+  positionAlloc->Add (Vector (50.0, 20.0, 0.0));   //AR2
+  positionAlloc->Add (Vector (25.0, -20.0, 0.0));  //HA
+  positionAlloc->Add (Vector (-25.0, -20.0, 0.0)); //CN
+  positionAlloc->Add (Vector (0.0, 40.0, 0.0));    //MN
+  mobility.SetPositionAllocator (positionAlloc);
+  mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+  mobility.Install (backbone1);
+  mobility.Install (ha);
+  mobility.Install (cn);
+  mobility.Install (sta);
+
+  //WiFi access network
+  Ssid ssid = Ssid ("ns-3-ssid");
+  YansWifiPhyHelper wifiPhy = YansWifiPhyHelper::Default ();
+  YansWifiChannelHelper wifiChannel = YansWifiChannelHelper::Default ();
+  wifiPhy.SetChannel (wifiChannel.Create ());
+  WifiHelper wifi;
+  NqosWifiMacHelper wifiMac = NqosWifiMacHelper::Default ();
+  wifiMac.SetType ("ns3::ApWifiMac",
+                   "Ssid", SsidValue (ssid),
+                   "BeaconGeneration", BooleanValue (true),
+                   "BeaconInterval", TimeValue (MilliSeconds (100)));
+  NetDeviceContainer ar1Devs = wifi.Install (wifiPhy, wifiMac, ars.Get (0));
+
+  //WiMAX access network
+  WimaxHelper::SchedulerType scheduler = WimaxHelper::SCHED_TYPE_SIMPLE;
+  WimaxHelper wimax;
+  NetDeviceContainer ar2Devs = wimax.Install (ars.Get (1), WimaxHelper::DEVICE_TYPE_BASE_STATION,
+                                              WimaxHelper::SIMPLE_PHY_TYPE_OFDM, scheduler);
+
+  Ipv6AddressHelper ipv62;
+  ipv62.SetBase (Ipv6Address ("8888:56ac::"), Ipv6Prefix (64));
+  Ipv6InterfaceContainer ar1Ifs = ipv62.Assign (ar1Devs);
+  ar1Ifs.SetForwarding (0, true);
+  ar1Ifs.SetDefaultRouteInAllNodes (0);
+
+  Ipv6AddressHelper ipv63;
+  ipv63.SetBase (Ipv6Address ("9999:db80::"), Ipv6Prefix (64));
+  Ipv6InterfaceContainer ar2Ifs = ipv63.Assign (ar2Devs);
+  ar2Ifs.SetForwarding (0, true);
+  ar2Ifs.SetDefaultRouteInAllNodes (0);
+
+  wifiMac.SetType ("ns3::StaWifiMac",
+                   "Ssid", SsidValue (ssid),
+                   "ActiveProbing", BooleanValue (false));
+  NetDeviceContainer staDevs = wifi.Install (wifiPhy, wifiMac, sta);
+  ipv6.AssignWithoutAddress (staDevs);
+
+  NetDeviceContainer wimaxstaDevs = wimax.Install (sta, WimaxHelper::DEVICE_TYPE_SUBSCRIBER_STATION,
+                                                   WimaxHelper::SIMPLE_PHY_TYPE_OFDM, scheduler);
+  Ptr<SubscriberStationNetDevice> ss = wimaxstaDevs.Get (0)->GetObject<SubscriberStationNetDevice> ();
+  ss->SetModulationType (WimaxPhy::MODULATION_TYPE_QAM16_12);
+
+  ServiceFlow *dlServiceFlowBe = new ServiceFlow (ServiceFlow::SF_DIRECTION_DOWN);
+  dlServiceFlowBe->SetCsSpecification (ServiceFlow::IPV6);
+  dlServiceFlowBe->SetServiceSchedulingType (ServiceFlow::SF_TYPE_BE);
+  dlServiceFlowBe->SetMaxSustainedTrafficRate (100000000);
+  dlServiceFlowBe->SetMinReservedTrafficRate (100000000);
+  dlServiceFlowBe->SetMinTolerableTrafficRate (100000000);
+  dlServiceFlowBe->SetMaximumLatency (10);
+  dlServiceFlowBe->SetMaxTrafficBurst (1000);
+  dlServiceFlowBe->SetTrafficPriority (1);
+  ss->AddServiceFlow (dlServiceFlowBe);
+
+  Ipv6AddressHelper ipv64;
+  ipv64.AssignWithoutAddress (wimaxstaDevs);
+
+  InstallRadvd (ars.Get (0), ar1Ifs.GetInterfaceIndex (0), Ipv6Address ("8888:56ac::"), 1.0);
+  InstallRadvd (ars.Get (1), ar2Ifs.GetInterfaceIndex (0), Ipv6Address ("9999:db80::"), 4.1);
+
+  Ipv6StaticRoutingHelper routingHelper;
+  Ptr<Ipv6StaticRouting> rt = routingHelper.GetStaticRouting (mid.Get (0)->GetObject<Ipv6> ());
+  rt->AddNetworkRouteTo (Ipv6Address ("8888:56ac::"), Ipv6Prefix (64), Ipv6Address ("2001:db80::200:ff:fe00:2"), 1, 0);
+  rt->AddNetworkRouteTo (Ipv6Address ("9999:db80::"), Ipv6Prefix (64), Ipv6Address ("2001:db80::200:ff:fe00:3"), 1, 0);
+  rt = routingHelper.GetStaticRouting (ars.Get (0)->GetObject<Ipv6> ());
+  rt->AddNetworkRouteTo (Ipv6Address ("5001:db80::"), Ipv6Prefix (64), Ipv6Address ("2001:db80::200:ff:fe00:1"), 1, 0);
+  rt = routingHelper.GetStaticRouting (ars.Get (1)->GetObject<Ipv6> ());
+  rt->AddNetworkRouteTo (Ipv6Address ("5001:db80::"), Ipv6Prefix (64), Ipv6Address ("2001:db80::200:ff:fe00:1"), 1, 0);
+  rt = routingHelper.GetStaticRouting (cn.Get (0)->GetObject<Ipv6> ());
+  rt->AddNetworkRouteTo (Ipv6Address ("8888:56ac::"), Ipv6Prefix (64), Ipv6Address ("5001:db80::200:ff:fe00:5"), 1, 0);
+  rt->AddNetworkRouteTo (Ipv6Address ("9999:db80::"), Ipv6Prefix (64), Ipv6Address ("5001:db80::200:ff:fe00:5"), 1, 0);
+  rt->AddNetworkRouteTo (Ipv6Address ("2001:db80::"), Ipv6Prefix (64), Ipv6Address ("5001:db80::200:ff:fe00:5"), 1, 0);
+
+  Mipv6HaHelper hahelper;
+  hahelper.Install (ha.Get (0));
+  Mipv6MnHelper mnhelper (hahelper.GetHomeAgentAddressList (), false);
+  mnhelper.Install (sta.Get (0));
+
+  Ptr<Mipv6Mn> mn = sta.Get (0)->GetObject<Mipv6Mn> ();
+  Ptr<Ipv6L3Protocol> ip = sta.Get (0)->GetObject<Ipv6L3Protocol> ();
+  uint32_t wimaxBid = ip->GetInterfaceForDevice (wimaxstaDevs.Get (0));
+
+  uint16_t port1 = 5000;
+  uint16_t port2 = 5001;
+
+  //flow 2 is steered to the WiMAX CoA, flow 1 follows the primary CoA
+  mn->AddFlowBinding (1, 1, wimaxBid, UdpL4Protocol::PROT_NUMBER, port2, port2);
+
+  PacketSinkHelper sink1 ("ns3::UdpSocketFactory", Inet6SocketAddress (Ipv6Address::GetAny (), port1));
+  PacketSinkHelper sink2 ("ns3::UdpSocketFactory", Inet6SocketAddress (Ipv6Address::GetAny (), port2));
+  ApplicationContainer sinks;
+  sinks.Add (sink1.Install (sta.Get (0)));
+  sinks.Add (sink2.Install (sta.Get (0)));
+  sinks.Start (Seconds (1.0));
+  sinks.Stop (Seconds (stop + 1.0));
+
+  UdpClientHelper client1 (mn->GetHomeAddress (), port1);
+  UdpClientHelper client2 (mn->GetHomeAddress (), port2);
+  ApplicationContainer clients;
+  clients.Add (client1.Install (cn.Get (0)));
+  clients.Add (client2.Install (cn.Get (0)));
+  clients.Get (0)->SetAttribute ("MaxPackets", UintegerValue (0xFFFFFFFF));
+  clients.Get (0)->SetAttribute ("Interval", TimeValue (Seconds (interval)));
+  clients.Get (0)->SetAttribute ("PacketSize", UintegerValue (packetSize));
+  clients.Get (1)->SetAttribute ("MaxPackets", UintegerValue (0xFFFFFFFF));
+  clients.Get (1)->SetAttribute ("Interval", TimeValue (Seconds (interval)));
+  clients.Get (1)->SetAttribute ("PacketSize", UintegerValue (packetSize));
+  clients.Start (Seconds (start));
+  clients.Stop (Seconds (stop));
+
+  ip->TraceConnectWithoutContext ("Rx", MakeCallback (&Ipv6Rx));
+
+  Simulator::Stop (Seconds (stop + 1.0));
+  Simulator::Run ();
+
+  double duration = stop - start;
+  uint64_t rx1 = DynamicCast<PacketSink> (sinks.Get (0))->GetTotalRx ();
+  uint64_t rx2 = DynamicCast<PacketSink> (sinks.Get (1))->GetTotalRx ();
+
+  std::cout << "MCoA: " << (mcoa ? "on" : "off") << std::endl;
+  std::cout << "Flow 1 goodput: " << rx1 * 8.0 / duration / 1e6 << " Mbps" << std::endl;
+  std::cout << "Flow 2 goodput: " << rx2 * 8.0 / duration / 1e6 << " Mbps" << std::endl;
+  std::cout << "Received over WiFi: " << g_rxBytes[ip->GetInterfaceForDevice (staDevs.Get (0))] * 8.0 / duration / 1e6 << " Mbps" << std::endl;
+  std::cout << "Received over WiMAX: " << g_rxBytes[wimaxBid] * 8.0 / duration / 1e6 << " Mbps" << std::endl;
+  std::cout << "Aggregate goodput: " << (rx1 + rx2) * 8.0 / duration / 1e6 << " Mbps" << std::endl;
+
+  Simulator::Destroy ();
+
+  return 0;
+}
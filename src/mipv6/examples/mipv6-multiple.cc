@@ -37,6 +37,7 @@
 #include "ns3/radvd.h"
 #include "ns3/radvd-interface.h"
 #include "ns3/radvd-prefix.h"
+#include "ns3/stats-module.h"
 #include <iostream>
 #include <iomanip>
 #include <fstream>
@@ -60,7 +61,10 @@ NodeContainer mid;
 NodeContainer backbone1;
 NodeContainer backbone2;
 
+bool stats = false;
+
 CommandLine cmd;
+cmd.AddValue ("stats", "Collect the handoff phase statistics", stats);
 cmd.Parse (argc, argv);
 
 ars.Create (2);
@@ -287,6 +291,14 @@ mnhelper.Install (sta.Get(1));
 mnhelper.Install (sta.Get(2));
 mnhelper.Install (sta.Get(3));
 
+Ptr<Mipv6Stats> mipv6Stats;
+if (stats)
+  {
+    mipv6Stats = CreateObject<Mipv6Stats> ();
+    mipv6Stats->InstallMn (sta);
+    mipv6Stats->InstallHa (ha.Get (0));
+  }
+
 LogComponentEnable ("Mipv6Mn", LOG_LEVEL_ALL);
 LogComponentEnable ("Mipv6Ha", LOG_LEVEL_ALL);
 
@@ -359,6 +371,33 @@ LogComponentEnable ("UdpEchoServerApplication", LOG_LEVEL_ALL);
 
 Simulator::Stop (Seconds (100.5));
 Simulator::Run ();
+
+if (stats)
+  {
+    mipv6Stats->Flush ();
+    for (uint32_t i = 0; i < sta.GetN (); i++)
+      {
+        Ptr<Mipv6HandoffCalculator> mnStats = mipv6Stats->GetMnStats (sta.Get (i)->GetId ());
+        std::cout << "MN " << sta.Get (i)->GetId () << ": " << mnStats->GetNHandoffs () << " handoffs, "
+                  << mnStats->GetNIncomplete () << " incomplete";
+        for (uint8_t p = 0; p < Mipv6HandoffCalculator::PHASE_COUNT; p++)
+          {
+            if (mnStats->GetCount (p))
+              {
+                std::cout << " " << Mipv6HandoffCalculator::GetPhaseName (p) << "=" << mnStats->GetMean (p).GetSeconds ();
+              }
+          }
+        std::cout << std::endl;
+      }
+
+    DataCollector data;
+    data.DescribeRun ("mipv6-multiple", "handoff", "default", "0");
+    mipv6Stats->Export (data);
+    OmnetDataOutput output;
+    output.SetFilePrefix ("mipv6-multiple");
+    output.Output (data);
+  }
+
 Simulator::Destroy ();
 
 return 0;
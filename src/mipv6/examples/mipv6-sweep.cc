@@ -0,0 +1,316 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/*
+ * A parameter sweep over the scenario of mipv6-multiple.cc: "mns" mobile
+ * nodes move at "speed" m/s from the first access router to the second
+ * one while a correspondent node sends them a packet every 100 ms. Each point
+ * is simulated by independent replications, run in parallel.
+ *
+ * ./waf --run "mipv6-sweep --sweep=mns=1,2,4;speed=3,6 --replications=10"
+ *
+ * The values of each replication are written to mipv6-sweep-results.csv
+ * and, with --format=db, to mipv6-sweep.db, their means and 95% confidence intervals to
+ * mipv6-sweep-summary.csv. Parameters named after an attribute, e.g.
+ * "ns3::WifiRemoteStationManager::RtsCtsThreshold=0,2200", are set with
+ * Config::SetDefault in each replication.
+ */
+
+#include <iostream>
+#include <cstdlib>
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/internet-module.h"
+#include "ns3/applications-module.h"
+#include "ns3/mobility-module.h"
+#include "ns3/wifi-module.h"
+#include "ns3/csma-module.h"
+#include "ns3/internet-apps-module.h"
+#include "ns3/stats-module.h"
+#include "ns3/mipv6-module.h"
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("Mipv6Sweep");
+
+/**
+ * \param parameters the parameters of a point
+ * \param name the name of a parameter
+ * \param value its value if the sweep does not set it
+ * \returns the value of the parameter
+ */
+static double
+GetParameter (const ReplicationRunner::Parameters &parameters, std::string name, double value)
+{
+  ReplicationRunner::Parameters::const_iterator i = parameters.find (name);
+  return i == parameters.end () ? value : std::atof (i->second.c_str ());
+}
+
+/**
+ * \brief Simulate a replication.
+ * \param parameters the parameters of the point
+ * \param collector the collector of the replication
+ */
+static void
+RunReplication (const ReplicationRunner::Parameters &parameters, Ptr<DataCollector> collector)
+{
+  uint32_t nMns = GetParameter (parameters, "mns", 4);
+  double speed = GetParameter (parameters, "speed", 3);
+  double duration = GetParameter (parameters, "duration", 60);
+
+  NodeContainer ars;
+  NodeContainer ha;
+  NodeContainer cn;
+  NodeContainer mid;
+  NodeContainer sta;
+  ars.Create (2);
+  ha.Create (1);
+  cn.Create (1);
+  mid.Create (1);
+  sta.Create (nMns);
+
+  InternetStackHelper internet;
+  internet.Install (ars);
+  internet.Install (mid);
+  internet.Install (ha);
+  internet.Install (cn);
+  internet.Install (sta);
+
+  NodeContainer backbone1 (mid.Get (0), ars.Get (0), ars.Get (1));
+  NodeContainer backbone2 (cn.Get (0), mid.Get (0), ha.Get (0));
+
+  CsmaHelper csma;
+  csma.SetChannelAttribute ("DataRate", DataRateValue (DataRate ("100Mbps")));
+  csma.SetChannelAttribute ("Delay", TimeValue (MilliSeconds (1)));
+  csma.SetDeviceAttribute ("Mtu", UintegerValue (1400));
+
+  Ipv6AddressHelper ipv6;
+  ipv6.SetBase (Ipv6Address ("2001:db80::"), Ipv6Prefix (64));
+  Ipv6InterfaceContainer backbone1Ifs = ipv6.Assign (csma.Install (backbone1));
+  Ipv6Address homePrefix ("5001:db80::");
+  ipv6.SetBase (homePrefix, Ipv6Prefix (64));
+  Ipv6InterfaceContainer backbone2Ifs = ipv6.Assign (csma.Install (backbone2));
+  for (uint32_t i = 0; i < 3; i++)
+    {
+      backbone1Ifs.SetForwarding (i, true);
+      backbone2Ifs.SetForwarding (i, true);
+      backbone1Ifs.SetDefaultRouteInAllNodes (i);
+      backbone2Ifs.SetDefaultRouteInAllNodes (i);
+    }
+
+  MobilityHelper mobility;
+  Ptr<ListPositionAllocator> positionAlloc = CreateObject<ListPositionAllocator> ();
+  positionAlloc->Add (Vector (0.0, -20.0, 0.0));   // MID
+  positionAlloc->Add (Vector (-50.0, 20.0, 0.0));  // AR1
+  positionAlloc->Add (Vector (50.0, 20.0, 0.0));   // AR2
+  positionAlloc->Add (Vector (25.0, -20.0, 0.0));  // HA
+  positionAlloc->Add (Vector (-25.0, -20.0, 0.0)); // CN
+  mobility.SetPositionAllocator (positionAlloc);
+  mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+  mobility.Install (NodeContainer (backbone1, ha, cn));
+
+  Ssid ssid = Ssid ("ns-3-ssid");
+  YansWifiPhyHelper wifiPhy = YansWifiPhyHelper::Default ();
+  YansWifiChannelHelper wifiChannel = YansWifiChannelHelper::Default ();
+  wifiPhy.SetChannel (wifiChannel.Create ());
+  WifiHelper wifi;
+  NqosWifiMacHelper wifiMac = NqosWifiMacHelper::Default ();
+  wifiMac.SetType ("ns3::ApWifiMac",
+                   "Ssid", SsidValue (ssid),
+                   "BeaconGeneration", BooleanValue (true),
+                   "BeaconInterval", TimeValue (MilliSeconds (100)));
+  NetDeviceContainer ar1Devs = wifi.Install (wifiPhy, wifiMac, ars.Get (0));
+  NetDeviceContainer ar2Devs = wifi.Install (wifiPhy, wifiMac, ars.Get (1));
+
+  Ipv6Address prefix1 ("8888:56ac::");
+  Ipv6Address prefix2 ("9999:db80::");
+  ipv6.SetBase (prefix1, Ipv6Prefix (64));
+  Ipv6InterfaceContainer ar1Ifs = ipv6.Assign (ar1Devs);
+  ar1Ifs.SetForwarding (0, true);
+  ipv6.SetBase (prefix2, Ipv6Prefix (64));
+  Ipv6InterfaceContainer ar2Ifs = ipv6.Assign (ar2Devs);
+  ar2Ifs.SetForwarding (0, true);
+
+  // the mobile nodes start under the first access router, one after the other
+  positionAlloc = CreateObject<ListPositionAllocator> ();
+  for (uint32_t i = 0; i < nMns; i++)
+    {
+      positionAlloc->Add (Vector (-50.0 - 5.0 * i, 50.0, 0.0));
+    }
+  mobility.SetPositionAllocator (positionAlloc);
+  mobility.SetMobilityModel ("ns3::ConstantVelocityMobilityModel");
+  mobility.Install (sta);
+  for (uint32_t i = 0; i < nMns; i++)
+    {
+      sta.Get (i)->GetObject<ConstantVelocityMobilityModel> ()->SetVelocity (Vector (speed, 0, 0));
+    }
+
+  wifiMac.SetType ("ns3::StaWifiMac",
+                   "Ssid", SsidValue (ssid),
+                   "ActiveProbing", BooleanValue (false));
+  NetDeviceContainer staDevs = wifi.Install (wifiPhy, wifiMac, sta);
+  ipv6.AssignWithoutAddress (staDevs);
+
+  Ptr<Radvd> radvd1 = CreateObject<Radvd> ();
+  Ptr<RadvdInterface> routerInterface1 = Create<RadvdInterface> (ar1Ifs.GetInterfaceIndex (0), 1500, 50);
+  routerInterface1->AddPrefix (Create<RadvdPrefix> (prefix1, 64, 1.5, 2.0));
+  radvd1->AddConfiguration (routerInterface1);
+  ars.Get (0)->AddApplication (radvd1);
+  radvd1->SetStartTime (Seconds (1.0));
+  radvd1->SetStopTime (Seconds (duration));
+
+  Ptr<Radvd> radvd2 = CreateObject<Radvd> ();
+  Ptr<RadvdInterface> routerInterface2 = Create<RadvdInterface> (ar2Ifs.GetInterfaceIndex (0), 1500, 50);
+  routerInterface2->AddPrefix (Create<RadvdPrefix> (prefix2, 64, 1.5, 2.0));
+  radvd2->AddConfiguration (routerInterface2);
+  ars.Get (1)->AddApplication (radvd2);
+  radvd2->SetStartTime (Seconds (4.1));
+  radvd2->SetStopTime (Seconds (duration));
+
+  Ipv6StaticRoutingHelper routingHelper;
+  Ptr<Ipv6StaticRouting> routing = routingHelper.GetStaticRouting (mid.Get (0)->GetObject<Ipv6> ());
+  routing->AddNetworkRouteTo (prefix1, Ipv6Prefix (64), backbone1Ifs.GetAddress (1, 1), 1, 0);
+  routing->AddNetworkRouteTo (prefix2, Ipv6Prefix (64), backbone1Ifs.GetAddress (2, 1), 1, 0);
+  for (uint32_t i = 0; i < 2; i++)
+    {
+      routing = routingHelper.GetStaticRouting (ars.Get (i)->GetObject<Ipv6> ());
+      routing->AddNetworkRouteTo (homePrefix, Ipv6Prefix (64), backbone1Ifs.GetAddress (0, 1), 1, 0);
+    }
+
+  Mipv6HaHelper haHelper;
+  haHelper.Install (ha.Get (0));
+  Mipv6MnHelper mnHelper (haHelper.GetHomeAgentAddressList (), false);
+  for (uint32_t i = 0; i < nMns; i++)
+    {
+      mnHelper.Install (sta.Get (i));
+    }
+  Ptr<Mipv6Stats> mipv6Stats = CreateObject<Mipv6Stats> ();
+  mipv6Stats->InstallMn (sta);
+  mipv6Stats->InstallHa (ha.Get (0));
+
+  UdpServerHelper server (9);
+  ApplicationContainer serverApps = server.Install (sta);
+  serverApps.Start (Seconds (4.0));
+  serverApps.Stop (Seconds (duration + 0.5));
+  for (uint32_t i = 0; i < nMns; i++)
+    {
+      // the home address of the mobile node
+      Mac48Address mac = Mac48Address::ConvertFrom (staDevs.Get (i)->GetAddress ());
+      UdpClientHelper client (Ipv6Address::MakeAutoconfiguredAddress (mac, homePrefix), 9);
+      client.SetAttribute ("MaxPackets", UintegerValue (1000000));
+      client.SetAttribute ("Interval", TimeValue (Seconds (0.1)));
+      client.SetAttribute ("PacketSize", UintegerValue (1024));
+      ApplicationContainer clientApps = client.Install (cn.Get (0));
+      clientApps.Start (Seconds (4.1 + 0.01 * i));
+      clientApps.Stop (Seconds (duration));
+    }
+
+  Simulator::Stop (Seconds (duration + 0.5));
+  Simulator::Run ();
+
+  // the handoffs and the packets of all the mobile nodes, and the mean
+  // of their binding delays
+  Ptr<CounterCalculator<uint32_t> > received = CreateObject<CounterCalculator<uint32_t> > ();
+  received->SetKey ("received");
+  received->SetContext ("all");
+  Ptr<CounterCalculator<uint32_t> > handoffs = CreateObject<CounterCalculator<uint32_t> > ();
+  handoffs->SetKey ("handoffs");
+  handoffs->SetContext ("all");
+  Ptr<MinMaxAvgTotalCalculator<double> > delay = CreateObject<MinMaxAvgTotalCalculator<double> > ();
+  delay->SetKey ("binding-delay");
+  delay->SetContext ("all");
+  mipv6Stats->Flush ();
+  for (uint32_t i = 0; i < nMns; i++)
+    {
+      received->Update (DynamicCast<UdpServer> (serverApps.Get (i))->GetReceived ());
+      Ptr<Mipv6HandoffCalculator> mnStats = mipv6Stats->GetMnStats (sta.Get (i)->GetId ());
+      handoffs->Update (mnStats->GetNHandoffs ());
+      if (mnStats->GetCount (Mipv6HandoffCalculator::BA_RECEIVED) != 0)
+        {
+          delay->Update (mnStats->GetMean (Mipv6HandoffCalculator::BA_RECEIVED).GetSeconds ());
+        }
+    }
+  collector->AddDataCalculator (handoffs);
+  collector->AddDataCalculator (delay);
+  collector->AddDataCalculator (received);
+  mipv6Stats->Export (*collector);
+
+  Simulator::Destroy ();
+}
+
+int main (int argc, char *argv[])
+{
+  std::string sweep = "mns=1,2,4;speed=3,6";
+  uint32_t replications = 10;
+  uint32_t jobs = 0;
+  std::string prefix = "mipv6-sweep";
+  std::string format = "db";
+
+  CommandLine cmd;
+  cmd.Usage ("Run a parameter sweep of mobile IPv6 handoffs.");
+  cmd.AddValue ("sweep", "the parameters and their values, as name=value,value;name=value", sweep);
+  cmd.AddValue ("replications", "the number of replications of each point", replications);
+  cmd.AddValue ("jobs", "the number of replications run at the same time, 0 for one per processor", jobs);
+  cmd.AddValue ("prefix", "the prefix of the output files", prefix);
+  cmd.AddValue ("format", "the output format of the replications: db, omnet or none", format);
+  cmd.Parse (argc, argv);
+
+  ReplicationRunner runner;
+  runner.SetSweep (sweep);
+  runner.SetReplications (replications);
+  runner.SetJobs (jobs);
+  runner.SetExperiment ("mipv6-sweep");
+  runner.SetFilePrefix (prefix);
+  Ptr<DataOutputInterface> output;
+  if (format == "omnet")
+    {
+      output = CreateObject<OmnetDataOutput> ();
+    }
+  else if (format == "db")
+    {
+#ifdef STATS_HAS_SQLITE3
+      output = CreateObject<SqliteDataOutput> ();
+#else
+      std::cerr << "sqlite support not compiled in, writing the CSV files only" << std::endl;
+#endif
+    }
+  else if (format != "none")
+    {
+      std::cerr << "Unknown output format " << format << std::endl;
+      return 1;
+    }
+  if (output)
+    {
+      output->SetFilePrefix (prefix);
+      runner.SetOutput (output);
+    }
+
+  runner.Run (MakeCallback (&RunReplication));
+
+  for (uint32_t i = 0; i < runner.GetNPoints (); i++)
+    {
+      std::cout << runner.GetPointLabel (i) << ": "
+                << runner.GetMean (i, "all", "handoffs") << " +- "
+                << runner.GetHalfWidth (i, "all", "handoffs") << " handoffs, binding delay "
+                << runner.GetMean (i, "all", "binding-delay-mean") << " +- "
+                << runner.GetHalfWidth (i, "all", "binding-delay-mean") << " s, "
+                << runner.GetMean (i, "all", "received") << " +- "
+                << runner.GetHalfWidth (i, "all", "received") << " packets received" << std::endl;
+    }
+  runner.PrintSpeedup (std::cout);
+  return 0;
+}
@@ -45,9 +45,118 @@
 #include <string>
 
 
+/*
+ * The MN walks out of the coverage of the wifi AR and back, the WiMAX AR
+ * covering the whole path. Without MIH, only the wifi interface of the MN
+ * is up at first, and the wifi and WiMAX interfaces are switched when the
+ * wifi association is lost and recovered (break-before-make). With
+ * --mih=1, both interfaces stay up and a MihFunction reports the link
+ * events of both devices to the Mipv6Mn, which registers its WiMAX CoA
+ * when the wifi beacons fall below the going down threshold, before the
+ * association is lost (make-before-break).
+ *
+ * The example prints the echo packets lost, the longest gap between two
+ * echo replies, and the handoff delay: the time from the loss of the wifi
+ * association to the BA registering a CoA of another link, 0 if it was
+ * registered before.
+ */
+
 using namespace ns3;
 NS_LOG_COMPONENT_DEFINE ("mip6Wifi-wimax");
 
+static Ptr<Ipv6L3Protocol> g_ip;           //!< The IPv6 stack of the MN.
+static Ptr<Mipv6Mn> g_mn;                  //!< The MN.
+static uint32_t g_wifiIf;                  //!< The wifi interface of the MN.
+static uint32_t g_wimaxIf;                 //!< The WiMAX interface of the MN.
+static Ipv6Address g_cn;                   //!< The address of the CN.
+static uint32_t g_sent = 0;                //!< The echo requests sent.
+static uint32_t g_received = 0;            //!< The echo replies received.
+static Time g_lastReply;                   //!< The last echo reply.
+static Time g_maxGap;                      //!< The longest gap between two replies.
+static Time g_lost;                        //!< When the wifi association was lost, if no BA followed yet.
+static bool g_waitingBa = false;           //!< Whether a BA is awaited since the loss.
+static std::vector<Time> g_handoffDelays;  //!< The handoff delays.
+static EventId g_wifiBack;                 //!< Switch back to wifi, once its association is stable.
+
+static bool
+IsRegisteredAway (void)
+{
+  int32_t interface = g_ip->GetInterfaceForAddress (g_mn->GetCoA ());
+  return interface >= 0 && (uint32_t) interface != g_wifiIf;
+}
+
+static void
+EchoTx (Ptr<const Packet> packet)
+{
+  g_sent++;
+}
+
+static void
+RxMn (Ptr<Packet> packet, Ipv6Header innerHeader, Ipv6Header outerHeader, Ptr<Ipv6Interface> interface)
+{
+  if (innerHeader.GetNextHeader () != UdpL4Protocol::PROT_NUMBER || innerHeader.GetSourceAddress () != g_cn)
+    {
+      return;
+    }
+  g_received++;
+  if (!g_lastReply.IsZero () && Simulator::Now () - g_lastReply > g_maxGap)
+    {
+      g_maxGap = Simulator::Now () - g_lastReply;
+    }
+  g_lastReply = Simulator::Now ();
+}
+
+static void
+RxBa (Ptr<Packet> packet, Ipv6Address src, Ipv6Address dst, Ptr<Ipv6Interface> interface)
+{
+  if (g_waitingBa && IsRegisteredAway ())
+    {
+      g_handoffDelays.push_back (Simulator::Now () - g_lost);
+      g_waitingBa = false;
+    }
+}
+
+static void
+WifiDeAssoc (bool mih, Mac48Address bssid)
+{
+  NS_LOG_INFO (Simulator::Now ().GetSeconds () << "s wifi association lost");
+  if (IsRegisteredAway ())
+    {
+      g_handoffDelays.push_back (Seconds (0));
+    }
+  else
+    {
+      g_lost = Simulator::Now ();
+      g_waitingBa = true;
+    }
+  g_wifiBack.Cancel ();
+  if (!mih && g_ip->IsUp (g_wifiIf))
+    {
+      // wifi down, wimax on
+      g_ip->GetInterface (g_wifiIf)->SetDown ();
+      g_ip->GetInterface (g_wimaxIf)->SetUp ();
+    }
+}
+
+static void
+WifiBack (void)
+{
+  // wimax down, wifi on
+  g_ip->GetInterface (g_wimaxIf)->SetDown ();
+  g_ip->GetInterface (g_wifiIf)->SetUp ();
+}
+
+static void
+WifiAssoc (bool mih, Mac48Address bssid)
+{
+  NS_LOG_INFO (Simulator::Now ().GetSeconds () << "s wifi associated");
+  if (!mih && !g_ip->IsUp (g_wifiIf))
+    {
+      // the association flaps at the edge of the coverage of the AR
+      g_wifiBack = Simulator::Schedule (Seconds (2.0), &WifiBack);
+    }
+}
+
 int main (int argc, char *argv[])
 {
 
@@ -61,7 +170,18 @@ NodeContainer backbone2;
 NodeContainer wifiar;
 NodeContainer wimaxar;
 
+bool mih = false;
+bool verbose = false;
+double interval = 0.1;
+double speed = 10.0;
+double stop = 60.0;
+
 CommandLine cmd;
+cmd.AddValue ("mih", "Prepare the handoffs from the MIH link events", mih);
+cmd.AddValue ("verbose", "Enable the logs of the MIPv6 agents and of the echo applications", verbose);
+cmd.AddValue ("interval", "Interval between two echo requests (s)", interval);
+cmd.AddValue ("speed", "Speed of the MN (m/s)", speed);
+cmd.AddValue ("stop", "Simulation time (s)", stop);
 cmd.Parse (argc, argv);
 
 ars.Create (2);
@@ -170,11 +290,19 @@ mobility.SetPositionAllocator (positionAlloc);
 mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
 mobility.Install (cn);
 
-positionAlloc = CreateObject<ListPositionAllocator> ();
-positionAlloc->Add (Vector (0.0, 40.0, 0.0));
-mobility.SetPositionAllocator (positionAlloc);
-mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
-mobility.Install (sta);
+//the MN leaves the wifi AR at 5 sec. and comes back, twice
+Ptr<WaypointMobilityModel> staMobility = CreateObject<WaypointMobilityModel> ();
+double x = -50.0;
+double t = 0.0;
+staMobility->AddWaypoint (Waypoint (Seconds (t), Vector (x, 40.0, 0.0)));
+for (t = 5.0; t < stop; t += 2 * 200.0 / speed + 10.0)
+  {
+    staMobility->AddWaypoint (Waypoint (Seconds (t), Vector (-50.0, 40.0, 0.0)));
+    staMobility->AddWaypoint (Waypoint (Seconds (t + 200.0 / speed), Vector (150.0, 40.0, 0.0)));
+    staMobility->AddWaypoint (Waypoint (Seconds (t + 200.0 / speed + 5.0), Vector (150.0, 40.0, 0.0)));
+    staMobility->AddWaypoint (Waypoint (Seconds (t + 2 * 200.0 / speed + 5.0), Vector (-50.0, 40.0, 0.0)));
+  }
+sta.Get (0)->AggregateObject (staMobility);
 
 
 Ssid ssid = Ssid ("ns-3-ssid");
@@ -325,8 +453,21 @@ Mipv6HaHelper hahelper;
 hahelper.Install (ha.Get (0));
 Mipv6MnHelper mnhelper1 (hahelper.GetHomeAgentAddressList (),false); 
 mnhelper1.Install (sta.Get (0));
-LogComponentEnable ("Mipv6Mn", LOG_LEVEL_ALL);
-LogComponentEnable ("Mipv6Ha", LOG_LEVEL_ALL);
+
+if (mih)
+  {
+    MihHelper mihHelper;
+    mihHelper.Install (sta.Get (0));
+  }
+
+if (verbose)
+  {
+    LogComponentEnable ("Mipv6Mn", LOG_LEVEL_ALL);
+    LogComponentEnable ("Mipv6Ha", LOG_LEVEL_ALL);
+    LogComponentEnable ("UdpEchoClientApplication", LOG_LEVEL_ALL);
+    LogComponentEnable ("UdpEchoServerApplication", LOG_LEVEL_ALL);
+    LogComponentEnable ("MihFunction", LOG_LEVEL_ALL);
+  }
 
 
 UdpEchoServerHelper echoServer (9);
@@ -336,44 +477,66 @@ ApplicationContainer serverApps = echoServer.Install (cn.Get (0));
 serverApps.Start (Seconds (1.0));
 serverApps.Stop (Seconds (700.0));
 
-UdpEchoClientHelper echoClient (Ipv6Address ("5001:db80::200:ff:fe00:4"), 9);
-echoClient.SetAttribute ("MaxPackets", UintegerValue (10000));
-echoClient.SetAttribute ("Interval", TimeValue (Seconds (1.0)));
+g_cn = Ipv6Address ("5001:db80::200:ff:fe00:4");
+UdpEchoClientHelper echoClient (g_cn, 9);
+echoClient.SetAttribute ("MaxPackets", UintegerValue (1000000));
+echoClient.SetAttribute ("Interval", TimeValue (Seconds (interval)));
 echoClient.SetAttribute ("PacketSize", UintegerValue (1024));
 
 ApplicationContainer clientApps = echoClient.Install (sta.Get (0));
 
-clientApps.Start (Seconds (1.1));
-clientApps.Stop (Seconds (700.0));  
+//out of phase with the beacons of the wifi AR, which would collide with
+//the requests sent at the same time
+clientApps.Start (Seconds (1.15));
+clientApps.Stop (Seconds (stop));  
 
-LogComponentEnable ("UdpEchoClientApplication", LOG_LEVEL_ALL);
-LogComponentEnable ("UdpEchoServerApplication", LOG_LEVEL_ALL);
 
 
+g_ip = sta.Get (0)->GetObject<Ipv6L3Protocol> ();
+g_mn = sta.Get (0)->GetObject<Mipv6Mn> ();
+g_wifiIf = g_ip->GetInterfaceForDevice (staDevs.Get (0));
+g_wimaxIf = g_ip->GetInterfaceForDevice (wimaxstaDevs.Get (0));
 
-Ptr<Ipv6L3Protocol> ip = sta.Get (0)->GetObject<Ipv6L3Protocol> ();  
+if (!mih)
+  {
+    //wimax down, wifi on at 0. sec.
+    g_ip->GetInterface (g_wimaxIf)->SetDown ();
+  }
 
-//wimax down, wifi on at 0. sec.
-ip->GetInterface (2)->SetDown ();
+Ptr<WifiNetDevice> staWifi = DynamicCast<WifiNetDevice> (staDevs.Get (0));
+staWifi->GetMac ()->TraceConnectWithoutContext ("DeAssoc", MakeBoundCallback (&WifiDeAssoc, mih));
+staWifi->GetMac ()->TraceConnectWithoutContext ("Assoc", MakeBoundCallback (&WifiAssoc, mih));
+clientApps.Get (0)->TraceConnectWithoutContext ("Tx", MakeCallback (&EchoTx));
+sta.Get (0)->GetObject<Ipv6TunnelL4Protocol> ()->TraceConnectWithoutContext ("RxMn", MakeCallback (&RxMn));
+g_mn->TraceConnectWithoutContext ("RxBA", MakeCallback (&RxBa));
 
-//wifi down, wimax on at 5.2 sec.
-Simulator::Schedule (Seconds (5.2), &Ipv6Interface::SetDown, ip->GetInterface (1));
-Simulator::Schedule (Seconds (5.2), &Ipv6Interface::SetUp, ip->GetInterface (2));
 
 
-//wimax down, wifi on at 10.2 sec.
-Simulator::Schedule (Seconds (10.2), &Ipv6Interface::SetDown, ip->GetInterface (2));
-Simulator::Schedule (Seconds (10.2), &Ipv6Interface::SetUp, ip->GetInterface (1));
+Simulator::Stop (Seconds (stop + 1.0));
+Simulator::Run ();
 
-//wifi down, wimax on at 15.2 sec.
-Simulator::Schedule (Seconds (15.2), &Ipv6Interface::SetDown, ip->GetInterface (1));
-Simulator::Schedule (Seconds (15.2), &Ipv6Interface::SetUp, ip->GetInterface (2));
-  
+Time maxDelay;
+Time sumDelay;
+for (std::vector<Time>::const_iterator it = g_handoffDelays.begin (); it != g_handoffDelays.end (); ++it)
+  {
+    sumDelay += *it;
+    maxDelay = Max (maxDelay, *it);
+  }
 
+std::cout << "MIH: " << (mih ? "on" : "off") << std::endl;
+std::cout << "Echo requests sent: " << g_sent << ", replies received: " << g_received
+          << ", lost: " << g_sent - g_received << std::endl;
+std::cout << "Longest gap between two replies: " << g_maxGap.GetSeconds () << " s" << std::endl;
+std::cout << "Wifi associations lost: " << g_handoffDelays.size () + (g_waitingBa ? 1 : 0) << std::endl;
+if (!g_handoffDelays.empty ())
+  {
+    std::cout << "Handoff delay: mean " << sumDelay.GetSeconds () / g_handoffDelays.size ()
+              << " s, max " << maxDelay.GetSeconds () << " s" << std::endl;
+  }
 
-Simulator::Stop (Seconds (100.0));
-Simulator::Run ();
 Simulator::Destroy ();
+g_ip = 0;
+g_mn = 0;
 
 return 0;
 }
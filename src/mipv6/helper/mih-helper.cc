@@ -0,0 +1,100 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/log.h"
+#include "ns3/node.h"
+#include "ns3/net-device.h"
+#include "ns3/mih-link-adapter.h"
+#ifdef NS3_MIPV6_LTE
+#include "ns3/mih-lte-link-adapter.h"
+#endif
+#include "mih-helper.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("MihHelper");
+
+MihHelper::MihHelper ()
+{
+  m_wifi.SetTypeId (MihWifiLinkAdapter::GetTypeId ());
+  m_wimax.SetTypeId (MihWimaxLinkAdapter::GetTypeId ());
+#ifdef NS3_MIPV6_LTE
+  m_lte.SetTypeId (MihLteLinkAdapter::GetTypeId ());
+#endif
+}
+
+MihHelper::~MihHelper ()
+{
+}
+
+void
+MihHelper::SetWifiAttribute (std::string name, const AttributeValue &value)
+{
+  m_wifi.Set (name, value);
+}
+
+void
+MihHelper::SetWimaxAttribute (std::string name, const AttributeValue &value)
+{
+  m_wimax.Set (name, value);
+}
+
+void
+MihHelper::SetLteAttribute (std::string name, const AttributeValue &value)
+{
+#ifdef NS3_MIPV6_LTE
+  m_lte.Set (name, value);
+#else
+  NS_FATAL_ERROR ("The LTE link adapters need the lte module");
+#endif
+}
+
+Ptr<MihFunction>
+MihHelper::Install (Ptr<Node> node) const
+{
+  Ptr<MihFunction> mih = node->GetObject<MihFunction> ();
+  NS_ASSERT_MSG (mih == 0, "MIH function already installed on node " << node->GetId ());
+  mih = CreateObject<MihFunction> ();
+
+  for (uint32_t i = 0; i < node->GetNDevices (); i++)
+    {
+      Ptr<NetDevice> device = node->GetDevice (i);
+      if (m_wifi.Create<MihLinkAdapter> ()->Attach (mih, device)
+          || m_wimax.Create<MihLinkAdapter> ()->Attach (mih, device)
+#ifdef NS3_MIPV6_LTE
+          || m_lte.Create<MihLinkAdapter> ()->Attach (mih, device)
+#endif
+          )
+        {
+          NS_LOG_LOGIC ("Node " << node->GetId () << " device " << i << " has a link adapter");
+        }
+    }
+
+  // aggregated last, so that the Mipv6Mn finds the links of the function
+  node->AggregateObject (mih);
+  return mih;
+}
+
+void
+MihHelper::Install (NodeContainer nodes) const
+{
+  for (NodeContainer::Iterator it = nodes.Begin (); it != nodes.End (); ++it)
+    {
+      Install (*it);
+    }
+}
+
+} // namespace ns3
@@ -0,0 +1,97 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MIH_HELPER_H
+#define MIH_HELPER_H
+
+#include <string>
+#include "ns3/ptr.h"
+#include "ns3/object-factory.h"
+#include "ns3/attribute.h"
+#include "ns3/node-container.h"
+#include "ns3/mih-function.h"
+
+namespace ns3 {
+
+class Node;
+
+/**
+ * \brief MIH Helper
+ *
+ * Aggregates a MihFunction to a node, and attaches to it a link adapter
+ * for each wifi station, WiMAX subscriber station and LTE UE device of the
+ * node; the LTE UEs are only supported when the lte module is built. The
+ * Mipv6Mn of the node, if any, then subscribes to its events and prepares
+ * its handoffs before the links are lost.
+ */
+class MihHelper
+{
+public:
+  MihHelper ();
+  ~MihHelper ();
+
+  /**
+   * \brief set an attribute of the wifi link adapters.
+   * \param name the name of the attribute
+   * \param value its value
+   */
+  void SetWifiAttribute (std::string name, const AttributeValue &value);
+
+  /**
+   * \brief set an attribute of the WiMAX link adapters.
+   * \param name the name of the attribute
+   * \param value its value
+   */
+  void SetWimaxAttribute (std::string name, const AttributeValue &value);
+
+  /**
+   * \brief set an attribute of the LTE link adapters.
+   * \param name the name of the attribute
+   * \param value its value
+   */
+  void SetLteAttribute (std::string name, const AttributeValue &value);
+
+  /**
+   * \param node The node on which to install the function.
+   * \returns the function of the node
+   */
+  Ptr<MihFunction> Install (Ptr<Node> node) const;
+
+  /**
+   * \param nodes The nodes on which to install the function.
+   */
+  void Install (NodeContainer nodes) const;
+
+private:
+  /**
+   * \brief the factory of the wifi link adapters.
+   */
+  ObjectFactory m_wifi;
+
+  /**
+   * \brief the factory of the WiMAX link adapters.
+   */
+  ObjectFactory m_wimax;
+
+  /**
+   * \brief the factory of the LTE link adapters.
+   */
+  ObjectFactory m_lte;
+};
+
+} // namespace ns3
+
+#endif /* MIH_HELPER_H */
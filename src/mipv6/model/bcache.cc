@@ -118,26 +118,9 @@ void BCache::Remove (BCache::Entry* entry)
 void BCache::SetHomePrefixes (std::list<Ipv6Address> halist)
 {
   m_HaaList = halist;
-  std::list<Ipv6Address> hlist;
-  hlist = m_HaaList;
-  uint8_t buf1[16],buf2[16];
-  while (hlist.size ())
+  for (std::list<Ipv6Address>::const_iterator it = m_HaaList.begin (); it != m_HaaList.end (); ++it)
     {
-      hlist.front ().GetBytes (buf1);
-      for (uint8_t i = 0; i < 16; i++)
-        {
-          if (i < 8)
-            {
-              buf2[i] = buf1[i];
-            }
-          else
-            {
-              buf2[i] = 0;
-            }
-        }
-      Ipv6Address addr (buf2);
-      m_HomePrefixList.push_back (addr);
-      hlist.pop_front ();
+      m_HomePrefixList.push_back (it->CombinePrefix (Ipv6Prefix (64)));
     }
 }
 
@@ -197,6 +180,8 @@ BCache::Entry *BCache::Entry::Copy ()
   bce->SetTunnelIfIndex (this->GetTunnelIfIndex ());
   bce->SetLastBindingUpdateTime (this->GetLastBindingUpdateTime ());
   bce->SetLastBindingUpdateSequence (this->GetLastBindingUpdateSequence ());
+  bce->m_coaList = this->m_coaList;
+  bce->m_flows = this->m_flows;
 
   bce->SetNext (0);
   return bce;
@@ -274,6 +259,108 @@ void BCache::Entry::SetCoa (Ipv6Address coa)
   m_coa = coa;
 }
 
+void BCache::Entry::AddCoa (uint16_t bid, Ipv6Address coa)
+{
+  NS_LOG_FUNCTION ( this << bid << coa );
+
+  m_coaList[bid] = coa;
+}
+
+void BCache::Entry::RemoveCoa (uint16_t bid)
+{
+  NS_LOG_FUNCTION ( this << bid );
+
+  m_coaList.erase (bid);
+
+  for (std::list<FlowBinding>::iterator it = m_flows.begin (); it != m_flows.end (); )
+    {
+      if (it->bid == bid)
+        {
+          it = m_flows.erase (it);
+        }
+      else
+        {
+          ++it;
+        }
+    }
+}
+
+Ipv6Address BCache::Entry::GetCoa (uint16_t bid) const
+{
+  NS_LOG_FUNCTION ( this << bid );
+
+  std::map<uint16_t, Ipv6Address>::const_iterator it = m_coaList.find (bid);
+  if (it == m_coaList.end ())
+    {
+      return Ipv6Address::GetAny ();
+    }
+  return it->second;
+}
+
+std::map<uint16_t, Ipv6Address> BCache::Entry::GetCoaList () const
+{
+  NS_LOG_FUNCTION (this);
+
+  return m_coaList;
+}
+
+uint32_t BCache::Entry::GetNCoa () const
+{
+  NS_LOG_FUNCTION (this);
+
+  return m_coaList.size ();
+}
+
+void BCache::Entry::AddFlowBinding (FlowBinding flow)
+{
+  NS_LOG_FUNCTION ( this << flow.fid << flow.bid );
+
+  RemoveFlowBinding (flow.fid);
+
+  std::list<FlowBinding>::iterator it = m_flows.begin ();
+  while (it != m_flows.end () && it->priority <= flow.priority)
+    {
+      ++it;
+    }
+  m_flows.insert (it, flow);
+}
+
+void BCache::Entry::RemoveFlowBinding (uint16_t fid)
+{
+  NS_LOG_FUNCTION ( this << fid );
+
+  for (std::list<FlowBinding>::iterator it = m_flows.begin (); it != m_flows.end (); ++it)
+    {
+      if (it->fid == fid)
+        {
+          m_flows.erase (it);
+          return;
+        }
+    }
+}
+
+bool BCache::Entry::HasFlowBindings () const
+{
+  NS_LOG_FUNCTION (this);
+
+  return !m_flows.empty ();
+}
+
+Ipv6Address BCache::Entry::LookupFlow (uint8_t protocol, uint16_t port) const
+{
+  NS_LOG_FUNCTION ( this << (uint32_t) protocol << port );
+
+  for (std::list<FlowBinding>::const_iterator it = m_flows.begin (); it != m_flows.end (); ++it)
+    {
+      if ((it->protocol == 0 || it->protocol == protocol)
+          && port >= it->portLow && port <= it->portHigh)
+        {
+          return GetCoa (it->bid);
+        }
+    }
+  return Ipv6Address::GetAny ();
+}
+
 void BCache::Entry::SetHoa (Ipv6Address hoa)
 {
   NS_LOG_FUNCTION ( this << hoa );
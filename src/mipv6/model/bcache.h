@@ -24,6 +24,7 @@
 
 
 #include <list>
+#include <map>
 #include "ns3/nstime.h"
 #include "ns3/node.h"
 #include "ns3/ipv6-address.h"
@@ -358,6 +359,77 @@ public:
      */
     BCache::Entry::State_e GetState ();
 
+    /**
+     * \brief structure of a flow binding (RFC 6089) registered by the MN
+     */
+    struct FlowBinding
+    {
+      uint16_t fid;      //!< flow identifier
+      uint16_t priority; //!< flow priority, lower value is matched first
+      uint16_t bid;      //!< binding identifier the flow is bound to
+      uint8_t protocol;  //!< transport protocol, 0 matches any
+      uint16_t portLow;  //!< lowest destination port of the flow
+      uint16_t portHigh; //!< highest destination port of the flow
+    };
+
+    /**
+     * \brief add or update a care-of address bound with a binding identifier (RFC 5648)
+     * \param bid binding identifier
+     * \param coa care-of address
+     */
+    void AddCoa (uint16_t bid, Ipv6Address coa);
+
+    /**
+     * \brief remove the care-of address bound with a binding identifier
+     * \param bid binding identifier
+     */
+    void RemoveCoa (uint16_t bid);
+
+    /**
+     * \brief get the care-of address bound with a binding identifier
+     * \param bid binding identifier
+     * \return care-of address, or any address if the binding does not exist
+     */
+    Ipv6Address GetCoa (uint16_t bid) const;
+
+    /**
+     * \brief get all registered care-of addresses, keyed by binding identifier
+     * \return care-of address map
+     */
+    std::map<uint16_t, Ipv6Address> GetCoaList () const;
+
+    /**
+     * \brief get the number of registered care-of addresses
+     * \return number of care-of addresses
+     */
+    uint32_t GetNCoa () const;
+
+    /**
+     * \brief add a flow binding, replacing any binding with the same flow identifier
+     * \param flow flow binding
+     */
+    void AddFlowBinding (FlowBinding flow);
+
+    /**
+     * \brief remove a flow binding
+     * \param fid flow identifier
+     */
+    void RemoveFlowBinding (uint16_t fid);
+
+    /**
+     * \brief check whether any flow binding is registered
+     * \return true if at least one flow binding exists
+     */
+    bool HasFlowBindings () const;
+
+    /**
+     * \brief lookup the care-of address a flow is bound to
+     * \param protocol transport protocol of the packet
+     * \param port destination port of the packet
+     * \return care-of address, or any address if no flow binding matches
+     */
+    Ipv6Address LookupFlow (uint8_t protocol, uint16_t port) const;
+
   private:
 
     /**
@@ -463,6 +535,16 @@ public:
      */
     State_e m_addrstate;
 
+    /**
+     * \brief The care-of addresses of the MN, keyed by binding identifier
+     */
+    std::map<uint16_t, Ipv6Address> m_coaList;
+
+    /**
+     * \brief The flow bindings of the MN, sorted by priority
+     */
+    std::list<FlowBinding> m_flows;
+
   };
 
 
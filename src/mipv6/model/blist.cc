@@ -431,6 +431,24 @@ Ipv6Address BList::GetCoa (void) const
   return m_coa;
 }
 
+void BList::AddCoa (uint16_t bid, Ipv6Address addr)
+{
+  NS_LOG_FUNCTION (this << bid << addr);
+  m_coaList[bid] = addr;
+}
+
+void BList::RemoveCoa (uint16_t bid)
+{
+  NS_LOG_FUNCTION (this << bid);
+  m_coaList.erase (bid);
+}
+
+std::map<uint16_t, Ipv6Address> BList::GetCoaList () const
+{
+  NS_LOG_FUNCTION (this);
+  return m_coaList;
+}
+
 Ipv6Address BList::GetHA () const
 {
   return m_ha;
@@ -22,6 +22,7 @@
 #define B_LIST_H
 
 #include <list>
+#include <map>
 #include "ns3/packet.h"
 #include "ns3/nstime.h"
 #include "ns3/ipv6-address.h"
@@ -275,6 +276,22 @@ public:
    * \param addr care-of-address
    */
   void SetCoa (Ipv6Address addr);
+  /**
+   * \brief add or update a care-of-address bound with a binding identifier (RFC 5648).
+   * \param bid binding identifier
+   * \param addr care-of-address
+   */
+  void AddCoa (uint16_t bid, Ipv6Address addr);
+  /**
+   * \brief remove the care-of-address bound with a binding identifier.
+   * \param bid binding identifier
+   */
+  void RemoveCoa (uint16_t bid);
+  /**
+   * \brief get all care-of-addresses, keyed by binding identifier.
+   * \return care-of-address map
+   */
+  std::map<uint16_t, Ipv6Address> GetCoaList () const;
   /**
    * \brief set home agent address.
    * \param ha home agent address
@@ -746,6 +763,11 @@ private:
    */
   Ipv6Address m_coa;
 
+  /**
+   * \brief CoAs keyed by binding identifier
+   */
+  std::map<uint16_t, Ipv6Address> m_coaList;
+
   /**
    * \brief home agent address
    */
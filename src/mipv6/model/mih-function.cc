@@ -0,0 +1,117 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/log.h"
+#include "ns3/assert.h"
+#include "ns3/trace-source-accessor.h"
+#include "mih-link-adapter.h"
+#include "mih-function.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("MihFunction");
+
+NS_OBJECT_ENSURE_REGISTERED (MihFunction);
+
+TypeId MihFunction::GetTypeId ()
+{
+  static TypeId tid = TypeId ("ns3::MihFunction")
+    .SetParent<Object> ()
+    .SetGroupName ("Mipv6")
+    .AddConstructor<MihFunction> ()
+    .AddTraceSource ("LinkEvent",
+                     "A link of the node went up, down, is going down, "
+                     "or its signal crossed a report threshold.",
+                     MakeTraceSourceAccessor (&MihFunction::m_linkEventTrace),
+                     "ns3::MihFunction::LinkEventTracedCallback")
+  ;
+  return tid;
+}
+
+MihFunction::MihFunction ()
+{
+  NS_LOG_FUNCTION_NOARGS ();
+}
+
+MihFunction::~MihFunction ()
+{
+  NS_LOG_FUNCTION_NOARGS ();
+}
+
+void MihFunction::DoDispose ()
+{
+  NS_LOG_FUNCTION (this);
+  for (std::vector<Ptr<MihLinkAdapter> >::iterator it = m_links.begin (); it != m_links.end (); ++it)
+    {
+      (*it)->Dispose ();
+    }
+  m_links.clear ();
+  Object::DoDispose ();
+}
+
+void MihFunction::AddLink (Ptr<MihLinkAdapter> adapter)
+{
+  NS_LOG_FUNCTION (this << adapter);
+  m_links.push_back (adapter);
+}
+
+uint32_t MihFunction::GetNLinks () const
+{
+  return m_links.size ();
+}
+
+Ptr<MihLinkAdapter> MihFunction::GetLink (uint32_t index) const
+{
+  NS_ASSERT (index < m_links.size ());
+  return m_links[index];
+}
+
+Ptr<MihLinkAdapter> MihFunction::GetLink (Ptr<NetDevice> device) const
+{
+  for (std::vector<Ptr<MihLinkAdapter> >::const_iterator it = m_links.begin (); it != m_links.end (); ++it)
+    {
+      if ((*it)->GetDevice () == device)
+        {
+          return *it;
+        }
+    }
+  return 0;
+}
+
+void MihFunction::NotifyLinkEvent (uint8_t event, Ptr<NetDevice> device, double signal)
+{
+  NS_LOG_FUNCTION (this << GetEventName (event) << device << signal);
+  m_linkEventTrace (event, device, signal);
+}
+
+std::string MihFunction::GetEventName (uint8_t event)
+{
+  switch (event)
+    {
+    case LINK_UP:
+      return "Link_Up";
+    case LINK_DOWN:
+      return "Link_Down";
+    case LINK_GOING_DOWN:
+      return "Link_Going_Down";
+    case LINK_PARAMETERS_REPORT:
+      return "Link_Parameters_Report";
+    default:
+      return "Unknown";
+    }
+}
+
+} /* namespace ns3 */
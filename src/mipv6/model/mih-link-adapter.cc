@@ -0,0 +1,348 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <cmath>
+#include <limits>
+#include "ns3/log.h"
+#include "ns3/double.h"
+#include "ns3/wifi-net-device.h"
+#include "ns3/sta-wifi-mac.h"
+#include "ns3/wifi-mac-header.h"
+#include "ns3/wimax-net-device.h"
+#include "ns3/ss-net-device.h"
+#include "mih-link-adapter.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("MihLinkAdapter");
+
+NS_OBJECT_ENSURE_REGISTERED (MihLinkAdapter);
+
+TypeId MihLinkAdapter::GetTypeId ()
+{
+  static TypeId tid = TypeId ("ns3::MihLinkAdapter")
+    .SetParent<Object> ()
+    .SetGroupName ("Mipv6")
+    .AddAttribute ("Hysteresis",
+                   "How far above GoingDownThreshold the signal has to go back "
+                   "before Link_Going_Down can be notified again.",
+                   DoubleValue (3.0),
+                   MakeDoubleAccessor (&MihLinkAdapter::m_hysteresis),
+                   MakeDoubleChecker<double> (0.0))
+  ;
+  return tid;
+}
+
+MihLinkAdapter::MihLinkAdapter ()
+  : m_linkUp (false),
+    m_goingDown (false),
+    m_signal (std::numeric_limits<double>::quiet_NaN ()),
+    m_goingDownThreshold (0.0),
+    m_hysteresis (3.0)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+}
+
+MihLinkAdapter::~MihLinkAdapter ()
+{
+  NS_LOG_FUNCTION_NOARGS ();
+}
+
+void MihLinkAdapter::DoDispose ()
+{
+  NS_LOG_FUNCTION (this);
+  m_mih = 0;
+  m_device = 0;
+  Object::DoDispose ();
+}
+
+bool MihLinkAdapter::Attach (Ptr<MihFunction> mih, Ptr<NetDevice> device)
+{
+  NS_LOG_FUNCTION (this << mih << device);
+  NS_ASSERT (m_device == 0);
+  m_mih = mih;
+  m_device = device;
+  if (!DoAttach (device))
+    {
+      m_mih = 0;
+      m_device = 0;
+      return false;
+    }
+  m_mih->AddLink (this);
+  return true;
+}
+
+Ptr<NetDevice> MihLinkAdapter::GetDevice () const
+{
+  return m_device;
+}
+
+bool MihLinkAdapter::IsLinkUp () const
+{
+  return m_linkUp;
+}
+
+bool MihLinkAdapter::IsGoingDown () const
+{
+  return m_goingDown;
+}
+
+double MihLinkAdapter::GetSignal () const
+{
+  return m_signal;
+}
+
+double MihLinkAdapter::GetSignalMargin () const
+{
+  return m_signal - m_goingDownThreshold;
+}
+
+void MihLinkAdapter::SetGoingDownThreshold (double threshold)
+{
+  m_goingDownThreshold = threshold;
+}
+
+double MihLinkAdapter::GetGoingDownThreshold () const
+{
+  return m_goingDownThreshold;
+}
+
+void MihLinkAdapter::AddReportThreshold (double threshold)
+{
+  NS_LOG_FUNCTION (this << threshold);
+  m_reportThresholds.push_back (threshold);
+}
+
+void MihLinkAdapter::LinkUp ()
+{
+  NS_LOG_FUNCTION (this);
+  if (m_linkUp)
+    {
+      return;
+    }
+  m_linkUp = true;
+  m_goingDown = false;
+  m_signal = std::numeric_limits<double>::quiet_NaN ();
+  Notify (MihFunction::LINK_UP);
+}
+
+void MihLinkAdapter::LinkDown ()
+{
+  NS_LOG_FUNCTION (this);
+  if (!m_linkUp)
+    {
+      return;
+    }
+  m_linkUp = false;
+  m_goingDown = false;
+  Notify (MihFunction::LINK_DOWN);
+}
+
+void MihLinkAdapter::ReportSignal (double signal)
+{
+  NS_LOG_FUNCTION (this << signal);
+  if (!m_linkUp)
+    {
+      return;
+    }
+
+  double last = m_signal;
+  m_signal = signal;
+
+  if (!std::isnan (last))
+    {
+      for (std::vector<double>::const_iterator it = m_reportThresholds.begin (); it != m_reportThresholds.end (); ++it)
+        {
+          if ((last < *it) != (signal < *it))
+            {
+              Notify (MihFunction::LINK_PARAMETERS_REPORT);
+              break;
+            }
+        }
+    }
+
+  if (!m_goingDown && signal < m_goingDownThreshold)
+    {
+      m_goingDown = true;
+      Notify (MihFunction::LINK_GOING_DOWN);
+    }
+  else if (m_goingDown && signal >= m_goingDownThreshold + m_hysteresis)
+    {
+      m_goingDown = false;
+      Notify (MihFunction::LINK_PARAMETERS_REPORT);
+    }
+}
+
+void MihLinkAdapter::Notify (uint8_t event)
+{
+  NS_LOG_LOGIC ("Link " << m_device->GetIfIndex () << " " << MihFunction::GetEventName (event)
+                        << " signal " << m_signal);
+  m_mih->NotifyLinkEvent (event, m_device, m_signal);
+}
+
+
+NS_OBJECT_ENSURE_REGISTERED (MihWifiLinkAdapter);
+
+TypeId MihWifiLinkAdapter::GetTypeId ()
+{
+  static TypeId tid = TypeId ("ns3::MihWifiLinkAdapter")
+    .SetParent<MihLinkAdapter> ()
+    .SetGroupName ("Mipv6")
+    .AddConstructor<MihWifiLinkAdapter> ()
+    .AddAttribute ("GoingDownThreshold",
+                   "The power (dBm) of the beacons of the access point below "
+                   "which the link is going down.",
+                   DoubleValue (-80.0),
+                   MakeDoubleAccessor (&MihLinkAdapter::SetGoingDownThreshold,
+                                       &MihLinkAdapter::GetGoingDownThreshold),
+                   MakeDoubleChecker<double> ())
+  ;
+  return tid;
+}
+
+MihWifiLinkAdapter::MihWifiLinkAdapter ()
+{
+  NS_LOG_FUNCTION_NOARGS ();
+}
+
+MihWifiLinkAdapter::~MihWifiLinkAdapter ()
+{
+  NS_LOG_FUNCTION_NOARGS ();
+}
+
+void MihWifiLinkAdapter::DoDispose ()
+{
+  NS_LOG_FUNCTION (this);
+  m_mac = 0;
+  MihLinkAdapter::DoDispose ();
+}
+
+bool MihWifiLinkAdapter::DoAttach (Ptr<NetDevice> device)
+{
+  NS_LOG_FUNCTION (this << device);
+  Ptr<WifiNetDevice> wifi = DynamicCast<WifiNetDevice> (device);
+  if (wifi == 0)
+    {
+      return false;
+    }
+  m_mac = DynamicCast<StaWifiMac> (wifi->GetMac ());
+  if (m_mac == 0 || wifi->GetPhy () == 0)
+    {
+      return false;
+    }
+  m_mac->TraceConnectWithoutContext ("Assoc", MakeCallback (&MihWifiLinkAdapter::Assoc, this));
+  m_mac->TraceConnectWithoutContext ("DeAssoc", MakeCallback (&MihWifiLinkAdapter::DeAssoc, this));
+  wifi->GetPhy ()->TraceConnectWithoutContext ("MonitorSnifferRx", MakeCallback (&MihWifiLinkAdapter::PhyRxSniffer, this));
+  return true;
+}
+
+void MihWifiLinkAdapter::Assoc (Mac48Address bssid)
+{
+  NS_LOG_FUNCTION (this << bssid);
+  LinkUp ();
+}
+
+void MihWifiLinkAdapter::DeAssoc (Mac48Address bssid)
+{
+  NS_LOG_FUNCTION (this << bssid);
+  LinkDown ();
+}
+
+void MihWifiLinkAdapter::PhyRxSniffer (Ptr<const Packet> packet, uint16_t channelFreqMhz,
+                                       uint16_t channelNumber, uint32_t rate, WifiPreamble preamble,
+                                       WifiTxVector txVector, struct mpduInfo aMpdu,
+                                       struct signalNoiseDbm signalNoise)
+{
+  if (!IsLinkUp () || aMpdu.type != NORMAL_MPDU)
+    {
+      return;
+    }
+  WifiMacHeader hdr;
+  packet->PeekHeader (hdr);
+  if (hdr.IsBeacon () && hdr.GetAddr3 () == m_mac->GetBssid ())
+    {
+      ReportSignal (signalNoise.signal);
+    }
+}
+
+
+NS_OBJECT_ENSURE_REGISTERED (MihWimaxLinkAdapter);
+
+TypeId MihWimaxLinkAdapter::GetTypeId ()
+{
+  static TypeId tid = TypeId ("ns3::MihWimaxLinkAdapter")
+    .SetParent<MihLinkAdapter> ()
+    .SetGroupName ("Mipv6")
+    .AddConstructor<MihWimaxLinkAdapter> ()
+    .AddAttribute ("GoingDownThreshold",
+                   "The SNR (dB) of the downlink bursts below which the link "
+                   "is going down.",
+                   DoubleValue (10.0),
+                   MakeDoubleAccessor (&MihLinkAdapter::SetGoingDownThreshold,
+                                       &MihLinkAdapter::GetGoingDownThreshold),
+                   MakeDoubleChecker<double> ())
+  ;
+  return tid;
+}
+
+MihWimaxLinkAdapter::MihWimaxLinkAdapter ()
+{
+  NS_LOG_FUNCTION_NOARGS ();
+}
+
+MihWimaxLinkAdapter::~MihWimaxLinkAdapter ()
+{
+  NS_LOG_FUNCTION_NOARGS ();
+}
+
+bool MihWimaxLinkAdapter::DoAttach (Ptr<NetDevice> device)
+{
+  NS_LOG_FUNCTION (this << device);
+  Ptr<SubscriberStationNetDevice> ss = DynamicCast<SubscriberStationNetDevice> (device);
+  if (ss == 0 || ss->GetPhy () == 0)
+    {
+      return false;
+    }
+  ss->AddLinkChangeCallback (MakeCallback (&MihWimaxLinkAdapter::LinkChanged, this));
+  // only the SimpleOfdmWimaxPhy has the SNR trace, the link events are
+  // notified without signal otherwise
+  ss->GetPhy ()->TraceConnectWithoutContext ("RxSnr", MakeCallback (&MihWimaxLinkAdapter::RxSnr, this));
+  LinkChanged ();
+  return true;
+}
+
+void MihWimaxLinkAdapter::LinkChanged ()
+{
+  NS_LOG_FUNCTION (this);
+  if (GetDevice ()->IsLinkUp ())
+    {
+      LinkUp ();
+    }
+  else
+    {
+      LinkDown ();
+    }
+}
+
+void MihWimaxLinkAdapter::RxSnr (double snr, uint8_t direction)
+{
+  if (direction == WimaxNetDevice::DIRECTION_DOWNLINK)
+    {
+      ReportSignal (snr);
+    }
+}
+
+} /* namespace ns3 */
@@ -0,0 +1,94 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <cmath>
+#include "ns3/log.h"
+#include "ns3/double.h"
+#include "ns3/lte-ue-net-device.h"
+#include "ns3/lte-ue-phy.h"
+#include "ns3/lte-ue-rrc.h"
+#include "mih-lte-link-adapter.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("MihLteLinkAdapter");
+
+NS_OBJECT_ENSURE_REGISTERED (MihLteLinkAdapter);
+
+TypeId MihLteLinkAdapter::GetTypeId ()
+{
+  static TypeId tid = TypeId ("ns3::MihLteLinkAdapter")
+    .SetParent<MihLinkAdapter> ()
+    .SetGroupName ("Mipv6")
+    .AddConstructor<MihLteLinkAdapter> ()
+    .AddAttribute ("GoingDownThreshold",
+                   "The RSRP (dBm) of the serving cell below which the link "
+                   "is going down.",
+                   DoubleValue (-110.0),
+                   MakeDoubleAccessor (&MihLinkAdapter::SetGoingDownThreshold,
+                                       &MihLinkAdapter::GetGoingDownThreshold),
+                   MakeDoubleChecker<double> ())
+  ;
+  return tid;
+}
+
+MihLteLinkAdapter::MihLteLinkAdapter ()
+{
+  NS_LOG_FUNCTION_NOARGS ();
+}
+
+MihLteLinkAdapter::~MihLteLinkAdapter ()
+{
+  NS_LOG_FUNCTION_NOARGS ();
+}
+
+bool MihLteLinkAdapter::DoAttach (Ptr<NetDevice> device)
+{
+  NS_LOG_FUNCTION (this << device);
+  Ptr<LteUeNetDevice> ue = DynamicCast<LteUeNetDevice> (device);
+  if (ue == 0 || ue->GetPhy () == 0 || ue->GetRrc () == 0)
+    {
+      return false;
+    }
+  ue->GetPhy ()->TraceConnectWithoutContext ("ReportCurrentCellRsrpSinr", MakeCallback (&MihLteLinkAdapter::RsrpSinr, this));
+  ue->GetRrc ()->TraceConnectWithoutContext ("ConnectionEstablished", MakeCallback (&MihLteLinkAdapter::Connected, this));
+  ue->GetRrc ()->TraceConnectWithoutContext ("HandoverEndOk", MakeCallback (&MihLteLinkAdapter::Connected, this));
+  ue->GetRrc ()->TraceConnectWithoutContext ("ConnectionTimeout", MakeCallback (&MihLteLinkAdapter::Disconnected, this));
+  ue->GetRrc ()->TraceConnectWithoutContext ("HandoverEndError", MakeCallback (&MihLteLinkAdapter::Disconnected, this));
+  return true;
+}
+
+void MihLteLinkAdapter::Connected (uint64_t imsi, uint16_t cellId, uint16_t rnti)
+{
+  NS_LOG_FUNCTION (this << imsi << cellId << rnti);
+  LinkUp ();
+}
+
+void MihLteLinkAdapter::Disconnected (uint64_t imsi, uint16_t cellId, uint16_t rnti)
+{
+  NS_LOG_FUNCTION (this << imsi << cellId << rnti);
+  LinkDown ();
+}
+
+void MihLteLinkAdapter::RsrpSinr (uint16_t cellId, uint16_t rnti, double rsrp, double sinr)
+{
+  if (rsrp > 0)
+    {
+      ReportSignal (10 * std::log10 (rsrp) + 30);
+    }
+}
+
+} /* namespace ns3 */
@@ -77,9 +77,57 @@ Mipv6Agent::~Mipv6Agent ()
 void Mipv6Agent::DoDispose ()
 {
   m_node = 0;
+  m_ipv6 = 0;
+  m_icmpv6 = 0;
+  m_mipv6Demux = 0;
+  m_tunnel = 0;
   Object::DoDispose ();
 }
 
+void Mipv6Agent::NotifyNewAggregate ()
+{
+  NS_LOG_FUNCTION (this);
+
+  /* the protocols may be aggregated after the agent, bind each one when it shows up */
+  if (m_ipv6 == 0)
+    {
+      m_ipv6 = GetObject<Ipv6L3Protocol> ();
+    }
+  if (m_icmpv6 == 0)
+    {
+      m_icmpv6 = GetObject<Icmpv6L4Protocol> ();
+    }
+  if (m_mipv6Demux == 0)
+    {
+      m_mipv6Demux = GetObject<Mipv6Demux> ();
+    }
+  if (m_tunnel == 0)
+    {
+      m_tunnel = GetObject<Ipv6TunnelL4Protocol> ();
+    }
+  Object::NotifyNewAggregate ();
+}
+
+Ptr<Ipv6L3Protocol> Mipv6Agent::GetIpv6 () const
+{
+  return m_ipv6;
+}
+
+Ptr<Icmpv6L4Protocol> Mipv6Agent::GetIcmpv6 () const
+{
+  return m_icmpv6;
+}
+
+Ptr<Mipv6Demux> Mipv6Agent::GetMipv6Demux () const
+{
+  return m_mipv6Demux;
+}
+
+Ptr<Ipv6TunnelL4Protocol> Mipv6Agent::GetTunnelProtocol () const
+{
+  return m_tunnel;
+}
+
 void Mipv6Agent::SetNode (Ptr<Node> node)
 {
   NS_LOG_FUNCTION (this << node);
@@ -155,7 +203,7 @@ void Mipv6Agent::SendMessage (Ptr<Packet> packet, Ipv6Address dst, uint32_t ttl)
 {
   NS_LOG_FUNCTION (this << packet << dst << (uint32_t)ttl << "send");
 
-  Ptr<Ipv6L3Protocol> ipv6 = m_node->GetObject<Ipv6L3Protocol> ();
+  Ptr<Ipv6L3Protocol> ipv6 = m_ipv6;
 
   NS_ASSERT (ipv6 != 0 && ipv6->GetRoutingProtocol () != 0);
 
@@ -24,6 +24,10 @@
 #include "ns3/object.h"
 #include "ns3/ipv6-address.h"
 #include "bcache.h"
+#include "mipv6-demux.h"
+#include "mipv6-tun-l4-protocol.h"
+#include "ns3/ipv6-l3-protocol.h"
+#include "ns3/icmpv6-l4-protocol.h"
 #include "ns3/traced-value.h"
 
 namespace ns3 {
@@ -80,6 +84,35 @@ public:
   void SendMessage (Ptr<Packet> packet, Ipv6Address dst, uint32_t ttl);
 
 protected:
+  /**
+   * \brief Bind the protocols of the node used by the agent, so that they
+   * are not looked up in the aggregates for every message.
+   */
+  virtual void NotifyNewAggregate ();
+
+  /**
+   * \brief Get the IPv6 protocol of the node.
+   * \return the IPv6 protocol
+   */
+  Ptr<Ipv6L3Protocol> GetIpv6 () const;
+
+  /**
+   * \brief Get the ICMPv6 protocol of the node.
+   * \return the ICMPv6 protocol
+   */
+  Ptr<Icmpv6L4Protocol> GetIcmpv6 () const;
+
+  /**
+   * \brief Get the mobility demultiplexer of the node.
+   * \return the mobility demultiplexer
+   */
+  Ptr<Mipv6Demux> GetMipv6Demux () const;
+
+  /**
+   * \brief Get the tunnel protocol of the node.
+   * \return the tunnel protocol, or 0 if the node has none
+   */
+  Ptr<Ipv6TunnelL4Protocol> GetTunnelProtocol () const;
 
   /**
    * \brief hanling packets if BU is received and calls the corresponding function inherited from this class.
@@ -152,6 +185,26 @@ private:
    */
   Ptr<Node> m_node;
 
+  /**
+   * \brief The IPv6 protocol.
+   */
+  Ptr<Ipv6L3Protocol> m_ipv6;
+
+  /**
+   * \brief The ICMPv6 protocol.
+   */
+  Ptr<Icmpv6L4Protocol> m_icmpv6;
+
+  /**
+   * \brief The mobility demultiplexer.
+   */
+  Ptr<Mipv6Demux> m_mipv6Demux;
+
+  /**
+   * \brief The tunnel protocol.
+   */
+  Ptr<Ipv6TunnelL4Protocol> m_tunnel;
+
   /**
    * \brief Trace source indicating a transmitted mobility handling packets by this agent 
    */
@@ -189,7 +189,7 @@ uint8_t Mipv6CN::HandleBU (Ptr<Packet> packet, const Ipv6Address &src, const Ipv
   Ipv6Address homeaddr;
   homeaddr = homopt.GetHomeAddress ();
 
-  Ptr<Mipv6Demux> ipv6MobilityDemux = GetNode ()->GetObject<Mipv6Demux> ();
+  Ptr<Mipv6Demux> ipv6MobilityDemux = GetMipv6Demux ();
   NS_ASSERT (ipv6MobilityDemux);
 
   Ptr<Mipv6Mobility> ipv6Mobility = ipv6MobilityDemux->GetMobility (bu.GetMhType ());
@@ -258,7 +258,7 @@ uint8_t Mipv6CN::HandleHoTI (Ptr<Packet> packet, const Ipv6Address &src, const I
   Ipv6Address homeaddr;
   homeaddr = homopt.GetHomeAddress ();
 
-  Ptr<Mipv6Demux> ipv6MobilityDemux = GetNode ()->GetObject<Mipv6Demux> ();
+  Ptr<Mipv6Demux> ipv6MobilityDemux = GetMipv6Demux ();
   NS_ASSERT (ipv6MobilityDemux);
 
   Ptr<Mipv6Mobility> ipv6Mobility = ipv6MobilityDemux->GetMobility (hoti.GetMhType ());
@@ -315,7 +315,7 @@ uint8_t Mipv6CN::HandleCoTI (Ptr<Packet> packet, const Ipv6Address &src, const I
   Ipv6Address homeaddr;
   homeaddr = homopt.GetHomeAddress ();
 
-  Ptr<Mipv6Demux> ipv6MobilityDemux = GetNode ()->GetObject<Mipv6Demux> ();
+  Ptr<Mipv6Demux> ipv6MobilityDemux = GetMipv6Demux ();
   NS_ASSERT (ipv6MobilityDemux);
 
   Ptr<Mipv6Mobility> ipv6Mobility = ipv6MobilityDemux->GetMobility (coti.GetMhType ());
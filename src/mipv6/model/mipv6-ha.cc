@@ -18,6 +18,7 @@
  * Author: Manoj Kumar Rana <manoj24.rana@gmail.com>
  */
 
+#include <set>
 #include "ns3/log.h"
 #include "ns3/assert.h"
 #include "ns3/packet.h"
@@ -31,11 +32,14 @@
 #include "ns3/callback.h"
 #include "ns3/ipv6-static-routing-helper.h"
 #include "ns3/ipv6-static-routing.h"
+#include "ns3/udp-l4-protocol.h"
+#include "ns3/tcp-l4-protocol.h"
 #include "mipv6-header.h"
 #include "mipv6-mobility.h"
 #include "mipv6-demux.h"
 #include "mipv6-l4-protocol.h"
 #include "mipv6-tun-l4-protocol.h"
+#include "tunnel-net-device.h"
 #include "mipv6-ha.h"
 #include "ns3/pointer.h"
 
@@ -57,6 +61,10 @@ Mipv6Ha::GetTypeId (void)
                    PointerValue (),
                    MakePointerAccessor (&Mipv6Ha::m_bCache),
                    MakePointerChecker<BCache> ())
+    .AddAttribute ("ProxyNdTable", "The home addresses defended by this agent on the home link.",
+                   PointerValue (),
+                   MakePointerAccessor (&Mipv6Ha::m_proxyNd),
+                   MakePointerChecker<ProxyNdTable> ())
     .AddTraceSource ("RxBU",
                      "Receive BU packet from MN",
                      MakeTraceSourceAccessor (&Mipv6Ha::m_rxbuTrace),
@@ -67,13 +75,15 @@ Mipv6Ha::GetTypeId (void)
 }
 
 Mipv6Ha::Mipv6Ha ()
-  : m_bCache (0)
+  : m_bCache (0),
+    m_proxyNd (0)
 {
 }
 
 Mipv6Ha::~Mipv6Ha ()
 {
   m_bCache = 0;
+  m_proxyNd = 0;
 }
 
 void Mipv6Ha::NotifyNewAggregate ()
@@ -82,15 +92,15 @@ void Mipv6Ha::NotifyNewAggregate ()
     {
       Ptr<Node> node = this->GetObject<Node> ();
       m_bCache = CreateObject<BCache> ();
+      m_proxyNd = CreateObject<ProxyNdTable> ();
 
       SetNode (node);
       m_bCache->SetNode (node);
+      m_proxyNd->SetNode (node);
       Ptr<Icmpv6L4Protocol> icmpv6l4 = node->GetObject<Icmpv6L4Protocol> ();
-      Ptr<Ipv6L3Protocol> ipv6 = node->GetObject<Ipv6L3Protocol> ();
       icmpv6l4->SetDADCallback (MakeCallback (&Mipv6Ha::DADFailureIndication, this));
       icmpv6l4->SetNSCallback (MakeCallback (&Mipv6Ha::IsAddress, this));
       icmpv6l4->SetHandleNSCallback (MakeCallback (&Mipv6Ha::HandleNS, this));
-      ipv6->SetNSCallback2 (MakeCallback (&Mipv6Ha::IsAddress2, this));
     }
 
   Mipv6Agent::NotifyNewAggregate ();
@@ -107,20 +117,11 @@ void Mipv6Ha::DADFailureIndication (Ipv6Address addr)
 
 bool Mipv6Ha::IsAddress (Ipv6Address addr)
 {
-  BCache::Entry *bce = m_bCache->Lookup (addr);
-  if (bce)
-    {
-      return true;
-    }
-  return false;
-}
-
-bool Mipv6Ha::IsAddress2 (Ipv6Address addr)
-{
-  return m_bCache->LookupSHoa (addr);
+  return m_proxyNd->IsDefended (addr);
 }
 
-Ptr<Packet> Mipv6Ha::BuildBA (Ipv6MobilityBindingUpdateHeader bu,Ipv6Address hoa, uint8_t status)
+Ptr<Packet> Mipv6Ha::BuildBA (Ipv6MobilityBindingUpdateHeader bu,Ipv6Address hoa, uint8_t status,
+                              const std::list<Ipv6MobilityOptionBindingIdentifierHeader> &bids)
 {
   NS_LOG_FUNCTION (this << status << "BUILD BACK");
 
@@ -135,6 +136,16 @@ Ptr<Packet> Mipv6Ha::BuildBA (Ipv6MobilityBindingUpdateHeader bu,Ipv6Address hoa
   ba.SetFlagK (true);
   ba.SetStatus (status);
   ba.SetLifetime ((uint16_t)Mipv6L4Protocol::MAX_BINDING_LIFETIME);
+
+  //echo the registered binding identifiers (RFC 5648)
+  for (std::list<Ipv6MobilityOptionBindingIdentifierHeader>::const_iterator it = bids.begin (); it != bids.end (); ++it)
+    {
+      Ipv6MobilityOptionBindingIdentifierHeader bid;
+      bid.SetBindingId (it->GetBindingId ());
+      bid.SetStatus (status);
+      ba.AddOption (bid);
+    }
+
   p->AddHeader (type2extn);
   p->AddHeader (ba);
 
@@ -171,13 +182,17 @@ uint8_t Mipv6Ha::HandleBU (Ptr<Packet> packet, const Ipv6Address &src, const Ipv
   Ipv6Address homeaddr;
   homeaddr = homopt.GetHomeAddress ();
 
-  Ptr<Mipv6Demux> ipv6MobilityDemux = GetNode ()->GetObject<Mipv6Demux> ();
+  Ptr<Mipv6Demux> ipv6MobilityDemux = GetMipv6Demux ();
   NS_ASSERT (ipv6MobilityDemux);
 
   Ptr<Mipv6Mobility> ipv6Mobility = ipv6MobilityDemux->GetMobility (bu.GetMhType ());
   NS_ASSERT (ipv6Mobility);
 
 
+  std::list<Ipv6MobilityOptionBindingIdentifierHeader> bids;
+  std::list<Ipv6MobilityOptionFlowIdentificationHeader> flows;
+  ParseMcoaOptions (bu, bids, flows);
+
   uint8_t errStatus = 0;
   BCache::Entry *bce = 0;
   BCache::Entry *bce2 = 0;
@@ -195,7 +210,7 @@ uint8_t Mipv6Ha::HandleBU (Ptr<Packet> packet, const Ipv6Address &src, const Ipv
 
 
   Ptr<Packet> ba;
-  ba = BuildBA (bu, homeaddr, errStatus);
+  ba = BuildBA (bu, homeaddr, errStatus, bids);
 
   bce = m_bCache->Lookup (homeaddr);
 
@@ -206,7 +221,60 @@ uint8_t Mipv6Ha::HandleBU (Ptr<Packet> packet, const Ipv6Address &src, const Ipv
           ClearTunnelAndRouting (bce);
           m_bCache->Remove (bce);
         }
-      free (bce2);
+      m_proxyNd->Remove (homeaddr, GetHomeInterface (dst, interface));
+      delete bce2;
+      if (bu.GetFlagA ())
+        {
+          SendMessage (ba, src, 64);
+        }
+      return 0;
+    }
+
+
+  if (bce && !bids.empty ())
+    {
+      //multiple care-of addresses: update the existing binding in place so
+      //that the other care-of addresses keep receiving traffic
+      delete bce2;
+      Ipv6Address primary = bce->GetCoa ();
+
+      UpdateMcoaBindings (bce, src, bu.GetLifetime (), bids, flows);
+      bce->SetLastBindingUpdateSequence (bu.GetSequence ());
+      bce->SetLastBindingUpdateTime (Time (bu.GetLifetime ()));
+
+      if (bce->GetNCoa () == 0)
+        {
+          ClearTunnelAndRouting (bce);
+          m_bCache->Remove (bce);
+          m_proxyNd->Remove (homeaddr, GetHomeInterface (dst, interface));
+        }
+      else
+        {
+          std::map<uint16_t, Ipv6Address> coas = bce->GetCoaList ();
+          bool primaryFound = false;
+          for (std::map<uint16_t, Ipv6Address>::iterator it = coas.begin (); it != coas.end (); ++it)
+            {
+              if (it->second == primary)
+                {
+                  primaryFound = true;
+                }
+            }
+          if (!primaryFound)
+            {
+              ClearTunnelAndRouting (bce);
+              bce->SetCoa (coas.begin ()->second);
+              SetupTunnelAndRouting (bce);
+            }
+          else
+            {
+              Ptr<TunnelNetDevice> tunnel = GetTunnelProtocol ()->GetTunnelDevice (primary);
+              if (tunnel)
+                {
+                  tunnel->SetRemoteSelector (MakeCallback (&Mipv6Ha::SelectTunnelRemote, this));
+                }
+            }
+        }
+
       if (bu.GetFlagA ())
         {
           SendMessage (ba, src, 64);
@@ -214,6 +282,7 @@ uint8_t Mipv6Ha::HandleBU (Ptr<Packet> packet, const Ipv6Address &src, const Ipv
       return 0;
     }
 
+  UpdateMcoaBindings (bce2, src, bu.GetLifetime (), bids, flows);
 
   if (bce)
     {
@@ -224,6 +293,7 @@ uint8_t Mipv6Ha::HandleBU (Ptr<Packet> packet, const Ipv6Address &src, const Ipv
 
 
       m_bCache->Add (bce2);
+      m_proxyNd->Add (homeaddr, dst, GetHomeInterface (dst, interface));
 
       if (bu.GetFlagA ())
         {
@@ -241,6 +311,7 @@ uint8_t Mipv6Ha::HandleBU (Ptr<Packet> packet, const Ipv6Address &src, const Ipv
       if (bu.GetFlagA ())
         {
           m_bCache->Add (bce2);
+          m_proxyNd->Add (homeaddr, dst, GetHomeInterface (dst, interface));
           Simulator::Schedule (Seconds (0.), &Mipv6Ha::DoDADForOffLinkAddress, this, homeaddr, interface);
           Simulator::Schedule (Seconds (1.), &Mipv6Ha::FunctionDadTimeoutForOffLinkAddress, this, interface, ba, homeaddr);
         }
@@ -251,12 +322,166 @@ uint8_t Mipv6Ha::HandleBU (Ptr<Packet> packet, const Ipv6Address &src, const Ipv
 
 }
 
+void Mipv6Ha::ParseMcoaOptions (Ipv6MobilityBindingUpdateHeader bu,
+                                std::list<Ipv6MobilityOptionBindingIdentifierHeader> &bids,
+                                std::list<Ipv6MobilityOptionFlowIdentificationHeader> &flows)
+{
+  NS_LOG_FUNCTION (this);
+
+  Buffer buf = bu.GetOptionBuffer ();
+  Buffer::Iterator start = buf.Begin ();
+  uint32_t offset = 0;
+
+  while (offset < buf.GetSize ())
+    {
+      uint8_t type = start.PeekU8 ();
+      uint32_t len = 1;
+
+      if (type != Mipv6Header::IPV6_MOBILITY_OPT_PAD1)
+        {
+          if (offset + 2 > buf.GetSize ())
+            {
+              break;
+            }
+          Buffer::Iterator tmp = start;
+          tmp.Next ();
+          len = tmp.ReadU8 () + 2;
+          if (offset + len > buf.GetSize ())
+            {
+              break;
+            }
+        }
+
+      if (type == Mipv6Header::IPV6_MOBILITY_OPT_BINDING_IDENTIFIER)
+        {
+          Ipv6MobilityOptionBindingIdentifierHeader bid;
+          bid.Deserialize (start);
+          bids.push_back (bid);
+        }
+      else if (type == Mipv6Header::IPV6_MOBILITY_OPT_FLOW_IDENTIFICATION)
+        {
+          Ipv6MobilityOptionFlowIdentificationHeader flow;
+          flow.Deserialize (start);
+          flows.push_back (flow);
+        }
+
+      start.Next (len);
+      offset += len;
+    }
+}
+
+void Mipv6Ha::UpdateMcoaBindings (BCache::Entry *bce, Ipv6Address src, uint16_t lifetime,
+                                  const std::list<Ipv6MobilityOptionBindingIdentifierHeader> &bids,
+                                  const std::list<Ipv6MobilityOptionFlowIdentificationHeader> &flows)
+{
+  NS_LOG_FUNCTION (this << bce << src << lifetime);
+
+  bool overwrite = false;
+  std::set<uint16_t> listed;
+  for (std::list<Ipv6MobilityOptionBindingIdentifierHeader>::const_iterator it = bids.begin (); it != bids.end (); ++it)
+    {
+      overwrite = overwrite || it->GetFlagO ();
+      listed.insert (it->GetBindingId ());
+    }
+  if (overwrite)
+    {
+      //bulk registration, the care-of addresses not listed are stale
+      std::map<uint16_t, Ipv6Address> coas = bce->GetCoaList ();
+      for (std::map<uint16_t, Ipv6Address>::iterator it = coas.begin (); it != coas.end (); ++it)
+        {
+          if (listed.find (it->first) == listed.end ())
+            {
+              bce->RemoveCoa (it->first);
+            }
+        }
+    }
+
+  for (std::list<Ipv6MobilityOptionBindingIdentifierHeader>::const_iterator it = bids.begin (); it != bids.end (); ++it)
+    {
+      if (lifetime == 0)
+        {
+          bce->RemoveCoa (it->GetBindingId ());
+          continue;
+        }
+
+      Ipv6Address coa = it->GetCareofAddress ();
+      if (coa.IsAny ())
+        {
+          coa = src;
+        }
+      bce->AddCoa (it->GetBindingId (), coa);
+    }
+
+  for (std::list<Ipv6MobilityOptionFlowIdentificationHeader>::const_iterator it = flows.begin (); it != flows.end (); ++it)
+    {
+      if (lifetime == 0 || it->GetAction () == Ipv6MobilityOptionFlowIdentificationHeader::FLOW_ACTION_DISCARD)
+        {
+          bce->RemoveFlowBinding (it->GetFlowId ());
+          continue;
+        }
+
+      BCache::Entry::FlowBinding flow;
+      flow.fid = it->GetFlowId ();
+      flow.priority = it->GetPriority ();
+      flow.bid = it->GetBindingId ();
+      flow.protocol = it->GetProtocol ();
+      flow.portLow = it->GetDestinationPortLow ();
+      flow.portHigh = it->GetDestinationPortHigh ();
+      bce->AddFlowBinding (flow);
+    }
+}
+
+Ipv6Address Mipv6Ha::SelectTunnelRemote (Ptr<const Packet> packet)
+{
+  NS_LOG_FUNCTION (this << packet);
+
+  Ipv6Header iph;
+  packet->PeekHeader (iph);
+
+  BCache::Entry *bce = m_bCache->Lookup (iph.GetDestinationAddress ());
+  if (bce == 0 || !bce->HasFlowBindings ())
+    {
+      return Ipv6Address::GetAny ();
+    }
+
+  uint8_t protocol = iph.GetNextHeader ();
+  if (protocol != UdpL4Protocol::PROT_NUMBER && protocol != TcpL4Protocol::PROT_NUMBER)
+    {
+      return Ipv6Address::GetAny ();
+    }
+
+  //both UDP and TCP carry the destination port at offset 2
+  uint32_t hdrSize = iph.GetSerializedSize ();
+  if (packet->GetSize () < hdrSize + 4)
+    {
+      return Ipv6Address::GetAny ();
+    }
+  uint8_t buf[44];
+  packet->CopyData (buf, hdrSize + 4);
+  uint16_t port = (buf[hdrSize + 2] << 8) | buf[hdrSize + 3];
+
+  return bce->LookupFlow (protocol, port);
+}
+
+uint32_t Mipv6Ha::GetHomeInterface (Ipv6Address haa, Ptr<Ipv6Interface> interface)
+{
+  NS_LOG_FUNCTION (this << haa << interface);
+  Ptr<Ipv6L3Protocol> ipv6 = GetIpv6 ();
+
+  int32_t index = ipv6->GetInterfaceForAddress (haa);
+  if (index < 0)
+    {
+      index = ipv6->GetInterfaceForDevice (interface->GetDevice ());
+    }
+  return index;
+}
+
 std::list<Ipv6Address> Mipv6Ha::HomeAgentAddressList ()
 {
   NS_LOG_FUNCTION (this);
   std::list<Ipv6Address> HaaList;
   uint32_t ndevices = GetNode ()->GetNDevices ();
-  Ptr<Ipv6L3Protocol> ipv6proto = GetNode ()->GetObject<Ipv6L3Protocol> ();
+  Ptr<Ipv6L3Protocol> ipv6proto = GetIpv6 ();
   Ipv6InterfaceAddress ipv6Addr;
   Ipv6Address addr;
   for (uint32_t i = 0; i < ndevices; i++)
@@ -281,16 +506,21 @@ bool Mipv6Ha::SetupTunnelAndRouting (BCache::Entry *bce)
   NS_LOG_FUNCTION (this << bce);
 
   //create tunnel
-  Ptr<Ipv6TunnelL4Protocol> th = GetNode ()->GetObject<Ipv6TunnelL4Protocol> ();
+  Ptr<Ipv6TunnelL4Protocol> th = GetTunnelProtocol ();
   NS_ASSERT (th);
 
   uint16_t tunnelIf = th->AddTunnel (bce->GetCoa ());
 
   bce->SetTunnelIfIndex (tunnelIf);
 
+  if (bce->GetNCoa () > 0)
+    {
+      th->GetTunnelDevice (bce->GetCoa ())->SetRemoteSelector (MakeCallback (&Mipv6Ha::SelectTunnelRemote, this));
+    }
+
   //routing setup by static routing protocol
   Ipv6StaticRoutingHelper staticRoutingHelper;
-  Ptr<Ipv6> ipv6 = GetNode ()->GetObject<Ipv6> ();
+  Ptr<Ipv6> ipv6 = GetIpv6 ();
 
   Ptr<Ipv6StaticRouting> staticRouting = staticRoutingHelper.GetStaticRouting (ipv6);
 
@@ -307,7 +537,7 @@ bool Mipv6Ha::ClearTunnelAndRouting (BCache::Entry *bce)
 
   //routing setup by static routing protocol
   Ipv6StaticRoutingHelper staticRoutingHelper;
-  Ptr<Ipv6> ipv6 = GetNode ()->GetObject<Ipv6> ();
+  Ptr<Ipv6> ipv6 = GetIpv6 ();
 
 
   Ptr<Ipv6StaticRouting> staticRouting = staticRoutingHelper.GetStaticRouting (ipv6);
@@ -315,9 +545,14 @@ bool Mipv6Ha::ClearTunnelAndRouting (BCache::Entry *bce)
   staticRouting->RemoveRoute (bce->GetHoa (), Ipv6Prefix (64), bce->GetTunnelIfIndex (), bce->GetHoa ());
 
   //create tunnel
-  Ptr<Ipv6TunnelL4Protocol> th = GetNode ()->GetObject<Ipv6TunnelL4Protocol> ();
+  Ptr<Ipv6TunnelL4Protocol> th = GetTunnelProtocol ();
   NS_ASSERT (th);
 
+  Ptr<TunnelNetDevice> tunnel = th->GetTunnelDevice (bce->GetCoa ());
+  if (tunnel)
+    {
+      tunnel->SetRemoteSelector (MakeNullCallback<Ipv6Address, Ptr<const Packet> > ());
+    }
   th->RemoveTunnel (bce->GetCoa ());
 
   bce->SetTunnelIfIndex (-1);
@@ -328,8 +563,8 @@ void Mipv6Ha::DoDADForOffLinkAddress (Ipv6Address target, Ptr<Ipv6Interface> int
 {
   NS_LOG_FUNCTION (this << target << interface);
   Ipv6Address addr;
-  Ptr<Ipv6L3Protocol> ipv6 = GetNode ()->GetObject<Ipv6L3Protocol> ();
-  Ptr<Icmpv6L4Protocol> icmp = GetNode ()->GetObject<Icmpv6L4Protocol> ();
+  Ptr<Ipv6L3Protocol> ipv6 = GetIpv6 ();
+  Ptr<Icmpv6L4Protocol> icmp = GetIcmpv6 ();
 
   NS_ASSERT (ipv6);
 
@@ -338,25 +573,43 @@ void Mipv6Ha::DoDADForOffLinkAddress (Ipv6Address target, Ptr<Ipv6Interface> int
 
   NdiscCache::Ipv6PayloadHeaderPair p = icmp->ForgeNS ("::",Ipv6Address::MakeSolicitedAddress (target), target, interface->GetDevice ()->GetAddress ());
 
-  /* update last packet UID */
-  interface->SetNsDadUid (target, p.first->GetUid ());
+  /* update last packet UID, so that our own probe is not answered */
+  ProxyNdTable::Entry *entry = m_proxyNd->Lookup (target, ipv6->GetInterfaceForDevice (interface->GetDevice ()));
+  if (entry)
+    {
+      entry->SetNsDadUid (p.first->GetUid ());
+    }
   Simulator::Schedule (Time (0), &Ipv6Interface::Send, interface, p.first, p.second, Ipv6Address::MakeSolicitedAddress (target));
 }
 
 void Mipv6Ha::FunctionDadTimeoutForOffLinkAddress (Ptr<Ipv6Interface> interface, Ptr<Packet> ba, Ipv6Address homeaddr)
 {
-  if (m_bCache->Lookup (homeaddr)->GetState () != BCache::Entry::INVALID)
+  BCache::Entry *bce = m_bCache->Lookup (homeaddr);
+  if (!bce)
     {
-      SendMessage (ba, m_bCache->Lookup (homeaddr)->GetCoa (), 64);
+      /* the binding was removed while DAD was running */
+      return;
     }
-  SetupTunnelAndRouting (m_bCache->Lookup (homeaddr));
+  if (bce->GetState () != BCache::Entry::INVALID)
+    {
+      SendMessage (ba, bce->GetCoa (), 64);
+    }
+  SetupTunnelAndRouting (bce);
 }
 
 void Mipv6Ha::HandleNS (Ptr<Packet> packet, Ptr<Ipv6Interface> interface, Ipv6Address src, Ipv6Address target)
 {
-  Ipv6InterfaceAddress ifaddr (target);
+  NS_LOG_FUNCTION (this << packet << interface << src << target);
 
-  if (packet->GetUid () == ifaddr.GetNsDadUid ())
+  Ptr<Ipv6L3Protocol> ipv6 = GetIpv6 ();
+  ProxyNdTable::Entry *entry = m_proxyNd->Lookup (target, ipv6->GetInterfaceForDevice (interface->GetDevice ()));
+  if (!entry)
+    {
+      NS_LOG_LOGIC ("Not a NS for a defended address");
+      return;
+    }
+
+  if (packet->GetUid () == entry->GetNsDadUid ())
     {
       /* don't process our own DAD probe */
       NS_LOG_LOGIC ("Hey we receive our DAD probe!");
@@ -364,11 +617,9 @@ void Mipv6Ha::HandleNS (Ptr<Packet> packet, Ptr<Ipv6Interface> interface, Ipv6Ad
     }
 
   Icmpv6OptionLinkLayerAddress lla (1);
-  Address hardwareAddress;
-  NdiscCache::Entry* entry = 0;
-  Ptr<Icmpv6L4Protocol> icmp = GetNode ()->GetObject<Icmpv6L4Protocol> ();
+  NdiscCache::Entry* cacheEntry = 0;
+  Ptr<Icmpv6L4Protocol> icmp = GetIcmpv6 ();
   Ptr<NdiscCache> cache = icmp->GetCache (interface->GetDevice ());
-  uint8_t flags = 0;
 
   /* XXX search all options following the NS header */
 
@@ -385,79 +636,25 @@ void Mipv6Ha::HandleNS (Ptr<Packet> packet, Ptr<Ipv6Interface> interface, Ipv6Ad
       /* Get LLA */
       packet->RemoveHeader (lla);
 
-      entry = cache->Lookup (src);
+      cacheEntry = cache->Lookup (src);
 
-      if (!entry)
+      if (!cacheEntry)
         {
-          entry = cache->Add (src);
-          entry->SetRouter (false);
-          entry->MarkStale (lla.GetAddress ());
+          cacheEntry = cache->Add (src);
+          cacheEntry->SetRouter (false);
+          cacheEntry->MarkStale (lla.GetAddress ());
         }
-      else if (entry->GetMacAddress () != lla.GetAddress ())
+      else if (cacheEntry->GetMacAddress () != lla.GetAddress ())
         {
-          entry->MarkStale (lla.GetAddress ());
+          cacheEntry->MarkStale (lla.GetAddress ());
         }
-
-      flags = 3; /* S + O flags */
-    }
-  else
-    {
-      /* it means someone do a DAD */
-      flags = 1; /* O flag */
-    }
-
-  /* send a NA to src */
-  Ptr<Ipv6L3Protocol> ipv6 = GetNode ()->GetObject<Ipv6L3Protocol> ();
-
-  if (ipv6->IsForwarding (ipv6->GetInterfaceForDevice (interface->GetDevice ())))
-    {
-      flags += 4; /* R flag */
-    }
-
-  hardwareAddress = interface->GetDevice ()->GetAddress ();
-  BCache::Entry *bce = m_bCache->Lookup (target);
-
-
-
-
-
-
-  Ptr<Packet> p = Create<Packet> ();
-  Ipv6Header ipHeader;
-  Icmpv6NA na;
-  Icmpv6OptionLinkLayerAddress llOption (0, hardwareAddress);  /* we give our mac address in response */
-
-
-  /* forge the entire NA packet from IPv6 header to ICMPv6 link-layer option, so that the packet does not pass by Icmpv6L4Protocol::Lookup again */
-
-  p->AddHeader (llOption);
-  na.SetIpv6Target (target);
-
-  if ((flags & 1))
-    {
-      na.SetFlagO (true);
-    }
-  if ((flags & 2) && bce->GetHA () != Ipv6Address::GetAny ())
-    {
-      na.SetFlagS (true);
     }
-  if ((flags & 4))
-    {
-      na.SetFlagR (true);
-    }
-
-  na.CalculatePseudoHeaderChecksum (bce->GetHA (), src, p->GetSize () + na.GetSerializedSize (), Icmpv6L4Protocol::PROT_NUMBER);
-  p->AddHeader (na);
-
-  ipHeader.SetSourceAddress (bce->GetHA ());
-  ipHeader.SetDestinationAddress (src);
-  ipHeader.SetNextHeader (Icmpv6L4Protocol::PROT_NUMBER);
-  ipHeader.SetPayloadLength (p->GetSize ());
-  ipHeader.SetHopLimit (255);
-  NdiscCache::Ipv6PayloadHeaderPair pi (p, ipHeader);
-  interface->Send (pi.first, pi.second, src.IsAny () ? Ipv6Address::GetAllNodesMulticast () : src);
 
-  /* not a NS for us discard it */
+  /* send a NA to src, or to all nodes if someone does a DAD;
+     the packet is fully forged so that it does not pass by Icmpv6L4Protocol::Lookup again */
+  Ipv6Address dst = src.IsAny () ? Ipv6Address::GetAllNodesMulticast () : src;
+  NdiscCache::Ipv6PayloadHeaderPair pi = entry->ForgeNA (dst, !src.IsAny ());
+  interface->Send (pi.first, pi.second, dst);
 }
 
 } /* namespace ns3 */
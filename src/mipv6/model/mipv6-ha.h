@@ -23,13 +23,19 @@
 
 #include "mipv6-agent.h"
 #include "bcache.h"
+#include "proxy-nd-table.h"
 #include "mipv6-header.h"
 
+class McoaOptionTestCase;
+
 namespace ns3 {
 class Packet;
 
 class Mipv6Ha : public Mipv6Agent
 {
+  /// allow McoaOptionTestCase access
+  friend class ::McoaOptionTestCase;
+
 public:
   /**
    * \brief The interface ID.
@@ -73,19 +79,12 @@ public:
   void DADFailureIndication (Ipv6Address addr);
 
   /**
-   * \brief lookup for home address of MN
+   * \brief lookup for home address of MN in the proxy ND table
    * \param addr home address
    * \returns status
    */
   bool IsAddress (Ipv6Address addr);
 
-  /**
-   * \brief lookup for solicited home address of MN
-   * \param addr home address
-   * \returns status
-   */
-  bool IsAddress2 (Ipv6Address addr);
-
   /**
    * \brief handle NS during DAD
    * \param packet the NS packet
@@ -114,9 +113,11 @@ protected:
    * \param bu the BU packet
    * \param hoa the home address
    * \param status the staus of BU reception
+   * \param bids the binding identifier options of the BU, echoed in the BA
    * \return a ba packet
    */
-  Ptr<Packet> BuildBA (Ipv6MobilityBindingUpdateHeader bu, Ipv6Address hoa, uint8_t status);
+  Ptr<Packet> BuildBA (Ipv6MobilityBindingUpdateHeader bu, Ipv6Address hoa, uint8_t status,
+                       const std::list<Ipv6MobilityOptionBindingIdentifierHeader> &bids);
 
   /**
    * \brief handle BU
@@ -142,6 +143,46 @@ protected:
    */
   bool ClearTunnelAndRouting (BCache::Entry *bce);
 
+  /**
+   * \brief collect the binding identifier and flow identification options of a BU
+   * \param bu the BU header
+   * \param bids list filled with binding identifier options
+   * \param flows list filled with flow identification options
+   */
+  void ParseMcoaOptions (Ipv6MobilityBindingUpdateHeader bu,
+                         std::list<Ipv6MobilityOptionBindingIdentifierHeader> &bids,
+                         std::list<Ipv6MobilityOptionFlowIdentificationHeader> &flows);
+
+  /**
+   * \brief register the care-of addresses and flow bindings of a BU in a bcache entry
+   *
+   * A binding identifier with the overwrite (O) flag replaces the
+   * care-of addresses of the entry with the ones of the BU (RFC 5648).
+   * \param bce BCache entry
+   * \param src the source address of the BU
+   * \param lifetime the lifetime of the BU
+   * \param bids binding identifier options
+   * \param flows flow identification options
+   */
+  void UpdateMcoaBindings (BCache::Entry *bce, Ipv6Address src, uint16_t lifetime,
+                           const std::list<Ipv6MobilityOptionBindingIdentifierHeader> &bids,
+                           const std::list<Ipv6MobilityOptionFlowIdentificationHeader> &flows);
+
+  /**
+   * \brief select the tunnel remote address of a packet from the flow bindings
+   * \param packet the packet to be tunnelled
+   * \return the care-of address the packet flow is bound to, or any address
+   */
+  Ipv6Address SelectTunnelRemote (Ptr<const Packet> packet);
+
+  /**
+   * \brief get the home link interface for a binding
+   * \param haa the HA address the BU was sent to
+   * \param interface the interface at which the BU is received
+   * \return the interface index
+   */
+  uint32_t GetHomeInterface (Ipv6Address haa, Ptr<Ipv6Interface> interface);
+
 
 private:
   /**
@@ -149,6 +190,11 @@ private:
    */
   Ptr<BCache> m_bCache;
 
+  /**
+   * \brief the home addresses defended on the home link.
+   */
+  Ptr<ProxyNdTable> m_proxyNd;
+
   /**
    * \brief Callback to trace RX (reception) bu packets.
    */ 
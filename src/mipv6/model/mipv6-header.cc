@@ -152,11 +152,19 @@ Mipv6OptionField::~Mipv6OptionField ()
 
 uint32_t Mipv6OptionField::GetSerializedSize () const
 {
+  if (m_optionData.GetSize () == 0)
+    {
+      return 0;
+    }
   return m_optionData.GetSize () + CalculatePad ((Mipv6OptionHeader::Alignment) {8,0});
 }
 
 void Mipv6OptionField::Serialize (Buffer::Iterator start) const
 {
+  if (m_optionData.GetSize () == 0)
+    {
+      return;
+    }
   start.Write (m_optionData.Begin (), m_optionData.End ());
   uint32_t fill = CalculatePad ((Mipv6OptionHeader::Alignment) {8,0});
 
@@ -341,7 +349,7 @@ void Ipv6MobilityBindingUpdateHeader::Print (std::ostream& os) const
 
 uint32_t Ipv6MobilityBindingUpdateHeader::GetSerializedSize () const
 {
-  return 12;
+  return 12 + Mipv6OptionField::GetSerializedSize ();
 }
 
 void Ipv6MobilityBindingUpdateHeader::Serialize (Buffer::Iterator start) const
@@ -382,6 +390,7 @@ void Ipv6MobilityBindingUpdateHeader::Serialize (Buffer::Iterator start) const
   i.WriteHtonU16 (reserved2);
   i.WriteHtonU16 (m_lifetime);
 
+  Mipv6OptionField::Serialize (i);
 }
 
 uint32_t Ipv6MobilityBindingUpdateHeader::Deserialize (Buffer::Iterator start)
@@ -426,6 +435,12 @@ uint32_t Ipv6MobilityBindingUpdateHeader::Deserialize (Buffer::Iterator start)
 
   m_lifetime = i.ReadNtohU16 ();
 
+  uint32_t length = (GetHeaderLen () + 1) << 3;
+  if (length > 12)
+    {
+      Mipv6OptionField::Deserialize (i, length - 12);
+    }
+
   return GetSerializedSize ();
 }
 
@@ -522,7 +537,7 @@ void Ipv6MobilityBindingAckHeader::Print (std::ostream& os) const
 
 uint32_t Ipv6MobilityBindingAckHeader::GetSerializedSize () const
 {
-  return 12;
+  return 12 + Mipv6OptionField::GetSerializedSize ();
 }
 
 void Ipv6MobilityBindingAckHeader::Serialize (Buffer::Iterator start) const
@@ -548,7 +563,7 @@ void Ipv6MobilityBindingAckHeader::Serialize (Buffer::Iterator start) const
   i.WriteHtonU16 (m_sequence);
   i.WriteHtonU16 (m_lifetime);
 
-
+  Mipv6OptionField::Serialize (i);
 }
 
 uint32_t Ipv6MobilityBindingAckHeader::Deserialize (Buffer::Iterator start)
@@ -574,6 +589,13 @@ uint32_t Ipv6MobilityBindingAckHeader::Deserialize (Buffer::Iterator start)
 
   m_sequence = i.ReadNtohU16 ();
   m_lifetime = i.ReadNtohU16 ();
+
+  uint32_t length = (GetHeaderLen () + 1) << 3;
+  if (length > 12)
+    {
+      Mipv6OptionField::Deserialize (i, length - 12);
+    }
+
   return GetSerializedSize ();
 }
 
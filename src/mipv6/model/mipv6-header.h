@@ -88,8 +88,9 @@ public:
     IPV6_MOBILITY_OPT_BINDING_REFRESH_ADVICE,
     IPV6_MOBILITY_OPT_ALTERNATE_CARE_OF_ADDRESS,
     IPV6_MOBILITY_OPT_NONCE_INDICES,
-    IPV6_MOBILITY_OPT_BINDING_AUTHORIZATION_DATA
-
+    IPV6_MOBILITY_OPT_BINDING_AUTHORIZATION_DATA,
+    IPV6_MOBILITY_OPT_BINDING_IDENTIFIER = 35,
+    IPV6_MOBILITY_OPT_FLOW_IDENTIFICATION = 36
 
   };
   /**
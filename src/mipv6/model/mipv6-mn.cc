@@ -22,6 +22,7 @@
 #include "ns3/assert.h"
 #include "ns3/packet.h"
 #include "ns3/node.h"
+#include "ns3/simulator.h"
 #include "ns3/ipv6.h"
 #include "ns3/ipv6-l3-protocol.h"
 #include "ns3/ipv6-interface.h"
@@ -39,9 +40,12 @@
 #include "mipv6-l4-protocol.h"
 #include "mipv6-mn.h"
 #include "mipv6-tun-l4-protocol.h"
+#include "mih-link-adapter.h"
 #include "ns3/udp-l4-protocol.h"
 #include "ns3/tcp-l4-protocol.h"
 #include "ns3/pointer.h"
+#include "ns3/boolean.h"
+#include "ns3/double.h"
 #include "ns3/trace-source-accessor.h"
 
 
@@ -62,6 +66,17 @@ Mipv6Mn::GetTypeId (void)
                    PointerValue (),
                    MakePointerAccessor (&Mipv6Mn::m_buinf),
                    MakePointerChecker<BList> ())
+    .AddAttribute ("EnableMcoa", "Register all care-of addresses with binding identifiers (RFC 5648).",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&Mipv6Mn::m_mcoa),
+                   MakeBooleanChecker ())
+    .AddAttribute ("HandbackMargin",
+                   "How much more margin above its going down threshold the signal "
+                   "of another link must have than the link of the CoA, for the MN "
+                   "to move to it on a Link_Parameters_Report.",
+                   DoubleValue (6.0),
+                   MakeDoubleAccessor (&Mipv6Mn::m_handbackMargin),
+                   MakeDoubleChecker<double> (0.0))
     .AddTraceSource ("RxBA",
                      "Received BA packet from HA",
                      MakeTraceSourceAccessor (&Mipv6Mn::m_rxbaTrace),
@@ -70,6 +85,14 @@ Mipv6Mn::GetTypeId (void)
                      "Sent BU packet from MN",
                      MakeTraceSourceAccessor (&Mipv6Mn::m_txbuTrace),
                      "ns3::Mipv6Mn::TxBuTracedCallback")
+    .AddTraceSource ("RxRA",
+                     "Received RA with a new prefix",
+                     MakeTraceSourceAccessor (&Mipv6Mn::m_rxraTrace),
+                     "ns3::Mipv6Mn::RxRaTracedCallback")
+    .AddTraceSource ("NewCoA",
+                     "New CoA configured, before the BU is sent",
+                     MakeTraceSourceAccessor (&Mipv6Mn::m_newCoaTrace),
+                     "ns3::Mipv6Mn::NewCoaTracedCallback")
 
 
     ;
@@ -82,6 +105,8 @@ Mipv6Mn::Mipv6Mn (std::list<Ipv6Address> haalist)
   m_hsequence = 0;
   m_cnsequence = 0;
   m_roflag = false;
+  m_mcoa = false;
+  m_handbackMargin = 6.0;
 }
 
 Mipv6Mn::~Mipv6Mn ()
@@ -93,9 +118,6 @@ void Mipv6Mn::NotifyNewAggregate ()
 {
   NS_LOG_FUNCTION (this);
 
-  uint8_t buf1[8],buf2[16],buf[16];
-  uint8_t i;
-
   if (GetNode () == 0)
     {
       Ptr<Node> node = this->GetObject<Node> ();
@@ -114,17 +136,8 @@ void Mipv6Mn::NotifyNewAggregate ()
       if (m_Haalist.size ())
         {
           m_buinf->SetHA (m_Haalist.front ()); // The first address
-          (m_buinf->GetHA ()).GetBytes (buf1); //Fetching Prefix
-          (ads.GetAddress ()).GetBytes (buf2); //Fetching interface identifier
-          for (i = 0; i < 8; i++)
-            {
-              buf[i] = buf1[i];
-            }
-          for (i = 0; i < 8; i++)
-            {
-              buf[i + 8] = buf2[i + 8];
-            }
-          Ipv6Address addr (buf);
+          // prefix of the HA, interface identifier of the link-local address
+          Ipv6Address addr = m_buinf->GetHA ().CombineInterfaceId (ads.GetAddress (), Ipv6Prefix (64));
           m_buinf->SetHoa (addr);
           Ptr<Ipv6TunnelL4Protocol> tunnel4prot = GetNode ()->GetObject<Ipv6TunnelL4Protocol> ();
           tunnel4prot->SetHomeAddress (addr);
@@ -142,11 +155,12 @@ void Mipv6Mn::NotifyNewAggregate ()
 
 
       Ptr<Icmpv6L4Protocol> icmpv6l4 = GetNode ()->GetObject<Icmpv6L4Protocol> ();
-      icmpv6l4->SetNewIPCallback (MakeCallback (&Mipv6Mn::HandleNewAttachment, this));
+      icmpv6l4->SetNewIPCallback (MakeCallback (&Mipv6Mn::HandleNewAddress, this));
       icmpv6l4->SetCheckAddressCallback (MakeCallback (&Mipv6Mn::CheckAddresses, this));
 
       Ptr<Ipv6L3Protocol> ipv6l3 = GetNode ()->GetObject<Ipv6L3Protocol> ();
       ipv6l3->SetPrefixCallback (MakeCallback (&Mipv6Mn::SetDefaultRouterAddress, this));
+      ipv6l3->SetAddressRemovedCallback (MakeCallback (&Mipv6Mn::HandleAddressRemoved, this));
 
       Ptr<UdpL4Protocol> udpl4 = GetNode ()->GetObject<UdpL4Protocol> ();
       udpl4->SetMipv6Callback (MakeCallback (&BList::GetHoa, m_buinf));
@@ -158,9 +172,25 @@ void Mipv6Mn::NotifyNewAggregate ()
       tunnell4->SetCacheAddressList (m_Haalist);
       tunnell4->SetHA (m_buinf->GetHA ());
     }
+
+  if (m_mih == 0 && GetNode () != 0)
+    {
+      m_mih = GetNode ()->GetObject<MihFunction> ();
+      if (m_mih != 0)
+        {
+          m_mih->TraceConnectWithoutContext ("LinkEvent", MakeCallback (&Mipv6Mn::HandleLinkEvent, this));
+        }
+    }
   Mipv6Agent::NotifyNewAggregate ();
 }
 
+void Mipv6Mn::DoDispose ()
+{
+  NS_LOG_FUNCTION (this);
+  m_mih = 0;
+  Mipv6Agent::DoDispose ();
+}
+
 
 uint16_t Mipv6Mn::GetHomeBUSequence ()
 {
@@ -205,6 +235,24 @@ Ptr<Packet> Mipv6Mn::BuildHomeBU ()
 
   bu.SetLifetime ((uint16_t)Mipv6L4Protocol::MAX_BINDING_LIFETIME);
 
+  if (m_mcoa)
+    {
+      std::map<uint16_t, Ipv6Address> coas = m_buinf->GetCoaList ();
+      for (std::map<uint16_t, Ipv6Address>::iterator it = coas.begin (); it != coas.end (); ++it)
+        {
+          Ipv6MobilityOptionBindingIdentifierHeader bid;
+          bid.SetBindingId (it->first);
+          bid.SetCareofAddress (it->second);
+          //the list is complete, the HA drops the CoAs not listed
+          bid.SetFlagO (true);
+          bu.AddOption (bid);
+        }
+      for (std::list<Ipv6MobilityOptionFlowIdentificationHeader>::iterator it = m_flows.begin (); it != m_flows.end (); ++it)
+        {
+          bu.AddOption (*it);
+        }
+    }
+
   p->AddHeader (bu);
 
   return p;
@@ -304,47 +352,72 @@ void Mipv6Mn::HandleNewAttachment (Ipv6Address ipr)
   if (!ipr.IsLinkLocal () )// && !ipr.IsEqual(m_buinf->GetHoa()))
     {
       Ipv6Address coa = ipr;
-      m_buinf->SetCoa (coa);
-
-      ClearTunnelAndRouting ();
-      Ptr<Ipv6> ipv6 = GetNode ()->GetObject<Ipv6> ();
+      Ptr<Ipv6> ipv6 = GetIpv6 ();
       NS_ASSERT (ipv6);
 
+      m_newCoaTrace (coa);
 
-      //preset header information
-      m_buinf->SetHomeLastBindingUpdateSequence (GetHomeBUSequence ());
-      //Cut to micro-seconds
-      m_buinf->SetHomeLastBindingUpdateTime (MicroSeconds (Simulator::Now ().GetMicroSeconds ()));
-      //reset (for the first registration)
-      m_buinf->ResetHomeRetryCount ();
+      if (m_mcoa)
+        {
+          int32_t bid = ipv6->GetInterfaceForAddress (coa);
+          if (bid < 0)
+            {
+              NS_LOG_LOGIC ("No interface has the CoA " << coa << ", not registered");
+              return;
+            }
+          //keep the established tunnel, the new CoA is added as another binding
+          m_buinf->AddCoa (bid, coa);
+          if (m_buinf->GetTunnelIfIndex () < 0)
+            {
+              m_buinf->SetCoa (coa);
+            }
+        }
+      else
+        {
+          m_buinf->SetCoa (coa);
+          ClearTunnelAndRouting ();
+        }
 
-      Ptr<Packet> p = BuildHomeBU ();
+      SendHomeBU ();
+    }
+}
 
-      //save packet
-      m_buinf->SetHomeBUPacket (p);
+void Mipv6Mn::SendHomeBU ()
+{
+  NS_LOG_FUNCTION (this);
 
+  //a BU of a previous CoA may be pending, this one supersedes it
+  m_buinf->StopHomeRetransTimer ();
 
-      //send BU
-      NS_LOG_FUNCTION (this << p->GetSize ());
-      
+  //preset header information
+  m_buinf->SetHomeLastBindingUpdateSequence (GetHomeBUSequence ());
+  //Cut to micro-seconds
+  m_buinf->SetHomeLastBindingUpdateTime (MicroSeconds (Simulator::Now ().GetMicroSeconds ()));
+  //reset (for the first registration)
+  m_buinf->ResetHomeRetryCount ();
 
+  Ptr<Packet> p = BuildHomeBU ();
 
-      
-      SendMessage (p->Copy (), m_buinf->GetHA (), 64);
-      Ptr<Packet> pkt = p->Copy ();
-      m_txbuTrace (pkt, m_buinf->GetCoa (), m_buinf->GetHA ());
+  //save packet
+  m_buinf->SetHomeBUPacket (p);
 
+  //send BU
+  NS_LOG_FUNCTION (this << p->GetSize ());
 
-      m_buinf->StartHomeRetransTimer ();
+  SendMessage (p->Copy (), m_buinf->GetHA (), 64);
+  Ptr<Packet> pkt = p->Copy ();
+  m_txbuTrace (pkt, m_buinf->GetCoa (), m_buinf->GetHA ());
 
-      if (m_buinf->IsHomeReachable ())
-        {
-          m_buinf->MarkHomeRefreshing ();
-        }
-      else
-        {
-          m_buinf->MarkHomeUpdating ();
-        }
+
+  m_buinf->StartHomeRetransTimer ();
+
+  if (m_buinf->IsHomeReachable ())
+    {
+      m_buinf->MarkHomeRefreshing ();
+    }
+  else
+    {
+      m_buinf->MarkHomeUpdating ();
     }
 }
 
@@ -365,7 +438,7 @@ uint8_t Mipv6Mn::HandleBA (Ptr<Packet> packet, const Ipv6Address &src, const Ipv
   p->RemoveHeader (ba);
   p->RemoveHeader (exttype2);
 
-  Ptr<Mipv6Demux> mipv6Demux = GetNode ()->GetObject<Mipv6Demux> ();
+  Ptr<Mipv6Demux> mipv6Demux = GetMipv6Demux ();
   NS_ASSERT (mipv6Demux);
 
   Ptr<Mipv6Mobility> ipv6Mobility = mipv6Demux->GetMobility (ba.GetMhType ());
@@ -399,7 +472,23 @@ uint8_t Mipv6Mn::HandleBA (Ptr<Packet> packet, const Ipv6Address &src, const Ipv
               {
                 if (!(m_buinf->GetHoa ()).IsEqual (m_buinf->GetCoa ()))
                   {
-                    SetupTunnelAndRouting ();
+                    int32_t primary = GetIpv6 ()->GetInterfaceForAddress (m_buinf->GetCoa ());
+                    if (!m_mcoa)
+                      {
+                        SetupTunnelAndRouting ();
+                      }
+                    else if (primary >= 0
+                             && (m_buinf->GetTunnelIfIndex () < 0 || static_cast<uint32_t> (primary) != m_OldinterfaceIndex))
+                      {
+                        //(re)tunnel through the interface of the primary CoA, the
+                        //other CoAs stay registered
+                        if (m_buinf->GetTunnelIfIndex () >= 0)
+                          {
+                            ClearTunnelAndRouting ();
+                          }
+                        RestoreDefaultRoute (primary, m_buinf->GetCoa ());
+                        SetupTunnelAndRouting ();
+                      }
                   }
 
                 m_buinf->MarkHomeReachable ();
@@ -520,7 +609,7 @@ uint8_t Mipv6Mn::HandleHoT (Ptr<Packet> packet, const Ipv6Address &src, const Ip
   p->RemoveHeader (hot);
   p->RemoveHeader (exttype2);
 
-  Ptr<Mipv6Demux> mipv6Demux = GetNode ()->GetObject<Mipv6Demux> ();
+  Ptr<Mipv6Demux> mipv6Demux = GetMipv6Demux ();
   NS_ASSERT (mipv6Demux);
 
   Ptr<Mipv6Mobility> ipv6Mobility = mipv6Demux->GetMobility (hot.GetMhType ());
@@ -568,7 +657,7 @@ uint8_t Mipv6Mn::HandleCoT (Ptr<Packet> packet, const Ipv6Address &src, const Ip
   p->RemoveHeader (cot);
   p->RemoveHeader (exttype2);
 
-  Ptr<Mipv6Demux> mipv6Demux = GetNode ()->GetObject<Mipv6Demux> ();
+  Ptr<Mipv6Demux> mipv6Demux = GetMipv6Demux ();
   NS_ASSERT (mipv6Demux);
 
   Ptr<Mipv6Mobility> ipv6Mobility = mipv6Demux->GetMobility (cot.GetMhType ());
@@ -622,7 +711,7 @@ uint8_t Mipv6Mn::HandleCoT (Ptr<Packet> packet, const Ipv6Address &src, const Ip
 
 bool Mipv6Mn::SetupTunnelAndRouting ()
 {
-  Ptr<Ipv6TunnelL4Protocol> th = GetNode ()->GetObject<Ipv6TunnelL4Protocol> ();
+  Ptr<Ipv6TunnelL4Protocol> th = GetTunnelProtocol ();
   NS_ASSERT (th);
 
   uint16_t tunnelIf = th->AddTunnel (m_buinf->GetHA ());
@@ -634,7 +723,7 @@ bool Mipv6Mn::SetupTunnelAndRouting ()
 
 
   Ipv6StaticRoutingHelper staticRoutingHelper;
-  Ptr<Ipv6> ipv6 = GetNode ()->GetObject<Ipv6> ();
+  Ptr<Ipv6> ipv6 = GetIpv6 ();
 
   Ptr<Ipv6StaticRouting> staticRouting = staticRoutingHelper.GetStaticRouting (ipv6);
   Ipv6RoutingTableEntry routeentry (staticRouting->GetDefaultRoute ());
@@ -643,18 +732,7 @@ bool Mipv6Mn::SetupTunnelAndRouting ()
 
   staticRouting->RemoveRoute (routeentry.GetDest (), routeentry.GetDestNetworkPrefix (), routeentry.GetInterface (), routeentry.GetPrefixToUse ());
 
-  uint8_t buf1[8],buf2[16],buf[16];
-  (routeentry.GetPrefixToUse ()).GetBytes (buf1);
-  (m_defaultrouteraddress).GetBytes (buf2);
-  for (int i = 0; i < 8; i++)
-    {
-      buf[i] = buf1[i];
-    }
-  for (int i = 0; i < 8; i++)
-    {
-      buf[i + 8] = buf2[i + 8];
-    }
-  Ipv6Address addr (buf);
+  Ipv6Address addr = routeentry.GetPrefixToUse ().CombineInterfaceId (m_defaultrouteraddress, Ipv6Prefix (64));
 
   staticRouting->AddHostRouteTo (m_buinf->GetHA (), addr, m_IfIndex, Ipv6Address ("::"), 0);
   m_OldinterfaceIndex = m_IfIndex;
@@ -673,7 +751,7 @@ void Mipv6Mn::ClearTunnelAndRouting ()
   NS_LOG_FUNCTION (this);
 
   Ipv6StaticRoutingHelper staticRoutingHelper;
-  Ptr<Ipv6> ipv6 = GetNode ()->GetObject<Ipv6> ();
+  Ptr<Ipv6> ipv6 = GetIpv6 ();
 
 
   Ptr<Ipv6StaticRouting> staticRouting = staticRoutingHelper.GetStaticRouting (ipv6);
@@ -682,7 +760,7 @@ void Mipv6Mn::ClearTunnelAndRouting ()
   staticRouting->RemoveRoute (m_buinf->GetHA (), Ipv6Prefix (128), m_OldinterfaceIndex, Ipv6Address ("::"));
 
   //clear tunnel
-  Ptr<Ipv6TunnelL4Protocol> th = GetNode ()->GetObject<Ipv6TunnelL4Protocol> ();
+  Ptr<Ipv6TunnelL4Protocol> th = GetTunnelProtocol ();
   NS_ASSERT (th);
 
   th->RemoveTunnel (m_buinf->GetHA ());
@@ -706,6 +784,8 @@ void Mipv6Mn::SetDefaultRouterAddress (Ipv6Address addr,  uint32_t index)
 {
   m_defaultrouteraddress = addr;
   m_IfIndex = index;
+  m_routers[index] = addr;
+  m_rxraTrace (addr, index);
 }
 
 bool Mipv6Mn::CheckAddresses (Ipv6Address ha, Ipv6Address hoa)
@@ -717,6 +797,266 @@ bool Mipv6Mn::CheckAddresses (Ipv6Address ha, Ipv6Address hoa)
   return false;
 }
 
+void Mipv6Mn::AddFlowBinding (uint16_t fid, uint16_t priority, uint16_t bid, uint8_t protocol, uint16_t portLow, uint16_t portHigh)
+{
+  NS_LOG_FUNCTION (this << fid << priority << bid << (uint32_t) protocol << portLow << portHigh);
+
+  Ipv6MobilityOptionFlowIdentificationHeader flow;
+  flow.SetFlowId (fid);
+  flow.SetPriority (priority);
+  flow.SetBindingId (bid);
+  flow.SetProtocol (protocol);
+  flow.SetDestinationPortRange (portLow, portHigh);
+  m_flows.push_back (flow);
+}
+
+void Mipv6Mn::HandleLinkEvent (uint8_t event, Ptr<NetDevice> device, double signal)
+{
+  NS_LOG_FUNCTION (this << MihFunction::GetEventName (event) << device->GetIfIndex () << signal);
+
+  Ptr<Ipv6L3Protocol> ipv6 = GetIpv6 ();
+  int32_t interface = ipv6->GetInterfaceForDevice (device);
+  if (interface < 0)
+    {
+      return;
+    }
+  int32_t current = ipv6->GetInterfaceForAddress (m_buinf->GetCoa ());
+
+  switch (event)
+    {
+    case MihFunction::LINK_GOING_DOWN:
+      m_linksGoingDown.insert (interface);
+      if (current < 0 || current == interface)
+        {
+          PrepareHandoff (interface);
+        }
+      break;
+    case MihFunction::LINK_DOWN:
+      m_linksGoingDown.erase (interface);
+      if (current < 0 || current == interface)
+        {
+          PrepareHandoff (interface);
+        }
+      break;
+    case MihFunction::LINK_UP:
+      m_linksGoingDown.erase (interface);
+      // only solicit the router: the CoA formed from its prefix is then
+      // registered, while an address still valid from a previous
+      // attachment is not, so that a flapping link is not used again
+      if (current != interface && ipv6->IsUp (interface) && GetCareOfAddress (interface).IsAny ())
+        {
+          HandoffTo (interface);
+        }
+      break;
+    case MihFunction::LINK_PARAMETERS_REPORT:
+      {
+        NS_LOG_LOGIC ("Link of interface " << interface << " reports signal " << signal);
+        // the other reports are threshold crossings, which only move the MN
+        // to a link clearly better than the one of the CoA
+        bool recovered = IsLinkUsable (interface) && m_linksGoingDown.erase (interface) > 0;
+        if (current != interface && ipv6->IsUp (interface) && IsLinkUsable (interface)
+            && (recovered || current < 0 || !IsLinkUsable (current) || IsLinkBetter (interface, current)))
+          {
+            HandoffTo (interface);
+          }
+      }
+      break;
+    default:
+      break;
+    }
+}
+
+void Mipv6Mn::HandleNewAddress (Ipv6Address address)
+{
+  NS_LOG_FUNCTION (this << address);
+
+  if (m_mih != 0 && !address.IsLinkLocal ())
+    {
+      int32_t interface = GetIpv6 ()->GetInterfaceForAddress (address);
+      if (interface >= 0 && !IsLinkUsable (interface))
+        {
+          NS_LOG_LOGIC ("Link of interface " << interface << " is going down, " << address << " is not registered");
+          return;
+        }
+    }
+  HandleNewAttachment (address);
+}
+
+bool Mipv6Mn::IsLinkUsable (uint32_t interface)
+{
+  Ptr<MihLinkAdapter> link = m_mih->GetLink (GetIpv6 ()->GetNetDevice (interface));
+  return link == 0 || (link->IsLinkUp () && !link->IsGoingDown ());
+}
+
+bool Mipv6Mn::IsLinkBetter (uint32_t interface, uint32_t current)
+{
+  Ptr<MihLinkAdapter> link = m_mih->GetLink (GetIpv6 ()->GetNetDevice (interface));
+  Ptr<MihLinkAdapter> currentLink = m_mih->GetLink (GetIpv6 ()->GetNetDevice (current));
+  if (link == 0 || currentLink == 0)
+    {
+      return false;
+    }
+  // false as well if either margin is NaN
+  return link->GetSignalMargin () >= currentLink->GetSignalMargin () + m_handbackMargin;
+}
+
+void Mipv6Mn::PrepareHandoff (int32_t interface)
+{
+  NS_LOG_FUNCTION (this << interface);
+
+  Ptr<Ipv6L3Protocol> ipv6 = GetIpv6 ();
+  int32_t target = -1;
+  for (uint32_t i = 0; i < m_mih->GetNLinks (); i++)
+    {
+      Ptr<MihLinkAdapter> link = m_mih->GetLink (i);
+      int32_t j = ipv6->GetInterfaceForDevice (link->GetDevice ());
+      if (j < 0 || j == interface || !link->IsLinkUp () || !ipv6->IsUp (j))
+        {
+          continue;
+        }
+      // prefer a link which is not going down itself
+      if (target < 0 || !link->IsGoingDown ())
+        {
+          target = j;
+        }
+      if (!link->IsGoingDown ())
+        {
+          break;
+        }
+    }
+
+  if (target < 0)
+    {
+      NS_LOG_LOGIC ("No other link or interface is up, the handoff waits for a new attachment");
+      return;
+    }
+  HandoffTo (target);
+}
+
+void Mipv6Mn::HandoffTo (uint32_t interface)
+{
+  NS_LOG_FUNCTION (this << interface);
+
+  Ptr<Ipv6L3Protocol> ipv6 = GetIpv6 ();
+  if (!ipv6->IsUp (interface))
+    {
+      // the interface was set down by the user, whose choice stands
+      NS_LOG_LOGIC ("Interface " << interface << " is down");
+      return;
+    }
+
+  Ipv6Address coa = GetCareOfAddress (interface);
+  if (coa.IsAny () || m_routers.find (interface) == m_routers.end ())
+    {
+      // solicit the router instead of waiting for its next RA
+      Ptr<NetDevice> device = ipv6->GetNetDevice (interface);
+      GetIcmpv6 ()->SendRS (ipv6->GetInterface (interface)->GetLinkLocalAddress ().GetAddress (),
+                            Ipv6Address::GetAllRoutersMulticast (), device->GetAddress ());
+      return;
+    }
+
+  if (m_mcoa)
+    {
+      // the other CoAs stay registered, the tunnel moves to this one once
+      // its BA is received
+      m_buinf->SetCoa (coa);
+    }
+  else
+    {
+      // the default route of the interface was replaced by the tunnel when
+      // its CoA was last registered, restore it so that the BU is sent from it
+      RestoreDefaultRoute (interface, coa);
+    }
+
+  HandleNewAttachment (coa);
+}
+
+bool Mipv6Mn::RestoreDefaultRoute (uint32_t interface, Ipv6Address coa)
+{
+  NS_LOG_FUNCTION (this << interface << coa);
+
+  std::map<uint32_t, Ipv6Address>::const_iterator router = m_routers.find (interface);
+  if (router == m_routers.end ())
+    {
+      return false;
+    }
+
+  Ipv6StaticRoutingHelper staticRoutingHelper;
+  Ptr<Ipv6StaticRouting> staticRouting = staticRoutingHelper.GetStaticRouting (GetIpv6 ());
+  Ipv6Address prefix = coa.CombinePrefix (Ipv6Prefix (64));
+  staticRouting->RemoveRoute (Ipv6Address ("::"), Ipv6Prefix::GetZero (), interface, prefix);
+  staticRouting->SetDefaultRoute (router->second, interface, prefix, 0);
+  m_defaultrouteraddress = router->second;
+  m_IfIndex = interface;
+  return true;
+}
+
+void Mipv6Mn::HandleAddressRemoved (Ipv6Address address, uint32_t interface)
+{
+  NS_LOG_FUNCTION (this << address << interface);
+
+  if (!m_mcoa)
+    {
+      return;
+    }
+
+  std::map<uint16_t, Ipv6Address> coas = m_buinf->GetCoaList ();
+  std::map<uint16_t, Ipv6Address>::iterator it = coas.find (interface);
+  if (it == coas.end () || it->second != address)
+    {
+      return;
+    }
+  m_buinf->RemoveCoa (interface);
+
+  // the interface is still updating its addresses and routes
+  Simulator::ScheduleNow (&Mipv6Mn::DeregisterCoa, this, address);
+}
+
+void Mipv6Mn::DeregisterCoa (Ipv6Address coa)
+{
+  NS_LOG_FUNCTION (this << coa);
+
+  std::map<uint16_t, Ipv6Address> coas = m_buinf->GetCoaList ();
+  if (coa == m_buinf->GetCoa ())
+    {
+      if (m_buinf->GetTunnelIfIndex () >= 0)
+        {
+          ClearTunnelAndRouting ();
+        }
+      if (coas.empty ())
+        {
+          // the CoA of the next attachment becomes the primary one
+          NS_LOG_LOGIC ("No CoA left");
+          return;
+        }
+      // the BU is sent from the new primary CoA, whose BA moves the tunnel
+      m_buinf->SetCoa (coas.begin ()->second);
+      RestoreDefaultRoute (coas.begin ()->first, coas.begin ()->second);
+    }
+  else if (coas.empty ())
+    {
+      return;
+    }
+
+  SendHomeBU ();
+}
+
+Ipv6Address Mipv6Mn::GetCareOfAddress (uint32_t interface)
+{
+  Ptr<Ipv6L3Protocol> ipv6 = GetIpv6 ();
+  for (uint32_t i = 0; i < ipv6->GetNAddresses (interface); i++)
+    {
+      Ipv6InterfaceAddress address = ipv6->GetAddress (interface, i);
+      if (address.GetScope () == Ipv6InterfaceAddress::GLOBAL
+          && address.GetState () == Ipv6InterfaceAddress::PREFERRED
+          && !address.GetAddress ().IsEqual (m_buinf->GetHoa ()))
+        {
+          return address.GetAddress ();
+        }
+    }
+  return Ipv6Address::GetAny ();
+}
+
 Ipv6Address Mipv6Mn::GetHomeAddress ()
 {
 return m_buinf->GetHoa ();
@@ -21,8 +21,12 @@
 #ifndef MIPV6_MN_H
 #define MIPV6_MN_H
 
+#include <map>
+#include <set>
 #include "mipv6-agent.h"
 #include "blist.h"
+#include "mipv6-header.h"
+#include "mih-function.h"
 #include "ns3/traced-callback.h"
 
 namespace ns3 {
@@ -130,6 +134,19 @@ public:
    */
   bool CheckAddresses (Ipv6Address ha, Ipv6Address hoa);
 
+  /**
+   * \brief add a flow binding (RFC 6089), sent with the next home BU.
+   *
+   * Only used when multiple care-of address registration is enabled.
+   * \param fid flow identifier
+   * \param priority flow priority, lower value is matched first
+   * \param bid binding identifier (the interface index of the CoA)
+   * \param protocol transport protocol, 0 matches any
+   * \param portLow lowest destination port of the flow
+   * \param portHigh highest destination port of the flow
+   */
+  void AddFlowBinding (uint16_t fid, uint16_t priority, uint16_t bid, uint8_t protocol, uint16_t portLow, uint16_t portHigh);
+
   /**
    * \return HoA
    */
@@ -162,12 +179,47 @@ public:
   typedef void (* TxBuTracedCallback)
     (Ptr<Packet> packet, Ipv6Address src, Ipv6Address dst);
 
+  /**
+   * TracedCallback signature for RA reception event.
+   *
+   * \param [in] router The default router address
+   * \param [in] interface The interface index the RA was received on
+   */
+  typedef void (* RxRaTracedCallback)
+    (Ipv6Address router, uint32_t interface);
+
+  /**
+   * TracedCallback signature for new CoA event.
+   *
+   * \param [in] coa The new care-of address
+   */
+  typedef void (* NewCoaTracedCallback)
+    (Ipv6Address coa);
+
 
 
 
 protected:
   virtual void NotifyNewAggregate ();
 
+  /**
+   * \brief Dispose this object.
+   */
+  virtual void DoDispose ();
+
+  /**
+   * \brief handle a link event of the MihFunction of the node: when the
+   * link of the CoA is going down or is down, the MN attaches to another
+   * link which is up (make-before-break), when a link goes up, it
+   * solicits its router at once, and when another link recovers from
+   * going down, or its signal margin beats the one of the link of the CoA
+   * by HandbackMargin, the MN attaches to it.
+   * \param event the event
+   * \param device the device of the link
+   * \param signal the last signal of the link
+   */
+  virtual void HandleLinkEvent (uint8_t event, Ptr<NetDevice> device, double signal);
+
   /**
    * \brief handle attachment with a network, called from ICMPv6L4Protocol
    * \param ipr the CoA currently configured at ICMPv6 layer
@@ -206,11 +258,109 @@ protected:
 
 private:
 
+  /**
+   * \brief handle an address configured at ICMPv6 layer: with a
+   * MihFunction, the addresses of the links which are down or going down
+   * are not registered, until their signal recovers.
+   * \param address the address
+   */
+  void HandleNewAddress (Ipv6Address address);
+
+  /**
+   * \brief check whether the MihFunction reports the link of an interface
+   * as up and not going down.
+   * \param interface the interface
+   * \returns true if so, or if the link has no adapter
+   */
+  bool IsLinkUsable (uint32_t interface);
+
+  /**
+   * \brief check whether the signal margin of the link of an interface
+   * beats the one of the link of another by HandbackMargin.
+   * \param interface the interface
+   * \param current the interface of the CoA
+   * \returns true if so, false if either link has no adapter or no signal
+   */
+  bool IsLinkBetter (uint32_t interface, uint32_t current);
+
+  /**
+   * \brief attach to another link than the one of an interface.
+   * \param interface the interface of the link which is going down
+   */
+  void PrepareHandoff (int32_t interface);
+
+  /**
+   * \brief register a CoA of an interface, configuring one first if the
+   * interface has none; nothing is done if the interface is down.
+   * \param interface the interface
+   */
+  void HandoffTo (uint32_t interface);
+
+  /**
+   * \brief get the preferred global address of an interface, other than
+   * the HoA.
+   * \param interface the interface
+   * \returns the address, or the any address if none
+   */
+  Ipv6Address GetCareOfAddress (uint32_t interface);
+
+  /**
+   * \brief send a home BU for the registered CoA(s) and start its
+   * retransmission timer.
+   */
+  void SendHomeBU ();
+
+  /**
+   * \brief make the router of an interface the default route of the MN,
+   * as it was before the tunnel replaced it.
+   * \param interface the interface
+   * \param coa the CoA of the interface
+   * \returns false if no router is known on the interface
+   */
+  bool RestoreDefaultRoute (uint32_t interface, Ipv6Address coa);
+
+  /**
+   * \brief handle an address removed from an interface: with multiple
+   * care-of address registration, the binding of a CoA is removed with
+   * the next home BU.
+   * \param address the address
+   * \param interface the interface
+   */
+  void HandleAddressRemoved (Ipv6Address address, uint32_t interface);
+
+  /**
+   * \brief send the home BU without a removed CoA; if it was the primary
+   * one, another CoA becomes primary and the tunnel moves to it.
+   * \param coa the removed CoA
+   */
+  void DeregisterCoa (Ipv6Address coa);
+
   /**
    * \brief Binding information list of the MN.
    */
   Ptr<BList> m_buinf;
 
+  /**
+   * \brief the MIH function of the node, if any.
+   */
+  Ptr<MihFunction> m_mih;
+
+  /**
+   * \brief the last default router learned on each interface.
+   */
+  std::map<uint32_t, Ipv6Address> m_routers;
+
+  /**
+   * \brief the interfaces whose link was reported going down.
+   */
+  std::set<uint32_t> m_linksGoingDown;
+
+  /**
+   * \brief how much more signal margin another link needs to be used
+   * instead of the link of the CoA.
+   */
+  double m_handbackMargin;
+
   /**
    * \brief home binding update sequence no.
    */
@@ -251,6 +401,16 @@ private:
    */
   uint32_t m_IfIndex;
 
+  /**
+   * \brief multiple care-of address registration flag (RFC 5648).
+   */
+  bool m_mcoa;
+
+  /**
+   * \brief flow bindings sent with the home BU.
+   */
+  std::list<Ipv6MobilityOptionFlowIdentificationHeader> m_flows;
+
   /**
    * \brief Callback to trace RX (reception) ba packets.
    */ 
@@ -261,6 +421,16 @@ private:
    */ 
   TracedCallback<Ptr<Packet>, Ipv6Address, Ipv6Address> m_txbuTrace;
 
+  /**
+   * \brief Callback to trace RA reception.
+   */
+  TracedCallback<Ipv6Address, uint32_t> m_rxraTrace;
+
+  /**
+   * \brief Callback to trace new CoAs.
+   */
+  TracedCallback<Ipv6Address> m_newCoaTrace;
+
 };
 
 } /* namespace ns3 */
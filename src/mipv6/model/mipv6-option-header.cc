@@ -562,4 +562,323 @@ Mipv6OptionHeader::Alignment Ipv6MobilityOptionBindingAuthorizationDataHeader::G
 }
 
 
+NS_OBJECT_ENSURE_REGISTERED (Ipv6MobilityOptionBindingIdentifierHeader);
+
+TypeId Ipv6MobilityOptionBindingIdentifierHeader::GetTypeId ()
+{
+  static TypeId tid = TypeId ("ns3::Ipv6MobilityOptionBindingIdentifierHeader")
+    .SetParent<Mipv6OptionHeader> ()
+    .AddConstructor<Ipv6MobilityOptionBindingIdentifierHeader> ()
+  ;
+  return tid;
+}
+
+TypeId Ipv6MobilityOptionBindingIdentifierHeader::GetInstanceTypeId () const
+{
+  return GetTypeId ();
+}
+
+Ipv6MobilityOptionBindingIdentifierHeader::Ipv6MobilityOptionBindingIdentifierHeader ()
+{
+  SetType (Mipv6Header::IPV6_MOBILITY_OPT_BINDING_IDENTIFIER);
+  SetLength (4);
+
+  m_bid = 0;
+  m_status = 0;
+  m_flagO = false;
+  m_coa.Set ("::");
+}
+
+Ipv6MobilityOptionBindingIdentifierHeader::~Ipv6MobilityOptionBindingIdentifierHeader ()
+{
+}
+
+uint16_t Ipv6MobilityOptionBindingIdentifierHeader::GetBindingId () const
+{
+  return m_bid;
+}
+
+void Ipv6MobilityOptionBindingIdentifierHeader::SetBindingId (uint16_t bid)
+{
+  m_bid = bid;
+}
+
+uint8_t Ipv6MobilityOptionBindingIdentifierHeader::GetStatus () const
+{
+  return m_status;
+}
+
+void Ipv6MobilityOptionBindingIdentifierHeader::SetStatus (uint8_t status)
+{
+  m_status = status;
+}
+
+bool Ipv6MobilityOptionBindingIdentifierHeader::GetFlagO () const
+{
+  return m_flagO;
+}
+
+void Ipv6MobilityOptionBindingIdentifierHeader::SetFlagO (bool o)
+{
+  m_flagO = o;
+}
+
+Ipv6Address Ipv6MobilityOptionBindingIdentifierHeader::GetCareofAddress () const
+{
+  return m_coa;
+}
+
+void Ipv6MobilityOptionBindingIdentifierHeader::SetCareofAddress (Ipv6Address coa)
+{
+  m_coa = coa;
+  SetLength (coa.IsAny () ? 4 : 20);
+}
+
+void Ipv6MobilityOptionBindingIdentifierHeader::Print (std::ostream& os) const
+{
+  os << "( type=" << (uint32_t)GetType () << ", length(excluding TL)=" << (uint32_t)GetLength () << ", bid=" << GetBindingId () << ", status=" << (uint32_t)GetStatus () << ", coa=" << GetCareofAddress () << ")";
+}
+
+uint32_t Ipv6MobilityOptionBindingIdentifierHeader::GetSerializedSize () const
+{
+  return GetLength () + 2;
+}
+
+void Ipv6MobilityOptionBindingIdentifierHeader::Serialize (Buffer::Iterator start) const
+{
+  uint8_t buff_coa[16];
+  Buffer::Iterator i = start;
+  uint8_t flags = 0;
+
+  i.WriteU8 (GetType ());
+  i.WriteU8 (GetLength ());
+
+  i.WriteHtonU16 (m_bid);
+  i.WriteU8 (m_status);
+
+  if (m_flagO)
+    {
+      flags |= (uint8_t)(1 << 6);
+    }
+  i.WriteU8 (flags);
+
+  if (GetLength () > 4)
+    {
+      m_coa.Serialize (buff_coa);
+      i.Write (buff_coa, 16);
+    }
+}
+
+uint32_t Ipv6MobilityOptionBindingIdentifierHeader::Deserialize (Buffer::Iterator start)
+{
+  uint8_t buff_coa[16];
+  Buffer::Iterator i = start;
+
+  SetType (i.ReadU8 ());
+  SetLength (i.ReadU8 ());
+
+  m_bid = i.ReadNtohU16 ();
+  m_status = i.ReadU8 ();
+  m_flagO = (i.ReadU8 () & (1 << 6)) != 0;
+
+  if (GetLength () > 4)
+    {
+      i.Read (buff_coa, 16);
+      m_coa.Set (buff_coa);
+    }
+  else
+    {
+      m_coa.Set ("::");
+    }
+
+  return GetSerializedSize ();
+}
+
+Mipv6OptionHeader::Alignment Ipv6MobilityOptionBindingIdentifierHeader::GetAlignment () const
+{
+  return (Alignment){
+           8,2
+  };                       //8n+2
+}
+
+NS_OBJECT_ENSURE_REGISTERED (Ipv6MobilityOptionFlowIdentificationHeader);
+
+TypeId Ipv6MobilityOptionFlowIdentificationHeader::GetTypeId ()
+{
+  static TypeId tid = TypeId ("ns3::Ipv6MobilityOptionFlowIdentificationHeader")
+    .SetParent<Mipv6OptionHeader> ()
+    .AddConstructor<Ipv6MobilityOptionFlowIdentificationHeader> ()
+  ;
+  return tid;
+}
+
+TypeId Ipv6MobilityOptionFlowIdentificationHeader::GetInstanceTypeId () const
+{
+  return GetTypeId ();
+}
+
+Ipv6MobilityOptionFlowIdentificationHeader::Ipv6MobilityOptionFlowIdentificationHeader ()
+{
+  SetType (Mipv6Header::IPV6_MOBILITY_OPT_FLOW_IDENTIFICATION);
+  SetLength (20);
+
+  m_fid = 0;
+  m_priority = 0;
+  m_action = FLOW_ACTION_FORWARD;
+  m_status = 0;
+  m_bid = 0;
+  m_protocol = 0;
+  m_portLow = 0;
+  m_portHigh = 0xFFFF;
+}
+
+Ipv6MobilityOptionFlowIdentificationHeader::~Ipv6MobilityOptionFlowIdentificationHeader ()
+{
+}
+
+uint16_t Ipv6MobilityOptionFlowIdentificationHeader::GetFlowId () const
+{
+  return m_fid;
+}
+
+void Ipv6MobilityOptionFlowIdentificationHeader::SetFlowId (uint16_t fid)
+{
+  m_fid = fid;
+}
+
+uint16_t Ipv6MobilityOptionFlowIdentificationHeader::GetPriority () const
+{
+  return m_priority;
+}
+
+void Ipv6MobilityOptionFlowIdentificationHeader::SetPriority (uint16_t pri)
+{
+  m_priority = pri;
+}
+
+uint8_t Ipv6MobilityOptionFlowIdentificationHeader::GetAction () const
+{
+  return m_action;
+}
+
+void Ipv6MobilityOptionFlowIdentificationHeader::SetAction (uint8_t action)
+{
+  m_action = action;
+}
+
+uint8_t Ipv6MobilityOptionFlowIdentificationHeader::GetStatus () const
+{
+  return m_status;
+}
+
+void Ipv6MobilityOptionFlowIdentificationHeader::SetStatus (uint8_t status)
+{
+  m_status = status;
+}
+
+uint16_t Ipv6MobilityOptionFlowIdentificationHeader::GetBindingId () const
+{
+  return m_bid;
+}
+
+void Ipv6MobilityOptionFlowIdentificationHeader::SetBindingId (uint16_t bid)
+{
+  m_bid = bid;
+}
+
+uint8_t Ipv6MobilityOptionFlowIdentificationHeader::GetProtocol () const
+{
+  return m_protocol;
+}
+
+void Ipv6MobilityOptionFlowIdentificationHeader::SetProtocol (uint8_t protocol)
+{
+  m_protocol = protocol;
+}
+
+uint16_t Ipv6MobilityOptionFlowIdentificationHeader::GetDestinationPortLow () const
+{
+  return m_portLow;
+}
+
+uint16_t Ipv6MobilityOptionFlowIdentificationHeader::GetDestinationPortHigh () const
+{
+  return m_portHigh;
+}
+
+void Ipv6MobilityOptionFlowIdentificationHeader::SetDestinationPortRange (uint16_t low, uint16_t high)
+{
+  m_portLow = low;
+  m_portHigh = high;
+}
+
+void Ipv6MobilityOptionFlowIdentificationHeader::Print (std::ostream& os) const
+{
+  os << "( type=" << (uint32_t)GetType () << ", length(excluding TL)=" << (uint32_t)GetLength () << ", fid=" << GetFlowId () << ", priority=" << GetPriority () << ", bid=" << GetBindingId () << ", protocol=" << (uint32_t)GetProtocol () << ", ports=" << GetDestinationPortLow () << "-" << GetDestinationPortHigh () << ")";
+}
+
+uint32_t Ipv6MobilityOptionFlowIdentificationHeader::GetSerializedSize () const
+{
+  return GetLength () + 2;
+}
+
+void Ipv6MobilityOptionFlowIdentificationHeader::Serialize (Buffer::Iterator start) const
+{
+  Buffer::Iterator i = start;
+
+  i.WriteU8 (GetType ());
+  i.WriteU8 (GetLength ());
+
+  i.WriteHtonU16 (m_fid);
+  i.WriteHtonU16 (m_priority);
+  i.WriteU8 (m_action);
+  i.WriteU8 (m_status);
+
+  //BID reference sub-option
+  i.WriteU8 (2);
+  i.WriteU8 (2);
+  i.WriteHtonU16 (m_bid);
+
+  //traffic selector sub-option
+  i.WriteU8 (1);
+  i.WriteU8 (8);
+  i.WriteU8 (0);
+  i.WriteU8 (0);
+  i.WriteU8 (m_protocol);
+  i.WriteU8 (0);
+  i.WriteHtonU16 (m_portLow);
+  i.WriteHtonU16 (m_portHigh);
+}
+
+uint32_t Ipv6MobilityOptionFlowIdentificationHeader::Deserialize (Buffer::Iterator start)
+{
+  Buffer::Iterator i = start;
+
+  SetType (i.ReadU8 ());
+  SetLength (i.ReadU8 ());
+
+  m_fid = i.ReadNtohU16 ();
+  m_priority = i.ReadNtohU16 ();
+  m_action = i.ReadU8 ();
+  m_status = i.ReadU8 ();
+
+  i.Next (2);
+  m_bid = i.ReadNtohU16 ();
+
+  i.Next (4);
+  m_protocol = i.ReadU8 ();
+  i.Next (1);
+  m_portLow = i.ReadNtohU16 ();
+  m_portHigh = i.ReadNtohU16 ();
+
+  return GetSerializedSize ();
+}
+
+Mipv6OptionHeader::Alignment Ipv6MobilityOptionFlowIdentificationHeader::GetAlignment () const
+{
+  return (Alignment){
+           2,0
+  };                       //2n
+}
+
 } /* namespace ns3 */
@@ -538,6 +538,293 @@ private:
   uint64_t m_auth;
 };
 
+/**
+ * \class Ipv6MobilityOptionBindingIdentifierHeader
+ * \brief Ipv6 Mobility Option Binding Identifier Header (RFC 5648).
+ */
+class Ipv6MobilityOptionBindingIdentifierHeader : public Mipv6OptionHeader
+{
+public:
+  /**
+   * \brief Get the type identifier.
+   * \return type identifier
+   */
+  static TypeId GetTypeId ();
+  /**
+   * \brief Return the instance type identifier.
+   * \return instance type ID
+   */
+  virtual TypeId GetInstanceTypeId () const;
+  /**
+   * \brief constructor
+   */
+  Ipv6MobilityOptionBindingIdentifierHeader ();
+  /**
+   * \brief destructor
+   */
+  virtual ~Ipv6MobilityOptionBindingIdentifierHeader ();
+  /**
+   * \brief get binding identifier
+   * \return binding identifier
+   */
+  uint16_t GetBindingId () const;
+  /**
+   * \brief set binding identifier
+   * \param bid binding identifier
+   */
+  void SetBindingId (uint16_t bid);
+  /**
+   * \brief get status
+   * \return status
+   */
+  uint8_t GetStatus () const;
+  /**
+   * \brief set status
+   * \param status status
+   */
+  void SetStatus (uint8_t status);
+  /**
+   * \brief get overwrite (O) flag
+   * \return overwrite flag
+   */
+  bool GetFlagO () const;
+  /**
+   * \brief set overwrite (O) flag
+   * \param o overwrite flag
+   */
+  void SetFlagO (bool o);
+  /**
+   * \brief get the CoA carried by this option.
+   * \return CoA, or the any address if none
+   */
+  Ipv6Address GetCareofAddress () const;
+  /**
+   * \brief set the CoA carried by this option.
+   * \param coa CoA
+   */
+  void SetCareofAddress (Ipv6Address coa);
+  /**
+   * \brief Print informations.
+   * \param os output stream
+   */
+  virtual void Print (std::ostream& os) const;
+  /**
+   * \brief Get the serialized size.
+   * \return serialized size
+   */
+  virtual uint32_t GetSerializedSize () const;
+  /**
+   * \brief Serialize the packet.
+   * \param start start offset
+   */
+  virtual void Serialize (Buffer::Iterator start) const;
+  /**
+   * \brief Deserialize the packet.
+   * \param start start offset
+   * \return length of packet
+   */
+  virtual uint32_t Deserialize (Buffer::Iterator start);
+  /**
+   * \brief Get the Alignment requirement of this option header
+   * \return the required alignment
+   */
+  virtual Alignment GetAlignment () const;
+protected:
+private:
+  /**
+   * \brief binding identifier
+   */
+  uint16_t m_bid;
+  /**
+   * \brief status
+   */
+  uint8_t m_status;
+  /**
+   * \brief overwrite flag
+   */
+  bool m_flagO;
+  /**
+   * \brief CoA
+   */
+  Ipv6Address m_coa;
+};
+
+/**
+ * \class Ipv6MobilityOptionFlowIdentificationHeader
+ * \brief Ipv6 Mobility Option Flow Identification Header (RFC 6089).
+ *
+ * Carries one flow binding. The BID reference and the traffic selector
+ * sub-options are always present; the traffic selector only matches on
+ * the upper layer protocol and a destination port range.
+ */
+class Ipv6MobilityOptionFlowIdentificationHeader : public Mipv6OptionHeader
+{
+public:
+  /**
+   * \enum Action_e
+   * \brief flow binding action
+   */
+  enum Action_e
+  {
+    FLOW_ACTION_FORWARD = 1,
+    FLOW_ACTION_DISCARD = 2
+  };
+  /**
+   * \brief Get the type identifier.
+   * \return type identifier
+   */
+  static TypeId GetTypeId ();
+  /**
+   * \brief Return the instance type identifier.
+   * \return instance type ID
+   */
+  virtual TypeId GetInstanceTypeId () const;
+  /**
+   * \brief constructor
+   */
+  Ipv6MobilityOptionFlowIdentificationHeader ();
+  /**
+   * \brief destructor
+   */
+  virtual ~Ipv6MobilityOptionFlowIdentificationHeader ();
+  /**
+   * \brief get flow identifier
+   * \return flow identifier
+   */
+  uint16_t GetFlowId () const;
+  /**
+   * \brief set flow identifier
+   * \param fid flow identifier
+   */
+  void SetFlowId (uint16_t fid);
+  /**
+   * \brief get flow priority
+   * \return flow priority
+   */
+  uint16_t GetPriority () const;
+  /**
+   * \brief set flow priority
+   * \param pri flow priority
+   */
+  void SetPriority (uint16_t pri);
+  /**
+   * \brief get action
+   * \return action
+   */
+  uint8_t GetAction () const;
+  /**
+   * \brief set action
+   * \param action action
+   */
+  void SetAction (uint8_t action);
+  /**
+   * \brief get status
+   * \return status
+   */
+  uint8_t GetStatus () const;
+  /**
+   * \brief set status
+   * \param status status
+   */
+  void SetStatus (uint8_t status);
+  /**
+   * \brief get the referred binding identifier
+   * \return binding identifier
+   */
+  uint16_t GetBindingId () const;
+  /**
+   * \brief set the referred binding identifier
+   * \param bid binding identifier
+   */
+  void SetBindingId (uint16_t bid);
+  /**
+   * \brief get traffic selector upper layer protocol
+   * \return protocol number, 0 matches any
+   */
+  uint8_t GetProtocol () const;
+  /**
+   * \brief set traffic selector upper layer protocol
+   * \param protocol protocol number, 0 matches any
+   */
+  void SetProtocol (uint8_t protocol);
+  /**
+   * \brief get traffic selector lowest destination port
+   * \return port
+   */
+  uint16_t GetDestinationPortLow () const;
+  /**
+   * \brief get traffic selector highest destination port
+   * \return port
+   */
+  uint16_t GetDestinationPortHigh () const;
+  /**
+   * \brief set traffic selector destination port range
+   * \param low lowest port
+   * \param high highest port
+   */
+  void SetDestinationPortRange (uint16_t low, uint16_t high);
+  /**
+   * \brief Print informations.
+   * \param os output stream
+   */
+  virtual void Print (std::ostream& os) const;
+  /**
+   * \brief Get the serialized size.
+   * \return serialized size
+   */
+  virtual uint32_t GetSerializedSize () const;
+  /**
+   * \brief Serialize the packet.
+   * \param start start offset
+   */
+  virtual void Serialize (Buffer::Iterator start) const;
+  /**
+   * \brief Deserialize the packet.
+   * \param start start offset
+   * \return length of packet
+   */
+  virtual uint32_t Deserialize (Buffer::Iterator start);
+  /**
+   * \brief Get the Alignment requirement of this option header
+   * \return the required alignment
+   */
+  virtual Alignment GetAlignment () const;
+protected:
+private:
+  /**
+   * \brief flow identifier
+   */
+  uint16_t m_fid;
+  /**
+   * \brief flow priority
+   */
+  uint16_t m_priority;
+  /**
+   * \brief action
+   */
+  uint8_t m_action;
+  /**
+   * \brief status
+   */
+  uint8_t m_status;
+  /**
+   * \brief referred binding identifier
+   */
+  uint16_t m_bid;
+  /**
+   * \brief upper layer protocol
+   */
+  uint8_t m_protocol;
+  /**
+   * \brief lowest destination port
+   */
+  uint16_t m_portLow;
+  /**
+   * \brief highest destination port
+   */
+  uint16_t m_portHigh;
+};
+
 
 } /* namespace ns3 */
 
@@ -0,0 +1,582 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2017 Jadavpur University, India
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <sstream>
+#include <stdlib.h>
+#include "ns3/log.h"
+#include "ns3/assert.h"
+#include "ns3/simulator.h"
+#include "ns3/boolean.h"
+#include "ns3/uinteger.h"
+#include "ns3/callback.h"
+#include "ns3/loopback-net-device.h"
+#include "ns3/data-output-interface.h"
+#include "mipv6-mn.h"
+#include "mipv6-ha.h"
+#include "mipv6-tun-l4-protocol.h"
+#include "tunnel-net-device.h"
+#include "mipv6-stats.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("Mipv6Stats");
+
+NS_OBJECT_ENSURE_REGISTERED (Mipv6HandoffCalculator);
+
+TypeId Mipv6HandoffCalculator::GetTypeId ()
+{
+  static TypeId tid = TypeId ("ns3::Mipv6HandoffCalculator")
+    .SetParent<DataCalculator> ()
+    .SetGroupName ("Mipv6")
+    .AddConstructor<Mipv6HandoffCalculator> ()
+  ;
+  return tid;
+}
+
+Mipv6HandoffCalculator::Mipv6HandoffCalculator ()
+  : m_incomplete (0),
+    m_signalingPackets (0),
+    m_signalingBytes (0)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  SetBins (MilliSeconds (50), 100);
+}
+
+Mipv6HandoffCalculator::~Mipv6HandoffCalculator ()
+{
+  NS_LOG_FUNCTION_NOARGS ();
+}
+
+void Mipv6HandoffCalculator::SetBins (Time width, uint32_t nBins)
+{
+  NS_LOG_FUNCTION (this << width << nBins);
+  NS_ASSERT (width.IsStrictlyPositive () && nBins > 0);
+
+  m_binWidth = width;
+  m_nBins = nBins;
+  for (uint8_t i = 0; i < PHASE_COUNT; i++)
+    {
+      m_bins[i].assign (nBins + 1, 0);
+      m_count[i] = 0;
+      m_sum[i] = Seconds (0);
+      m_max[i] = Seconds (0);
+    }
+}
+
+void Mipv6HandoffCalculator::AddSample (uint8_t phase, Time delay)
+{
+  NS_LOG_FUNCTION (this << (uint32_t) phase << delay);
+  NS_ASSERT (phase < PHASE_COUNT);
+
+  if (!m_enabled)
+    {
+      return;
+    }
+
+  uint64_t bin = delay.GetTimeStep () / m_binWidth.GetTimeStep ();
+  if (bin > m_nBins)
+    {
+      bin = m_nBins;
+    }
+  m_bins[phase][bin]++;
+  m_count[phase]++;
+  m_sum[phase] += delay;
+  if (delay > m_max[phase])
+    {
+      m_max[phase] = delay;
+    }
+}
+
+void Mipv6HandoffCalculator::AddSignaling (uint32_t bytes)
+{
+  NS_LOG_FUNCTION (this << bytes);
+
+  if (!m_enabled)
+    {
+      return;
+    }
+
+  m_signalingPackets++;
+  m_signalingBytes += bytes;
+}
+
+void Mipv6HandoffCalculator::AddIncomplete ()
+{
+  NS_LOG_FUNCTION (this);
+
+  if (!m_enabled)
+    {
+      return;
+    }
+
+  m_incomplete++;
+}
+
+uint32_t Mipv6HandoffCalculator::GetCount (uint8_t phase) const
+{
+  NS_ASSERT (phase < PHASE_COUNT);
+  return m_count[phase];
+}
+
+Time Mipv6HandoffCalculator::GetMean (uint8_t phase) const
+{
+  NS_ASSERT (phase < PHASE_COUNT);
+  if (m_count[phase] == 0)
+    {
+      return Seconds (0);
+    }
+  return TimeStep (m_sum[phase].GetTimeStep () / m_count[phase]);
+}
+
+Time Mipv6HandoffCalculator::GetMax (uint8_t phase) const
+{
+  NS_ASSERT (phase < PHASE_COUNT);
+  return m_max[phase];
+}
+
+uint32_t Mipv6HandoffCalculator::GetBinCount (uint8_t phase, uint32_t bin) const
+{
+  NS_ASSERT (phase < PHASE_COUNT && bin <= m_nBins);
+  return m_bins[phase][bin];
+}
+
+uint32_t Mipv6HandoffCalculator::GetNBins () const
+{
+  return m_nBins + 1;
+}
+
+uint32_t Mipv6HandoffCalculator::GetNHandoffs () const
+{
+  return m_count[FIRST_DATA];
+}
+
+uint32_t Mipv6HandoffCalculator::GetNIncomplete () const
+{
+  return m_incomplete;
+}
+
+uint32_t Mipv6HandoffCalculator::GetSignalingPackets () const
+{
+  return m_signalingPackets;
+}
+
+uint64_t Mipv6HandoffCalculator::GetSignalingBytes () const
+{
+  return m_signalingBytes;
+}
+
+std::string Mipv6HandoffCalculator::GetPhaseName (uint8_t phase)
+{
+  switch (phase)
+    {
+    case L2_DOWN:
+      return "l2-down";
+    case L2_UP:
+      return "l2-up";
+    case RA_RECEIVED:
+      return "ra";
+    case COA_READY:
+      return "coa";
+    case BU_SENT:
+      return "bu";
+    case BA_RECEIVED:
+      return "ba";
+    case FIRST_DATA:
+      return "first-data";
+    default:
+      return "unknown";
+    }
+}
+
+void Mipv6HandoffCalculator::Output (DataOutputCallback &callback) const
+{
+  NS_LOG_FUNCTION (this << &callback);
+
+  callback.OutputSingleton (m_context, m_key + "-handoffs", GetNHandoffs ());
+  callback.OutputSingleton (m_context, m_key + "-incomplete-handoffs", m_incomplete);
+  callback.OutputSingleton (m_context, m_key + "-signaling-packets", m_signalingPackets);
+  callback.OutputSingleton (m_context, m_key + "-signaling-bytes", (double) m_signalingBytes);
+
+  for (uint8_t i = 0; i < PHASE_COUNT; i++)
+    {
+      if (m_count[i] == 0)
+        {
+          continue;
+        }
+
+      std::string name = m_key + "-" + GetPhaseName (i);
+      callback.OutputSingleton (m_context, name + "-count", m_count[i]);
+      callback.OutputSingleton (m_context, name + "-mean", GetMean (i));
+      callback.OutputSingleton (m_context, name + "-max", m_max[i]);
+      for (uint32_t j = 0; j <= m_nBins; j++)
+        {
+          if (m_bins[i][j] != 0)
+            {
+              std::ostringstream bin;
+              bin << name << "-bin-" << j;
+              callback.OutputSingleton (m_context, bin.str (), m_bins[i][j]);
+            }
+        }
+    }
+}
+
+NS_OBJECT_ENSURE_REGISTERED (Mipv6Stats);
+
+TypeId Mipv6Stats::GetTypeId ()
+{
+  static TypeId tid = TypeId ("ns3::Mipv6Stats")
+    .SetParent<Object> ()
+    .SetGroupName ("Mipv6")
+    .AddConstructor<Mipv6Stats> ()
+    .AddAttribute ("Enabled", "Whether the handoff phases are recorded.",
+                   BooleanValue (true),
+                   MakeBooleanAccessor (&Mipv6Stats::m_enabled),
+                   MakeBooleanChecker ())
+    .AddAttribute ("BinWidth", "The width of a histogram bin.",
+                   TimeValue (MilliSeconds (50)),
+                   MakeTimeAccessor (&Mipv6Stats::m_binWidth),
+                   MakeTimeChecker ())
+    .AddAttribute ("NBins", "The number of histogram bins, an overflow bin is added.",
+                   UintegerValue (100),
+                   MakeUintegerAccessor (&Mipv6Stats::m_nBins),
+                   MakeUintegerChecker<uint32_t> (1))
+  ;
+  return tid;
+}
+
+Mipv6Stats::Mipv6Stats ()
+  : m_enabled (true),
+    m_nBins (100)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+}
+
+Mipv6Stats::~Mipv6Stats ()
+{
+  NS_LOG_FUNCTION_NOARGS ();
+}
+
+void Mipv6Stats::DoDispose ()
+{
+  NS_LOG_FUNCTION (this);
+  m_handoffs.clear ();
+  m_mnStats.clear ();
+  m_haStats.clear ();
+  Object::DoDispose ();
+}
+
+void Mipv6Stats::InstallMn (Ptr<Node> node)
+{
+  NS_LOG_FUNCTION (this << node);
+
+  Ptr<Mipv6Mn> mn = node->GetObject<Mipv6Mn> ();
+  NS_ASSERT_MSG (mn, "Mipv6Stats::InstallMn (): no Mipv6Mn on node " << node->GetId ());
+
+  std::ostringstream context;
+  context << node->GetId ();
+
+  FindMnStats (node->GetId ());
+
+  mn->TraceConnect ("RxRA", context.str (), MakeCallback (&Mipv6Stats::RxRa, this));
+  mn->TraceConnect ("NewCoA", context.str (), MakeCallback (&Mipv6Stats::NewCoa, this));
+  mn->TraceConnect ("TxBU", context.str (), MakeCallback (&Mipv6Stats::TxBu, this));
+  mn->TraceConnect ("RxBA", context.str (), MakeCallback (&Mipv6Stats::RxBa, this));
+
+  Ptr<Ipv6TunnelL4Protocol> tunnel = node->GetObject<Ipv6TunnelL4Protocol> ();
+  if (tunnel)
+    {
+      tunnel->TraceConnect ("RxMn", context.str (), MakeCallback (&Mipv6Stats::RxTunnel, this));
+    }
+
+  for (uint32_t i = 0; i < node->GetNDevices (); i++)
+    {
+      Ptr<NetDevice> device = node->GetDevice (i);
+      if (DynamicCast<LoopbackNetDevice> (device) || DynamicCast<TunnelNetDevice> (device))
+        {
+          continue;
+        }
+      device->AddLinkChangeCallback (MakeCallback (&Mipv6Stats::LinkChanged, this).Bind (device));
+    }
+}
+
+void Mipv6Stats::InstallMn (NodeContainer nodes)
+{
+  NS_LOG_FUNCTION (this);
+
+  for (NodeContainer::Iterator it = nodes.Begin (); it != nodes.End (); ++it)
+    {
+      InstallMn (*it);
+    }
+}
+
+void Mipv6Stats::InstallHa (Ptr<Node> node)
+{
+  NS_LOG_FUNCTION (this << node);
+
+  Ptr<Mipv6Ha> ha = node->GetObject<Mipv6Ha> ();
+  NS_ASSERT_MSG (ha, "Mipv6Stats::InstallHa (): no Mipv6Ha on node " << node->GetId ());
+
+  ha->TraceConnectWithoutContext ("RxBU", MakeCallback (&Mipv6Stats::RxBuHa, this));
+}
+
+Ptr<Mipv6HandoffCalculator> Mipv6Stats::GetMnStats (uint32_t nodeId) const
+{
+  std::map<uint32_t, Ptr<Mipv6HandoffCalculator> >::const_iterator it = m_mnStats.find (nodeId);
+  if (it == m_mnStats.end ())
+    {
+      return 0;
+    }
+  return it->second;
+}
+
+Ptr<Mipv6HandoffCalculator> Mipv6Stats::GetHaStats (Ipv6Address ha) const
+{
+  std::map<Ipv6Address, Ptr<Mipv6HandoffCalculator> >::const_iterator it = m_haStats.find (ha);
+  if (it == m_haStats.end ())
+    {
+      return 0;
+    }
+  return it->second;
+}
+
+void Mipv6Stats::Flush ()
+{
+  NS_LOG_FUNCTION (this);
+
+  for (std::map<uint32_t, Handoff>::iterator it = m_handoffs.begin (); it != m_handoffs.end (); ++it)
+    {
+      if (it->second.active)
+        {
+          Commit (it->first, it->second);
+        }
+    }
+}
+
+void Mipv6Stats::Export (DataCollector &collector)
+{
+  NS_LOG_FUNCTION (this);
+
+  Flush ();
+
+  for (std::map<uint32_t, Ptr<Mipv6HandoffCalculator> >::const_iterator it = m_mnStats.begin (); it != m_mnStats.end (); ++it)
+    {
+      collector.AddDataCalculator (it->second);
+    }
+  for (std::map<Ipv6Address, Ptr<Mipv6HandoffCalculator> >::const_iterator it = m_haStats.begin (); it != m_haStats.end (); ++it)
+    {
+      collector.AddDataCalculator (it->second);
+    }
+}
+
+Ptr<Mipv6HandoffCalculator> Mipv6Stats::FindMnStats (uint32_t nodeId)
+{
+  Ptr<Mipv6HandoffCalculator> &calc = m_mnStats[nodeId];
+  if (!calc)
+    {
+      std::ostringstream context;
+      context << "node[" << nodeId << "]";
+      calc = CreateObject<Mipv6HandoffCalculator> ();
+      calc->SetBins (m_binWidth, m_nBins);
+      calc->SetKey ("mipv6-mn");
+      calc->SetContext (context.str ());
+    }
+  return calc;
+}
+
+Ptr<Mipv6HandoffCalculator> Mipv6Stats::FindHaStats (Ipv6Address ha)
+{
+  Ptr<Mipv6HandoffCalculator> &calc = m_haStats[ha];
+  if (!calc)
+    {
+      std::ostringstream context;
+      context << "ha[" << ha << "]";
+      calc = CreateObject<Mipv6HandoffCalculator> ();
+      calc->SetBins (m_binWidth, m_nBins);
+      calc->SetKey ("mipv6-ha");
+      calc->SetContext (context.str ());
+    }
+  return calc;
+}
+
+uint32_t Mipv6Stats::GetNodeId (std::string context)
+{
+  return atoi (context.c_str ());
+}
+
+void Mipv6Stats::Record (uint32_t nodeId, uint8_t phase)
+{
+  NS_LOG_FUNCTION (this << nodeId << (uint32_t) phase);
+
+  Handoff &h = m_handoffs[nodeId];
+  Time now = Simulator::Now ();
+  bool movement = phase == Mipv6HandoffCalculator::L2_DOWN
+    || phase == Mipv6HandoffCalculator::L2_UP
+    || phase == Mipv6HandoffCalculator::RA_RECEIVED
+    || phase == Mipv6HandoffCalculator::COA_READY;
+
+  if (h.active
+      && (phase == Mipv6HandoffCalculator::L2_DOWN
+          || (h.seen[Mipv6HandoffCalculator::BA_RECEIVED]
+              && (movement || phase == Mipv6HandoffCalculator::BU_SENT))))
+    {
+      /* no data came through the binding before the MN moved again or
+         updated its binding */
+      Commit (nodeId, h);
+    }
+
+  if (!h.active)
+    {
+      /* only the movement itself starts a handoff, BU refreshes and
+         data on an established binding do not */
+      if (!movement)
+        {
+          return;
+        }
+      h.active = true;
+      h.start = now;
+      h.ha = Ipv6Address::GetAny ();
+      for (uint8_t i = 0; i < Mipv6HandoffCalculator::PHASE_COUNT; i++)
+        {
+          h.seen[i] = false;
+        }
+    }
+
+  if (h.seen[phase])
+    {
+      return;
+    }
+  if (phase == Mipv6HandoffCalculator::FIRST_DATA && !h.seen[Mipv6HandoffCalculator::BA_RECEIVED])
+    {
+      /* still flowing through the previous binding */
+      return;
+    }
+
+  h.time[phase] = now;
+  h.seen[phase] = true;
+
+  if (phase == Mipv6HandoffCalculator::FIRST_DATA)
+    {
+      Commit (nodeId, h);
+    }
+}
+
+void Mipv6Stats::Commit (uint32_t nodeId, Handoff &h)
+{
+  NS_LOG_FUNCTION (this << nodeId);
+
+  Ptr<Mipv6HandoffCalculator> mnStats = FindMnStats (nodeId);
+  Ptr<Mipv6HandoffCalculator> haStats = h.ha.IsAny () ? 0 : FindHaStats (h.ha);
+  for (uint8_t i = 0; i < Mipv6HandoffCalculator::PHASE_COUNT; i++)
+    {
+      if (h.seen[i])
+        {
+          mnStats->AddSample (i, h.time[i] - h.start);
+          if (haStats)
+            {
+              haStats->AddSample (i, h.time[i] - h.start);
+            }
+        }
+    }
+  if (!h.seen[Mipv6HandoffCalculator::FIRST_DATA])
+    {
+      mnStats->AddIncomplete ();
+      if (haStats)
+        {
+          haStats->AddIncomplete ();
+        }
+    }
+  h.active = false;
+}
+
+void Mipv6Stats::LinkChanged (Ptr<NetDevice> device)
+{
+  NS_LOG_FUNCTION (this << device);
+
+  if (!m_enabled)
+    {
+      return;
+    }
+  Record (device->GetNode ()->GetId (),
+          device->IsLinkUp () ? Mipv6HandoffCalculator::L2_UP : Mipv6HandoffCalculator::L2_DOWN);
+}
+
+void Mipv6Stats::RxRa (std::string context, Ipv6Address router, uint32_t interface)
+{
+  if (!m_enabled)
+    {
+      return;
+    }
+  Record (GetNodeId (context), Mipv6HandoffCalculator::RA_RECEIVED);
+}
+
+void Mipv6Stats::NewCoa (std::string context, Ipv6Address coa)
+{
+  if (!m_enabled)
+    {
+      return;
+    }
+  Record (GetNodeId (context), Mipv6HandoffCalculator::COA_READY);
+}
+
+void Mipv6Stats::TxBu (std::string context, Ptr<Packet> packet, Ipv6Address src, Ipv6Address dst)
+{
+  if (!m_enabled)
+    {
+      return;
+    }
+  uint32_t nodeId = GetNodeId (context);
+  FindMnStats (nodeId)->AddSignaling (packet->GetSize ());
+  Record (nodeId, Mipv6HandoffCalculator::BU_SENT);
+}
+
+void Mipv6Stats::RxBa (std::string context, Ptr<Packet> packet, Ipv6Address src, Ipv6Address dst, Ptr<Ipv6Interface> interface)
+{
+  if (!m_enabled)
+    {
+      return;
+    }
+  uint32_t nodeId = GetNodeId (context);
+  FindMnStats (nodeId)->AddSignaling (packet->GetSize ());
+
+  Handoff &h = m_handoffs[nodeId];
+  if (h.active && !h.seen[Mipv6HandoffCalculator::BA_RECEIVED])
+    {
+      h.ha = src;
+    }
+  Record (nodeId, Mipv6HandoffCalculator::BA_RECEIVED);
+}
+
+void Mipv6Stats::RxTunnel (std::string context, Ptr<Packet> packet, Ipv6Header inner, Ipv6Header outer, Ptr<Ipv6Interface> interface)
+{
+  if (!m_enabled)
+    {
+      return;
+    }
+  Record (GetNodeId (context), Mipv6HandoffCalculator::FIRST_DATA);
+}
+
+void Mipv6Stats::RxBuHa (Ptr<Packet> packet, Ipv6Address src, Ipv6Address dst, Ptr<Ipv6Interface> interface)
+{
+  if (!m_enabled)
+    {
+      return;
+    }
+  FindHaStats (dst)->AddSignaling (packet->GetSize ());
+}
+
+} /* namespace ns3 */
@@ -71,6 +71,7 @@ Ipv6TunnelL4Protocol::~Ipv6TunnelL4Protocol ()
 void Ipv6TunnelL4Protocol::DoDispose ()
 {
   m_node = 0;
+  m_ipv6 = 0;
   
   for ( TunnelMapI i = m_tunnelMap.begin(); i != m_tunnelMap.end(); i++ )
     {
@@ -94,6 +95,7 @@ void Ipv6TunnelL4Protocol::NotifyNewAggregate ()
           if (ipv6 != 0)
             {
               this->SetNode (node);
+              m_ipv6 = ipv6;
               ipv6->Insert (this);
             }
         }
@@ -122,7 +124,7 @@ int Ipv6TunnelL4Protocol::GetProtocolNumber () const
 void Ipv6TunnelL4Protocol::SendMessage (Ptr<Packet> packet, Ipv6Address src, Ipv6Address dst, uint8_t ttl)
 {
   NS_LOG_FUNCTION (this << packet << src << dst << (uint32_t)ttl);
-  Ptr<Ipv6L3Protocol> ipv6 = m_node->GetObject<Ipv6L3Protocol> ();
+  Ptr<Ipv6L3Protocol> ipv6 = m_ipv6;
   SocketIpTtlTag tag;
   NS_ASSERT (ipv6 != 0);
 
@@ -133,7 +135,7 @@ void Ipv6TunnelL4Protocol::SendMessage (Ptr<Packet> packet, Ipv6Address src, Ipv
 
 enum IpL4Protocol::RxStatus Ipv6TunnelL4Protocol::Receive(Ptr<Packet> p, Ipv6Header const &header, Ptr<Ipv6Interface> incomingInterface)
 {
-  Ptr<Ipv6L3Protocol> ipv6 = GetNode()->GetObject<Ipv6L3Protocol>();
+  Ptr<Ipv6L3Protocol> ipv6 = m_ipv6;
   NS_ASSERT (ipv6 != 0);
   Ipv6Address src=header.GetSourceAddress ();
   /**
@@ -240,7 +242,7 @@ uint16_t Ipv6TunnelL4Protocol::AddTunnel(Ipv6Address remote, Ipv6Address local)
     }
     
   dev->IncreaseRefCount ();
-  Ptr<Ipv6> ipv6 = m_node->GetObject<Ipv6> ();
+  Ptr<Ipv6> ipv6 = m_ipv6;
   int32_t ifIndex = -1;
   ifIndex = ipv6->GetInterfaceForDevice (dev);
   
@@ -29,6 +29,7 @@
 namespace ns3 {
 
 class Node;
+class Ipv6L3Protocol;
 class Packet;
 
 /**
@@ -229,6 +230,11 @@ private:
    */
   Ptr<Node> m_node;
 
+  /**
+   * \brief The IPv6 protocol of the node.
+   */
+  Ptr<Ipv6L3Protocol> m_ipv6;
+
   /**
    * \brief create a tunnel map.
   */
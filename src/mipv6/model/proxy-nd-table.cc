@@ -0,0 +1,253 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2017 Jadavpur University, India
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/log.h"
+#include "ns3/assert.h"
+#include "ns3/net-device.h"
+#include "ns3/ipv6-l3-protocol.h"
+#include "ns3/icmpv6-l4-protocol.h"
+#include "proxy-nd-table.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("ProxyNdTable");
+NS_OBJECT_ENSURE_REGISTERED (ProxyNdTable);
+
+TypeId ProxyNdTable::GetTypeId ()
+{
+  static TypeId tid = TypeId ("ns3::ProxyNdTable")
+    .SetParent<Object> ();
+  return tid;
+}
+
+ProxyNdTable::ProxyNdTable ()
+{
+  NS_LOG_FUNCTION_NOARGS ();
+}
+
+ProxyNdTable::~ProxyNdTable ()
+{
+  NS_LOG_FUNCTION_NOARGS ();
+}
+
+void ProxyNdTable::DoDispose ()
+{
+  NS_LOG_FUNCTION (this);
+  Flush ();
+  m_node = 0;
+  Object::DoDispose ();
+}
+
+Ptr<Node> ProxyNdTable::GetNode () const
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  return m_node;
+}
+
+void ProxyNdTable::SetNode (Ptr<Node> node)
+{
+  NS_LOG_FUNCTION (this << node);
+  m_node = node;
+}
+
+ProxyNdTable::Entry *ProxyNdTable::Add (Ipv6Address target, Ipv6Address source, uint32_t interface)
+{
+  NS_LOG_FUNCTION (this << target << source << interface);
+
+  Ptr<Ipv6L3Protocol> ipv6 = m_node->GetObject<Ipv6L3Protocol> ();
+  NS_ASSERT (ipv6);
+
+  Entry entry (target, source, interface,
+               ipv6->GetNetDevice (interface)->GetAddress (),
+               ipv6->IsForwarding (interface));
+
+  ProxyNdKey_t key = std::make_pair (interface, target);
+  ProxyNdTableEntriesI it = m_entries.find (key);
+  if (it != m_entries.end ())
+    {
+      /* the group is already joined */
+      entry.SetNsDadUid (it->second.GetNsDadUid ());
+      it->second = entry;
+      return &it->second;
+    }
+
+  it = m_entries.insert (std::make_pair (key, entry)).first;
+  m_targets[target]++;
+  JoinGroup (entry.GetSolicitedAddress (), interface);
+  return &it->second;
+}
+
+void ProxyNdTable::Remove (Ipv6Address target, uint32_t interface)
+{
+  NS_LOG_FUNCTION (this << target << interface);
+
+  ProxyNdTableEntriesI it = m_entries.find (std::make_pair (interface, target));
+  if (it == m_entries.end ())
+    {
+      return;
+    }
+
+  LeaveGroup (it->second.GetSolicitedAddress (), interface);
+  m_entries.erase (it);
+
+  ProxyNdTargets_t::iterator count = m_targets.find (target);
+  if (--count->second == 0)
+    {
+      m_targets.erase (count);
+    }
+}
+
+ProxyNdTable::Entry *ProxyNdTable::Lookup (Ipv6Address target, uint32_t interface)
+{
+  NS_LOG_FUNCTION (this << target << interface);
+
+  ProxyNdTableEntriesI it = m_entries.find (std::make_pair (interface, target));
+  if (it != m_entries.end ())
+    {
+      return &it->second;
+    }
+  return 0;
+}
+
+bool ProxyNdTable::IsDefended (Ipv6Address target) const
+{
+  NS_LOG_FUNCTION (this << target);
+  return m_targets.find (target) != m_targets.end ();
+}
+
+uint32_t ProxyNdTable::GetNEntries () const
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  return m_entries.size ();
+}
+
+void ProxyNdTable::Flush ()
+{
+  NS_LOG_FUNCTION (this);
+
+  for (ProxyNdTableEntriesI it = m_entries.begin (); it != m_entries.end (); ++it)
+    {
+      LeaveGroup (it->second.GetSolicitedAddress (), it->second.GetInterface ());
+    }
+  m_entries.clear ();
+  m_targets.clear ();
+}
+
+void ProxyNdTable::JoinGroup (Ipv6Address group, uint32_t interface)
+{
+  NS_LOG_FUNCTION (this << group << interface);
+
+  SolicitedGroupKey_t key = std::make_pair (group, interface);
+  if (m_groups[key]++ == 0)
+    {
+      m_node->GetObject<Ipv6L3Protocol> ()->AddMulticastAddress (group, interface);
+    }
+}
+
+void ProxyNdTable::LeaveGroup (Ipv6Address group, uint32_t interface)
+{
+  NS_LOG_FUNCTION (this << group << interface);
+
+  SolicitedGroupKey_t key = std::make_pair (group, interface);
+  SolicitedGroups_t::iterator it = m_groups.find (key);
+  if (it == m_groups.end ())
+    {
+      return;
+    }
+
+  if (--it->second == 0)
+    {
+      m_groups.erase (it);
+      Ptr<Ipv6L3Protocol> ipv6 = m_node ? m_node->GetObject<Ipv6L3Protocol> () : 0;
+      if (ipv6)
+        {
+          ipv6->RemoveMulticastAddress (group, interface);
+        }
+    }
+}
+
+ProxyNdTable::Entry::Entry (Ipv6Address target, Ipv6Address source, uint32_t interface, Address lla, bool router)
+  : m_target (target),
+    m_solicited (Ipv6Address::MakeSolicitedAddress (target)),
+    m_source (source),
+    m_interface (interface),
+    m_nsDadUid (0)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+
+  /* we give our mac address in response */
+  Icmpv6OptionLinkLayerAddress llOption (0, lla);
+  m_option = Create<Packet> ();
+  m_option->AddHeader (llOption);
+
+  m_na.SetIpv6Target (target);
+  m_na.SetFlagO (true);
+  m_na.SetFlagR (router);
+
+  m_ipHeader.SetSourceAddress (source);
+  m_ipHeader.SetNextHeader (Icmpv6L4Protocol::PROT_NUMBER);
+  m_ipHeader.SetHopLimit (255);
+}
+
+Ipv6Address ProxyNdTable::Entry::GetTarget () const
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  return m_target;
+}
+
+Ipv6Address ProxyNdTable::Entry::GetSolicitedAddress () const
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  return m_solicited;
+}
+
+uint32_t ProxyNdTable::Entry::GetInterface () const
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  return m_interface;
+}
+
+void ProxyNdTable::Entry::SetNsDadUid (uint32_t uid)
+{
+  NS_LOG_FUNCTION (this << uid);
+  m_nsDadUid = uid;
+}
+
+uint32_t ProxyNdTable::Entry::GetNsDadUid () const
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  return m_nsDadUid;
+}
+
+NdiscCache::Ipv6PayloadHeaderPair ProxyNdTable::Entry::ForgeNA (Ipv6Address dst, bool solicited) const
+{
+  NS_LOG_FUNCTION (this << dst << solicited);
+
+  Ptr<Packet> p = m_option->Copy ();
+  Icmpv6NA na = m_na;
+  na.SetFlagS (solicited);
+  na.CalculatePseudoHeaderChecksum (m_source, dst, p->GetSize () + na.GetSerializedSize (), Icmpv6L4Protocol::PROT_NUMBER);
+  p->AddHeader (na);
+
+  Ipv6Header ipHeader = m_ipHeader;
+  ipHeader.SetDestinationAddress (dst);
+  ipHeader.SetPayloadLength (p->GetSize ());
+  return NdiscCache::Ipv6PayloadHeaderPair (p, ipHeader);
+}
+
+} /* namespace ns3 */
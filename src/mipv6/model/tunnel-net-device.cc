@@ -130,6 +130,8 @@ TunnelNetDevice::~TunnelNetDevice ()
 void TunnelNetDevice::DoDispose ()
 {
   m_node = 0;
+  m_ipv6 = 0;
+  m_remoteSelector = MakeNullCallback<Ipv6Address, Ptr<const Packet> > ();
   NetDevice::DoDispose ();
 }
 
@@ -161,6 +163,13 @@ void TunnelNetDevice::SetRemoteAddress (Ipv6Address raddr)
   m_remoteAddress = raddr;
 }
 
+void TunnelNetDevice::SetRemoteSelector (Callback<Ipv6Address, Ptr<const Packet> > selector)
+{
+  NS_LOG_FUNCTION (this);
+
+  m_remoteSelector = selector;
+}
+
 void TunnelNetDevice::IncreaseRefCount ()
 {
   NS_LOG_FUNCTION (this);
@@ -331,12 +340,20 @@ TunnelNetDevice::Send (Ptr<Packet> packet, const Address& dest, uint16_t protoco
       return true;
 
     }
-  Ptr<Ipv6L3Protocol> ipv6 = GetNode ()->GetObject<Ipv6L3Protocol>();
+  Ptr<Ipv6L3Protocol> ipv6 = m_ipv6;
   NS_ASSERT (ipv6 != 0 && ipv6->GetRoutingProtocol () != 0);
   NS_ASSERT ( !m_remoteAddress.IsAny () );
 
   Ipv6Address src = m_localAddress;
   Ipv6Address dst = m_remoteAddress;
+  if (!m_remoteSelector.IsNull ())
+    {
+      Ipv6Address selected = m_remoteSelector (packet);
+      if (!selected.IsAny ())
+        {
+          dst = selected;
+        }
+    }
   SocketIpTtlTag tag;
   uint8_t ttl = 64;
   m_macTxTrace (packet);
@@ -383,7 +400,7 @@ TunnelNetDevice::SendFrom (Ptr<Packet> packet, const Address& source, const Addr
 
   NS_ASSERT (m_supportsSendFrom);
 
-  Ptr<Ipv6L3Protocol> ipv6 = GetNode ()->GetObject<Ipv6L3Protocol>();
+  Ptr<Ipv6L3Protocol> ipv6 = m_ipv6;
   NS_ASSERT (ipv6 != 0 && ipv6->GetRoutingProtocol () != 0);
   NS_ASSERT ( !m_remoteAddress.IsAny () );
 
@@ -447,6 +464,7 @@ void
 TunnelNetDevice::SetNode (Ptr<Node> node)
 {
   m_node = node;
+  m_ipv6 = node->GetObject<Ipv6L3Protocol> ();
 }
 
 bool
@@ -31,6 +31,7 @@
 
 namespace ns3 {
 
+class Ipv6L3Protocol;
 
 /**
  * \class TunnelNetDevice
@@ -103,6 +104,15 @@ public:
    */
   void SetRemoteAddress (Ipv6Address raddr);
 
+  /**
+   * \brief set a callback selecting the remote address per packet.
+   *
+   * When the callback returns a non-any address, it overrides the
+   * remote address for that packet (used for flow bindings).
+   * \param selector remote address selector
+   */
+  void SetRemoteSelector (Callback<Ipv6Address, Ptr<const Packet> > selector);
+
   /**
    * \brief increase ref count.
   */
@@ -207,6 +217,10 @@ private:
    * \brief node which contains this device.
    */
   Ptr<Node> m_node;
+  /**
+   * \brief IPv6 protocol of the node, bound when the device is added to it.
+   */
+  Ptr<Ipv6L3Protocol> m_ipv6;
   /**
    * \brief received packet callback variable.
    */
@@ -248,6 +262,10 @@ private:
    * \brief remote address.
   */
   Ipv6Address m_remoteAddress;
+  /**
+   * \brief per-packet remote address selector.
+  */
+  Callback<Ipv6Address, Ptr<const Packet> > m_remoteSelector;
   /**
    * \brief ref count.
   */
@@ -0,0 +1,169 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <cmath>
+#include <limits>
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/mobility-module.h"
+#include "ns3/lte-module.h"
+#include "ns3/mipv6-module.h"
+#include "ns3/mih-lte-link-adapter.h"
+
+
+/* *
+   * Scenario: an LTE UE moves away from its eNB
+
+                 Class: MihLteTestCase
+
+   * Pass criteria: 1) the UE device has an LTE link adapter,
+                    2) Link_Up is notified once the RRC connection is established,
+                    3) the serving cell RSRP is reported, and decreases as the UE moves away,
+                    4) Link_Going_Down is notified once it falls below the threshold.
+
+* */
+
+using namespace ns3;
+
+class MihLteTestCase : public TestCase
+{
+public:
+  MihLteTestCase ();
+  virtual ~MihLteTestCase ();
+
+  /**
+   * \brief trace the link events of the UE.
+   * \param: event the event
+   * \param: device the device of the link
+   * \param: signal the signal of the link
+   */
+  void LinkEvent (uint8_t event, Ptr<NetDevice> device, double signal);
+
+  /**
+   * \brief record the signal of the link.
+   */
+  void SampleSignal (void);
+
+private:
+  virtual void DoRun (void);
+  Ptr<MihFunction> mih;
+  Ptr<NetDevice> dev;        // the LTE device of the UE
+  Time linkup;               // the first Link_Up
+  Time goingdown;            // the first Link_Going_Down
+  double signal_linkup;      // the signal 10 ms after Link_Up
+  double signal_end;         // the signal at the last sample
+};
+
+MihLteTestCase::MihLteTestCase ()
+  : TestCase ("Test the MIH link events of an LTE UE")
+{
+  signal_linkup = std::numeric_limits<double>::quiet_NaN ();
+  signal_end = std::numeric_limits<double>::quiet_NaN ();
+}
+
+MihLteTestCase::~MihLteTestCase ()
+{
+}
+
+void
+MihLteTestCase::DoRun (void)
+{
+  NodeContainer enb;
+  enb.Create (1);
+  NodeContainer ue;
+  ue.Create (1);
+
+  MobilityHelper mobility;
+  mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+  mobility.Install (enb);
+  mobility.SetMobilityModel ("ns3::ConstantVelocityMobilityModel");
+  mobility.Install (ue);
+  enb.Get (0)->GetObject<MobilityModel> ()->SetPosition (Vector (0, 0, 0));
+  ue.Get (0)->GetObject<MobilityModel> ()->SetPosition (Vector (100, 0, 0));
+  // with Friis and 30 dBm, the RSRP goes from about -74 dBm to -95 dBm
+  ue.Get (0)->GetObject<ConstantVelocityMobilityModel> ()->SetVelocity (Vector (1000, 0, 0));
+
+  Ptr<LteHelper> lteHelper = CreateObject<LteHelper> ();
+  NetDeviceContainer enbDevs = lteHelper->InstallEnbDevice (enb);
+  NetDeviceContainer ueDevs = lteHelper->InstallUeDevice (ue);
+  dev = ueDevs.Get (0);
+
+  MihHelper mihHelper;
+  mihHelper.SetLteAttribute ("GoingDownThreshold", DoubleValue (-85.0));
+  mih = mihHelper.Install (ue.Get (0));
+  NS_TEST_ASSERT_MSG_EQ (mih->GetNLinks (), 1, "The UE device should have a link adapter");
+  NS_TEST_ASSERT_MSG_NE (DynamicCast<MihLteLinkAdapter> (mih->GetLink (dev)), 0, "The link adapter should be an LTE one");
+
+  lteHelper->Attach (ueDevs, enbDevs.Get (0));
+
+  mih->TraceConnectWithoutContext ("LinkEvent", MakeCallback (&MihLteTestCase::LinkEvent, this));
+  Simulator::Schedule (Seconds (1.0), &MihLteTestCase::SampleSignal, this);
+
+  Simulator::Stop (Seconds (1.0));
+  Simulator::Run ();
+
+  NS_TEST_ASSERT_MSG_GT (linkup, Seconds (0.0), "The link should go up once the RRC connection is established");
+  NS_TEST_ASSERT_MSG_LT (linkup, Seconds (0.2), "The link should go up once the RRC connection is established");
+  NS_TEST_ASSERT_MSG_GT (signal_linkup, -85.0, "The RSRP near the eNB should be reported");
+  NS_TEST_ASSERT_MSG_EQ_TOL (signal_end, -95.0, 1.0, "The RSRP far from the eNB should be reported");
+  NS_TEST_ASSERT_MSG_GT (goingdown, linkup, "The link should go down once the UE moves away");
+  NS_TEST_ASSERT_MSG_EQ (mih->GetLink (dev)->IsLinkUp (), true, "The link should still be up");
+
+  mih = 0;
+  dev = 0;
+  Simulator::Destroy ();
+}
+
+void MihLteTestCase::LinkEvent (uint8_t event, Ptr<NetDevice> device, double signal)
+{
+  if (event == MihFunction::LINK_UP && device == dev && linkup.IsZero ())
+    {
+      linkup = Simulator::Now ();
+      // the first RSRP of the serving cell comes with the first subframes
+      Simulator::Schedule (MilliSeconds (10), &MihLteTestCase::SampleSignal, this);
+    }
+  else if (event == MihFunction::LINK_GOING_DOWN && device == dev && goingdown.IsZero ())
+    {
+      goingdown = Simulator::Now ();
+    }
+}
+
+void MihLteTestCase::SampleSignal (void)
+{
+  double signal = mih->GetLink (dev)->GetSignal ();
+  if (std::isnan (signal_linkup))
+    {
+      signal_linkup = signal;
+    }
+  signal_end = signal;
+}
+
+/**
+ * \brief MIH LTE test suite
+ */
+class MihLteTestSuite : public TestSuite
+{
+  public:
+    MihLteTestSuite ();
+};
+
+MihLteTestSuite::MihLteTestSuite ()
+  : TestSuite ("mipv6-mih-lte", UNIT)
+{
+  AddTestCase (new MihLteTestCase, TestCase::QUICK);
+}
+
+static MihLteTestSuite mihltetestsuite;
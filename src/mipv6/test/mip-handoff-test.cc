@@ -617,6 +617,289 @@ void HandoffTestCase::SetCallbacks ()
   mipmn->TraceConnectWithoutContext ("RxBA", MakeCallback (&HandoffTestCase::RxBA, this));
 }
 
+/* *
+   * Scenario: make-before-break handoff
+
+                 Class: MakeBeforeBreakTestCase
+
+   * The MN has a wifi interface on each AR, each AR on its own channel. It registers the CoA of AR1,
+     then moves towards AR2 while staying associated with AR1.
+
+   * Pass criteria: 1) The Link_Going_Down of the link of AR1 is followed by a BA for the CoA of AR2,
+                       received while the MN is still associated with AR1, and
+                    2) the CN packets reach the MN through AR2 after this BA.
+* */
+
+class MakeBeforeBreakTestCase : public TestCase
+{
+public:
+  MakeBeforeBreakTestCase ();
+  virtual ~MakeBeforeBreakTestCase ();
+
+  /**
+   * \brief trace the link events of the MN.
+   * \param: event the event
+   * \param: device the device of the link
+   * \param: signal the signal of the link
+   */
+  void LinkEvent (uint8_t event, Ptr<NetDevice> device, double signal);
+
+  /**
+   * \brief trace ba packets received by MN
+   * \param: packet ba packet
+   * \param: src source address
+   * \param: dst destination address
+   * \param: interface interface which receives that packet
+   */
+  void RxBA (Ptr<Packet> packet, Ipv6Address src, Ipv6Address dst, Ptr<Ipv6Interface> interface);
+
+  /**
+   * \brief trace packets received at the MN tunnel end point
+   * \param: p original packet
+   * \param: ih IPv6 inner header
+   * \param: oh IPv6 outer header
+   * \param: i interface which receives that packet
+   */
+  void RxPktAtTun (Ptr<Packet> p, Ipv6Header ih, Ipv6Header oh, Ptr<Ipv6Interface> i);
+
+private:
+  virtual void DoRun (void);
+  Ptr<Node> mn;
+  Ptr<MihFunction> mih;
+  Ptr<NetDevice> dev1;       // the wifi device of the MN on AR1
+  Ptr<NetDevice> dev2;       // the wifi device of the MN on AR2
+  Time goingdown;            // the first Link_Going_Down of the link of AR1
+  bool registered_ar1;       // whether the last BA before was for the CoA of AR1
+  Time bafar2;               // the first BA for the CoA of AR2 after it
+  bool linkup_at_ba;         // whether the link of AR1 was still up then
+  uint64_t pktcounter_ar2;   // packets received through AR2 after that BA
+};
+
+MakeBeforeBreakTestCase::MakeBeforeBreakTestCase ()
+  : TestCase ("Test a make-before-break handoff on the MIH link events")
+{
+  registered_ar1 = false;
+  linkup_at_ba = false;
+  pktcounter_ar2 = 0;
+}
+
+MakeBeforeBreakTestCase::~MakeBeforeBreakTestCase ()
+{
+}
+
+void
+MakeBeforeBreakTestCase::DoRun (void)
+{
+/*
+                                     -----
+                                    | CN |
+                                     -----
+                                   p2p | 1111::/64
+                                       |
+                                     -----
+                                    | HA |
+                                     -----
+                                      /\
+                        2222::/64   /    \ 3333::/64
+                                  / p2p    \ p2p
+                                /            \
+                            -----          -----
+                           | AR1 |        | AR2 |
+                            -----          -----
+                    4444::/64 ^              ^ 5555::/64
+                    channel 1 ^              ^ channel 2
+                               ------
+                               | MN | ====> 5 m/s
+                               ------
+*/
+
+  NodeContainer n, sta;
+  n.Create (4);
+  sta.Create (1);
+  mn = sta.Get (0);
+
+  InternetStackHelper internet;
+  internet.Install (n);
+  internet.Install (sta);
+
+  MobilityHelper mobility;
+  Ptr<ListPositionAllocator> positionAlloc = CreateObject<ListPositionAllocator> ();
+  positionAlloc->Add (Vector (30.0, -40.0, 0.0));  //CN
+  positionAlloc->Add (Vector (30.0, -20.0, 0.0));  //HA
+  positionAlloc->Add (Vector (0.0, 0.0, 0.0));     //AR1
+  positionAlloc->Add (Vector (60.0, 0.0, 0.0));    //AR2
+  mobility.SetPositionAllocator (positionAlloc);
+  mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+  mobility.Install (n);
+
+  positionAlloc = CreateObject<ListPositionAllocator> ();
+  positionAlloc->Add (Vector (25.0, 0.0, 0.0));  //MN, in range of both ARs
+  mobility.SetPositionAllocator (positionAlloc);
+  mobility.SetMobilityModel ("ns3::ConstantVelocityMobilityModel");
+  mobility.Install (sta);
+
+  // the beacons of AR1 fall below the going down threshold of the wifi
+  // adapter about 45 m away from it, the association is lost about 150 m away
+  Ptr<ConstantVelocityMobilityModel> cvm = mn->GetObject<ConstantVelocityMobilityModel> ();
+  Simulator::Schedule (Seconds (6.0), &ConstantVelocityMobilityModel::SetVelocity, cvm, Vector (5, 0, 0));
+  Simulator::Schedule (Seconds (13.0), &ConstantVelocityMobilityModel::SetVelocity, cvm, Vector (0, 0, 0));
+
+  PointToPointHelper pointToPoint;
+  pointToPoint.SetDeviceAttribute ("DataRate", StringValue ("100Mbps"));
+  pointToPoint.SetChannelAttribute ("Delay", StringValue ("2ms"));
+
+  NetDeviceContainer d1 = pointToPoint.Install (n.Get (0), n.Get (1));
+  NetDeviceContainer d2 = pointToPoint.Install (n.Get (1), n.Get (2));
+  NetDeviceContainer d3 = pointToPoint.Install (n.Get (1), n.Get (3));
+
+  Ipv6AddressHelper ipv6;
+  ipv6.SetBase (Ipv6Address ("1111::"), Ipv6Prefix (64));
+  Ipv6InterfaceContainer iifc1 = ipv6.Assign (d1);
+  iifc1.SetForwarding (0, true);
+  iifc1.SetDefaultRouteInAllNodes (0);
+  iifc1.SetForwarding (1, true);
+  iifc1.SetDefaultRouteInAllNodes (1);
+
+  ipv6.SetBase (Ipv6Address ("2222::"), Ipv6Prefix (64));
+  Ipv6InterfaceContainer iifc2 = ipv6.Assign (d2);
+  iifc2.SetForwarding (0, true);
+  iifc2.SetForwarding (1, true);
+
+  ipv6.SetBase (Ipv6Address ("3333::"), Ipv6Prefix (64));
+  Ipv6InterfaceContainer iifc3 = ipv6.Assign (d3);
+  iifc3.SetForwarding (0, true);
+  iifc3.SetForwarding (1, true);
+
+  // one channel and SSID per AR, a station of the MN on each
+  YansWifiPhyHelper wifiPhy = YansWifiPhyHelper::Default ();
+  YansWifiChannelHelper wifiChannel = YansWifiChannelHelper::Default ();
+  WifiHelper wifi;
+  NqosWifiMacHelper wifiMac = NqosWifiMacHelper::Default ();
+  NetDeviceContainer d4, d5, d6;
+  for (uint32_t i = 0; i < 2; i++)
+    {
+      Ssid ssid = Ssid (i == 0 ? "ar1" : "ar2");
+      wifiPhy.SetChannel (wifiChannel.Create ());
+      wifiMac.SetType ("ns3::ApWifiMac",
+                       "Ssid", SsidValue (ssid),
+                       "BeaconGeneration", BooleanValue (true),
+                       "BeaconInterval", TimeValue (MilliSeconds (100)));
+      (i == 0 ? d4 : d5) = wifi.Install (wifiPhy, wifiMac, n.Get (2 + i));
+      wifiMac.SetType ("ns3::StaWifiMac",
+                       "Ssid", SsidValue (ssid),
+                       "ActiveProbing", BooleanValue (false));
+      d6.Add (wifi.Install (wifiPhy, wifiMac, mn));
+    }
+  dev1 = d6.Get (0);
+  dev2 = d6.Get (1);
+
+  ipv6.SetBase (Ipv6Address ("4444::"), Ipv6Prefix (64));
+  Ipv6InterfaceContainer iifc4 = ipv6.Assign (d4);
+  iifc4.SetForwarding (0, true);
+  ipv6.SetBase (Ipv6Address ("5555::"), Ipv6Prefix (64));
+  Ipv6InterfaceContainer iifc5 = ipv6.Assign (d5);
+  iifc5.SetForwarding (0, true);
+  ipv6.AssignWithoutAddress (d6);
+
+  // AR2 advertises its prefix first, so that the CoA of AR1 is registered last
+  Ptr<Radvd> radvd1 = CreateObject<Radvd> ();
+  Ptr<RadvdInterface> routerInterface1 = Create<RadvdInterface> (iifc4.GetInterfaceIndex (0), 1500, 50);
+  routerInterface1->AddPrefix (Create<RadvdPrefix> (Ipv6Address ("4444::"), 64));
+  radvd1->AddConfiguration (routerInterface1);
+  n.Get (2)->AddApplication (radvd1);
+  radvd1->SetStartTime (Seconds (3.0));
+  radvd1->SetStopTime (Seconds (20.0));
+
+  Ptr<Radvd> radvd2 = CreateObject<Radvd> ();
+  Ptr<RadvdInterface> routerInterface2 = Create<RadvdInterface> (iifc5.GetInterfaceIndex (0), 1500, 50);
+  routerInterface2->AddPrefix (Create<RadvdPrefix> (Ipv6Address ("5555::"), 64));
+  radvd2->AddConfiguration (routerInterface2);
+  n.Get (3)->AddApplication (radvd2);
+  radvd2->SetStartTime (Seconds (1.0));
+  radvd2->SetStopTime (Seconds (20.0));
+
+  Ipv6StaticRoutingHelper routingHelper;
+  Ptr<Ipv6StaticRouting> rttop = routingHelper.GetStaticRouting (n.Get (1)->GetObject<Ipv6> ());
+  rttop->AddNetworkRouteTo (Ipv6Address ("4444::"), Ipv6Prefix (64), iifc2.GetAddress (1, 1), 2, 0);
+  rttop->AddNetworkRouteTo (Ipv6Address ("5555::"), Ipv6Prefix (64), iifc3.GetAddress (1, 1), 3, 0);
+  rttop = routingHelper.GetStaticRouting (n.Get (2)->GetObject<Ipv6> ());
+  rttop->SetDefaultRoute (iifc2.GetAddress (0, 1), 1);
+  rttop = routingHelper.GetStaticRouting (n.Get (3)->GetObject<Ipv6> ());
+  rttop->SetDefaultRoute (iifc3.GetAddress (0, 1), 1);
+
+  Mipv6HaHelper hh;
+  hh.Install (n.Get (1));
+  Mipv6MnHelper mh (hh.GetHomeAgentAddressList (), false);
+  mh.Install (mn);
+  MihHelper mihHelper;
+  mih = mihHelper.Install (mn);
+  NS_TEST_ASSERT_MSG_EQ (mih->GetNLinks (), 2, "Both stations of the MN should have a link adapter");
+
+  Ptr<Mipv6Mn> mipmn = mn->GetObject<Mipv6Mn> ();
+  UdpServerHelper server (5000);
+  ApplicationContainer serverapps = server.Install (mn);
+  serverapps.Start (Seconds (5));
+  serverapps.Stop (Seconds (19));
+
+  UdpClientHelper client (mipmn->GetHomeAddress (), 5000);
+  client.SetAttribute ("MaxPackets", UintegerValue (50000));
+  client.SetAttribute ("Interval", TimeValue (MilliSeconds (50)));
+  client.SetAttribute ("PacketSize", UintegerValue (1024));
+  ApplicationContainer clientapps = client.Install (n.Get (0));
+  clientapps.Start (Seconds (5));
+  clientapps.Stop (Seconds (19));
+
+  mih->TraceConnectWithoutContext ("LinkEvent", MakeCallback (&MakeBeforeBreakTestCase::LinkEvent, this));
+  mipmn->TraceConnectWithoutContext ("RxBA", MakeCallback (&MakeBeforeBreakTestCase::RxBA, this));
+  mn->GetObject<Ipv6TunnelL4Protocol> ()->TraceConnectWithoutContext ("RxMn", MakeCallback (&MakeBeforeBreakTestCase::RxPktAtTun, this));
+
+  Simulator::Stop (Seconds (20.0));
+  Simulator::Run ();
+
+  NS_TEST_ASSERT_MSG_GT (goingdown, Seconds (6.0), "The link of AR1 should go down once the MN moves");
+  NS_TEST_ASSERT_MSG_EQ (registered_ar1, true, "The CoA of AR1 should be registered before the MN moves");
+  NS_TEST_ASSERT_MSG_GT (bafar2, goingdown, "The CoA of AR2 should be registered once the link of AR1 goes down");
+  NS_TEST_ASSERT_MSG_EQ (linkup_at_ba, true, "The CoA of AR2 should be registered before the link of AR1 is lost");
+  NS_TEST_ASSERT_MSG_GT (pktcounter_ar2, 0, "The packets should reach the MN through AR2");
+
+  mn = 0;
+  mih = 0;
+  dev1 = 0;
+  dev2 = 0;
+  Simulator::Destroy ();
+}
+
+void MakeBeforeBreakTestCase::LinkEvent (uint8_t event, Ptr<NetDevice> device, double signal)
+{
+  if (event == MihFunction::LINK_GOING_DOWN && device == dev1 && goingdown.IsZero ())
+    {
+      goingdown = Simulator::Now ();
+    }
+}
+
+void MakeBeforeBreakTestCase::RxBA (Ptr<Packet> packet, Ipv6Address src, Ipv6Address dst, Ptr<Ipv6Interface> interface)
+{
+  Ptr<Mipv6Mn> mipmn = mn->GetObject<Mipv6Mn> ();
+  Ipv6Address prefix = mipmn->GetCoA ().CombinePrefix (Ipv6Prefix (64));
+  if (goingdown.IsZero ())
+    {
+      registered_ar1 = prefix == Ipv6Address ("4444::");
+    }
+  else if (bafar2.IsZero () && prefix == Ipv6Address ("5555::"))
+    {
+      bafar2 = Simulator::Now ();
+      linkup_at_ba = mih->GetLink (dev1)->IsLinkUp ();
+    }
+}
+
+void MakeBeforeBreakTestCase::RxPktAtTun (Ptr<Packet> p, Ipv6Header ih, Ipv6Header oh, Ptr<Ipv6Interface> i)
+{
+  if (!bafar2.IsZero () && i->GetDevice () == dev2)
+    {
+      pktcounter_ar2++;
+    }
+}
+
 /**
  * \brief test suite 2
  */
@@ -630,6 +913,7 @@ Mipv6TestSuite2::Mipv6TestSuite2 ()
   : TestSuite ("mipv6-test2", UNIT)
 {
   AddTestCase (new HandoffTestCase, TestCase::QUICK);
+  AddTestCase (new MakeBeforeBreakTestCase, TestCase::QUICK);
 }
 
 static Mipv6TestSuite2 mipv6testsuite;
@@ -616,6 +616,494 @@ void NoHandoffTestCase::SetCallbacks ()
   mipmn->TraceConnectWithoutContext ("RxBA", MakeCallback(&NoHandoffTestCase::RxBA, this));
 }
 
+/**
+ * \brief BID and flow identification mobility options (RFC 5648, RFC 6089)
+ * carried by a BU are read back by the HA and registered in its binding
+ * cache.
+ */
+class McoaOptionTestCase : public TestCase
+{
+public:
+  McoaOptionTestCase ();
+  virtual ~McoaOptionTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+McoaOptionTestCase::McoaOptionTestCase ()
+  : TestCase ("Binding identifier and flow identification options round trip")
+{
+}
+
+McoaOptionTestCase::~McoaOptionTestCase ()
+{
+}
+
+void
+McoaOptionTestCase::DoRun (void)
+{
+  Ipv6Address wimax ("9999:db80::200:ff:fe00:a");
+  Ipv6Address wifi ("8888:56ac::200:ff:fe00:9");
+
+  Ipv6MobilityOptionBindingIdentifierHeader bid;
+  bid.SetBindingId (2);
+  bid.SetStatus (0);
+  bid.SetFlagO (true);
+  bid.SetCareofAddress (wimax);
+
+  // without care-of address, the BID is bound to the source of the BU
+  Ipv6MobilityOptionBindingIdentifierHeader bid2;
+  bid2.SetBindingId (1);
+  bid2.SetStatus (0);
+
+  Ipv6MobilityOptionFlowIdentificationHeader flow;
+  flow.SetFlowId (7);
+  flow.SetPriority (3);
+  flow.SetAction (Ipv6MobilityOptionFlowIdentificationHeader::FLOW_ACTION_FORWARD);
+  flow.SetBindingId (2);
+  flow.SetProtocol (17);
+  flow.SetDestinationPortRange (9000, 9010);
+
+  Ipv6MobilityBindingUpdateHeader bu;
+  bu.SetSequence (12);
+  bu.SetFlagA (true);
+  bu.SetFlagH (true);
+  bu.SetLifetime (40);
+  bu.AddOption (bid);
+  bu.AddOption (bid2);
+  bu.AddOption (flow);
+
+  Ptr<Packet> p = Create<Packet> ();
+  p->AddHeader (bu);
+
+  Ipv6MobilityBindingUpdateHeader bu2;
+  p->RemoveHeader (bu2);
+  NS_TEST_ASSERT_MSG_EQ (p->GetSize (), 0, "The BU was not read entirely");
+  NS_TEST_ASSERT_MSG_EQ (bu2.GetSequence (), 12, "Wrong BU sequence");
+  NS_TEST_ASSERT_MSG_EQ (bu2.GetLifetime (), 40, "Wrong BU lifetime");
+
+  Ptr<Mipv6Ha> ha = CreateObject<Mipv6Ha> ();
+  std::list<Ipv6MobilityOptionBindingIdentifierHeader> bids;
+  std::list<Ipv6MobilityOptionFlowIdentificationHeader> flows;
+  ha->ParseMcoaOptions (bu2, bids, flows);
+
+  NS_TEST_ASSERT_MSG_EQ (bids.size (), 2, "The BID options were not found");
+  NS_TEST_ASSERT_MSG_EQ (bids.front ().GetBindingId (), 2, "Wrong binding identifier");
+  NS_TEST_ASSERT_MSG_EQ (bids.front ().GetFlagO (), true, "Wrong overwrite flag");
+  NS_TEST_ASSERT_MSG_EQ (bids.front ().GetCareofAddress (), wimax, "Wrong care-of address");
+  NS_TEST_ASSERT_MSG_EQ (bids.back ().GetBindingId (), 1, "Wrong binding identifier");
+
+  NS_TEST_ASSERT_MSG_EQ (flows.size (), 1, "The flow identification option was not found");
+  NS_TEST_ASSERT_MSG_EQ (flows.front ().GetFlowId (), 7, "Wrong flow identifier");
+  NS_TEST_ASSERT_MSG_EQ (flows.front ().GetPriority (), 3, "Wrong flow priority");
+  NS_TEST_ASSERT_MSG_EQ ((uint32_t) flows.front ().GetAction (), (uint32_t) Ipv6MobilityOptionFlowIdentificationHeader::FLOW_ACTION_FORWARD, "Wrong flow action");
+  NS_TEST_ASSERT_MSG_EQ (flows.front ().GetBindingId (), 2, "Wrong flow binding identifier");
+  NS_TEST_ASSERT_MSG_EQ ((uint32_t) flows.front ().GetProtocol (), 17, "Wrong flow protocol");
+  NS_TEST_ASSERT_MSG_EQ (flows.front ().GetDestinationPortLow (), 9000, "Wrong lowest port");
+  NS_TEST_ASSERT_MSG_EQ (flows.front ().GetDestinationPortHigh (), 9010, "Wrong highest port");
+
+  // the overwrite flag drops the care-of addresses the BU does not list
+  Ptr<BCache> bcache = CreateObject<BCache> ();
+  BCache::Entry *bce = new BCache::Entry (bcache);
+  bce->AddCoa (3, Ipv6Address ("7777:1::1"));
+  ha->UpdateMcoaBindings (bce, wifi, bu2.GetLifetime (), bids, flows);
+  NS_TEST_ASSERT_MSG_EQ (bce->GetNCoa (), 2, "BID 3 should be replaced by the BIDs of the BU");
+  NS_TEST_ASSERT_MSG_EQ (bce->GetCoa (2), wimax, "Wrong care-of address of BID 2");
+  NS_TEST_ASSERT_MSG_EQ (bce->GetCoa (1), wifi, "BID 1 should be bound to the source of the BU");
+  NS_TEST_ASSERT_MSG_EQ (bce->LookupFlow (17, 9005), wimax, "The flow should be bound to BID 2");
+  NS_TEST_ASSERT_MSG_EQ (bce->LookupFlow (17, 9011), Ipv6Address::GetAny (), "Port 9011 is out of the flow");
+
+  delete bce;
+  bcache->Dispose ();
+  ha->Dispose ();
+
+  // a BU without options keeps its original size
+  Ipv6MobilityBindingUpdateHeader plain;
+  NS_TEST_ASSERT_MSG_EQ (plain.GetSerializedSize (), 12, "Wrong size of a BU without options");
+}
+
+/**
+ * \brief A binding cache entry keeps one care-of address per BID, and
+ * steers the flows to them by priority.
+ */
+class McoaBCacheTestCase : public TestCase
+{
+public:
+  McoaBCacheTestCase ();
+  virtual ~McoaBCacheTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+McoaBCacheTestCase::McoaBCacheTestCase ()
+  : TestCase ("Binding cache with multiple care-of addresses")
+{
+}
+
+McoaBCacheTestCase::~McoaBCacheTestCase ()
+{
+}
+
+void
+McoaBCacheTestCase::DoRun (void)
+{
+  Ptr<BCache> bcache = CreateObject<BCache> ();
+  BCache::Entry *bce = new BCache::Entry (bcache);
+  Ipv6Address wifi ("8888:56ac::200:ff:fe00:9");
+  Ipv6Address wimax ("9999:db80::200:ff:fe00:a");
+
+  bce->AddCoa (1, wifi);
+  bce->AddCoa (2, wimax);
+  NS_TEST_ASSERT_MSG_EQ (bce->GetNCoa (), 2, "Both care-of addresses must be registered");
+  NS_TEST_ASSERT_MSG_EQ (bce->GetCoa (1), wifi, "Wrong care-of address of BID 1");
+  NS_TEST_ASSERT_MSG_EQ (bce->GetCoa (2), wimax, "Wrong care-of address of BID 2");
+  NS_TEST_ASSERT_MSG_EQ (bce->GetCoa (3), Ipv6Address::GetAny (), "BID 3 is not registered");
+
+  // a new CoA of a BID replaces the previous one
+  Ipv6Address wifi2 ("8888:56ac::200:ff:fe00:b");
+  bce->AddCoa (1, wifi2);
+  NS_TEST_ASSERT_MSG_EQ (bce->GetNCoa (), 2, "A BID has a single care-of address");
+  NS_TEST_ASSERT_MSG_EQ (bce->GetCoa (1), wifi2, "The care-of address of BID 1 was not updated");
+
+  BCache::Entry::FlowBinding video;
+  video.fid = 1;
+  video.priority = 10;
+  video.bid = 2;
+  video.protocol = 17;
+  video.portLow = 9000;
+  video.portHigh = 9100;
+  bce->AddFlowBinding (video);
+
+  BCache::Entry::FlowBinding voice;
+  voice.fid = 2;
+  voice.priority = 1;
+  voice.bid = 1;
+  voice.protocol = 0;
+  voice.portLow = 9050;
+  voice.portHigh = 9050;
+  bce->AddFlowBinding (voice);
+
+  NS_TEST_ASSERT_MSG_EQ (bce->HasFlowBindings (), true, "The flow bindings were not added");
+  NS_TEST_ASSERT_MSG_EQ (bce->LookupFlow (17, 9000), wimax, "Flow 1 is bound to BID 2");
+  NS_TEST_ASSERT_MSG_EQ (bce->LookupFlow (17, 9050), wifi2, "Flow 2 has the highest priority");
+  NS_TEST_ASSERT_MSG_EQ (bce->LookupFlow (6, 9000), Ipv6Address::GetAny (), "No flow of TCP port 9000");
+
+  // the flows of a removed BID are removed with it
+  bce->RemoveCoa (1);
+  NS_TEST_ASSERT_MSG_EQ (bce->GetNCoa (), 1, "BID 1 was not removed");
+  NS_TEST_ASSERT_MSG_EQ (bce->LookupFlow (17, 9050), wimax, "Flow 2 must be removed with BID 1");
+
+  bce->RemoveFlowBinding (1);
+  NS_TEST_ASSERT_MSG_EQ (bce->HasFlowBindings (), false, "Flow 1 was not removed");
+
+  delete bce;
+  bcache->Dispose ();
+}
+
+/**
+ * \brief The proxy ND table defends a home address per home link
+ * interface and joins each solicited-node group once.
+ */
+class ProxyNdTableTestCase : public TestCase
+{
+public:
+  ProxyNdTableTestCase ();
+  virtual ~ProxyNdTableTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+ProxyNdTableTestCase::ProxyNdTableTestCase ()
+  : TestCase ("Proxy ND table keyed by interface and address")
+{
+}
+
+ProxyNdTableTestCase::~ProxyNdTableTestCase ()
+{
+}
+
+void
+ProxyNdTableTestCase::DoRun (void)
+{
+  NodeContainer nodes;
+  nodes.Create (3);
+
+  InternetStackHelper internet;
+  internet.SetIpv4StackInstall (false);
+  internet.Install (nodes);
+
+  // the HA (node 0) has two home links
+  CsmaHelper csma;
+  Ipv6AddressHelper ipv6h;
+  ipv6h.SetBase (Ipv6Address ("2001:1::"), Ipv6Prefix (64));
+  ipv6h.Assign (csma.Install (NodeContainer (nodes.Get (0), nodes.Get (1))));
+  ipv6h.SetBase (Ipv6Address ("2001:2::"), Ipv6Prefix (64));
+  ipv6h.Assign (csma.Install (NodeContainer (nodes.Get (0), nodes.Get (2))));
+
+  Ptr<Ipv6L3Protocol> ipv6 = nodes.Get (0)->GetObject<Ipv6L3Protocol> ();
+  Ptr<ProxyNdTable> table = CreateObject<ProxyNdTable> ();
+  table->SetNode (nodes.Get (0));
+
+  Ipv6Address ha ("2001:1::200:ff:fe00:1");
+  Ipv6Address hoa ("2001:1::200:ff:fe00:99");
+  Ipv6Address other ("2001:2::200:ff:fe00:99");
+  Ipv6Address group = Ipv6Address::MakeSolicitedAddress (hoa);
+
+  table->Add (hoa, ha, 1);
+  table->Add (hoa, ha, 2);
+  table->Add (hoa, ha, 1);
+  NS_TEST_ASSERT_MSG_EQ (table->GetNEntries (), 2, "One entry per interface");
+  NS_TEST_ASSERT_MSG_NE (table->Lookup (hoa, 1), 0, "The address is defended on interface 1");
+  NS_TEST_ASSERT_MSG_NE (table->Lookup (hoa, 2), 0, "The address is defended on interface 2");
+  NS_TEST_ASSERT_MSG_EQ (table->Lookup (hoa, 1)->GetInterface (), 1, "Wrong interface of the entry");
+  NS_TEST_ASSERT_MSG_EQ (ipv6->IsRegisteredMulticastAddress (group, 1), true, "Group not joined on interface 1");
+  NS_TEST_ASSERT_MSG_EQ (ipv6->IsRegisteredMulticastAddress (group, 2), true, "Group not joined on interface 2");
+
+  // an address with the same solicited-node group on interface 2
+  table->Add (other, ha, 2);
+
+  table->Remove (hoa, 1);
+  NS_TEST_ASSERT_MSG_EQ (table->Lookup (hoa, 1), 0, "The address is still defended on interface 1");
+  NS_TEST_ASSERT_MSG_EQ (table->IsDefended (hoa), true, "The address is still defended on interface 2");
+  NS_TEST_ASSERT_MSG_EQ (ipv6->IsRegisteredMulticastAddress (group, 1), false, "Group not left on interface 1");
+
+  table->Remove (hoa, 2);
+  NS_TEST_ASSERT_MSG_EQ (table->IsDefended (hoa), false, "The address is no longer defended");
+  NS_TEST_ASSERT_MSG_EQ (ipv6->IsRegisteredMulticastAddress (group, 2), true, "The group is still used on interface 2");
+
+  table->Remove (other, 2);
+  NS_TEST_ASSERT_MSG_EQ (ipv6->IsRegisteredMulticastAddress (group, 2), false, "Group not left on interface 2");
+
+  table->Add (hoa, ha, 1);
+  table->Add (other, ha, 2);
+  table->Flush ();
+  NS_TEST_ASSERT_MSG_EQ (table->GetNEntries (), 0, "The table was not flushed");
+  NS_TEST_ASSERT_MSG_EQ (ipv6->IsRegisteredMulticastAddress (group, 1), false, "Group not left on flush");
+  NS_TEST_ASSERT_MSG_EQ (ipv6->IsRegisteredMulticastAddress (group, 2), false, "Group not left on flush");
+
+  table->Dispose ();
+  Simulator::Destroy ();
+}
+
+/**
+ * \brief Mipv6Stats accounts the handoffs which end without data
+ * through their binding, and those still in progress, as incomplete.
+ */
+class Mipv6StatsTestCase : public TestCase
+{
+public:
+  Mipv6StatsTestCase ();
+  virtual ~Mipv6StatsTestCase ();
+
+private:
+  virtual void DoRun (void);
+  /**
+   * \brief schedule the record of a phase.
+   * \param stats the statistics
+   * \param t the time of the phase
+   * \param phase the phase
+   */
+  void Record (Ptr<Mipv6Stats> stats, double t, uint8_t phase);
+};
+
+Mipv6StatsTestCase::Mipv6StatsTestCase ()
+  : TestCase ("Complete and incomplete handoff statistics")
+{
+}
+
+Mipv6StatsTestCase::~Mipv6StatsTestCase ()
+{
+}
+
+void
+Mipv6StatsTestCase::Record (Ptr<Mipv6Stats> stats, double t, uint8_t phase)
+{
+  Simulator::Schedule (Seconds (t), &Mipv6Stats::Record, stats, 1, phase);
+}
+
+void
+Mipv6StatsTestCase::DoRun (void)
+{
+  Ptr<Mipv6Stats> stats = CreateObject<Mipv6Stats> ();
+
+  // a complete handoff
+  Record (stats, 1.0, Mipv6HandoffCalculator::L2_DOWN);
+  Record (stats, 1.1, Mipv6HandoffCalculator::L2_UP);
+  Record (stats, 1.2, Mipv6HandoffCalculator::RA_RECEIVED);
+  Record (stats, 1.3, Mipv6HandoffCalculator::COA_READY);
+  Record (stats, 1.4, Mipv6HandoffCalculator::BU_SENT);
+  Record (stats, 1.5, Mipv6HandoffCalculator::BA_RECEIVED);
+  Record (stats, 1.6, Mipv6HandoffCalculator::FIRST_DATA);
+  // a binding refresh does not start a handoff
+  Record (stats, 2.0, Mipv6HandoffCalculator::BU_SENT);
+  Record (stats, 2.1, Mipv6HandoffCalculator::BA_RECEIVED);
+  Record (stats, 2.2, Mipv6HandoffCalculator::FIRST_DATA);
+  // no data through the binding before the next movement
+  Record (stats, 5.0, Mipv6HandoffCalculator::L2_DOWN);
+  Record (stats, 5.1, Mipv6HandoffCalculator::L2_UP);
+  Record (stats, 5.4, Mipv6HandoffCalculator::BU_SENT);
+  Record (stats, 5.5, Mipv6HandoffCalculator::BA_RECEIVED);
+  // still in progress at the end of the run
+  Record (stats, 8.0, Mipv6HandoffCalculator::L2_DOWN);
+  Record (stats, 8.1, Mipv6HandoffCalculator::L2_UP);
+
+  Simulator::Run ();
+  stats->Flush ();
+  stats->Flush ();
+
+  Ptr<Mipv6HandoffCalculator> mn = stats->GetMnStats (1);
+  NS_TEST_ASSERT_MSG_NE (mn, 0, "The handoffs of node 1 were not accounted");
+  NS_TEST_ASSERT_MSG_EQ (mn->GetNHandoffs (), 1, "A single handoff got data through its binding");
+  NS_TEST_ASSERT_MSG_EQ (mn->GetNIncomplete (), 2, "Two handoffs are incomplete");
+  NS_TEST_ASSERT_MSG_EQ (mn->GetCount (Mipv6HandoffCalculator::L2_DOWN), 3, "Wrong number of handoffs started");
+  NS_TEST_ASSERT_MSG_EQ (mn->GetCount (Mipv6HandoffCalculator::BA_RECEIVED), 2, "The refresh BA must not be accounted");
+  NS_TEST_ASSERT_MSG_EQ (mn->GetMean (Mipv6HandoffCalculator::FIRST_DATA), MilliSeconds (600), "Wrong handoff delay");
+  NS_TEST_ASSERT_MSG_EQ (mn->GetMax (Mipv6HandoffCalculator::BA_RECEIVED), MilliSeconds (500), "Wrong BA delay");
+
+  stats->Dispose ();
+  Simulator::Destroy ();
+}
+
+/**
+ * \brief A link adapter whose link and signal are set by the test.
+ */
+class MihTestLinkAdapter : public MihLinkAdapter
+{
+public:
+  /// \brief the link goes up.
+  void Up (void)
+  {
+    LinkUp ();
+  }
+  /// \brief the link goes down.
+  void Down (void)
+  {
+    LinkDown ();
+  }
+  /**
+   * \brief a sample of the signal.
+   * \param signal the signal
+   */
+  void Signal (double signal)
+  {
+    ReportSignal (signal);
+  }
+
+protected:
+  virtual bool DoAttach (Ptr<NetDevice> device)
+  {
+    return true;
+  }
+};
+
+/**
+ * \brief MihLinkAdapter notifies Link_Going_Down once below its threshold,
+ * again only past the hysteresis, and reports the crossings of its report
+ * thresholds.
+ */
+class MihLinkAdapterTestCase : public TestCase
+{
+public:
+  MihLinkAdapterTestCase ();
+  virtual ~MihLinkAdapterTestCase ();
+
+private:
+  virtual void DoRun (void);
+  /**
+   * \brief trace the events of the function.
+   * \param event the event
+   * \param device the device of the link
+   * \param signal the signal of the link
+   */
+  void LinkEvent (uint8_t event, Ptr<NetDevice> device, double signal);
+  /**
+   * \brief report a signal and check the events it notified.
+   * \param signal the signal
+   * \param events the events expected, in the order of their notification
+   */
+  void Check (double signal, std::string events);
+
+  Ptr<MihTestLinkAdapter> m_link;   //!< The link adapter.
+  std::string m_events;             //!< The events notified since the last check.
+};
+
+MihLinkAdapterTestCase::MihLinkAdapterTestCase ()
+  : TestCase ("MIH link adapter thresholds")
+{
+}
+
+MihLinkAdapterTestCase::~MihLinkAdapterTestCase ()
+{
+}
+
+void
+MihLinkAdapterTestCase::LinkEvent (uint8_t event, Ptr<NetDevice> device, double signal)
+{
+  m_events += (m_events.empty () ? "" : " ") + MihFunction::GetEventName (event);
+}
+
+void
+MihLinkAdapterTestCase::Check (double signal, std::string events)
+{
+  m_events.clear ();
+  m_link->Signal (signal);
+  NS_TEST_EXPECT_MSG_EQ (m_events, events, "Wrong events for signal " << signal);
+}
+
+void
+MihLinkAdapterTestCase::DoRun (void)
+{
+  Ptr<MihFunction> mih = CreateObject<MihFunction> ();
+  mih->TraceConnectWithoutContext ("LinkEvent", MakeCallback (&MihLinkAdapterTestCase::LinkEvent, this));
+  m_link = CreateObject<MihTestLinkAdapter> ();
+  m_link->SetAttribute ("Hysteresis", DoubleValue (3.0));
+  m_link->SetGoingDownThreshold (-80.0);
+  m_link->Attach (mih, CreateObject<SimpleNetDevice> ());
+
+  // no event while the link is down
+  Check (-90.0, "");
+  m_link->Up ();
+  NS_TEST_EXPECT_MSG_EQ (m_events, MihFunction::GetEventName (MihFunction::LINK_UP), "The link is up");
+
+  // going down once below the threshold, until the hysteresis is passed
+  std::string goingDown = MihFunction::GetEventName (MihFunction::LINK_GOING_DOWN);
+  std::string report = MihFunction::GetEventName (MihFunction::LINK_PARAMETERS_REPORT);
+  Check (-70.0, "");
+  Check (-81.0, goingDown);
+  NS_TEST_EXPECT_MSG_EQ (m_link->IsGoingDown (), true, "The link is going down");
+  Check (-85.0, "");
+  Check (-78.0, "");
+  Check (-81.0, "");
+  Check (-77.0, report);
+  NS_TEST_EXPECT_MSG_EQ (m_link->IsGoingDown (), false, "The link recovered");
+  NS_TEST_EXPECT_MSG_EQ_TOL (m_link->GetSignalMargin (), 3.0, 1e-9, "Wrong signal margin");
+  Check (-80.5, goingDown);
+
+  // the link going up again clears the going down state and the signal
+  m_link->Down ();
+  m_link->Up ();
+  NS_TEST_EXPECT_MSG_EQ (m_link->IsGoingDown (), false, "The link went up again");
+  NS_TEST_EXPECT_MSG_EQ (std::isnan (m_link->GetSignalMargin ()), true, "No signal since the link went up");
+
+  // a crossing of a report threshold, in either direction
+  m_link->AddReportThreshold (-60.0);
+  Check (-65.0, "");
+  Check (-55.0, report);
+  Check (-50.0, "");
+  Check (-60.0, "");
+  Check (-61.0, report);
+  // a crossing down to below the going down threshold
+  Check (-50.0, report);
+  Check (-90.0, report + " " + goingDown);
+
+  m_link = 0;
+  mih->Dispose ();
+  Simulator::Destroy ();
+}
+
 /**
  * \brief test suite 1
  */
@@ -629,6 +1117,11 @@ Mipv6TestSuite::Mipv6TestSuite ()
   : TestSuite ("mipv6-test1", UNIT)
 {
   AddTestCase (new NoHandoffTestCase, TestCase::QUICK);
+  AddTestCase (new McoaOptionTestCase, TestCase::QUICK);
+  AddTestCase (new McoaBCacheTestCase, TestCase::QUICK);
+  AddTestCase (new ProxyNdTableTestCase, TestCase::QUICK);
+  AddTestCase (new Mipv6StatsTestCase, TestCase::QUICK);
+  AddTestCase (new MihLinkAdapterTestCase, TestCase::QUICK);
 }
 
 static Mipv6TestSuite mipv6testsuite;
@@ -0,0 +1,418 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include "ns3/log.h"
+#include "ns3/abort.h"
+#include "ns3/simulator.h"
+#include "ns3/node-list.h"
+#include "ns3/waypoint-mobility-model.h"
+#include "waypoint-trace-helper.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("WaypointTraceHelper");
+
+/**
+ * \brief Add a waypoint after the last one of a node, or move the last
+ * one if it is not earlier.
+ * \param waypoints the waypoints of the node
+ * \param time the time of the waypoint
+ * \param position its position
+ */
+static void
+AddWaypoint (std::vector<Waypoint> &waypoints, Time time, const Vector &position)
+{
+  if (!waypoints.empty () && waypoints.back ().time >= time)
+    {
+      waypoints.back ().position = position;
+      return;
+    }
+  waypoints.push_back (Waypoint (time, position));
+}
+
+/**
+ * \param a a waypoint
+ * \param b another waypoint
+ * \returns whether a is earlier than b
+ */
+static bool
+WaypointTimeLess (const Waypoint &a, const Waypoint &b)
+{
+  return a.time < b.time;
+}
+
+/**
+ * \brief Parse a number.
+ * \param token the text
+ * \param value the number
+ * \returns false if the text is not a number
+ */
+static bool
+ParseNumber (const std::string &token, double &value)
+{
+  const char *begin = token.c_str ();
+  char *end;
+  value = std::strtod (begin, &end);
+  return end != begin && *end == '\0';
+}
+
+/**
+ * \brief Parse a node of an ns-2 trace, like "$node_(4)".
+ * \param token the text
+ * \param node the node
+ * \returns false if the text is not a node
+ */
+static bool
+ParseNs2Node (const std::string &token, uint32_t &node)
+{
+  const std::string prefix = "$node_(";
+  if (token.compare (0, prefix.size (), prefix) != 0 || token[token.size () - 1] != ')')
+    {
+      return false;
+    }
+  double value;
+  if (!ParseNumber (token.substr (prefix.size (), token.size () - prefix.size () - 1), value)
+      || value < 0 || value != std::floor (value))
+    {
+      return false;
+    }
+  node = static_cast<uint32_t> (value);
+  return true;
+}
+
+/// A timed statement of an ns-2 trace.
+struct Ns2Movement
+{
+  double at;          //!< The time.
+  bool setdest;       //!< Whether the node moves, or jumps.
+  char coordinate;    //!< The coordinate set by a jump, 'X', 'Y' or 'Z'.
+  double x;           //!< The destination, or the value of the coordinate.
+  double y;           //!< The y of the destination.
+  double speed;       //!< The speed.
+};
+
+/**
+ * \param position a position
+ * \param coordinate 'X', 'Y' or 'Z'
+ * \param value the value of the coordinate
+ * \returns the position with the coordinate set
+ */
+static Vector
+SetCoordinate (Vector position, char coordinate, double value)
+{
+  switch (coordinate)
+    {
+    case 'X':
+      position.x = value;
+      break;
+    case 'Y':
+      position.y = value;
+      break;
+    default:
+      position.z = value;
+      break;
+    }
+  return position;
+}
+
+WaypointTraceHelper::WaypointTraceHelper (std::string filename)
+  : m_file (Create<WaypointTraceFile> ())
+{
+  if (!m_file->Open (filename))
+    {
+      NS_FATAL_ERROR ("Could not map waypoint file " << filename);
+    }
+}
+
+uint32_t
+WaypointTraceHelper::GetNNodes (void) const
+{
+  return m_file->GetNNodes ();
+}
+
+void
+WaypointTraceHelper::Install (void) const
+{
+  for (NodeList::Iterator i = NodeList::Begin (); i != NodeList::End (); ++i)
+    {
+      if ((*i)->GetId () < m_file->GetNNodes ())
+        {
+          Install (*i, (*i)->GetId ());
+        }
+    }
+}
+
+void
+WaypointTraceHelper::Install (NodeContainer nodes) const
+{
+  for (uint32_t i = 0; i < nodes.GetN () && i < m_file->GetNNodes (); i++)
+    {
+      Install (nodes.Get (i), i);
+    }
+}
+
+void
+WaypointTraceHelper::Install (Ptr<Node> node, uint32_t index) const
+{
+  NS_LOG_FUNCTION (this << node << index);
+  NS_ASSERT (index < m_file->GetNNodes ());
+  Ptr<WaypointMobilityModel> model = node->GetObject<WaypointMobilityModel> ();
+  if (model == 0)
+    {
+      if (node->GetObject<MobilityModel> () != 0)
+        {
+          NS_FATAL_ERROR ("Node " << node->GetId () << " already has a mobility model");
+        }
+      model = CreateObject<WaypointMobilityModel> ();
+      node->AggregateObject (model);
+    }
+  Feed (m_file, model, index, 0);
+}
+
+void
+WaypointTraceHelper::Feed (Ptr<WaypointTraceFile> file, Ptr<WaypointMobilityModel> model,
+                           uint32_t index, uint64_t next)
+{
+  NS_LOG_FUNCTION (model << index << next);
+  uint64_t n = file->GetNWaypoints (index);
+  Time now = Simulator::Now ();
+  while (next < n)
+    {
+      model->AddWaypoint (file->GetWaypoint (index, next));
+      next++;
+      // the model needs the waypoint after the one it moves to, so the
+      // next waypoint is given when it reaches the one before the last
+      if (next >= 2 && next < n)
+        {
+          Time when = file->GetWaypoint (index, next - 2).time;
+          if (when > now)
+            {
+              Simulator::Schedule (when - now, &WaypointTraceHelper::Feed, file, model, index, next);
+              return;
+            }
+        }
+    }
+}
+
+void
+WaypointTraceHelper::ConvertNs2 (std::string ns2File, std::string waypointFile)
+{
+  NS_LOG_FUNCTION (ns2File << waypointFile);
+  std::ifstream file (ns2File.c_str ());
+  if (!file.is_open ())
+    {
+      NS_FATAL_ERROR ("Could not open ns-2 trace " << ns2File);
+    }
+  std::vector<Vector> initial;
+  std::vector<std::vector<Ns2Movement> > movements;
+  std::string line;
+  while (std::getline (file, line))
+    {
+      std::replace (line.begin (), line.end (), '"', ' ');
+      std::istringstream iss (line);
+      std::vector<std::string> tokens;
+      std::string token;
+      while (iss >> token)
+        {
+          tokens.push_back (token);
+        }
+      if (tokens.empty ())
+        {
+          continue;
+        }
+      uint32_t node;
+      double value;
+      if (tokens.size () == 4 && tokens[1] == "set" && ParseNs2Node (tokens[0], node)
+          && tokens[2].size () == 2 && tokens[2][1] == '_' && ParseNumber (tokens[3], value))
+        {
+          // $node_(0) set X_ 1.0
+          if (node >= initial.size ())
+            {
+              initial.resize (node + 1);
+              movements.resize (node + 1);
+            }
+          initial[node] = SetCoordinate (initial[node], tokens[2][0], value);
+          continue;
+        }
+      Ns2Movement movement;
+      if (tokens.size () < 7 || tokens[0] != "$ns_" || tokens[1] != "at"
+          || !ParseNumber (tokens[2], movement.at) || movement.at < 0 || !ParseNs2Node (tokens[3], node))
+        {
+          NS_LOG_WARN ("Line skipped: " << line);
+          continue;
+        }
+      if (tokens.size () == 8 && tokens[4] == "setdest" && ParseNumber (tokens[5], movement.x)
+          && ParseNumber (tokens[6], movement.y) && ParseNumber (tokens[7], movement.speed))
+        {
+          // $ns_ at 1.0 "$node_(0) setdest 2.0 3.0 4.0"
+          movement.setdest = true;
+        }
+      else if (tokens.size () == 7 && tokens[4] == "set" && tokens[5].size () == 2 && tokens[5][1] == '_'
+               && ParseNumber (tokens[6], movement.x))
+        {
+          // $ns_ at 1.0 "$node_(0) set X_ 2.0"
+          movement.setdest = false;
+          movement.coordinate = tokens[5][0];
+        }
+      else
+        {
+          NS_LOG_WARN ("Line skipped: " << line);
+          continue;
+        }
+      if (node >= initial.size ())
+        {
+          initial.resize (node + 1);
+          movements.resize (node + 1);
+        }
+      movements[node].push_back (movement);
+    }
+
+  std::vector<std::vector<Waypoint> > waypoints (movements.size ());
+  for (uint32_t node = 0; node < movements.size (); node++)
+    {
+      std::vector<Waypoint> &out = waypoints[node];
+      Vector position = initial[node];
+      AddWaypoint (out, Seconds (0), position);
+      bool moving = false;
+      double start = 0;
+      double arrival = 0;
+      Vector velocity;
+      Vector destination;
+      for (uint32_t k = 0; k < movements[node].size (); k++)
+        {
+          const Ns2Movement &movement = movements[node][k];
+          double at = std::max (movement.at, start);
+          if (moving && at < arrival)
+            {
+              // the movement is interrupted where the node is
+              double travelled = at - start;
+              position = Vector (position.x + velocity.x * travelled,
+                                 position.y + velocity.y * travelled,
+                                 position.z);
+            }
+          else if (moving)
+            {
+              AddWaypoint (out, Seconds (arrival), destination);
+              position = destination;
+            }
+          moving = false;
+          AddWaypoint (out, Seconds (at), position);
+          start = at;
+          if (movement.setdest)
+            {
+              double dx = movement.x - position.x;
+              double dy = movement.y - position.y;
+              double distance = std::sqrt (dx * dx + dy * dy);
+              if (movement.speed > 0 && distance > 0)
+                {
+                  double time = distance / movement.speed;
+                  velocity = Vector (dx / time, dy / time, 0);
+                  destination = Vector (movement.x, movement.y, position.z);
+                  arrival = at + time;
+                  moving = true;
+                }
+            }
+          else
+            {
+              position = SetCoordinate (position, movement.coordinate, movement.x);
+              AddWaypoint (out, Seconds (at) + NanoSeconds (1), position);
+            }
+        }
+      if (moving)
+        {
+          AddWaypoint (out, Seconds (arrival), destination);
+        }
+    }
+  if (!WaypointTraceFile::Write (waypointFile, waypoints))
+    {
+      NS_FATAL_ERROR ("Could not write waypoint file " << waypointFile);
+    }
+}
+
+void
+WaypointTraceHelper::ConvertCsv (std::string csvFile, std::string waypointFile)
+{
+  NS_LOG_FUNCTION (csvFile << waypointFile);
+  std::ifstream file (csvFile.c_str ());
+  if (!file.is_open ())
+    {
+      NS_FATAL_ERROR ("Could not open CSV trace " << csvFile);
+    }
+  std::vector<std::vector<Waypoint> > waypoints;
+  std::string line;
+  bool first = true;
+  while (std::getline (file, line))
+    {
+      if (line.empty () || line[0] == '#')
+        {
+          continue;
+        }
+      std::istringstream iss (line);
+      std::vector<double> values;
+      std::string field;
+      bool numbers = true;
+      while (std::getline (iss, field, ','))
+        {
+          double value;
+          field.erase (0, field.find_first_not_of (" \t\r"));
+          field.erase (field.find_last_not_of (" \t\r") + 1);
+          numbers = numbers && ParseNumber (field, value);
+          values.push_back (value);
+        }
+      bool header = first && !numbers;
+      first = false;
+      if (header)
+        {
+          continue;
+        }
+      if (!numbers || (values.size () != 4 && values.size () != 5)
+          || values[0] < 0 || values[0] != std::floor (values[0]))
+        {
+          NS_LOG_WARN ("Line skipped: " << line);
+          continue;
+        }
+      uint32_t node = static_cast<uint32_t> (values[0]);
+      if (node >= waypoints.size ())
+        {
+          waypoints.resize (node + 1);
+        }
+      waypoints[node].push_back (Waypoint (Seconds (values[1]),
+                                           Vector (values[2], values[3], values.size () == 5 ? values[4] : 0)));
+    }
+  for (uint32_t node = 0; node < waypoints.size (); node++)
+    {
+      // in increasing time, the last waypoint of a time replacing the others
+      std::vector<Waypoint> sorted (waypoints[node]);
+      std::stable_sort (sorted.begin (), sorted.end (), WaypointTimeLess);
+      waypoints[node].clear ();
+      for (uint32_t k = 0; k < sorted.size (); k++)
+        {
+          AddWaypoint (waypoints[node], sorted[k].time, sorted[k].position);
+        }
+    }
+  if (!WaypointTraceFile::Write (waypointFile, waypoints))
+    {
+      NS_FATAL_ERROR ("Could not write waypoint file " << waypointFile);
+    }
+}
+
+} // namespace ns3
@@ -68,5 +68,10 @@ ConstantVelocityMobilityModel::DoGetVelocity (void) const
 {
   return m_helper.GetVelocity ();
 }
+bool
+ConstantVelocityMobilityModel::DoIsPiecewiseLinear (void) const
+{
+  return true;
+}
 
 } // namespace ns3
@@ -217,6 +217,11 @@ GaussMarkovMobilityModel::DoGetVelocity (void) const
 {
   return m_helper.GetVelocity ();
 }
+bool
+GaussMarkovMobilityModel::DoIsPiecewiseLinear (void) const
+{
+  return true;
+}
 
 int64_t
 GaussMarkovMobilityModel::DoAssignStreams (int64_t stream)
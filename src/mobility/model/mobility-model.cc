@@ -113,5 +113,17 @@ MobilityModel::DoAssignStreams (int64_t start)
   return 0;
 }
 
+bool
+MobilityModel::IsPiecewiseLinear (void) const
+{
+  return DoIsPiecewiseLinear ();
+}
+
+bool
+MobilityModel::DoIsPiecewiseLinear (void) const
+{
+  return false;
+}
+
 
 } // namespace ns3
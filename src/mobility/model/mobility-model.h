@@ -78,6 +78,12 @@ public:
    * \return the number of stream indices assigned by this model
    */
   int64_t AssignStreams (int64_t stream);
+  /**
+   * \return true if the velocity of the model only changes when it
+   * notifies a course change, i.e. if the model moves in a straight
+   * line at constant speed between two notifications.
+   */
+  bool IsPiecewiseLinear (void) const;
 
   /**
    *  TracedCallback signature.
@@ -122,6 +128,12 @@ private:
    * \return the number of streams used
    */
   virtual int64_t DoAssignStreams (int64_t start);
+  /**
+   * The default implementation returns false. Subclasses which notify
+   * every change of their velocity are expected to override this.
+   * \return true if the model is piecewise linear
+   */
+  virtual bool DoIsPiecewiseLinear (void) const;
 
   /**
    * Used to alert subscribers that a change in direction, velocity,
@@ -0,0 +1,272 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/log.h"
+#include "ns3/assert.h"
+#include "ns3/simulator.h"
+#include "mobility-store.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("MobilityStore");
+
+NS_OBJECT_ENSURE_REGISTERED (MobilityStore);
+
+TypeId
+MobilityStore::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::MobilityStore")
+    .SetParent<Object> ()
+    .SetGroupName ("Mobility")
+    .AddConstructor<MobilityStore> ()
+    .AddTraceSource ("CourseChanges",
+                     "The entries which changed course at the current time.",
+                     MakeTraceSourceAccessor (&MobilityStore::m_courseChangesTrace),
+                     "ns3::MobilityStore::CourseChangesCallback")
+  ;
+  return tid;
+}
+
+MobilityStore::MobilityStore ()
+  : m_evaluated (NanoSeconds (-1))
+{
+  NS_LOG_FUNCTION (this);
+}
+
+MobilityStore::~MobilityStore ()
+{
+  NS_LOG_FUNCTION (this);
+  Clear ();
+}
+
+void
+MobilityStore::DoDispose (void)
+{
+  NS_LOG_FUNCTION (this);
+  Clear ();
+  Object::DoDispose ();
+}
+
+uint32_t
+MobilityStore::Add (Ptr<MobilityModel> mobility)
+{
+  NS_LOG_FUNCTION (this << mobility);
+  NS_ASSERT (mobility != 0);
+  uint32_t index = m_mobility.size ();
+  m_mobility.push_back (mobility);
+  m_x0.push_back (0);
+  m_y0.push_back (0);
+  m_z0.push_back (0);
+  m_vx.push_back (0);
+  m_vy.push_back (0);
+  m_vz.push_back (0);
+  m_t0.push_back (0);
+  m_x.push_back (0);
+  m_y.push_back (0);
+  m_z.push_back (0);
+  m_linear.push_back (0);
+  m_changed.push_back (0);
+  Record (index);
+  if (m_byMobility.find (PeekPointer (mobility)) == m_byMobility.end ())
+    {
+      mobility->TraceConnectWithoutContext ("CourseChange", MakeCallback (&MobilityStore::CourseChanged, this));
+    }
+  m_byMobility.insert (std::make_pair (PeekPointer (mobility), index));
+  return index;
+}
+
+uint32_t
+MobilityStore::GetN (void) const
+{
+  return m_mobility.size ();
+}
+
+Ptr<MobilityModel>
+MobilityStore::GetMobility (uint32_t index) const
+{
+  NS_ASSERT (index < m_mobility.size ());
+  return m_mobility[index];
+}
+
+Vector
+MobilityStore::GetPosition (uint32_t index)
+{
+  NS_ASSERT (index < m_mobility.size ());
+  if (!m_linear[index])
+    {
+      return m_mobility[index]->GetPosition ();
+    }
+  Evaluate ();
+  return Vector (m_x[index], m_y[index], m_z[index]);
+}
+
+Vector
+MobilityStore::GetVelocity (uint32_t index) const
+{
+  NS_ASSERT (index < m_mobility.size ());
+  return Vector (m_vx[index], m_vy[index], m_vz[index]);
+}
+
+bool
+MobilityStore::IsMoving (uint32_t index) const
+{
+  NS_ASSERT (index < m_mobility.size ());
+  return m_vx[index] != 0 || m_vy[index] != 0 || m_vz[index] != 0;
+}
+
+void
+MobilityStore::GetPositions (std::vector<Vector> &positions)
+{
+  NS_LOG_FUNCTION (this);
+  Evaluate ();
+  uint32_t n = m_mobility.size ();
+  positions.resize (n);
+  for (uint32_t i = 0; i < n; i++)
+    {
+      if (m_linear[i])
+        {
+          positions[i] = Vector (m_x[i], m_y[i], m_z[i]);
+        }
+      else
+        {
+          positions[i] = m_mobility[i]->GetPosition ();
+        }
+    }
+}
+
+void
+MobilityStore::NotifyCourseChanges (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_notify.Cancel ();
+  if (m_changes.empty ())
+    {
+      return;
+    }
+  // the callbacks may change the course of other entries
+  std::vector<uint32_t> changes;
+  changes.swap (m_changes);
+  for (uint32_t i = 0; i < changes.size (); i++)
+    {
+      m_changed[changes[i]] = 0;
+    }
+  m_courseChangesTrace (changes);
+}
+
+void
+MobilityStore::Clear (void)
+{
+  NS_LOG_FUNCTION (this);
+  for (std::multimap<const MobilityModel *, uint32_t>::const_iterator i = m_byMobility.begin ();
+       i != m_byMobility.end (); i = m_byMobility.upper_bound (i->first))
+    {
+      m_mobility[i->second]->TraceDisconnectWithoutContext ("CourseChange",
+                                                            MakeCallback (&MobilityStore::CourseChanged, this));
+    }
+  m_notify.Cancel ();
+  m_mobility.clear ();
+  m_x0.clear ();
+  m_y0.clear ();
+  m_z0.clear ();
+  m_vx.clear ();
+  m_vy.clear ();
+  m_vz.clear ();
+  m_t0.clear ();
+  m_x.clear ();
+  m_y.clear ();
+  m_z.clear ();
+  m_linear.clear ();
+  m_changed.clear ();
+  m_changes.clear ();
+  m_byMobility.clear ();
+  m_evaluated = NanoSeconds (-1);
+}
+
+void
+MobilityStore::Evaluate (void)
+{
+  Time now = Simulator::Now ();
+  if (now == m_evaluated || m_mobility.empty ())
+    {
+      return;
+    }
+  m_evaluated = now;
+  // one pass over plain arrays, without branches, which the compiler
+  // can vectorize; the entries which are not piecewise linear are
+  // evaluated too, but their result is not used
+  double t = now.GetSeconds ();
+  uint32_t n = m_mobility.size ();
+  const double *x0 = &m_x0[0];
+  const double *y0 = &m_y0[0];
+  const double *z0 = &m_z0[0];
+  const double *vx = &m_vx[0];
+  const double *vy = &m_vy[0];
+  const double *vz = &m_vz[0];
+  const double *t0 = &m_t0[0];
+  double *x = &m_x[0];
+  double *y = &m_y[0];
+  double *z = &m_z[0];
+  for (uint32_t i = 0; i < n; i++)
+    {
+      double dt = t - t0[i];
+      x[i] = x0[i] + vx[i] * dt;
+      y[i] = y0[i] + vy[i] * dt;
+      z[i] = z0[i] + vz[i] * dt;
+    }
+}
+
+void
+MobilityStore::Record (uint32_t index)
+{
+  Ptr<MobilityModel> mobility = m_mobility[index];
+  Vector position = mobility->GetPosition ();
+  Vector velocity = mobility->GetVelocity ();
+  m_linear[index] = mobility->IsPiecewiseLinear ();
+  m_x0[index] = position.x;
+  m_y0[index] = position.y;
+  m_z0[index] = position.z;
+  m_vx[index] = velocity.x;
+  m_vy[index] = velocity.y;
+  m_vz[index] = velocity.z;
+  m_t0[index] = Simulator::Now ().GetSeconds ();
+  // the positions may have been evaluated at the current time already
+  m_x[index] = position.x;
+  m_y[index] = position.y;
+  m_z[index] = position.z;
+}
+
+void
+MobilityStore::CourseChanged (Ptr<const MobilityModel> mobility)
+{
+  NS_LOG_FUNCTION (this << mobility);
+  typedef std::multimap<const MobilityModel *, uint32_t>::const_iterator Iterator;
+  std::pair<Iterator, Iterator> range = m_byMobility.equal_range (PeekPointer (mobility));
+  for (Iterator i = range.first; i != range.second; ++i)
+    {
+      Record (i->second);
+      if (!m_changed[i->second])
+        {
+          m_changed[i->second] = 1;
+          m_changes.push_back (i->second);
+        }
+    }
+  if (!m_notify.IsRunning ())
+    {
+      m_notify = Simulator::ScheduleNow (&MobilityStore::NotifyCourseChanges, this);
+    }
+}
+
+} // namespace ns3
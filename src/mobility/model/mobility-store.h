@@ -0,0 +1,154 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MOBILITY_STORE_H
+#define MOBILITY_STORE_H
+
+#include <map>
+#include <vector>
+#include <stdint.h>
+#include "ns3/object.h"
+#include "ns3/ptr.h"
+#include "ns3/nstime.h"
+#include "ns3/vector.h"
+#include "ns3/event-id.h"
+#include "ns3/traced-callback.h"
+#include "ns3/mobility-model.h"
+
+namespace ns3 {
+
+/**
+ * \ingroup mobility
+ * \brief The positions of many mobility models, evaluated together, and
+ * their course changes, notified together.
+ *
+ * Between two course changes, a piecewise linear mobility model (see
+ * MobilityModel::IsPiecewiseLinear) moves at the velocity it had at the
+ * first one. The store records the position, the velocity and the time
+ * of the last course change of each entry, in one array per coordinate,
+ * and evaluates the current positions of all the entries in a single
+ * loop over these arrays, at most once per time step. The positions of
+ * the entries whose model is not piecewise linear are asked to the model.
+ * A position set without a course change notification is seen at the
+ * next notification.
+ *
+ * The course changes of the models are not forwarded one at a time: the
+ * entries which changed course are collected, and the CourseChanges trace
+ * source is fired once with all of them, after the events already
+ * scheduled at the same time, or earlier when NotifyCourseChanges is
+ * called, e.g. by a consumer which is about to use the positions.
+ */
+class MobilityStore : public Object
+{
+public:
+  /**
+   * Register this type with the TypeId system.
+   * \return the object TypeId
+   */
+  static TypeId GetTypeId (void);
+  MobilityStore ();
+  virtual ~MobilityStore ();
+
+  /**
+   * \param mobility a mobility model, which may be added several times
+   * \returns the index of its entry
+   */
+  uint32_t Add (Ptr<MobilityModel> mobility);
+  /**
+   * \returns the number of entries
+   */
+  uint32_t GetN (void) const;
+  /**
+   * \param index the index of an entry
+   * \returns its mobility model
+   */
+  Ptr<MobilityModel> GetMobility (uint32_t index) const;
+  /**
+   * \param index the index of an entry
+   * \returns its current position
+   */
+  Vector GetPosition (uint32_t index);
+  /**
+   * \param index the index of an entry
+   * \returns its velocity at its last course change
+   */
+  Vector GetVelocity (uint32_t index) const;
+  /**
+   * \param index the index of an entry
+   * \returns whether its velocity was not zero at its last course change
+   */
+  bool IsMoving (uint32_t index) const;
+  /**
+   * \param positions the current positions of all the entries, by index
+   */
+  void GetPositions (std::vector<Vector> &positions);
+  /**
+   * \brief Fire the CourseChanges trace source now, if some entries
+   * changed course since it was last fired.
+   */
+  void NotifyCourseChanges (void);
+  /// Remove all the entries, and stop following their mobility models.
+  void Clear (void);
+
+  /**
+   * TracedCallback signature for the course changes of a time step.
+   *
+   * \param [in] indices The entries which changed course, in the order
+   * of their first change.
+   */
+  typedef void (* CourseChangesCallback)(const std::vector<uint32_t> &indices);
+
+protected:
+  virtual void DoDispose (void);
+
+private:
+  /// Evaluate the positions of the piecewise linear entries at the current time.
+  void Evaluate (void);
+  /**
+   * \brief Record the position and velocity of an entry at the current time.
+   * \param index the index of the entry
+   */
+  void Record (uint32_t index);
+  /**
+   * \brief Record the entries of a mobility model which changed course.
+   * \param mobility the mobility model
+   */
+  void CourseChanged (Ptr<const MobilityModel> mobility);
+
+  std::vector<Ptr<MobilityModel> > m_mobility;  //!< The mobility model of each entry.
+  std::vector<double> m_x0;      //!< The x coordinate at the last course change.
+  std::vector<double> m_y0;      //!< The y coordinate at the last course change.
+  std::vector<double> m_z0;      //!< The z coordinate at the last course change.
+  std::vector<double> m_vx;      //!< The x velocity since the last course change.
+  std::vector<double> m_vy;      //!< The y velocity since the last course change.
+  std::vector<double> m_vz;      //!< The z velocity since the last course change.
+  std::vector<double> m_t0;      //!< The time of the last course change, in seconds.
+  std::vector<double> m_x;       //!< The x coordinate when last evaluated.
+  std::vector<double> m_y;       //!< The y coordinate when last evaluated.
+  std::vector<double> m_z;       //!< The z coordinate when last evaluated.
+  std::vector<uint8_t> m_linear;  //!< Whether the model of each entry is piecewise linear.
+  std::vector<uint8_t> m_changed; //!< Whether each entry is in m_changes.
+  std::vector<uint32_t> m_changes;  //!< The entries which changed course, not notified yet.
+  std::multimap<const MobilityModel *, uint32_t> m_byMobility;  //!< The entries of each mobility model.
+  Time m_evaluated;              //!< When the positions were last evaluated.
+  EventId m_notify;              //!< The notification of the course changes.
+  /// The course changes of a time step.
+  TracedCallback<const std::vector<uint32_t> &> m_courseChangesTrace;
+};
+
+} // namespace ns3
+
+#endif /* MOBILITY_STORE_H */
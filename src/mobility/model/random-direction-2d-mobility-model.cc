@@ -153,6 +153,11 @@ RandomDirection2dMobilityModel::DoGetVelocity (void) const
 {
   return m_helper.GetVelocity ();
 }
+bool
+RandomDirection2dMobilityModel::DoIsPiecewiseLinear (void) const
+{
+  return true;
+}
 int64_t
 RandomDirection2dMobilityModel::DoAssignStreams (int64_t stream)
 {
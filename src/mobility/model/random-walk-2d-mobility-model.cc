@@ -175,6 +175,11 @@ RandomWalk2dMobilityModel::DoGetVelocity (void) const
 {
   return m_helper.GetVelocity ();
 }
+bool
+RandomWalk2dMobilityModel::DoIsPiecewiseLinear (void) const
+{
+  return true;
+}
 int64_t
 RandomWalk2dMobilityModel::DoAssignStreams (int64_t stream)
 {
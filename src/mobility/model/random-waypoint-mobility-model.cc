@@ -112,6 +112,11 @@ RandomWaypointMobilityModel::DoGetVelocity (void) const
 {
   return m_helper.GetVelocity ();
 }
+bool
+RandomWaypointMobilityModel::DoIsPiecewiseLinear (void) const
+{
+  return true;
+}
 int64_t
 RandomWaypointMobilityModel::DoAssignStreams (int64_t stream)
 {
@@ -0,0 +1,206 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <algorithm>
+#include <cmath>
+#include "ns3/log.h"
+#include "ns3/assert.h"
+#include "ns3/simulator.h"
+#include "spatial-index.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("SpatialIndex");
+
+SpatialIndex::SpatialIndex ()
+  : m_cellSize (1000),
+    m_lastUpdate (NanoSeconds (-1))
+{
+  NS_LOG_FUNCTION (this);
+  m_store = CreateObject<MobilityStore> ();
+  m_store->TraceConnectWithoutContext ("CourseChanges", MakeCallback (&SpatialIndex::CourseChanged, this));
+}
+
+SpatialIndex::~SpatialIndex ()
+{
+  NS_LOG_FUNCTION (this);
+  Clear ();
+  m_store->Dispose ();
+}
+
+void
+SpatialIndex::SetCellSize (double size)
+{
+  NS_LOG_FUNCTION (this << size);
+  NS_ASSERT_MSG (m_entries.empty (), "The cell size must be set before adding entries");
+  NS_ASSERT (size > 0);
+  m_cellSize = size;
+}
+
+void
+SpatialIndex::Add (uint32_t id, Ptr<MobilityModel> mobility)
+{
+  NS_LOG_FUNCTION (this << id << mobility);
+  uint32_t index = m_entries.size ();
+  Entry entry;
+  entry.id = id;
+  entry.position = 0;
+  entry.moving = false;
+  if (mobility == 0)
+    {
+      m_entries.push_back (entry);
+      m_unplaced.push_back (index);
+      return;
+    }
+  entry.position = m_store->Add (mobility);
+  m_byPosition.push_back (index);
+  NS_ASSERT (m_byPosition.size () == m_store->GetN ());
+  entry.cell = GetCell (m_store->GetPosition (entry.position));
+  Vector velocity = m_store->GetVelocity (entry.position);
+  entry.moving = velocity.x != 0 || velocity.y != 0;
+  m_entries.push_back (entry);
+  m_cells[entry.cell].push_back (index);
+  if (entry.moving)
+    {
+      m_moving.insert (index);
+    }
+}
+
+uint32_t
+SpatialIndex::GetN (void) const
+{
+  return m_entries.size ();
+}
+
+void
+SpatialIndex::Clear (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_store->Clear ();
+  m_entries.clear ();
+  m_cells.clear ();
+  m_byPosition.clear ();
+  m_moving.clear ();
+  m_unplaced.clear ();
+  m_lastUpdate = NanoSeconds (-1);
+}
+
+SpatialIndex::Cell
+SpatialIndex::GetCell (const Vector &position) const
+{
+  return Cell (static_cast<int64_t> (std::floor (position.x / m_cellSize)),
+               static_cast<int64_t> (std::floor (position.y / m_cellSize)));
+}
+
+void
+SpatialIndex::Update (uint32_t index)
+{
+  Entry &entry = m_entries[index];
+  Cell cell = GetCell (m_store->GetPosition (entry.position));
+  if (cell == entry.cell)
+    {
+      return;
+    }
+  std::map<Cell, std::vector<uint32_t> >::iterator old = m_cells.find (entry.cell);
+  NS_ASSERT (old != m_cells.end ());
+  old->second.erase (std::find (old->second.begin (), old->second.end (), index));
+  if (old->second.empty ())
+    {
+      m_cells.erase (old);
+    }
+  m_cells[cell].push_back (index);
+  entry.cell = cell;
+}
+
+void
+SpatialIndex::CourseChanged (const std::vector<uint32_t> &positions)
+{
+  NS_LOG_FUNCTION (this << positions.size ());
+  for (uint32_t k = 0; k < positions.size (); k++)
+    {
+      uint32_t index = m_byPosition[positions[k]];
+      Update (index);
+      Vector velocity = m_store->GetVelocity (positions[k]);
+      bool moving = velocity.x != 0 || velocity.y != 0;
+      m_entries[index].moving = moving;
+      if (moving)
+        {
+          m_moving.insert (index);
+        }
+      else
+        {
+          m_moving.erase (index);
+        }
+    }
+}
+
+void
+SpatialIndex::GetCandidates (const Vector &position, double range, std::vector<uint32_t> &ids)
+{
+  NS_LOG_FUNCTION (this << position << range);
+  ids.clear ();
+  m_store->NotifyCourseChanges ();
+  if (Simulator::Now () != m_lastUpdate)
+    {
+      // the moving entries may have left their cell since they were last
+      // placed, without changing course
+      for (std::set<uint32_t>::const_iterator i = m_moving.begin (); i != m_moving.end (); ++i)
+        {
+          Update (*i);
+        }
+      m_lastUpdate = Simulator::Now ();
+    }
+
+  Cell low = GetCell (Vector (position.x - range, position.y - range, 0));
+  Cell high = GetCell (Vector (position.x + range, position.y + range, 0));
+  double nCells = (double (high.first - low.first) + 1) * (double (high.second - low.second) + 1);
+  if (nCells > m_cells.size ())
+    {
+      // fewer occupied cells than cells in range
+      for (std::map<Cell, std::vector<uint32_t> >::const_iterator i = m_cells.begin (); i != m_cells.end (); ++i)
+        {
+          if (i->first.first >= low.first && i->first.first <= high.first
+              && i->first.second >= low.second && i->first.second <= high.second)
+            {
+              for (uint32_t k = 0; k < i->second.size (); k++)
+                {
+                  ids.push_back (m_entries[i->second[k]].id);
+                }
+            }
+        }
+    }
+  else
+    {
+      for (int64_t x = low.first; x <= high.first; x++)
+        {
+          std::map<Cell, std::vector<uint32_t> >::const_iterator i = m_cells.lower_bound (Cell (x, low.second));
+          for (; i != m_cells.end () && i->first.first == x && i->first.second <= high.second; ++i)
+            {
+              for (uint32_t k = 0; k < i->second.size (); k++)
+                {
+                  ids.push_back (m_entries[i->second[k]].id);
+                }
+            }
+        }
+    }
+  for (uint32_t k = 0; k < m_unplaced.size (); k++)
+    {
+      ids.push_back (m_entries[m_unplaced[k]].id);
+    }
+  std::sort (ids.begin (), ids.end ());
+}
+
+} // namespace ns3
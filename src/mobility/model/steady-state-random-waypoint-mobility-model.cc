@@ -282,6 +282,11 @@ SteadyStateRandomWaypointMobilityModel::DoGetVelocity (void) const
 {
   return m_helper.GetVelocity ();
 }
+bool
+SteadyStateRandomWaypointMobilityModel::DoIsPiecewiseLinear (void) const
+{
+  return true;
+}
 int64_t
 SteadyStateRandomWaypointMobilityModel::DoAssignStreams (int64_t stream)
 {
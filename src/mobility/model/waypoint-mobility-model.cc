@@ -212,6 +212,11 @@ WaypointMobilityModel::DoGetVelocity (void) const
 {
   return m_velocity;
 }
+bool
+WaypointMobilityModel::DoIsPiecewiseLinear (void) const
+{
+  return !m_lazyNotify;
+}
 
 } // namespace ns3
 
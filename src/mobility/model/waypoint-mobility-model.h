@@ -156,6 +156,12 @@ private:
    * \return The velocity vector of a node. 
    */
   virtual Vector DoGetVelocity (void) const;
+  /**
+   * \brief The velocity only changes at the waypoints, which are notified
+   * unless LazyNotify is set.
+   * \return true if LazyNotify is not set
+   */
+  virtual bool DoIsPiecewiseLinear (void) const;
 
   /**
    * \brief This variable is set to true if there are no waypoints in the std::deque
@@ -0,0 +1,203 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <cstring>
+#include <fstream>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include "ns3/log.h"
+#include "ns3/assert.h"
+#include "waypoint-trace-file.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("WaypointTraceFile");
+
+/// The magic characters of a waypoint file.
+static const char g_magic[8] = { 'N', 'S', '3', 'W', 'A', 'Y', 'P', 'T' };
+/// The byte order mark of a waypoint file.
+static const uint32_t g_byteOrder = 0x01020304;
+
+WaypointTraceFile::WaypointTraceFile ()
+  : m_map (0),
+    m_size (0),
+    m_nNodes (0),
+    m_index (0),
+    m_records (0)
+{
+  NS_LOG_FUNCTION (this);
+}
+
+WaypointTraceFile::~WaypointTraceFile ()
+{
+  NS_LOG_FUNCTION (this);
+  Close ();
+}
+
+bool
+WaypointTraceFile::Open (std::string filename)
+{
+  NS_LOG_FUNCTION (this << filename);
+  Close ();
+  int fd = open (filename.c_str (), O_RDONLY);
+  if (fd < 0)
+    {
+      NS_LOG_WARN ("Could not open " << filename);
+      return false;
+    }
+  struct stat st;
+  if (fstat (fd, &st) < 0 || st.st_size < static_cast<off_t> (sizeof (Header)))
+    {
+      NS_LOG_WARN ("Could not read the header of " << filename);
+      close (fd);
+      return false;
+    }
+  void *map = mmap (0, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+  // the mapping holds its own reference to the file
+  close (fd);
+  if (map == MAP_FAILED)
+    {
+      NS_LOG_WARN ("Could not map " << filename);
+      return false;
+    }
+  m_map = map;
+  m_size = st.st_size;
+
+  const Header *header = static_cast<const Header *> (m_map);
+  if (std::memcmp (header->magic, g_magic, sizeof (g_magic)) != 0 || header->byteOrder != g_byteOrder)
+    {
+      NS_LOG_WARN (filename << " is not a waypoint file of this host");
+      Close ();
+      return false;
+    }
+  uint64_t indexEnd = sizeof (Header) + uint64_t (header->nNodes) * sizeof (IndexEntry);
+  if (indexEnd > m_size)
+    {
+      NS_LOG_WARN ("Truncated index in " << filename);
+      Close ();
+      return false;
+    }
+  m_nNodes = header->nNodes;
+  m_index = reinterpret_cast<const IndexEntry *> (static_cast<const char *> (m_map) + sizeof (Header));
+  m_records = reinterpret_cast<const Record *> (static_cast<const char *> (m_map) + indexEnd);
+  uint64_t nRecords = (m_size - indexEnd) / sizeof (Record);
+  for (uint32_t i = 0; i < m_nNodes; i++)
+    {
+      if (m_index[i].first > nRecords || m_index[i].count > nRecords - m_index[i].first)
+        {
+          NS_LOG_WARN ("Waypoints of node " << i << " out of " << filename);
+          Close ();
+          return false;
+        }
+    }
+  return true;
+}
+
+void
+WaypointTraceFile::Close (void)
+{
+  NS_LOG_FUNCTION (this);
+  if (m_map != 0)
+    {
+      munmap (m_map, m_size);
+    }
+  m_map = 0;
+  m_size = 0;
+  m_nNodes = 0;
+  m_index = 0;
+  m_records = 0;
+}
+
+bool
+WaypointTraceFile::IsOpen (void) const
+{
+  return m_map != 0;
+}
+
+uint32_t
+WaypointTraceFile::GetNNodes (void) const
+{
+  return m_nNodes;
+}
+
+uint64_t
+WaypointTraceFile::GetNWaypoints (uint32_t node) const
+{
+  NS_ASSERT (node < m_nNodes);
+  return m_index[node].count;
+}
+
+const WaypointTraceFile::Record *
+WaypointTraceFile::GetWaypoints (uint32_t node) const
+{
+  NS_ASSERT (node < m_nNodes);
+  return m_records + m_index[node].first;
+}
+
+Waypoint
+WaypointTraceFile::GetWaypoint (uint32_t node, uint64_t index) const
+{
+  NS_ASSERT (index < GetNWaypoints (node));
+  const Record &record = GetWaypoints (node)[index];
+  return Waypoint (NanoSeconds (record.time), Vector (record.x, record.y, record.z));
+}
+
+bool
+WaypointTraceFile::Write (std::string filename, const std::vector<std::vector<Waypoint> > &waypoints)
+{
+  NS_LOG_FUNCTION (filename << waypoints.size ());
+  std::ofstream file (filename.c_str (), std::ios::out | std::ios::binary | std::ios::trunc);
+  if (!file.is_open ())
+    {
+      NS_LOG_WARN ("Could not open " << filename);
+      return false;
+    }
+  Header header;
+  std::memcpy (header.magic, g_magic, sizeof (g_magic));
+  header.byteOrder = g_byteOrder;
+  header.nNodes = waypoints.size ();
+  file.write (reinterpret_cast<const char *> (&header), sizeof (header));
+  uint64_t first = 0;
+  for (uint32_t i = 0; i < waypoints.size (); i++)
+    {
+      IndexEntry entry;
+      entry.first = first;
+      entry.count = waypoints[i].size ();
+      file.write (reinterpret_cast<const char *> (&entry), sizeof (entry));
+      first += entry.count;
+    }
+  for (uint32_t i = 0; i < waypoints.size (); i++)
+    {
+      for (uint32_t k = 0; k < waypoints[i].size (); k++)
+        {
+          const Waypoint &waypoint = waypoints[i][k];
+          NS_ASSERT_MSG (k == 0 || waypoints[i][k - 1].time < waypoint.time,
+                         "The waypoints of node " << i << " are not in increasing time");
+          Record record;
+          record.time = waypoint.time.GetNanoSeconds ();
+          record.x = waypoint.position.x;
+          record.y = waypoint.position.y;
+          record.z = waypoint.position.z;
+          file.write (reinterpret_cast<const char *> (&record), sizeof (record));
+        }
+    }
+  file.close ();
+  return !file.fail ();
+}
+
+} // namespace ns3
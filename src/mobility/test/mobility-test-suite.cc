@@ -23,14 +23,22 @@
  * involved).
  */
 
+#include <algorithm>
+
 #include "ns3/test.h"
 #include "ns3/boolean.h"
+#include "ns3/pointer.h"
 #include "ns3/simulator.h"
 #include "ns3/scheduler.h"
 #include "ns3/vector.h"
 #include "ns3/mobility-model.h"
 #include "ns3/waypoint-mobility-model.h"
 #include "ns3/mobility-helper.h"
+#include "ns3/mobility-store.h"
+#include "ns3/constant-position-mobility-model.h"
+#include "ns3/constant-acceleration-mobility-model.h"
+#include "ns3/rectangle.h"
+#include "ns3/string.h"
 
 using namespace ns3;
 
@@ -354,6 +362,144 @@ WaypointMobilityModelViaHelper::DoRun (void)
   Simulator::Destroy ();
 }
 
+// MobilityStore evaluates the same positions as the mobility models, and
+// notifies the course changes of a time step together
+class MobilityStoreTest : public TestCase
+{
+public:
+  MobilityStoreTest ();
+  virtual ~MobilityStoreTest ();
+
+private:
+  void TestPositions (void);
+  void CourseChanges (const std::vector<uint32_t> &indices);
+  virtual void DoRun (void);
+  Ptr<MobilityStore> m_store;
+  std::vector<Time> m_notifyTimes;
+  std::vector<std::vector<uint32_t> > m_notified;
+};
+
+MobilityStoreTest::MobilityStoreTest ()
+  : TestCase ("Test MobilityStore positions and course changes")
+{
+}
+
+MobilityStoreTest::~MobilityStoreTest ()
+{
+}
+
+void
+MobilityStoreTest::TestPositions (void)
+{
+  std::vector<Vector> positions;
+  m_store->GetPositions (positions);
+  NS_TEST_ASSERT_MSG_EQ (positions.size (), m_store->GetN (), "Wrong number of positions");
+  for (uint32_t i = 0; i < m_store->GetN (); i++)
+    {
+      Vector expected = m_store->GetMobility (i)->GetPosition ();
+      NS_TEST_EXPECT_MSG_EQ_TOL (positions[i].x, expected.x, 1e-6, "Wrong x of entry " << i << " at " << Simulator::Now ());
+      NS_TEST_EXPECT_MSG_EQ_TOL (positions[i].y, expected.y, 1e-6, "Wrong y of entry " << i << " at " << Simulator::Now ());
+      NS_TEST_EXPECT_MSG_EQ_TOL (positions[i].z, expected.z, 1e-6, "Wrong z of entry " << i << " at " << Simulator::Now ());
+      Vector position = m_store->GetPosition (i);
+      NS_TEST_EXPECT_MSG_EQ_TOL (position.x, positions[i].x, 1e-9, "Different positions of entry " << i);
+    }
+}
+
+void
+MobilityStoreTest::CourseChanges (const std::vector<uint32_t> &indices)
+{
+  m_notifyTimes.push_back (Simulator::Now ());
+  m_notified.push_back (indices);
+}
+
+void
+MobilityStoreTest::DoRun (void)
+{
+  m_store = CreateObject<MobilityStore> ();
+  m_store->TraceConnectWithoutContext ("CourseChanges", MakeCallback (&MobilityStoreTest::CourseChanges, this));
+
+  NodeContainer walkers;
+  walkers.Create (6);
+  MobilityHelper mobility;
+  Ptr<ListPositionAllocator> positions = CreateObject<ListPositionAllocator> ();
+  for (uint32_t i = 0; i < walkers.GetN (); i++)
+    {
+      positions->Add (Vector (10.0 * i, 20.0, 0.0));
+    }
+  mobility.SetPositionAllocator (positions);
+  mobility.SetMobilityModel ("ns3::RandomWaypointMobilityModel",
+                             "Speed", StringValue ("ns3::UniformRandomVariable[Min=1.0|Max=20.0]"),
+                             "Pause", StringValue ("ns3::ConstantRandomVariable[Constant=0.3]"),
+                             "PositionAllocator", PointerValue (positions));
+  mobility.Install (NodeContainer (walkers.Get (0), walkers.Get (1), walkers.Get (2)));
+  mobility.SetMobilityModel ("ns3::RandomWalk2dMobilityModel",
+                             "Bounds", RectangleValue (Rectangle (0, 60, 0, 40)),
+                             "Time", TimeValue (Seconds (0.7)),
+                             "Speed", StringValue ("ns3::ConstantRandomVariable[Constant=30.0]"));
+  mobility.Install (NodeContainer (walkers.Get (3), walkers.Get (4)));
+  mobility.SetMobilityModel ("ns3::ConstantAccelerationMobilityModel");
+  mobility.Install (walkers.Get (5));
+  walkers.Get (5)->GetObject<ConstantAccelerationMobilityModel> ()->SetVelocityAndAcceleration (Vector (1, 0, 0),
+                                                                                                Vector (0, 0.5, 0));
+  Ptr<WaypointMobilityModel> waypoints = CreateObject<WaypointMobilityModel> ();
+  waypoints->AddWaypoint (Waypoint (Seconds (1.0), Vector (0.0, 0.0, 0.0)));
+  waypoints->AddWaypoint (Waypoint (Seconds (3.0), Vector (10.0, 5.0, 2.0)));
+  waypoints->AddWaypoint (Waypoint (Seconds (4.5), Vector (-3.0, 5.0, 0.0)));
+
+  std::vector<Ptr<ConstantPositionMobilityModel> > fixed;
+  for (uint32_t i = 0; i < 3; i++)
+    {
+      fixed.push_back (CreateObject<ConstantPositionMobilityModel> ());
+      fixed[i]->SetPosition (Vector (i, 0, 0));
+    }
+
+  for (uint32_t i = 0; i < walkers.GetN (); i++)
+    {
+      m_store->Add (walkers.Get (i)->GetObject<MobilityModel> ());
+    }
+  m_store->Add (waypoints);
+  for (uint32_t i = 0; i < fixed.size (); i++)
+    {
+      m_store->Add (fixed[i]);
+    }
+  // a model may be added twice
+  m_store->Add (fixed[2]);
+  NS_TEST_ASSERT_MSG_EQ (m_store->GetN (), 11, "Wrong number of entries");
+
+  for (uint32_t k = 0; k <= 24; k++)
+    {
+      Simulator::Schedule (Seconds (0.25 * k), &MobilityStoreTest::TestPositions, this);
+    }
+  // the three fixed nodes jump at the same time, and are notified together
+  for (uint32_t i = 0; i < fixed.size (); i++)
+    {
+      Simulator::Schedule (Seconds (5.1), &MobilityModel::SetPosition, fixed[i], Vector (100, 10.0 * i, 0));
+    }
+  Simulator::Schedule (Seconds (5.1), &MobilityModel::SetPosition, fixed[0], Vector (200, 0, 0));
+  Simulator::Stop (Seconds (6.01));
+  Simulator::Run ();
+
+  NS_TEST_EXPECT_MSG_EQ (m_store->IsMoving (6), false, "The waypoints ended");
+  NS_TEST_EXPECT_MSG_EQ_TOL (m_store->GetPosition (7).x, 200, 1e-9, "Last position not kept");
+  uint32_t jumps = 0;
+  for (uint32_t k = 0; k < m_notifyTimes.size (); k++)
+    {
+      std::vector<uint32_t> sorted = m_notified[k];
+      std::sort (sorted.begin (), sorted.end ());
+      NS_TEST_EXPECT_MSG_EQ ((std::unique (sorted.begin (), sorted.end ()) == sorted.end ()), true,
+                             "Entry notified twice at " << m_notifyTimes[k]);
+      if (m_notifyTimes[k] == Seconds (5.1))
+        {
+          jumps++;
+          NS_TEST_EXPECT_MSG_EQ (m_notified[k].size (), 4, "The fixed nodes not notified together");
+        }
+    }
+  NS_TEST_EXPECT_MSG_EQ (jumps, 1, "The jumps not notified");
+  Simulator::Destroy ();
+  m_store->Dispose ();
+  m_store = 0;
+}
+
 class MobilityTestSuite : public TestSuite
 {
 public:
@@ -367,6 +513,7 @@ MobilityTestSuite::MobilityTestSuite ()
   AddTestCase (new WaypointLazyNotifyTrue, TestCase::QUICK);
   AddTestCase (new WaypointInitialPositionIsWaypoint, TestCase::QUICK);
   AddTestCase (new WaypointMobilityModelViaHelper, TestCase::QUICK);
+  AddTestCase (new MobilityStoreTest, TestCase::QUICK);
 }
 
 static MobilityTestSuite mobilityTestSuite;
@@ -0,0 +1,213 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <fstream>
+
+#include "ns3/test.h"
+#include "ns3/simulator.h"
+#include "ns3/node-container.h"
+#include "ns3/ns2-mobility-helper.h"
+#include "ns3/waypoint-mobility-model.h"
+#include "ns3/waypoint-trace-file.h"
+#include "ns3/waypoint-trace-helper.h"
+
+using namespace ns3;
+
+/**
+ * \brief Nodes moved by WaypointTraceHelper along an ns-2 trace follow
+ * the nodes moved by Ns2MobilityHelper along the same trace, while each
+ * waypoint model is given at most two waypoints ahead.
+ */
+class WaypointTraceNs2Test : public TestCase
+{
+public:
+  WaypointTraceNs2Test ();
+
+private:
+  virtual void DoRun (void);
+  /// Compare the positions of the nodes.
+  void Check (void);
+
+  NodeContainer m_ns2Nodes;       //!< The nodes moved by Ns2MobilityHelper.
+  NodeContainer m_waypointNodes;  //!< The nodes moved by WaypointTraceHelper.
+};
+
+WaypointTraceNs2Test::WaypointTraceNs2Test ()
+  : TestCase ("WaypointTraceHelper follows an ns-2 trace")
+{
+}
+
+void
+WaypointTraceNs2Test::Check (void)
+{
+  for (uint32_t i = 0; i < m_ns2Nodes.GetN (); i++)
+    {
+      Vector expected = m_ns2Nodes.Get (i)->GetObject<MobilityModel> ()->GetPosition ();
+      Ptr<WaypointMobilityModel> model = m_waypointNodes.Get (i)->GetObject<WaypointMobilityModel> ();
+      Vector position = model->GetPosition ();
+      NS_TEST_EXPECT_MSG_EQ_TOL (position.x, expected.x, 1e-6, "Wrong x of node " << i << " at " << Simulator::Now ());
+      NS_TEST_EXPECT_MSG_EQ_TOL (position.y, expected.y, 1e-6, "Wrong y of node " << i << " at " << Simulator::Now ());
+      NS_TEST_EXPECT_MSG_EQ_TOL (position.z, expected.z, 1e-6, "Wrong z of node " << i << " at " << Simulator::Now ());
+      NS_TEST_EXPECT_MSG_LT (model->WaypointsLeft (), 3, "Too many waypoints given to node " << i);
+    }
+}
+
+void
+WaypointTraceNs2Test::DoRun (void)
+{
+  std::string ns2File = CreateTempDirFilename ("WaypointTraceNs2Test.tcl");
+  std::string waypointFile = CreateTempDirFilename ("WaypointTraceNs2Test.wpt");
+  std::ofstream of (ns2File.c_str ());
+  of << "$node_(0) set X_ 0.0\n"
+     << "$node_(0) set Y_ 0.0\n"
+     << "$node_(0) set Z_ 0.0\n"
+     << "$node_(1) set X_ 100.0\n"
+     << "$node_(1) set Y_ 50.0\n"
+     << "$node_(1) set Z_ 0.0\n"
+     << "$ns_ at 1.0 \"$node_(0) setdest 30.0 40.0 5.0\"\n"
+     << "$ns_ at 2.0 \"$node_(1) setdest 200.0 50.0 10.0\"\n"
+     // interrupted at 140 50
+     << "$ns_ at 6.0 \"$node_(1) setdest 100.0 0.0 20.0\"\n"
+     // stopped on the way
+     << "$ns_ at 8.0 \"$node_(1) setdest 100.0 0.0 0.0\"\n"
+     << "$ns_ at 15.0 \"$node_(0) setdest 0.0 40.0 10.0\"\n"
+     << "$ns_ at 22.0 \"$node_(0) setdest 10.0 40.0 1.0\"\n"
+     << "$ns_ at 25.0 \"$node_(1) setdest 130.0 0.0 5.0\"\n"
+     // the initial position of a node may come last
+     << "$ns_ at 3.0 \"$node_(2) setdest 10.0 10.0 2.0\"\n"
+     << "$node_(2) set X_ 10.0\n"
+     << "$node_(2) set Y_ 20.0\n";
+  of.close ();
+
+  WaypointTraceHelper::ConvertNs2 (ns2File, waypointFile);
+  m_ns2Nodes.Create (3);
+  m_waypointNodes.Create (3);
+  Ns2MobilityHelper ns2 (ns2File);
+  ns2.Install (m_ns2Nodes.Begin (), m_ns2Nodes.End ());
+  {
+    // the nodes keep the file mapped after the helper is gone
+    WaypointTraceHelper waypoints (waypointFile);
+    NS_TEST_ASSERT_MSG_EQ (waypoints.GetNNodes (), 3, "Wrong number of nodes");
+    waypoints.Install (m_waypointNodes);
+  }
+
+  for (uint32_t k = 0; k < 62; k++)
+    {
+      Simulator::Schedule (Seconds (0.25 + 0.5 * k), &WaypointTraceNs2Test::Check, this);
+    }
+  Simulator::Run ();
+  Simulator::Destroy ();
+  m_ns2Nodes = NodeContainer ();
+  m_waypointNodes = NodeContainer ();
+
+  // Ns2MobilityHelper moves a node set at a time from where it was at the
+  // start, so the scheduled positions are checked on the file instead
+  of.open (ns2File.c_str ());
+  of << "$node_(0) set X_ 0.0\n"
+     << "$node_(0) set Y_ 0.0\n"
+     << "$ns_ at 1.0 \"$node_(0) setdest 10.0 0.0 1.0\"\n"
+     << "$ns_ at 5.0 \"$node_(0) set Y_ 30.0\"\n";
+  of.close ();
+  WaypointTraceHelper::ConvertNs2 (ns2File, waypointFile);
+  Ptr<WaypointTraceFile> file = Create<WaypointTraceFile> ();
+  NS_TEST_ASSERT_MSG_EQ (file->Open (waypointFile), true, "Could not open the waypoint file");
+  NS_TEST_ASSERT_MSG_EQ (file->GetNWaypoints (0), 4, "Wrong number of waypoints");
+  Waypoint before = file->GetWaypoint (0, 2);
+  Waypoint after = file->GetWaypoint (0, 3);
+  NS_TEST_EXPECT_MSG_EQ (before.time, Seconds (5), "Wrong time");
+  NS_TEST_EXPECT_MSG_EQ_TOL (before.position.x, 4, 1e-9, "Wrong position");
+  NS_TEST_EXPECT_MSG_EQ_TOL (before.position.y, 0, 1e-9, "Wrong position");
+  NS_TEST_EXPECT_MSG_EQ (after.time, Seconds (5) + NanoSeconds (1), "Wrong time");
+  NS_TEST_EXPECT_MSG_EQ_TOL (after.position.x, 4, 1e-9, "Wrong position");
+  NS_TEST_EXPECT_MSG_EQ_TOL (after.position.y, 30, 1e-9, "Wrong position");
+}
+
+/**
+ * \brief CSV traces: the header, the order of the lines and the optional
+ * z coordinate; and invalid waypoint files.
+ */
+class WaypointTraceCsvTest : public TestCase
+{
+public:
+  WaypointTraceCsvTest ();
+
+private:
+  virtual void DoRun (void);
+};
+
+WaypointTraceCsvTest::WaypointTraceCsvTest ()
+  : TestCase ("WaypointTraceHelper converts a CSV trace")
+{
+}
+
+void
+WaypointTraceCsvTest::DoRun (void)
+{
+  std::string csvFile = CreateTempDirFilename ("WaypointTraceCsvTest.csv");
+  std::string waypointFile = CreateTempDirFilename ("WaypointTraceCsvTest.wpt");
+  std::ofstream of (csvFile.c_str ());
+  of << "node,time,x,y,z\n"
+     << "# a comment\n"
+     << "1,10,0,0\n"
+     << "0,0,0,0,0\n"
+     << "0,10,100,0,10\n"
+     << "1,0,50,50\n"
+     << "0,5,0,0,0\n"
+     << "0,5,20,0,0\n";
+  of.close ();
+  WaypointTraceHelper::ConvertCsv (csvFile, waypointFile);
+
+  Ptr<WaypointTraceFile> file = Create<WaypointTraceFile> ();
+  NS_TEST_ASSERT_MSG_EQ (file->Open (waypointFile), true, "Could not open the waypoint file");
+  NS_TEST_ASSERT_MSG_EQ (file->GetNNodes (), 2, "Wrong number of nodes");
+  NS_TEST_ASSERT_MSG_EQ (file->GetNWaypoints (0), 3, "Wrong number of waypoints");
+  NS_TEST_ASSERT_MSG_EQ (file->GetNWaypoints (1), 2, "Wrong number of waypoints");
+  // the last waypoint of a time replaces the others
+  NS_TEST_EXPECT_MSG_EQ (file->GetWaypoint (0, 1).time, Seconds (5), "Wrong order");
+  NS_TEST_EXPECT_MSG_EQ_TOL (file->GetWaypoint (0, 1).position.x, 20, 1e-9, "Wrong waypoint");
+  NS_TEST_EXPECT_MSG_EQ_TOL (file->GetWaypoint (0, 2).position.z, 10, 1e-9, "Wrong z");
+  NS_TEST_EXPECT_MSG_EQ_TOL (file->GetWaypoint (1, 0).position.y, 50, 1e-9, "Wrong order");
+  file->Close ();
+
+  NodeContainer nodes;
+  nodes.Create (2);
+  WaypointTraceHelper waypoints (waypointFile);
+  waypoints.Install (nodes);
+  Simulator::Stop (Seconds (7.5));
+  Simulator::Run ();
+  Vector position = nodes.Get (0)->GetObject<MobilityModel> ()->GetPosition ();
+  NS_TEST_EXPECT_MSG_EQ_TOL (position.x, 60, 1e-6, "Wrong position");
+  NS_TEST_EXPECT_MSG_EQ_TOL (position.z, 5, 1e-6, "Wrong position");
+  position = nodes.Get (1)->GetObject<MobilityModel> ()->GetPosition ();
+  NS_TEST_EXPECT_MSG_EQ_TOL (position.x, 12.5, 1e-6, "Wrong position");
+  Simulator::Destroy ();
+
+  NS_TEST_EXPECT_MSG_EQ (file->Open (csvFile), false, "A CSV file opened as a waypoint file");
+  NS_TEST_EXPECT_MSG_EQ (file->Open (CreateTempDirFilename ("missing.wpt")), false, "A missing file opened");
+}
+
+//-----------------------------------------------------------------------------
+class WaypointTraceTestSuite : public TestSuite
+{
+public:
+  WaypointTraceTestSuite () : TestSuite ("waypoint-trace", UNIT)
+  {
+    AddTestCase (new WaypointTraceNs2Test (), TestCase::QUICK);
+    AddTestCase (new WaypointTraceCsvTest (), TestCase::QUICK);
+  }
+};
+
+static WaypointTraceTestSuite g_waypointTraceTestSuite;
@@ -18,6 +18,7 @@
  * Author: Mathieu Lacage <mathieu.lacage@sophia.inria.fr>
  */
 #include "buffer.h"
+#include "packet-pool.h"
 #include "ns3/assert.h"
 #include "ns3/log.h"
 
@@ -51,6 +52,8 @@ NS_LOG_COMPONENT_DEFINE ("Buffer");
 
 
 uint32_t Buffer::g_recommendedStart = 0;
+const uint32_t Buffer::HEAD_SEGMENT_THRESHOLD;
+const uint32_t Buffer::HEAD_SEGMENT_SIZE;
 #ifdef BUFFER_FREE_LIST
 /* The following macros are pretty evil but they are needed to allow us to
  * keep track of 3 possible states for the g_freeList variable:
@@ -185,6 +188,33 @@ Buffer::Deallocate (struct Buffer::Data *data)
   delete [] buf;
 }
 
+struct Buffer::Data *
+Buffer::CreateHead (uint32_t reqSize)
+{
+  NS_LOG_FUNCTION (reqSize);
+  // head segments are small and short-lived: take them from the
+  // packet pool, and use all the memory of the size class.
+  uint32_t size = PacketPool::GetCapacity (std::max<uint32_t> (reqSize - 1 + sizeof (struct Buffer::Data),
+                                                              HEAD_SEGMENT_SIZE));
+  struct Buffer::Data *head = static_cast<struct Buffer::Data *> (PacketPool::Allocate (size));
+  head->m_size = size + 1 - sizeof (struct Buffer::Data);
+  head->m_count = 1;
+  head->m_dirtyStart = head->m_size;
+  head->m_dirtyEnd = head->m_size;
+  return head;
+}
+
+void
+Buffer::ReleaseHead (struct Buffer::Data *head)
+{
+  NS_LOG_FUNCTION (head);
+  head->m_count--;
+  if (head->m_count == 0)
+    {
+      PacketPool::Deallocate (head, head->m_size - 1 + sizeof (struct Buffer::Data));
+    }
+}
+
 Buffer::Buffer ()
 {
   NS_LOG_FUNCTION (this);
@@ -198,6 +228,8 @@ Buffer::Buffer (uint32_t dataSize)
 }
 
 Buffer::Buffer (uint32_t dataSize, bool initialize)
+  : m_head (0),
+    m_headSize (0)
 {
   NS_LOG_FUNCTION (this << dataSize << initialize);
   if (initialize == true)
@@ -226,13 +258,23 @@ Buffer::CheckInternalState (void) const
     m_start <= m_data->m_size &&
     m_zeroAreaStart <= m_data->m_size;
 
-  bool ok = m_data->m_count > 0 && offsetsOk && dirtyOk && internalSizeOk;
+  bool headOk = (m_head == 0) == (m_headSize == 0);
+  if (m_head != 0)
+    {
+      headOk = headOk && m_head->m_count > 0 &&
+        m_headSize <= m_head->m_size &&
+        m_head->m_dirtyStart <= m_head->m_size - m_headSize &&
+        m_head->m_dirtyEnd == m_head->m_size;
+    }
+
+  bool ok = m_data->m_count > 0 && offsetsOk && dirtyOk && internalSizeOk && headOk;
   if (!ok)
     {
       LOG_INTERNAL_STATE ("check " << this << 
                           ", " << (offsetsOk ? "true" : "false") <<
                           ", " << (dirtyOk ? "true" : "false") <<
-                          ", " << (internalSizeOk ? "true" : "false") << " ");
+                          ", " << (internalSizeOk ? "true" : "false") <<
+                          ", " << (headOk ? "true" : "false") << " ");
     }
   return ok;
 #else
@@ -245,6 +287,8 @@ Buffer::Initialize (uint32_t zeroSize)
 {
   NS_LOG_FUNCTION (this << zeroSize);
   m_data = Buffer::Create (0);
+  m_head = 0;
+  m_headSize = 0;
   m_start = std::min (m_data->m_size, g_recommendedStart);
   m_maxZeroAreaStart = m_start;
   m_zeroAreaStart = m_start;
@@ -270,6 +314,19 @@ Buffer::operator = (Buffer const&o)
       m_data = o.m_data;
       m_data->m_count++;
     }
+  if (m_head != o.m_head)
+    {
+      if (o.m_head != 0)
+        {
+          o.m_head->m_count++;
+        }
+      if (m_head != 0)
+        {
+          ReleaseHead (m_head);
+        }
+      m_head = o.m_head;
+    }
+  m_headSize = o.m_headSize;
   g_recommendedStart = std::max (g_recommendedStart, m_maxZeroAreaStart);
   m_maxZeroAreaStart = o.m_maxZeroAreaStart;
   m_zeroAreaStart = o.m_zeroAreaStart;
@@ -290,6 +347,10 @@ Buffer::~Buffer ()
     {
       Recycle (m_data);
     }
+  if (m_head != 0)
+    {
+      ReleaseHead (m_head);
+    }
 }
 
 uint32_t
@@ -311,7 +372,12 @@ Buffer::AddAtStart (uint32_t start)
   NS_LOG_FUNCTION (this << start);
   NS_ASSERT (CheckInternalState ());
   bool isDirty = m_data->m_count > 1 && m_start > m_data->m_dirtyStart;
-  if (m_start >= start && !isDirty)
+  if (m_head != 0)
+    {
+      /* the bytes before m_start are in the head segment */
+      AddAtStartOfHead (start);
+    }
+  else if (m_start >= start && !isDirty)
     {
       /* enough space in the buffer and not dirty. 
        * To add: |..|
@@ -323,6 +389,13 @@ Buffer::AddAtStart (uint32_t start)
       // update dirty area
       m_data->m_dirtyStart = m_start;
     } 
+  else if (GetInternalSize () >= HEAD_SEGMENT_THRESHOLD)
+    {
+      /* no room before m_start: rather than copying the data,
+       * put the new bytes in a head segment.
+       */
+      AddAtStartOfHead (start);
+    }
   else
     {
       uint32_t newSize = GetInternalSize () + start;
@@ -350,6 +423,33 @@ Buffer::AddAtStart (uint32_t start)
   LOG_INTERNAL_STATE ("add start=" << start << ", ");
   NS_ASSERT (CheckInternalState ());
 }
+void
+Buffer::AddAtStartOfHead (uint32_t start)
+{
+  NS_LOG_FUNCTION (this << start);
+  if (m_head != 0)
+    {
+      uint32_t headStart = m_head->m_size - m_headSize;
+      bool isDirty = m_head->m_count > 1 && headStart > m_head->m_dirtyStart;
+      if (headStart >= start && !isDirty)
+        {
+          m_headSize += start;
+          m_head->m_dirtyStart = m_head->m_size - m_headSize;
+          return;
+        }
+    }
+  struct Buffer::Data *head = Buffer::CreateHead (m_headSize + start);
+  if (m_head != 0)
+    {
+      memcpy (head->m_data + head->m_size - m_headSize,
+              m_head->m_data + m_head->m_size - m_headSize, m_headSize);
+      ReleaseHead (m_head);
+    }
+  m_head = head;
+  m_headSize += start;
+  m_head->m_dirtyStart = m_head->m_size - m_headSize;
+}
+
 void
 Buffer::AddAtEnd (uint32_t end)
 {
@@ -403,6 +503,7 @@ Buffer::AddAtEnd (const Buffer &o)
   if (m_data->m_count == 1 &&
       m_end == m_zeroAreaEnd &&
       m_end == m_data->m_dirtyEnd &&
+      o.m_head == 0 &&
       o.m_start == o.m_zeroAreaStart &&
       o.m_zeroAreaEnd - o.m_zeroAreaStart > 0)
     {
@@ -442,6 +543,21 @@ Buffer::RemoveAtStart (uint32_t start)
 {
   NS_LOG_FUNCTION (this << start);
   NS_ASSERT (CheckInternalState ());
+  if (m_head != 0)
+    {
+      if (start < m_headSize)
+        {
+          /* only remove start of the head segment */
+          m_headSize -= start;
+          NS_ASSERT (CheckInternalState ());
+          return;
+        }
+      /* remove the head segment */
+      start -= m_headSize;
+      ReleaseHead (m_head);
+      m_head = 0;
+      m_headSize = 0;
+    }
   uint32_t newStart = m_start + start;
   if (newStart <= m_zeroAreaStart)
     {
@@ -487,6 +603,11 @@ Buffer::RemoveAtEnd (uint32_t end)
 {
   NS_LOG_FUNCTION (this << end);
   NS_ASSERT (CheckInternalState ());
+  if (m_head != 0 && end > m_end - m_start)
+    {
+      /* the end of the head segment goes too: merge the segments */
+      TransformIntoRealBuffer ();
+    }
   uint32_t newEnd = m_end - std::min (end, m_end - m_start);
   if (newEnd > m_zeroAreaEnd)
     {
@@ -535,6 +656,15 @@ Buffer::CreateFullCopy (void) const
 {
   NS_LOG_FUNCTION (this);
   NS_ASSERT (CheckInternalState ());
+  if (m_head != 0)
+    {
+      Buffer tmp;
+      tmp.AddAtStart (GetSize ());
+      NS_ASSERT (tmp.m_head == 0 && tmp.m_zeroAreaStart == tmp.m_end);
+      CopyData (tmp.m_data->m_data + tmp.m_start, GetSize ());
+      NS_ASSERT (tmp.CheckInternalState ());
+      return tmp;
+    }
   if (m_zeroAreaEnd - m_zeroAreaStart != 0) 
     {
       Buffer tmp;
@@ -559,6 +689,10 @@ uint32_t
 Buffer::GetSerializedSize (void) const
 {
   NS_LOG_FUNCTION (this);
+  if (m_head != 0)
+    {
+      return CreateFullCopy ().GetSerializedSize ();
+    }
   uint32_t dataStart = (m_zeroAreaStart - m_start + 3) & (~0x3);
   uint32_t dataEnd = (m_end - m_zeroAreaEnd + 3) & (~0x3);
 
@@ -579,6 +713,10 @@ uint32_t
 Buffer::Serialize (uint8_t* buffer, uint32_t maxSize) const
 {
   NS_LOG_FUNCTION (this << &buffer << maxSize);
+  if (m_head != 0)
+    {
+      return CreateFullCopy ().Serialize (buffer, maxSize);
+    }
   uint32_t* p = reinterpret_cast<uint32_t *> (buffer);
   uint32_t size = 0;
 
@@ -715,6 +853,12 @@ void
 Buffer::CopyData (std::ostream *os, uint32_t size) const
 {
   NS_LOG_FUNCTION (this << &os << size);
+  if (m_head != 0 && size > 0)
+    {
+      uint32_t tmpsize = std::min (m_headSize, size);
+      os->write ((const char*)(m_head->m_data + m_head->m_size - m_headSize), tmpsize);
+      size -= tmpsize;
+    }
   if (size > 0)
     {
       uint32_t tmpsize = std::min (m_zeroAreaStart-m_start, size);
@@ -745,6 +889,13 @@ Buffer::CopyData (uint8_t *buffer, uint32_t size) const
 {
   NS_LOG_FUNCTION (this << &buffer << size);
   uint32_t originalSize = size;
+  if (m_head != 0 && size > 0)
+    {
+      uint32_t tmpsize = std::min (m_headSize, size);
+      memcpy (buffer, m_head->m_data + m_head->m_size - m_headSize, tmpsize);
+      buffer += tmpsize;
+      size -= tmpsize;
+    }
   if (size > 0)
     {
       uint32_t tmpsize = std::min (m_zeroAreaStart-m_start, size);
@@ -843,6 +994,15 @@ Buffer::Iterator::Write (Iterator start, Iterator end)
   uint32_t size = end.m_current - start.m_current;
   NS_ASSERT_MSG (CheckNoZero (m_current, m_current + size),
                  GetWriteErrorMessage ());
+  if (m_headSize != 0 || start.m_headSize != 0)
+    {
+      // the bytes are split among segments.
+      for (uint32_t i = 0; i < size; i++)
+        {
+          WriteU8 (start.ReadU8 ());
+        }
+      return;
+    }
   if (start.m_current <= start.m_zeroStart)
     {
       uint32_t toCopy = std::min (size, start.m_zeroStart - start.m_current);
@@ -955,14 +1115,22 @@ Buffer::Iterator::Write (uint8_t const*buffer, uint32_t size)
   NS_LOG_FUNCTION (this << &buffer << size);
   NS_ASSERT_MSG (CheckNoZero (m_current, size),
                  GetWriteErrorMessage ());
+  if (m_current < m_headEnd)
+    {
+      uint32_t toCopy = std::min (size, m_headEnd - m_current);
+      memcpy (&m_head[m_current - m_dataStart], buffer, toCopy);
+      m_current += toCopy;
+      buffer += toCopy;
+      size -= toCopy;
+    }
   uint8_t *to;
   if (m_current <= m_zeroStart)
     {
-      to = &m_data[m_current];
+      to = &m_data[m_current - m_headSize];
     }
   else
     {
-      to = &m_data[m_current - (m_zeroEnd - m_zeroStart)];
+      to = &m_data[m_current - m_headSize - (m_zeroEnd - m_zeroStart)];
     }
   memcpy (to, buffer, size);
   m_current += size;
@@ -88,6 +88,25 @@ namespace ns3 {
  * \endverbatim
  *
  * A simple state invariant is that m_start <= m_zeroStart <= m_zeroEnd <= m_end
+ *
+ * Bytes added at the start of a buffer whose BufferData is shared
+ * and dirty, or has no room left before m_start, require a copy of
+ * the whole BufferData. When the buffer holds more than
+ * HEAD_SEGMENT_THRESHOLD real bytes, these bytes are instead written
+ * to a small "head segment", a second BufferData which precedes
+ * the first one:
+ *
+ * \verbatim
+ * Head segment:          |*****hhhhhh|
+ *                        |-----^ m_head->m_size - m_headSize
+ * Virtual byte buffer:        |hhhhhhxxxxxxxxxxxx0000000000000.........|
+ * \endverbatim
+ *
+ * Further headers go to the head segment, so that nested
+ * encapsulations cost a copy of the headers rather than of the
+ * payload. The head segment is shared and copied on write like the
+ * BufferData it precedes. Operations which need contiguous bytes
+ * (PeekData, Serialize) merge both segments first.
  */
 class Buffer 
 {
@@ -473,9 +492,24 @@ private:
     uint32_t m_current;
     /**
      * a pointer to the underlying byte buffer. All offsets are relative
-     * to this pointer.
+     * to this pointer, minus m_headSize.
      */
     uint8_t *m_data;
+    /**
+     * offset in virtual bytes from the start of the data buffer to the
+     * end of the head segment. Equal to m_dataStart without head segment.
+     */
+    uint32_t m_headEnd;
+    /**
+     * size of the head segment, in bytes. The offsets of the bytes
+     * of the underlying byte buffer are shifted by this size.
+     */
+    uint32_t m_headSize;
+    /**
+     * a pointer to the bytes of the head segment. The byte at offset
+     * m_dataStart is the first one.
+     */
+    uint8_t *m_head;
   };
 
   /**
@@ -742,8 +776,47 @@ private:
    * \param data the buffer data storage
    */
   static void Deallocate (struct Buffer::Data *data);
+  /**
+   * \brief Allocate the storage of a head segment
+   * \param reqSize the storage size to create
+   * \returns a pointer to the allocated storage
+   */
+  static struct Buffer::Data *CreateHead (uint32_t reqSize);
+  /**
+   * \brief Release a reference to the storage of a head segment
+   * \param head the storage
+   */
+  static void ReleaseHead (struct Buffer::Data *head);
+  /**
+   * \brief Add bytes at the start of the head segment, creating
+   * or copying the head segment if needed.
+   * \param start size to reserve
+   */
+  void AddAtStartOfHead (uint32_t start);
+
+  /**
+   * Minimum number of real bytes in a buffer for the bytes added
+   * at its start to go to a head segment rather than to a copy
+   * of the buffer.
+   */
+  static const uint32_t HEAD_SEGMENT_THRESHOLD = 256;
+  /**
+   * Size of the allocation of a new head segment, storage header
+   * included.
+   */
+  static const uint32_t HEAD_SEGMENT_SIZE = 128;
 
   struct Data *m_data; //!< the buffer data storage
+  /**
+   * the head segment storage, or zero. Its bytes precede the ones
+   * of m_data, and end at the end of its storage.
+   */
+  struct Data *m_head;
+  /**
+   * number of bytes in the head segment. Zero if and only if
+   * m_head is zero.
+   */
+  uint32_t m_headSize;
 
   /**
    * keep track of the maximum value of m_zeroAreaStart across
@@ -811,7 +884,10 @@ Buffer::Iterator::Iterator ()
     m_dataStart (0),
     m_dataEnd (0),
     m_current (0),
-    m_data (0)
+    m_data (0),
+    m_headEnd (0),
+    m_headSize (0),
+    m_head (0)
 {
 }
 Buffer::Iterator::Iterator (Buffer const*buffer)
@@ -828,11 +904,18 @@ Buffer::Iterator::Iterator (Buffer const*buffer, bool dummy)
 void
 Buffer::Iterator::Construct (const Buffer *buffer)
 {
-  m_zeroStart = buffer->m_zeroAreaStart;
-  m_zeroEnd = buffer->m_zeroAreaEnd;
+  m_headSize = buffer->m_headSize;
+  m_zeroStart = buffer->m_zeroAreaStart + m_headSize;
+  m_zeroEnd = buffer->m_zeroAreaEnd + m_headSize;
   m_dataStart = buffer->m_start;
-  m_dataEnd = buffer->m_end;
+  m_dataEnd = buffer->m_end + m_headSize;
+  m_headEnd = buffer->m_start + m_headSize;
   m_data = buffer->m_data->m_data;
+  m_head = 0;
+  if (m_headSize != 0)
+    {
+      m_head = buffer->m_head->m_data + buffer->m_head->m_size - m_headSize;
+    }
 }
 
 void 
@@ -865,14 +948,19 @@ Buffer::Iterator::WriteU8 (uint8_t data)
   NS_ASSERT_MSG (Check (m_current),
                  GetWriteErrorMessage ());
 
-  if (m_current < m_zeroStart)
+  if (m_current < m_headEnd)
+    {
+      m_head[m_current - m_dataStart] = data;
+      m_current++;
+    }
+  else if (m_current < m_zeroStart)
     {
-      m_data[m_current] = data;
+      m_data[m_current - m_headSize] = data;
       m_current++;
     }
   else
     {
-      m_data[m_current - (m_zeroEnd-m_zeroStart)] = data;
+      m_data[m_current - m_headSize - (m_zeroEnd-m_zeroStart)] = data;
       m_current++;
     }
 }
@@ -882,14 +970,21 @@ Buffer::Iterator::WriteU8 (uint8_t  data, uint32_t len)
 {
   NS_ASSERT_MSG (CheckNoZero (m_current, m_current + len),
                  GetWriteErrorMessage ());
-  if (m_current <= m_zeroStart)
+  if (m_current < m_headEnd)
     {
-      std::memset (&(m_data[m_current]), data, len);
+      for (uint32_t i = 0; i < len; i++)
+        {
+          WriteU8 (data);
+        }
+    }
+  else if (m_current <= m_zeroStart)
+    {
+      std::memset (&(m_data[m_current - m_headSize]), data, len);
       m_current += len;
     }
   else
     {
-      uint8_t *buffer = &m_data[m_current - (m_zeroEnd-m_zeroStart)];
+      uint8_t *buffer = &m_data[m_current - m_headSize - (m_zeroEnd-m_zeroStart)];
       std::memset (buffer, data, len);
       m_current += len;
     }
@@ -900,14 +995,20 @@ Buffer::Iterator::WriteHtonU16 (uint16_t data)
 {
   NS_ASSERT_MSG (CheckNoZero (m_current, m_current + 2),
                  GetWriteErrorMessage ());
+  if (m_current < m_headEnd)
+    {
+      WriteU8 ((data >> 8) & 0xff);
+      WriteU8 ((data >> 0) & 0xff);
+      return;
+    }
   uint8_t *buffer;
   if (m_current + 2 <= m_zeroStart)
     {
-      buffer = &m_data[m_current];
+      buffer = &m_data[m_current - m_headSize];
     }
   else
     {
-      buffer = &m_data[m_current - (m_zeroEnd - m_zeroStart)];
+      buffer = &m_data[m_current - m_headSize - (m_zeroEnd - m_zeroStart)];
     }
   buffer[0] = (data >> 8)& 0xff;
   buffer[1] = (data >> 0)& 0xff;
@@ -920,14 +1021,22 @@ Buffer::Iterator::WriteHtonU32 (uint32_t data)
   NS_ASSERT_MSG (CheckNoZero (m_current, m_current + 4),
                  GetWriteErrorMessage ());
 
+  if (m_current < m_headEnd)
+    {
+      WriteU8 ((data >> 24) & 0xff);
+      WriteU8 ((data >> 16) & 0xff);
+      WriteU8 ((data >> 8) & 0xff);
+      WriteU8 ((data >> 0) & 0xff);
+      return;
+    }
   uint8_t *buffer;
   if (m_current + 4 <= m_zeroStart)
     {
-      buffer = &m_data[m_current];
+      buffer = &m_data[m_current - m_headSize];
     }
   else
     {
-      buffer = &m_data[m_current - (m_zeroEnd - m_zeroStart)];
+      buffer = &m_data[m_current - m_headSize - (m_zeroEnd - m_zeroStart)];
     }
   buffer[0] = (data >> 24)& 0xff;
   buffer[1] = (data >> 16)& 0xff;
@@ -940,13 +1049,13 @@ uint16_t
 Buffer::Iterator::ReadNtohU16 (void)
 {
   uint8_t *buffer;
-  if (m_current + 2 <= m_zeroStart)
+  if (m_current >= m_headEnd && m_current + 2 <= m_zeroStart)
     {
-      buffer = &m_data[m_current];
+      buffer = &m_data[m_current - m_headSize];
     }
   else if (m_current >= m_zeroEnd)
     {
-      buffer = &m_data[m_current - (m_zeroEnd - m_zeroStart)];
+      buffer = &m_data[m_current - m_headSize - (m_zeroEnd - m_zeroStart)];
     }
   else
     {
@@ -964,13 +1073,13 @@ uint32_t
 Buffer::Iterator::ReadNtohU32 (void)
 {
   uint8_t *buffer;
-  if (m_current + 4 <= m_zeroStart)
+  if (m_current >= m_headEnd && m_current + 4 <= m_zeroStart)
     {
-      buffer = &m_data[m_current];
+      buffer = &m_data[m_current - m_headSize];
     }
   else if (m_current >= m_zeroEnd)
     {
-      buffer = &m_data[m_current - (m_zeroEnd - m_zeroStart)];
+      buffer = &m_data[m_current - m_headSize - (m_zeroEnd - m_zeroStart)];
     }
   else
     {
@@ -995,9 +1104,13 @@ Buffer::Iterator::PeekU8 (void)
                  m_current < m_dataEnd,
                  GetReadErrorMessage ());
 
-  if (m_current < m_zeroStart)
+  if (m_current < m_headEnd)
+    {
+      return m_head[m_current - m_dataStart];
+    }
+  else if (m_current < m_zeroStart)
     {
-      uint8_t data = m_data[m_current];
+      uint8_t data = m_data[m_current - m_headSize];
       return data;
     }
   else if (m_current < m_zeroEnd)
@@ -1006,7 +1119,7 @@ Buffer::Iterator::PeekU8 (void)
     }
   else
     {
-      uint8_t data = m_data[m_current - (m_zeroEnd-m_zeroStart)];
+      uint8_t data = m_data[m_current - m_headSize - (m_zeroEnd-m_zeroStart)];
       return data;
     }
 }
@@ -1043,6 +1156,8 @@ Buffer::Iterator::Read (Buffer::Iterator start, uint32_t size)
 
 Buffer::Buffer (Buffer const&o)
   : m_data (o.m_data),
+    m_head (o.m_head),
+    m_headSize (o.m_headSize),
     m_maxZeroAreaStart (o.m_zeroAreaStart),
     m_zeroAreaStart (o.m_zeroAreaStart),
     m_zeroAreaEnd (o.m_zeroAreaEnd),
@@ -1050,13 +1165,17 @@ Buffer::Buffer (Buffer const&o)
     m_end (o.m_end)
 {
   m_data->m_count++;
+  if (m_head != 0)
+    {
+      m_head->m_count++;
+    }
   NS_ASSERT (CheckInternalState ());
 }
 
 uint32_t 
 Buffer::GetSize (void) const
 {
-  return m_end - m_start;
+  return m_end - m_start + m_headSize;
 }
 
 Buffer::Iterator 
@@ -18,12 +18,12 @@
  * Author: Mathieu Lacage <mathieu.lacage@sophia.inria.fr>
  */
 #include "byte-tag-list.h"
+#include "packet-pool.h"
 #include "ns3/log.h"
 #include <vector>
 #include <cstring>
 
 #define USE_FREE_LIST 1
-#define FREE_LIST_SIZE 1000
 #define OFFSET_MAX (2147483647)
 
 namespace ns3 {
@@ -44,32 +44,6 @@ struct ByteTagListData {
   uint8_t data[4]; //!< data
 };
 
-#ifdef USE_FREE_LIST
-/**
- * \ingroup packet
- *
- * \brief Container class for struct ByteTagListData
- *
- * Internal use only.
- */
-static class ByteTagListDataFreeList : public std::vector<struct ByteTagListData *>
-{
-public:
-  ~ByteTagListDataFreeList ();
-} g_freeList; //!< Container for struct ByteTagListData
-static uint32_t g_maxSize = 0; //!< maximum data size (used for allocation)
-
-ByteTagListDataFreeList::~ByteTagListDataFreeList ()
-{
-  NS_LOG_FUNCTION (this);
-  for (ByteTagListDataFreeList::iterator i = begin ();
-       i != end (); i++)
-    {
-      uint8_t *buffer = (uint8_t *)(*i);
-      delete [] buffer;
-    }
-}
-#endif /* USE_FREE_LIST */
 
 ByteTagList::Iterator::Item::Item (TagBuffer buf_)
   : buf (buf_)
@@ -344,24 +318,11 @@ struct ByteTagListData *
 ByteTagList::Allocate (uint32_t size)
 {
   NS_LOG_FUNCTION (this << size);
-  while (!g_freeList.empty ())
-    {
-      struct ByteTagListData *data = g_freeList.back ();
-      g_freeList.pop_back ();
-      NS_ASSERT (data != 0);
-      if (data->size >= size)
-        {
-          data->count = 1;
-          data->dirty = 0;
-          return data;
-        }
-      uint8_t *buffer = (uint8_t *)data;
-      delete [] buffer;
-    }
-  uint8_t *buffer = new uint8_t [std::max (size, g_maxSize) + sizeof (struct ByteTagListData) - 4];
-  struct ByteTagListData *data = (struct ByteTagListData *)buffer;
+  std::size_t bytes = size + sizeof (struct ByteTagListData) - 4;
+  struct ByteTagListData *data = (struct ByteTagListData *)PacketPool::Allocate (bytes);
   data->count = 1;
-  data->size = size;
+  // use the whole block: the list grows without reallocation.
+  data->size = PacketPool::GetCapacity (bytes) - (sizeof (struct ByteTagListData) - 4);
   data->dirty = 0;
   return data;
 }
@@ -374,20 +335,10 @@ ByteTagList::Deallocate (struct ByteTagListData *data)
     {
       return;
     }
-  g_maxSize = std::max (g_maxSize, data->size);
   data->count--;
   if (data->count == 0)
     {
-      if (g_freeList.size () > FREE_LIST_SIZE ||
-          data->size < g_maxSize)
-        {
-          uint8_t *buffer = (uint8_t *)data;
-          delete [] buffer;
-        }
-      else
-        {
-          g_freeList.push_back (data);
-        }
+      PacketPool::Deallocate (data, data->size + sizeof (struct ByteTagListData) - 4);
     }
 }
 
@@ -0,0 +1,69 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "packet-pool.h"
+#include "ns3/block-pool.h"
+
+namespace ns3 {
+
+/** Number of size classes of the packet pool: blocks larger than 256 bytes are not pooled. */
+static const std::size_t PACKET_POOL_CLASSES = 16;
+
+/** The pool of the calling thread. */
+static __thread BlockPool::State g_packetPool;
+/** Releases the pool of the main thread at exit. */
+static BlockPool::Cleanup g_packetPoolCleanup (&g_packetPool);
+
+void *
+PacketPool::Allocate (std::size_t size)
+{
+  return BlockPool::Allocate (&g_packetPool, PACKET_POOL_CLASSES, size);
+}
+
+void
+PacketPool::Deallocate (void *p, std::size_t size)
+{
+  BlockPool::Deallocate (&g_packetPool, PACKET_POOL_CLASSES, p, size);
+}
+
+std::size_t
+PacketPool::GetCapacity (std::size_t size)
+{
+  return BlockPool::GetCapacity (PACKET_POOL_CLASSES, size);
+}
+
+struct PacketPool::Stats
+PacketPool::GetStats (void)
+{
+  struct BlockPool::State *pool = &g_packetPool;
+  struct Stats stats;
+  stats.allocations = pool->allocations;
+  stats.reuses = pool->reuses;
+  stats.deallocations = pool->deallocations;
+  stats.free = BlockPool::GetFree (pool);
+  return stats;
+}
+
+void
+PacketPool::ResetStats (void)
+{
+  struct BlockPool::State *pool = &g_packetPool;
+  pool->allocations = 0;
+  pool->reuses = 0;
+  pool->deallocations = 0;
+}
+
+} // namespace ns3
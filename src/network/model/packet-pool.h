@@ -0,0 +1,90 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef PACKET_POOL_H
+#define PACKET_POOL_H
+
+#include <stdint.h>
+#include <cstddef>
+
+namespace ns3 {
+
+/**
+ * \ingroup packet
+ *
+ * \brief The memory pool of the Packet objects and of their tag lists.
+ *
+ * Packet, PacketTagList::TagData and the ByteTagList data are allocated
+ * here rather than directly from the heap. The pool is a BlockPool with
+ * 16-byte size classes up to 256 bytes: the memory of a released object
+ * is reused by the next object of the same size class, so that the
+ * copies and header operations done on every forwarded packet do not
+ * go through malloc and free. Larger blocks are not pooled.
+ *
+ * The free lists and the statistics are per thread, so that packets
+ * created by the threads of the realtime simulator need no lock. A
+ * block released by another thread than the one which allocated it
+ * goes to the free list of the releasing thread. The free blocks of a
+ * thread go back to the heap when it exits, and those of the main
+ * thread at the end of the program.
+ */
+class PacketPool
+{
+public:
+  /** The statistics of the pool of the calling thread. */
+  struct Stats
+  {
+    uint64_t allocations;   //!< Number of blocks allocated.
+    uint64_t reuses;        //!< Number of blocks allocated from a free list.
+    uint64_t deallocations; //!< Number of blocks released.
+    uint64_t free;          //!< Number of blocks in the free lists.
+  };
+
+  /**
+   * Allocate a block.
+   *
+   * \param [in] size The size of the block.
+   * \returns The block, of GetCapacity (size) bytes.
+   */
+  static void * Allocate (std::size_t size);
+  /**
+   * Release a block.
+   *
+   * \param [in] p The block.
+   * \param [in] size The size given to Allocate, or the capacity
+   *             of the block.
+   */
+  static void Deallocate (void *p, std::size_t size);
+  /**
+   * \param [in] size The size of a block.
+   * \returns The number of bytes usable in a block allocated for size
+   *          bytes.
+   */
+  static std::size_t GetCapacity (std::size_t size);
+  /**
+   * \returns The statistics of the pool of the calling thread.
+   */
+  static struct Stats GetStats (void);
+  /**
+   * Reset the counters of the pool of the calling thread. The free
+   * blocks are kept.
+   */
+  static void ResetStats (void);
+};
+
+} // namespace ns3
+
+#endif /* PACKET_POOL_H */
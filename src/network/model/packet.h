@@ -29,6 +29,7 @@
 #include "byte-tag-list.h"
 #include "packet-tag-list.h"
 #include "nix-vector.h"
+#include "packet-pool.h"
 #include "ns3/mac48-address.h"
 #include "ns3/callback.h"
 #include "ns3/assert.h"
@@ -244,6 +245,24 @@ public:
    * \return the copied object
    */
   Packet &operator = (const Packet &o);
+  /**
+   * \brief Allocate a packet from the PacketPool.
+   * \param size the size of the packet object
+   * \return the memory of the packet
+   */
+  static void * operator new (std::size_t size)
+  {
+    return PacketPool::Allocate (size);
+  }
+  /**
+   * \brief Return the memory of a packet to the PacketPool.
+   * \param p the memory of the packet
+   * \param size the size of the packet object
+   */
+  static void operator delete (void *p, std::size_t size)
+  {
+    PacketPool::Deallocate (p, size);
+  }
   /**
    * \brief Create a packet with a zero-filled payload.
    *
@@ -22,6 +22,8 @@
 #include "ns3/random-variable-stream.h"
 #include "ns3/double.h"
 #include "ns3/test.h"
+#include <vector>
+#include <cstring>
 
 using namespace ns3;
 
@@ -361,6 +363,159 @@ BufferTest::DoRun (void)
   NS_TEST_ASSERT_MSG_EQ (val1, val2, "Bad ReadNtohU16()");
 }
 //-----------------------------------------------------------------------------
+class BufferHeadSegmentTest : public TestCase {
+private:
+  void CheckBytes (Buffer b, const std::vector<uint8_t> &expected, std::string msg);
+  void Prepend (Buffer &b, std::vector<uint8_t> &expected, uint32_t n, uint8_t value);
+public:
+  virtual void DoRun (void);
+  BufferHeadSegmentTest ();
+};
+
+BufferHeadSegmentTest::BufferHeadSegmentTest ()
+  : TestCase ("Buffer head segment") {
+}
+
+void
+BufferHeadSegmentTest::CheckBytes (Buffer b, const std::vector<uint8_t> &expected, std::string msg)
+{
+  NS_TEST_ASSERT_MSG_EQ (b.GetSize (), expected.size (), msg << ": size");
+  std::vector<uint8_t> got (b.GetSize ());
+  b.CopyData (&got[0], got.size ());
+  NS_TEST_EXPECT_MSG_EQ ((got == expected), true, msg << ": CopyData");
+  bool ok = true;
+  Buffer::Iterator i = b.Begin ();
+  for (uint32_t j = 0; j < expected.size (); j++)
+    {
+      ok = ok && i.ReadU8 () == expected[j];
+    }
+  NS_TEST_EXPECT_MSG_EQ (ok, true, msg << ": Iterator::ReadU8");
+  ok = true;
+  i = b.Begin ();
+  for (uint32_t j = 0; j + 4 <= expected.size (); j += 4)
+    {
+      uint32_t v = (expected[j] << 24) | (expected[j + 1] << 16) | (expected[j + 2] << 8) | expected[j + 3];
+      ok = ok && i.ReadNtohU32 () == v;
+    }
+  NS_TEST_EXPECT_MSG_EQ (ok, true, msg << ": Iterator::ReadNtohU32");
+  NS_TEST_EXPECT_MSG_EQ (std::memcmp (b.PeekData (), &expected[0], expected.size ()), 0, msg << ": PeekData");
+}
+
+void
+BufferHeadSegmentTest::Prepend (Buffer &b, std::vector<uint8_t> &expected, uint32_t n, uint8_t value)
+{
+  b.AddAtStart (n);
+  Buffer::Iterator i = b.Begin ();
+  // mix the write methods, to cross the segment boundaries
+  for (uint32_t j = 0; j < n; )
+    {
+      if (j + 4 <= n && j % 3 == 0)
+        {
+          i.WriteHtonU32 ((value << 24) | (value << 16) | (value << 8) | value);
+          j += 4;
+        }
+      else if (j + 2 <= n && j % 3 == 1)
+        {
+          i.WriteHtonU16 ((value << 8) | value);
+          j += 2;
+        }
+      else
+        {
+          i.WriteU8 (value);
+          j++;
+        }
+    }
+  expected.insert (expected.begin (), n, value);
+}
+
+void
+BufferHeadSegmentTest::DoRun (void)
+{
+  std::vector<uint8_t> payloadBytes (1001);
+  for (uint32_t j = 0; j < payloadBytes.size (); j++)
+    {
+      payloadBytes[j] = j * 7;
+    }
+  Buffer payload;
+  payload.AddAtStart (payloadBytes.size ());
+  payload.Begin ().Write (&payloadBytes[0], payloadBytes.size ());
+  CheckBytes (payload, payloadBytes, "payload");
+
+  // a frame received, sharing the payload
+  Buffer frame = payload;
+  std::vector<uint8_t> frameBytes = payloadBytes;
+  Prepend (frame, frameBytes, 14, 0xee);
+
+  // the packet, with the frame header removed, is encapsulated
+  Buffer packet = frame;
+  std::vector<uint8_t> packetBytes = payloadBytes;
+  packet.RemoveAtStart (14);
+  Prepend (packet, packetBytes, 40, 0xa1);
+  CheckBytes (packet, packetBytes, "encapsulated");
+  Prepend (packet, packetBytes, 41, 0xa2);
+  CheckBytes (packet, packetBytes, "encapsulated twice");
+  CheckBytes (frame, frameBytes, "frame after encapsulation");
+
+  // copy on write of the head segment
+  Buffer other = packet;
+  std::vector<uint8_t> otherBytes = packetBytes;
+  Prepend (other, otherBytes, 8, 0xb1);
+  Prepend (packet, packetBytes, 8, 0xa3);
+  Prepend (packet, packetBytes, 100, 0xa4);
+  CheckBytes (other, otherBytes, "copy");
+  CheckBytes (packet, packetBytes, "original");
+  CheckBytes (frame, frameBytes, "frame after copies");
+
+  // removal from the start, within and past the head segment
+  Buffer b = packet;
+  std::vector<uint8_t> bBytes = packetBytes;
+  b.RemoveAtStart (30);
+  bBytes.erase (bBytes.begin (), bBytes.begin () + 30);
+  CheckBytes (b, bBytes, "remove in head");
+  b.RemoveAtStart (170);
+  bBytes.erase (bBytes.begin (), bBytes.begin () + 170);
+  CheckBytes (b, bBytes, "remove past head");
+
+  // removal from the end, into the head segment
+  b = packet;
+  bBytes = packetBytes;
+  b.RemoveAtEnd (1050);
+  bBytes.resize (bBytes.size () - 1050);
+  CheckBytes (b, bBytes, "remove end");
+
+  // fragments
+  b = packet.CreateFragment (100, 200);
+  bBytes.assign (packetBytes.begin () + 100, packetBytes.begin () + 300);
+  CheckBytes (b, bBytes, "fragment");
+
+  // concatenation
+  b = Buffer ();
+  bBytes.clear ();
+  Prepend (b, bBytes, 5, 0xc1);
+  b.AddAtEnd (packet);
+  bBytes.insert (bBytes.end (), packetBytes.begin (), packetBytes.end ());
+  CheckBytes (b, bBytes, "concatenation");
+  b = packet;
+  b.AddAtEnd (other);
+  bBytes = packetBytes;
+  bBytes.insert (bBytes.end (), otherBytes.begin (), otherBytes.end ());
+  CheckBytes (b, bBytes, "concatenation of segmented buffers");
+
+  // copy between iterators
+  b = Buffer ();
+  b.AddAtStart (packet.GetSize ());
+  b.Begin ().Write (packet.Begin (), packet.End ());
+  CheckBytes (b, packetBytes, "iterator copy");
+
+  // serialization
+  std::vector<uint8_t> serialized (packet.GetSerializedSize ());
+  NS_TEST_EXPECT_MSG_EQ (packet.Serialize (&serialized[0], serialized.size ()), 1, "serialize");
+  Buffer deserialized (0, false);
+  // as in Packet::Deserialize, the size includes the 4 bytes of the size field
+  deserialized.Deserialize (&serialized[0], serialized.size () + 4);
+  CheckBytes (deserialized, packetBytes, "deserialized");
+}
+//-----------------------------------------------------------------------------
 class BufferTestSuite : public TestSuite
 {
 public:
@@ -371,6 +526,7 @@ BufferTestSuite::BufferTestSuite ()
   : TestSuite ("buffer", UNIT)
 {
   AddTestCase (new BufferTest, TestCase::QUICK);
+  AddTestCase (new BufferHeadSegmentTest, TestCase::QUICK);
 }
 
 static BufferTestSuite g_bufferTestSuite;
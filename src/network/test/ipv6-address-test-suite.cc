@@ -91,6 +91,85 @@ Ipv6AddressTestCase1::DoRun (void)
 
 }
 
+class Ipv6AddressTestCase2 : public TestCase
+{
+public:
+  Ipv6AddressTestCase2 ();
+  virtual ~Ipv6AddressTestCase2 ();
+
+private:
+  virtual void DoRun (void);
+};
+
+Ipv6AddressTestCase2::Ipv6AddressTestCase2 ()
+  : TestCase ("comparison, hash and prefix code")
+{
+}
+
+Ipv6AddressTestCase2::~Ipv6AddressTestCase2 ()
+{
+}
+
+void
+Ipv6AddressTestCase2::DoRun (void)
+{
+  // the order is the one of the bytes, most significant first
+  NS_TEST_ASSERT_MSG_EQ ((Ipv6Address ("2001:db8::1") < Ipv6Address ("2001:db8::2")), true, "Failed comparison");
+  NS_TEST_ASSERT_MSG_EQ ((Ipv6Address ("2001:db8::ff") < Ipv6Address ("2001:db8::100")), true, "Failed comparison");
+  NS_TEST_ASSERT_MSG_EQ ((Ipv6Address ("2001:db8::ffff") < Ipv6Address ("2001:db9::")), true, "Failed comparison");
+  NS_TEST_ASSERT_MSG_EQ ((Ipv6Address ("2001:db9::") < Ipv6Address ("2001:db8::ffff")), false, "Failed comparison");
+  NS_TEST_ASSERT_MSG_EQ ((Ipv6Address ("::1") < Ipv6Address ("::1")), false, "Failed comparison");
+  NS_TEST_ASSERT_MSG_EQ ((Ipv6Address ("fe80::1") == Ipv6Address ("fe80::1")), true, "Failed comparison");
+  NS_TEST_ASSERT_MSG_EQ ((Ipv6Address ("fe80::1") != Ipv6Address ("fe81::1")), true, "Failed comparison");
+
+  Ipv6AddressHash hash;
+  NS_TEST_ASSERT_MSG_EQ (hash (Ipv6Address ("2001:db8::1")), hash (Ipv6Address ("2001:db8::1")), "Failed hash");
+  NS_TEST_ASSERT_MSG_NE (hash (Ipv6Address ("2001:db8::1")), hash (Ipv6Address ("2001:db8::2")), "Failed hash");
+  NS_TEST_ASSERT_MSG_NE (hash (Ipv6Address ("2001:db8::1")), hash (Ipv6Address ("2001:db8:0:1::1")), "Failed hash");
+
+  // well-known addresses
+  NS_TEST_ASSERT_MSG_EQ (Ipv6Address::GetLoopback (), Ipv6Address ("::1"), "Failed well-known address");
+  NS_TEST_ASSERT_MSG_EQ (Ipv6Address::GetAny (), Ipv6Address ("::"), "Failed well-known address");
+  NS_TEST_ASSERT_MSG_EQ (Ipv6Address::GetAllNodesMulticast (), Ipv6Address ("ff02::1"), "Failed well-known address");
+  NS_TEST_ASSERT_MSG_EQ (Ipv6Address::GetAllRoutersMulticast (), Ipv6Address ("ff02::2"), "Failed well-known address");
+  NS_TEST_ASSERT_MSG_EQ (Ipv6Address::GetAllHostsMulticast (), Ipv6Address ("ff02::3"), "Failed well-known address");
+  NS_TEST_ASSERT_MSG_EQ (Ipv6Address::GetOnes (), Ipv6Address ("ffff:ffff:ffff:ffff:ffff:ffff:ffff:ffff"), "Failed well-known address");
+  NS_TEST_ASSERT_MSG_EQ (Ipv6Address ("::1").IsLocalhost (), true, "Failed address type");
+  NS_TEST_ASSERT_MSG_EQ (Ipv6Address ("::").IsAny (), true, "Failed address type");
+  NS_TEST_ASSERT_MSG_EQ (Ipv6Address ("::1").IsAny (), false, "Failed address type");
+  NS_TEST_ASSERT_MSG_EQ (Ipv6Address ("fe80::1").IsLinkLocal (), true, "Failed address type");
+  NS_TEST_ASSERT_MSG_EQ (Ipv6Address ("fe80:0:0:1::1").IsLinkLocal (), false, "Failed address type");
+  NS_TEST_ASSERT_MSG_EQ (Ipv6Address ("2001:db8:1::1").IsDocumentation (), true, "Failed address type");
+  NS_TEST_ASSERT_MSG_EQ (Ipv6Address ("2001:db9::1").IsDocumentation (), false, "Failed address type");
+  NS_TEST_ASSERT_MSG_EQ (Ipv6Address::MakeIpv4MappedAddress (Ipv4Address ("10.0.0.1")).IsIpv4MappedAddress (), true, "Failed address type");
+  NS_TEST_ASSERT_MSG_EQ (Ipv6Address ("::fffe:a00:1").IsIpv4MappedAddress (), false, "Failed address type");
+  NS_TEST_ASSERT_MSG_EQ (Ipv6Address ("ff02::1").IsAllNodesMulticast (), true, "Failed address type");
+  NS_TEST_ASSERT_MSG_EQ (Ipv6Address ("ff05::2").IsAllRoutersMulticast (), true, "Failed address type");
+
+  // prefixes
+  uint8_t bytes[16];
+  Ipv6Prefix (65).GetBytes (bytes);
+  NS_TEST_ASSERT_MSG_EQ (bytes[7], 0xff, "Failed prefix");
+  NS_TEST_ASSERT_MSG_EQ (bytes[8], 0x80, "Failed prefix");
+  NS_TEST_ASSERT_MSG_EQ (bytes[9], 0, "Failed prefix");
+  NS_TEST_ASSERT_MSG_EQ (Ipv6Prefix ((uint8_t)0).GetPrefixLength (), 0, "Failed prefix");
+  NS_TEST_ASSERT_MSG_EQ (Ipv6Prefix (13).GetPrefixLength (), 13, "Failed prefix");
+  NS_TEST_ASSERT_MSG_EQ (Ipv6Prefix (64).GetPrefixLength (), 64, "Failed prefix");
+  NS_TEST_ASSERT_MSG_EQ (Ipv6Prefix (127).GetPrefixLength (), 127, "Failed prefix");
+  NS_TEST_ASSERT_MSG_EQ (Ipv6Prefix (128).GetPrefixLength (), 128, "Failed prefix");
+  NS_TEST_ASSERT_MSG_EQ (Ipv6Prefix (64), Ipv6Prefix ("ffff:ffff:ffff:ffff::"), "Failed prefix");
+
+  Ipv6Address ha ("2001:db8:1:2::1");
+  NS_TEST_ASSERT_MSG_EQ (ha.CombinePrefix (Ipv6Prefix (64)), Ipv6Address ("2001:db8:1:2::"), "Failed prefix combination");
+  NS_TEST_ASSERT_MSG_EQ (ha.CombinePrefix (Ipv6Prefix (36)), Ipv6Address ("2001:db8::"), "Failed prefix combination");
+  NS_TEST_ASSERT_MSG_EQ (ha.CombineInterfaceId (Ipv6Address ("fe80::200:ff:fe00:7"), Ipv6Prefix (64)),
+                         Ipv6Address ("2001:db8:1:2:200:ff:fe00:7"), "Failed interface identifier combination");
+  NS_TEST_ASSERT_MSG_EQ (Ipv6Prefix (64).IsMatch (ha, Ipv6Address ("2001:db8:1:2::99")), true, "Failed prefix match");
+  NS_TEST_ASSERT_MSG_EQ (Ipv6Prefix (64).IsMatch (ha, Ipv6Address ("2001:db8:1:3::1")), false, "Failed prefix match");
+  NS_TEST_ASSERT_MSG_EQ (Ipv6Prefix (127).IsMatch (ha, Ipv6Address ("2001:db8:1:2::0")), true, "Failed prefix match");
+  NS_TEST_ASSERT_MSG_EQ (Ipv6Prefix (128).IsMatch (ha, Ipv6Address ("2001:db8:1:2::0")), false, "Failed prefix match");
+}
+
 class Ipv6AddressTestSuite : public TestSuite
 {
 public:
@@ -101,6 +180,7 @@ Ipv6AddressTestSuite::Ipv6AddressTestSuite ()
   : TestSuite ("ipv6-address", UNIT)
 {
   AddTestCase (new Ipv6AddressTestCase1, TestCase::QUICK);
+  AddTestCase (new Ipv6AddressTestCase2, TestCase::QUICK);
 }
 
 static Ipv6AddressTestSuite ipv6AddressTestSuite;
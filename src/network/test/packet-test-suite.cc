@@ -19,6 +19,7 @@
  */
 #include "ns3/packet.h"
 #include "ns3/packet-tag-list.h"
+#include "ns3/packet-pool.h"
 #include "ns3/test.h"
 #include "ns3/unused.h"
 #include <limits>     // std:numeric_limits
@@ -847,6 +848,52 @@ PacketTagListTest::DoRun (void)
     
 }
 
+//--------------------------------------
+class PacketPoolTest : public TestCase
+{
+public:
+  PacketPoolTest ();
+private:
+  void DoRun (void);
+};
+
+PacketPoolTest::PacketPoolTest ()
+  : TestCase ("Check the reuse of the memory of packets and tags")
+{
+}
+
+void
+PacketPoolTest::DoRun (void)
+{
+  NS_TEST_EXPECT_MSG_EQ (PacketPool::GetCapacity (1), 16, "smallest size class");
+  NS_TEST_EXPECT_MSG_EQ (PacketPool::GetCapacity (17), 32, "rounded to the size class");
+  NS_TEST_EXPECT_MSG_EQ (PacketPool::GetCapacity (1000), 1000, "large blocks are not pooled");
+
+  Ptr<Packet> p = Create<Packet> (100);
+  p->AddPacketTag (ATestTag<1> ());
+  p->AddByteTag (ATestTag<2> ());
+  p = 0;
+
+  PacketPool::ResetStats ();
+  struct PacketPool::Stats stats = PacketPool::GetStats ();
+  uint64_t free = stats.free;
+  p = Create<Packet> (100);
+  p->AddPacketTag (ATestTag<1> ());
+  p->AddByteTag (ATestTag<2> ());
+  stats = PacketPool::GetStats ();
+  NS_TEST_EXPECT_MSG_EQ (stats.allocations, 3, "packet, packet tag and byte tags allocated");
+  NS_TEST_EXPECT_MSG_EQ (stats.reuses, 3, "packet, packet tag and byte tags reused");
+  NS_TEST_EXPECT_MSG_EQ (stats.free, free - 3, "the blocks were taken from the free lists");
+
+  Ptr<Packet> copy = p->Copy ();
+  copy->AddPacketTag (ATestTag<3> ());
+  p = 0;
+  copy = 0;
+  stats = PacketPool::GetStats ();
+  NS_TEST_EXPECT_MSG_EQ (stats.deallocations, stats.allocations, "all the blocks released");
+  NS_TEST_EXPECT_MSG_EQ (stats.free, free - stats.reuses + stats.deallocations, "the blocks went back to the free lists");
+}
+
 //-----------------------------------------------------------------------------
 class PacketTestSuite : public TestSuite
 {
@@ -859,6 +906,7 @@ PacketTestSuite::PacketTestSuite ()
 {
   AddTestCase (new PacketTest, TestCase::QUICK);
   AddTestCase (new PacketTagListTest, TestCase::QUICK);
+  AddTestCase (new PacketPoolTest, TestCase::QUICK);
 }
 
 static PacketTestSuite g_packetTestSuite;
@@ -42,6 +42,7 @@
 
 
 #include <iomanip>
+#include <algorithm>
 #include <memory.h>
 
 #include "ns3/log.h"
@@ -56,86 +57,6 @@ namespace ns3 {
 
 NS_LOG_COMPONENT_DEFINE ("Ipv6Address");
 
-#ifdef __cplusplus
-extern "C"
-{ /* } */
-#endif
-
-/**
- * \brief Get a hash key.
- * \param k the key
- * \param length the length of the key
- * \param level the previous hash, or an arbitrary value
- * \return hash
- * \note Adapted from Jens Jakobsen implementation (chillispot).
- */
-static uint32_t lookuphash (unsigned char* k, uint32_t length, uint32_t level)
-{
-  NS_LOG_FUNCTION (k << length << level);
-#define mix(a, b, c) \
-  ({ \
-     (a) -= (b); (a) -= (c); (a) ^= ((c) >> 13); \
-     (b) -= (c); (b) -= (a); (b) ^= ((a) << 8);  \
-     (c) -= (a); (c) -= (b); (c) ^= ((b) >> 13); \
-     (a) -= (b); (a) -= (c); (a) ^= ((c) >> 12); \
-     (b) -= (c); (b) -= (a); (b) ^= ((a) << 16); \
-     (c) -= (a); (c) -= (b); (c) ^= ((b) >> 5);  \
-     (a) -= (b); (a) -= (c); (a) ^= ((c) >> 3);  \
-     (b) -= (c); (b) -= (a); (b) ^= ((a) << 10); \
-     (c) -= (a); (c) -= (b); (c) ^= ((b) >> 15); \
-   })
-
-  typedef uint32_t  ub4;   /* unsigned 4-byte quantities */
-  uint32_t a = 0;
-  uint32_t b = 0;
-  uint32_t c = 0;
-  uint32_t len = 0;
-
-  /* Set up the internal state */
-  len = length;
-  a = b = 0x9e3779b9;  /* the golden ratio; an arbitrary value */
-  c = level;           /* the previous hash value */
-
-  /* handle most of the key */
-  while (len >= 12)
-    {
-      a += (k[0] + ((ub4)k[1] << 8) + ((ub4)k[2] << 16) + ((ub4)k[3] << 24));
-      b += (k[4] + ((ub4)k[5] << 8) + ((ub4)k[6] << 16) + ((ub4)k[7] << 24));
-      c += (k[8] + ((ub4)k[9] << 8) + ((ub4)k[10] << 16) + ((ub4)k[11] << 24));
-      mix (a, b, c);
-      k += 12; 
-      len -= 12;
-    }
-
-  /* handle the last 11 bytes */
-  c += length;
-  switch (len) /* all the case statements fall through */
-    {
-    case 11: c += ((ub4)k[10] << 24);
-    case 10: c += ((ub4)k[9] << 16);
-    case 9: c += ((ub4)k[8] << 8);  /* the first byte of c is reserved for the length */
-    case 8: b += ((ub4)k[7] << 24);
-    case 7: b += ((ub4)k[6] << 16);
-    case 6: b += ((ub4)k[5] << 8);
-    case 5: b += k[4];
-    case 4: a += ((ub4)k[3] << 24);
-    case 3: a += ((ub4)k[2] << 16);
-    case 2: a += ((ub4)k[1] << 8);
-    case 1: a += k[0];
-      /* case 0: nothing left to add */
-    }
-  mix (a, b, c);
-
-#undef mix
-
-  /* report the result */
-  return c;
-}
-
-#ifdef __cplusplus
-}
-#endif
-
 /**
  * \brief Convert an IPv6 C-string into a 128-bit representation.
  *
@@ -278,18 +199,6 @@ static bool AsciiToIpv6Host (const char *address, uint8_t addr[16])
   return (1);
 }
 
-Ipv6Address::Ipv6Address ()
-{
-  NS_LOG_FUNCTION (this);
-  memset (m_address, 0x00, 16);
-}
-
-Ipv6Address::Ipv6Address (Ipv6Address const& addr)
-{
-  // Do not add function logging here, to avoid stack overflow
-  memcpy (m_address, addr.m_address, 16);
-}
-
 Ipv6Address::Ipv6Address (Ipv6Address const* addr)
 {
   // Do not add function logging here, to avoid stack overflow
@@ -309,12 +218,6 @@ Ipv6Address::Ipv6Address (uint8_t address[16])
   memcpy (m_address, address, 16);
 }
 
-Ipv6Address::~Ipv6Address ()
-{
-  /* do nothing */
-  NS_LOG_FUNCTION (this);
-}
-
 void Ipv6Address::Set (char const* address)
 {
   NS_LOG_FUNCTION (this << address);
@@ -595,8 +498,7 @@ void Ipv6Address::Print (std::ostream& os) const
 bool Ipv6Address::IsLocalhost () const
 {
   NS_LOG_FUNCTION (this);
-  static Ipv6Address localhost ("::1");
-  return (*this == localhost);
+  return (*this == GetLoopback ());
 }
 
 bool Ipv6Address::IsMulticast () const
@@ -622,32 +524,29 @@ bool Ipv6Address::IsLinkLocalMulticast () const
 bool Ipv6Address::IsIpv4MappedAddress () const
 {
   NS_LOG_FUNCTION (this);
-  uint8_t v4MappedPrefix[12] = { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-                                 0x00, 0x00, 0xff, 0xff };
-  if (memcmp(m_address, v4MappedPrefix, sizeof(v4MappedPrefix)) == 0)
+  // ::ffff:0:0/96
+  if (m_words[0] == 0 && (SwapWord (m_words[1]) >> 32) == 0xffff)
     {
       return (true);
     }
   return (false);
 }
 
-Ipv6Address Ipv6Address::CombinePrefix (Ipv6Prefix const& prefix)
+Ipv6Address Ipv6Address::CombinePrefix (Ipv6Prefix const& prefix) const
 {
   NS_LOG_FUNCTION (this << prefix);
   Ipv6Address ipv6;
-  uint8_t addr[16];
-  uint8_t pref[16];
-  unsigned int i = 0;
-
-  memcpy (addr, m_address, 16);
-  ((Ipv6Prefix)prefix).GetBytes (pref);
+  ipv6.m_words[0] = m_words[0] & prefix.m_words[0];
+  ipv6.m_words[1] = m_words[1] & prefix.m_words[1];
+  return ipv6;
+}
 
-  /* a little bit ugly... */
-  for (i = 0; i < 16; i++)
-    {
-      addr[i] = addr[i] & pref[i];
-    }
-  ipv6.Set (addr);
+Ipv6Address Ipv6Address::CombineInterfaceId (Ipv6Address const& interfaceId, Ipv6Prefix const& prefix) const
+{
+  NS_LOG_FUNCTION (this << interfaceId << prefix);
+  Ipv6Address ipv6;
+  ipv6.m_words[0] = (m_words[0] & prefix.m_words[0]) | (interfaceId.m_words[0] & ~prefix.m_words[0]);
+  ipv6.m_words[1] = (m_words[1] & prefix.m_words[1]) | (interfaceId.m_words[1] & ~prefix.m_words[1]);
   return ipv6;
 }
 
@@ -671,42 +570,40 @@ bool Ipv6Address::IsSolicitedMulticast () const
 bool Ipv6Address::IsAllNodesMulticast () const
 {
   NS_LOG_FUNCTION (this);
-  static Ipv6Address allNodesI ("ff01::1");
-  static Ipv6Address allNodesL ("ff02::1");
-  static Ipv6Address allNodesR ("ff03::1");
+  static const Ipv6Address allNodesI (0xff01000000000000ULL, 1);
+  static const Ipv6Address allNodesL (0xff02000000000000ULL, 1);
+  static const Ipv6Address allNodesR (0xff03000000000000ULL, 1);
   return (*this == allNodesI || *this == allNodesL || *this == allNodesR);
 }
 
 bool Ipv6Address::IsAllRoutersMulticast () const
 {
   NS_LOG_FUNCTION (this);
-  static Ipv6Address allroutersI ("ff01::2");
-  static Ipv6Address allroutersL ("ff02::2");
-  static Ipv6Address allroutersR ("ff03::2");
-  static Ipv6Address allroutersS ("ff05::2");
+  static const Ipv6Address allroutersI (0xff01000000000000ULL, 2);
+  static const Ipv6Address allroutersL (0xff02000000000000ULL, 2);
+  static const Ipv6Address allroutersR (0xff03000000000000ULL, 2);
+  static const Ipv6Address allroutersS (0xff05000000000000ULL, 2);
   return (*this == allroutersI || *this == allroutersL || *this == allroutersR || *this == allroutersS);
 }
 
 bool Ipv6Address::IsAllHostsMulticast () const
 {
   NS_LOG_FUNCTION (this);
-  static Ipv6Address allhosts ("ff02::3");
-  return (*this == allhosts);
+  return (*this == GetAllHostsMulticast ());
 }
 
 bool Ipv6Address::IsAny () const
 {
   NS_LOG_FUNCTION (this);
-  static Ipv6Address any ("::");
-  return (*this == any);
+  return (m_words[0] | m_words[1]) == 0;
 }
 
 
 bool Ipv6Address::IsDocumentation () const
 {
   NS_LOG_FUNCTION (this);
-  Ipv6Address documentation ("2001:db8::0");
-  if (((Ipv6Address*)this)->CombinePrefix (Ipv6Prefix (32)) == documentation)
+  // 2001:db8::/32
+  if ((SwapWord (m_words[0]) >> 32) == 0x20010db8)
     {
       return true;
     }
@@ -752,49 +649,49 @@ uint8_t Ipv6Address::GetType (void)
 Ipv6Address Ipv6Address::GetAllNodesMulticast ()
 {
   NS_LOG_FUNCTION_NOARGS ();
-  static Ipv6Address nmc ("ff02::1");
+  static const Ipv6Address nmc (0xff02000000000000ULL, 1);
   return nmc;
 }
 
 Ipv6Address Ipv6Address::GetAllRoutersMulticast ()
 {
   NS_LOG_FUNCTION_NOARGS ();
-  static Ipv6Address rmc ("ff02::2");
+  static const Ipv6Address rmc (0xff02000000000000ULL, 2);
   return rmc;
 }
 
 Ipv6Address Ipv6Address::GetAllHostsMulticast ()
 {
   NS_LOG_FUNCTION_NOARGS ();
-  static Ipv6Address hmc ("ff02::3");
+  static const Ipv6Address hmc (0xff02000000000000ULL, 3);
   return hmc;
 }
 
 Ipv6Address Ipv6Address::GetLoopback ()
 {
   NS_LOG_FUNCTION_NOARGS ();
-  static Ipv6Address loopback ("::1");
+  static const Ipv6Address loopback (0, 1);
   return loopback;
 }
 
 Ipv6Address Ipv6Address::GetZero ()
 {
   NS_LOG_FUNCTION_NOARGS ();
-  static Ipv6Address zero ("::");
+  static const Ipv6Address zero (0, 0);
   return zero;
 }
 
 Ipv6Address Ipv6Address::GetAny ()
 {
   NS_LOG_FUNCTION_NOARGS ();
-  static Ipv6Address any ("::");
+  static const Ipv6Address any (0, 0);
   return any;
 }
 
 Ipv6Address Ipv6Address::GetOnes ()
 {
   NS_LOG_FUNCTION_NOARGS ();
-  static Ipv6Address ones ("ffff:ffff:ffff:ffff:ffff:ffff:ffff:ffff");
+  static const Ipv6Address ones (~0ULL, ~0ULL);
   return ones; 
 }
 
@@ -807,8 +704,8 @@ void Ipv6Address::GetBytes (uint8_t buf[16]) const
 bool Ipv6Address::IsLinkLocal () const
 {
   NS_LOG_FUNCTION (this);
-  Ipv6Address linkLocal ("fe80::0");
-  if (!IsMulticast () && ((Ipv6Address*)this)->CombinePrefix (Ipv6Prefix (64)) == linkLocal)
+  // fe80::/64
+  if (SwapWord (m_words[0]) == 0xfe80000000000000ULL)
     {
       return true;
     }
@@ -818,11 +715,7 @@ bool Ipv6Address::IsLinkLocal () const
 bool Ipv6Address::IsEqual (const Ipv6Address& other) const
 {
   NS_LOG_FUNCTION (this << other);
-  if (!memcmp (m_address, other.m_address, 16))
-    {
-      return true;
-    }
-  return false;
+  return *this == other;
 }
 
 std::ostream& operator << (std::ostream& os, Ipv6Address const& address)
@@ -839,6 +732,20 @@ std::istream& operator >> (std::istream& is, Ipv6Address& address)
   return is;
 }
 
+/**
+ * \brief Get a word of a prefix mask.
+ * \param bits the number of high-order bits set (0 - 64)
+ * \return the mask, in host order
+ */
+static uint64_t MakeMaskWord (unsigned int bits)
+{
+  if (bits == 0)
+    {
+      return 0;
+    }
+  return ~static_cast<uint64_t> (0) << (64 - bits);
+}
+
 Ipv6Prefix::Ipv6Prefix ()
 {
   NS_LOG_FUNCTION (this);
@@ -860,36 +767,10 @@ Ipv6Prefix::Ipv6Prefix (uint8_t prefix[16])
 Ipv6Prefix::Ipv6Prefix (uint8_t prefix)
 {
   NS_LOG_FUNCTION (this << static_cast<uint32_t> (prefix));
-  unsigned int nb=0;
-  unsigned int mod=0;
-  unsigned int i=0;
-
-  memset (m_prefix, 0x00, 16);
-
   NS_ASSERT (prefix <= 128);
 
-  nb = prefix / 8;
-  mod = prefix % 8;
-
-  // protect memset with 'nb > 0' check to suppress
-  // __warn_memset_zero_len compiler errors in some gcc>4.5.x 
-  if (nb > 0)
-    {
-      memset (m_prefix, 0xff, nb);
-    }
-  if (mod)
-    {
-      m_prefix[nb] = 0xff << (8-mod);
-    }
-
-  if (nb < 16)
-    {
-      nb++;
-      for (i = nb; i < 16; i++)
-        {
-          m_prefix[i] = 0x00;
-        }
-    }
+  m_words[0] = Ipv6Address::SwapWord (MakeMaskWord (std::min<unsigned int> (prefix, 64)));
+  m_words[1] = Ipv6Address::SwapWord (MakeMaskWord (prefix > 64 ? prefix - 64 : 0));
 }
 
 Ipv6Prefix::Ipv6Prefix (Ipv6Prefix const& prefix)
@@ -911,22 +792,8 @@ Ipv6Prefix::~Ipv6Prefix ()
 bool Ipv6Prefix::IsMatch (Ipv6Address a, Ipv6Address b) const
 {
   NS_LOG_FUNCTION (this << a << b);
-  uint8_t addrA[16];
-  uint8_t addrB[16];
-  unsigned int i = 0;
-
-  a.GetBytes (addrA);
-  b.GetBytes (addrB);
-
-  /* a little bit ugly... */
-  for (i = 0; i < 16; i++)
-    {
-      if ((addrA[i] & m_prefix[i]) != (addrB[i] & m_prefix[i]))
-        {
-          return false;
-        }
-    }
-  return true;
+  return (((a.m_words[0] ^ b.m_words[0]) & m_words[0])
+          | ((a.m_words[1] ^ b.m_words[1]) & m_words[1])) == 0;
 }
 
 void Ipv6Prefix::Print (std::ostream &os) const
@@ -985,11 +852,7 @@ uint8_t Ipv6Prefix::GetPrefixLength () const
 
 bool Ipv6Prefix::IsEqual (const Ipv6Prefix& other) const
 {
-  if (!memcmp (m_prefix, other.m_prefix, 16))
-    {
-      return true;
-    }
-  return false;
+  return *this == other;
 }
 
 std::ostream& operator << (std::ostream& os, Ipv6Prefix const& prefix)
@@ -1006,15 +869,6 @@ std::istream& operator >> (std::istream& is, Ipv6Prefix& prefix)
   return is;
 }
 
-size_t Ipv6AddressHash::operator () (Ipv6Address const &x) const
-{
-  uint8_t buf[16];
-
-  x.GetBytes (buf);
-
-  return lookuphash (buf, sizeof (buf), 0);
-}
-
 ATTRIBUTE_HELPER_CPP (Ipv6Address);
 ATTRIBUTE_HELPER_CPP (Ipv6Prefix);
 
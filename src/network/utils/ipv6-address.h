@@ -261,7 +261,19 @@ public:
    * \return an IPv6 address that is this address combined
    * (bitwise AND) with a prefix, yielding an IPv6 network address.
    */
-  Ipv6Address CombinePrefix (Ipv6Prefix const & prefix);
+  Ipv6Address CombinePrefix (Ipv6Prefix const & prefix) const;
+
+  /**
+   * \brief Combine the prefix of this address with an interface identifier.
+   *
+   * This forms e.g. a home address from the address of the home agent
+   * and the interface identifier of a node.
+   * \param interfaceId an address holding the interface identifier
+   * \param prefix the IPv6 prefix
+   * \return an IPv6 address made of the bits of this address covered by
+   * the prefix and of the other bits of interfaceId.
+   */
+  Ipv6Address CombineInterfaceId (Ipv6Address const & interfaceId, Ipv6Prefix const & prefix) const;
 
   /**
    * \brief If the Address matches the type.
@@ -338,6 +350,22 @@ public:
   void GetBytes (uint8_t buf[16]) const;
 
 private:
+  /**
+   * \brief Constructs an Ipv6Address from two 64-bit words.
+   *
+   * Used for the well-known addresses, which are not parsed.
+   * \param high the 64 high-order bits, in host order
+   * \param low the 64 low-order bits, in host order
+   */
+  Ipv6Address (uint64_t high, uint64_t low);
+
+  /**
+   * \brief Convert a word of the address between network and host order.
+   * \param word the word
+   * \return the word in the other byte order
+   */
+  static uint64_t SwapWord (uint64_t word);
+
   /**
    * \brief convert the IPv6Address object to an Address object.
    * \return the Address object corresponding to this object.
@@ -351,9 +379,18 @@ private:
   static uint8_t GetType (void);
 
   /**
-   * \brief The address representation on 128 bits (16 bytes).
+   * \brief The address representation on 128 bits (16 bytes), in network
+   * order. Comparisons, hashes and prefix masks work on the two 64-bit
+   * words rather than on the bytes.
    */
-  uint8_t m_address[16];
+  union
+  {
+    uint8_t m_address[16];  //!< The bytes of the address.
+    uint64_t m_words[2];    //!< The address as two words, in network order.
+  };
+
+  friend class Ipv6Prefix;
+  friend class Ipv6AddressHash;
 
   /**
    * \brief Equal to operator.
@@ -489,9 +526,15 @@ public:
 
 private:
   /**
-   * \brief The prefix representation.
+   * \brief The prefix representation, in network order.
    */
-  uint8_t m_prefix[16];
+  union
+  {
+    uint8_t m_prefix[16];   //!< The bytes of the prefix.
+    uint64_t m_words[2];    //!< The prefix as two words, in network order.
+  };
+
+  friend class Ipv6Address;
 
   /**
    * \brief Equal to operator.
@@ -551,29 +594,65 @@ std::istream & operator >> (std::istream &is, Ipv6Address &address);
  */
 std::istream & operator >> (std::istream &is, Ipv6Prefix &prefix);
 
+inline Ipv6Address::Ipv6Address ()
+{
+  m_words[0] = 0;
+  m_words[1] = 0;
+}
+
+inline Ipv6Address::Ipv6Address (Ipv6Address const& addr)
+{
+  m_words[0] = addr.m_words[0];
+  m_words[1] = addr.m_words[1];
+}
+
+inline Ipv6Address::Ipv6Address (uint64_t high, uint64_t low)
+{
+  m_words[0] = SwapWord (high);
+  m_words[1] = SwapWord (low);
+}
+
+inline Ipv6Address::~Ipv6Address ()
+{
+}
+
+inline uint64_t Ipv6Address::SwapWord (uint64_t word)
+{
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+  return __builtin_bswap64 (word);
+#else
+  return word;
+#endif
+}
+
 inline bool operator == (const Ipv6Address& a, const Ipv6Address& b)
 {
-  return (!std::memcmp (a.m_address, b.m_address, 16));
+  return ((a.m_words[0] ^ b.m_words[0]) | (a.m_words[1] ^ b.m_words[1])) == 0;
 }
 
 inline bool operator != (const Ipv6Address& a, const Ipv6Address& b)
 {
-  return std::memcmp (a.m_address, b.m_address, 16);
+  return !(a == b);
 }
 
 inline bool operator < (const Ipv6Address& a, const Ipv6Address& b)
 {
-  return (std::memcmp (a.m_address, b.m_address, 16) < 0);
+  // same order as a memcmp of the bytes
+  if (a.m_words[0] != b.m_words[0])
+    {
+      return Ipv6Address::SwapWord (a.m_words[0]) < Ipv6Address::SwapWord (b.m_words[0]);
+    }
+  return Ipv6Address::SwapWord (a.m_words[1]) < Ipv6Address::SwapWord (b.m_words[1]);
 }
 
 inline bool operator == (const Ipv6Prefix& a, const Ipv6Prefix& b)
 {
-  return (!std::memcmp (a.m_prefix, b.m_prefix, 16));
+  return a.m_words[0] == b.m_words[0] && a.m_words[1] == b.m_words[1];
 }
 
 inline bool operator != (const Ipv6Prefix& a, const Ipv6Prefix& b)
 {
-  return std::memcmp (a.m_prefix, b.m_prefix, 16);
+  return !(a == b);
 }
 
 /**
@@ -591,6 +670,20 @@ public:
   size_t operator () (Ipv6Address const &x) const;
 };
 
+inline size_t Ipv6AddressHash::operator () (Ipv6Address const &x) const
+{
+  // the addresses of a subnet differ in their last bytes, that is in the
+  // high-order bits of the second word: fold the words together, then
+  // spread every bit over the whole hash (finalizer of MurmurHash3).
+  uint64_t h = x.m_words[1] + x.m_words[0] * 0x9e3779b97f4a7c15ULL;
+  h ^= h >> 33;
+  h *= 0xff51afd7ed558ccdULL;
+  h ^= h >> 33;
+  h *= 0xc4ceb9fe1a85ec53ULL;
+  h ^= h >> 33;
+  return static_cast<size_t> (h);
+}
+
 } /* namespace ns3 */
 
 #endif /* IPV6_ADDRESS_H */
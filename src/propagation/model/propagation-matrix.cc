@@ -0,0 +1,200 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/log.h"
+#include "ns3/assert.h"
+#include "propagation-matrix.h"
+#include "jakes-propagation-loss-model.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("PropagationMatrix");
+
+PropagationMatrix::PropagationMatrix ()
+  : m_staticLoss (true)
+{
+  NS_LOG_FUNCTION (this);
+}
+
+PropagationMatrix::~PropagationMatrix ()
+{
+  NS_LOG_FUNCTION (this);
+  Clear ();
+}
+
+void
+PropagationMatrix::SetLossModel (Ptr<PropagationLossModel> loss)
+{
+  NS_LOG_FUNCTION (this << loss);
+  m_loss = loss;
+  m_staticLoss = IsStatic (loss);
+  NS_LOG_LOGIC ("the loss of the paths is " << (m_staticLoss ? "kept" : "computed each time"));
+  InvalidateAll ();
+}
+
+void
+PropagationMatrix::SetDelayModel (Ptr<PropagationDelayModel> delay)
+{
+  NS_LOG_FUNCTION (this << delay);
+  m_delay = delay;
+  InvalidateAll ();
+}
+
+void
+PropagationMatrix::Add (Ptr<MobilityModel> mobility)
+{
+  NS_LOG_FUNCTION (this << mobility);
+  uint32_t index = m_entries.size ();
+  Entry entry;
+  entry.mobility = mobility;
+  entry.moving = false;
+  if (mobility != 0)
+    {
+      Vector velocity = mobility->GetVelocity ();
+      entry.moving = velocity.x != 0 || velocity.y != 0 || velocity.z != 0;
+      if (m_byMobility.find (PeekPointer (mobility)) == m_byMobility.end ())
+        {
+          mobility->TraceConnectWithoutContext ("CourseChange", MakeCallback (&PropagationMatrix::CourseChanged, this));
+        }
+      m_byMobility.insert (std::make_pair (PeekPointer (mobility), index));
+    }
+  m_entries.push_back (entry);
+  m_paths.push_back (Paths ());
+  m_senders.push_back (std::set<uint32_t> ());
+}
+
+uint32_t
+PropagationMatrix::GetN (void) const
+{
+  return m_entries.size ();
+}
+
+double
+PropagationMatrix::CalcRxPower (double txPowerDbm, uint32_t sender, uint32_t receiver)
+{
+  NS_ASSERT (m_loss != 0);
+  if (!m_staticLoss)
+    {
+      NS_ASSERT (sender < m_entries.size () && receiver < m_entries.size ());
+      return m_loss->CalcRxPower (txPowerDbm, m_entries[sender].mobility, m_entries[receiver].mobility);
+    }
+  return txPowerDbm + GetPath (sender, receiver).rxPowerDbm;
+}
+
+Time
+PropagationMatrix::GetDelay (uint32_t sender, uint32_t receiver)
+{
+  NS_ASSERT (m_delay != 0);
+  return GetPath (sender, receiver).delay;
+}
+
+void
+PropagationMatrix::Clear (void)
+{
+  NS_LOG_FUNCTION (this);
+  for (std::multimap<const MobilityModel *, uint32_t>::const_iterator i = m_byMobility.begin ();
+       i != m_byMobility.end (); i = m_byMobility.upper_bound (i->first))
+    {
+      m_entries[i->second].mobility->TraceDisconnectWithoutContext ("CourseChange",
+                                                                    MakeCallback (&PropagationMatrix::CourseChanged, this));
+    }
+  m_entries.clear ();
+  m_paths.clear ();
+  m_senders.clear ();
+  m_byMobility.clear ();
+}
+
+const PropagationMatrix::Path &
+PropagationMatrix::GetPath (uint32_t sender, uint32_t receiver)
+{
+  NS_ASSERT (sender < m_entries.size () && receiver < m_entries.size ());
+  if (m_entries[sender].moving || m_entries[receiver].moving)
+    {
+      Compute (sender, receiver, m_moving);
+      return m_moving;
+    }
+  Paths::iterator i = m_paths[sender].find (receiver);
+  if (i == m_paths[sender].end ())
+    {
+      i = m_paths[sender].insert (std::make_pair (receiver, Path ())).first;
+      Compute (sender, receiver, i->second);
+      m_senders[receiver].insert (sender);
+    }
+  return i->second;
+}
+
+void
+PropagationMatrix::Compute (uint32_t sender, uint32_t receiver, Path &path) const
+{
+  Ptr<MobilityModel> a = m_entries[sender].mobility;
+  Ptr<MobilityModel> b = m_entries[receiver].mobility;
+  NS_ASSERT_MSG (a != 0 && b != 0, "The entries of a path must have a mobility model");
+  path.rxPowerDbm = m_loss != 0 && m_staticLoss ? m_loss->CalcRxPower (0, a, b) : 0;
+  path.delay = m_delay != 0 ? m_delay->GetDelay (a, b) : Seconds (0);
+}
+
+bool
+PropagationMatrix::IsStatic (Ptr<PropagationLossModel> loss)
+{
+  for (Ptr<PropagationLossModel> model = loss; model != 0; model = model->GetNext ())
+    {
+      if (DynamicCast<RandomPropagationLossModel> (model) != 0
+          || DynamicCast<NakagamiPropagationLossModel> (model) != 0
+          || DynamicCast<JakesPropagationLossModel> (model) != 0
+          || DynamicCast<FixedRssLossModel> (model) != 0)
+        {
+          return false;
+        }
+    }
+  return true;
+}
+
+void
+PropagationMatrix::InvalidateAll (void)
+{
+  for (uint32_t k = 0; k < m_paths.size (); k++)
+    {
+      m_paths[k].clear ();
+      m_senders[k].clear ();
+    }
+}
+
+void
+PropagationMatrix::CourseChanged (Ptr<const MobilityModel> mobility)
+{
+  NS_LOG_FUNCTION (this << mobility);
+  typedef std::multimap<const MobilityModel *, uint32_t>::const_iterator Iterator;
+  std::pair<Iterator, Iterator> range = m_byMobility.equal_range (PeekPointer (mobility));
+  Vector velocity = mobility->GetVelocity ();
+  bool moving = velocity.x != 0 || velocity.y != 0 || velocity.z != 0;
+  for (Iterator i = range.first; i != range.second; ++i)
+    {
+      uint32_t index = i->second;
+      m_entries[index].moving = moving;
+      for (Paths::const_iterator j = m_paths[index].begin (); j != m_paths[index].end (); ++j)
+        {
+          m_senders[j->first].erase (index);
+        }
+      m_paths[index].clear ();
+      for (std::set<uint32_t>::const_iterator j = m_senders[index].begin (); j != m_senders[index].end (); ++j)
+        {
+          m_paths[*j].erase (index);
+        }
+      m_senders[index].clear ();
+    }
+}
+
+} // namespace ns3
@@ -0,0 +1,169 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#ifndef PROPAGATION_MATRIX_H
+#define PROPAGATION_MATRIX_H
+
+#include <map>
+#include <set>
+#include <vector>
+#include <stdint.h>
+#include "ns3/ptr.h"
+#include "ns3/nstime.h"
+#include "ns3/mobility-model.h"
+#include "propagation-loss-model.h"
+#include "propagation-delay-model.h"
+
+namespace ns3 {
+
+/**
+ * \ingroup propagation
+ * \brief The propagation loss and delay of the paths between a set of
+ * mobility models, computed once and kept until one of them moves.
+ *
+ * Each entry is a mobility model, numbered in the order it was added,
+ * e.g. the index of a PHY in the list of a channel. The loss and delay
+ * of the path from an entry to another are computed on first use with
+ * the loss and delay models, and kept by sender and receiver, so that
+ * only the paths in use take memory. When the mobility model of an entry
+ * notifies a course change, the paths from and to the entry are removed;
+ * the paths from or to an entry which was moving at its last course
+ * change are computed each time, and not kept.
+ *
+ * The loss of a path is kept as the power received for a transmit power
+ * of 0 dBm. If one of the loss models draws random variables or changes
+ * with time (RandomPropagationLossModel, NakagamiPropagationLossModel,
+ * JakesPropagationLossModel), or depends on the transmit power
+ * (FixedRssLossModel), the loss is computed each time, and only the
+ * delay is kept.
+ */
+class PropagationMatrix
+{
+public:
+  PropagationMatrix ();
+  ~PropagationMatrix ();
+
+  /**
+   * \param loss the loss model
+   *
+   * Clears the paths computed before.
+   */
+  void SetLossModel (Ptr<PropagationLossModel> loss);
+  /**
+   * \param delay the delay model
+   *
+   * Clears the paths computed before.
+   */
+  void SetDelayModel (Ptr<PropagationDelayModel> delay);
+  /**
+   * \param mobility the mobility model of the next entry, or 0
+   */
+  void Add (Ptr<MobilityModel> mobility);
+  /**
+   * \returns the number of entries
+   */
+  uint32_t GetN (void) const;
+  /**
+   * \param txPowerDbm the transmit power, in dBm
+   * \param sender the entry which sends
+   * \param receiver the entry which receives
+   * \returns the received power, in dBm
+   *
+   * Both entries must have a mobility model, and the loss model must be set.
+   */
+  double CalcRxPower (double txPowerDbm, uint32_t sender, uint32_t receiver);
+  /**
+   * \param sender the entry which sends
+   * \param receiver the entry which receives
+   * \returns the propagation delay
+   *
+   * Both entries must have a mobility model, and the delay model must be set.
+   */
+  Time GetDelay (uint32_t sender, uint32_t receiver);
+  /// Remove all the entries, and stop following their mobility models.
+  void Clear (void);
+
+private:
+  /**
+   * \brief Copy constructor, not implemented: the matrix follows the
+   * mobility models of its entries.
+   * \param o the other matrix
+   */
+  PropagationMatrix (const PropagationMatrix &o);
+  /**
+   * \brief Assignment operator, not implemented.
+   * \param o the other matrix
+   * \returns the matrix
+   */
+  PropagationMatrix &operator = (const PropagationMatrix &o);
+
+  /// An entry.
+  struct Entry
+  {
+    Ptr<MobilityModel> mobility;  //!< The mobility model.
+    bool moving;                  //!< Whether the velocity was not zero at the last course change.
+  };
+  /// A path between two entries.
+  struct Path
+  {
+    double rxPowerDbm;  //!< The power received for 0 dBm sent.
+    Time delay;         //!< The propagation delay.
+  };
+  /// The paths from a sender, by receiver.
+  typedef std::map<uint32_t, Path> Paths;
+
+  /**
+   * \param loss a loss model
+   * \returns true if the loss of a path given by the model and the next
+   * ones does not change as long as the entries do not move, and does not
+   * depend on the transmit power
+   */
+  static bool IsStatic (Ptr<PropagationLossModel> loss);
+
+  /**
+   * \param sender the entry which sends
+   * \param receiver the entry which receives
+   * \returns the path, computed if needed
+   */
+  const Path & GetPath (uint32_t sender, uint32_t receiver);
+  /**
+   * \brief Compute a path.
+   * \param sender the entry which sends
+   * \param receiver the entry which receives
+   * \param path the path
+   */
+  void Compute (uint32_t sender, uint32_t receiver, Path &path) const;
+  /// Remove all the paths.
+  void InvalidateAll (void);
+  /**
+   * \brief Remove the paths of the entries of a mobility model which
+   * changed course.
+   * \param mobility the mobility model
+   */
+  void CourseChanged (Ptr<const MobilityModel> mobility);
+
+  Ptr<PropagationLossModel> m_loss;    //!< The loss model.
+  bool m_staticLoss;                   //!< Whether the loss of the paths can be kept.
+  Ptr<PropagationDelayModel> m_delay;  //!< The delay model.
+  std::vector<Entry> m_entries;        //!< The entries.
+  std::vector<Paths> m_paths;          //!< The paths kept, by sender.
+  std::vector<std::set<uint32_t> > m_senders; //!< The senders of the paths kept, by receiver.
+  std::multimap<const MobilityModel *, uint32_t> m_byMobility; //!< The entries of each mobility model, by index.
+  Path m_moving;                       //!< The last path computed from or to a moving entry.
+};
+
+} // namespace ns3
+
+#endif /* PROPAGATION_MATRIX_H */
@@ -22,7 +22,10 @@
 #include "ns3/config.h"
 #include "ns3/double.h"
 #include "ns3/propagation-loss-model.h"
+#include "ns3/propagation-delay-model.h"
+#include "ns3/propagation-matrix.h"
 #include "ns3/constant-position-mobility-model.h"
+#include "ns3/constant-velocity-mobility-model.h"
 #include "ns3/simulator.h"
 
 using namespace ns3;
@@ -436,6 +439,119 @@ RangePropagationLossModelTestCase::DoRun (void)
   Simulator::Destroy ();
 }
 
+/**
+ * Make sure that a PropagationMatrix gives the loss and delay of its
+ * models, while a node moves and another one jumps.
+ */
+class PropagationMatrixTestCase : public TestCase
+{
+public:
+  PropagationMatrixTestCase ();
+  virtual ~PropagationMatrixTestCase ();
+
+private:
+  virtual void DoRun (void);
+  /// Compare the paths of the matrix with the models.
+  void Check (void);
+
+  std::vector<Ptr<MobilityModel> > m_nodes;  //!< The entries of the matrix
+  Ptr<PropagationLossModel> m_loss;          //!< The loss model
+  Ptr<PropagationDelayModel> m_delay;        //!< The delay model
+  PropagationMatrix *m_matrix;               //!< The matrix
+};
+
+PropagationMatrixTestCase::PropagationMatrixTestCase ()
+  : TestCase ("Test PropagationMatrix"),
+    m_matrix (0)
+{
+}
+
+PropagationMatrixTestCase::~PropagationMatrixTestCase ()
+{
+}
+
+void
+PropagationMatrixTestCase::Check (void)
+{
+  for (uint32_t i = 0; i < m_nodes.size (); i++)
+    {
+      for (uint32_t j = 0; j < m_nodes.size (); j++)
+        {
+          if (i == j)
+            {
+              continue;
+            }
+          NS_TEST_EXPECT_MSG_EQ_TOL (m_matrix->CalcRxPower (10, i, j), m_loss->CalcRxPower (10, m_nodes[i], m_nodes[j]),
+                                     1e-9, "Wrong power from " << i << " to " << j << " at " << Simulator::Now ());
+          NS_TEST_EXPECT_MSG_EQ (m_matrix->GetDelay (i, j), m_delay->GetDelay (m_nodes[i], m_nodes[j]),
+                                 "Wrong delay from " << i << " to " << j << " at " << Simulator::Now ());
+        }
+    }
+}
+
+void
+PropagationMatrixTestCase::DoRun (void)
+{
+  m_loss = CreateObject<LogDistancePropagationLossModel> ();
+  m_loss->SetNext (CreateObject<ThreeLogDistancePropagationLossModel> ());
+  m_delay = CreateObject<ConstantSpeedPropagationDelayModel> ();
+  PropagationMatrix matrix;
+  m_matrix = &matrix;
+  matrix.SetLossModel (m_loss);
+  matrix.SetDelayModel (m_delay);
+
+  m_nodes.clear ();
+  for (uint32_t i = 0; i < 20; i++)
+    {
+      Ptr<MobilityModel> node = CreateObject<ConstantPositionMobilityModel> ();
+      node->SetPosition (Vector (30.0 * i, 7.0 * (i % 3), 0));
+      m_nodes.push_back (node);
+    }
+  // one node walks, and another one jumps at 3 s
+  Ptr<ConstantVelocityMobilityModel> walker = CreateObject<ConstantVelocityMobilityModel> ();
+  walker->SetPosition (Vector (50, 50, 0));
+  walker->SetVelocity (Vector (10, 0, 0));
+  m_nodes[4] = walker;
+  // two entries may share a mobility model
+  m_nodes[7] = m_nodes[6];
+  for (uint32_t i = 0; i < m_nodes.size (); i++)
+    {
+      matrix.Add (m_nodes[i]);
+    }
+  NS_TEST_ASSERT_MSG_EQ (matrix.GetN (), 20, "Wrong number of entries");
+
+  for (uint32_t t = 0; t < 6; t++)
+    {
+      Simulator::Schedule (Seconds (t), &PropagationMatrixTestCase::Check, this);
+    }
+  Simulator::Schedule (Seconds (3), &MobilityModel::SetPosition, m_nodes[6], Vector (1000, 0, 0));
+  Simulator::Schedule (Seconds (4.5), &ConstantVelocityMobilityModel::SetVelocity, walker, Vector (0, 0, 0));
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  // the fading of a random loss model is drawn again for each call, while
+  // the transmit power given to a fixed one is ignored
+  Ptr<NakagamiPropagationLossModel> fading = CreateObject<NakagamiPropagationLossModel> ();
+  fading->AssignStreams (1);
+  m_loss->SetNext (fading);
+  matrix.SetLossModel (m_loss);
+  double first = matrix.CalcRxPower (10, 0, 1);
+  bool drawn = false;
+  for (uint32_t k = 0; k < 10; k++)
+    {
+      drawn = drawn || matrix.CalcRxPower (10, 0, 1) != first;
+    }
+  NS_TEST_EXPECT_MSG_EQ (drawn, true, "The fading of a path was kept");
+  Ptr<FixedRssLossModel> fixed = CreateObject<FixedRssLossModel> ();
+  fixed->SetRss (-60);
+  matrix.SetLossModel (fixed);
+  NS_TEST_EXPECT_MSG_EQ_TOL (matrix.CalcRxPower (20, 0, 1), -60, 1e-9, "Wrong fixed power");
+  NS_TEST_EXPECT_MSG_EQ (matrix.GetDelay (0, 1), m_delay->GetDelay (m_nodes[0], m_nodes[1]), "Wrong delay");
+
+  matrix.Clear ();
+  m_matrix = 0;
+}
+
 class PropagationLossModelsTestSuite : public TestSuite
 {
 public:
@@ -450,6 +566,7 @@ PropagationLossModelsTestSuite::PropagationLossModelsTestSuite ()
   AddTestCase (new LogDistancePropagationLossModelTestCase, TestCase::QUICK);
   AddTestCase (new MatrixPropagationLossModelTestCase, TestCase::QUICK);
   AddTestCase (new RangePropagationLossModelTestCase, TestCase::QUICK);
+  AddTestCase (new PropagationMatrixTestCase, TestCase::QUICK);
 }
 
 static PropagationLossModelsTestSuite propagationLossModelsTestSuite;
@@ -0,0 +1,748 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <iostream>
+#include <sstream>
+#include <limits>
+#include <cmath>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <unistd.h>
+#include <poll.h>
+#include <sys/wait.h>
+
+#include "replication-runner.h"
+#include "ns3/abort.h"
+#include "ns3/log.h"
+#include "ns3/config.h"
+#include "ns3/string.h"
+#include "ns3/rng-seed-manager.h"
+#include "ns3/system-wall-clock-ms.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("ReplicationRunner");
+
+/**
+ * \ingroup stats
+ * Write the values output by the calculators of a replication as lines
+ * of tab separated fields: the kind ('N' for a number, 'S' for a
+ * string, 'T' for the processor time of the replication), the key, the
+ * variable and the value. Statistical summaries
+ * are written as one number per statistic.
+ */
+class ReplicationWriter : public DataOutputCallback
+{
+public:
+  ReplicationWriter ()
+  {
+    m_data.precision (17);
+  }
+  /** \returns the lines written */
+  std::string GetData (void) const
+  {
+    return m_data.str ();
+  }
+  /**
+   * \param key the key
+   * \param variable the variable
+   * \param val the value
+   */
+  void WriteNumber (std::string key, std::string variable, double val)
+  {
+    m_data << "N\t" << key << "\t" << variable << "\t" << val << "\n";
+  }
+  virtual void OutputStatistic (std::string key, std::string variable,
+                                const StatisticalSummary *statSum)
+  {
+    if (statSum == 0)
+      {
+        return;
+      }
+    WriteNumber (key, variable + "-count", statSum->getCount ());
+    WriteNumber (key, variable + "-sum", statSum->getSum ());
+    WriteNumber (key, variable + "-mean", statSum->getMean ());
+    WriteNumber (key, variable + "-min", statSum->getMin ());
+    WriteNumber (key, variable + "-max", statSum->getMax ());
+    WriteNumber (key, variable + "-stddev", statSum->getStddev ());
+  }
+  virtual void OutputSingleton (std::string key, std::string variable, int val)
+  {
+    WriteNumber (key, variable, val);
+  }
+  virtual void OutputSingleton (std::string key, std::string variable, uint32_t val)
+  {
+    WriteNumber (key, variable, val);
+  }
+  virtual void OutputSingleton (std::string key, std::string variable, double val)
+  {
+    WriteNumber (key, variable, val);
+  }
+  virtual void OutputSingleton (std::string key, std::string variable, std::string val)
+  {
+    m_data << "S\t" << key << "\t" << variable << "\t" << val << "\n";
+  }
+  virtual void OutputSingleton (std::string key, std::string variable, Time val)
+  {
+    WriteNumber (key, variable, val.GetSeconds ());
+  }
+
+private:
+  std::ostringstream m_data;  //!< The lines written.
+};
+
+/**
+ * \ingroup stats
+ * A calculator which outputs the values received from a replication,
+ * to write them with a DataOutputInterface.
+ */
+class ReplicationRecords : public DataCalculator
+{
+public:
+  /**
+   * \param key the key
+   * \param variable the variable
+   * \param value the value
+   * \param numeric whether the value is a number
+   */
+  void Add (std::string key, std::string variable, std::string value, bool numeric)
+  {
+    m_keys.push_back (key);
+    m_variables.push_back (variable);
+    m_values.push_back (value);
+    m_numeric.push_back (numeric);
+  }
+  virtual void Output (DataOutputCallback &callback) const
+  {
+    for (uint32_t i = 0; i < m_values.size (); i++)
+      {
+        if (m_numeric[i])
+          {
+            callback.OutputSingleton (m_keys[i], m_variables[i], std::atof (m_values[i].c_str ()));
+          }
+        else
+          {
+            callback.OutputSingleton (m_keys[i], m_variables[i], m_values[i]);
+          }
+      }
+  }
+
+private:
+  std::vector<std::string> m_keys;       //!< The keys.
+  std::vector<std::string> m_variables;  //!< The variables.
+  std::vector<std::string> m_values;     //!< The values.
+  std::vector<bool> m_numeric;           //!< Whether each value is a number.
+};
+
+/**
+ * \param text a text
+ * \param separator the separator
+ * \returns the fields of the text
+ */
+static std::vector<std::string>
+Split (std::string text, char separator)
+{
+  std::vector<std::string> fields;
+  std::string::size_type start = 0;
+  while (true)
+    {
+      std::string::size_type end = text.find (separator, start);
+      fields.push_back (text.substr (start, end - start));
+      if (end == std::string::npos)
+        {
+          return fields;
+        }
+      start = end + 1;
+    }
+}
+
+/**
+ * \param field a field
+ * \returns the field, quoted if needed to be a CSV field
+ */
+static std::string
+CsvField (std::string field)
+{
+  if (field.find_first_of (",\"\n") == std::string::npos)
+    {
+      return field;
+    }
+  std::string quoted = "\"";
+  for (std::string::size_type i = 0; i < field.size (); i++)
+    {
+      if (field[i] == '"')
+        {
+          quoted += '"';
+        }
+      quoted += field[i];
+    }
+  return quoted + "\"";
+}
+
+/**
+ * \param df the degrees of freedom
+ * \returns the 0.975 quantile of the Student t distribution
+ */
+static double
+GetStudentT975 (uint32_t df)
+{
+  static const double table[30] = {
+    12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+    2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+    2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042
+  };
+  if (df <= 30)
+    {
+      return table[df - 1];
+    }
+  // Cornish-Fisher expansion around the normal quantile
+  double z = 1.959964;
+  double z3 = z * z * z;
+  double z5 = z3 * z * z;
+  return z + (z3 + z) / (4.0 * df) + (5 * z5 + 16 * z3 + 3 * z) / (96.0 * df * df);
+}
+
+ReplicationRunner::ReplicationRunner ()
+  : m_replications (1),
+    m_runBase (1),
+    m_jobs (0),
+    m_experiment ("sweep"),
+    m_filePrefix ("sweep"),
+    m_failures (0),
+    m_lastJobs (1),
+    m_elapsed (0),
+    m_serialTime (0)
+{
+}
+
+void
+ReplicationRunner::SetSweep (std::string spec)
+{
+  NS_LOG_FUNCTION (this << spec);
+  m_parameters.clear ();
+  if (spec.empty ())
+    {
+      return;
+    }
+  std::vector<std::string> parameters = Split (spec, ';');
+  for (uint32_t i = 0; i < parameters.size (); i++)
+    {
+      std::string::size_type equal = parameters[i].find ('=');
+      NS_ABORT_MSG_IF (equal == std::string::npos, "Invalid sweep parameter \"" << parameters[i] << "\"");
+      AddParameter (parameters[i].substr (0, equal), parameters[i].substr (equal + 1));
+    }
+}
+
+void
+ReplicationRunner::AddParameter (std::string name, std::string values)
+{
+  NS_LOG_FUNCTION (this << name << values);
+  NS_ABORT_MSG_IF (name.empty () || values.empty (), "Invalid sweep parameter \"" << name << "\"");
+  Parameter parameter;
+  parameter.name = name;
+  parameter.values = Split (values, ',');
+  m_parameters.push_back (parameter);
+}
+
+void
+ReplicationRunner::SetReplications (uint32_t replications)
+{
+  NS_ABORT_MSG_IF (replications == 0, "At least one replication is needed");
+  m_replications = replications;
+}
+
+void
+ReplicationRunner::SetRunBase (uint64_t run)
+{
+  m_runBase = run;
+}
+
+void
+ReplicationRunner::SetJobs (uint32_t jobs)
+{
+  m_jobs = jobs;
+}
+
+void
+ReplicationRunner::SetExperiment (std::string experiment)
+{
+  m_experiment = experiment;
+}
+
+void
+ReplicationRunner::SetFilePrefix (std::string prefix)
+{
+  m_filePrefix = prefix;
+}
+
+void
+ReplicationRunner::SetOutput (Ptr<DataOutputInterface> output)
+{
+  m_output = output;
+}
+
+uint32_t
+ReplicationRunner::GetNPoints (void) const
+{
+  uint32_t points = 1;
+  for (uint32_t i = 0; i < m_parameters.size (); i++)
+    {
+      points *= m_parameters[i].values.size ();
+    }
+  return points;
+}
+
+ReplicationRunner::Parameters
+ReplicationRunner::GetPoint (uint32_t point) const
+{
+  Parameters parameters;
+  // the last parameter varies the fastest
+  for (uint32_t i = m_parameters.size (); i-- > 0; )
+    {
+      uint32_t n = m_parameters[i].values.size ();
+      parameters[m_parameters[i].name] = m_parameters[i].values[point % n];
+      point /= n;
+    }
+  return parameters;
+}
+
+std::string
+ReplicationRunner::GetPointLabel (uint32_t point) const
+{
+  Parameters parameters = GetPoint (point);
+  std::string label;
+  for (uint32_t i = 0; i < m_parameters.size (); i++)
+    {
+      label += (i ? "," : "") + m_parameters[i].name + "=" + parameters[m_parameters[i].name];
+    }
+  return label;
+}
+
+uint32_t
+ReplicationRunner::GetNFailures (void) const
+{
+  return m_failures;
+}
+
+double
+ReplicationRunner::GetElapsed (void) const
+{
+  return m_elapsed;
+}
+
+double
+ReplicationRunner::GetSerialTime (void) const
+{
+  return m_serialTime;
+}
+
+void
+ReplicationRunner::Run (ReplicationCallback replication)
+{
+  NS_LOG_FUNCTION (this);
+  uint32_t jobs = m_jobs;
+  if (jobs == 0)
+    {
+      long processors = sysconf (_SC_NPROCESSORS_ONLN);
+      jobs = processors > 0 ? processors : 1;
+    }
+  uint32_t points = GetNPoints ();
+  uint32_t total = points * m_replications;
+  m_values.assign (points, Values ());
+  m_failures = 0;
+  m_serialTime = 0;
+
+  if (!m_filePrefix.empty ())
+    {
+      std::string name = m_filePrefix + "-results.csv";
+      m_results.open (name.c_str ());
+      NS_ABORT_MSG_UNLESS (m_results.is_open (), "Could not open " << name);
+      m_results.precision (17);
+      for (uint32_t i = 0; i < m_parameters.size (); i++)
+        {
+          m_results << CsvField (m_parameters[i].name) << ",";
+        }
+      m_results << "run,key,variable,value" << std::endl;
+    }
+
+  SystemWallClockMs clock;
+  clock.Start ();
+  std::vector<Job> running;
+  uint32_t next = 0;
+  while (next < total || !running.empty ())
+    {
+      while (running.size () < jobs && next < total)
+        {
+          running.push_back (Launch (replication, next / m_replications, next % m_replications));
+          next++;
+        }
+
+      std::vector<struct pollfd> fds (running.size ());
+      for (uint32_t i = 0; i < running.size (); i++)
+        {
+          fds[i].fd = running[i].fd;
+          fds[i].events = POLLIN;
+          fds[i].revents = 0;
+        }
+      if (poll (&fds[0], fds.size (), -1) < 0)
+        {
+          NS_ABORT_MSG_IF (errno != EINTR, "poll failed: " << std::strerror (errno));
+          continue;
+        }
+      for (uint32_t i = running.size (); i-- > 0; )
+        {
+          if (fds[i].revents == 0)
+            {
+              continue;
+            }
+          char buffer[4096];
+          ssize_t n = read (running[i].fd, buffer, sizeof (buffer));
+          if (n > 0)
+            {
+              running[i].data.append (buffer, n);
+              continue;
+            }
+          if (n < 0 && errno == EINTR)
+            {
+              continue;
+            }
+          close (running[i].fd);
+          int status;
+          while (waitpid (running[i].pid, &status, 0) < 0 && errno == EINTR)
+            {
+            }
+          Collect (running[i], status);
+          running.erase (running.begin () + i);
+        }
+    }
+  m_elapsed = clock.End () / 1000.0;
+
+  if (m_results.is_open ())
+    {
+      m_results.close ();
+    }
+  m_lastJobs = jobs;
+  if (!m_filePrefix.empty ())
+    {
+      Summarize ();
+    }
+}
+
+void
+ReplicationRunner::PrintSpeedup (std::ostream &os) const
+{
+  double speedup = m_elapsed > 0 ? m_serialTime / m_elapsed : 0;
+  os << GetNPoints () * m_replications << " replications of " << GetNPoints () << " points, "
+     << m_lastJobs << " jobs: " << m_elapsed << " s elapsed, " << m_serialTime
+     << " s of replications, speedup " << speedup << ", efficiency " << speedup / m_lastJobs;
+  if (m_failures != 0)
+    {
+      os << ", " << m_failures << " failed";
+    }
+  os << std::endl;
+}
+
+ReplicationRunner::Job
+ReplicationRunner::Launch (ReplicationCallback replication, uint32_t point, uint32_t index)
+{
+  NS_LOG_FUNCTION (this << point << index);
+  int fds[2];
+  NS_ABORT_MSG_IF (pipe (fds) != 0, "pipe failed: " << std::strerror (errno));
+  // the buffered output would be written again by the child
+  std::cout.flush ();
+  std::cerr.flush ();
+  std::fflush (0);
+  int pid = fork ();
+  NS_ABORT_MSG_IF (pid < 0, "fork failed: " << std::strerror (errno));
+  if (pid == 0)
+    {
+      close (fds[0]);
+      RunReplication (replication, point, index, fds[1]);
+      close (fds[1]);
+      std::cout.flush ();
+      std::cerr.flush ();
+      std::fflush (0);
+      _exit (0);
+    }
+  close (fds[1]);
+  Job job;
+  job.pid = pid;
+  job.fd = fds[0];
+  job.point = point;
+  job.replication = index;
+  return job;
+}
+
+void
+ReplicationRunner::RunReplication (ReplicationCallback replication, uint32_t point, uint32_t index, int fd)
+{
+  uint64_t run = m_runBase + index;
+  RngSeedManager::SetRun (run);
+  Parameters parameters = GetPoint (point);
+  for (Parameters::const_iterator i = parameters.begin (); i != parameters.end (); ++i)
+    {
+      if (i->first.find ("::") != std::string::npos)
+        {
+          Config::SetDefault (i->first, StringValue (i->second));
+        }
+    }
+
+  std::ostringstream runLabel;
+  runLabel << run;
+  std::string label = GetPointLabel (point);
+  Ptr<DataCollector> collector = CreateObject<DataCollector> ();
+  collector->DescribeRun (m_experiment, label, label, runLabel.str ());
+  for (Parameters::const_iterator i = parameters.begin (); i != parameters.end (); ++i)
+    {
+      collector->AddMetadata (i->first, i->second);
+    }
+
+  SystemWallClockMs clock;
+  clock.Start ();
+  replication (parameters, collector);
+  clock.End ();
+  // processor time, which unlike the wall-clock time does not grow when
+  // the replications compete for the processors
+  int64_t ms = clock.GetElapsedUser () + clock.GetElapsedSystem ();
+
+  ReplicationWriter writer;
+  for (DataCalculatorList::iterator i = collector->DataCalculatorBegin ();
+       i != collector->DataCalculatorEnd (); ++i)
+    {
+      (*i)->Output (writer);
+    }
+  // the last line is the processor time of the replication
+  std::ostringstream time;
+  time << "T\t\t\t" << ms / 1000.0 << "\n";
+  std::string data = writer.GetData () + time.str ();
+  std::string::size_type written = 0;
+  while (written < data.size ())
+    {
+      ssize_t n = write (fd, data.data () + written, data.size () - written);
+      if (n < 0 && errno == EINTR)
+        {
+          continue;
+        }
+      if (n <= 0)
+        {
+          return;
+        }
+      written += n;
+    }
+}
+
+void
+ReplicationRunner::Collect (const Job &job, int status)
+{
+  NS_LOG_FUNCTION (this << job.point << job.replication);
+  std::vector<Record> records;
+  double processorTime = -1;
+  std::vector<std::string> lines = Split (job.data, '\n');
+  for (uint32_t i = 0; i < lines.size (); i++)
+    {
+      std::vector<std::string> fields = Split (lines[i], '\t');
+      if (fields.size () != 4)
+        {
+          continue;
+        }
+      if (fields[0] == "T")
+        {
+          processorTime = std::atof (fields[3].c_str ());
+          continue;
+        }
+      Record record;
+      record.numeric = fields[0] == "N";
+      record.key = fields[1];
+      record.variable = fields[2];
+      record.value = fields[3];
+      records.push_back (record);
+    }
+
+  uint64_t run = m_runBase + job.replication;
+  if (!WIFEXITED (status) || WEXITSTATUS (status) != 0 || processorTime < 0)
+    {
+      m_failures++;
+      std::cerr << "Replication " << run << " of " << GetPointLabel (job.point) << " failed" << std::endl;
+      return;
+    }
+  m_serialTime += processorTime;
+
+  Values &values = m_values[job.point];
+  Parameters parameters = GetPoint (job.point);
+  Ptr<ReplicationRecords> calculator = CreateObject<ReplicationRecords> ();
+  for (uint32_t i = 0; i < records.size (); i++)
+    {
+      const Record &record = records[i];
+      if (record.numeric)
+        {
+          std::vector<double> &replications = values[std::make_pair (record.key, record.variable)];
+          replications.resize (m_replications, std::numeric_limits<double>::quiet_NaN ());
+          replications[job.replication] = std::atof (record.value.c_str ());
+        }
+      calculator->Add (record.key, record.variable, record.value, record.numeric);
+      if (m_results.is_open ())
+        {
+          for (uint32_t j = 0; j < m_parameters.size (); j++)
+            {
+              m_results << CsvField (parameters[m_parameters[j].name]) << ",";
+            }
+          m_results << run << "," << CsvField (record.key) << "," << CsvField (record.variable)
+                    << "," << CsvField (record.value) << "\n";
+        }
+    }
+  if (m_results.is_open ())
+    {
+      m_results.flush ();
+    }
+
+  if (m_output != 0)
+    {
+      std::ostringstream runLabel;
+      runLabel << run;
+      std::string label = GetPointLabel (job.point);
+      Ptr<DataCollector> collector = CreateObject<DataCollector> ();
+      collector->DescribeRun (m_experiment, label, label, runLabel.str ());
+      for (Parameters::const_iterator i = parameters.begin (); i != parameters.end (); ++i)
+        {
+          collector->AddMetadata (i->first, i->second);
+        }
+      collector->AddDataCalculator (calculator);
+      m_output->Output (*collector);
+      collector->Dispose ();
+    }
+}
+
+const std::vector<double> *
+ReplicationRunner::Find (uint32_t point, std::string key, std::string variable) const
+{
+  if (point >= m_values.size ())
+    {
+      return 0;
+    }
+  Values::const_iterator i = m_values[point].find (std::make_pair (key, variable));
+  if (i == m_values[point].end ())
+    {
+      return 0;
+    }
+  return &i->second;
+}
+
+double
+ReplicationRunner::GetValue (uint32_t point, uint32_t replication,
+                             std::string key, std::string variable) const
+{
+  const std::vector<double> *values = Find (point, key, variable);
+  if (values == 0 || replication >= values->size ())
+    {
+      return std::numeric_limits<double>::quiet_NaN ();
+    }
+  return (*values)[replication];
+}
+
+uint32_t
+ReplicationRunner::GetCount (uint32_t point, std::string key, std::string variable) const
+{
+  const std::vector<double> *values = Find (point, key, variable);
+  uint32_t count = 0;
+  for (uint32_t i = 0; values != 0 && i < values->size (); i++)
+    {
+      if (!std::isnan ((*values)[i]))
+        {
+          count++;
+        }
+    }
+  return count;
+}
+
+double
+ReplicationRunner::GetMean (uint32_t point, std::string key, std::string variable) const
+{
+  const std::vector<double> *values = Find (point, key, variable);
+  uint32_t count = 0;
+  double sum = 0;
+  for (uint32_t i = 0; values != 0 && i < values->size (); i++)
+    {
+      if (!std::isnan ((*values)[i]))
+        {
+          sum += (*values)[i];
+          count++;
+        }
+    }
+  return count ? sum / count : std::numeric_limits<double>::quiet_NaN ();
+}
+
+double
+ReplicationRunner::GetHalfWidth (uint32_t point, std::string key, std::string variable) const
+{
+  const std::vector<double> *values = Find (point, key, variable);
+  uint32_t count = GetCount (point, key, variable);
+  if (count < 2)
+    {
+      return std::numeric_limits<double>::quiet_NaN ();
+    }
+  double mean = GetMean (point, key, variable);
+  double squares = 0;
+  for (uint32_t i = 0; i < values->size (); i++)
+    {
+      if (!std::isnan ((*values)[i]))
+        {
+          squares += ((*values)[i] - mean) * ((*values)[i] - mean);
+        }
+    }
+  return GetStudentT975 (count - 1) * std::sqrt (squares / (count - 1) / count);
+}
+
+void
+ReplicationRunner::Summarize (void)
+{
+  std::string name = m_filePrefix + "-summary.csv";
+  std::ofstream summary (name.c_str ());
+  NS_ABORT_MSG_UNLESS (summary.is_open (), "Could not open " << name);
+  summary.precision (17);
+  for (uint32_t i = 0; i < m_parameters.size (); i++)
+    {
+      summary << CsvField (m_parameters[i].name) << ",";
+    }
+  summary << "key,variable,count,mean,ci95" << std::endl;
+
+  for (uint32_t point = 0; point < m_values.size (); point++)
+    {
+      Parameters parameters = GetPoint (point);
+      for (Values::const_iterator i = m_values[point].begin (); i != m_values[point].end (); ++i)
+        {
+          std::string key = i->first.first;
+          std::string variable = i->first.second;
+          uint32_t count = GetCount (point, key, variable);
+          double mean = GetMean (point, key, variable);
+          double halfWidth = GetHalfWidth (point, key, variable);
+          for (uint32_t j = 0; j < m_parameters.size (); j++)
+            {
+              summary << CsvField (parameters[m_parameters[j].name]) << ",";
+            }
+          summary << CsvField (key) << "," << CsvField (variable) << "," << count << ","
+                  << mean << ",";
+          if (!std::isnan (halfWidth))
+            {
+              summary << halfWidth;
+            }
+          summary << std::endl;
+        }
+    }
+}
+
+} // namespace ns3
@@ -0,0 +1,253 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef REPLICATION_RUNNER_H
+#define REPLICATION_RUNNER_H
+
+#include <map>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <ostream>
+#include "ns3/callback.h"
+#include "ns3/ptr.h"
+#include "ns3/data-collector.h"
+#include "ns3/data-output-interface.h"
+
+namespace ns3 {
+
+/**
+ * \ingroup stats
+ * \brief Run the replications of a parameter sweep in parallel processes.
+ *
+ * The sweep is the cartesian product of the values of its parameters,
+ * for instance "mns=1,2,4;speed=1,5" gives six points. Each point is
+ * simulated by a number of replications, replication r using the run
+ * number RunBase + r at every point, so the replications do not depend
+ * on each other nor on the number of processes.
+ *
+ * Each replication is run in a process forked from the caller: it sets
+ * the run number, applies the parameters whose name contains "::" with
+ * Config::SetDefault, and calls the replication callback, which builds
+ * and runs the simulation and adds its calculators to the DataCollector
+ * it is given. The singletons and statistical summaries of the
+ * calculators are sent back to the caller, which
+ *  - writes them to "<prefix>-results.csv" as each replication ends,
+ *    and, if an output is set, to it (e.g. a SqliteDataOutput, so that
+ *    the whole sweep ends up in one database),
+ *  - computes the mean of each numeric value over the replications of
+ *    each point, and its 95% confidence interval, written to
+ *    "<prefix>-summary.csv",
+ *  - measures the speedup over running the replications one at a time.
+ *
+ * Run () must be called before any simulation object is created, since
+ * the replications inherit the state of the caller.
+ */
+class ReplicationRunner
+{
+public:
+  /// The values of the parameters of a point, by parameter name.
+  typedef std::map<std::string, std::string> Parameters;
+  /// The replication callback.
+  typedef Callback<void, const Parameters &, Ptr<DataCollector> > ReplicationCallback;
+
+  ReplicationRunner ();
+
+  /**
+   * \param spec the sweep, as "name=value,value;name=value"
+   *
+   * Replaces the parameters added before.
+   */
+  void SetSweep (std::string spec);
+  /**
+   * \param name the name of the parameter
+   * \param values its values, separated by commas
+   */
+  void AddParameter (std::string name, std::string values);
+  /**
+   * \param replications the number of replications of each point
+   */
+  void SetReplications (uint32_t replications);
+  /**
+   * \param run the run number of the first replication
+   */
+  void SetRunBase (uint64_t run);
+  /**
+   * \param jobs the number of replications run at the same time, 0 for
+   * the number of processors
+   */
+  void SetJobs (uint32_t jobs);
+  /**
+   * \param experiment the experiment label of the DataCollectors
+   */
+  void SetExperiment (std::string experiment);
+  /**
+   * \param prefix the prefix of the CSV files, or an empty string for none
+   */
+  void SetFilePrefix (std::string prefix);
+  /**
+   * \param output where each replication is written, or 0
+   */
+  void SetOutput (Ptr<DataOutputInterface> output);
+
+  /**
+   * \brief Run all the replications of all the points.
+   * \param replication the replication callback
+   */
+  void Run (ReplicationCallback replication);
+  /**
+   * \brief Print the wall-clock time of the last Run (), and its speedup
+   * over running the replications one at a time.
+   * \param os the output stream
+   */
+  void PrintSpeedup (std::ostream &os) const;
+
+  /**
+   * \returns the number of points of the sweep
+   */
+  uint32_t GetNPoints (void) const;
+  /**
+   * \param point a point
+   * \returns its parameters
+   */
+  Parameters GetPoint (uint32_t point) const;
+  /**
+   * \param point a point
+   * \returns its parameters, as "name=value,name=value"
+   */
+  std::string GetPointLabel (uint32_t point) const;
+  /**
+   * \returns the number of replications which failed in the last Run ()
+   */
+  uint32_t GetNFailures (void) const;
+  /**
+   * \param point a point
+   * \param replication a replication
+   * \param key the key of the value
+   * \param variable the variable of the value
+   * \returns the value, or NaN if the replication did not output it
+   */
+  double GetValue (uint32_t point, uint32_t replication,
+                   std::string key, std::string variable) const;
+  /**
+   * \param point a point
+   * \param key the key of the value
+   * \param variable the variable of the value
+   * \returns the number of replications which output the value
+   */
+  uint32_t GetCount (uint32_t point, std::string key, std::string variable) const;
+  /**
+   * \param point a point
+   * \param key the key of the value
+   * \param variable the variable of the value
+   * \returns the mean of the value over the replications
+   */
+  double GetMean (uint32_t point, std::string key, std::string variable) const;
+  /**
+   * \param point a point
+   * \param key the key of the value
+   * \param variable the variable of the value
+   * \returns the half-width of the 95% confidence interval of the mean,
+   * or NaN with less than two replications
+   */
+  double GetHalfWidth (uint32_t point, std::string key, std::string variable) const;
+  /**
+   * \returns the wall-clock time of the last Run (), in seconds
+   */
+  double GetElapsed (void) const;
+  /**
+   * \returns the sum of the processor times of the replications of the
+   * last Run (), in seconds: about the time they take one at a time
+   */
+  double GetSerialTime (void) const;
+
+private:
+  /// A parameter of the sweep.
+  struct Parameter
+  {
+    std::string name;                  //!< The name.
+    std::vector<std::string> values;   //!< The values.
+  };
+  /// A value output by a replication.
+  struct Record
+  {
+    std::string key;       //!< The key.
+    std::string variable;  //!< The variable.
+    std::string value;     //!< The value, as text.
+    bool numeric;          //!< Whether the value is a number.
+  };
+  /// A replication being run.
+  struct Job
+  {
+    int pid;               //!< The process.
+    int fd;                //!< The read end of its pipe.
+    uint32_t point;        //!< The point.
+    uint32_t replication;  //!< The replication.
+    std::string data;      //!< What it sent so far.
+  };
+  /// The values of each replication, by key and variable.
+  typedef std::map<std::pair<std::string, std::string>, std::vector<double> > Values;
+
+  /**
+   * \brief Fork the process of a replication.
+   * \param replication the replication callback
+   * \param point the point
+   * \param index the replication
+   * \returns the job
+   */
+  Job Launch (ReplicationCallback replication, uint32_t point, uint32_t index);
+  /**
+   * \brief Run a replication, in its process.
+   * \param replication the replication callback
+   * \param point the point
+   * \param index the replication
+   * \param fd where the values are written
+   */
+  void RunReplication (ReplicationCallback replication, uint32_t point, uint32_t index, int fd);
+  /**
+   * \brief Store and output what a replication sent.
+   * \param job the job, which has ended
+   * \param status its exit status
+   */
+  void Collect (const Job &job, int status);
+  /// Write the means and confidence intervals of the values.
+  void Summarize (void);
+  /**
+   * \param point a point
+   * \param key the key of the value
+   * \param variable the variable of the value
+   * \returns the values of the replications, or 0
+   */
+  const std::vector<double> * Find (uint32_t point, std::string key, std::string variable) const;
+
+  std::vector<Parameter> m_parameters;  //!< The sweep.
+  uint32_t m_replications;              //!< The number of replications of each point.
+  uint64_t m_runBase;                   //!< The run number of the first replication.
+  uint32_t m_jobs;                      //!< The number of concurrent replications.
+  std::string m_experiment;             //!< The experiment label.
+  std::string m_filePrefix;             //!< The prefix of the CSV files.
+  Ptr<DataOutputInterface> m_output;    //!< The output of each replication.
+  std::ofstream m_results;              //!< The CSV file of the values.
+  std::vector<Values> m_values;         //!< The values, by point.
+  uint32_t m_failures;                  //!< The number of failed replications.
+  uint32_t m_lastJobs;                  //!< The number of concurrent replications of the last Run ().
+  double m_elapsed;                     //!< The wall-clock time of the sweep.
+  double m_serialTime;                  //!< The sum of the processor times of the replications.
+};
+
+} // namespace ns3
+
+#endif /* REPLICATION_RUNNER_H */
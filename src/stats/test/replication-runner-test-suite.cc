@@ -0,0 +1,146 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <cmath>
+#include <cstdlib>
+
+#include "ns3/test.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/rng-seed-manager.h"
+#include "ns3/basic-data-calculators.h"
+#include "ns3/replication-runner.h"
+
+using namespace ns3;
+
+/**
+ * A replication drawing ten numbers, uniform in [0, Max], times the
+ * "scale" parameter.
+ * \param parameters the parameters of the point
+ * \param collector the collector of the replication
+ */
+static void
+DrawReplication (const ReplicationRunner::Parameters &parameters, Ptr<DataCollector> collector)
+{
+  double scale = std::atof (parameters.find ("scale")->second.c_str ());
+  Ptr<UniformRandomVariable> random = CreateObject<UniformRandomVariable> ();
+  Ptr<MinMaxAvgTotalCalculator<double> > draws = CreateObject<MinMaxAvgTotalCalculator<double> > ();
+  draws->SetKey ("draw");
+  draws->SetContext ("test");
+  for (uint32_t i = 0; i < 10; i++)
+    {
+      draws->Update (scale * random->GetValue ());
+    }
+  collector->AddDataCalculator (draws);
+}
+
+/**
+ * A replication outputting its run number.
+ * \param parameters the parameters of the point
+ * \param collector the collector of the replication
+ */
+static void
+RunNumberReplication (const ReplicationRunner::Parameters &parameters, Ptr<DataCollector> collector)
+{
+  Ptr<CounterCalculator<uint32_t> > run = CreateObject<CounterCalculator<uint32_t> > ();
+  run->SetKey ("run");
+  run->SetContext ("test");
+  run->Update (RngSeedManager::GetRun ());
+  collector->AddDataCalculator (run);
+}
+
+/**
+ * \brief ReplicationRunner sweeps: the values do not depend on the
+ * number of processes, and the confidence intervals.
+ */
+class ReplicationRunnerTestCase : public TestCase
+{
+public:
+  ReplicationRunnerTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+ReplicationRunnerTestCase::ReplicationRunnerTestCase ()
+  : TestCase ("ReplicationRunner sweeps")
+{
+}
+
+void
+ReplicationRunnerTestCase::DoRun (void)
+{
+  ReplicationRunner serial;
+  serial.SetSweep ("ns3::UniformRandomVariable::Max=1,100;scale=1,2");
+  serial.SetReplications (3);
+  serial.SetJobs (1);
+  serial.SetFilePrefix ("");
+  NS_TEST_ASSERT_MSG_EQ (serial.GetNPoints (), 4, "Wrong number of points");
+  NS_TEST_ASSERT_MSG_EQ (serial.GetPointLabel (1), "ns3::UniformRandomVariable::Max=1,scale=2", "Wrong point");
+  serial.Run (MakeCallback (&DrawReplication));
+  NS_TEST_ASSERT_MSG_EQ (serial.GetNFailures (), 0, "Failed replications");
+
+  ReplicationRunner parallel;
+  parallel.SetSweep ("ns3::UniformRandomVariable::Max=1,100;scale=1,2");
+  parallel.SetReplications (3);
+  parallel.SetJobs (3);
+  parallel.SetFilePrefix ("");
+  parallel.Run (MakeCallback (&DrawReplication));
+  NS_TEST_ASSERT_MSG_EQ (parallel.GetNFailures (), 0, "Failed replications");
+
+  for (uint32_t point = 0; point < 4; point++)
+    {
+      NS_TEST_EXPECT_MSG_EQ (serial.GetCount (point, "test", "draw-mean"), 3, "Missing replications");
+      double max = (point < 2 ? 1 : 100) * (point % 2 ? 2 : 1);
+      for (uint32_t r = 0; r < 3; r++)
+        {
+          double value = serial.GetValue (point, r, "test", "draw-max");
+          NS_TEST_EXPECT_MSG_EQ (value, parallel.GetValue (point, r, "test", "draw-max"),
+                                 "Replication " << r << " of point " << point << " not deterministic");
+          NS_TEST_EXPECT_MSG_EQ ((value > 0 && value <= max), true, "Parameter not applied");
+        }
+      NS_TEST_EXPECT_MSG_NE (serial.GetValue (point, 0, "test", "draw-mean"),
+                             serial.GetValue (point, 1, "test", "draw-mean"), "Same run number");
+    }
+  // the replications of a point use the same run numbers at every point
+  NS_TEST_EXPECT_MSG_EQ_TOL (serial.GetValue (1, 2, "test", "draw-mean"),
+                             2 * serial.GetValue (0, 2, "test", "draw-mean"), 1e-12, "Different run");
+
+  ReplicationRunner runs;
+  runs.SetReplications (4);
+  runs.SetRunBase (1);
+  runs.SetJobs (2);
+  runs.SetFilePrefix ("");
+  runs.Run (MakeCallback (&RunNumberReplication));
+  NS_TEST_ASSERT_MSG_EQ (runs.GetNPoints (), 1, "Wrong number of points");
+  NS_TEST_EXPECT_MSG_EQ (runs.GetCount (0, "test", "run"), 4, "Missing replications");
+  NS_TEST_EXPECT_MSG_EQ_TOL (runs.GetMean (0, "test", "run"), 2.5, 1e-12, "Wrong mean");
+  // t(0.975, 3) * sqrt (5 / 3) / sqrt (4)
+  NS_TEST_EXPECT_MSG_EQ_TOL (runs.GetHalfWidth (0, "test", "run"), 3.182 * std::sqrt (5.0 / 3) / 2, 1e-9,
+                             "Wrong confidence interval");
+  NS_TEST_EXPECT_MSG_EQ (std::isnan (runs.GetMean (0, "test", "missing")), true, "Unexpected value");
+}
+
+//-----------------------------------------------------------------------------
+class ReplicationRunnerTestSuite : public TestSuite
+{
+public:
+  ReplicationRunnerTestSuite () : TestSuite ("replication-runner", UNIT)
+  {
+    AddTestCase (new ReplicationRunnerTestCase (), TestCase::QUICK);
+  }
+};
+
+static ReplicationRunnerTestSuite g_replicationRunnerTestSuite;
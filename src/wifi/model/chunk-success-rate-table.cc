@@ -0,0 +1,99 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <cmath>
+#include <algorithm>
+#include "chunk-success-rate-table.h"
+#include "ns3/assert.h"
+
+namespace ns3 {
+
+/// The lowest ratio of the grid, in dB
+static const double MIN_DB = -10.0;
+/// The step of the grid, in dB
+static const double STEP_DB = 0.01;
+/// The number of points of the grid, up to 40 dB
+static const uint32_t N_POINTS = 5001;
+/**
+ * The bounds of ln (-ln (1 - pe)): below, the success rate of any chunk
+ * is 1, and MAX_LOG_LOG marks the points where pe is above 0.1.
+ */
+static const double MIN_LOG_LOG = -700.0;
+static const double MAX_LOG_LOG = 6.5;
+
+ChunkSuccessRateTable::ChunkSuccessRateTable ()
+{
+}
+
+uint32_t
+ChunkSuccessRateTable::GetNPoints (void)
+{
+  return N_POINTS;
+}
+
+double
+ChunkSuccessRateTable::GetRatio (uint32_t i)
+{
+  return std::pow (10.0, (MIN_DB + i * STEP_DB) / 10.0);
+}
+
+bool
+ChunkSuccessRateTable::IsEmpty (void) const
+{
+  return m_logLogs.empty ();
+}
+
+void
+ChunkSuccessRateTable::Add (double pe)
+{
+  NS_ASSERT (m_logLogs.size () < N_POINTS);
+  double logLog;
+  if (pe <= 0)
+    {
+      logLog = MIN_LOG_LOG;
+    }
+  else if (pe > 0.1)
+    {
+      // near pe = 1, ln (-ln (1 - pe)) is far from linear
+      logLog = MAX_LOG_LOG;
+    }
+  else
+    {
+      logLog = std::max (MIN_LOG_LOG, std::log (-log1p (-pe)));
+    }
+  m_logLogs.push_back (logLog);
+}
+
+bool
+ChunkSuccessRateTable::GetSuccessRate (double ratio, uint32_t nbits, double &rate) const
+{
+  NS_ASSERT (m_logLogs.size () == N_POINTS);
+  double position = (10.0 * std::log10 (ratio) - MIN_DB) / STEP_DB;
+  if (!(position >= 0 && position < N_POINTS - 1))
+    {
+      return false;
+    }
+  uint32_t i = static_cast<uint32_t> (position);
+  if (m_logLogs[i] >= MAX_LOG_LOG || m_logLogs[i + 1] >= MAX_LOG_LOG)
+    {
+      return false;
+    }
+  double logLog = m_logLogs[i] + (position - i) * (m_logLogs[i + 1] - m_logLogs[i]);
+  rate = std::exp (-(double)nbits * std::exp (logLog));
+  return true;
+}
+
+} //namespace ns3
@@ -135,6 +135,7 @@ InterferenceHelper::NiChange::operator < (const InterferenceHelper::NiChange& o)
 
 InterferenceHelper::InterferenceHelper ()
   : m_errorRateModel (0),
+    m_niStart (0),
     m_firstPower (0.0),
     m_rxing (false)
 {
@@ -194,7 +195,7 @@ InterferenceHelper::GetEnergyDuration (double energyW)
   double noiseInterferenceW = 0.0;
   Time end = now;
   noiseInterferenceW = m_firstPower;
-  for (NiChanges::const_iterator i = m_niChanges.begin (); i != m_niChanges.end (); i++)
+  for (NiChanges::const_iterator i = m_niChanges.begin () + m_niStart; i != m_niChanges.end (); i++)
     {
       noiseInterferenceW += i->GetDelta ();
       end = i->GetTime ();
@@ -217,12 +218,25 @@ InterferenceHelper::AppendEvent (Ptr<InterferenceHelper::Event> event)
   if (!m_rxing)
     {
       NiChanges::iterator nowIterator = GetPosition (now);
-      for (NiChanges::iterator i = m_niChanges.begin (); i != nowIterator; i++)
+      for (NiChanges::iterator i = m_niChanges.begin () + m_niStart; i != nowIterator; i++)
         {
           m_firstPower += i->GetDelta ();
         }
-      m_niChanges.erase (m_niChanges.begin (), nowIterator);
-      m_niChanges.insert (m_niChanges.begin (), NiChange (event->GetStartTime (), event->GetRxPowerW ()));
+      m_niStart = nowIterator - m_niChanges.begin ();
+      if (m_niStart == 0)
+        {
+          m_niChanges.insert (m_niChanges.begin (), NiChange (event->GetStartTime (), event->GetRxPowerW ()));
+        }
+      else
+        {
+          if (m_niStart > m_niChanges.size () / 2)
+            {
+              m_niChanges.erase (m_niChanges.begin (), nowIterator - 1);
+              m_niStart = 1;
+            }
+          m_niStart--;
+          m_niChanges[m_niStart] = NiChange (event->GetStartTime (), event->GetRxPowerW ());
+        }
     }
   else
     {
@@ -253,7 +267,8 @@ InterferenceHelper::CalculateNoiseInterferenceW (Ptr<InterferenceHelper::Event>
 {
   double noiseInterference = m_firstPower;
   NS_ASSERT (m_rxing);
-  for (NiChanges::const_iterator i = m_niChanges.begin () + 1; i != m_niChanges.end (); i++)
+  ni->push_back (NiChange (event->GetStartTime (), noiseInterference));
+  for (NiChanges::const_iterator i = m_niChanges.begin () + m_niStart + 1; i != m_niChanges.end (); i++)
     {
       if ((event->GetEndTime () == i->GetTime ()) && event->GetRxPowerW () == -i->GetDelta ())
         {
@@ -261,7 +276,6 @@ InterferenceHelper::CalculateNoiseInterferenceW (Ptr<InterferenceHelper::Event>
         }
       ni->push_back (*i);
     }
-  ni->insert (ni->begin (), NiChange (event->GetStartTime (), noiseInterference));
   ni->push_back (NiChange (event->GetEndTime (), 0));
   return noiseInterference;
 }
@@ -788,8 +802,8 @@ InterferenceHelper::CalculatePlcpHeaderPer (Ptr<const InterferenceHelper::Event>
 struct InterferenceHelper::SnrPer
 InterferenceHelper::CalculatePlcpPayloadSnrPer (Ptr<InterferenceHelper::Event> event)
 {
-  NiChanges ni;
-  double noiseInterferenceW = CalculateNoiseInterferenceW (event, &ni);
+  m_chunkChanges.clear ();
+  double noiseInterferenceW = CalculateNoiseInterferenceW (event, &m_chunkChanges);
   double snr = CalculateSnr (event->GetRxPowerW (),
                              noiseInterferenceW,
                              event->GetTxVector ().GetChannelWidth ());
@@ -797,7 +811,7 @@ InterferenceHelper::CalculatePlcpPayloadSnrPer (Ptr<InterferenceHelper::Event> e
   /* calculate the SNIR at the start of the packet and accumulate
    * all SNIR changes in the snir vector.
    */
-  double per = CalculatePlcpPayloadPer (event, &ni);
+  double per = CalculatePlcpPayloadPer (event, &m_chunkChanges);
 
   struct SnrPer snrPer;
   snrPer.snr = snr;
@@ -808,8 +822,8 @@ InterferenceHelper::CalculatePlcpPayloadSnrPer (Ptr<InterferenceHelper::Event> e
 struct InterferenceHelper::SnrPer
 InterferenceHelper::CalculatePlcpHeaderSnrPer (Ptr<InterferenceHelper::Event> event)
 {
-  NiChanges ni;
-  double noiseInterferenceW = CalculateNoiseInterferenceW (event, &ni);
+  m_chunkChanges.clear ();
+  double noiseInterferenceW = CalculateNoiseInterferenceW (event, &m_chunkChanges);
   double snr = CalculateSnr (event->GetRxPowerW (),
                              noiseInterferenceW,
                              event->GetTxVector ().GetChannelWidth ());
@@ -817,7 +831,7 @@ InterferenceHelper::CalculatePlcpHeaderSnrPer (Ptr<InterferenceHelper::Event> ev
   /* calculate the SNIR at the start of the plcp header and accumulate
    * all SNIR changes in the snir vector.
    */
-  double per = CalculatePlcpHeaderPer (event, &ni);
+  double per = CalculatePlcpHeaderPer (event, &m_chunkChanges);
 
   struct SnrPer snrPer;
   snrPer.snr = snr;
@@ -829,6 +843,7 @@ void
 InterferenceHelper::EraseEvents (void)
 {
   m_niChanges.clear ();
+  m_niStart = 0;
   m_rxing = false;
   m_firstPower = 0.0;
 }
@@ -836,7 +851,7 @@ InterferenceHelper::EraseEvents (void)
 InterferenceHelper::NiChanges::iterator
 InterferenceHelper::GetPosition (Time moment)
 {
-  return std::upper_bound (m_niChanges.begin (), m_niChanges.end (), NiChange (moment, 0));
+  return std::upper_bound (m_niChanges.begin () + m_niStart, m_niChanges.end (), NiChange (moment, 0));
 }
 
 void
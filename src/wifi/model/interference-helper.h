@@ -23,7 +23,6 @@
 
 #include <stdint.h>
 #include <vector>
-#include <list>
 #include "wifi-mode.h"
 #include "wifi-preamble.h"
 #include "wifi-phy-standard.h"
@@ -259,10 +258,6 @@ private:
    * typedef for a vector of NiChanges
    */
   typedef std::vector <NiChange> NiChanges;
-  /**
-   * typedef for a list of Events
-   */
-  typedef std::list<Ptr<Event> > Events;
 
   /**
    * Append the given Event.
@@ -325,8 +320,17 @@ private:
 
   double m_noiseFigure; /**< noise figure (linear) */
   Ptr<ErrorRateModel> m_errorRateModel;
-  /// Experimental: needed for energy duration calculation
+  /**
+   * Experimental: needed for energy duration calculation.
+   *
+   * The changes before m_niStart are in the past and already summed in
+   * m_firstPower: they are only erased once they are half of the vector,
+   * and the change starting a new reception takes the place of the last
+   * one, so that the vector is not shifted at each new signal.
+   */
   NiChanges m_niChanges;
+  uint32_t m_niStart; //!< index of the first change of m_niChanges not in m_firstPower
+  NiChanges m_chunkChanges; //!< changes during the event whose PER is computed
   double m_firstPower;
   bool m_rxing;
   /// Returns an iterator to the first nichange, which is later than moment
@@ -20,9 +20,11 @@
  */
 
 #include <cmath>
+#include <map>
 #include "nist-error-rate-model.h"
 #include "wifi-phy.h"
 #include "ns3/log.h"
+#include "ns3/boolean.h"
 
 namespace ns3 {
 
@@ -30,6 +32,19 @@ NS_LOG_COMPONENT_DEFINE ("NistErrorRateModel");
 
 NS_OBJECT_ENSURE_REGISTERED (NistErrorRateModel);
 
+/// The chunk success rate tables, by constellation size and b value
+typedef std::map<uint32_t, ChunkSuccessRateTable> Tables;
+
+/**
+ * \returns the tables of the models, which only depend on the scheme
+ */
+static Tables &
+GetTables (void)
+{
+  static Tables tables;
+  return tables;
+}
+
 TypeId
 NistErrorRateModel::GetTypeId (void)
 {
@@ -37,11 +52,18 @@ NistErrorRateModel::GetTypeId (void)
     .SetParent<ErrorRateModel> ()
     .SetGroupName ("Wifi")
     .AddConstructor<NistErrorRateModel> ()
+    .AddAttribute ("UseLookupTable",
+                   "Interpolate the OFDM chunk success rates in precomputed tables, "
+                   "instead of computing them for each chunk.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&NistErrorRateModel::m_useLookupTable),
+                   MakeBooleanChecker ())
   ;
   return tid;
 }
 
 NistErrorRateModel::NistErrorRateModel ()
+  : m_useLookupTable (false)
 {
 }
 
@@ -99,6 +121,15 @@ NistErrorRateModel::GetFecBpskBer (double snr, uint32_t nbits,
                                    uint32_t bValue) const
 {
   NS_LOG_FUNCTION (this << snr << nbits << bValue);
+  if (m_useLookupTable)
+    {
+      const ChunkSuccessRateTable &table = GetTable (2, bValue);
+      double rate;
+      if (table.GetSuccessRate (snr, nbits, rate))
+        {
+          return rate;
+        }
+    }
   double ber = GetBpskBer (snr);
   if (ber == 0.0)
     {
@@ -115,6 +146,15 @@ NistErrorRateModel::GetFecQpskBer (double snr, uint32_t nbits,
                                    uint32_t bValue) const
 {
   NS_LOG_FUNCTION (this << snr << nbits << bValue);
+  if (m_useLookupTable)
+    {
+      const ChunkSuccessRateTable &table = GetTable (4, bValue);
+      double rate;
+      if (table.GetSuccessRate (snr, nbits, rate))
+        {
+          return rate;
+        }
+    }
   double ber = GetQpskBer (snr);
   if (ber == 0.0)
     {
@@ -203,6 +243,15 @@ NistErrorRateModel::GetFec16QamBer (double snr, uint32_t nbits,
                                     uint32_t bValue) const
 {
   NS_LOG_FUNCTION (this << snr << nbits << bValue);
+  if (m_useLookupTable)
+    {
+      const ChunkSuccessRateTable &table = GetTable (16, bValue);
+      double rate;
+      if (table.GetSuccessRate (snr, nbits, rate))
+        {
+          return rate;
+        }
+    }
   double ber = Get16QamBer (snr);
   if (ber == 0.0)
     {
@@ -219,6 +268,15 @@ NistErrorRateModel::GetFec64QamBer (double snr, uint32_t nbits,
                                     uint32_t bValue) const
 {
   NS_LOG_FUNCTION (this << snr << nbits << bValue);
+  if (m_useLookupTable)
+    {
+      const ChunkSuccessRateTable &table = GetTable (64, bValue);
+      double rate;
+      if (table.GetSuccessRate (snr, nbits, rate))
+        {
+          return rate;
+        }
+    }
   double ber = Get64QamBer (snr);
   if (ber == 0.0)
     {
@@ -235,6 +293,15 @@ NistErrorRateModel::GetFec256QamBer (double snr, uint32_t nbits,
                                      uint32_t bValue) const
 {
   NS_LOG_FUNCTION (this << snr << nbits << bValue);
+  if (m_useLookupTable)
+    {
+      const ChunkSuccessRateTable &table = GetTable (256, bValue);
+      double rate;
+      if (table.GetSuccessRate (snr, nbits, rate))
+        {
+          return rate;
+        }
+    }
   double ber = Get256QamBer (snr);
   if (ber == 0.0)
     {
@@ -246,6 +313,50 @@ NistErrorRateModel::GetFec256QamBer (double snr, uint32_t nbits,
   return pms;
 }
 
+double
+NistErrorRateModel::GetFecBer (uint32_t constellation, double snr, uint32_t bValue) const
+{
+  double ber;
+  switch (constellation)
+    {
+    case 2:
+      ber = GetBpskBer (snr);
+      break;
+    case 4:
+      ber = GetQpskBer (snr);
+      break;
+    case 16:
+      ber = Get16QamBer (snr);
+      break;
+    case 64:
+      ber = Get64QamBer (snr);
+      break;
+    default:
+      NS_ASSERT (constellation == 256);
+      ber = Get256QamBer (snr);
+      break;
+    }
+  if (ber == 0.0)
+    {
+      return 0.0;
+    }
+  return std::min (CalculatePe (ber, bValue), 1.0);
+}
+
+const ChunkSuccessRateTable &
+NistErrorRateModel::GetTable (uint32_t constellation, uint32_t bValue) const
+{
+  ChunkSuccessRateTable &table = GetTables ()[constellation * 8 + bValue];
+  if (table.IsEmpty ())
+    {
+      for (uint32_t i = 0; i < ChunkSuccessRateTable::GetNPoints (); i++)
+        {
+          table.Add (GetFecBer (constellation, ChunkSuccessRateTable::GetRatio (i), bValue));
+        }
+    }
+  return table;
+}
+
 double
 NistErrorRateModel::GetChunkSuccessRate (WifiMode mode, WifiTxVector txVector, double snr, uint32_t nbits) const
 {
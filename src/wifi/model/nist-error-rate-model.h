@@ -25,6 +25,7 @@
 #include "wifi-mode.h"
 #include "error-rate-model.h"
 #include "dsss-error-rate-model.h"
+#include "chunk-success-rate-table.h"
 
 namespace ns3 {
 
@@ -35,6 +36,10 @@ namespace ns3 {
  * the model description and validation can be found in
  * http://www.nsnam.org/~pei/80211ofdm.pdf.  For DSSS modulations (802.11b),
  * the model uses the DsssErrorRateModel.
+ *
+ * If the UseLookupTable attribute is set, the OFDM success rates are
+ * interpolated in a ChunkSuccessRateTable of each modulation and coding
+ * scheme, computed when it is first used.
  */
 class NistErrorRateModel : public ErrorRateModel
 {
@@ -149,6 +154,22 @@ private:
    */
   double GetFec256QamBer (double snr, uint32_t nbits,
                           uint32_t bValue) const;
+  /**
+   * \param constellation the size of the constellation
+   * \param snr the signal to noise ratio
+   * \param bValue the b value of the code rate
+   * \returns the bit error rate after decoding
+   */
+  double GetFecBer (uint32_t constellation, double snr, uint32_t bValue) const;
+  /**
+   * \param constellation the size of the constellation
+   * \param bValue the b value of the code rate
+   * \returns the table of the scheme, computed on first use and shared by
+   * all the models
+   */
+  const ChunkSuccessRateTable & GetTable (uint32_t constellation, uint32_t bValue) const;
+
+  bool m_useLookupTable; //!< whether the success rates are interpolated in tables
 };
 
 } //namespace ns3
@@ -26,6 +26,7 @@
 #include "ns3/string.h"
 #include "ns3/pointer.h"
 #include "ns3/boolean.h"
+#include "ns3/double.h"
 #include "ns3/trace-source-accessor.h"
 #include "qos-tag.h"
 #include "mac-low.h"
@@ -54,6 +55,10 @@
                   \    -----------------------
                    \-> | Wait Probe Response |
                        -----------------------
+ *
+ * With the candidate cache, the STA goes from Beacon Missed straight to
+ * Wait Association Response with the strongest cached AP, and it also
+ * goes there from Associated when it roams to a stronger AP.
  */
 
 namespace ns3 {
@@ -92,12 +97,41 @@ StaWifiMac::GetTypeId (void)
                    BooleanValue (false),
                    MakeBooleanAccessor (&StaWifiMac::SetActiveProbing, &StaWifiMac::GetActiveProbing),
                    MakeBooleanChecker ())
+    .AddAttribute ("CandidateCache",
+                   "If true, the APs heard in beacons and probe responses are cached, and "
+                   "the STA reassociates at once with the strongest of them when it loses "
+                   "its AP, or when the signal of its AP falls below RoamingThreshold.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&StaWifiMac::SetCandidateCache, &StaWifiMac::GetCandidateCache),
+                   MakeBooleanChecker ())
+    .AddAttribute ("CandidateLifetime",
+                   "How long an AP stays in the cache after its last beacon or probe response.",
+                   TimeValue (Seconds (1.0)),
+                   MakeTimeAccessor (&StaWifiMac::m_candidateLifetime),
+                   MakeTimeChecker ())
+    .AddAttribute ("RoamingThreshold",
+                   "The signal of the AP (dBm) below which the STA roams to a stronger "
+                   "cached AP before losing its AP.",
+                   DoubleValue (-75.0),
+                   MakeDoubleAccessor (&StaWifiMac::m_roamingThreshold),
+                   MakeDoubleChecker<double> ())
+    .AddAttribute ("RoamingHysteresis",
+                   "How much stronger (dB) than the AP a cached AP must be for the STA to roam to it.",
+                   DoubleValue (5.0),
+                   MakeDoubleAccessor (&StaWifiMac::m_roamingHysteresis),
+                   MakeDoubleChecker<double> (0.0))
     .AddTraceSource ("Assoc", "Associated with an access point.",
                      MakeTraceSourceAccessor (&StaWifiMac::m_assocLogger),
                      "ns3::Mac48Address::TracedCallback")
     .AddTraceSource ("DeAssoc", "Association with an access point lost.",
                      MakeTraceSourceAccessor (&StaWifiMac::m_deAssocLogger),
                      "ns3::Mac48Address::TracedCallback")
+    .AddTraceSource ("Handoff",
+                     "Associated again after losing or leaving an access point. "
+                     "The latency is counted from the last beacon of the old access point, "
+                     "or from the time the station left it to roam.",
+                     MakeTraceSourceAccessor (&StaWifiMac::m_handoffLogger),
+                     "ns3::StaWifiMac::HandoffTracedCallback")
   ;
   return tid;
 }
@@ -106,7 +140,11 @@ StaWifiMac::StaWifiMac ()
   : m_state (BEACON_MISSED),
     m_probeRequestEvent (),
     m_assocRequestEvent (),
-    m_beaconWatchdogEnd (Seconds (0.0))
+    m_beaconWatchdogEnd (Seconds (0.0)),
+    m_candidateCache (false),
+    m_rxSignal (0.0),
+    m_rxChannel (0),
+    m_handoff (false)
 {
   NS_LOG_FUNCTION (this);
 
@@ -148,6 +186,28 @@ StaWifiMac::StartActiveAssociation (void)
   TryToEnsureAssociated ();
 }
 
+void
+StaWifiMac::SetWifiPhy (Ptr<WifiPhy> phy)
+{
+  NS_LOG_FUNCTION (this << phy);
+  RegularWifiMac::SetWifiPhy (phy);
+  if (m_candidateCache)
+    {
+      phy->TraceConnectWithoutContext ("MonitorSnifferRx", MakeCallback (&StaWifiMac::PhyRxSniffer, this));
+    }
+}
+
+void
+StaWifiMac::ResetWifiPhy (void)
+{
+  NS_LOG_FUNCTION (this);
+  if (m_candidateCache)
+    {
+      m_phy->TraceDisconnectWithoutContext ("MonitorSnifferRx", MakeCallback (&StaWifiMac::PhyRxSniffer, this));
+    }
+  RegularWifiMac::ResetWifiPhy ();
+}
+
 void
 StaWifiMac::SetActiveProbing (bool enable)
 {
@@ -168,6 +228,38 @@ bool StaWifiMac::GetActiveProbing (void) const
   return m_activeProbing;
 }
 
+void
+StaWifiMac::SetCandidateCache (bool enable)
+{
+  NS_LOG_FUNCTION (this << enable);
+  if (enable == m_candidateCache)
+    {
+      return;
+    }
+  if (m_phy != 0)
+    {
+      if (enable)
+        {
+          m_phy->TraceConnectWithoutContext ("MonitorSnifferRx", MakeCallback (&StaWifiMac::PhyRxSniffer, this));
+        }
+      else
+        {
+          m_phy->TraceDisconnectWithoutContext ("MonitorSnifferRx", MakeCallback (&StaWifiMac::PhyRxSniffer, this));
+        }
+    }
+  if (!enable)
+    {
+      m_candidates.clear ();
+    }
+  m_candidateCache = enable;
+}
+
+bool
+StaWifiMac::GetCandidateCache (void) const
+{
+  return m_candidateCache;
+}
+
 void
 StaWifiMac::SendProbeRequest (void)
 {
@@ -266,16 +358,24 @@ StaWifiMac::TryToEnsureAssociated (void)
        */
       break;
     case BEACON_MISSED:
-      /* we were associated but we missed a bunch of beacons
-       * so we should assume we are not associated anymore.
-       * We try to initiate a probe request now.
-       */
-      m_linkDown ();
-      if (m_activeProbing)
-        {
-          SetState (WAIT_PROBE_RESP);
-          SendProbeRequest ();
-        }
+      {
+        /* we were associated but we missed a bunch of beacons
+         * so we should assume we are not associated anymore.
+         * We reassociate with the best cached AP if there is
+         * one, or else try to initiate a probe request now.
+         */
+        m_linkDown ();
+        Mac48Address bssid;
+        if (m_candidateCache && GetBestCandidate (GetBssid (), bssid))
+          {
+            Reassociate (bssid);
+          }
+        else if (m_activeProbing)
+          {
+            SetState (WAIT_PROBE_RESP);
+            SendProbeRequest ();
+          }
+      }
       break;
     case WAIT_ASSOC_RESP:
       /* we have sent an assoc request so we do not need to
@@ -297,6 +397,13 @@ void
 StaWifiMac::AssocRequestTimeout (void)
 {
   NS_LOG_FUNCTION (this);
+  Mac48Address bssid;
+  if (m_candidateCache && GetBestCandidate (Mac48Address (), bssid)
+      && bssid != GetBssid ())
+    {
+      Reassociate (bssid);
+      return;
+    }
   SetState (WAIT_ASSOC_RESP);
   SendAssociationRequest ();
 }
@@ -341,6 +448,88 @@ StaWifiMac::RestartBeaconWatchdog (Time delay)
     }
 }
 
+void
+StaWifiMac::PhyRxSniffer (Ptr<const Packet> packet, uint16_t channelFreqMhz,
+                          uint16_t channelNumber, uint32_t rate, WifiPreamble preamble,
+                          WifiTxVector txVector, struct mpduInfo aMpdu,
+                          struct signalNoiseDbm signalNoise)
+{
+  m_rxSignal = signalNoise.signal;
+  m_rxChannel = channelNumber;
+}
+
+void
+StaWifiMac::UpdateCandidate (Mac48Address bssid)
+{
+  NS_LOG_FUNCTION (this << bssid << m_rxSignal);
+  ApCandidate &candidate = m_candidates[bssid];
+  candidate.signal = m_rxSignal;
+  candidate.channel = m_rxChannel;
+  candidate.lastSeen = Simulator::Now ();
+}
+
+bool
+StaWifiMac::GetBestCandidate (Mac48Address exclude, Mac48Address &bssid)
+{
+  NS_LOG_FUNCTION (this << exclude);
+  Time oldest = Simulator::Now () - m_candidateLifetime;
+  bool found = false;
+  double signal = 0;
+  for (ApCandidates::iterator i = m_candidates.begin (); i != m_candidates.end (); )
+    {
+      if (i->second.lastSeen < oldest)
+        {
+          m_candidates.erase (i++);
+          continue;
+        }
+      if (i->first != exclude && (!found || i->second.signal > signal))
+        {
+          found = true;
+          bssid = i->first;
+          signal = i->second.signal;
+        }
+      i++;
+    }
+  return found;
+}
+
+void
+StaWifiMac::CheckRoaming (void)
+{
+  NS_LOG_FUNCTION (this);
+  ApCandidates::const_iterator current = m_candidates.find (GetBssid ());
+  if (current == m_candidates.end ()
+      || current->second.signal >= m_roamingThreshold)
+    {
+      return;
+    }
+  double signal = current->second.signal;
+  Mac48Address bssid;
+  if (GetBestCandidate (GetBssid (), bssid)
+      && m_candidates[bssid].signal >= signal + m_roamingHysteresis)
+    {
+      NS_LOG_DEBUG ("roaming from " << GetBssid () << " to " << bssid);
+      m_linkDown ();
+      Reassociate (bssid);
+      // the link is lost now, not at the last beacon of the AP
+      m_handoffStart = Simulator::Now ();
+    }
+}
+
+void
+StaWifiMac::Reassociate (Mac48Address bssid)
+{
+  NS_LOG_FUNCTION (this << bssid);
+  uint16_t channel = m_candidates[bssid].channel;
+  if (channel != m_phy->GetChannelNumber ())
+    {
+      m_phy->SetChannelNumber (channel);
+    }
+  SetState (WAIT_ASSOC_RESP);
+  SetBssid (bssid);
+  SendAssociationRequest ();
+}
+
 bool
 StaWifiMac::IsAssociated (void) const
 {
@@ -506,10 +695,18 @@ StaWifiMac::Receive (Ptr<Packet> packet, const WifiMacHeader *hdr)
               goodBeacon = false;
             }
         }
+      if (goodBeacon && m_candidateCache)
+        {
+          UpdateCandidate (hdr->GetAddr3 ());
+        }
       if ((IsWaitAssocResp () || IsAssociated ()) && hdr->GetAddr3 () != GetBssid ())
         {
           goodBeacon = false;
         }
+      if (goodBeacon && IsAssociated ())
+        {
+          m_lastBeacon = Simulator::Now ();
+        }
       if (goodBeacon)
         {
           Time delay = MicroSeconds (beacon.GetBeaconIntervalUs () * m_maxMissedBeacons);
@@ -547,10 +744,23 @@ StaWifiMac::Receive (Ptr<Packet> packet, const WifiMacHeader *hdr)
           SetState (WAIT_ASSOC_RESP);
           SendAssociationRequest ();
         }
+      if (m_candidateCache && IsAssociated ())
+        {
+          CheckRoaming ();
+        }
       return;
     }
   else if (hdr->IsProbeResp ())
     {
+      if (m_candidateCache)
+        {
+          MgtProbeResponseHeader probeResp;
+          packet->PeekHeader (probeResp);
+          if (probeResp.GetSsid ().IsEqual (GetSsid ()))
+            {
+              UpdateCandidate (hdr->GetAddr3 ());
+            }
+        }
       if (m_state == WAIT_PROBE_RESP)
         {
           MgtProbeResponseHeader probeResp;
@@ -795,11 +1005,19 @@ StaWifiMac::SetState (MacState value)
       && m_state != ASSOCIATED)
     {
       m_assocLogger (GetBssid ());
+      if (m_handoff)
+        {
+          m_handoffLogger (m_handoffBssid, GetBssid (), Simulator::Now () - m_handoffStart);
+        }
+      m_lastBeacon = Simulator::Now ();
     }
   else if (value != ASSOCIATED
            && m_state == ASSOCIATED)
     {
       m_deAssocLogger (GetBssid ());
+      m_handoff = true;
+      m_handoffBssid = GetBssid ();
+      m_handoffStart = m_lastBeacon;
     }
   m_state = value;
 }
@@ -29,6 +29,8 @@
 #include "supported-rates.h"
 #include "amsdu-subframe-header.h"
 #include "capability-information.h"
+#include "wifi-phy.h"
+#include <map>
 
 namespace ns3  {
 
@@ -82,6 +84,20 @@ public:
    */
   void StartActiveAssociation (void);
 
+  virtual void SetWifiPhy (Ptr<WifiPhy> phy);
+  virtual void ResetWifiPhy (void);
+
+  /**
+   * TracedCallback signature for handoffs.
+   *
+   * \param [in] oldBssid The BSSID of the AP the STA lost or left.
+   * \param [in] newBssid The BSSID of the AP the STA associated with.
+   * \param [in] latency The time since the last beacon of the old AP,
+   *             or since the STA left it to roam.
+   */
+  typedef void (* HandoffTracedCallback)
+    (Mac48Address oldBssid, Mac48Address newBssid, Time latency);
+
 
 private:
   /**
@@ -96,6 +112,18 @@ private:
     REFUSED
   };
 
+  /**
+   * An AP heard in a beacon or a probe response.
+   */
+  struct ApCandidate
+  {
+    double signal;     //!< The signal of its last frame, in dBm.
+    uint16_t channel;  //!< Its channel number.
+    Time lastSeen;     //!< When its last frame was received.
+  };
+  /// The cached APs, by BSSID.
+  typedef std::map<Mac48Address, ApCandidate> ApCandidates;
+
   /**
    * Enable or disable active probing.
    *
@@ -108,6 +136,19 @@ private:
    * \return true if active probing is enabled, false otherwise
    */
   bool GetActiveProbing (void) const;
+  /**
+   * Enable or disable the cache of the APs heard. The signal of the
+   * frames is only sniffed from the phy while it is enabled.
+   *
+   * \param enable enable or disable the cache
+   */
+  void SetCandidateCache (bool enable);
+  /**
+   * Return whether the cache of the APs heard is enabled.
+   *
+   * \return true if the cache is enabled, false otherwise
+   */
+  bool GetCandidateCache (void) const;
 
   virtual void Receive (Ptr<Packet> packet, const WifiMacHeader *hdr);
 
@@ -165,6 +206,50 @@ private:
    * \return SupportedRates all rates that we support
    */
   SupportedRates GetSupportedRates (void) const;
+  /**
+   * Record the signal of a frame received by the PHY, before it is
+   * forwarded up to Receive.
+   *
+   * \param packet the frame
+   * \param channelFreqMhz the frequency of the channel
+   * \param channelNumber the channel number
+   * \param rate the data rate
+   * \param preamble the preamble
+   * \param txVector the TXVECTOR of the frame
+   * \param aMpdu the A-MPDU information
+   * \param signalNoise the signal and noise levels
+   */
+  void PhyRxSniffer (Ptr<const Packet> packet, uint16_t channelFreqMhz,
+                     uint16_t channelNumber, uint32_t rate, WifiPreamble preamble,
+                     WifiTxVector txVector, struct mpduInfo aMpdu,
+                     struct signalNoiseDbm signalNoise);
+  /**
+   * Cache the AP which sent the frame being received.
+   *
+   * \param bssid the BSSID of the AP
+   */
+  void UpdateCandidate (Mac48Address bssid);
+  /**
+   * Find the AP with the strongest signal among those heard recently.
+   * The APs which were not heard for CandidateLifetime are removed.
+   *
+   * \param exclude an AP which is not a candidate
+   * \param bssid the BSSID of the best AP
+   * \return true if an AP was found, false otherwise
+   */
+  bool GetBestCandidate (Mac48Address exclude, Mac48Address &bssid);
+  /**
+   * Roam to a cached AP if the signal of the AP has fallen below
+   * RoamingThreshold and the cached AP is RoamingHysteresis stronger.
+   */
+  void CheckRoaming (void);
+  /**
+   * Send an association request to a cached AP, switching to its
+   * channel if needed.
+   *
+   * \param bssid the BSSID of the AP
+   */
+  void Reassociate (Mac48Address bssid);
   /**
    * Set the current MAC state.
    *
@@ -187,9 +272,21 @@ private:
   Time m_beaconWatchdogEnd;
   uint32_t m_maxMissedBeacons;
   bool m_activeProbing;
+  bool m_candidateCache;
+  Time m_candidateLifetime;
+  double m_roamingThreshold;
+  double m_roamingHysteresis;
+  ApCandidates m_candidates;
+  double m_rxSignal;           //!< The signal of the last frame received, in dBm.
+  uint16_t m_rxChannel;        //!< The channel of the last frame received.
+  Time m_lastBeacon;           //!< When the last beacon of the AP was received.
+  bool m_handoff;              //!< Whether the STA lost or left an AP.
+  Mac48Address m_handoffBssid; //!< The AP it lost or left.
+  Time m_handoffStart;         //!< When the link with that AP was lost.
 
   TracedCallback<Mac48Address> m_assocLogger;
   TracedCallback<Mac48Address> m_deAssocLogger;
+  TracedCallback<Mac48Address, Mac48Address, Time> m_handoffLogger;
 };
 
 } //namespace ns3
@@ -20,9 +20,11 @@
  */
 
 #include <cmath>
+#include <map>
 #include "yans-error-rate-model.h"
 #include "wifi-phy.h"
 #include "ns3/log.h"
+#include "ns3/boolean.h"
 
 namespace ns3 {
 
@@ -30,6 +32,19 @@ NS_LOG_COMPONENT_DEFINE ("YansErrorRateModel");
 
 NS_OBJECT_ENSURE_REGISTERED (YansErrorRateModel);
 
+/// The chunk success rate tables, by constellation size and code
+typedef std::map<uint32_t, ChunkSuccessRateTable> Tables;
+
+/**
+ * \returns the tables of the models, which only depend on the scheme
+ */
+static Tables &
+GetTables (void)
+{
+  static Tables tables;
+  return tables;
+}
+
 TypeId
 YansErrorRateModel::GetTypeId (void)
 {
@@ -37,11 +52,18 @@ YansErrorRateModel::GetTypeId (void)
     .SetParent<ErrorRateModel> ()
     .SetGroupName ("Wifi")
     .AddConstructor<YansErrorRateModel> ()
+    .AddAttribute ("UseLookupTable",
+                   "Interpolate the OFDM chunk success rates in precomputed tables, "
+                   "instead of computing them for each chunk.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&YansErrorRateModel::m_useLookupTable),
+                   MakeBooleanChecker ())
   ;
   return tid;
 }
 
 YansErrorRateModel::YansErrorRateModel ()
+  : m_useLookupTable (false)
 {
 }
 
@@ -148,6 +170,16 @@ YansErrorRateModel::GetFecBpskBer (double snr, double nbits,
                                    uint32_t dFree, uint32_t adFree) const
 {
   NS_LOG_FUNCTION (this << snr << nbits << signalSpread << phyRate << dFree << adFree);
+  if (m_useLookupTable)
+    {
+      double ebNo = snr * signalSpread / phyRate;
+      const ChunkSuccessRateTable &table = GetTable (2, dFree, adFree, 0);
+      double rate;
+      if (table.GetSuccessRate (ebNo, static_cast<uint32_t> (nbits), rate))
+        {
+          return rate;
+        }
+    }
   double ber = GetBpskBer (snr, signalSpread, phyRate);
   if (ber == 0.0)
     {
@@ -168,6 +200,16 @@ YansErrorRateModel::GetFecQamBer (double snr, uint32_t nbits,
                                   uint32_t adFree, uint32_t adFreePlusOne) const
 {
   NS_LOG_FUNCTION (this << snr << nbits << signalSpread << phyRate << m << dFree << adFree << adFreePlusOne);
+  if (m_useLookupTable)
+    {
+      double ebNo = snr * signalSpread / phyRate;
+      const ChunkSuccessRateTable &table = GetTable (m, dFree, adFree, adFreePlusOne);
+      double rate;
+      if (table.GetSuccessRate (ebNo, nbits, rate))
+        {
+          return rate;
+        }
+    }
   double ber = GetQamBer (snr, m, signalSpread, phyRate);
   if (ber == 0.0)
     {
@@ -184,6 +226,48 @@ YansErrorRateModel::GetFecQamBer (double snr, uint32_t nbits,
   return pms;
 }
 
+double
+YansErrorRateModel::GetFecBer (double ebNo, uint32_t m, uint32_t dFree,
+                               uint32_t adFree, uint32_t adFreePlusOne) const
+{
+  double ber;
+  double pmu;
+  if (m == 2)
+    {
+      ber = GetBpskBer (ebNo, 1, 1);
+      if (ber == 0.0)
+        {
+          return 0.0;
+        }
+      pmu = adFree * CalculatePd (ber, dFree);
+    }
+  else
+    {
+      ber = GetQamBer (ebNo, m, 1, 1);
+      if (ber == 0.0)
+        {
+          return 0.0;
+        }
+      pmu = adFree * CalculatePd (ber, dFree);
+      pmu += adFreePlusOne * CalculatePd (ber, dFree + 1);
+    }
+  return std::min (pmu, 1.0);
+}
+
+const ChunkSuccessRateTable &
+YansErrorRateModel::GetTable (uint32_t m, uint32_t dFree, uint32_t adFree, uint32_t adFreePlusOne) const
+{
+  ChunkSuccessRateTable &table = GetTables ()[((m * 16 + dFree) * 32 + adFree) * 128 + adFreePlusOne];
+  if (table.IsEmpty ())
+    {
+      for (uint32_t i = 0; i < ChunkSuccessRateTable::GetNPoints (); i++)
+        {
+          table.Add (GetFecBer (ChunkSuccessRateTable::GetRatio (i), m, dFree, adFree, adFreePlusOne));
+        }
+    }
+  return table;
+}
+
 double
 YansErrorRateModel::GetChunkSuccessRate (WifiMode mode, WifiTxVector txVector, double snr, uint32_t nbits) const
 {
@@ -25,6 +25,7 @@
 #include "wifi-mode.h"
 #include "error-rate-model.h"
 #include "dsss-error-rate-model.h"
+#include "chunk-success-rate-table.h"
 
 namespace ns3 {
 
@@ -52,6 +53,11 @@ namespace ns3 {
  *      57(2):440-449, February 2009.
  *    - More detailed description and validation can be found in
  *      http://www.nsnam.org/~pei/80211b.pdf
+ *
+ * If the UseLookupTable attribute is set, the OFDM success rates are
+ * interpolated in a ChunkSuccessRateTable of each modulation and code,
+ * indexed by Eb/No, so that the tables do not depend on the channel
+ * width nor on the rate. A table is computed when it is first used.
  */
 class YansErrorRateModel : public ErrorRateModel
 {
@@ -162,6 +168,30 @@ private:
                        uint32_t phyRate,
                        uint32_t m, uint32_t dfree,
                        uint32_t adFree, uint32_t adFreePlusOne) const;
+  /**
+   * \param ebNo Eb/No ratio (not dB)
+   * \param m the size of the constellation
+   * \param dFree
+   * \param adFree
+   * \param adFreePlusOne
+   *
+   * \return the bit error rate after decoding
+   */
+  double GetFecBer (double ebNo, uint32_t m, uint32_t dFree,
+                    uint32_t adFree, uint32_t adFreePlusOne) const;
+  /**
+   * \param m the size of the constellation
+   * \param dFree
+   * \param adFree
+   * \param adFreePlusOne
+   *
+   * \return the table of the code, computed on first use and shared by
+   * all the models
+   */
+  const ChunkSuccessRateTable & GetTable (uint32_t m, uint32_t dFree,
+                                          uint32_t adFree, uint32_t adFreePlusOne) const;
+
+  bool m_useLookupTable; //!< whether the success rates are interpolated in tables
 };
 
 } //namespace ns3
@@ -18,6 +18,7 @@
  * Author: Mathieu Lacage, <mathieu.lacage@sophia.inria.fr>
  */
 
+#include <algorithm>
 #include "ns3/packet.h"
 #include "ns3/simulator.h"
 #include "ns3/mobility-model.h"
@@ -25,6 +26,8 @@
 #include "ns3/node.h"
 #include "ns3/log.h"
 #include "ns3/pointer.h"
+#include "ns3/double.h"
+#include "ns3/boolean.h"
 #include "ns3/object-factory.h"
 #include "yans-wifi-channel.h"
 #include "ns3/propagation-loss-model.h"
@@ -51,17 +54,34 @@ YansWifiChannel::GetTypeId (void)
                    PointerValue (),
                    MakePointerAccessor (&YansWifiChannel::m_delay),
                    MakePointerChecker<PropagationDelayModel> ())
+    .AddAttribute ("MaxRange",
+                   "The distance, in meters, beyond which packets are not delivered, "
+                   "or 0 to deliver them to all the PHYs of the channel.",
+                   DoubleValue (0),
+                   MakeDoubleAccessor (&YansWifiChannel::m_maxRange),
+                   MakeDoubleChecker<double> (0))
+    .AddAttribute ("PropagationMatrix",
+                   "If true, the propagation loss and delay between two PHYs are computed once, "
+                   "and again only when one of them moves. The loss of random loss models, "
+                   "or of loss models depending on the transmit power, is still computed each time.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&YansWifiChannel::m_propagationMatrix),
+                   MakeBooleanChecker ())
   ;
   return tid;
 }
 
 YansWifiChannel::YansWifiChannel ()
+  : m_maxRange (0),
+    m_propagationMatrix (false)
 {
 }
 
 YansWifiChannel::~YansWifiChannel ()
 {
   NS_LOG_FUNCTION_NOARGS ();
+  m_index.Clear ();
+  m_matrix.Clear ();
   m_phyList.clear ();
 }
 
@@ -69,12 +89,14 @@ void
 YansWifiChannel::SetPropagationLossModel (Ptr<PropagationLossModel> loss)
 {
   m_loss = loss;
+  m_matrix.SetLossModel (loss);
 }
 
 void
 YansWifiChannel::SetPropagationDelayModel (Ptr<PropagationDelayModel> delay)
 {
   m_delay = delay;
+  m_matrix.SetDelayModel (delay);
 }
 
 void
@@ -83,24 +105,68 @@ YansWifiChannel::Send (Ptr<YansWifiPhy> sender, Ptr<const Packet> packet, double
 {
   Ptr<MobilityModel> senderMobility = sender->GetMobility ()->GetObject<MobilityModel> ();
   NS_ASSERT (senderMobility != 0);
-  uint32_t j = 0;
-  for (PhyList::const_iterator i = m_phyList.begin (); i != m_phyList.end (); i++, j++)
+  uint32_t nCandidates = m_phyList.size ();
+  if (m_maxRange > 0)
     {
-      if (sender != (*i))
+      if (m_index.GetN () == 0)
+        {
+          m_index.SetCellSize (m_maxRange);
+        }
+      for (uint32_t k = m_index.GetN (); k < m_phyList.size (); k++)
+        {
+          m_index.Add (k, m_phyList[k]->GetMobility ()->GetObject<MobilityModel> ());
+        }
+      m_index.GetCandidates (senderMobility->GetPosition (), m_maxRange, m_candidates);
+      nCandidates = m_candidates.size ();
+    }
+  uint32_t senderIndex = 0;
+  if (m_propagationMatrix)
+    {
+      if (m_matrix.GetN () == 0)
+        {
+          // the models may have been set as attributes
+          m_matrix.SetLossModel (m_loss);
+          m_matrix.SetDelayModel (m_delay);
+        }
+      for (uint32_t k = m_matrix.GetN (); k < m_phyList.size (); k++)
+        {
+          m_matrix.Add (m_phyList[k]->GetMobility ()->GetObject<MobilityModel> ());
+        }
+      senderIndex = std::find (m_phyList.begin (), m_phyList.end (), sender) - m_phyList.begin ();
+    }
+  for (uint32_t k = 0; k < nCandidates; k++)
+    {
+      uint32_t j = m_maxRange > 0 ? m_candidates[k] : k;
+      Ptr<YansWifiPhy> receiver = m_phyList[j];
+      if (sender != receiver)
         {
           //For now don't account for inter channel interference
-          if ((*i)->GetChannelNumber () != sender->GetChannelNumber ())
+          if (receiver->GetChannelNumber () != sender->GetChannelNumber ())
             {
               continue;
             }
 
-          Ptr<MobilityModel> receiverMobility = (*i)->GetMobility ()->GetObject<MobilityModel> ();
-          Time delay = m_delay->GetDelay (senderMobility, receiverMobility);
-          double rxPowerDbm = m_loss->CalcRxPower (txPowerDbm, senderMobility, receiverMobility);
+          Ptr<MobilityModel> receiverMobility = receiver->GetMobility ()->GetObject<MobilityModel> ();
+          if (m_maxRange > 0 && senderMobility->GetDistanceFrom (receiverMobility) > m_maxRange)
+            {
+              continue;
+            }
+          Time delay;
+          double rxPowerDbm;
+          if (m_propagationMatrix)
+            {
+              delay = m_matrix.GetDelay (senderIndex, j);
+              rxPowerDbm = m_matrix.CalcRxPower (txPowerDbm, senderIndex, j);
+            }
+          else
+            {
+              delay = m_delay->GetDelay (senderMobility, receiverMobility);
+              rxPowerDbm = m_loss->CalcRxPower (txPowerDbm, senderMobility, receiverMobility);
+            }
           NS_LOG_DEBUG ("propagation: txPower=" << txPowerDbm << "dbm, rxPower=" << rxPowerDbm << "dbm, " <<
                         "distance=" << senderMobility->GetDistanceFrom (receiverMobility) << "m, delay=" << delay);
           Ptr<Packet> copy = packet->Copy ();
-          Ptr<Object> dstNetDevice = m_phyList[j]->GetDevice ();
+          Ptr<Object> dstNetDevice = receiver->GetDevice ();
           uint32_t dstNode;
           if (dstNetDevice == 0)
             {
@@ -30,12 +30,12 @@
 #include "wifi-tx-vector.h"
 #include "yans-wifi-phy.h"
 #include "ns3/nstime.h"
+#include "ns3/spatial-index.h"
+#include "ns3/propagation-matrix.h"
 
 namespace ns3 {
 
 class NetDevice;
-class PropagationLossModel;
-class PropagationDelayModel;
 
 struct Parameters
 {
@@ -57,6 +57,18 @@ struct Parameters
  * class and contains a ns3::PropagationLossModel and a ns3::PropagationDelayModel.
  * By default, no propagation models are set so, it is the caller's responsability
  * to set them before using the channel.
+ *
+ * If the MaxRange attribute is set, a packet is delivered only to the PHYs
+ * within that distance of the sender, which are found with a SpatialIndex
+ * of the PHY positions instead of looking at every PHY of the channel. The
+ * farther PHYs would not even sense the packet as interference, provided
+ * the range is chosen beyond the distance at which the propagation loss
+ * model brings the maximum transmit power below the noise floor.
+ *
+ * If the PropagationMatrix attribute is set, the loss and delay of the
+ * path between two PHYs are computed once, and again only when one of
+ * them moves, as explained in PropagationMatrix. The loss of random
+ * propagation loss models is still computed for each packet.
  */
 class YansWifiChannel : public WifiChannel
 {
@@ -137,6 +149,11 @@ private:
   PhyList m_phyList;                   //!< List of YansWifiPhys connected to this YansWifiChannel
   Ptr<PropagationLossModel> m_loss;    //!< Propagation loss model
   Ptr<PropagationDelayModel> m_delay;  //!< Propagation delay model
+  double m_maxRange;                   //!< Distance beyond which packets are not delivered, 0 for none
+  mutable SpatialIndex m_index;        //!< Positions of the PHYs, by index in the PHY list
+  mutable std::vector<uint32_t> m_candidates; //!< PHYs near the sender of the last packet
+  bool m_propagationMatrix;            //!< Whether the paths between the PHYs are kept
+  mutable PropagationMatrix m_matrix;  //!< Paths between the PHYs, by index in the PHY list
 };
 
 } //namespace ns3
@@ -23,6 +23,8 @@
 #include "ns3/dsss-error-rate-model.h"
 #include "ns3/yans-error-rate-model.h"
 #include "ns3/nist-error-rate-model.h"
+#include "ns3/boolean.h"
+#include "ns3/object-factory.h"
 
 using namespace ns3;
 
@@ -279,6 +281,76 @@ WifiErrorRateModelsTestCaseNist::DoRun (void)
   NS_TEST_ASSERT_MSG_EQ_TOL (ps, 0.999, 0.001, "Not equal within tolerance");
 }
 
+class WifiErrorRateModelsTestCaseLookupTable : public TestCase
+{
+public:
+  WifiErrorRateModelsTestCaseLookupTable ();
+  virtual ~WifiErrorRateModelsTestCaseLookupTable ();
+
+private:
+  virtual void DoRun (void);
+  /**
+   * Compare the success rates of a model with and without lookup tables.
+   * \param tid the TypeId of the model
+   */
+  void CompareModels (TypeId tid);
+};
+
+WifiErrorRateModelsTestCaseLookupTable::WifiErrorRateModelsTestCaseLookupTable ()
+  : TestCase ("WifiErrorRateModel test case lookup tables")
+{
+}
+
+WifiErrorRateModelsTestCaseLookupTable::~WifiErrorRateModelsTestCaseLookupTable ()
+{
+}
+
+void
+WifiErrorRateModelsTestCaseLookupTable::CompareModels (TypeId tid)
+{
+  ObjectFactory factory;
+  factory.SetTypeId (tid);
+  Ptr<ErrorRateModel> exact = factory.Create<ErrorRateModel> ();
+  factory.Set ("UseLookupTable", BooleanValue (true));
+  Ptr<ErrorRateModel> table = factory.Create<ErrorRateModel> ();
+  // another model shares the tables filled in by the first one
+  Ptr<ErrorRateModel> other = factory.Create<ErrorRateModel> ();
+
+  const char *modes[] = {"OfdmRate6Mbps", "OfdmRate9Mbps", "OfdmRate12Mbps", "OfdmRate18Mbps",
+                         "OfdmRate24Mbps", "OfdmRate36Mbps", "OfdmRate48Mbps", "OfdmRate54Mbps",
+                         "HtMcs5", "HtMcs7", "VhtMcs8", "VhtMcs9"};
+  uint32_t sizes[] = {1, 100, 16000};
+  for (uint32_t m = 0; m < sizeof (modes) / sizeof (modes[0]); m++)
+    {
+      WifiTxVector txVector;
+      txVector.SetMode (WifiMode (modes[m]));
+      txVector.SetChannelWidth (m < 10 ? 20 : 80);
+      txVector.SetNss (1);
+      // from below to above the tables, between their points
+      for (double snr = -12.0; snr < 45.0; snr += 0.0537)
+        {
+          for (uint32_t s = 0; s < sizeof (sizes) / sizeof (sizes[0]); s++)
+            {
+              double ratio = std::pow (10.0, snr / 10.0);
+              double expected = exact->GetChunkSuccessRate (txVector.GetMode (), txVector, ratio, sizes[s]);
+              double value = table->GetChunkSuccessRate (txVector.GetMode (), txVector, ratio, sizes[s]);
+              NS_TEST_ASSERT_MSG_EQ_TOL (value, expected, 2e-5,
+                                         tid.GetName () << " " << modes[m] << " snr " << snr << " dB, "
+                                                        << sizes[s] << " bits");
+              NS_TEST_ASSERT_MSG_EQ (other->GetChunkSuccessRate (txVector.GetMode (), txVector, ratio, sizes[s]),
+                                     value, "Different tables");
+            }
+        }
+    }
+}
+
+void
+WifiErrorRateModelsTestCaseLookupTable::DoRun (void)
+{
+  CompareModels (NistErrorRateModel::GetTypeId ());
+  CompareModels (YansErrorRateModel::GetTypeId ());
+}
+
 class WifiErrorRateModelsTestSuite : public TestSuite
 {
 public:
@@ -290,6 +362,7 @@ WifiErrorRateModelsTestSuite::WifiErrorRateModelsTestSuite ()
 {
   AddTestCase (new WifiErrorRateModelsTestCaseDsss, TestCase::QUICK);
   AddTestCase (new WifiErrorRateModelsTestCaseNist, TestCase::QUICK);
+  AddTestCase (new WifiErrorRateModelsTestCaseLookupTable, TestCase::QUICK);
 }
 
 static WifiErrorRateModelsTestSuite wifiErrorRateModelsTestSuite;
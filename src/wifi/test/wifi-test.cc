@@ -29,6 +29,7 @@
 #include "ns3/propagation-loss-model.h"
 #include "ns3/yans-error-rate-model.h"
 #include "ns3/constant-position-mobility-model.h"
+#include "ns3/constant-velocity-mobility-model.h"
 #include "ns3/test.h"
 #include "ns3/pointer.h"
 #include "ns3/rng-seed-manager.h"
@@ -39,6 +40,8 @@
 #include "ns3/packet-socket-server.h"
 #include "ns3/packet-socket-client.h"
 #include "ns3/packet-socket-helper.h"
+#include "ns3/nqos-wifi-mac-helper.h"
+#include "ns3/double.h"
 
 using namespace ns3;
 
@@ -618,6 +621,293 @@ Bug730TestCase::DoRun (void)
   NS_TEST_ASSERT_MSG_EQ (result, true, "packet reception unexpectedly stopped after adapting fragmentation threshold!");
 }
 
+//-----------------------------------------------------------------------------
+/**
+ * Make sure that a YansWifiChannel with a MaxRange, or with a propagation
+ * matrix, delivers the same packets, with the same power, as without: two
+ * clusters of nodes far apart broadcast packets, while a node moves out
+ * of the reception range of the first cluster without changing course.
+ */
+class YansWifiChannelMaxRangeTest : public TestCase
+{
+public:
+  YansWifiChannelMaxRangeTest ();
+
+  virtual void DoRun (void);
+
+
+private:
+  /**
+   * Simulate the scenario.
+   * \param maxRange the MaxRange of the channel
+   * \param matrix whether the channel uses a propagation matrix
+   */
+  void RunOne (double maxRange, bool matrix);
+  /**
+   * Broadcast a packet.
+   * \param dev the sender
+   */
+  void SendOnePacket (Ptr<WifiNetDevice> dev);
+
+  std::vector<uint32_t> m_received;  //!< The packets received by each node
+  std::vector<double> m_rxPower;     //!< The sum of their power, in dBm
+  uint32_t m_dropped;                //!< The packets dropped by all nodes
+};
+
+YansWifiChannelMaxRangeTest::YansWifiChannelMaxRangeTest ()
+  : TestCase ("YansWifiChannel MaxRange")
+{
+}
+
+static void
+CountRx (uint32_t *count, Ptr<const Packet> packet)
+{
+  (*count)++;
+}
+
+static void
+SumRxPower (double *sum, Ptr<const Packet> packet, uint16_t channelFreqMhz, uint16_t channelNumber,
+            uint32_t rate, WifiPreamble preamble, WifiTxVector txVector, struct mpduInfo aMpdu,
+            struct signalNoiseDbm signalNoise)
+{
+  *sum += signalNoise.signal;
+}
+
+void
+YansWifiChannelMaxRangeTest::SendOnePacket (Ptr<WifiNetDevice> dev)
+{
+  Ptr<Packet> p = Create<Packet> (100);
+  dev->Send (p, dev->GetBroadcast (), 1);
+}
+
+void
+YansWifiChannelMaxRangeTest::RunOne (double maxRange, bool matrix)
+{
+  NodeContainer nodes;
+  nodes.Create (9);
+
+  MobilityHelper mobility;
+  Ptr<ListPositionAllocator> positions = CreateObject<ListPositionAllocator> ();
+  for (uint32_t i = 0; i < 4; i++)
+    {
+      positions->Add (Vector (10.0 * i, 5.0 * i, 0.0));
+      positions->Add (Vector (20000.0 + 10.0 * i, 5.0 * i, 0.0));
+    }
+  NodeContainer fixed;
+  for (uint32_t i = 0; i < 8; i++)
+    {
+      fixed.Add (nodes.Get (i));
+    }
+  mobility.SetPositionAllocator (positions);
+  mobility.Install (fixed);
+  mobility.SetMobilityModel ("ns3::ConstantVelocityMobilityModel");
+  mobility.Install (nodes.Get (8));
+  Ptr<ConstantVelocityMobilityModel> mover = nodes.Get (8)->GetObject<ConstantVelocityMobilityModel> ();
+  mover->SetPosition (Vector (800.0, 0.0, 0.0));
+  mover->SetVelocity (Vector (200.0, 0.0, 0.0));
+
+  YansWifiChannelHelper channelHelper;
+  channelHelper.SetPropagationDelay ("ns3::ConstantSpeedPropagationDelayModel");
+  channelHelper.AddPropagationLoss ("ns3::LogDistancePropagationLossModel", "Exponent", DoubleValue (2.0));
+  Ptr<YansWifiChannel> channel = channelHelper.Create ();
+  channel->SetAttribute ("MaxRange", DoubleValue (maxRange));
+  channel->SetAttribute ("PropagationMatrix", BooleanValue (matrix));
+  YansWifiPhyHelper phy = YansWifiPhyHelper::Default ();
+  phy.SetChannel (channel);
+  NqosWifiMacHelper mac = NqosWifiMacHelper::Default ();
+  mac.SetType ("ns3::AdhocWifiMac");
+  WifiHelper wifi;
+  wifi.SetStandard (WIFI_PHY_STANDARD_80211a);
+  wifi.SetRemoteStationManager ("ns3::ConstantRateWifiManager", "DataMode", StringValue ("OfdmRate6Mbps"));
+  NetDeviceContainer devices = wifi.Install (phy, mac, nodes);
+  wifi.AssignStreams (devices, 100);
+
+  m_received.assign (nodes.GetN (), 0);
+  m_rxPower.assign (nodes.GetN (), 0);
+  m_dropped = 0;
+  for (uint32_t i = 0; i < nodes.GetN (); i++)
+    {
+      Ptr<WifiNetDevice> dev = DynamicCast<WifiNetDevice> (devices.Get (i));
+      dev->GetPhy ()->TraceConnectWithoutContext ("PhyRxEnd", MakeBoundCallback (&CountRx, &m_received[i]));
+      dev->GetPhy ()->TraceConnectWithoutContext ("PhyRxDrop", MakeBoundCallback (&CountRx, &m_dropped));
+      dev->GetPhy ()->TraceConnectWithoutContext ("MonitorSnifferRx", MakeBoundCallback (&SumRxPower, &m_rxPower[i]));
+      for (uint32_t k = 0; k < 50; k++)
+        {
+          Simulator::Schedule (Seconds (0.2 * k + 0.013 * i),
+                               &YansWifiChannelMaxRangeTest::SendOnePacket, this, dev);
+        }
+    }
+
+  Simulator::Stop (Seconds (11.0));
+  Simulator::Run ();
+  Simulator::Destroy ();
+}
+
+void
+YansWifiChannelMaxRangeTest::DoRun (void)
+{
+  RunOne (0, false);
+  std::vector<uint32_t> received = m_received;
+  std::vector<double> rxPower = m_rxPower;
+  uint32_t dropped = m_dropped;
+
+  RunOne (0, true);
+  for (uint32_t i = 0; i < received.size (); i++)
+    {
+      NS_TEST_EXPECT_MSG_EQ (m_received[i], received[i], "Different packets received by node " << i << " with a matrix");
+      NS_TEST_EXPECT_MSG_EQ_TOL (m_rxPower[i], rxPower[i], 1e-9, "Different power received by node " << i << " with a matrix");
+    }
+  NS_TEST_EXPECT_MSG_EQ (m_dropped, dropped, "Different packets dropped with a matrix");
+
+  RunOne (2500, false);
+  NS_TEST_ASSERT_MSG_GT (received[0], 0, "Nothing received");
+  NS_TEST_ASSERT_MSG_GT (received[8], 0, "Nothing received by the moving node");
+  NS_TEST_ASSERT_MSG_LT (received[8], received[0], "The moving node did not leave the range");
+  for (uint32_t i = 0; i < received.size (); i++)
+    {
+      NS_TEST_EXPECT_MSG_EQ (m_received[i], received[i], "Different packets received by node " << i);
+      NS_TEST_EXPECT_MSG_EQ_TOL (m_rxPower[i], rxPower[i], 1e-9, "Different power received by node " << i);
+    }
+  NS_TEST_EXPECT_MSG_LT (m_dropped, dropped, "Packets sent beyond the maximum range");
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * Make sure that a StaWifiMac moving from an AP to another reassociates
+ * within 100 ms with the candidate cache, by roaming before it loses its
+ * AP, while it first waits for MaxMissedBeacons beacons without it.
+ */
+class StaWifiMacRoamingTest : public TestCase
+{
+public:
+  StaWifiMacRoamingTest ();
+
+  virtual void DoRun (void);
+
+
+private:
+  /**
+   * Simulate the scenario.
+   * \param candidateCache whether the STA caches the APs
+   * \param late whether the cache is enabled once the STA is installed
+   */
+  void RunOne (bool candidateCache, bool late);
+  /**
+   * Record a handoff.
+   * \param oldBssid the AP left
+   * \param newBssid the AP joined
+   * \param latency the latency of the handoff
+   */
+  void Handoff (Mac48Address oldBssid, Mac48Address newBssid, Time latency);
+
+  std::vector<Mac48Address> m_apAddresses;  //!< The addresses of the APs
+  std::vector<Mac48Address> m_from;         //!< The AP left at each handoff
+  std::vector<Mac48Address> m_to;           //!< The AP joined at each handoff
+  std::vector<Time> m_latencies;            //!< The latency of each handoff
+};
+
+StaWifiMacRoamingTest::StaWifiMacRoamingTest ()
+  : TestCase ("StaWifiMac roaming")
+{
+}
+
+void
+StaWifiMacRoamingTest::Handoff (Mac48Address oldBssid, Mac48Address newBssid, Time latency)
+{
+  m_from.push_back (oldBssid);
+  m_to.push_back (newBssid);
+  m_latencies.push_back (latency);
+}
+
+void
+StaWifiMacRoamingTest::RunOne (bool candidateCache, bool late)
+{
+  NodeContainer apNodes;
+  apNodes.Create (2);
+  NodeContainer staNode;
+  staNode.Create (1);
+
+  MobilityHelper mobility;
+  Ptr<ListPositionAllocator> positions = CreateObject<ListPositionAllocator> ();
+  positions->Add (Vector (0.0, 0.0, 0.0));
+  positions->Add (Vector (100.0, 0.0, 0.0));
+  mobility.SetPositionAllocator (positions);
+  mobility.Install (apNodes);
+  mobility.SetMobilityModel ("ns3::ConstantVelocityMobilityModel");
+  mobility.Install (staNode);
+  Ptr<ConstantVelocityMobilityModel> mover = staNode.Get (0)->GetObject<ConstantVelocityMobilityModel> ();
+  mover->SetPosition (Vector (-40.0, 0.0, 0.0));
+  mover->SetVelocity (Vector (20.0, 0.0, 0.0));
+
+  YansWifiChannelHelper channel = YansWifiChannelHelper::Default ();
+  YansWifiPhyHelper phy = YansWifiPhyHelper::Default ();
+  phy.SetChannel (channel.Create ());
+  WifiHelper wifi;
+  wifi.SetStandard (WIFI_PHY_STANDARD_80211a);
+  wifi.SetRemoteStationManager ("ns3::ConstantRateWifiManager", "DataMode", StringValue ("OfdmRate6Mbps"));
+  WifiMacHelper mac;
+  Ssid ssid = Ssid ("roaming");
+  // the beacons of the APs must not always collide
+  mac.SetType ("ns3::ApWifiMac",
+               "Ssid", SsidValue (ssid),
+               "EnableBeaconJitter", BooleanValue (true));
+  NetDeviceContainer apDevices = wifi.Install (phy, mac, apNodes);
+  mac.SetType ("ns3::StaWifiMac",
+               "Ssid", SsidValue (ssid),
+               "CandidateCache", BooleanValue (candidateCache && !late));
+  NetDeviceContainer staDevices = wifi.Install (phy, mac, staNode);
+  wifi.AssignStreams (apDevices, 100);
+  wifi.AssignStreams (staDevices, 200);
+
+  m_apAddresses.clear ();
+  for (uint32_t i = 0; i < apDevices.GetN (); i++)
+    {
+      m_apAddresses.push_back (Mac48Address::ConvertFrom (apDevices.Get (i)->GetAddress ()));
+    }
+  m_from.clear ();
+  m_to.clear ();
+  m_latencies.clear ();
+  Ptr<WifiNetDevice> sta = DynamicCast<WifiNetDevice> (staDevices.Get (0));
+  sta->GetMac ()->TraceConnectWithoutContext ("Handoff", MakeCallback (&StaWifiMacRoamingTest::Handoff, this));
+  if (late)
+    {
+      // the phy is already set: the sniffer must be connected now
+      sta->GetMac ()->SetAttribute ("CandidateCache", BooleanValue (candidateCache));
+    }
+
+  Simulator::Stop (Seconds (12.0));
+  Simulator::Run ();
+  Simulator::Destroy ();
+}
+
+void
+StaWifiMacRoamingTest::DoRun (void)
+{
+  RunOne (false, false);
+  NS_TEST_ASSERT_MSG_EQ (m_latencies.size (), 1, "Wrong number of handoffs without the cache");
+  if (m_latencies.size () != 1)
+    {
+      return;
+    }
+  NS_TEST_EXPECT_MSG_EQ (m_from[0], m_apAddresses[0], "Wrong AP left");
+  NS_TEST_EXPECT_MSG_EQ (m_to[0], m_apAddresses[1], "Wrong AP joined");
+  // 10 beacons of 102.4 ms must be missed first
+  NS_TEST_EXPECT_MSG_GT (m_latencies[0], MilliSeconds (1024), "Handoff too fast without the cache");
+
+  for (uint32_t late = 0; late < 2; late++)
+    {
+      RunOne (true, late);
+      NS_TEST_ASSERT_MSG_EQ (m_latencies.size (), 1, "Wrong number of handoffs with the cache");
+      if (m_latencies.size () != 1)
+        {
+          return;
+        }
+      NS_TEST_EXPECT_MSG_EQ (m_from[0], m_apAddresses[0], "Wrong AP left");
+      NS_TEST_EXPECT_MSG_EQ (m_to[0], m_apAddresses[1], "Wrong AP joined");
+      NS_TEST_EXPECT_MSG_LT (m_latencies[0], MilliSeconds (100), "Handoff too slow with the cache");
+    }
+}
+
 //-----------------------------------------------------------------------------
 class WifiTestSuite : public TestSuite
 {
@@ -633,6 +923,8 @@ WifiTestSuite::WifiTestSuite ()
   AddTestCase (new InterferenceHelperSequenceTest, TestCase::QUICK); //Bug 991
   AddTestCase (new Bug555TestCase, TestCase::QUICK); //Bug 555
   AddTestCase (new Bug730TestCase, TestCase::QUICK); //Bug 730
+  AddTestCase (new YansWifiChannelMaxRangeTest, TestCase::QUICK);
+  AddTestCase (new StaWifiMacRoamingTest, TestCase::QUICK);
 }
 
 static WifiTestSuite g_wifiTestSuite;
@@ -531,6 +531,7 @@ BaseStationNetDevice::Start (void)
   /* shall actually be 2 symbols = 1 (preamble) + 1 (bandwidth request header)*/
   m_bwReqOppSize = 6;
   m_uplinkScheduler->InitOnce ();
+  LinkUp ();
 }
 
 void
@@ -680,7 +681,15 @@ BaseStationNetDevice::Enqueue (Ptr<Packet> packet, const MacHeaderType &hdrType,
 
   hdr.SetCid (connection->GetCid ());
 
-  return connection->Enqueue (packet, hdrType, hdr);
+  if (!connection->Enqueue (packet, hdrType, hdr))
+    {
+      return false;
+    }
+  if (m_scheduler != 0)
+    {
+      m_scheduler->OnEnqueue (connection);
+    }
+  return true;
 }
 
 void
@@ -321,7 +321,7 @@ BSSchedulerRtps::BSSchedulerBasicConnection (uint32_t &availableSymbols)
   std::vector<Ptr<WimaxConnection> >::const_iterator iter;
   std::vector<Ptr<WimaxConnection> > connections;
 
-  connections = GetBs ()->GetConnectionManager ()->GetConnections (Cid::BASIC);
+  connections = GetBackloggedConnections (CLASS_BASIC);
   for (iter = connections.begin (); iter != connections.end (); ++iter)
     {
       while ((*iter)->HasPackets () && availableSymbols > 0)
@@ -380,7 +380,7 @@ BSSchedulerRtps::BSSchedulerPrimaryConnection (uint32_t &availableSymbols)
   std::vector<Ptr<WimaxConnection> >::const_iterator iter;
   std::vector<Ptr<WimaxConnection> > connections;
 
-  connections = GetBs ()->GetConnectionManager ()->GetConnections (Cid::PRIMARY);
+  connections = GetBackloggedConnections (CLASS_PRIMARY);
   for (iter = connections.begin (); iter != connections.end (); ++iter)
     {
       while ((*iter)->HasPackets () && availableSymbols > 0)
@@ -437,44 +437,40 @@ BSSchedulerRtps::BSSchedulerUGSConnection (uint32_t &availableSymbols)
 
   Time currentTime = Simulator::Now ();
 
-  std::vector<ServiceFlow*>::iterator iter;
+  std::vector<Ptr<WimaxConnection> >::const_iterator iter;
   ServiceFlowRecord *serviceFlowRecord;
-  std::vector<ServiceFlow*> serviceFlows;
+  std::vector<Ptr<WimaxConnection> > connections;
 
-  serviceFlows = GetBs ()->GetServiceFlowManager ()->GetServiceFlows (ServiceFlow::SF_TYPE_UGS);
-  for (iter = serviceFlows.begin (); iter != serviceFlows.end (); ++iter)
+  // if latency would exceed in case grant is allocated in next frame then allocate in current frame
+  connections = GetDueConnections (CLASS_UGS);
+  for (iter = connections.begin (); iter != connections.end (); ++iter)
     {
-      serviceFlowRecord = (*iter)->GetRecord ();
-      // if latency would exceed in case grant is allocated in next frame then allocate in current frame
-      if ((*iter)->HasPackets () && ((currentTime - serviceFlowRecord->GetDlTimeStamp ())
-                                     + GetBs ()->GetPhy ()->GetFrameDuration ()) > MilliSeconds ((*iter)->GetMaximumLatency ()))
+      serviceFlowRecord = (*iter)->GetServiceFlow ()->GetRecord ();
+      connection = *iter;
+      if (connection->GetType () == Cid::MULTICAST)
         {
-          connection = (*iter)->GetConnection ();
-          if (connection->GetType () == Cid::MULTICAST)
-            {
-              modulationType = connection->GetServiceFlow ()->GetModulation ();
-            }
-          else
-            {
-              modulationType = GetBs ()->GetSSManager ()->GetSSRecord (connection->GetCid ())->GetModulationType ();
-            }
-          diuc = GetBs ()->GetBurstProfileManager ()->GetBurstProfile (modulationType,
-                                                                       WimaxNetDevice::DIRECTION_DOWNLINK);
+          modulationType = connection->GetServiceFlow ()->GetModulation ();
+        }
+      else
+        {
+          modulationType = GetBs ()->GetSSManager ()->GetSSRecord (connection->GetCid ())->GetModulationType ();
+        }
+      diuc = GetBs ()->GetBurstProfileManager ()->GetBurstProfile (modulationType,
+                                                                   WimaxNetDevice::DIRECTION_DOWNLINK);
 
-          nrSymbolsRequired = connection->GetServiceFlow ()->GetRecord ()->GetGrantSize ();
+      nrSymbolsRequired = connection->GetServiceFlow ()->GetRecord ()->GetGrantSize ();
 
-          // Packet fragmentation for UGS connections has not been implemented yet!
-          if (availableSymbols > nrSymbolsRequired)
+      // Packet fragmentation for UGS connections has not been implemented yet!
+      if (availableSymbols > nrSymbolsRequired)
+        {
+          availableSymbols -= nrSymbolsRequired;
+          burst = CreateUgsBurst (connection->GetServiceFlow (), modulationType, nrSymbolsRequired);
+          if (burst->GetNPackets () != 0)
             {
-              availableSymbols -= nrSymbolsRequired;
-              burst = CreateUgsBurst (connection->GetServiceFlow (), modulationType, nrSymbolsRequired);
-              if (burst->GetNPackets () != 0)
-                {
-                  AddDownlinkBurst (connection, diuc, modulationType, burst);
-                  currentTime = Simulator::Now ();
-                  serviceFlowRecord->SetDlTimeStamp (currentTime);
-                  burst = Create<PacketBurst> ();
-                }
+              AddDownlinkBurst (connection, diuc, modulationType, burst);
+              currentTime = Simulator::Now ();
+              serviceFlowRecord->SetDlTimeStamp (currentTime);
+              burst = Create<PacketBurst> ();
             }
         }
     }
@@ -494,55 +490,49 @@ BSSchedulerRtps::BSSchedulerRTPSConnection (uint32_t &availableSymbols)
 
   std::vector<Ptr<WimaxConnection> >::const_iterator iter;
   std::vector<Ptr<WimaxConnection> > connections;
-  std::vector<ServiceFlow*>::iterator iter2;
   ServiceFlowRecord *serviceFlowRecord;
-  std::vector<ServiceFlow*> serviceFlows;
 
-  uint32_t symbolsRequired[100];
-  WimaxPhy::ModulationType modulationType_[100];
-  uint8_t diuc_[100];
-  Ptr<WimaxConnection> rtPSConnection[100];
   uint32_t dataToSend;
   uint32_t totSymbolsRequired = 0;
   int nbConnection = 0;
 
   NS_LOG_INFO ("\tDL Scheduler for rtPS flows \n" << "\t\tavailableSymbols = " << availableSymbols);
 
-  serviceFlows = GetBs ()->GetServiceFlowManager ()->GetServiceFlows (ServiceFlow::SF_TYPE_RTPS);
+  // DL RTPS Scheduler works for all rtPS connection that have packets to transmitt!!!
+  connections = GetBackloggedConnections (CLASS_RTPS);
+  std::vector<uint32_t> symbolsRequired (connections.size ());
+  std::vector<WimaxPhy::ModulationType> modulationType_ (connections.size ());
+  std::vector<uint8_t> diuc_ (connections.size ());
+  std::vector<Ptr<WimaxConnection> > rtPSConnection (connections.size ());
   nbConnection = 0;
-  for (iter2 = serviceFlows.begin (); iter2 != serviceFlows.end (); ++iter2)
+  for (iter = connections.begin (); iter != connections.end (); ++iter)
     {
-      // DL RTPS Scheduler works for all rtPS connection that have packets to transmitt!!!
-      serviceFlowRecord = (*iter2)->GetRecord ();
-
-      if ((*iter2)->HasPackets ())
+      serviceFlowRecord = (*iter)->GetServiceFlow ()->GetRecord ();
+      currentTime = Simulator::Now ();
+      serviceFlowRecord->SetDlTimeStamp (currentTime);
+      rtPSConnection[nbConnection] = *iter;
+      if (rtPSConnection[nbConnection]->GetType () == Cid::MULTICAST)
         {
-          currentTime = Simulator::Now ();
-          serviceFlowRecord->SetDlTimeStamp (currentTime);
-          rtPSConnection[nbConnection] = (*iter2)->GetConnection ();
-          if (rtPSConnection[nbConnection]->GetType () == Cid::MULTICAST)
-            {
-              modulationType_[nbConnection] = rtPSConnection[nbConnection]->GetServiceFlow ()->GetModulation ();
-            }
-          else
-            {
-              modulationType_[nbConnection]
-                = GetBs ()->GetSSManager ()->GetSSRecord (rtPSConnection[nbConnection]->GetCid ())->GetModulationType ();
-            }
-          diuc_[nbConnection]
-            = GetBs ()->GetBurstProfileManager ()->GetBurstProfile (modulationType_[nbConnection],
-                                                                    WimaxNetDevice::DIRECTION_DOWNLINK);
+          modulationType_[nbConnection] = rtPSConnection[nbConnection]->GetServiceFlow ()->GetModulation ();
+        }
+      else
+        {
+          modulationType_[nbConnection]
+            = GetBs ()->GetSSManager ()->GetSSRecord (rtPSConnection[nbConnection]->GetCid ())->GetModulationType ();
+        }
+      diuc_[nbConnection]
+        = GetBs ()->GetBurstProfileManager ()->GetBurstProfile (modulationType_[nbConnection],
+                                                                WimaxNetDevice::DIRECTION_DOWNLINK);
 
-          dataToSend = rtPSConnection[nbConnection]->GetQueue ()->GetQueueLengthWithMACOverhead ();
-          NS_LOG_INFO ("\t\tRTPS DL Scheduler for CID = " << rtPSConnection[nbConnection]->GetCid ()
-                                                          << "\n\t\t\t dataToSend = " << dataToSend);
+      dataToSend = rtPSConnection[nbConnection]->GetQueue ()->GetQueueLengthWithMACOverhead ();
+      NS_LOG_INFO ("\t\tRTPS DL Scheduler for CID = " << rtPSConnection[nbConnection]->GetCid ()
+                                                      << "\n\t\t\t dataToSend = " << dataToSend);
 
-          symbolsRequired[nbConnection] = GetBs ()->GetPhy ()->GetNrSymbols (dataToSend,
-                                                                             modulationType_[nbConnection]);
+      symbolsRequired[nbConnection] = GetBs ()->GetPhy ()->GetNrSymbols (dataToSend,
+                                                                         modulationType_[nbConnection]);
 
-          totSymbolsRequired += symbolsRequired[nbConnection];
-          nbConnection++;
-        }
+      totSymbolsRequired += symbolsRequired[nbConnection];
+      nbConnection++;
     }
 
   NS_LOG_INFO ("\t\ttotSymbolsRequired = " << totSymbolsRequired);
@@ -629,13 +619,13 @@ BSSchedulerRtps::BSSchedulerNRTPSConnection (uint32_t &availableSymbols)
   Ptr<Packet> packet;
   Ptr<PacketBurst> burst = Create<PacketBurst> ();
 
-  std::vector<ServiceFlow*>::iterator iter;
-  std::vector<ServiceFlow*> serviceFlows;
+  std::vector<Ptr<WimaxConnection> >::const_iterator iter;
+  std::vector<Ptr<WimaxConnection> > connections;
 
-  serviceFlows = GetBs ()->GetServiceFlowManager ()->GetServiceFlows (ServiceFlow::SF_TYPE_NRTPS);
-  for (iter = serviceFlows.begin (); iter != serviceFlows.end (); ++iter)
+  connections = GetBackloggedConnections (CLASS_NRTPS);
+  for (iter = connections.begin (); iter != connections.end (); ++iter)
     {
-      connection = (*iter)->GetConnection ();
+      connection = *iter;
 
       while ((*iter)->HasPackets () && availableSymbols > 0)
         {
@@ -684,13 +674,13 @@ BSSchedulerRtps::BSSchedulerBEConnection (uint32_t &availableSymbols)
   Ptr<Packet> packet;
   Ptr<PacketBurst> burst = Create<PacketBurst> ();
 
-  std::vector<ServiceFlow*>::iterator iter;
-  std::vector<ServiceFlow*> serviceFlows;
+  std::vector<Ptr<WimaxConnection> >::const_iterator iter;
+  std::vector<Ptr<WimaxConnection> > connections;
 
-  serviceFlows = GetBs ()->GetServiceFlowManager ()->GetServiceFlows (ServiceFlow::SF_TYPE_BE);
-  for (iter = serviceFlows.begin (); iter != serviceFlows.end (); ++iter)
+  connections = GetBackloggedConnections (CLASS_BE);
+  for (iter = connections.begin (); iter != connections.end (); ++iter)
     {
-      connection = (*iter)->GetConnection ();
+      connection = *iter;
 
       while ((*iter)->HasPackets () && availableSymbols > 0)
         {
@@ -222,9 +222,7 @@ bool BSSchedulerSimple::SelectConnection (Ptr<WimaxConnection> &connection)
 {
   connection = 0;
   Time currentTime = Simulator::Now ();
-  std::vector<Ptr<WimaxConnection> >::const_iterator iter1;
-  std::vector<ServiceFlow*>::iterator iter2;
-  ServiceFlowRecord *serviceFlowRecord;
+  ServiceFlow *serviceFlow;
   NS_LOG_INFO ("BS Scheduler: Selecting connection...");
   if (GetBs ()->GetBroadcastConnection ()->HasPackets ())
     {
@@ -240,86 +238,54 @@ bool BSSchedulerSimple::SelectConnection (Ptr<WimaxConnection> &connection)
     }
   else
     {
-      std::vector<Ptr<WimaxConnection> > connections;
-      std::vector<ServiceFlow*> serviceFlows;
-
-      connections = GetBs ()->GetConnectionManager ()->GetConnections (Cid::BASIC);
-      for (iter1 = connections.begin (); iter1 != connections.end (); ++iter1)
+      connection = GetFirstBackloggedConnection (CLASS_BASIC);
+      if (connection != 0)
         {
-          if ((*iter1)->HasPackets ())
-            {
-              NS_LOG_INFO ("Return Basic");
-              connection = *iter1;
-              return true;
-            }
+          NS_LOG_INFO ("Return Basic");
+          return true;
         }
 
-      connections = GetBs ()->GetConnectionManager ()->GetConnections (Cid::PRIMARY);
-      for (iter1 = connections.begin (); iter1 != connections.end (); ++iter1)
+      connection = GetFirstBackloggedConnection (CLASS_PRIMARY);
+      if (connection != 0)
         {
-          if ((*iter1)->HasPackets ())
-            {
-              NS_LOG_INFO ("Return Primary");
-              connection = *iter1;
-              return true;
-            }
+          NS_LOG_INFO ("Return Primary");
+          return true;
         }
 
-      serviceFlows = GetBs ()->GetServiceFlowManager ()->GetServiceFlows (ServiceFlow::SF_TYPE_UGS);
-      for (iter2 = serviceFlows.begin (); iter2 != serviceFlows.end (); ++iter2)
+      // if latency would exceed in case grant is allocated in next frame then allocate in current frame
+      connection = GetFirstDueConnection (CLASS_UGS);
+      if (connection != 0)
         {
-          serviceFlowRecord = (*iter2)->GetRecord ();
-          NS_LOG_INFO ("processing UGS: HAS PACKET=" << (*iter2)->HasPackets () << "max Latency = "
-                                                     << MilliSeconds ((*iter2)->GetMaximumLatency ()) << "Delay = " << ((currentTime
-                                                                                           - serviceFlowRecord->GetDlTimeStamp ()) + GetBs ()->GetPhy ()->GetFrameDuration ()));
-          // if latency would exceed in case grant is allocated in next frame then allocate in current frame
-          if ((*iter2)->HasPackets () && ((currentTime - serviceFlowRecord->GetDlTimeStamp ())
-                                          + GetBs ()->GetPhy ()->GetFrameDuration ()) > MilliSeconds ((*iter2)->GetMaximumLatency ()))
-            {
-              serviceFlowRecord->SetDlTimeStamp (currentTime);
-              connection = (*iter2)->GetConnection ();
-              NS_LOG_INFO ("Return UGS SF: CID = " << (*iter2)->GetCid () << "SFID = " << (*iter2)->GetSfid ());
-              return true;
-            }
+          serviceFlow = connection->GetServiceFlow ();
+          NS_LOG_INFO ("processing UGS: max Latency = " << MilliSeconds (serviceFlow->GetMaximumLatency ())
+                                                        << "Deadline = " << GetDeadline (serviceFlow));
+          serviceFlow->GetRecord ()->SetDlTimeStamp (currentTime);
+          NS_LOG_INFO ("Return UGS SF: CID = " << serviceFlow->GetCid () << "SFID = " << serviceFlow->GetSfid ());
+          return true;
         }
 
-      serviceFlows = GetBs ()->GetServiceFlowManager ()->GetServiceFlows (ServiceFlow::SF_TYPE_RTPS);
-      for (iter2 = serviceFlows.begin (); iter2 != serviceFlows.end (); ++iter2)
+      // if latency would exceed in case poll is allocated in next frame then allocate in current frame
+      connection = GetFirstDueConnection (CLASS_RTPS);
+      if (connection != 0)
         {
-          serviceFlowRecord = (*iter2)->GetRecord ();
-          // if latency would exceed in case poll is allocated in next frame then allocate in current frame
-          if ((*iter2)->HasPackets () && ((currentTime - serviceFlowRecord->GetDlTimeStamp ())
-                                          + GetBs ()->GetPhy ()->GetFrameDuration ()) > MilliSeconds ((*iter2)->GetMaximumLatency ()))
-            {
-              serviceFlowRecord->SetDlTimeStamp (currentTime);
-              connection = (*iter2)->GetConnection ();
-              NS_LOG_INFO ("Return RTPS SF: CID = " << (*iter2)->GetCid () << "SFID = " << (*iter2)->GetSfid ());
-              return true;
-            }
+          serviceFlow = connection->GetServiceFlow ();
+          serviceFlow->GetRecord ()->SetDlTimeStamp (currentTime);
+          NS_LOG_INFO ("Return RTPS SF: CID = " << serviceFlow->GetCid () << "SFID = " << serviceFlow->GetSfid ());
+          return true;
         }
 
-      serviceFlows = GetBs ()->GetServiceFlowManager ()->GetServiceFlows (ServiceFlow::SF_TYPE_NRTPS);
-      for (iter2 = serviceFlows.begin (); iter2 != serviceFlows.end (); ++iter2)
+      connection = GetFirstBackloggedConnection (CLASS_NRTPS);
+      if (connection != 0)
         {
-          //unused: serviceFlowRecord = (*iter2)->GetRecord ();
-          if ((*iter2)->HasPackets ())
-            {
-              NS_LOG_INFO ("Return NRTPS SF: CID = " << (*iter2)->GetCid () << "SFID = " << (*iter2)->GetSfid ());
-              connection = (*iter2)->GetConnection ();
-              return true;
-            }
+          NS_LOG_INFO ("Return NRTPS SF: CID = " << connection->GetCid ());
+          return true;
         }
 
-      serviceFlows = GetBs ()->GetServiceFlowManager ()->GetServiceFlows (ServiceFlow::SF_TYPE_BE);
-      for (iter2 = serviceFlows.begin (); iter2 != serviceFlows.end (); ++iter2)
+      connection = GetFirstBackloggedConnection (CLASS_BE);
+      if (connection != 0)
         {
-          //unused: serviceFlowRecord = (*iter2)->GetRecord ();
-          if ((*iter2)->HasPackets ())
-            {
-              NS_LOG_INFO ("Return BE SF: CID = " << (*iter2)->GetCid () << "SFID = " << (*iter2)->GetSfid ());
-              connection = (*iter2)->GetConnection ();
-              return true;
-            }
+          NS_LOG_INFO ("Return BE SF: CID = " << connection->GetCid ());
+          return true;
         }
     }
   NS_LOG_INFO ("NO connection is selected!");
@@ -34,6 +34,7 @@
 #include "service-flow.h"
 #include "service-flow-record.h"
 #include "service-flow-manager.h"
+#include "bs-service-flow-manager.h"
 
 namespace ns3 {
 
@@ -121,4 +122,219 @@ BSScheduler::CheckForFragmentation (Ptr<WimaxConnection> connection,
       return false;
     }
 }
+
+BSScheduler::ConnectionClass
+BSScheduler::GetConnectionClass (Ptr<WimaxConnection> connection)
+{
+  switch (connection->GetType ())
+    {
+    case Cid::BASIC:
+      return CLASS_BASIC;
+    case Cid::PRIMARY:
+      return CLASS_PRIMARY;
+    case Cid::TRANSPORT:
+    case Cid::MULTICAST:
+      switch (connection->GetSchedulingType ())
+        {
+        case ServiceFlow::SF_TYPE_UGS:
+          return CLASS_UGS;
+        case ServiceFlow::SF_TYPE_RTPS:
+          return CLASS_RTPS;
+        case ServiceFlow::SF_TYPE_NRTPS:
+          return CLASS_NRTPS;
+        case ServiceFlow::SF_TYPE_BE:
+          return CLASS_BE;
+        default:
+          return CLASS_NONE;
+        }
+    default:
+      // the broadcast and initial ranging connections are always checked
+      return CLASS_NONE;
+    }
+}
+
+Time
+BSScheduler::GetDeadline (const ServiceFlow *serviceFlow)
+{
+  return serviceFlow->GetRecord ()->GetDlTimeStamp () + MilliSeconds (serviceFlow->GetMaximumLatency ())
+         - GetBs ()->GetPhy ()->GetFrameDuration ();
+}
+
+int64_t
+BSScheduler::GetPosition (Ptr<WimaxConnection> connection, ConnectionClass connectionClass)
+{
+  if (connectionClass == CLASS_BASIC || connectionClass == CLASS_PRIMARY)
+    {
+      // the connection manager holds them by increasing cid
+      return connection->GetCid ().GetIdentifier ();
+    }
+  return GetBs ()->GetServiceFlowManager ()->GetServiceFlowIndex (connection->GetServiceFlow ());
+}
+
+void
+BSScheduler::OnEnqueue (Ptr<WimaxConnection> connection)
+{
+  uint16_t cid = connection->GetCid ().GetIdentifier ();
+  if (m_backlogged.find (cid) != m_backlogged.end ())
+    {
+      return;
+    }
+  ConnectionClass connectionClass = GetConnectionClass (connection);
+  if (connectionClass == CLASS_NONE)
+    {
+      return;
+    }
+  BackloggedConnection backlogged;
+  backlogged.connection = connection;
+  backlogged.connectionClass = connectionClass;
+  backlogged.position = GetPosition (connection, connectionClass);
+  backlogged.deadline = 0;
+  backlogged.due = false;
+  if (connectionClass == CLASS_UGS || connectionClass == CLASS_RTPS)
+    {
+      backlogged.deadline = GetDeadline (connection->GetServiceFlow ()).GetTimeStep ();
+      m_pending[connectionClass].insert (std::make_pair (backlogged.deadline, cid));
+    }
+  m_backlogged[cid] = backlogged;
+  m_backlogs[connectionClass].insert (std::make_pair (backlogged.position, cid));
+}
+
+void
+BSScheduler::Drop (BackloggedConnections::iterator entry)
+{
+  uint16_t cid = entry->first;
+  BackloggedConnection &backlogged = entry->second;
+  m_backlogs[backlogged.connectionClass].erase (std::make_pair (backlogged.position, cid));
+  if (backlogged.connectionClass == CLASS_UGS || backlogged.connectionClass == CLASS_RTPS)
+    {
+      if (backlogged.due)
+        {
+          m_due[backlogged.connectionClass].erase (std::make_pair (backlogged.position, cid));
+        }
+      else
+        {
+          m_pending[backlogged.connectionClass].erase (std::make_pair (backlogged.deadline, cid));
+        }
+    }
+  m_backlogged.erase (entry);
+}
+
+std::vector<Ptr<WimaxConnection> >
+BSScheduler::Walk (ConnectionClass connectionClass, bool first)
+{
+  std::vector<Ptr<WimaxConnection> > connections;
+  Backlog &backlog = m_backlogs[connectionClass];
+  Backlog::iterator iter = backlog.begin ();
+  while (iter != backlog.end ())
+    {
+      BackloggedConnections::iterator entry = m_backlogged.find (iter->second);
+      NS_ASSERT (entry != m_backlogged.end ());
+      Backlog::iterator next = iter;
+      ++next;
+      if (!entry->second.connection->HasPackets ())
+        {
+          Drop (entry);
+        }
+      else
+        {
+          connections.push_back (entry->second.connection);
+          if (first)
+            {
+              break;
+            }
+        }
+      iter = next;
+    }
+  return connections;
+}
+
+std::vector<Ptr<WimaxConnection> >
+BSScheduler::WalkDue (ConnectionClass connectionClass, bool first)
+{
+  int64_t now = Simulator::Now ().GetTimeStep ();
+  Backlog &pending = m_pending[connectionClass];
+  Backlog &due = m_due[connectionClass];
+  // the deadlines only move forward, when the schedulers serve the flows:
+  // a connection whose deadline moved is found again further
+  while (!pending.empty () && pending.begin ()->first < now)
+    {
+      BackloggedConnections::iterator entry = m_backlogged.find (pending.begin ()->second);
+      NS_ASSERT (entry != m_backlogged.end ());
+      BackloggedConnection &backlogged = entry->second;
+      pending.erase (pending.begin ());
+      backlogged.deadline = GetDeadline (backlogged.connection->GetServiceFlow ()).GetTimeStep ();
+      backlogged.due = backlogged.deadline < now;
+      if (backlogged.due)
+        {
+          due.insert (std::make_pair (backlogged.position, entry->first));
+        }
+      else
+        {
+          pending.insert (std::make_pair (backlogged.deadline, entry->first));
+        }
+    }
+
+  std::vector<Ptr<WimaxConnection> > connections;
+  Backlog::iterator iter = due.begin ();
+  while (iter != due.end ())
+    {
+      BackloggedConnections::iterator entry = m_backlogged.find (iter->second);
+      NS_ASSERT (entry != m_backlogged.end ());
+      BackloggedConnection &backlogged = entry->second;
+      Backlog::iterator next = iter;
+      ++next;
+      if (!backlogged.connection->HasPackets ())
+        {
+          Drop (entry);
+          iter = next;
+          continue;
+        }
+      int64_t deadline = GetDeadline (backlogged.connection->GetServiceFlow ()).GetTimeStep ();
+      if (deadline >= now)
+        {
+          // served since its deadline passed
+          backlogged.deadline = deadline;
+          backlogged.due = false;
+          pending.insert (std::make_pair (deadline, iter->second));
+          due.erase (iter);
+          iter = next;
+          continue;
+        }
+      connections.push_back (backlogged.connection);
+      if (first)
+        {
+          break;
+        }
+      iter = next;
+    }
+  return connections;
+}
+
+std::vector<Ptr<WimaxConnection> >
+BSScheduler::GetBackloggedConnections (ConnectionClass connectionClass)
+{
+  return Walk (connectionClass, false);
+}
+
+Ptr<WimaxConnection>
+BSScheduler::GetFirstBackloggedConnection (ConnectionClass connectionClass)
+{
+  std::vector<Ptr<WimaxConnection> > connections = Walk (connectionClass, true);
+  return connections.empty () ? 0 : connections.front ();
+}
+
+std::vector<Ptr<WimaxConnection> >
+BSScheduler::GetDueConnections (ConnectionClass connectionClass)
+{
+  NS_ASSERT (connectionClass == CLASS_UGS || connectionClass == CLASS_RTPS);
+  return WalkDue (connectionClass, false);
+}
+
+Ptr<WimaxConnection>
+BSScheduler::GetFirstDueConnection (ConnectionClass connectionClass)
+{
+  NS_ASSERT (connectionClass == CLASS_UGS || connectionClass == CLASS_RTPS);
+  std::vector<Ptr<WimaxConnection> > connections = WalkDue (connectionClass, true);
+  return connections.empty () ? 0 : connections.front ();
+}
 } // namespace ns3
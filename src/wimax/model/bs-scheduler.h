@@ -24,6 +24,9 @@
 #define BS_SCHEDULER_H
 
 #include <list>
+#include <map>
+#include <set>
+#include <vector>
 #include "ns3/packet.h"
 #include "wimax-phy.h"
 #include "ns3/packet-burst.h"
@@ -104,9 +107,114 @@ public:
   bool CheckForFragmentation (Ptr<WimaxConnection> connection,
                               int availableSymbols,
                               WimaxPhy::ModulationType modulationType);
+
+  /**
+   * \brief Notify the scheduler that a packet was queued on a connection:
+   * the connection is then indexed by class until its queue is found
+   * empty, so that the schedulers only go through the connections which
+   * have packets to send.
+   * \param connection the connection
+   */
+  void OnEnqueue (Ptr<WimaxConnection> connection);
+
+protected:
+  /// The classes of the indexed connections, by decreasing priority.
+  enum ConnectionClass
+  {
+    CLASS_BASIC,
+    CLASS_PRIMARY,
+    CLASS_UGS,
+    CLASS_RTPS,
+    CLASS_NRTPS,
+    CLASS_BE,
+    CLASS_COUNT,
+    CLASS_NONE
+  };
+
+  /**
+   * \param connectionClass a class of connections
+   * \returns the connections of the class which have packets to send, in
+   * the order the connection manager (basic and primary connections) or
+   * the service flow manager (the others) holds them
+   */
+  std::vector<Ptr<WimaxConnection> > GetBackloggedConnections (ConnectionClass connectionClass);
+  /**
+   * \param connectionClass a class of connections
+   * \returns the first of GetBackloggedConnections, or 0
+   */
+  Ptr<WimaxConnection> GetFirstBackloggedConnection (ConnectionClass connectionClass);
+  /**
+   * \param connectionClass CLASS_UGS or CLASS_RTPS
+   * \returns the connections of GetBackloggedConnections whose deadline
+   * passed, in the same order
+   */
+  std::vector<Ptr<WimaxConnection> > GetDueConnections (ConnectionClass connectionClass);
+  /**
+   * \param connectionClass CLASS_UGS or CLASS_RTPS
+   * \returns the first of GetDueConnections, or 0
+   */
+  Ptr<WimaxConnection> GetFirstDueConnection (ConnectionClass connectionClass);
+  /**
+   * \param serviceFlow a service flow
+   * \returns the time after which its packets would exceed their maximum
+   * latency if they were only sent in the next frame
+   */
+  Time GetDeadline (const ServiceFlow *serviceFlow);
+
 private:
+  /// A connection with packets to send.
+  struct BackloggedConnection
+  {
+    Ptr<WimaxConnection> connection;   //!< The connection.
+    ConnectionClass connectionClass;   //!< Its class.
+    int64_t position;                  //!< Its position in its manager.
+    int64_t deadline;                  //!< Its deadline when last checked (UGS and rtPS).
+    bool due;                          //!< Whether its deadline had passed then.
+  };
+  /// An index of connections: their keys (position or deadline) and cids.
+  typedef std::set<std::pair<int64_t, uint16_t> > Backlog;
+  /// The indexed connections, by cid.
+  typedef std::map<uint16_t, BackloggedConnection> BackloggedConnections;
+
+  /**
+   * \param connection a connection
+   * \returns its class
+   */
+  static ConnectionClass GetConnectionClass (Ptr<WimaxConnection> connection);
+  /**
+   * \param connection a connection
+   * \param connectionClass its class
+   * \returns its position in the connection manager or the service flow
+   * manager
+   */
+  int64_t GetPosition (Ptr<WimaxConnection> connection, ConnectionClass connectionClass);
+  /**
+   * \brief Remove a connection from the indexes.
+   * \param entry the connection in m_backlogged
+   */
+  void Drop (BackloggedConnections::iterator entry);
+  /**
+   * \brief Go through the connections of a class, dropping those found empty.
+   * \param connectionClass a class of connections
+   * \param first whether to stop at the first connection with packets
+   * \returns the connections with packets
+   */
+  std::vector<Ptr<WimaxConnection> > Walk (ConnectionClass connectionClass, bool first);
+  /**
+   * \brief Go through the UGS or rtPS connections whose deadline passed,
+   * dropping those found empty and putting back those served since.
+   * \param connectionClass CLASS_UGS or CLASS_RTPS
+   * \param first whether to stop at the first connection with packets
+   * \returns the connections due with packets
+   */
+  std::vector<Ptr<WimaxConnection> > WalkDue (ConnectionClass connectionClass, bool first);
+
   Ptr<BaseStationNetDevice> m_bs;
   std::list<std::pair<OfdmDlMapIe*, Ptr<PacketBurst> > > *m_downlinkBursts;
+  BackloggedConnections m_backlogged;   //!< The indexed connections.
+  Backlog m_backlogs[CLASS_COUNT];      //!< The connections of each class, by position.
+  Backlog m_pending[CLASS_COUNT];       //!< The UGS and rtPS connections not due, by deadline.
+  Backlog m_due[CLASS_COUNT];           //!< The UGS and rtPS connections due, by position.
 };
 
 } // namespace ns3
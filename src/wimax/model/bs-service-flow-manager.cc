@@ -69,6 +69,7 @@ BsServiceFlowManager::GetTypeId (void)
 void
 BsServiceFlowManager::DoDispose (void)
 {
+  m_serviceFlowIndexes.clear ();
   ServiceFlowManager::DoDispose ();
 }
 
@@ -93,9 +94,19 @@ BsServiceFlowManager::GetDsaAckTimeoutEvent (void) const
 void
 BsServiceFlowManager::AddServiceFlow (ServiceFlow *serviceFlow)
 {
+  uint32_t index = m_serviceFlowIndexes.size ();
+  m_serviceFlowIndexes[serviceFlow] = index;
   ServiceFlowManager::AddServiceFlow (serviceFlow);
 }
 
+uint32_t
+BsServiceFlowManager::GetServiceFlowIndex (const ServiceFlow *serviceFlow) const
+{
+  std::map<const ServiceFlow*, uint32_t>::const_iterator iter = m_serviceFlowIndexes.find (serviceFlow);
+  NS_ASSERT_MSG (iter != m_serviceFlowIndexes.end (), "Service flow not added to the base station");
+  return iter->second;
+}
+
 ServiceFlow*
 BsServiceFlowManager::GetServiceFlow (uint32_t sfid) const
 {
@@ -22,6 +22,7 @@
 #define BS_SERVICE_FLOW_MANAGER_H
 
 #include <stdint.h>
+#include <map>
 #include "ns3/event-id.h"
 #include "mac-messages.h"
 #include "ns3/buffer.h"
@@ -74,6 +75,12 @@ public:
    * \return the list of service flows configured with schedulingType as a QoS class
    */
   std::vector<ServiceFlow*> GetServiceFlows (ServiceFlow::SchedulingType schedulingType) const;
+  /**
+   * \param serviceFlow a service flow of the base station
+   * \return the number of service flows added before it, that is its
+   * position in the lists of GetServiceFlows
+   */
+  uint32_t GetServiceFlowIndex (const ServiceFlow *serviceFlow) const;
   /**
    * \brief set the maximum Dynamic ServiceFlow Add (DSA) retries
    */
@@ -109,6 +116,8 @@ private:
   uint8_t m_maxDsaRspRetries;
   EventId m_dsaAckTimeoutEvent;
   Cid m_inuseScheduleDsaRspCid;
+  /// The position of each service flow, in the order they were added.
+  std::map<const ServiceFlow*, uint32_t> m_serviceFlowIndexes;
 };
 
 } // namespace ns3
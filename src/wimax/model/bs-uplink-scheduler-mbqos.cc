@@ -739,21 +739,16 @@ UplinkSchedulerMBQoS::CheckMinimumBandwidth (uint32_t &availableSymbols)
 {
   std::list<Ptr<PriorityUlJob> > priorityUlJobs;
 
-  // For each connection of type rtPS or nrtPS
-  std::vector<SSRecord*> *ssRecords = GetBs ()->GetSSManager ()->GetSSRecords ();
-  for (std::vector<SSRecord*>::iterator iter = ssRecords->begin (); iter != ssRecords->end (); ++iter)
+  // For each connection of type rtPS or nrtPS (only those having requests
+  // in the intermediate queue are used below)
+  for (std::list<Ptr<UlJob> >::const_iterator iter = m_uplinkJobs_inter.begin (); iter != m_uplinkJobs_inter.end (); ++iter)
     {
-      SSRecord *ssRecord = *iter;
-      std::vector<ServiceFlow*> serviceFlows = ssRecord->GetServiceFlows (ServiceFlow::SF_TYPE_ALL);
-      for (std::vector<ServiceFlow*>::iterator iter2 = serviceFlows.begin (); iter2 != serviceFlows.end (); ++iter2)
+      ServiceFlow *serviceFlow = (*iter)->GetServiceFlow ();
+      if (serviceFlow->GetSchedulingType () == ServiceFlow::SF_TYPE_RTPS || serviceFlow->GetSchedulingType ()
+          == ServiceFlow::SF_TYPE_NRTPS)
         {
-          ServiceFlow *serviceFlow = *iter2;
-          if (serviceFlow->GetSchedulingType () == ServiceFlow::SF_TYPE_RTPS || serviceFlow->GetSchedulingType ()
-              == ServiceFlow::SF_TYPE_NRTPS)
-            {
-              serviceFlow->GetRecord ()->SetBackloggedTemp (serviceFlow->GetRecord ()->GetBacklogged ());
-              serviceFlow->GetRecord ()->SetGrantedBandwidthTemp (serviceFlow->GetRecord ()->GetBwSinceLastExpiry ());
-            }
+          serviceFlow->GetRecord ()->SetBackloggedTemp (serviceFlow->GetRecord ()->GetBacklogged ());
+          serviceFlow->GetRecord ()->SetGrantedBandwidthTemp (serviceFlow->GetRecord ()->GetBwSinceLastExpiry ());
         }
     }
 
@@ -180,7 +180,9 @@ UplinkSchedulerRtps::Schedule (void)
   std::vector<SSRecord*> *ssRecords = GetBs ()->GetSSManager ()->GetSSRecords ();
   NS_LOG_INFO ("UL Scheduler start, availableSymbols = " << availableSymbols);
 
-  for (std::vector<SSRecord*>::iterator iter = ssRecords->begin (); iter != ssRecords->end (); ++iter)
+  // once the uplink subframe is full the stations left are not gone through:
+  // their grants and polls stay due for the next frames
+  for (std::vector<SSRecord*>::iterator iter = ssRecords->begin (); iter != ssRecords->end () && availableSymbols; ++iter)
     {
       SSRecord *ssRecord = *iter;
       if (ssRecord->GetIsBroadcastSS ())
@@ -510,11 +512,11 @@ UplinkSchedulerRtps::ULSchedulerRTPSConnection (uint32_t &symbolsToAllocation, u
 {
   NS_LOG_INFO ("\tUL Scheduler for rtPS flows");
   NS_LOG_INFO ("\t\tavailableSymbols = " << availableSymbols);
-  ServiceFlowRecord *record_[100];
-  uint32_t allocSizeSymbols_[100]; // symbolsRequired for each SSRecord
-  OfdmUlMapIe ulMapIe_[100];
+  std::vector<ServiceFlowRecord*> record_;
+  std::vector<uint32_t> allocSizeSymbols_; // symbolsRequired for each SSRecord
+  std::vector<OfdmUlMapIe> ulMapIe_;
   OfdmUlMapIe ulMapIe;
-  WimaxPhy::ModulationType modulationType_[100];
+  std::vector<WimaxPhy::ModulationType> modulationType_;
   WimaxPhy::ModulationType modulationType;
   int nbAllocation = 0;
   uint32_t allocSizeBytes;
@@ -542,17 +544,18 @@ UplinkSchedulerRtps::ULSchedulerRTPSConnection (uint32_t &symbolsToAllocation, u
           std::vector<ServiceFlow*> serviceFlows = ssRecord->GetServiceFlows (ServiceFlow::SF_TYPE_RTPS);
           for (std::vector<ServiceFlow*>::iterator iter2 = serviceFlows.begin (); iter2 != serviceFlows.end (); ++iter2)
             {
-              record_[nbAllocation] = (*iter2)->GetRecord ();
-              uint32_t requiredBandwidth = record_[nbAllocation]->GetRequestedBandwidth ()
-                - record_[nbAllocation]->GetGrantedBandwidth ();
+              ServiceFlowRecord *record = (*iter2)->GetRecord ();
+              uint32_t requiredBandwidth = record->GetRequestedBandwidth ()
+                - record->GetGrantedBandwidth ();
 
               if (requiredBandwidth > 0)
                 {
-                  modulationType_[nbAllocation] = modulationType;
-                  ulMapIe_[nbAllocation] = ulMapIe;
+                  record_.push_back (record);
+                  modulationType_.push_back (modulationType);
+                  ulMapIe_.push_back (ulMapIe);
                   allocSizeBytes = requiredBandwidth;
-                  allocSizeSymbols_[nbAllocation] = GetBs ()->GetPhy ()->GetNrSymbols (allocSizeBytes,
-                                                                                       modulationType_[nbAllocation]);
+                  allocSizeSymbols_.push_back (GetBs ()->GetPhy ()->GetNrSymbols (allocSizeBytes,
+                                                                                  modulationType_[nbAllocation]));
                   totAllocSizeSymbols += allocSizeSymbols_[nbAllocation];
 
                   NS_LOG_INFO ("\t\tUL Scheduler for CID = " << (*iter2)->GetConnection ()->GetCid ());
@@ -182,7 +182,9 @@ UplinkSchedulerSimple::Schedule (void)
   AllocateInitialRangingInterval (symbolsToAllocation, availableSymbols);
 
   std::vector<SSRecord*> *ssRecords = GetBs ()->GetSSManager ()->GetSSRecords ();
-  for (std::vector<SSRecord*>::iterator iter = ssRecords->begin (); iter != ssRecords->end (); ++iter)
+  // once the uplink subframe is full the stations left are not gone through:
+  // their grants and polls stay due for the next frames
+  for (std::vector<SSRecord*>::iterator iter = ssRecords->begin (); iter != ssRecords->end () && availableSymbols; ++iter)
     {
       SSRecord *ssRecord = *iter;
 
@@ -117,42 +117,23 @@ ConnectionManager::AddConnection (Ptr<WimaxConnection> connection, Cid::Type typ
       break;
     case Cid::MULTICAST:
       m_multicastConnections.push_back (connection);
-      break;
+      return;
     default:
       NS_FATAL_ERROR ("Invalid connection type");
       break;
     }
+  // GetConnection does not look for the multicast connections
+  m_connectionsByCid.insert (std::make_pair (connection->GetCid ().GetIdentifier (), connection));
 }
 
 Ptr<WimaxConnection>
 ConnectionManager::GetConnection (Cid cid)
 {
-  std::vector<Ptr<WimaxConnection> >::const_iterator iter;
-
-  for (iter = m_basicConnections.begin (); iter != m_basicConnections.end (); ++iter)
+  std::map<uint16_t, Ptr<WimaxConnection> >::const_iterator iter = m_connectionsByCid.find (cid.GetIdentifier ());
+  if (iter != m_connectionsByCid.end ())
     {
-      if ((*iter)->GetCid () == cid)
-        {
-          return *iter;
-        }
+      return iter->second;
     }
-
-  for (iter = m_primaryConnections.begin (); iter != m_primaryConnections.end (); ++iter)
-    {
-      if ((*iter)->GetCid () == cid)
-        {
-          return *iter;
-        }
-    }
-
-  for (iter = m_transportConnections.begin (); iter != m_transportConnections.end (); ++iter)
-    {
-      if ((*iter)->GetCid () == cid)
-        {
-          return *iter;
-        }
-    }
-
   return 0;
 }
 
@@ -23,6 +23,7 @@
 #ifndef CONNECTION_MANAGER_H
 #define CONNECTION_MANAGER_H
 
+#include <map>
 #include <stdint.h>
 #include "cid.h"
 #include "wimax-connection.h"
@@ -84,6 +85,8 @@ private:
   std::vector<Ptr<WimaxConnection> > m_primaryConnections;
   std::vector<Ptr<WimaxConnection> > m_transportConnections;
   std::vector<Ptr<WimaxConnection> > m_multicastConnections;
+  /// The basic, primary and transport connections, by cid.
+  std::map<uint16_t, Ptr<WimaxConnection> > m_connectionsByCid;
   // only for BS
   CidFactory *m_cidFactory;
 };
@@ -19,6 +19,7 @@
  *                              <amine.ismail@udcast.com>
  */
 
+#include <algorithm>
 #include "ns3/simulator.h"
 #include "ns3/callback.h"
 #include "ns3/nstime.h"
@@ -26,27 +27,34 @@
 #include "ns3/assert.h"
 #include "ns3/net-device.h"
 #include "ns3/node.h"
+#include "ns3/double.h"
+#include "ns3/boolean.h"
 #include "wimax-phy.h"
 #include "simple-ofdm-wimax-phy.h"
 #include "simple-ofdm-wimax-channel.h"
 #include "ns3/mobility-model.h"
 #include "ns3/cost231-propagation-loss-model.h"
+#include "ns3/propagation-delay-model.h"
 #include "simple-ofdm-send-param.h"
 
 namespace ns3 {
 
 NS_LOG_COMPONENT_DEFINE ("simpleOfdmWimaxChannel");
   
-// NS_OBJECT_ENSURE_REGISTERED (simpleOfdmWimaxChannel);
+NS_OBJECT_ENSURE_REGISTERED (SimpleOfdmWimaxChannel);
 
 
 SimpleOfdmWimaxChannel::SimpleOfdmWimaxChannel (void)
+  : m_maxRange (0),
+    m_propagationMatrix (false)
 {
   m_loss = 0;
 }
 
 SimpleOfdmWimaxChannel::~SimpleOfdmWimaxChannel (void)
 {
+  m_index.Clear ();
+  m_matrix.Clear ();
   m_phyList.clear ();
 }
 
@@ -58,11 +66,26 @@ SimpleOfdmWimaxChannel::GetTypeId (void)
     .SetParent<WimaxChannel> ()
     .SetGroupName ("Wimax")
     .AddConstructor<SimpleOfdmWimaxChannel> ()
+    .AddAttribute ("MaxRange",
+                   "The distance, in meters, beyond which the blocks are not sent, "
+                   "or 0 to send them to all the PHYs of the channel.",
+                   DoubleValue (0),
+                   MakeDoubleAccessor (&SimpleOfdmWimaxChannel::m_maxRange),
+                   MakeDoubleChecker<double> (0))
+    .AddAttribute ("PropagationMatrix",
+                   "If true, the propagation loss and delay between two PHYs are computed once, "
+                   "and again only when one of them moves. The loss of a random propagation "
+                   "model is still computed each time.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&SimpleOfdmWimaxChannel::m_propagationMatrix),
+                   MakeBooleanChecker ())
     ;
   return tid;
 }
 
 SimpleOfdmWimaxChannel::SimpleOfdmWimaxChannel (PropModel propModel)
+  : m_maxRange (0),
+    m_propagationMatrix (false)
 {
   switch (propModel)
     {
@@ -111,7 +134,7 @@ SimpleOfdmWimaxChannel::SetPropagationModel (PropModel propModel)
     default:
       m_loss = 0;
     }
-
+  m_matrix.SetLossModel (m_loss);
 }
 
 void
@@ -130,26 +153,18 @@ SimpleOfdmWimaxChannel::DoGetNDevices (void) const
 Ptr<NetDevice>
 SimpleOfdmWimaxChannel::DoGetDevice (uint32_t index) const
 {
-  uint32_t j = 0;
-  for (std::list<Ptr<SimpleOfdmWimaxPhy> >::const_iterator iter = m_phyList.begin (); iter != m_phyList.end (); ++iter)
+  if (index >= m_phyList.size ())
     {
-      if (j == index)
-        {
-          return (*iter)->GetDevice ();
-        }
-      j++;
+      NS_FATAL_ERROR ("Unable to get device");
+      return 0;
     }
-
-  NS_FATAL_ERROR ("Unable to get device");
-  return 0;
+  return m_phyList[index]->GetDevice ();
 }
 
 void
 SimpleOfdmWimaxChannel::Send (Time BlockTime,
                               uint32_t burstSize,
                               Ptr<WimaxPhy> phy,
-                              bool isFirstBlock,
-                              bool isLastBlock,
                               uint64_t frequency,
                               WimaxPhy::ModulationType modulationType,
                               uint8_t direction,
@@ -160,29 +175,75 @@ SimpleOfdmWimaxChannel::Send (Time BlockTime,
   Ptr<MobilityModel> senderMobility = 0;
   Ptr<MobilityModel> receiverMobility = 0;
   senderMobility = phy->GetDevice ()->GetNode ()->GetObject<MobilityModel> ();
-  simpleOfdmSendParam * param;
-  for (std::list<Ptr<SimpleOfdmWimaxPhy> >::iterator iter = m_phyList.begin (); iter != m_phyList.end (); ++iter)
+  bool cull = m_maxRange > 0 && senderMobility != 0;
+  uint32_t nCandidates = m_phyList.size ();
+  if (cull)
+    {
+      if (m_index.GetN () == 0)
+        {
+          m_index.SetCellSize (m_maxRange);
+        }
+      for (uint32_t k = m_index.GetN (); k < m_phyList.size (); k++)
+        {
+          m_index.Add (k, m_phyList[k]->GetDevice ()->GetNode ()->GetObject<MobilityModel> ());
+        }
+      m_index.GetCandidates (senderMobility->GetPosition (), m_maxRange, m_candidates);
+      nCandidates = m_candidates.size ();
+    }
+  bool matrix = m_propagationMatrix && senderMobility != 0 && m_loss != 0;
+  uint32_t senderIndex = 0;
+  if (matrix)
     {
+      if (m_matrix.GetN () == 0)
+        {
+          // the delay of the blocks is distance / 3e8 m/s
+          Ptr<ConstantSpeedPropagationDelayModel> delay = CreateObject<ConstantSpeedPropagationDelayModel> ();
+          delay->SetSpeed (300000000.0);
+          m_matrix.SetLossModel (m_loss);
+          m_matrix.SetDelayModel (delay);
+        }
+      for (uint32_t k = m_matrix.GetN (); k < m_phyList.size (); k++)
+        {
+          m_matrix.Add (m_phyList[k]->GetDevice ()->GetNode ()->GetObject<MobilityModel> ());
+        }
+      senderIndex = std::find (m_phyList.begin (), m_phyList.end (), phy) - m_phyList.begin ();
+    }
+  for (uint32_t k = 0; k < nCandidates; k++)
+    {
+      uint32_t j = cull ? m_candidates[k] : k;
+      Ptr<SimpleOfdmWimaxPhy> rxphy = m_phyList[j];
       Time delay = Seconds (0);
-      if (phy != *iter)
+      if (phy != rxphy)
         {
           double distance = 0;
-          receiverMobility = (*iter)->GetDevice ()->GetNode ()->GetObject<MobilityModel> ();
+          receiverMobility = rxphy->GetDevice ()->GetNode ()->GetObject<MobilityModel> ();
+          if (cull && receiverMobility != 0 && senderMobility->GetDistanceFrom (receiverMobility) > m_maxRange)
+            {
+              continue;
+            }
           if (receiverMobility != 0 && senderMobility != 0 && m_loss != 0)
             {
-              distance = senderMobility->GetDistanceFrom (receiverMobility);
-              delay =  Seconds (distance/300000000.0);
-              rxPowerDbm = m_loss->CalcRxPower (txPowerDbm, senderMobility, receiverMobility);
+              if (matrix)
+                {
+                  delay = m_matrix.GetDelay (senderIndex, j);
+                  rxPowerDbm = m_matrix.CalcRxPower (txPowerDbm, senderIndex, j);
+                }
+              else
+                {
+                  distance = senderMobility->GetDistanceFrom (receiverMobility);
+                  delay =  Seconds (distance/300000000.0);
+                  rxPowerDbm = m_loss->CalcRxPower (txPowerDbm, senderMobility, receiverMobility);
+                }
             }
 
-          param = new simpleOfdmSendParam (burstSize,
-                                           isFirstBlock,
-                                           frequency,
-                                           modulationType,
-                                           direction,
-                                           rxPowerDbm,
-                                           burst);
-          Ptr<Object> dstNetDevice = (*iter)->GetDevice ();
+          simpleOfdmSendParam param (burstSize,
+                                     true,
+                                     frequency,
+                                     modulationType,
+                                     direction,
+                                     rxPowerDbm,
+                                     burst);
+          Ptr<Object> dstNetDevice = rxphy->GetDevice ();
           uint32_t dstNode;
           if (dstNetDevice == 0)
             {
@@ -196,7 +257,7 @@ SimpleOfdmWimaxChannel::Send (Time BlockTime,
                                           delay,
                                           &SimpleOfdmWimaxChannel::EndSendDummyBlock,
                                           this,
-                                          *iter,
+                                          rxphy,
                                           param);
         }
     }
@@ -204,23 +265,22 @@ SimpleOfdmWimaxChannel::Send (Time BlockTime,
 }
 
 void
-SimpleOfdmWimaxChannel::EndSendDummyBlock (Ptr<SimpleOfdmWimaxPhy> rxphy, simpleOfdmSendParam * param)
+SimpleOfdmWimaxChannel::EndSendDummyBlock (Ptr<SimpleOfdmWimaxPhy> rxphy, simpleOfdmSendParam param)
 {
-  rxphy->StartReceive (param->GetBurstSize (),
-                       param->GetIsFirstBlock (),
-                       param->GetFrequency (),
-                       param->GetModulationType (),
-                       param->GetDirection (),
-                       param->GetRxPowerDbm (),
-                       param->GetBurst ());
-  delete param;
+  rxphy->StartReceive (param.GetBurstSize (),
+                       param.GetIsFirstBlock (),
+                       param.GetFrequency (),
+                       param.GetModulationType (),
+                       param.GetDirection (),
+                       param.GetRxPowerDbm (),
+                       param.GetBurst ());
 }
 
 int64_t
 SimpleOfdmWimaxChannel::AssignStreams (int64_t stream)
 {
   int64_t currentStream = stream;
-  typedef std::list<Ptr<SimpleOfdmWimaxPhy> > PhyList;
+  typedef std::vector<Ptr<SimpleOfdmWimaxPhy> > PhyList;
   for (PhyList::const_iterator i = m_phyList.begin (); i != m_phyList.end (); i++)
     {
       Ptr<SimpleOfdmWimaxPhy> simpleOfdm = (*i);
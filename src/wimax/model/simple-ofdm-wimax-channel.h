@@ -22,11 +22,13 @@
 #ifndef SIMPLE_OFDM_WIMAX_CHANNEL_H
 #define SIMPLE_OFDM_WIMAX_CHANNEL_H
 
-#include <list>
+#include <vector>
 #include "wimax-channel.h"
 #include "bvec.h"
 #include "wimax-phy.h"
 #include "ns3/propagation-loss-model.h"
+#include "ns3/spatial-index.h"
+#include "ns3/propagation-matrix.h"
 #include "simple-ofdm-send-param.h"
 
 namespace ns3 {
@@ -37,6 +39,16 @@ class SimpleOfdmWimaxPhy;
 
 /**
  * \ingroup wimax
+ *
+ * If the MaxRange attribute is set, the blocks are sent only to the PHYs
+ * within that distance of the sender, found with a SpatialIndex of the
+ * node positions. The PHYs whose node has no mobility model always
+ * receive the blocks.
+ *
+ * If the PropagationMatrix attribute is set, the loss and delay of the
+ * path between two PHYs are computed once, and again only when one of
+ * them moves, as explained in PropagationMatrix. The loss of
+ * RANDOM_PROPAGATION is still computed for each burst.
  */
 class SimpleOfdmWimaxChannel : public WimaxChannel
 {
@@ -65,12 +77,10 @@ public:
   SimpleOfdmWimaxChannel (PropModel propModel);
 
   /**
-   * \brief Sends a dummy fec block to all connected physical devices
-   * \param BlockTime the time needed to send the block
+   * \brief Sends the fec blocks of a burst to all connected physical devices
+   * \param BlockTime the time needed to send the blocks
    * \param burstSize the size of the burst
    * \param phy the sender device
-   * \param isFirstBlock true if this block is the first one, false otherwise
-   * \param isLastBlock true if this block is the last one, false otherwise
    * \param frequency the frequency on which the block is sent
    * \param modulationType the modulation used to send the fec block
    * \param direction uplink or downlink
@@ -78,8 +88,7 @@ public:
    * \param burst the packet burst to send
    */
   void Send (Time BlockTime,
-             uint32_t burstSize, Ptr<WimaxPhy> phy, bool isFirstBlock,
-             bool isLastBlock,
+             uint32_t burstSize, Ptr<WimaxPhy> phy,
              uint64_t frequency, WimaxPhy::ModulationType modulationType,
              uint8_t direction, double txPowerDbm, Ptr<PacketBurst> burst);
   /**
@@ -100,11 +109,16 @@ public:
 
 private:
   void DoAttach (Ptr<WimaxPhy> phy);
-  std::list<Ptr<SimpleOfdmWimaxPhy> > m_phyList;
+  std::vector<Ptr<SimpleOfdmWimaxPhy> > m_phyList;
   uint32_t DoGetNDevices (void) const;
-  void EndSendDummyBlock  (Ptr<SimpleOfdmWimaxPhy> rxphy, simpleOfdmSendParam * param);
+  void EndSendDummyBlock  (Ptr<SimpleOfdmWimaxPhy> rxphy, simpleOfdmSendParam param);
   Ptr<NetDevice> DoGetDevice (uint32_t i) const;
   Ptr<PropagationLossModel> m_loss;
+  double m_maxRange;                      ///< distance beyond which blocks are not sent, 0 for none
+  SpatialIndex m_index;                   ///< positions of the PHYs, by index in the PHY list
+  std::vector<uint32_t> m_candidates;     ///< PHYs near the sender of the last blocks
+  bool m_propagationMatrix;               ///< whether the paths between the PHYs are kept
+  PropagationMatrix m_matrix;             ///< paths between the PHYs, by index in the PHY list
 };
 
 } // namespace ns3
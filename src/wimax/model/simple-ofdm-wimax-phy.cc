@@ -127,7 +127,12 @@ TypeId SimpleOfdmWimaxPhy::GetTypeId (void)
     .AddTraceSource ("PhyRxDrop",
                      "Trace source indicating a packet has been dropped by the device during reception",
                      MakeTraceSourceAccessor (&SimpleOfdmWimaxPhy::m_phyRxDropTrace),
-                     "ns3::PacketBurst::TracedCallback");
+                     "ns3::PacketBurst::TracedCallback")
+
+    .AddTraceSource ("RxSnr",
+                     "Trace source indicating the SNR of a burst received on the receive frequency",
+                     MakeTraceSourceAccessor (&SimpleOfdmWimaxPhy::m_rxSnrTrace),
+                     "ns3::SimpleOfdmWimaxPhy::SnrTracedCallback");
   return tid;
 }
 
@@ -135,7 +140,6 @@ void
 SimpleOfdmWimaxPhy::InitSimpleOfdmWimaxPhy (void)
 {
   m_fecBlockSize = 0;
-  m_nrFecBlocksSent = 0;
   m_dataRateBpsk12 = 0;
   m_dataRateQpsk12 = 0;
   m_dataRateQpsk34 = 0;
@@ -153,14 +157,10 @@ SimpleOfdmWimaxPhy::InitSimpleOfdmWimaxPhy (void)
   m_nfft = 256;
   m_g = (double) 1 / 4;
   SetNrCarriers (192);
-  m_fecBlocks = new std::list<bvec>;
-  m_receivedFecBlocks = new std::list<bvec>;
   m_currentBurstSize = 0;
   m_noiseFigure = 5; // dB
   m_txPower = 30; // dBm
   SetBandwidth (10000000); // 10Mhz
-  m_nbErroneousBlock = 0;
-  m_nrRecivedFecBlocks = 0;
   m_snrToBlockErrorRateManager = new SNRToBlockErrorRateManager ();
 }
 
@@ -235,10 +235,6 @@ SimpleOfdmWimaxPhy::SetNoiseFigure (double noiseFigure)
 void
 SimpleOfdmWimaxPhy::DoDispose (void)
 {
-  delete m_receivedFecBlocks;
-  delete m_fecBlocks;
-  m_receivedFecBlocks = 0;
-  m_fecBlocks = 0;
   delete m_snrToBlockErrorRateManager;
   WimaxPhy::DoDispose ();
 }
@@ -275,71 +271,44 @@ SimpleOfdmWimaxPhy::Send (Ptr<PacketBurst> burst,
   if (GetState () != PHY_STATE_TX)
     {
       m_currentBurstSize = burst->GetSize ();
-      m_nrFecBlocksSent = 0;
       m_currentBurst = burst;
       SetBlockParameters (burst->GetSize (), modulationType);
       NotifyTxBegin (m_currentBurst);
-      StartSendDummyFecBlock (true, modulationType, direction);
+      StartSendFecBlocks (modulationType, direction);
       m_traceTx (burst);
     }
 }
 
 void
-SimpleOfdmWimaxPhy::StartSendDummyFecBlock (bool isFirstBlock,
-                                            WimaxPhy::ModulationType modulationType,
-                                            uint8_t direction)
+SimpleOfdmWimaxPhy::StartSendFecBlocks (WimaxPhy::ModulationType modulationType,
+                                        uint8_t direction)
 {
   SetState (PHY_STATE_TX);
-  bool isLastFecBlock = 0;
-  if (isFirstBlock)
-    {
-      m_blockTime = GetBlockTransmissionTime (modulationType);
-    }
+  m_blockTime = GetBlockTransmissionTime (modulationType);
+  // the FEC blocks of the burst are sent back to back, as one transmission
+  Time burstTime = m_blockTime * (int64_t) m_nrBlocks;
 
   SimpleOfdmWimaxChannel *channel = dynamic_cast<SimpleOfdmWimaxChannel*> (PeekPointer (GetChannel ()));
   NS_ASSERT (channel != 0);
 
-  if (m_nrRemainingBlocksToSend==1)
-    {
-      isLastFecBlock = true;
-    }
-  else
-    {
-      isLastFecBlock = false;
-    }
-  channel->Send (m_blockTime,
+  channel->Send (burstTime,
                  m_currentBurstSize,
                  this,
-                 isFirstBlock,
-                 isLastFecBlock,
                  GetTxFrequency (),
                  modulationType,
                  direction,
                  m_txPower,
                  m_currentBurst);
 
-  m_nrRemainingBlocksToSend--;
-  Simulator::Schedule (m_blockTime, &SimpleOfdmWimaxPhy::EndSendFecBlock, this, modulationType, direction);
+  Simulator::Schedule (burstTime, &SimpleOfdmWimaxPhy::EndSendFecBlocks, this);
 }
 
 
 void
-SimpleOfdmWimaxPhy::EndSendFecBlock (WimaxPhy::ModulationType modulationType,
-                                     uint8_t direction)
+SimpleOfdmWimaxPhy::EndSendFecBlocks (void)
 {
-  m_nrFecBlocksSent++;
   SetState (PHY_STATE_IDLE);
-
-  if (m_nrFecBlocksSent * m_blockSize == m_currentBurstSize * 8 + m_paddingBits)
-    {
-      // this is the last FEC block of the burst
-      NS_ASSERT_MSG (m_nrRemainingBlocksToSend == 0, "Error while sending a burst");
-      NotifyTxEnd (m_currentBurst);
-    }
-  else
-    {
-      StartSendDummyFecBlock (false,modulationType,direction);
-    }
+  NotifyTxEnd (m_currentBurst);
 }
 
 void
@@ -358,39 +327,30 @@ SimpleOfdmWimaxPhy::StartReceive (uint32_t burstSize,
                                   Ptr<PacketBurst> burst)
 {
 
-  uint8_t drop = 0;
   double Nwb = -114 + m_noiseFigure + 10 * std::log (GetBandwidth () / 1000000000.0) / 2.303;
   double SNR = rxPower - Nwb;
 
-  SNRToBlockErrorRateRecord * record = m_snrToBlockErrorRateManager->GetSNRToBlockErrorRateRecord (SNR, modulationType);
-  double I1 = record->GetI1 ();
-  double I2 = record->GetI2 ();
-
-  double blockErrorRate = m_URNG->GetValue (I1, I2);
-
-  double rand = m_URNG->GetValue (0.0, 1.0);
-
-  if (rand < blockErrorRate)
-    {
-      drop = 1;
-    }
-  if (rand > blockErrorRate)
-    {
-      drop = 0;
-    }
+  SNRToBlockErrorRateRecord record = m_snrToBlockErrorRateManager->GetRecord (SNR, modulationType);
+  double I1 = record.GetI1 ();
+  double I2 = record.GetI2 ();
 
-  if (blockErrorRate == 1.0)
-    {
-      drop = 1;
-    }
-  if (blockErrorRate == 0.0)
+  // the SNR is the same for all the FEC blocks of the burst: draw the
+  // error of each one at once
+  uint16_t nrBlocks = GetNrBlocks (burstSize, modulationType);
+  uint16_t nrErroneousBlocks = 0;
+  for (uint16_t i = 0; i < nrBlocks; i++)
     {
-      drop = 0;
+      double blockErrorRate = m_URNG->GetValue (I1, I2);
+      double rand = m_URNG->GetValue (0.0, 1.0);
+      if (blockErrorRate == 1.0 || (blockErrorRate != 0.0 && rand < blockErrorRate))
+        {
+          nrErroneousBlocks++;
+        }
     }
-  delete record;
 
   NS_LOG_INFO ("PHY: Receive rxPower=" << rxPower << ", Nwb=" << Nwb << ", SNR=" << SNR << ", Modulation="
-                                       << modulationType << ", BlocErrorRate=" << blockErrorRate << ", drop=" << (int) drop);
+                                       << modulationType << ", blocks=" << nrBlocks
+                                       << ", erroneous blocks=" << nrErroneousBlocks);
 
   switch (GetState ())
     {
@@ -406,22 +366,15 @@ SimpleOfdmWimaxPhy::StartReceive (uint32_t burstSize,
     case PHY_STATE_IDLE:
       if (frequency == GetRxFrequency ())
         {
-          if (isFirstBlock)
-            {
-              NotifyRxBegin (burst);
-              m_receivedFecBlocks->clear ();
-              m_nrRecivedFecBlocks=0;
-              SetBlockParameters (burstSize, modulationType);
-              m_blockTime = GetBlockTransmissionTime (modulationType);
-            }
-
-          Simulator::Schedule (m_blockTime,
-                               &SimpleOfdmWimaxPhy::EndReceiveFecBlock,
+          m_rxSnrTrace (SNR, direction);
+          NotifyRxBegin (burst);
+          SetBlockParameters (burstSize, modulationType);
+          m_blockTime = GetBlockTransmissionTime (modulationType);
+
+          Simulator::Schedule (m_blockTime * (int64_t) m_nrBlocks,
+                               &SimpleOfdmWimaxPhy::EndReceiveFecBlocks,
                                this,
-                               burstSize,
-                               modulationType,
-                               direction,
-                               drop,
+                               nrErroneousBlocks,
                                burst);
 
           SetState (PHY_STATE_RX);
@@ -440,36 +393,21 @@ SimpleOfdmWimaxPhy::StartReceive (uint32_t burstSize,
 }
 
 void
-SimpleOfdmWimaxPhy::EndReceiveFecBlock (uint32_t burstSize,
-                                        WimaxPhy::ModulationType modulationType,
-                                        uint8_t direction,
-                                        uint8_t drop,
-                                        Ptr<PacketBurst> burst)
+SimpleOfdmWimaxPhy::EndReceiveFecBlocks (uint16_t nrErroneousBlocks,
+                                         Ptr<PacketBurst> burst)
 {
   SetState (PHY_STATE_IDLE);
-  m_nrRecivedFecBlocks++;
-
-  if (drop == true)
+  NotifyRxEnd (burst);
+  if (nrErroneousBlocks == 0)
     {
-      m_nbErroneousBlock++;
+      Simulator::Schedule (Seconds (0),
+                           &SimpleOfdmWimaxPhy::EndReceive,
+                           this,
+                           burst);
     }
-
-  if ((uint32_t) m_nrRecivedFecBlocks * m_blockSize == burstSize * 8 + m_paddingBits)
+  else
     {
-      NotifyRxEnd (burst);
-      if (m_nbErroneousBlock == 0)
-        {
-          Simulator::Schedule (Seconds (0),
-                               &SimpleOfdmWimaxPhy::EndReceive,
-                               this,
-                               burst);
-        }
-      else
-        {
-          NotifyRxDrop (burst);
-        }
-      m_nbErroneousBlock = 0;
-      m_nrRecivedFecBlocks = 0;
+      NotifyRxDrop (burst);
     }
 }
 
@@ -481,137 +419,6 @@ SimpleOfdmWimaxPhy::EndReceive (Ptr<const PacketBurst> burst)
   m_traceRx (burst);
 }
 
-bvec
-SimpleOfdmWimaxPhy::ConvertBurstToBits (Ptr<const PacketBurst> burst)
-{
-  bvec buffer (burst->GetSize () * 8, 0);
-
-  std::list<Ptr<Packet> > packets = burst->GetPackets ();
-
-  uint32_t j = 0;
-  for (std::list<Ptr<Packet> >::iterator iter = packets.begin (); iter != packets.end (); ++iter)
-    {
-      Ptr<Packet> packet = *iter;
-      uint8_t *pstart = (uint8_t*) std::malloc (packet->GetSize ());
-      std::memset (pstart, 0, packet->GetSize ());
-      packet->CopyData (pstart, packet->GetSize ());
-      bvec temp (8);
-      temp.resize (0, 0);
-      temp.resize (8, 0);
-      for (uint32_t i = 0; i < packet->GetSize (); i++)
-        {
-          for (uint8_t l = 0; l < 8; l++)
-            {
-              temp[l] = (bool)((((uint8_t) pstart[i]) >> (7 - l)) & 0x01);
-              buffer.at (j * 8 + l) = temp[l];
-            }
-          j++;
-        }
-      std::free (pstart);
-    }
-
-  return buffer;
-}
-
-/*
- Converts back the bit buffer (bvec) to the actual burst.
- Actually creates byte buffer from the bvec and resets the buffer
- of each packet in the copy of the orifinal burst stored before transmitting.
- By doing this it preserves the metadata and tags in the packet.
- Function could also be named DeserializeBurst because actually it
- copying to the burst's byte buffer.
- */
-Ptr<PacketBurst>
-SimpleOfdmWimaxPhy::ConvertBitsToBurst (bvec buffer)
-{
-  uint8_t init[buffer.size () / 8];
-  uint8_t *pstart = init;
-  uint8_t temp;
-  int32_t j = 0;
-  // recreating byte buffer from bit buffer (bvec)
-  for (uint32_t i = 0; i < buffer.size (); i += 8)
-    {
-
-      temp = 0;
-      for (int l = 0; l < 8; l++)
-        {
-          bool bin = buffer.at (i + l);
-          temp += (uint8_t)(bin * std::pow (2.0, (7 - l)));
-        }
-
-      *(pstart + j) = temp;
-      j++;
-    }
-  uint16_t bufferSize = buffer.size () / 8;
-  uint16_t pos = 0;
-  Ptr<PacketBurst> RecvBurst = Create<PacketBurst> ();
-  while (pos < bufferSize)
-    {
-      uint16_t packetSize = 0;
-      // Get the header type: first bit
-      uint8_t ht = (pstart[pos] >> 7) & 0x01;
-      if (ht == 1)
-        {
-          // BW request header. Size is always 8 bytes
-          packetSize = 6;
-        }
-      else
-        {
-          // Read the size
-          uint8_t Len_MSB = pstart[pos + 1] & 0x07;
-          packetSize = (uint16_t)((uint16_t)(Len_MSB << 8) | (uint16_t)(pstart[pos + 2]));
-          if (packetSize == 0)
-            {
-              break; // padding
-            }
-        }
-
-      Ptr<Packet> p = Create<Packet> (&(pstart[pos]), packetSize);
-      RecvBurst->AddPacket (p);
-      pos += packetSize;
-    }
-  return RecvBurst;
-}
-
-void
-SimpleOfdmWimaxPhy::CreateFecBlocks (const bvec &buffer, WimaxPhy::ModulationType modulationType)
-{
-
-  bvec fecBlock (m_blockSize);
-  for (uint32_t i = 0, j = m_nrBlocks; j > 0; i += m_blockSize, j--)
-    {
-
-      if (j == 1 && m_paddingBits > 0) // last block can be smaller than block size
-        {
-          fecBlock = bvec (buffer.begin () + i, buffer.end ());
-          fecBlock.resize (m_blockSize, 0);
-        }
-      else
-        {
-          fecBlock = bvec (buffer.begin () + i, buffer.begin () + i + m_blockSize);
-        }
-
-      m_fecBlocks->push_back (fecBlock);
-    }
-}
-
-bvec
-SimpleOfdmWimaxPhy::RecreateBuffer ()
-{
-
-  bvec buffer (m_blockSize * (unsigned long)m_nrBlocks);
-  bvec block (m_blockSize);
-  uint32_t i = 0;
-  for (uint32_t j = 0; j < m_nrBlocks; j++)
-    {
-      bvec tmpRecFecBloc = m_receivedFecBlocks->front ();
-      buffer.insert (buffer.begin () + i, tmpRecFecBloc.begin (), tmpRecFecBloc.end ());
-      m_receivedFecBlocks->pop_front ();
-      i += m_blockSize;
-    }
-  return buffer;
-}
-
 void
 SimpleOfdmWimaxPhy::DoSetDataRates (void)
 {
@@ -811,7 +618,6 @@ SimpleOfdmWimaxPhy::SetBlockParameters (uint32_t burstSize, WimaxPhy::Modulation
   m_blockSize = GetFecBlockSize (modulationType);
   m_nrBlocks = GetNrBlocks (burstSize, modulationType);
   m_paddingBits = (m_nrBlocks * m_blockSize) - (burstSize * 8);
-  m_nrRemainingBlocksToSend = m_nrBlocks;
   NS_ASSERT_MSG (static_cast<uint32_t> (m_nrBlocks * m_blockSize) >= (burstSize * 8), "Size of padding bytes < 0");
 }
 
@@ -29,7 +29,6 @@
 #include "ns3/event-id.h"
 #include "ns3/random-variable-stream.h"
 #include "wimax-phy.h"
-#include "bvec.h"
 #include "ns3/snr-to-block-error-rate-manager.h"
 #include "wimax-connection.h"
 namespace ns3 {
@@ -61,6 +60,14 @@ public:
    * \param loss set to true to enable the loss model
    */
   void ActivateLoss (bool loss);
+
+  /**
+   * TracedCallback signature for the SNR of the received bursts.
+   *
+   * \param [in] snr The SNR, in dB.
+   * \param [in] direction The direction of the burst.
+   */
+  typedef void (* SnrTracedCallback)(double snr, uint8_t direction);
   /**
    * \brief Set the path of the repository containing the traces
    * \param tracesPath the path to the repository.
@@ -94,11 +101,12 @@ public:
    */
   WimaxPhy::PhyType GetPhyType (void) const;
   /**
-   * \brief start the reception of a fec block
+   * \brief start the reception of the fec blocks of a burst, and draw
+   * whether each one is received in error
    * \param burstSize the burst size
    * \param isFirstBlock true if this block is the first one, false otherwise
-   * \param frequency the frequency in wich the fec block is being received
-   * \param modulationType the modulation used to transmit this fec Block
+   * \param frequency the frequency in wich the fec blocks are being received
+   * \param modulationType the modulation used to transmit the fec blocks
    * \param direction set to uplink and downlink
    * \param rxPower the received power.
    * \param burst the burst to be sent
@@ -190,26 +198,16 @@ private:
   Time DoGetTransmissionTime (uint32_t size, WimaxPhy::ModulationType modulationType) const;
   uint64_t DoGetNrSymbols (uint32_t size, WimaxPhy::ModulationType modulationType) const;
   uint64_t DoGetNrBytes (uint32_t symbols, WimaxPhy::ModulationType modulationType) const;
-  bvec ConvertBurstToBits (Ptr<const PacketBurst> burst);
-  Ptr<PacketBurst> ConvertBitsToBurst (bvec buffer);
-  void CreateFecBlocks (const bvec &buffer, WimaxPhy::ModulationType modulationType);
-  bvec RecreateBuffer ();
   uint32_t GetFecBlockSize (WimaxPhy::ModulationType type) const;
   uint32_t GetCodedFecBlockSize (WimaxPhy::ModulationType modulationType) const;
   void SetBlockParameters (uint32_t burstSize, WimaxPhy::ModulationType modulationType);
   uint16_t GetNrBlocks (uint32_t burstSize, WimaxPhy::ModulationType modulationType) const;
   void DoDispose (void);
   void EndSend (void);
-  void EndSendFecBlock (WimaxPhy::ModulationType modulationType, uint8_t direction);
+  void EndSendFecBlocks (void);
   void EndReceive (Ptr<const PacketBurst> burst);
-  void EndReceiveFecBlock (uint32_t burstSize,
-                           WimaxPhy::ModulationType modulationType,
-                           uint8_t direction,
-                           uint8_t drop,
-                           Ptr<PacketBurst> burst);
-  void StartSendDummyFecBlock (bool isFirstBlock,
-                               WimaxPhy::ModulationType modulationType,
-                               uint8_t direction);
+  void EndReceiveFecBlocks (uint16_t nrErroneousBlocks, Ptr<PacketBurst> burst);
+  void StartSendFecBlocks (WimaxPhy::ModulationType modulationType, uint8_t direction);
   Time GetBlockTransmissionTime (WimaxPhy::ModulationType modulationType) const;
   void DoSetDataRates (void);
   void InitSimpleOfdmWimaxPhy (void);
@@ -241,9 +239,6 @@ private:
   uint16_t m_fecBlockSize; // in bits, size of FEC block transmitted after PHY operations
   uint32_t m_currentBurstSize;
 
-  std::list<bvec> *m_receivedFecBlocks; // a list of received FEC blocks until they are combined to recreate the full burst buffer
-  uint32_t m_nrFecBlocksSent; // counting the number of FEC blocks sent (within a burst)
-  std::list<bvec> *m_fecBlocks;
   Time m_blockTime;
 
   TracedCallback<Ptr<const PacketBurst> > m_traceRx;
@@ -255,12 +250,9 @@ private:
 
   // parameters to store for a per burst life-time
   uint16_t m_nrBlocks;
-  uint16_t m_nrRemainingBlocksToSend;
   Ptr<PacketBurst> m_currentBurst;
   uint16_t m_blockSize;
   uint32_t m_paddingBits;
-  uint16_t m_nbErroneousBlock;
-  uint16_t m_nrRecivedFecBlocks;
   uint16_t m_nfft;
   double m_g;
   double m_bandWidth;
@@ -327,6 +319,12 @@ private:
    */
   TracedCallback<Ptr<PacketBurst > > m_phyRxDropTrace;
 
+  /**
+   * The trace source fired with the SNR of each burst received on the
+   * receive frequency, when its reception begins.
+   */
+  TracedCallback<double, uint8_t> m_rxSnrTrace;
+
   SNRToBlockErrorRateManager * m_snrToBlockErrorRateManager;
 
   /// Provides uniform random variables.
@@ -24,6 +24,7 @@
 #define SNR_TO_BLOCK_ERROR_RATE_MANAGER_H
 
 #include "ns3/snr-to-block-error-rate-record.h"
+#include "ns3/snr-to-block-error-rate-table.h"
 #include <vector>
 #include "ns3/ptr.h"
 
@@ -73,6 +74,13 @@ public:
    * \return the Block Error Rate
    */
   double GetBlockErrorRate (double SNR, uint8_t modulation);
+  /**
+   * \brief returns the record corresponding to a given modulation and SNR value
+   * \param SNR the SNR value
+   * \param modulation one of the seven MCS
+   * \return the record, with all its error rates 0 if the losses are not activated
+   */
+  SNRToBlockErrorRateRecord GetRecord (double SNR, uint8_t modulation) const;
   SNRToBlockErrorRateRecord *
   /**
    * \brief returns a record of type SNRToBlockErrorRateRecord corresponding to a given modulation and SNR value
@@ -105,7 +113,7 @@ private:
   static const unsigned int TRACE_FILE_PATH_SIZE = 1024;
   char m_traceFilePath[TRACE_FILE_PATH_SIZE];
 
-  std::vector<SNRToBlockErrorRateRecord *> * m_recordModulation[7];
+  Ptr<const SNRToBlockErrorRateTable> m_table;
 
 };
 }
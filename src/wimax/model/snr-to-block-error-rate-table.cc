@@ -0,0 +1,273 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <map>
+#include <fstream>
+#include <sstream>
+#include "ns3/log.h"
+#include "ns3/assert.h"
+#include "snr-to-block-error-rate-table.h"
+#include "default-traces.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("SNRToBlockErrorRateTable");
+
+/// The largest number of SNR bins of a trace.
+static const uint32_t MAX_BINS = 65536;
+
+/// The tables in use, by key.
+typedef std::map<std::string, SNRToBlockErrorRateTable *> Tables;
+
+/**
+ * \returns the tables in use
+ */
+static Tables &
+GetTables (void)
+{
+  static Tables tables;
+  return tables;
+}
+
+/**
+ * \param values the trace of a modulation in default-traces.h
+ * \param points the points of the trace
+ */
+template <typename T, std::size_t N>
+static void
+CopyTrace (const double (&values)[6][N], std::vector<T> &points)
+{
+  points.resize (N);
+  for (std::size_t j = 0; j < N; j++)
+    {
+      points[j].snr = values[0][j];
+      points[j].bitErrorRate = values[1][j];
+      points[j].blockErrorRate = values[2][j];
+      points[j].sigma2 = values[3][j];
+      points[j].i1 = values[4][j];
+      points[j].i2 = values[5][j];
+    }
+}
+
+Ptr<const SNRToBlockErrorRateTable>
+SNRToBlockErrorRateTable::Get (std::string prefix)
+{
+  Tables::const_iterator it = GetTables ().find (prefix);
+  if (it != GetTables ().end ())
+    {
+      return it->second;
+    }
+  Ptr<SNRToBlockErrorRateTable> table (new SNRToBlockErrorRateTable (prefix), false);
+  if (!table->LoadFiles (prefix))
+    {
+      NS_LOG_INFO ("Unable to load " << prefix << "*.txt!! Loading default traces...");
+      return GetDefault ();
+    }
+  GetTables ()[prefix] = PeekPointer (table);
+  return table;
+}
+
+Ptr<const SNRToBlockErrorRateTable>
+SNRToBlockErrorRateTable::GetDefault (void)
+{
+  // the key of the default table is no file prefix
+  std::string key;
+  Tables::const_iterator it = GetTables ().find (key);
+  if (it != GetTables ().end ())
+    {
+      return it->second;
+    }
+  Ptr<SNRToBlockErrorRateTable> table (new SNRToBlockErrorRateTable (key), false);
+  table->LoadDefault ();
+  GetTables ()[key] = PeekPointer (table);
+  return table;
+}
+
+SNRToBlockErrorRateTable::SNRToBlockErrorRateTable (std::string key)
+  : m_key (key)
+{
+}
+
+SNRToBlockErrorRateTable::~SNRToBlockErrorRateTable ()
+{
+  Tables::iterator it = GetTables ().find (m_key);
+  if (it != GetTables ().end () && it->second == this)
+    {
+      GetTables ().erase (it);
+    }
+}
+
+bool
+SNRToBlockErrorRateTable::LoadFiles (std::string prefix)
+{
+  for (uint8_t i = 0; i < N_MODULATIONS; i++)
+    {
+      std::ostringstream name;
+      name << prefix << (int) i << ".txt";
+      std::ifstream file (name.str ().c_str ());
+      if (!file.good ())
+        {
+          return false;
+        }
+      Point point;
+      while (file >> point.snr >> point.bitErrorRate >> point.blockErrorRate
+             >> point.sigma2 >> point.i1 >> point.i2)
+        {
+          m_traces[i].points.push_back (point);
+        }
+      if (m_traces[i].points.empty ())
+        {
+          return false;
+        }
+      Index (m_traces[i]);
+    }
+  return true;
+}
+
+void
+SNRToBlockErrorRateTable::LoadDefault (void)
+{
+  CopyTrace (modulation0, m_traces[0].points);
+  CopyTrace (modulation1, m_traces[1].points);
+  CopyTrace (modulation2, m_traces[2].points);
+  CopyTrace (modulation3, m_traces[3].points);
+  CopyTrace (modulation4, m_traces[4].points);
+  CopyTrace (modulation5, m_traces[5].points);
+  CopyTrace (modulation6, m_traces[6].points);
+  for (uint8_t i = 0; i < N_MODULATIONS; i++)
+    {
+      Index (m_traces[i]);
+    }
+}
+
+void
+SNRToBlockErrorRateTable::Index (Trace &trace)
+{
+  const std::vector<Point> &points = trace.points;
+  uint32_t n = points.size ();
+  double range = points[n - 1].snr - points[0].snr;
+  double step = range;
+  for (uint32_t j = 1; j < n; j++)
+    {
+      double width = points[j].snr - points[j - 1].snr;
+      if (width > 0 && width < step)
+        {
+          step = width;
+        }
+    }
+  if (step <= 0)
+    {
+      // a single point, or a single SNR
+      trace.step = 1;
+      trace.bins.assign (1, std::min<uint32_t> (1, n - 1));
+      return;
+    }
+  uint32_t nBins = std::min<double> (range / step + 1, MAX_BINS);
+  if (nBins == MAX_BINS)
+    {
+      step = range / (MAX_BINS - 1);
+    }
+  trace.step = step;
+  trace.bins.resize (nBins);
+  uint32_t upper = 1;
+  for (uint32_t b = 0; b < nBins; b++)
+    {
+      double start = points[0].snr + b * step;
+      while (upper < n - 1 && points[upper].snr <= start)
+        {
+          upper++;
+        }
+      trace.bins[b] = upper;
+    }
+}
+
+uint32_t
+SNRToBlockErrorRateTable::FindUpper (const Trace &trace, double snr)
+{
+  const std::vector<Point> &points = trace.points;
+  uint32_t b = static_cast<uint32_t> ((snr - points[0].snr) / trace.step);
+  if (b >= trace.bins.size ())
+    {
+      b = trace.bins.size () - 1;
+    }
+  // the bin holds at most one point, unless there are too many to bin
+  // or the start of the bin is off by a rounding error
+  uint32_t i = trace.bins[b];
+  while (points[i].snr <= snr)
+    {
+      i++;
+    }
+  while (points[i - 1].snr > snr)
+    {
+      i--;
+    }
+  return i;
+}
+
+SNRToBlockErrorRateRecord
+SNRToBlockErrorRateTable::GetRecord (double snr, uint8_t modulation) const
+{
+  NS_ASSERT (modulation < N_MODULATIONS);
+  const Trace &trace = m_traces[modulation];
+  const std::vector<Point> &points = trace.points;
+  const Point &first = points.front ();
+  const Point &last = points.back ();
+  if (snr <= first.snr)
+    {
+      return SNRToBlockErrorRateRecord (first.snr, first.bitErrorRate, first.blockErrorRate,
+                                        first.sigma2, first.i1, first.i2);
+    }
+  if (snr >= last.snr)
+    {
+      return SNRToBlockErrorRateRecord (last.snr, last.bitErrorRate, last.blockErrorRate,
+                                        last.sigma2, last.i1, last.i2);
+    }
+  uint32_t i = FindUpper (trace, snr);
+  const Point &below = points[i - 1];
+  const Point &above = points[i];
+  double intervalSize = above.snr - below.snr;
+  double coeff1 = (snr - below.snr) / intervalSize;
+  double coeff2 = -1 * (snr - above.snr) / intervalSize;
+  return SNRToBlockErrorRateRecord (snr,
+                                    coeff2 * below.bitErrorRate + coeff1 * above.bitErrorRate,
+                                    coeff2 * below.blockErrorRate + coeff1 * above.blockErrorRate,
+                                    coeff2 * below.sigma2 + coeff1 * above.sigma2,
+                                    coeff2 * below.i1 + coeff1 * above.i1,
+                                    coeff2 * below.i2 + coeff1 * above.i2);
+}
+
+double
+SNRToBlockErrorRateTable::GetBlockErrorRate (double snr, uint8_t modulation) const
+{
+  NS_ASSERT (modulation < N_MODULATIONS);
+  const Trace &trace = m_traces[modulation];
+  const std::vector<Point> &points = trace.points;
+  if (snr <= points.front ().snr)
+    {
+      return 1;
+    }
+  if (snr >= points.back ().snr)
+    {
+      return 0;
+    }
+  uint32_t i = FindUpper (trace, snr);
+  double intervalSize = points[i].snr - points[i - 1].snr;
+  double coeff1 = (snr - points[i - 1].snr) / intervalSize;
+  double coeff2 = -1 * (snr - points[i].snr) / intervalSize;
+  return coeff2 * points[i - 1].blockErrorRate + coeff1 * points[i].blockErrorRate;
+}
+
+} // namespace ns3
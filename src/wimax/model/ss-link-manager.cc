@@ -414,6 +414,7 @@ SSLinkManager::PerformRanging (Cid cid,
         {
 
           m_ss->SetState (SubscriberStationNetDevice::SS_STATE_REGISTERED);
+          m_ss->LinkUp ();
           // initiate service flows
           if (m_ss->HasServiceFlows () && !m_ss->GetAreServiceFlowsAllocated ())
             {
@@ -59,46 +59,70 @@ SSManager::CreateSSRecord (const Mac48Address &macAddress)
 {
   SSRecord *ssRecord = new SSRecord (macAddress);
   m_ssRecords->push_back (ssRecord);
+  m_ssRecordsByMac.insert (std::make_pair (macAddress, ssRecord));
   return ssRecord;
 }
 
 SSRecord*
 SSManager::GetSSRecord (const Mac48Address &macAddress) const
 {
-  for (std::vector<SSRecord*>::iterator iter = m_ssRecords->begin (); iter != m_ssRecords->end (); ++iter)
+  std::map<Mac48Address, SSRecord*>::const_iterator iter = m_ssRecordsByMac.find (macAddress);
+  if (iter != m_ssRecordsByMac.end ())
     {
-      if ((*iter)->GetMacAddress () == macAddress)
-        {
-          return *iter;
-        }
+      return iter->second;
     }
 
   NS_LOG_DEBUG ("GetSSRecord: SSRecord not found!");
   return 0;
 }
 
+bool
+SSManager::HasCid (const SSRecord *ssRecord, Cid cid)
+{
+  if (ssRecord->GetBasicCid () == cid || ssRecord->GetPrimaryCid () == cid)
+    {
+      return true;
+    }
+  std::vector<ServiceFlow*> sf = ssRecord->GetServiceFlows (ServiceFlow::SF_TYPE_ALL);
+  for (std::vector<ServiceFlow*>::iterator iter = sf.begin (); iter != sf.end (); ++iter)
+    {
+      if ((*iter)->GetConnection ()->GetCid () == cid)
+        {
+          return true;
+        }
+    }
+  return false;
+}
+
 SSRecord*
 SSManager::GetSSRecord (Cid cid) const
 {
-  for (std::vector<SSRecord*>::iterator iter1 = m_ssRecords->begin (); iter1 != m_ssRecords->end (); ++iter1)
+  // the schedulers look the ss records up by cid every frame: the records
+  // found are remembered, and checked since they may have lost the cid
+  std::map<uint16_t, SSRecord*>::const_iterator found = m_ssRecordsByCid.find (cid.GetIdentifier ());
+  if (found != m_ssRecordsByCid.end () && HasCid (found->second, cid))
     {
-      SSRecord *ssRecord = *iter1;
-      if (ssRecord->GetBasicCid () == cid || ssRecord->GetPrimaryCid () == cid)
+      return found->second;
+    }
+  // an unknown cid: the cids of all the records are indexed at once, so
+  // that the flows added since the last miss do not cost a search each
+  m_ssRecordsByCid.clear ();
+  for (std::vector<SSRecord*>::iterator iter = m_ssRecords->begin (); iter != m_ssRecords->end (); ++iter)
+    {
+      SSRecord *ssRecord = *iter;
+      m_ssRecordsByCid.insert (std::make_pair (ssRecord->GetBasicCid ().GetIdentifier (), ssRecord));
+      m_ssRecordsByCid.insert (std::make_pair (ssRecord->GetPrimaryCid ().GetIdentifier (), ssRecord));
+      std::vector<ServiceFlow*> serviceFlows = ssRecord->GetServiceFlows (ServiceFlow::SF_TYPE_ALL);
+      for (std::vector<ServiceFlow*>::iterator iter2 = serviceFlows.begin (); iter2 != serviceFlows.end (); ++iter2)
         {
-          return ssRecord;
-        }
-      else
-        {
-          std::vector<ServiceFlow*> sf = ssRecord->GetServiceFlows (ServiceFlow::SF_TYPE_ALL);
-          for (std::vector<ServiceFlow*>::iterator iter2 = sf.begin (); iter2 != sf.end (); ++iter2)
-            {
-              if ((*iter2)->GetConnection ()->GetCid () == cid)
-                {
-                  return ssRecord;
-                }
-            }
+          m_ssRecordsByCid.insert (std::make_pair ((*iter2)->GetConnection ()->GetCid ().GetIdentifier (), ssRecord));
         }
     }
+  found = m_ssRecordsByCid.find (cid.GetIdentifier ());
+  if (found != m_ssRecordsByCid.end ())
+    {
+      return found->second;
+    }
 
   NS_LOG_DEBUG ("GetSSRecord: SSRecord not found!");
   return 0;
@@ -113,14 +137,7 @@ SSManager::GetSSRecords (void) const
 bool
 SSManager::IsInRecord (const Mac48Address &macAddress) const
 {
-  for (std::vector<SSRecord*>::iterator iter = m_ssRecords->begin (); iter != m_ssRecords->end (); ++iter)
-    {
-      if ((*iter)->GetMacAddress () == macAddress)
-        {
-          return true;
-        }
-    }
-  return false;
+  return m_ssRecordsByMac.find (macAddress) != m_ssRecordsByMac.end ();
 }
 
 bool
@@ -136,22 +153,34 @@ SSManager::DeleteSSRecord (Cid cid)
   for (std::vector<SSRecord*>::iterator iter1 = m_ssRecords->begin (); iter1 != m_ssRecords->end (); ++iter1)
     {
       SSRecord *ssRecord = *iter1;
-      if (ssRecord->GetBasicCid () == cid || ssRecord->GetPrimaryCid () == cid)
+      if (HasCid (ssRecord, cid))
         {
           m_ssRecords->erase (iter1);
-          return;
-        }
-      else
-        {
-          std::vector<ServiceFlow*> sf = ssRecord->GetServiceFlows (ServiceFlow::SF_TYPE_ALL);
-          for (std::vector<ServiceFlow*>::const_iterator iter2 = sf.begin (); iter2 != sf.end (); ++iter2)
+          std::map<Mac48Address, SSRecord*>::iterator byMac = m_ssRecordsByMac.find (ssRecord->GetMacAddress ());
+          if (byMac != m_ssRecordsByMac.end () && byMac->second == ssRecord)
             {
-              if ((*iter2)->GetConnection ()->GetCid () == cid)
+              m_ssRecordsByMac.erase (byMac);
+              for (std::vector<SSRecord*>::iterator iter2 = m_ssRecords->begin (); iter2 != m_ssRecords->end (); ++iter2)
                 {
-                  m_ssRecords->erase (iter1);
-                  return;
+                  if ((*iter2)->GetMacAddress () == ssRecord->GetMacAddress ())
+                    {
+                      m_ssRecordsByMac.insert (std::make_pair ((*iter2)->GetMacAddress (), *iter2));
+                      break;
+                    }
                 }
             }
+          for (std::map<uint16_t, SSRecord*>::iterator byCid = m_ssRecordsByCid.begin (); byCid != m_ssRecordsByCid.end (); )
+            {
+              if (byCid->second == ssRecord)
+                {
+                  m_ssRecordsByCid.erase (byCid++);
+                }
+              else
+                {
+                  ++byCid;
+                }
+            }
+          return;
         }
     }
 }
@@ -23,6 +23,7 @@
 #ifndef SS_MANAGER_H
 #define SS_MANAGER_H
 
+#include <map>
 #include <stdint.h>
 #include "cid.h"
 #include "ss-record.h"
@@ -59,7 +60,19 @@ public:
   uint32_t GetNSSs (void) const;
   uint32_t GetNRegisteredSSs (void) const;
 private:
+  /**
+   * \param ssRecord an ss record
+   * \param cid a cid
+   * \returns whether the cid is a basic, primary or transport cid of the
+   * ss record
+   */
+  static bool HasCid (const SSRecord *ssRecord, Cid cid);
+
   std::vector<SSRecord*> *m_ssRecords;
+  /// The ss records, by MAC address.
+  std::map<Mac48Address, SSRecord*> m_ssRecordsByMac;
+  /// The ss records found by cid, checked when used since their cids may change.
+  mutable std::map<uint16_t, SSRecord*> m_ssRecordsByCid;
 };
 
 } // namespace ns3
@@ -574,6 +574,7 @@ void
 SubscriberStationNetDevice::Stop (void)
 {
   SetState (SS_STATE_STOPPED);
+  LinkDown ();
 }
 
 void
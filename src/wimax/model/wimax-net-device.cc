@@ -146,6 +146,7 @@ WimaxNetDevice::WimaxNetDevice (void)
   m_burstProfileManager = CreateObject<BurstProfileManager> (this);
   m_bandwidthManager = CreateObject<BandwidthManager> (this);
   m_nrFrames = 0;
+  m_linkUp = false;
   m_direction = ~0;
   m_frameStartTime = Seconds (0);
 }
@@ -25,6 +25,8 @@
 #include "ns3/net-device-container.h"
 #include "ns3/wimax-helper.h"
 #include "ns3/snr-to-block-error-rate-manager.h"
+#include "ns3/simple-ofdm-wimax-phy.h"
+#include "ns3/packet-burst.h"
 
 using namespace ns3;
 
@@ -158,6 +160,178 @@ Ns3WimaxSNRtoBLERTestCase::DoRun (void)
     }
 }
 
+/*
+ * Test the lookup of the SNR to block error rate traces
+ */
+
+class Ns3WimaxSNRtoBLERLookupTestCase : public TestCase
+{
+public:
+  Ns3WimaxSNRtoBLERLookupTestCase ();
+  virtual ~Ns3WimaxSNRtoBLERLookupTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+};
+
+Ns3WimaxSNRtoBLERLookupTestCase::Ns3WimaxSNRtoBLERLookupTestCase ()
+  : TestCase ("Test the lookup of the SNR to block error rate traces")
+{
+}
+
+Ns3WimaxSNRtoBLERLookupTestCase::~Ns3WimaxSNRtoBLERLookupTestCase ()
+{
+}
+
+void
+Ns3WimaxSNRtoBLERLookupTestCase::DoRun (void)
+{
+  SNRToBlockErrorRateManager manager;
+  manager.LoadTraces ();
+
+  // the first points of the BPSK 1/2 trace are 0.5 dB: 0.98730 and 0.6 dB: 0.93240
+  SNRToBlockErrorRateRecord record = manager.GetRecord (0.5, 0);
+  NS_TEST_ASSERT_MSG_EQ_TOL (record.GetBlockErrorRate (), 0.98730, 1e-12, "Wrong value at a point");
+  record = manager.GetRecord (0.55, 0);
+  NS_TEST_ASSERT_MSG_EQ_TOL (record.GetBlockErrorRate (), (0.98730 + 0.93240) / 2, 1e-9,
+                             "Wrong interpolation");
+  NS_TEST_ASSERT_MSG_EQ_TOL (record.GetSNRValue (), 0.55, 1e-12, "Wrong SNR");
+  NS_TEST_ASSERT_MSG_EQ_TOL (manager.GetBlockErrorRate (0.55, 0), (0.98730 + 0.93240) / 2, 1e-9,
+                             "Wrong interpolation");
+
+  // outside of the traces
+  record = manager.GetRecord (-10, 0);
+  NS_TEST_ASSERT_MSG_EQ (record.GetSNRValue (), 0, "Not the first point");
+  NS_TEST_ASSERT_MSG_EQ (record.GetBlockErrorRate (), 1, "Not the first point");
+  NS_TEST_ASSERT_MSG_EQ (manager.GetBlockErrorRate (-10, 0), 1, "Wrong rate below the trace");
+  record = manager.GetRecord (100, 6);
+  NS_TEST_ASSERT_MSG_EQ (record.GetBlockErrorRate (), 0, "Not the last point");
+  NS_TEST_ASSERT_MSG_EQ (manager.GetBlockErrorRate (100, 6), 0, "Wrong rate above the trace");
+
+  // inside the traces, the record and the rate are interpolated alike
+  for (uint8_t modulation = 0; modulation < 7; modulation++)
+    {
+      for (double snr = -5; snr < 40; snr += 0.013)
+        {
+          record = manager.GetRecord (snr, modulation);
+          double rate = record.GetBlockErrorRate ();
+          NS_TEST_ASSERT_MSG_EQ ((rate >= 0 && rate <= 1), true, "Wrong rate at " << snr << " dB");
+          if (record.GetSNRValue () == snr)
+            {
+              NS_TEST_ASSERT_MSG_EQ (manager.GetBlockErrorRate (snr, modulation), rate,
+                                     "Inconsistent rate at " << snr << " dB");
+            }
+        }
+    }
+
+  // the managers loading the same traces share them, and the losses
+  // can be turned off in one of them only
+  SNRToBlockErrorRateManager other;
+  other.LoadTraces ();
+  other.ActivateLoss (false);
+  NS_TEST_ASSERT_MSG_EQ (other.GetRecord (0.55, 0).GetBlockErrorRate (), 0, "Losses not turned off");
+  NS_TEST_ASSERT_MSG_EQ_TOL (manager.GetRecord (0.55, 0).GetBlockErrorRate (), (0.98730 + 0.93240) / 2, 1e-9,
+                             "Losses turned off in the other manager");
+}
+
+/*
+ * Receive bursts of several fec blocks at a SNR where some of the blocks
+ * are in error, and check that each burst is either delivered or dropped
+ * as a whole
+ */
+
+class Ns3WimaxBurstLossTestCase : public TestCase
+{
+public:
+  Ns3WimaxBurstLossTestCase ();
+  virtual ~Ns3WimaxBurstLossTestCase ();
+
+private:
+  virtual void DoRun (void);
+  void Send (Ptr<SimpleOfdmWimaxPhy> phy, Ptr<PacketBurst> burst, double rxPowerDbm);
+  void Receive (Ptr<const PacketBurst> burst);
+  void Drop (Ptr<PacketBurst> burst);
+
+  uint32_t m_received;
+  uint32_t m_dropped;
+  uint32_t m_incomplete;
+};
+
+Ns3WimaxBurstLossTestCase::Ns3WimaxBurstLossTestCase ()
+  : TestCase ("Test that a burst is received or dropped as a whole"),
+    m_received (0),
+    m_dropped (0),
+    m_incomplete (0)
+{
+}
+
+Ns3WimaxBurstLossTestCase::~Ns3WimaxBurstLossTestCase ()
+{
+}
+
+void
+Ns3WimaxBurstLossTestCase::Send (Ptr<SimpleOfdmWimaxPhy> phy, Ptr<PacketBurst> burst, double rxPowerDbm)
+{
+  phy->StartReceive (burst->GetSize (), true, phy->GetRxFrequency (), WimaxPhy::MODULATION_TYPE_QPSK_12,
+                     0, rxPowerDbm, burst);
+}
+
+void
+Ns3WimaxBurstLossTestCase::Receive (Ptr<const PacketBurst> burst)
+{
+  m_received++;
+  if (burst->GetNPackets () != 3)
+    {
+      m_incomplete++;
+    }
+}
+
+void
+Ns3WimaxBurstLossTestCase::Drop (Ptr<PacketBurst> burst)
+{
+  m_dropped++;
+}
+
+void
+Ns3WimaxBurstLossTestCase::DoRun (void)
+{
+  uint64_t frequency = 5000000;
+  Ptr<SimpleOfdmWimaxPhy> phy = CreateObject<SimpleOfdmWimaxPhy> ();
+  phy->SetFrameDuration (Seconds (0.01));
+  phy->SetPhyParameters ();
+  phy->SetDataRates ();
+  phy->SetSimplex (frequency);
+  phy->SetState (WimaxPhy::PHY_STATE_IDLE);
+  phy->ActivateLoss (true);
+  phy->WimaxPhy::SetReceiveCallback (MakeCallback (&Ns3WimaxBurstLossTestCase::Receive, this));
+  phy->TraceConnectWithoutContext ("PhyRxDrop", MakeCallback (&Ns3WimaxBurstLossTestCase::Drop, this));
+
+  // a QPSK 1/2 fec block carries 24 bits, so that the bursts of 60 bytes
+  // span 20 blocks. 3.8 dB above the noise of a 10 MHz channel, about one
+  // block in a hundred and one burst in ten are in error
+  double noise = -114 + phy->GetNoiseFigure () + 10 * std::log10 (phy->GetBandwidth () / 1000000000.0);
+  uint32_t nBursts = 200;
+  for (uint32_t i = 0; i < nBursts; i++)
+    {
+      Ptr<PacketBurst> burst = Create<PacketBurst> ();
+      for (uint32_t j = 0; j < 3; j++)
+        {
+          burst->AddPacket (Create<Packet> (20));
+        }
+      Simulator::Schedule (MilliSeconds (10 * i), &Ns3WimaxBurstLossTestCase::Send, this,
+                           phy, burst, noise + 3.8);
+    }
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  NS_TEST_ASSERT_MSG_EQ (m_received + m_dropped, nBursts, "Bursts neither received nor dropped");
+  NS_TEST_ASSERT_MSG_EQ (m_incomplete, 0, "Part of a burst received");
+  NS_TEST_ASSERT_MSG_GT (m_received, 0, "No burst received");
+  NS_TEST_ASSERT_MSG_GT (m_dropped, 0, "No burst dropped");
+  phy->Dispose ();
+}
+
 /*
  * The test suite
  */
@@ -170,7 +344,9 @@ Ns3WimaxPhyTestSuite::Ns3WimaxPhyTestSuite ()
   : TestSuite ("wimax-phy-layer", UNIT)
 {
   AddTestCase (new Ns3WimaxSNRtoBLERTestCase, TestCase::QUICK);
+  AddTestCase (new Ns3WimaxSNRtoBLERLookupTestCase, TestCase::QUICK);
   AddTestCase (new Ns3WimaxSimpleOFDMTestCase, TestCase::QUICK);
+  AddTestCase (new Ns3WimaxBurstLossTestCase, TestCase::QUICK);
 
 }
 
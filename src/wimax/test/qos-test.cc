@@ -30,6 +30,12 @@
 #include "ns3/ipv4-address.h"
 #include "ns3/service-flow.h"
 #include "ns3/ipcs-classifier-record.h"
+#include "ns3/bs-net-device.h"
+#include "ns3/bs-scheduler.h"
+#include "ns3/bs-service-flow-manager.h"
+#include "ns3/connection-manager.h"
+#include "ns3/wimax-connection.h"
+#include "ns3/packet.h"
 
 using namespace ns3;
 
@@ -272,6 +278,137 @@ Ns3WimaxSFTypeTestCase::DoRun ()
     }
 }
 
+// =============================================================================
+/*
+ * Test the selections of the simple downlink scheduler of the base station:
+ * the UGS flows due are served in the order of the service flow manager,
+ * whatever their deadlines, and the connections emptied aside from the
+ * scheduler are skipped until they get packets again.
+ */
+class Ns3WimaxBsSchedulerTestCase : public TestCase
+{
+public:
+  Ns3WimaxBsSchedulerTestCase ();
+  virtual ~Ns3WimaxBsSchedulerTestCase ();
+
+private:
+  virtual void DoRun (void);
+  /**
+   * \brief Add a downlink service flow to the base station.
+   * \param schedulingType the scheduling type of the flow
+   * \param maxLatency its maximum latency in ms
+   * \returns the connection of the flow
+   */
+  Ptr<WimaxConnection> AddFlow (ServiceFlow::SchedulingType schedulingType, uint32_t maxLatency);
+  /**
+   * \brief Queue a packet on a connection of the base station.
+   * \param connection the connection
+   */
+  void Enqueue (Ptr<WimaxConnection> connection);
+  /**
+   * \returns the connection selected by the scheduler, or 0
+   */
+  Ptr<WimaxConnection> Select (void);
+  /// Add the flows and check the selections, once their deadlines passed.
+  void Check (void);
+
+  Ptr<BaseStationNetDevice> m_bs;   //!< The base station.
+  uint32_t m_sfid;                  //!< The sfid of the next flow.
+};
+
+Ns3WimaxBsSchedulerTestCase::Ns3WimaxBsSchedulerTestCase ()
+  : TestCase ("Test the connection selection of the simple BS scheduler"),
+    m_sfid (100)
+{
+}
+
+Ns3WimaxBsSchedulerTestCase::~Ns3WimaxBsSchedulerTestCase ()
+{
+}
+
+Ptr<WimaxConnection>
+Ns3WimaxBsSchedulerTestCase::AddFlow (ServiceFlow::SchedulingType schedulingType, uint32_t maxLatency)
+{
+  Ptr<WimaxConnection> connection = m_bs->GetConnectionManager ()->CreateConnection (Cid::TRANSPORT);
+  ServiceFlow *serviceFlow = new ServiceFlow (m_sfid++, ServiceFlow::SF_DIRECTION_DOWN, connection);
+  connection->SetServiceFlow (serviceFlow);
+  serviceFlow->SetServiceSchedulingType (schedulingType);
+  serviceFlow->SetMaximumLatency (maxLatency);
+  serviceFlow->SetIsEnabled (true);
+  serviceFlow->SetType (ServiceFlow::SF_TYPE_ACTIVE);
+  m_bs->GetServiceFlowManager ()->AddServiceFlow (serviceFlow);
+  return connection;
+}
+
+void
+Ns3WimaxBsSchedulerTestCase::Enqueue (Ptr<WimaxConnection> connection)
+{
+  NS_TEST_ASSERT_MSG_EQ (m_bs->Enqueue (Create<Packet> (100), MacHeaderType (), connection), true,
+                         "The packet should be queued");
+}
+
+Ptr<WimaxConnection>
+Ns3WimaxBsSchedulerTestCase::Select (void)
+{
+  Ptr<WimaxConnection> connection;
+  if (!m_bs->GetBSScheduler ()->SelectConnection (connection))
+    {
+      return 0;
+    }
+  return connection;
+}
+
+void
+Ns3WimaxBsSchedulerTestCase::Check (void)
+{
+  // never served, the flows are due since their maximum latency (minus a
+  // frame): the second one is the most urgent, the first one the least
+  Ptr<WimaxConnection> first = AddFlow (ServiceFlow::SF_TYPE_UGS, 50);
+  Ptr<WimaxConnection> second = AddFlow (ServiceFlow::SF_TYPE_UGS, 30);
+  Ptr<WimaxConnection> third = AddFlow (ServiceFlow::SF_TYPE_UGS, 40);
+  Enqueue (third);
+  Enqueue (second);
+  Enqueue (first);
+  NS_TEST_EXPECT_MSG_EQ (Select (), first, "The first UGS flow should be served first");
+  NS_TEST_EXPECT_MSG_EQ (Select (), second, "The second UGS flow should be served next");
+  NS_TEST_EXPECT_MSG_EQ (Select (), third, "The third UGS flow should be served last");
+  // still having packets, but their deadlines moved
+  NS_TEST_EXPECT_MSG_EQ (Select (), Ptr<WimaxConnection> (0), "The UGS flows served should not be due any more");
+
+  Ptr<WimaxConnection> be1 = AddFlow (ServiceFlow::SF_TYPE_BE, 100);
+  Ptr<WimaxConnection> be2 = AddFlow (ServiceFlow::SF_TYPE_BE, 100);
+  Enqueue (be1);
+  Enqueue (be2);
+  be1->Dequeue ();
+  NS_TEST_EXPECT_MSG_EQ (Select (), be2, "The emptied BE flow should be skipped");
+  be2->Dequeue ();
+  NS_TEST_EXPECT_MSG_EQ (Select (), Ptr<WimaxConnection> (0), "No flow should be selected");
+  Enqueue (be1);
+  NS_TEST_EXPECT_MSG_EQ (Select (), be1, "The BE flow found empty should be served once it has packets again");
+
+  // no subscriber station owns the flows: the frames must not send them
+  Simulator::Stop ();
+}
+
+void
+Ns3WimaxBsSchedulerTestCase::DoRun ()
+{
+  NodeContainer bsNodes;
+  bsNodes.Create (1);
+  WimaxHelper wimax;
+  NetDeviceContainer bsDevs = wimax.Install (bsNodes,
+                                             WimaxHelper::DEVICE_TYPE_BASE_STATION,
+                                             WimaxHelper::SIMPLE_PHY_TYPE_OFDM,
+                                             WimaxHelper::SCHED_TYPE_SIMPLE);
+  m_bs = bsDevs.Get (0)->GetObject<BaseStationNetDevice> ();
+
+  // between two frames, so that the base station does not send the packets
+  Simulator::Schedule (Seconds (0.2) + MicroSeconds (1), &Ns3WimaxBsSchedulerTestCase::Check, this);
+  Simulator::Run ();
+  m_bs = 0;
+  Simulator::Destroy ();
+}
+
 class Ns3WimaxQoSTestSuite : public TestSuite
 {
 public:
@@ -283,6 +420,7 @@ Ns3WimaxQoSTestSuite::Ns3WimaxQoSTestSuite ()
 {
   AddTestCase (new Ns3WimaxSFTypeTestCase, TestCase::QUICK);
   AddTestCase (new Ns3WimaxSchedulingTestCase, TestCase::QUICK);
+  AddTestCase (new Ns3WimaxBsSchedulerTestCase, TestCase::QUICK);
 }
 
 static Ns3WimaxQoSTestSuite ns3WimaxQoSTestSuite;
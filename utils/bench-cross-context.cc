@@ -0,0 +1,129 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/*
+ * Stress the injection of events from foreign threads, the path taken
+ * by the packets read by fd-net-device and tap-bridge: several threads
+ * call Simulator::ScheduleWithContext as fast as they can while the
+ * simulator runs them.
+ */
+
+#include <iostream>
+#include <list>
+#include <stdlib.h> // for exit ()
+
+#include "ns3/core-module.h"
+
+using namespace ns3;
+
+/** Number of events run, only touched by the simulator thread. */
+static uint32_t g_received = 0;
+/** Number of events to run. */
+static uint32_t g_total = 0;
+/** Number of events injected by each thread. */
+static uint32_t g_perThread = 0;
+/** The producer threads. */
+static std::list<Ptr<SystemThread> > g_threads;
+
+static void
+Receive (void)
+{
+  g_received++;
+}
+
+static void
+Produce (uint32_t context)
+{
+  for (uint32_t i = 0; i < g_perThread; i++)
+    {
+      Simulator::ScheduleWithContext (context, Seconds (0), &Receive);
+    }
+}
+
+static void
+Poll (void)
+{
+  if (g_received < g_total)
+    {
+      Simulator::Schedule (MicroSeconds (10), &Poll);
+    }
+  else
+    {
+      Simulator::Stop ();
+    }
+}
+
+static void
+Start (void)
+{
+  for (std::list<Ptr<SystemThread> >::iterator i = g_threads.begin (); i != g_threads.end (); i++)
+    {
+      (*i)->Start ();
+    }
+  Poll ();
+}
+
+int main (int argc, char *argv[])
+{
+  uint32_t threads = 4;
+  uint32_t n = 100000;
+  bool realtime = false;
+
+  CommandLine cmd;
+  cmd.Usage ("Benchmark Simulator::ScheduleWithContext from several threads.");
+  cmd.AddValue ("threads", "number of producer threads", threads);
+  cmd.AddValue ("n", "number of events injected by each thread", n);
+  cmd.AddValue ("realtime", "use RealtimeSimulatorImpl", realtime);
+  cmd.Parse (argc, argv);
+
+  if (threads == 0 || n == 0)
+    {
+      std::cerr << "Error-- the number of threads and events must not be 0" << std::endl;
+      exit (1);
+    }
+  if (realtime)
+    {
+      GlobalValue::Bind ("SimulatorImplementationType",
+                         StringValue ("ns3::RealtimeSimulatorImpl"));
+    }
+
+  g_perThread = n;
+  g_total = threads * n;
+  for (uint32_t i = 0; i < threads; i++)
+    {
+      g_threads.push_back (Create<SystemThread> (MakeBoundCallback (&Produce, i)));
+    }
+  Simulator::Schedule (Seconds (0), &Start);
+
+  SystemWallClockMs time;
+  time.Start ();
+  Simulator::Run ();
+  uint64_t deltaMs = time.End ();
+  for (std::list<Ptr<SystemThread> >::iterator i = g_threads.begin (); i != g_threads.end (); i++)
+    {
+      (*i)->Join ();
+    }
+  Simulator::Destroy ();
+
+  double s = (deltaMs ? deltaMs : 1) / 1000.0;
+  std::cout << (realtime ? "realtime" : "default")
+            << " " << threads << " threads: "
+            << g_received << " events in " << s << " s, "
+            << (g_received / s) << " events/s, "
+            << (s * 1e9 / g_received) << " ns/event"
+            << std::endl;
+  return 0;
+}
@@ -0,0 +1,109 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/*
+ * Measure the demultiplexing of the IPv6 packets received by a server
+ * with many sockets: a listening socket on the server port, one
+ * connected socket per client (each client is a mobile node bound to
+ * its home address), and some unconnected sockets on other ports.
+ */
+
+#include <iostream>
+#include <vector>
+#include <stdlib.h> // for exit ()
+
+#include "ns3/core-module.h"
+#include "ns3/ipv6-address.h"
+#include "src/internet/model/ipv6-end-point.h"
+#include "src/internet/model/ipv6-end-point-demux.h"
+
+using namespace ns3;
+
+/**
+ * \param [in] i The client index.
+ * \returns The home address of the client.
+ */
+static Ipv6Address
+MakeClientAddress (uint32_t i)
+{
+  uint8_t buf[16] = { 0x20, 0x01, 0, 0x10, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 };
+  buf[4] = i >> 24;
+  buf[5] = i >> 16;
+  buf[6] = i >> 8;
+  buf[7] = i;
+  buf[15] = 1;
+  return Ipv6Address (buf);
+}
+
+int main (int argc, char *argv[])
+{
+  uint32_t sockets = 10000;
+  uint32_t n = 200000;
+
+  CommandLine cmd;
+  cmd.Usage ("Benchmark the IPv6 end point demultiplexer with many sockets.");
+  cmd.AddValue ("sockets", "number of connected sockets", sockets);
+  cmd.AddValue ("n", "number of lookups", n);
+  cmd.Parse (argc, argv);
+
+  if (sockets == 0 || n == 0)
+    {
+      std::cerr << "Error-- the number of sockets and of lookups must not be 0" << std::endl;
+      exit (1);
+    }
+
+  Ipv6Address server ("2001:1::1");
+  uint16_t port = 7;
+  Ipv6EndPointDemux demux;
+  demux.Allocate (port);
+  for (uint32_t i = 0; i < 100; i++)
+    {
+      demux.Allocate (server, 1000 + i);
+    }
+
+  SystemWallClockMs time;
+  time.Start ();
+  std::vector<Ipv6EndPoint *> endPoints;
+  for (uint32_t i = 0; i < sockets; i++)
+    {
+      endPoints.push_back (demux.Allocate (server, port, MakeClientAddress (i), 49152));
+    }
+  uint64_t allocateMs = time.End ();
+
+  uint64_t found = 0;
+  time.Start ();
+  for (uint32_t i = 0; i < n; i++)
+    {
+      uint32_t client = (i * 7919) % sockets;
+      found += demux.Lookup (server, port, MakeClientAddress (client), 49152, 0).size ();
+    }
+  uint64_t lookupMs = time.End ();
+
+  // reconnections: each socket is closed and reopened
+  time.Start ();
+  for (uint32_t i = 0; i < sockets; i++)
+    {
+      demux.DeAllocate (endPoints[i]);
+      endPoints[i] = demux.Allocate (server, port, MakeClientAddress (i), 49153);
+    }
+  uint64_t churnMs = time.End ();
+
+  std::cout << sockets << " sockets: allocate " << allocateMs * 1e6 / sockets << " ns, "
+            << "lookup " << lookupMs * 1e6 / n << " ns, "
+            << "deallocate and allocate " << churnMs * 1e6 / sockets << " ns"
+            << " (" << found << " found)" << std::endl;
+  return 0;
+}
@@ -0,0 +1,113 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/*
+ * Measure the cost of Object::GetObject on a node carrying a full
+ * IPv4/IPv6 stack, i.e. the lookups the protocols and the MIPv6 agents
+ * perform on their node for every packet.
+ */
+
+#include "ns3/command-line.h"
+#include "ns3/system-wall-clock-ms.h"
+#include "ns3/node.h"
+#include "ns3/internet-stack-helper.h"
+#include "ns3/ipv4-l3-protocol.h"
+#include "ns3/ipv6-l3-protocol.h"
+#include "ns3/icmpv6-l4-protocol.h"
+#include "ns3/udp-l4-protocol.h"
+#include "ns3/tcp-l4-protocol.h"
+#include "ns3/arp-l3-protocol.h"
+#include <iostream>
+#include <string>
+#include <stdlib.h> // for exit ()
+
+using namespace ns3;
+
+template <typename T>
+static void
+RunBench (Ptr<Node> node, std::string name, uint32_t n)
+{
+  uint32_t found = 0;
+  SystemWallClockMs time;
+  time.Start ();
+  for (uint32_t i = 0; i < n; i++)
+    {
+      if (node->GetObject<T> () != 0)
+        {
+          found++;
+        }
+    }
+  uint64_t deltaMs = time.End ();
+  double ps = n * 1000.0 / (deltaMs ? deltaMs : 1);
+  std::cout << name
+            << " " << ps << " lookups/s"
+            << " (" << deltaMs << " ms elapsed, "
+            << found << " found)"
+            << std::endl;
+}
+
+static void
+RunMixed (Ptr<Node> node, uint32_t n)
+{
+  uint32_t found = 0;
+  SystemWallClockMs time;
+  time.Start ();
+  for (uint32_t i = 0; i < n; i++)
+    {
+      found += node->GetObject<Ipv6L3Protocol> () != 0;
+      found += node->GetObject<Icmpv6L4Protocol> () != 0;
+      found += node->GetObject<UdpL4Protocol> () != 0;
+      found += node->GetObject<Ipv4L3Protocol> () != 0;
+    }
+  uint64_t deltaMs = time.End ();
+  double ps = n * 4000.0 / (deltaMs ? deltaMs : 1);
+  std::cout << "mixed"
+            << " " << ps << " lookups/s"
+            << " (" << deltaMs << " ms elapsed, "
+            << found << " found)"
+            << std::endl;
+}
+
+int main (int argc, char *argv[])
+{
+  uint32_t n = 0;
+  CommandLine cmd;
+  cmd.Usage ("Benchmark Object::GetObject on a node with an internet stack.");
+  cmd.AddValue ("n", "number of lookups of each type", n);
+  cmd.Parse (argc, argv);
+
+  if (n == 0)
+    {
+      std::cerr << "Error-- number of lookups must be specified " <<
+        "by command-line argument --n=(number of lookups)" << std::endl;
+      exit (1);
+    }
+
+  Ptr<Node> node = CreateObject<Node> ();
+  InternetStackHelper internet;
+  internet.Install (node);
+
+  std::cout << "Running bench-get-object with n=" << n << std::endl;
+  RunBench<Ipv6L3Protocol> (node, "Ipv6L3Protocol", n);
+  RunBench<Icmpv6L4Protocol> (node, "Icmpv6L4Protocol", n);
+  RunBench<UdpL4Protocol> (node, "UdpL4Protocol", n);
+  RunBench<TcpL4Protocol> (node, "TcpL4Protocol", n);
+  RunBench<ArpL3Protocol> (node, "ArpL3Protocol", n);
+  RunBench<Ipv6> (node, "Ipv6", n);
+  RunMixed (node, n);
+
+  return 0;
+}
@@ -0,0 +1,174 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/*
+ * Measure the lookups of IPv6 addresses in the hash maps used by the
+ * neighbor and binding caches, with the hash and comparison of
+ * Ipv6Address, and with the byte-wise hash and memcmp they replaced.
+ * The addresses are those of hosts in a few /64 subnets, which differ
+ * only in their last bytes.
+ */
+
+#include <iostream>
+#include <vector>
+#include <cstring>
+#include <stdlib.h> // for exit ()
+
+#include "ns3/core-module.h"
+#include "ns3/ipv6-address.h"
+#include "ns3/sgi-hashmap.h"
+
+using namespace ns3;
+
+/**
+ * The former Ipv6AddressHash: Bob Jenkins' lookup2 on the bytes of
+ * the address.
+ */
+class BytesHash : public std::unary_function<Ipv6Address, size_t>
+{
+public:
+  size_t operator () (Ipv6Address const &x) const
+  {
+    uint8_t k[16];
+    x.GetBytes (k);
+    uint32_t a = 0x9e3779b9;
+    uint32_t b = 0x9e3779b9;
+    uint32_t c = 0;
+    a += k[0] + ((uint32_t)k[1] << 8) + ((uint32_t)k[2] << 16) + ((uint32_t)k[3] << 24);
+    b += k[4] + ((uint32_t)k[5] << 8) + ((uint32_t)k[6] << 16) + ((uint32_t)k[7] << 24);
+    c += k[8] + ((uint32_t)k[9] << 8) + ((uint32_t)k[10] << 16) + ((uint32_t)k[11] << 24);
+    Mix (a, b, c);
+    c += 16;
+    a += k[12] + ((uint32_t)k[13] << 8) + ((uint32_t)k[14] << 16) + ((uint32_t)k[15] << 24);
+    Mix (a, b, c);
+    return c;
+  }
+
+private:
+  static void Mix (uint32_t &a, uint32_t &b, uint32_t &c)
+  {
+    a -= b; a -= c; a ^= (c >> 13);
+    b -= c; b -= a; b ^= (a << 8);
+    c -= a; c -= b; c ^= (b >> 13);
+    a -= b; a -= c; a ^= (c >> 12);
+    b -= c; b -= a; b ^= (a << 16);
+    c -= a; c -= b; c ^= (b >> 5);
+    a -= b; a -= c; a ^= (c >> 3);
+    b -= c; b -= a; b ^= (a << 10);
+    c -= a; c -= b; c ^= (b >> 15);
+  }
+};
+
+/**
+ * The former comparison: memcmp of the bytes (an Ipv6Address is made
+ * of its 16 bytes only).
+ */
+class BytesEqual : public std::binary_function<Ipv6Address, Ipv6Address, bool>
+{
+public:
+  bool operator () (Ipv6Address const &x, Ipv6Address const &y) const
+  {
+    return std::memcmp (&x, &y, 16) == 0;
+  }
+};
+
+/**
+ * Fill a map, then look up every address once, plus as many
+ * addresses which are not in the map.
+ *
+ * \tparam Map \deduced The hash map type.
+ * \param [in] map The map.
+ * \param [in] addresses The addresses.
+ * \param [in] misses Addresses not in the map.
+ * \param [in] name The name of the variant.
+ */
+template <typename Map>
+static void
+Run (Map &map, const std::vector<Ipv6Address> &addresses,
+     const std::vector<Ipv6Address> &misses, const char *name)
+{
+  SystemWallClockMs time;
+  time.Start ();
+  for (uint32_t i = 0; i < addresses.size (); i++)
+    {
+      map[addresses[i]] = i;
+    }
+  uint64_t insertMs = time.End ();
+
+  uint64_t found = 0;
+  time.Start ();
+  for (uint32_t i = 0; i < addresses.size (); i++)
+    {
+      found += map.find (addresses[i]) != map.end ();
+      found += map.find (misses[i]) != map.end ();
+    }
+  uint64_t lookupMs = time.End ();
+
+  std::cout << name << ": insert " << insertMs * 1e6 / addresses.size ()
+            << " ns/address, lookup " << lookupMs * 1e6 / (2 * addresses.size ())
+            << " ns/lookup, " << map.bucket_count () << " buckets"
+            << " (" << found << " found)" << std::endl;
+}
+
+int main (int argc, char *argv[])
+{
+  uint32_t n = 1000000;
+  uint32_t subnets = 16;
+
+  CommandLine cmd;
+  cmd.Usage ("Benchmark the lookups of IPv6 addresses in a hash map.");
+  cmd.AddValue ("n", "number of addresses in the map", n);
+  cmd.AddValue ("subnets", "number of /64 subnets", subnets);
+  cmd.Parse (argc, argv);
+
+  if (n == 0 || subnets == 0)
+    {
+      std::cerr << "Error-- the number of addresses and subnets must not be 0" << std::endl;
+      exit (1);
+    }
+
+  std::vector<Ipv6Address> addresses;
+  std::vector<Ipv6Address> misses;
+  for (uint32_t i = 0; i < n; i++)
+    {
+      uint8_t buf[16];
+      std::memset (buf, 0, 16);
+      uint32_t subnet = i % subnets;
+      uint32_t host = i / subnets + 1;
+      buf[0] = 0x20;
+      buf[1] = 0x01;
+      buf[6] = subnet >> 8;
+      buf[7] = subnet;
+      buf[12] = host >> 24;
+      buf[13] = host >> 16;
+      buf[14] = host >> 8;
+      buf[15] = host;
+      addresses.push_back (Ipv6Address (buf));
+      // same host in another prefix
+      buf[5] = 1;
+      misses.push_back (Ipv6Address (buf));
+    }
+
+  {
+    sgi::hash_map<Ipv6Address, uint32_t, BytesHash, BytesEqual> map;
+    Run (map, addresses, misses, "bytes");
+  }
+  {
+    sgi::hash_map<Ipv6Address, uint32_t, Ipv6AddressHash> map;
+    Run (map, addresses, misses, "words");
+  }
+  return 0;
+}
@@ -0,0 +1,130 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/*
+ * Measure the computation of the IPv6 routes of a backbone by
+ * Ipv6GlobalRoutingHelper: a ring of routers with random chords, the
+ * links between routers having link-local addresses only, and a stub
+ * network behind each router. The routes are computed once, then again
+ * without any change, then after a link went down.
+ */
+
+#include <iostream>
+#include <stdlib.h> // for exit ()
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/internet-module.h"
+#include "ns3/ipv6-global-routing-helper.h"
+
+using namespace ns3;
+
+/**
+ * \param [in] routers The routers.
+ * \returns The number of routes of the routers.
+ */
+static uint64_t
+CountRoutes (NodeContainer &routers)
+{
+  Ipv6StaticRoutingHelper helper;
+  uint64_t count = 0;
+  for (uint32_t i = 0; i < routers.GetN (); i++)
+    {
+      Ptr<Ipv6StaticRouting> routing = helper.GetStaticRouting (routers.Get (i)->GetObject<Ipv6> ());
+      count += routing->GetNRoutes ();
+    }
+  return count;
+}
+
+int main (int argc, char *argv[])
+{
+  uint32_t nRouters = 1000;
+  uint32_t chords = 500;
+
+  CommandLine cmd;
+  cmd.Usage ("Benchmark the computation of the IPv6 routes of a backbone.");
+  cmd.AddValue ("routers", "number of routers", nRouters);
+  cmd.AddValue ("chords", "number of links added to the ring", chords);
+  cmd.Parse (argc, argv);
+
+  if (nRouters < 3)
+    {
+      std::cerr << "Error-- the number of routers must be at least 3" << std::endl;
+      exit (1);
+    }
+
+  SystemWallClockMs time;
+  time.Start ();
+  NodeContainer routers;
+  routers.Create (nRouters);
+  InternetStackHelper internet;
+  internet.SetIpv4StackInstall (false);
+  internet.Install (routers);
+
+  SimpleNetDeviceHelper simple;
+  Ipv6AddressHelper address;
+  Ptr<UniformRandomVariable> random = CreateObject<UniformRandomVariable> ();
+  for (uint32_t i = 0; i < nRouters + chords; i++)
+    {
+      uint32_t a = i % nRouters;
+      uint32_t b = (a + 1) % nRouters;
+      if (i >= nRouters)
+        {
+          b = random->GetInteger (0, nRouters - 1);
+          if (b == a)
+            {
+              b = (a + nRouters / 2) % nRouters;
+            }
+        }
+      address.AssignWithoutAddress (simple.Install (NodeContainer (routers.Get (a), routers.Get (b))));
+    }
+  address.SetBase (Ipv6Address ("2001:db8::"), Ipv6Prefix (64));
+  for (uint32_t i = 0; i < nRouters; i++)
+    {
+      address.Assign (simple.Install (routers.Get (i)));
+      address.NewNetwork ();
+      Ptr<Ipv6> ipv6 = routers.Get (i)->GetObject<Ipv6> ();
+      for (uint32_t j = 1; j < ipv6->GetNInterfaces (); j++)
+        {
+          ipv6->SetForwarding (j, true);
+        }
+    }
+  uint64_t setupMs = time.End ();
+
+  time.Start ();
+  Ipv6GlobalRoutingHelper::PopulateRoutingTables ();
+  uint64_t populateMs = time.End ();
+  uint64_t routes = CountRoutes (routers);
+
+  time.Start ();
+  Ipv6GlobalRoutingHelper::RecomputeRoutingTables ();
+  uint64_t unchangedMs = time.End ();
+
+  // the first link of the ring goes down on router 0
+  routers.Get (0)->GetObject<Ipv6> ()->SetDown (1);
+  time.Start ();
+  Ipv6GlobalRoutingHelper::RecomputeRoutingTables ();
+  uint64_t linkDownMs = time.End ();
+
+  std::cout << nRouters << " routers, " << nRouters + chords << " links, "
+            << routes << " routes: setup " << setupMs << " ms, "
+            << "populate " << populateMs << " ms, "
+            << "recompute " << unchangedMs << " ms, "
+            << "recompute after a link down " << linkDownMs << " ms" << std::endl;
+
+  Simulator::Destroy ();
+  return 0;
+}
@@ -0,0 +1,151 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/*
+ * Measure the cost of Ipv6L3Protocol::Receive on a node with many
+ * interfaces (e.g. an HA with one tunnel per binding). Packets are
+ * injected on the first interface and addressed to the last one, with
+ * the weak end system model, so the "is this for me" check has to find
+ * an address on another interface.
+ */
+
+#include "ns3/command-line.h"
+#include "ns3/system-wall-clock-ms.h"
+#include "ns3/config.h"
+#include "ns3/boolean.h"
+#include "ns3/node.h"
+#include "ns3/packet.h"
+#include "ns3/simple-net-device.h"
+#include "ns3/internet-stack-helper.h"
+#include "ns3/ipv6-address-helper.h"
+#include "ns3/ipv6-l3-protocol.h"
+#include "ns3/ipv6-header.h"
+#include "ns3/udp-header.h"
+#include "ns3/udp-l4-protocol.h"
+#include "ns3/udp-socket-factory.h"
+#include "ns3/inet6-socket-address.h"
+#include "ns3/socket.h"
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <stdlib.h> // for exit ()
+
+using namespace ns3;
+
+static uint64_t g_received = 0;
+
+static void
+Drain (Ptr<Socket> socket)
+{
+  Ptr<Packet> packet;
+  while ((packet = socket->Recv ()))
+    {
+      g_received++;
+    }
+}
+
+static void
+RunBench (uint32_t nInterfaces, uint32_t n)
+{
+  Ptr<Node> node = CreateObject<Node> ();
+  NetDeviceContainer devices;
+  for (uint32_t i = 0; i < nInterfaces; i++)
+    {
+      Ptr<SimpleNetDevice> device = CreateObject<SimpleNetDevice> ();
+      device->SetAddress (Mac48Address::Allocate ());
+      node->AddDevice (device);
+      devices.Add (device);
+    }
+
+  InternetStackHelper internet;
+  internet.SetIpv4StackInstall (false);
+  internet.Install (node);
+
+  Ipv6AddressHelper address;
+  address.SetBase (Ipv6Address ("2001:db8::"), Ipv6Prefix (64));
+  Ipv6InterfaceContainer interfaces = address.Assign (devices);
+
+  Ptr<Ipv6L3Protocol> ipv6 = node->GetObject<Ipv6L3Protocol> ();
+  Ipv6Address destination = interfaces.GetAddress (nInterfaces - 1, 1);
+
+  Ptr<Socket> sink = Socket::CreateSocket (node, UdpSocketFactory::GetTypeId ());
+  sink->Bind (Inet6SocketAddress (Ipv6Address::GetAny (), 9));
+  sink->SetRecvCallback (MakeCallback (&Drain));
+
+  UdpHeader udp;
+  udp.SetSourcePort (9);
+  udp.SetDestinationPort (9);
+  Ptr<Packet> packet = Create<Packet> (64);
+  packet->AddHeader (udp);
+
+  Ipv6Header header;
+  header.SetSourceAddress (Ipv6Address ("2001:db8:ffff::1"));
+  header.SetDestinationAddress (destination);
+  header.SetNextHeader (UdpL4Protocol::PROT_NUMBER);
+  header.SetPayloadLength (packet->GetSize ());
+  header.SetHopLimit (64);
+  packet->AddHeader (header);
+
+  Ptr<NetDevice> device = devices.Get (0);
+  Address from = Mac48Address::Allocate ();
+
+  g_received = 0;
+  SystemWallClockMs time;
+  time.Start ();
+  for (uint32_t i = 0; i < n; i++)
+    {
+      ipv6->Receive (device, packet, Ipv6L3Protocol::PROT_NUMBER, from,
+                     device->GetAddress (), NetDevice::PACKET_HOST);
+    }
+  uint64_t deltaMs = time.End ();
+  double ps = n * 1000.0 / (deltaMs ? deltaMs : 1);
+  std::cout << "interfaces=" << nInterfaces
+            << " " << ps << " packets/s"
+            << " (" << deltaMs << " ms elapsed, "
+            << g_received << " delivered)"
+            << std::endl;
+
+  sink->Close ();
+}
+
+int main (int argc, char *argv[])
+{
+  uint32_t n = 0;
+  uint32_t maxInterfaces = 1000;
+  CommandLine cmd;
+  cmd.Usage ("Benchmark Ipv6L3Protocol::Receive as the number of interfaces grows.");
+  cmd.AddValue ("n", "number of packets to receive for each configuration", n);
+  cmd.AddValue ("maxInterfaces", "largest number of interfaces to test", maxInterfaces);
+  cmd.Parse (argc, argv);
+
+  if (n == 0)
+    {
+      std::cerr << "Error-- number of packets must be specified " <<
+        "by command-line argument --n=(number of packets)" << std::endl;
+      exit (1);
+    }
+
+  Config::SetDefault ("ns3::Icmpv6L4Protocol::DAD", BooleanValue (false));
+  Config::SetDefault ("ns3::Ipv6L3Protocol::StrongEndSystemModel", BooleanValue (false));
+
+  std::cout << "Running bench-ipv6-receive with n=" << n << std::endl;
+  for (uint32_t nInterfaces = 1; nInterfaces <= maxInterfaces; nInterfaces *= 10)
+    {
+      RunBench (nInterfaces, n);
+    }
+
+  return 0;
+}
@@ -0,0 +1,160 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/*
+ * Measure the evaluation of the positions of many random waypoint nodes:
+ * every time step, the positions of all the nodes are asked to their
+ * mobility models one at a time, or evaluated together by a
+ * MobilityStore, or not at all, to measure the cost of the mobility
+ * events alone. The course changes are counted as notified by the models
+ * and as coalesced by the store.
+ */
+
+#include <iostream>
+#include <stdlib.h> // for exit ()
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/mobility-module.h"
+#include "ns3/mobility-store.h"
+
+using namespace ns3;
+
+/// The number of course changes notified by the models.
+static uint64_t g_courseChanges = 0;
+/// The number of notifications of the store.
+static uint64_t g_notifications = 0;
+/// A sum of the coordinates, so that the positions are used.
+static double g_sum = 0;
+
+/**
+ * \param [in] model The model which changed course.
+ */
+static void
+CourseChange (Ptr<const MobilityModel> model)
+{
+  g_courseChanges++;
+}
+
+/**
+ * \param [in] indices The entries which changed course.
+ */
+static void
+CourseChanges (const std::vector<uint32_t> &indices)
+{
+  g_notifications++;
+}
+
+/**
+ * \param [in] nodes The nodes.
+ * \param [in] step The time step.
+ */
+static void
+EvaluateModels (NodeContainer *nodes, Time step)
+{
+  for (uint32_t i = 0; i < nodes->GetN (); i++)
+    {
+      Vector position = nodes->Get (i)->GetObject<MobilityModel> ()->GetPosition ();
+      g_sum += position.x + position.y;
+    }
+  Simulator::Schedule (step, &EvaluateModels, nodes, step);
+}
+
+/**
+ * \param [in] store The store.
+ * \param [in] step The time step.
+ */
+static void
+EvaluateStore (Ptr<MobilityStore> store, Time step)
+{
+  static std::vector<Vector> positions;
+  store->GetPositions (positions);
+  for (uint32_t i = 0; i < positions.size (); i++)
+    {
+      g_sum += positions[i].x + positions[i].y;
+    }
+  Simulator::Schedule (step, &EvaluateStore, store, step);
+}
+
+int main (int argc, char *argv[])
+{
+  uint32_t nNodes = 5000;
+  double duration = 60;
+  double step = 0.1;
+  std::string mode = "store";
+
+  CommandLine cmd;
+  cmd.Usage ("Benchmark the evaluation of the positions of random waypoint nodes.");
+  cmd.AddValue ("nodes", "number of nodes", nNodes);
+  cmd.AddValue ("duration", "simulated time, in seconds", duration);
+  cmd.AddValue ("step", "time between two evaluations of all the positions, in seconds", step);
+  cmd.AddValue ("mode", "how the positions are evaluated: models, store or none", mode);
+  cmd.Parse (argc, argv);
+
+  if (mode != "models" && mode != "store" && mode != "none")
+    {
+      std::cerr << "Error-- unknown mode " << mode << std::endl;
+      exit (1);
+    }
+
+  SystemWallClockMs time;
+  time.Start ();
+  NodeContainer nodes;
+  nodes.Create (nNodes);
+  ObjectFactory positions;
+  positions.SetTypeId ("ns3::RandomRectanglePositionAllocator");
+  positions.Set ("X", StringValue ("ns3::UniformRandomVariable[Min=0.0|Max=5000.0]"));
+  positions.Set ("Y", StringValue ("ns3::UniformRandomVariable[Min=0.0|Max=5000.0]"));
+  Ptr<PositionAllocator> allocator = positions.Create ()->GetObject<PositionAllocator> ();
+  MobilityHelper mobility;
+  mobility.SetPositionAllocator (allocator);
+  mobility.SetMobilityModel ("ns3::RandomWaypointMobilityModel",
+                             "Speed", StringValue ("ns3::UniformRandomVariable[Min=10.0|Max=30.0]"),
+                             "Pause", StringValue ("ns3::UniformRandomVariable[Min=0.0|Max=2.0]"),
+                             "PositionAllocator", PointerValue (allocator));
+  mobility.Install (nodes);
+
+  Ptr<MobilityStore> store = CreateObject<MobilityStore> ();
+  store->TraceConnectWithoutContext ("CourseChanges", MakeCallback (&CourseChanges));
+  for (uint32_t i = 0; i < nNodes; i++)
+    {
+      Ptr<MobilityModel> model = nodes.Get (i)->GetObject<MobilityModel> ();
+      model->TraceConnectWithoutContext ("CourseChange", MakeCallback (&CourseChange));
+      store->Add (model);
+    }
+  if (mode == "models")
+    {
+      Simulator::Schedule (Seconds (step), &EvaluateModels, &nodes, Seconds (step));
+    }
+  else if (mode == "store")
+    {
+      Simulator::Schedule (Seconds (step), &EvaluateStore, store, Seconds (step));
+    }
+  uint64_t setupMs = time.End ();
+
+  time.Start ();
+  Simulator::Stop (Seconds (duration));
+  Simulator::Run ();
+  uint64_t runMs = time.End ();
+
+  std::cout << nNodes << " nodes, " << duration << " s, positions evaluated every " << step
+            << " s by " << mode << ": " << g_courseChanges << " course changes, "
+            << g_notifications << " store notifications, setup " << setupMs << " ms, run "
+            << runMs << " ms (checksum " << g_sum << ")" << std::endl;
+
+  Simulator::Destroy ();
+  return 0;
+}
@@ -0,0 +1,114 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/*
+ * Measure the speedup of ReplicationRunner with the number of jobs: the
+ * same sweep of CPU-bound replications, each one a chain of simulator
+ * events with random delays, is run with 1, 2, 4... jobs, up to the
+ * number of processors.
+ */
+
+#include <iomanip>
+#include <iostream>
+#include <algorithm>
+#include <unistd.h>
+
+#include "ns3/core-module.h"
+#include "ns3/stats-module.h"
+
+using namespace ns3;
+
+/**
+ * Schedule the next event of the chain.
+ * \param [in] random The delays of the events.
+ * \param [in] counter The number of events.
+ * \param [in] left The number of events still to run.
+ */
+static void
+Step (Ptr<ExponentialRandomVariable> random, Ptr<CounterCalculator<uint32_t> > counter, uint32_t left)
+{
+  counter->Update ();
+  if (left > 0)
+    {
+      Simulator::Schedule (NanoSeconds (random->GetInteger ()), &Step, random, counter, left - 1);
+    }
+}
+
+/// The number of events of a replication.
+static uint32_t g_events = 1000000;
+
+/**
+ * A replication running g_events events.
+ * \param [in] parameters The parameters of the point.
+ * \param [in] collector The collector of the replication.
+ */
+static void
+RunReplication (const ReplicationRunner::Parameters &parameters, Ptr<DataCollector> collector)
+{
+  Ptr<ExponentialRandomVariable> random = CreateObject<ExponentialRandomVariable> ();
+  random->SetAttribute ("Mean", DoubleValue (1000));
+  Ptr<CounterCalculator<uint32_t> > counter = CreateObject<CounterCalculator<uint32_t> > ();
+  counter->SetKey ("events");
+  counter->SetContext ("bench");
+  Simulator::Schedule (Seconds (0), &Step, random, counter, g_events - 1);
+  Simulator::Run ();
+  Simulator::Destroy ();
+  collector->AddDataCalculator (counter);
+}
+
+int main (int argc, char *argv[])
+{
+  uint32_t replications = 8;
+  long processors = sysconf (_SC_NPROCESSORS_ONLN);
+  uint32_t maxJobs = processors > 0 ? processors : 1;
+
+  CommandLine cmd;
+  cmd.Usage ("Benchmark the speedup of parallel replications with the number of jobs.");
+  cmd.AddValue ("replications", "number of replications of each of the two points", replications);
+  cmd.AddValue ("events", "number of events of a replication", g_events);
+  cmd.AddValue ("jobs", "largest number of jobs", maxJobs);
+  cmd.Parse (argc, argv);
+  maxJobs = std::max (maxJobs, 1U);
+
+  std::cout << processors << " processors, " << 2 * replications << " replications of "
+            << g_events << " events" << std::endl;
+  std::cout << std::setw (6) << "jobs" << std::setw (12) << "elapsed (s)"
+            << std::setw (10) << "speedup" << std::setw (12) << "efficiency"
+            << std::setw (10) << "failed" << std::endl;
+  double serial = 0;
+  for (uint32_t jobs = 1; ; jobs = std::min (2 * jobs, maxJobs))
+    {
+      ReplicationRunner runner;
+      runner.SetSweep ("ns3::ExponentialRandomVariable::Bound=0,10000");
+      runner.SetReplications (replications);
+      runner.SetJobs (jobs);
+      runner.SetFilePrefix ("");
+      runner.Run (MakeCallback (&RunReplication));
+      if (jobs == 1)
+        {
+          serial = runner.GetElapsed ();
+        }
+      double speedup = serial / runner.GetElapsed ();
+      std::cout << std::setw (6) << jobs << std::setw (12) << runner.GetElapsed ()
+                << std::setw (10) << speedup << std::setw (12) << speedup / jobs
+                << std::setw (10) << runner.GetNFailures () << std::endl;
+      if (jobs >= maxJobs)
+        {
+          break;
+        }
+    }
+  return 0;
+}
@@ -0,0 +1,267 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/*
+ * Replay a trace written by ns3::RecordingScheduler against one or all
+ * of the schedulers, and report for each:
+ *  - the throughput, in scheduler operations per second,
+ *  - the peak of the memory allocated while replaying,
+ *  - the time per operation for each decade of the number of pending
+ *    events. The growth of this time with the population, once the
+ *    algorithmic cost is accounted for, is a proxy for cache misses.
+ *
+ * Record a trace with e.g.
+ *   ./waf --run "mipv6-multiple --SchedulerType=ns3::RecordingScheduler"
+ */
+
+#include <iomanip>
+#include <iostream>
+#include <vector>
+#include <string>
+#include <new>
+#include <cstdlib>
+#include <sys/time.h>
+
+#include "ns3/core-module.h"
+
+using namespace ns3;
+
+/** Bytes currently allocated through operator new. */
+static size_t g_allocated = 0;
+/** Peak of g_allocated since the last reset. */
+static size_t g_peak = 0;
+
+/** Header of the allocations, keeping their size and the alignment. */
+union AllocHeader
+{
+  size_t size;
+  long double align;
+};
+
+void *
+operator new (size_t size)
+{
+  AllocHeader *header = static_cast<AllocHeader *> (std::malloc (sizeof (AllocHeader) + size));
+  if (header == 0)
+    {
+      throw std::bad_alloc ();
+    }
+  header->size = size;
+  g_allocated += size;
+  if (g_allocated > g_peak)
+    {
+      g_peak = g_allocated;
+    }
+  return header + 1;
+}
+
+void
+operator delete (void *p)
+{
+  if (p == 0)
+    {
+      return;
+    }
+  AllocHeader *header = static_cast<AllocHeader *> (p) - 1;
+  g_allocated -= header->size;
+  std::free (header);
+}
+
+void *
+operator new[] (size_t size)
+{
+  return operator new (size);
+}
+
+void
+operator delete[] (void *p)
+{
+  operator delete (p);
+}
+
+/** The event of all the replayed records: schedulers never run it. */
+class ReplayEvent : public EventImpl
+{
+protected:
+  virtual void Notify (void)
+  {}
+};
+
+/** \returns The wall clock time in microseconds. */
+static uint64_t
+GetUs (void)
+{
+  struct timeval tv;
+  gettimeofday (&tv, 0);
+  return tv.tv_sec * 1000000ULL + tv.tv_usec;
+}
+
+/** Number of decades of the population reported. */
+static const uint32_t DECADES = 8;
+/** Number of operations timed together. */
+static const uint32_t CHUNK = 1024;
+
+static void
+Replay (std::string type, const std::vector<SchedulerTraceReader::Record> &records)
+{
+  ObjectFactory factory (type);
+  ReplayEvent event;
+  uint64_t decadeUs[DECADES] = { 0 };
+  uint64_t decadeOps[DECADES] = { 0 };
+  uint32_t mismatches = 0;
+  uint32_t population = 0;
+
+  size_t base = g_allocated;
+  g_peak = g_allocated;
+  Ptr<Scheduler> scheduler = factory.Create<Scheduler> ();
+
+  uint64_t start = GetUs ();
+  uint64_t chunkStart = start;
+  uint32_t decade = 0;
+  for (uint32_t i = 0; i < records.size (); i++)
+    {
+      if (i % CHUNK == 0)
+        {
+          uint64_t now = GetUs ();
+          decadeUs[decade] += now - chunkStart;
+          decadeOps[decade] += i == 0 ? 0 : CHUNK;
+          chunkStart = now;
+          decade = 0;
+          for (uint32_t p = population; p >= 10 && decade < DECADES - 1; p /= 10)
+            {
+              decade++;
+            }
+        }
+      const SchedulerTraceReader::Record &r = records[i];
+      Scheduler::Event ev;
+      ev.impl = &event;
+      ev.key.m_ts = r.ts;
+      ev.key.m_uid = r.uid;
+      ev.key.m_context = r.context;
+      switch (r.op)
+        {
+        case SchedulerTraceReader::INSERT:
+          scheduler->Insert (ev);
+          population++;
+          break;
+        case SchedulerTraceReader::REMOVE_NEXT:
+          if (scheduler->RemoveNext ().key.m_uid != r.uid)
+            {
+              mismatches++;
+            }
+          population--;
+          break;
+        case SchedulerTraceReader::REMOVE:
+          scheduler->Remove (ev);
+          population--;
+          break;
+        }
+    }
+  uint64_t end = GetUs ();
+  decadeUs[decade] += end - chunkStart;
+  decadeOps[decade] += (records.size () - 1) % CHUNK + 1;
+  double s = (end - start) / 1e6;
+
+  std::cout << std::endl << type << std::endl
+            << "  time: " << s << " s, "
+            << (records.size () / s) << " ops/s, "
+            << (s * 1e9 / records.size ()) << " ns/op" << std::endl
+            << "  peak memory: " << (g_peak - base) << " bytes" << std::endl;
+  if (mismatches)
+    {
+      std::cout << "  RemoveNext returned another event than recorded "
+                << mismatches << " times" << std::endl;
+    }
+  std::cout << "  ns/op by number of pending events:" << std::endl;
+  uint64_t low = 0;
+  uint64_t high = 10;
+  for (uint32_t d = 0; d < DECADES; d++, low = high, high *= 10)
+    {
+      if (decadeOps[d] != 0)
+        {
+          std::cout << "    " << std::setw (9) << low << " - " << std::setw (9) << high
+                    << ": " << (decadeUs[d] * 1000.0 / decadeOps[d]) << std::endl;
+        }
+    }
+}
+
+int main (int argc, char *argv[])
+{
+  std::string filename = "scheduler-trace.bin";
+  std::string type = "ns3::MapScheduler";
+  bool all = false;
+
+  CommandLine cmd;
+  cmd.Usage ("Replay a scheduler trace recorded by ns3::RecordingScheduler.");
+  cmd.AddValue ("file", "trace file", filename);
+  cmd.AddValue ("scheduler", "type of the scheduler to replay the trace with", type);
+  cmd.AddValue ("all", "replay the trace with all the schedulers but ListScheduler", all);
+  cmd.Parse (argc, argv);
+
+  SchedulerTraceReader reader;
+  if (!reader.Open (filename))
+    {
+      std::cerr << "Error-- " << filename << " is not a scheduler trace" << std::endl;
+      exit (1);
+    }
+  std::vector<SchedulerTraceReader::Record> records;
+  SchedulerTraceReader::Record record;
+  uint32_t counts[3] = { 0 };
+  uint32_t population = 0;
+  uint32_t peak = 0;
+  while (reader.Read (record))
+    {
+      records.push_back (record);
+      if (record.op == SchedulerTraceReader::INSERT)
+        {
+          counts[0]++;
+          peak = std::max (peak, ++population);
+        }
+      else
+        {
+          counts[record.op == SchedulerTraceReader::REMOVE_NEXT ? 1 : 2]++;
+          population--;
+        }
+    }
+  std::cout << filename << ": " << records.size () << " operations, "
+            << counts[0] << " Insert, " << counts[1] << " RemoveNext, "
+            << counts[2] << " Remove, "
+            << "peak of " << peak << " pending events" << std::endl;
+  if (records.empty ())
+    {
+      return 0;
+    }
+
+  std::vector<std::string> types;
+  if (all)
+    {
+      types.push_back ("ns3::MapScheduler");
+      types.push_back ("ns3::HeapScheduler");
+      types.push_back ("ns3::CalendarScheduler");
+      types.push_back ("ns3::DaryHeapScheduler");
+      types.push_back ("ns3::LadderScheduler");
+    }
+  else
+    {
+      types.push_back (type);
+    }
+  for (uint32_t i = 0; i < types.size (); i++)
+    {
+      Replay (types[i], records);
+    }
+
+  return 0;
+}
@@ -45,7 +45,8 @@ public:
   Bench (const uint32_t population, const uint32_t total)
   : m_population (population),
     m_total (total),
-    m_count (0)
+    m_count (0),
+    m_perEvent (0)
   { };
   
   void SetRandomStream (Ptr<RandomVariableStream> stream)
@@ -64,6 +65,11 @@ public:
   }
     
   void RunBench (void);
+
+  double GetPerEvent (void) const
+  {
+    return m_perEvent;
+  }
 private:
   void Cb (void);
   
@@ -71,6 +77,7 @@ private:
   uint32_t m_population;
   uint32_t m_total;
   uint32_t m_count;
+  double m_perEvent;
 };
 
 void
@@ -99,6 +106,7 @@ Bench::RunBench (void)
   simu = time.End ();
   simu /= 1000;
   DEB ("run took " << simu << "s");
+  m_perEvent = simu / m_count;
 
   LOG (std::setw (g_fwidth) << init <<
        std::setw (g_fwidth) << (m_population / init) <<
@@ -109,6 +117,23 @@ Bench::RunBench (void)
 
 }
 
+/**
+ * Measure the time spent creating and releasing the EventImpl of
+ * the events run by the bench, i.e. the allocator part of Schedule.
+ */
+static double
+AllocatorTime (Bench *bench, uint32_t total)
+{
+  SystemWallClockMs time;
+  time.Start ();
+  for (uint32_t i = 0; i < total; ++i)
+    {
+      EventImpl *event = MakeEvent (&Bench::RunBench, bench);
+      event->Unref ();
+    }
+  return time.End () / 1000.0;
+}
+
 void
 Bench::Cb (void)
 {
@@ -177,6 +202,44 @@ GetRandomStream (std::string filename)
   return stream;
 }
 
+/**
+ * Event intervals of a mobility simulation: mostly Wi-Fi MAC timers,
+ * with some BList/BCache retransmission and refresh timers, Radvd
+ * advertisements and binding lifetimes.
+ */
+Ptr<RandomVariableStream>
+GetTimerMixStream (void)
+{
+  LOGME ("using MIPv6 timer mix distribution");
+  Ptr<UniformRandomVariable> u = CreateObject<UniformRandomVariable> ();
+  std::vector<double> nsValues;
+  for (uint32_t i = 0; i < 100000; i++)
+    {
+      double p = u->GetValue ();
+      double s;
+      if (p < 0.80)
+        {
+          s = u->GetValue (10e-6, 500e-6);      // MAC slots, SIFS, ACK timeouts
+        }
+      else if (p < 0.95)
+        {
+          s = u->GetValue (1, 4);               // BU retransmissions and refreshes
+        }
+      else if (p < 0.99)
+        {
+          s = u->GetValue (3, 10);              // Radvd advertisements
+        }
+      else
+        {
+          s = 100;                              // binding lifetimes
+        }
+      nsValues.push_back ((uint64_t) (s * 1000000000));
+    }
+  Ptr<DeterministicRandomVariable> drv = CreateObject<DeterministicRandomVariable> ();
+  drv->SetValueArray (&nsValues[0], nsValues.size ());
+  return drv;
+}
+
 
 
 int main (int argc, char *argv[])
@@ -186,6 +249,10 @@ int main (int argc, char *argv[])
   bool schedHeap = false;
   bool schedList = false;
   bool schedMap  = true;
+  bool schedDary = false;
+  bool schedLadder = false;
+  bool all = false;
+  bool mix = false;
 
   uint32_t pop   =  100000;
   uint32_t total = 1000000;
@@ -205,6 +272,10 @@ int main (int argc, char *argv[])
   cmd.AddValue ("heap",  "use HeapScheduler",             schedHeap);
   cmd.AddValue ("list",  "use ListSheduler",              schedList);
   cmd.AddValue ("map",   "use MapScheduler (default)",    schedMap);
+  cmd.AddValue ("dary",  "use DaryHeapScheduler",         schedDary);
+  cmd.AddValue ("ladder", "use LadderScheduler",          schedLadder);
+  cmd.AddValue ("all",   "run and compare all the schedulers", all);
+  cmd.AddValue ("mix",   "use the MIPv6 timer mix distribution", mix);
   cmd.AddValue ("debug", "enable debugging output",       g_debug);
   cmd.AddValue ("pop",   "event population size (default 1E5)",         pop);
   cmd.AddValue ("total", "total number of events to run (default 1E6)", total);
@@ -215,60 +286,103 @@ int main (int argc, char *argv[])
   g_me = cmd.GetName () + ": ";
   g_fwidth += 6;  // 5 extra chars in '2.000002e+07 ': . e+0 _
 
-  ObjectFactory factory ("ns3::MapScheduler");
-  if (schedCal)  { factory.SetTypeId ("ns3::CalendarScheduler"); }
-  if (schedHeap) { factory.SetTypeId ("ns3::HeapScheduler");     }
-  if (schedList) { factory.SetTypeId ("ns3::ListScheduler");     }  
-  Simulator::SetScheduler (factory);
+  std::vector<std::string> schedulers;
+  if (all)
+    {
+      schedulers.push_back ("ns3::MapScheduler");
+      schedulers.push_back ("ns3::ListScheduler");
+      schedulers.push_back ("ns3::HeapScheduler");
+      schedulers.push_back ("ns3::CalendarScheduler");
+      schedulers.push_back ("ns3::DaryHeapScheduler");
+      schedulers.push_back ("ns3::LadderScheduler");
+    }
+  else
+    {
+      std::string type = "ns3::MapScheduler";
+      if (schedCal)    { type = "ns3::CalendarScheduler"; }
+      if (schedHeap)   { type = "ns3::HeapScheduler";     }
+      if (schedList)   { type = "ns3::ListScheduler";     }
+      if (schedDary)   { type = "ns3::DaryHeapScheduler"; }
+      if (schedLadder) { type = "ns3::LadderScheduler";   }
+      schedulers.push_back (type);
+    }
 
   LOGME (std::setprecision (g_fwidth - 6));
   DEB ("debugging is ON");
 
-  LOGME ("scheduler: " << factory.GetTypeId ().GetName ());
   LOGME ("population: " << pop);
   LOGME ("total events: " << total);
   LOGME ("runs: " << runs);
   
   Bench *bench = new Bench (pop, total);
-  bench->SetRandomStream (GetRandomStream (filename));
+  bench->SetRandomStream (mix ? GetTimerMixStream () : GetRandomStream (filename));
 
-  // table header
-  LOG ("");
-  LOG (std::left << std::setw (g_fwidth) << "Run #" <<
-       std::left << std::setw (3 * g_fwidth) << "Inititialization:" <<
-       std::left << std::setw (3 * g_fwidth) << "Simulation:");
-  LOG (std::left << std::setw (g_fwidth) << "" <<
-       std::left << std::setw (g_fwidth) << "Time (s)" <<
-       std::left << std::setw (g_fwidth) << "Rate (ev/s)" <<
-       std::left << std::setw (g_fwidth) << "Per (s/ev)" <<
-       std::left << std::setw (g_fwidth) << "Time (s)" <<
-       std::left << std::setw (g_fwidth) << "Rate (ev/s)" <<
-       std::left << std::setw (g_fwidth) << "Per (s/ev)" );
-  LOG (std::setfill ('-') <<
-       std::right << std::setw (g_fwidth) << " " <<
-       std::right << std::setw (g_fwidth) << " " <<       
-       std::right << std::setw (g_fwidth) << " " <<       
-       std::right << std::setw (g_fwidth) << " " <<       
-       std::right << std::setw (g_fwidth) << " " <<       
-       std::right << std::setw (g_fwidth) << " " <<       
-       std::right << std::setw (g_fwidth) << " " <<
-       std::setfill (' ')
-       );
-       
-  // prime
-  DEB ("priming");
-  std::cout << std::left << std::setw (g_fwidth) << "(prime)";
-  bench->RunBench ();
-
-  bench->SetPopulation (pop);
-  bench->SetTotal (total);
-  for (uint32_t i = 0; i < runs; i++)
+  std::vector<double> rates;
+  for (uint32_t s = 0; s < schedulers.size (); s++)
     {
-      std::cout << std::setw (g_fwidth) << i;
-      
+      ObjectFactory factory (schedulers[s]);
+      Simulator::SetScheduler (factory);
+
+      LOG ("");
+      LOGME ("scheduler: " << factory.GetTypeId ().GetName ());
+
+      // table header
+      LOG ("");
+      LOG (std::left << std::setw (g_fwidth) << "Run #" <<
+           std::left << std::setw (3 * g_fwidth) << "Inititialization:" <<
+           std::left << std::setw (3 * g_fwidth) << "Simulation:");
+      LOG (std::left << std::setw (g_fwidth) << "" <<
+           std::left << std::setw (g_fwidth) << "Time (s)" <<
+           std::left << std::setw (g_fwidth) << "Rate (ev/s)" <<
+           std::left << std::setw (g_fwidth) << "Per (s/ev)" <<
+           std::left << std::setw (g_fwidth) << "Time (s)" <<
+           std::left << std::setw (g_fwidth) << "Rate (ev/s)" <<
+           std::left << std::setw (g_fwidth) << "Per (s/ev)" );
+      LOG (std::setfill ('-') <<
+           std::right << std::setw (g_fwidth) << " " <<
+           std::right << std::setw (g_fwidth) << " " <<       
+           std::right << std::setw (g_fwidth) << " " <<       
+           std::right << std::setw (g_fwidth) << " " <<       
+           std::right << std::setw (g_fwidth) << " " <<       
+           std::right << std::setw (g_fwidth) << " " <<       
+           std::right << std::setw (g_fwidth) << " " <<
+           std::setfill (' ')
+           );
+       
+      // prime
+      DEB ("priming");
+      std::cout << std::left << std::setw (g_fwidth) << "(prime)";
+      bench->SetPopulation (pop);
+      bench->SetTotal (total);
       bench->RunBench ();
+
+      bench->SetPopulation (pop);
+      bench->SetTotal (total);
+      for (uint32_t i = 0; i < runs; i++)
+        {
+          std::cout << std::setw (g_fwidth) << i;
+      
+          bench->RunBench ();
+        }
+      rates.push_back (1 / bench->GetPerEvent ());
     }
 
+  if (schedulers.size () > 1)
+    {
+      // comparison to MapScheduler, on the last run of each scheduler
+      LOG ("");
+      for (uint32_t s = 0; s < schedulers.size (); s++)
+        {
+          LOG (std::left << std::setw (3 * g_fwidth) << schedulers[s] <<
+               std::left << std::setw (g_fwidth) << rates[s] << "ev/s " <<
+               std::left << std::setw (g_fwidth) << (rates[s] / rates[0]) << "x");
+        }
+    }
+
+  double alloc = AllocatorTime (bench, total);
+  LOGME ("allocator: " << (alloc / total) << " s/ev, "
+         << (100 * alloc / total / bench->GetPerEvent ()) << "% of the simulation time");
+
   LOG ("");
   return 0;
 
@@ -0,0 +1,197 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/*
+ * Count the heap allocations done for each packet forwarded by a home
+ * agent through its tunnel. The packet operations are the ones done,
+ * in order, by the layers crossed by a packet from a correspondent node
+ * to the mobile node:
+ *  - the device receives a copy of the frame and removes the Ethernet
+ *    header,
+ *  - Ipv6L3Protocol::Receive copies the packet and removes the IPv6
+ *    header, Ipv6L3Protocol::IpForward adds it back,
+ *  - TunnelNetDevice::SendFrom adds a SocketIpTtlTag,
+ *  - Ipv6L3Protocol::Send removes the tag and adds the outer header,
+ *  - the device adds a FlowIdTag and the Ethernet header, and the
+ *    channel copies the frame.
+ */
+
+#include <iostream>
+#include <new>
+#include <cstdlib>
+
+#include "ns3/core-module.h"
+#include "ns3/packet.h"
+#include "ns3/packet-pool.h"
+#include "ns3/socket.h"
+#include "ns3/flow-id-tag.h"
+#include "ns3/ethernet-header.h"
+#include "ns3/ipv6-header.h"
+#include "ns3/udp-header.h"
+
+using namespace ns3;
+
+/** Number of calls to operator new. */
+static uint64_t g_heapAllocations = 0;
+
+void *
+operator new (size_t size)
+{
+  g_heapAllocations++;
+  void *p = std::malloc (size ? size : 1);
+  if (p == 0)
+    {
+      throw std::bad_alloc ();
+    }
+  return p;
+}
+
+void
+operator delete (void *p)
+{
+  std::free (p);
+}
+
+void *
+operator new[] (size_t size)
+{
+  return operator new (size);
+}
+
+void
+operator delete[] (void *p)
+{
+  operator delete (p);
+}
+
+/**
+ * \param [in] size The payload size.
+ * \returns The frame received by the home agent.
+ */
+static Ptr<Packet>
+MakeFrame (uint32_t size)
+{
+  Ptr<Packet> p = Create<Packet> (size);
+  UdpHeader udp;
+  udp.SetSourcePort (1000);
+  udp.SetDestinationPort (2000);
+  p->AddHeader (udp);
+  Ipv6Header ip;
+  ip.SetSourceAddress (Ipv6Address ("2001:2::1"));
+  ip.SetDestinationAddress (Ipv6Address ("2001:1::100"));
+  ip.SetNextHeader (17);
+  ip.SetPayloadLength (p->GetSize ());
+  ip.SetHopLimit (64);
+  p->AddHeader (ip);
+  p->AddHeader (EthernetHeader ());
+  return p;
+}
+
+/**
+ * Forward a frame through the tunnel.
+ *
+ * \param [in] frame The frame received.
+ * \returns The frame sent.
+ */
+static Ptr<Packet>
+Forward (Ptr<const Packet> frame)
+{
+  // device
+  Ptr<Packet> p = frame->Copy ();
+  EthernetHeader eth;
+  p->RemoveHeader (eth);
+
+  // Ipv6L3Protocol::Receive and IpForward
+  Ptr<Packet> packet = p->Copy ();
+  Ipv6Header inner;
+  packet->RemoveHeader (inner);
+  inner.SetHopLimit (inner.GetHopLimit () - 1);
+  packet->AddHeader (inner);
+
+  // TunnelNetDevice::SendFrom
+  SocketIpTtlTag ttl;
+  ttl.SetTtl (64);
+  packet->AddPacketTag (ttl);
+
+  // Ipv6L3Protocol::Send
+  packet->RemovePacketTag (ttl);
+  Ipv6Header outer;
+  outer.SetSourceAddress (Ipv6Address ("2001:1::1"));
+  outer.SetDestinationAddress (Ipv6Address ("2001:3::200"));
+  outer.SetNextHeader (41);
+  outer.SetPayloadLength (packet->GetSize ());
+  outer.SetHopLimit (ttl.GetTtl ());
+  packet->AddHeader (outer);
+
+  // device and channel
+  packet->AddByteTag (FlowIdTag (1));
+  packet->AddHeader (eth);
+  return packet->Copy ();
+}
+
+int main (int argc, char *argv[])
+{
+  uint32_t n = 100000;
+  uint32_t size = 1000;
+
+  CommandLine cmd;
+  cmd.Usage ("Count the allocations per packet forwarded through a MIPv6 tunnel.");
+  cmd.AddValue ("n", "number of packets", n);
+  cmd.AddValue ("size", "payload size", size);
+  cmd.Parse (argc, argv);
+
+  if (n == 0)
+    {
+      std::cerr << "Error-- the number of packets must not be 0" << std::endl;
+      exit (1);
+    }
+
+  // warm up the pools
+  for (uint32_t i = 0; i < 16; i++)
+    {
+      Forward (MakeFrame (size));
+    }
+
+  uint64_t frameAllocations = 0;
+  uint64_t forwardAllocations = 0;
+  PacketPool::ResetStats ();
+  SystemWallClockMs time;
+  time.Start ();
+  for (uint32_t i = 0; i < n; i++)
+    {
+      uint64_t start = g_heapAllocations;
+      Ptr<Packet> frame = MakeFrame (size);
+      uint64_t made = g_heapAllocations;
+      Forward (frame);
+      frameAllocations += made - start;
+      forwardAllocations += g_heapAllocations - made;
+    }
+  uint64_t deltaMs = time.End ();
+  struct PacketPool::Stats stats = PacketPool::GetStats ();
+
+  double s = (deltaMs ? deltaMs : 1) / 1000.0;
+  std::cout << n << " packets of " << size << " bytes in " << s << " s, "
+            << (s * 1e9 / n) << " ns/packet" << std::endl
+            << "heap allocations per forwarded packet: "
+            << (double)forwardAllocations / n << std::endl
+            << "heap allocations per frame created: "
+            << (double)frameAllocations / n << std::endl
+            << "pool allocations per packet: "
+            << (double)stats.allocations / n << ", "
+            << (100.0 * stats.reuses / (stats.allocations ? stats.allocations : 1))
+            << " % reused" << std::endl;
+  return 0;
+}
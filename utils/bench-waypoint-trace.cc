@@ -0,0 +1,174 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/*
+ * Measure the installation and the simulation of a large ns-2 mobility
+ * trace: the trace is generated, then either installed by
+ * Ns2MobilityHelper, which schedules all its movements at once, or
+ * converted to a waypoint file by another process and installed by
+ * WaypointTraceHelper, which maps the file and gives the waypoints to
+ * the models as they go.
+ * The positions of all the nodes are asked every second.
+ */
+
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <stdlib.h> // for exit ()
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/mobility-module.h"
+#include "ns3/waypoint-trace-helper.h"
+
+using namespace ns3;
+
+/// A sum of the coordinates, so that the positions are used.
+static double g_sum = 0;
+
+/**
+ * \param [in] nodes The nodes.
+ */
+static void
+Sample (NodeContainer *nodes)
+{
+  for (uint32_t i = 0; i < nodes->GetN (); i++)
+    {
+      Vector position = nodes->Get (i)->GetObject<MobilityModel> ()->GetPosition ();
+      g_sum += position.x + position.y;
+    }
+  Simulator::Schedule (Seconds (1), &Sample, nodes);
+}
+
+/**
+ * \returns The resident set size of the process, in kB.
+ */
+static long
+GetRss (void)
+{
+  long pages = 0;
+  long resident = 0;
+  std::ifstream statm ("/proc/self/statm");
+  statm >> pages >> resident;
+  return resident * (sysconf (_SC_PAGESIZE) / 1024);
+}
+
+/**
+ * \brief Write a random ns-2 trace: each node moves to a new destination
+ * every ten seconds.
+ * \param [in] filename The trace file.
+ * \param [in] nNodes The number of nodes.
+ * \param [in] nMoves The number of movements of each node.
+ */
+static void
+WriteNs2Trace (std::string filename, uint32_t nNodes, uint32_t nMoves)
+{
+  Ptr<UniformRandomVariable> random = CreateObject<UniformRandomVariable> ();
+  std::ofstream os (filename.c_str ());
+  for (uint32_t i = 0; i < nNodes; i++)
+    {
+      os << "$node_(" << i << ") set X_ " << random->GetValue (0, 1000) << "\n"
+         << "$node_(" << i << ") set Y_ " << random->GetValue (0, 1000) << "\n";
+    }
+  for (uint32_t k = 0; k < nMoves; k++)
+    {
+      for (uint32_t i = 0; i < nNodes; i++)
+        {
+          os << "$ns_ at " << 10 * k + random->GetValue (0, 1) << " \"$node_(" << i << ") setdest "
+             << random->GetValue (0, 1000) << " " << random->GetValue (0, 1000) << " "
+             << random->GetValue (100, 200) << "\"\n";
+        }
+    }
+}
+
+int main (int argc, char *argv[])
+{
+  uint32_t nNodes = 1000;
+  uint32_t nMoves = 200;
+  std::string mode = "waypoint";
+
+  CommandLine cmd;
+  cmd.Usage ("Benchmark the installation and the simulation of a large ns-2 mobility trace.");
+  cmd.AddValue ("nodes", "number of nodes", nNodes);
+  cmd.AddValue ("moves", "number of movements of each node", nMoves);
+  cmd.AddValue ("mode", "ns2 (Ns2MobilityHelper) or waypoint (WaypointTraceHelper)", mode);
+  cmd.Parse (argc, argv);
+
+  if (mode != "ns2" && mode != "waypoint")
+    {
+      std::cerr << "Error-- unknown mode " << mode << std::endl;
+      exit (1);
+    }
+
+  std::string ns2File = "bench-waypoint-trace.tcl";
+  std::string waypointFile = "bench-waypoint-trace.wpt";
+  WriteNs2Trace (ns2File, nNodes, nMoves);
+  long generateRss = GetRss ();
+
+  SystemWallClockMs time;
+  uint64_t convertMs = 0;
+  if (mode == "waypoint")
+    {
+      // the conversion is done offline, in a process of its own
+      time.Start ();
+      pid_t pid = fork ();
+      if (pid == 0)
+        {
+          WaypointTraceHelper::ConvertNs2 (ns2File, waypointFile);
+          _exit (0);
+        }
+      int status;
+      waitpid (pid, &status, 0);
+      convertMs = time.End ();
+    }
+  long convertRss = GetRss ();
+
+  NodeContainer nodes;
+  nodes.Create (nNodes);
+  time.Start ();
+  if (mode == "ns2")
+    {
+      Ns2MobilityHelper ns2 (ns2File);
+      ns2.Install (nodes.Begin (), nodes.End ());
+    }
+  else
+    {
+      WaypointTraceHelper waypoints (waypointFile);
+      waypoints.Install (nodes);
+    }
+  uint64_t installMs = time.End ();
+  long installRss = GetRss ();
+
+  Simulator::Schedule (Seconds (0), &Sample, &nodes);
+  Simulator::Stop (Seconds (10 * nMoves));
+  time.Start ();
+  Simulator::Run ();
+  uint64_t runMs = time.End ();
+  long runRss = GetRss ();
+  Simulator::Destroy ();
+
+  std::cout << mode << ": " << nNodes << " nodes, " << nMoves << " movements each: "
+            << "convert " << convertMs << " ms, install " << installMs << " ms, "
+            << "run " << runMs << " ms; RSS " << generateRss << " kB after generating, "
+            << convertRss << " kB after converting, " << installRss << " kB after installing, "
+            << runRss << " kB after running (" << g_sum << ")" << std::endl;
+
+  std::remove (ns2File.c_str ());
+  std::remove (waypointFile.c_str ());
+  return 0;
+}
@@ -0,0 +1,143 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/*
+ * Measure the broadcast of a YansWifiChannel: adhoc nodes on a large
+ * grid, a tenth of them walking, each broadcasting packets. With a
+ * MaxRange, the channel only delivers the packets to the nodes within
+ * that distance of the sender. With a propagation matrix, the channel
+ * caches the loss and delay between the nodes which do not move.
+ */
+
+#include <iostream>
+#include <cmath>
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/mobility-module.h"
+#include "ns3/wifi-module.h"
+
+using namespace ns3;
+
+/**
+ * \param [in] dev The sender.
+ */
+static void
+SendOnePacket (Ptr<NetDevice> dev)
+{
+  dev->Send (Create<Packet> (100), dev->GetBroadcast (), 1);
+}
+
+/**
+ * \param [in] count The number of packets received.
+ * \param [in] packet The packet.
+ */
+static void
+CountRx (uint64_t *count, Ptr<const Packet> packet)
+{
+  (*count)++;
+}
+
+int main (int argc, char *argv[])
+{
+  uint32_t nNodes = 400;
+  uint32_t nPackets = 10;
+  double spacing = 100;
+  double maxRange = 0;
+  uint32_t walkEvery = 10;
+  bool matrix = false;
+
+  CommandLine cmd;
+  cmd.Usage ("Benchmark the broadcast of a YansWifiChannel.");
+  cmd.AddValue ("nodes", "number of nodes", nNodes);
+  cmd.AddValue ("packets", "number of packets broadcast by each node", nPackets);
+  cmd.AddValue ("spacing", "distance between the nodes of the grid, in meters", spacing);
+  cmd.AddValue ("maxRange", "MaxRange of the channel, 0 for none", maxRange);
+  cmd.AddValue ("walkEvery", "one node in this many walks, 0 for none", walkEvery);
+  cmd.AddValue ("matrix", "use a propagation matrix", matrix);
+  cmd.Parse (argc, argv);
+
+  SystemWallClockMs time;
+  time.Start ();
+  NodeContainer nodes;
+  nodes.Create (nNodes);
+  uint32_t width = std::ceil (std::sqrt (nNodes));
+  MobilityHelper mobility;
+  mobility.SetPositionAllocator ("ns3::GridPositionAllocator",
+                                 "DeltaX", DoubleValue (spacing),
+                                 "DeltaY", DoubleValue (spacing),
+                                 "GridWidth", UintegerValue (width));
+  mobility.SetMobilityModel ("ns3::RandomWalk2dMobilityModel",
+                             "Bounds", RectangleValue (Rectangle (0, width * spacing, 0, width * spacing)),
+                             "Time", TimeValue (Seconds (2)),
+                             "Speed", StringValue ("ns3::ConstantRandomVariable[Constant=10]"));
+  NodeContainer walkers;
+  NodeContainer fixed;
+  for (uint32_t i = 0; i < nNodes; i++)
+    {
+      if (walkEvery != 0 && i % walkEvery == 0)
+        {
+          walkers.Add (nodes.Get (i));
+        }
+      else
+        {
+          fixed.Add (nodes.Get (i));
+        }
+    }
+  mobility.Install (walkers);
+  mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+  mobility.Install (fixed);
+
+  YansWifiChannelHelper channelHelper = YansWifiChannelHelper::Default ();
+  Ptr<YansWifiChannel> channel = channelHelper.Create ();
+  channel->SetAttribute ("MaxRange", DoubleValue (maxRange));
+  channel->SetAttribute ("PropagationMatrix", BooleanValue (matrix));
+  YansWifiPhyHelper phy = YansWifiPhyHelper::Default ();
+  phy.SetChannel (channel);
+  NqosWifiMacHelper mac = NqosWifiMacHelper::Default ();
+  mac.SetType ("ns3::AdhocWifiMac");
+  WifiHelper wifi;
+  wifi.SetStandard (WIFI_PHY_STANDARD_80211a);
+  wifi.SetRemoteStationManager ("ns3::ConstantRateWifiManager", "DataMode", StringValue ("OfdmRate6Mbps"));
+  NetDeviceContainer devices = wifi.Install (phy, mac, nodes);
+  wifi.AssignStreams (devices, 1);
+
+  uint64_t received = 0;
+  Ptr<UniformRandomVariable> start = CreateObject<UniformRandomVariable> ();
+  for (uint32_t i = 0; i < nNodes; i++)
+    {
+      Ptr<WifiNetDevice> dev = DynamicCast<WifiNetDevice> (devices.Get (i));
+      dev->GetPhy ()->TraceConnectWithoutContext ("PhyRxEnd", MakeBoundCallback (&CountRx, &received));
+      for (uint32_t k = 0; k < nPackets; k++)
+        {
+          Simulator::Schedule (Seconds (k + start->GetValue ()), &SendOnePacket, devices.Get (i));
+        }
+    }
+  uint64_t setupMs = time.End ();
+
+  time.Start ();
+  Simulator::Stop (Seconds (nPackets + 1));
+  Simulator::Run ();
+  uint64_t runMs = time.End ();
+
+  std::cout << nNodes << " nodes, " << nNodes * nPackets << " packets sent, "
+            << received << " received, max range " << maxRange << " m, "
+            << walkers.GetN () << " walking, matrix " << (matrix ? "on" : "off") << ": "
+            << "setup " << setupMs << " ms, run " << runMs << " ms" << std::endl;
+
+  Simulator::Destroy ();
+  return 0;
+}
@@ -0,0 +1,129 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/*
+ * Measure the layer 2 handoffs of wifi stations walking along a corridor
+ * of APs sharing an SSID and a channel, with and without the AP candidate
+ * cache of StaWifiMac. The latency of a handoff runs from the loss of the
+ * old AP (its last beacon, or the decision to roam) to the association
+ * with the new one.
+ */
+
+#include <iostream>
+#include <algorithm>
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/mobility-module.h"
+#include "ns3/wifi-module.h"
+
+using namespace ns3;
+
+/// The number of handoffs.
+static uint32_t g_handoffs = 0;
+/// The sum of their latencies.
+static Time g_totalLatency;
+/// The largest latency.
+static Time g_maxLatency;
+
+/**
+ * \param [in] oldBssid The AP left.
+ * \param [in] newBssid The AP joined.
+ * \param [in] latency The latency of the handoff.
+ */
+static void
+Handoff (Mac48Address oldBssid, Mac48Address newBssid, Time latency)
+{
+  g_handoffs++;
+  g_totalLatency += latency;
+  g_maxLatency = std::max (g_maxLatency, latency);
+}
+
+int main (int argc, char *argv[])
+{
+  uint32_t nAps = 5;
+  uint32_t nStas = 10;
+  double spacing = 100;
+  double speed = 20;
+  bool cache = false;
+
+  CommandLine cmd;
+  cmd.Usage ("Benchmark the layer 2 handoffs of wifi stations walking along a corridor of APs.");
+  cmd.AddValue ("aps", "number of APs", nAps);
+  cmd.AddValue ("stas", "number of stations", nStas);
+  cmd.AddValue ("spacing", "distance between the APs, in meters", spacing);
+  cmd.AddValue ("speed", "speed of the stations, in m/s", speed);
+  cmd.AddValue ("cache", "enable the AP candidate cache of the stations", cache);
+  cmd.Parse (argc, argv);
+
+  NodeContainer aps;
+  aps.Create (nAps);
+  NodeContainer stas;
+  stas.Create (nStas);
+
+  MobilityHelper mobility;
+  Ptr<ListPositionAllocator> positions = CreateObject<ListPositionAllocator> ();
+  for (uint32_t i = 0; i < nAps; i++)
+    {
+      positions->Add (Vector (spacing * i, 0.0, 0.0));
+    }
+  mobility.SetPositionAllocator (positions);
+  mobility.Install (aps);
+  mobility.SetMobilityModel ("ns3::ConstantVelocityMobilityModel");
+  mobility.Install (stas);
+  for (uint32_t i = 0; i < nStas; i++)
+    {
+      // side by side, from the first AP to the last one
+      Ptr<ConstantVelocityMobilityModel> model = stas.Get (i)->GetObject<ConstantVelocityMobilityModel> ();
+      model->SetPosition (Vector (0.0, 2.0 * i, 0.0));
+      model->SetVelocity (Vector (speed, 0.0, 0.0));
+    }
+
+  YansWifiChannelHelper channel = YansWifiChannelHelper::Default ();
+  YansWifiPhyHelper phy = YansWifiPhyHelper::Default ();
+  phy.SetChannel (channel.Create ());
+  WifiHelper wifi;
+  wifi.SetStandard (WIFI_PHY_STANDARD_80211a);
+  wifi.SetRemoteStationManager ("ns3::ConstantRateWifiManager", "DataMode", StringValue ("OfdmRate6Mbps"));
+  WifiMacHelper mac;
+  Ssid ssid = Ssid ("corridor");
+  // without jitter, the beacons of the APs would always collide
+  mac.SetType ("ns3::ApWifiMac",
+               "Ssid", SsidValue (ssid),
+               "EnableBeaconJitter", BooleanValue (true));
+  wifi.Install (phy, mac, aps);
+  mac.SetType ("ns3::StaWifiMac",
+               "Ssid", SsidValue (ssid),
+               "CandidateCache", BooleanValue (cache));
+  wifi.Install (phy, mac, stas);
+
+  Config::ConnectWithoutContext ("/NodeList/*/DeviceList/*/$ns3::WifiNetDevice/Mac/$ns3::StaWifiMac/Handoff",
+                                 MakeCallback (&Handoff));
+
+  SystemWallClockMs clock;
+  clock.Start ();
+  Simulator::Stop (Seconds (spacing * (nAps - 1) / speed));
+  Simulator::Run ();
+  uint64_t ms = clock.End ();
+
+  std::cout << nStas << " stations, " << nAps << " APs" << (cache ? " with the candidate cache" : "") << ": "
+            << g_handoffs << " handoffs, latency mean "
+            << (g_handoffs ? g_totalLatency.GetSeconds () * 1000 / g_handoffs : 0) << " ms, max "
+            << g_maxLatency.GetSeconds () * 1000 << " ms, simulated in " << ms << " ms" << std::endl;
+
+  Simulator::Destroy ();
+  return 0;
+}
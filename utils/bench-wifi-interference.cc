@@ -0,0 +1,238 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/*
+ * Measure the packet error rate evaluations of the InterferenceHelper
+ * of a wifi receiver hearing many stations: each station sends 802.11a
+ * frames of random size and rate at Poisson times, and the receiver
+ * locks on the frames arriving while it is idle, evaluating the PER of
+ * their PLCP header and of their payload as YansWifiPhy does. The
+ * chunk success rates of the error rate model are then measured alone.
+ */
+
+#include <iostream>
+#include <stdlib.h> // for exit ()
+
+#include "ns3/core-module.h"
+#include "ns3/wifi-module.h"
+#include "ns3/interference-helper.h"
+
+using namespace ns3;
+
+/**
+ * A receiver and the stations it hears.
+ */
+class InterferenceBench
+{
+public:
+  /**
+   * \param [in] stations The number of stations.
+   * \param [in] rate The frames sent by each station per second.
+   * \param [in] error The error rate model.
+   */
+  InterferenceBench (uint32_t stations, double rate, Ptr<ErrorRateModel> error);
+  /**
+   * \returns The number of PER evaluations.
+   */
+  uint64_t GetEvaluations (void) const;
+  /**
+   * \returns The number of frames received without error.
+   */
+  uint64_t GetReceived (void) const;
+
+private:
+  /**
+   * A station sends a frame.
+   * \param [in] station The station.
+   */
+  void Send (uint32_t station);
+  /**
+   * The PLCP header of the frame being received ends.
+   * \param [in] event The frame.
+   */
+  void EndHeader (Ptr<InterferenceHelper::Event> event);
+  /**
+   * The frame being received ends.
+   * \param [in] event The frame.
+   */
+  void EndReceive (Ptr<InterferenceHelper::Event> event);
+
+  InterferenceHelper m_interference;        //!< The interference helper of the receiver.
+  Ptr<YansWifiPhy> m_phy;                   //!< A PHY, for the frame durations.
+  std::vector<double> m_rxPowerW;           //!< The power received from each station.
+  std::vector<WifiMode> m_modes;            //!< The modes of the frames.
+  Ptr<ExponentialRandomVariable> m_interval; //!< The interval between the frames of a station.
+  Ptr<UniformRandomVariable> m_random;      //!< The size and mode of the frames, and the errors.
+  bool m_receiving;                         //!< Whether a frame is being received.
+  bool m_headerOk;                          //!< Whether its header was received.
+  uint64_t m_evaluations;                   //!< The number of PER evaluations.
+  uint64_t m_received;                      //!< The number of frames received.
+};
+
+InterferenceBench::InterferenceBench (uint32_t stations, double rate, Ptr<ErrorRateModel> error)
+  : m_receiving (false),
+    m_headerOk (false),
+    m_evaluations (0),
+    m_received (0)
+{
+  m_interference.SetNoiseFigure (std::pow (10.0, 7.0 / 10.0));
+  m_interference.SetErrorRateModel (error);
+  m_phy = CreateObject<YansWifiPhy> ();
+  m_phy->ConfigureStandard (WIFI_PHY_STANDARD_80211a);
+  for (uint32_t i = 0; i < m_phy->GetNModes (); i++)
+    {
+      m_modes.push_back (m_phy->GetMode (i));
+    }
+  m_interval = CreateObject<ExponentialRandomVariable> ();
+  m_interval->SetAttribute ("Mean", DoubleValue (1 / rate));
+  m_random = CreateObject<UniformRandomVariable> ();
+  for (uint32_t i = 0; i < stations; i++)
+    {
+      // between -95 and -60 dBm
+      m_rxPowerW.push_back (std::pow (10.0, (m_random->GetValue (-95, -60) - 30) / 10.0));
+      Simulator::Schedule (Seconds (m_interval->GetValue ()), &InterferenceBench::Send, this, i);
+    }
+}
+
+uint64_t
+InterferenceBench::GetEvaluations (void) const
+{
+  return m_evaluations;
+}
+
+uint64_t
+InterferenceBench::GetReceived (void) const
+{
+  return m_received;
+}
+
+void
+InterferenceBench::Send (uint32_t station)
+{
+  WifiTxVector txVector;
+  txVector.SetMode (m_modes[m_random->GetInteger (0, m_modes.size () - 1)]);
+  txVector.SetChannelWidth (20);
+  txVector.SetNss (1);
+  uint32_t size = m_random->GetInteger (100, 1500);
+  Time duration = m_phy->CalculateTxDuration (size, txVector, WIFI_PREAMBLE_LONG, 5180);
+  Ptr<InterferenceHelper::Event> event = m_interference.Add (size, txVector, WIFI_PREAMBLE_LONG,
+                                                             duration, m_rxPowerW[station]);
+  if (!m_receiving)
+    {
+      m_receiving = true;
+      m_interference.NotifyRxStart ();
+      Simulator::Schedule (m_phy->CalculatePlcpPreambleAndHeaderDuration (txVector, WIFI_PREAMBLE_LONG),
+                           &InterferenceBench::EndHeader, this, event);
+      Simulator::Schedule (duration, &InterferenceBench::EndReceive, this, event);
+    }
+  Simulator::Schedule (Seconds (m_interval->GetValue ()), &InterferenceBench::Send, this, station);
+}
+
+void
+InterferenceBench::EndHeader (Ptr<InterferenceHelper::Event> event)
+{
+  struct InterferenceHelper::SnrPer snrPer = m_interference.CalculatePlcpHeaderSnrPer (event);
+  m_evaluations++;
+  m_headerOk = m_random->GetValue () > snrPer.per;
+}
+
+void
+InterferenceBench::EndReceive (Ptr<InterferenceHelper::Event> event)
+{
+  struct InterferenceHelper::SnrPer snrPer = m_interference.CalculatePlcpPayloadSnrPer (event);
+  m_evaluations++;
+  m_interference.NotifyRxEnd ();
+  m_receiving = false;
+  if (m_headerOk && m_random->GetValue () > snrPer.per)
+    {
+      m_received++;
+    }
+}
+
+int main (int argc, char *argv[])
+{
+  uint32_t stations = 50;
+  double rate = 50;
+  double time = 20;
+  std::string model = "nist";
+  bool lookup = false;
+  uint32_t calls = 1000000;
+
+  CommandLine cmd;
+  cmd.Usage ("Benchmark the PER evaluations of the wifi InterferenceHelper.");
+  cmd.AddValue ("stations", "number of stations heard by the receiver", stations);
+  cmd.AddValue ("rate", "frames sent by each station per second", rate);
+  cmd.AddValue ("time", "simulated time, in seconds", time);
+  cmd.AddValue ("model", "error rate model: nist or yans", model);
+  cmd.AddValue ("lookup", "interpolate the chunk success rates in tables", lookup);
+  cmd.AddValue ("calls", "chunk success rates computed after the simulation", calls);
+  cmd.Parse (argc, argv);
+
+  Ptr<ErrorRateModel> error;
+  if (model == "nist")
+    {
+      error = CreateObject<NistErrorRateModel> ();
+    }
+  else if (model == "yans")
+    {
+      error = CreateObject<YansErrorRateModel> ();
+    }
+  else
+    {
+      std::cerr << "Error-- unknown error rate model " << model << std::endl;
+      exit (1);
+    }
+  error->SetAttribute ("UseLookupTable", BooleanValue (lookup));
+
+  InterferenceBench bench (stations, rate, error);
+  SystemWallClockMs clock;
+  clock.Start ();
+  Simulator::Stop (Seconds (time));
+  Simulator::Run ();
+  uint64_t ms = clock.End ();
+
+  std::cout << stations << " stations, " << model << (lookup ? " with tables" : "") << ": "
+            << bench.GetEvaluations () << " PER evaluations, "
+            << bench.GetReceived () << " frames received in " << ms << " ms, "
+            << bench.GetEvaluations () * 1000.0 / std::max<uint64_t> (ms, 1) << " evaluations per second"
+            << std::endl;
+
+  // the chunk success rates alone, from -5 to 35 dB
+  std::vector<WifiMode> modes;
+  Ptr<YansWifiPhy> phy = CreateObject<YansWifiPhy> ();
+  phy->ConfigureStandard (WIFI_PHY_STANDARD_80211a);
+  for (uint32_t i = 0; i < phy->GetNModes (); i++)
+    {
+      modes.push_back (phy->GetMode (i));
+    }
+  WifiTxVector txVector;
+  txVector.SetChannelWidth (20);
+  txVector.SetNss (1);
+  double sum = 0;
+  clock.Start ();
+  for (uint32_t i = 0; i < calls; i++)
+    {
+      txVector.SetMode (modes[i % modes.size ()]);
+      double snr = std::pow (10.0, (-5.0 + 40.0 * (i % 4001) / 4000) / 10.0);
+      sum += error->GetChunkSuccessRate (modes[i % modes.size ()], txVector, snr, 1000);
+    }
+  ms = clock.End ();
+  std::cout << calls << " chunk success rates in " << ms << " ms (mean " << sum / std::max<uint32_t> (calls, 1) << ")"
+            << std::endl;
+
+  Simulator::Destroy ();
+  return 0;
+}
@@ -0,0 +1,146 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/*
+ * Measure the throughput of the simple OFDM WiMAX PHY: a base station
+ * sends a saturating UDP flow down to each subscriber station, and the
+ * bursts received by all the PHYs are counted against the wall-clock
+ * time of the simulation. With a propagation matrix, the channel
+ * computes the loss and delay between the stations once.
+ */
+
+#include <iostream>
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/internet-module.h"
+#include "ns3/applications-module.h"
+#include "ns3/mobility-module.h"
+#include "ns3/wimax-module.h"
+
+using namespace ns3;
+
+/// The number of bursts received by the PHYs.
+static uint64_t g_bursts = 0;
+/// The number of bytes received by the PHYs.
+static uint64_t g_bytes = 0;
+
+/**
+ * \param [in] burst A burst received by a PHY.
+ */
+static void
+PhyRx (Ptr<const PacketBurst> burst)
+{
+  g_bursts++;
+  g_bytes += burst->GetSize ();
+}
+
+int main (int argc, char *argv[])
+{
+  uint32_t nSs = 10;
+  double duration = 10;
+  uint32_t packetSize = 1024;
+  bool loss = true;
+  bool matrix = false;
+
+  CommandLine cmd;
+  cmd.Usage ("Benchmark the simple OFDM WiMAX PHY.");
+  cmd.AddValue ("ss", "number of subscriber stations", nSs);
+  cmd.AddValue ("duration", "simulated time, in seconds", duration);
+  cmd.AddValue ("size", "size of the UDP packets", packetSize);
+  cmd.AddValue ("loss", "whether the PHYs draw block errors", loss);
+  cmd.AddValue ("matrix", "use a propagation matrix", matrix);
+  cmd.Parse (argc, argv);
+
+  Config::SetDefault ("ns3::SimpleOfdmWimaxChannel::PropagationMatrix", BooleanValue (matrix));
+
+  NodeContainer ssNodes;
+  NodeContainer bsNodes;
+  ssNodes.Create (nSs);
+  bsNodes.Create (1);
+
+  MobilityHelper mobility;
+  mobility.SetPositionAllocator ("ns3::GridPositionAllocator",
+                                 "MinX", DoubleValue (-500.0),
+                                 "DeltaX", DoubleValue (100.0),
+                                 "DeltaY", DoubleValue (100.0),
+                                 "GridWidth", UintegerValue (10));
+  mobility.Install (ssNodes);
+  mobility.SetPositionAllocator ("ns3::GridPositionAllocator",
+                                 "MinY", DoubleValue (-100.0));
+  mobility.Install (bsNodes);
+
+  WimaxHelper wimax;
+  NetDeviceContainer ssDevs = wimax.Install (ssNodes, WimaxHelper::DEVICE_TYPE_SUBSCRIBER_STATION,
+                                             WimaxHelper::SIMPLE_PHY_TYPE_OFDM, WimaxHelper::SCHED_TYPE_SIMPLE);
+  NetDeviceContainer bsDevs = wimax.Install (bsNodes, WimaxHelper::DEVICE_TYPE_BASE_STATION,
+                                             WimaxHelper::SIMPLE_PHY_TYPE_OFDM, WimaxHelper::SCHED_TYPE_SIMPLE);
+  NetDeviceContainer devs (ssDevs, bsDevs);
+  for (uint32_t i = 0; i < devs.GetN (); i++)
+    {
+      Ptr<WimaxPhy> phy = devs.Get (i)->GetObject<WimaxNetDevice> ()->GetPhy ();
+      phy->GetObject<SimpleOfdmWimaxPhy> ()->ActivateLoss (loss);
+      phy->TraceConnectWithoutContext ("Rx", MakeCallback (&PhyRx));
+    }
+
+  InternetStackHelper stack;
+  stack.Install (bsNodes);
+  stack.Install (ssNodes);
+  Ipv4AddressHelper address;
+  address.SetBase ("10.1.0.0", "255.255.0.0");
+  Ipv4InterfaceContainer ssInterfaces = address.Assign (ssDevs);
+  address.Assign (bsDevs);
+
+  UdpServerHelper server (100);
+  ApplicationContainer serverApps = server.Install (ssNodes);
+  serverApps.Start (Seconds (1));
+  for (uint32_t i = 0; i < nSs; i++)
+    {
+      UdpClientHelper client (ssInterfaces.GetAddress (i), 100);
+      client.SetAttribute ("MaxPackets", UintegerValue (0xffffffff));
+      client.SetAttribute ("Interval", TimeValue (MilliSeconds (1)));
+      client.SetAttribute ("PacketSize", UintegerValue (packetSize));
+      ApplicationContainer clientApps = client.Install (bsNodes.Get (0));
+      clientApps.Start (Seconds (1));
+
+      IpcsClassifierRecord classifier (Ipv4Address ("0.0.0.0"), Ipv4Mask ("0.0.0.0"),
+                                       ssInterfaces.GetAddress (i), Ipv4Mask ("255.255.255.255"),
+                                       0, 65000, 100, 100, 17, 1);
+      ServiceFlow flow = wimax.CreateServiceFlow (ServiceFlow::SF_DIRECTION_DOWN,
+                                                  ServiceFlow::SF_TYPE_BE, classifier);
+      ssDevs.Get (i)->GetObject<SubscriberStationNetDevice> ()->AddServiceFlow (flow);
+    }
+
+  Simulator::Stop (Seconds (duration));
+  SystemWallClockMs time;
+  time.Start ();
+  Simulator::Run ();
+  uint64_t ms = time.End ();
+
+  uint64_t received = 0;
+  for (uint32_t i = 0; i < nSs; i++)
+    {
+      received += DynamicCast<UdpServer> (serverApps.Get (i))->GetReceived ();
+    }
+  double seconds = ms / 1000.0;
+  std::cout << nSs << " subscriber stations, matrix " << (matrix ? "on" : "off") << ", " << duration << " s simulated in " << ms << " ms: "
+            << g_bursts << " bursts (" << g_bursts / seconds << " per second), "
+            << g_bytes * 8 / seconds / 1e6 << " Mbit of bursts per second, "
+            << received << " UDP packets received" << std::endl;
+
+  Simulator::Destroy ();
+  return 0;
+}
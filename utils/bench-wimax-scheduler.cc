@@ -0,0 +1,193 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/*
+ * Measure the schedulers of a WiMAX base station serving many subscriber
+ * stations. The stations are registered in the managers of the base
+ * station directly, without ranging nor PHYs of their own: station i has
+ * a downlink and an uplink service flow of the scheduling type i % 4
+ * (UGS, rtPS, nrtPS, BE). Every frame, packets are queued on some random
+ * downlink flows and bandwidth is requested on some random uplink flows,
+ * and the base station runs its downlink and uplink schedulers.
+ */
+
+#include <iostream>
+#include <stdlib.h> // for exit ()
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/wimax-module.h"
+#include "ns3/bs-net-device.h"
+#include "ns3/ss-manager.h"
+#include "ns3/ss-record.h"
+#include "ns3/connection-manager.h"
+#include "ns3/bs-service-flow-manager.h"
+#include "ns3/bs-uplink-scheduler.h"
+#include "ns3/service-flow-record.h"
+#include "ns3/mac-messages.h"
+
+using namespace ns3;
+
+/// The base station.
+static Ptr<BaseStationNetDevice> g_bs;
+/// The downlink connections of the stations.
+static std::vector<Ptr<WimaxConnection> > g_downlink;
+/// The uplink connections of the stations.
+static std::vector<Ptr<WimaxConnection> > g_uplink;
+/// The number of packets queued.
+static uint64_t g_queued = 0;
+
+/**
+ * \brief Register a subscriber station and its service flows.
+ * \param [in] index The index of the station.
+ */
+static void
+AddStation (uint32_t index)
+{
+  static uint32_t sfid = 100;
+  SSRecord *ssRecord = g_bs->GetSSManager ()->CreateSSRecord (Mac48Address::Allocate ());
+  RngRsp rngrsp;
+  g_bs->GetConnectionManager ()->AllocateManagementConnections (ssRecord, &rngrsp);
+  ssRecord->SetModulationType (WimaxPhy::MODULATION_TYPE_QAM16_12);
+  ssRecord->SetRangingStatus (WimaxNetDevice::RANGING_STATUS_SUCCESS);
+
+  ServiceFlow::SchedulingType types[] = { ServiceFlow::SF_TYPE_UGS, ServiceFlow::SF_TYPE_RTPS,
+                                          ServiceFlow::SF_TYPE_NRTPS, ServiceFlow::SF_TYPE_BE };
+  ServiceFlow::Direction directions[] = { ServiceFlow::SF_DIRECTION_DOWN, ServiceFlow::SF_DIRECTION_UP };
+  for (uint32_t d = 0; d < 2; d++)
+    {
+      Ptr<WimaxConnection> connection = g_bs->GetConnectionManager ()->CreateConnection (Cid::TRANSPORT);
+      ServiceFlow *serviceFlow = new ServiceFlow (sfid++, directions[d], connection);
+      connection->SetServiceFlow (serviceFlow);
+      serviceFlow->SetServiceSchedulingType (types[index % 4]);
+      serviceFlow->SetMaxSustainedTrafficRate (100000);
+      serviceFlow->SetMinReservedTrafficRate (64000);
+      serviceFlow->SetMaximumLatency (20);
+      serviceFlow->SetToleratedJitter (10);
+      serviceFlow->SetIsEnabled (true);
+      serviceFlow->SetType (ServiceFlow::SF_TYPE_ACTIVE);
+      g_bs->GetServiceFlowManager ()->AddServiceFlow (serviceFlow);
+      ssRecord->AddServiceFlow (serviceFlow);
+      g_bs->GetUplinkScheduler ()->SetupServiceFlow (ssRecord, serviceFlow);
+      (d == 0 ? g_downlink : g_uplink).push_back (connection);
+    }
+  ssRecord->SetAreServiceFlowsAllocated (true);
+}
+
+/**
+ * \brief Queue packets on random downlink flows and request bandwidth on
+ * random uplink flows, every frame.
+ * \param [in] random The random stream.
+ * \param [in] active The number of flows of each direction given traffic.
+ * \param [in] size The size of the packets and of the requests.
+ */
+static void
+Offer (Ptr<UniformRandomVariable> random, uint32_t active, uint32_t size)
+{
+  for (uint32_t i = 0; i < active; i++)
+    {
+      Ptr<WimaxConnection> connection = g_downlink[random->GetInteger (0, g_downlink.size () - 1)];
+      if (g_bs->Enqueue (Create<Packet> (size), MacHeaderType (), connection))
+        {
+          g_queued++;
+        }
+      connection = g_uplink[random->GetInteger (0, g_uplink.size () - 1)];
+      // as the bandwidth manager of the base station receiving a request
+      BandwidthRequestHeader request;
+      request.SetType ((uint8_t) BandwidthRequestHeader::HEADER_TYPE_AGGREGATE);
+      request.SetCid (connection->GetCid ());
+      request.SetBr (size);
+      ServiceFlowRecord *record = connection->GetServiceFlow ()->GetRecord ();
+      record->SetRequestedBandwidth (size);
+      g_bs->GetUplinkScheduler ()->OnSetRequestedBandwidth (record);
+      g_bs->GetUplinkScheduler ()->ProcessBandwidthRequest (request);
+      record->IncreaseBacklogged (size);
+    }
+  Simulator::Schedule (g_bs->GetPhy ()->GetFrameDuration (), &Offer, random, active, size);
+}
+
+int main (int argc, char *argv[])
+{
+  uint32_t nSs = 100;
+  uint32_t active = 20;
+  uint32_t size = 200;
+  uint32_t frames = 200;
+  std::string scheduler = "simple";
+
+  CommandLine cmd;
+  cmd.Usage ("Benchmark the schedulers of a WiMAX base station.");
+  cmd.AddValue ("ss", "number of subscriber stations", nSs);
+  cmd.AddValue ("active", "number of flows of each direction given traffic every frame", active);
+  cmd.AddValue ("size", "size of the packets and of the bandwidth requests", size);
+  cmd.AddValue ("frames", "number of frames", frames);
+  cmd.AddValue ("scheduler", "simple, rtps or mbqos", scheduler);
+  cmd.Parse (argc, argv);
+
+  WimaxHelper::SchedulerType type;
+  if (scheduler == "simple")
+    {
+      type = WimaxHelper::SCHED_TYPE_SIMPLE;
+    }
+  else if (scheduler == "rtps")
+    {
+      type = WimaxHelper::SCHED_TYPE_RTPS;
+    }
+  else if (scheduler == "mbqos")
+    {
+      type = WimaxHelper::SCHED_TYPE_MBQOS;
+    }
+  else
+    {
+      std::cerr << "Error-- unknown scheduler " << scheduler << std::endl;
+      exit (1);
+    }
+
+  NodeContainer bsNodes;
+  bsNodes.Create (1);
+  WimaxHelper wimax;
+  NetDeviceContainer bsDevs = wimax.Install (bsNodes, WimaxHelper::DEVICE_TYPE_BASE_STATION,
+                                             WimaxHelper::SIMPLE_PHY_TYPE_OFDM, type);
+  g_bs = bsDevs.Get (0)->GetObject<BaseStationNetDevice> ();
+  // the stations register once the first frame has described the burst
+  // profiles
+  for (uint32_t i = 0; i < nSs; i++)
+    {
+      Simulator::Schedule (MicroSeconds (1), &AddStation, i);
+    }
+
+  Ptr<UniformRandomVariable> random = CreateObject<UniformRandomVariable> ();
+  Simulator::Schedule (MicroSeconds (1), &Offer, random, active, size);
+  Simulator::Stop (g_bs->GetPhy ()->GetFrameDuration () * frames);
+  SystemWallClockMs time;
+  time.Start ();
+  Simulator::Run ();
+  uint64_t ms = time.End ();
+
+  uint64_t left = 0;
+  for (uint32_t i = 0; i < g_downlink.size (); i++)
+    {
+      left += g_downlink[i]->GetQueue ()->GetSize ();
+    }
+  std::cout << scheduler << ": " << nSs << " subscriber stations, " << g_bs->GetNrFrames () << " frames in "
+            << ms << " ms (" << 1000.0 * ms / g_bs->GetNrFrames () << " us per frame): "
+            << g_queued << " packets queued, " << g_queued - left << " sent" << std::endl;
+
+  g_downlink.clear ();
+  g_uplink.clear ();
+  g_bs = 0;
+  Simulator::Destroy ();
+  return 0;
+}
@@ -0,0 +1,96 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/*
+ * Measure the SNR to block error rate tables of the simple OFDM WiMAX
+ * PHY: the time and resident memory taken by creating the PHYs of many
+ * subscriber stations, each one loading the tables, and the time of a
+ * lookup.
+ */
+
+#include <iostream>
+#include <fstream>
+#include <unistd.h>
+
+#include "ns3/core-module.h"
+#include "ns3/wimax-module.h"
+
+using namespace ns3;
+
+/**
+ * \returns The resident memory of the process, in kilobytes, or 0 if unknown.
+ */
+static uint64_t
+GetResidentKb (void)
+{
+  std::ifstream statm ("/proc/self/statm");
+  uint64_t size = 0;
+  uint64_t resident = 0;
+  if (!(statm >> size >> resident))
+    {
+      return 0;
+    }
+  return resident * sysconf (_SC_PAGESIZE) / 1024;
+}
+
+int main (int argc, char *argv[])
+{
+  uint32_t nPhys = 10000;
+  uint32_t lookups = 1000000;
+
+  CommandLine cmd;
+  cmd.Usage ("Benchmark the SNR to block error rate tables of the WiMAX PHY.");
+  cmd.AddValue ("phys", "number of PHYs created", nPhys);
+  cmd.AddValue ("lookups", "number of lookups", lookups);
+  cmd.Parse (argc, argv);
+
+  std::vector<Ptr<SimpleOfdmWimaxPhy> > phys;
+  phys.reserve (nPhys);
+  uint64_t residentKb = GetResidentKb ();
+  SystemWallClockMs time;
+  time.Start ();
+  for (uint32_t i = 0; i < nPhys; i++)
+    {
+      phys.push_back (CreateObject<SimpleOfdmWimaxPhy> ());
+    }
+  uint64_t createMs = time.End ();
+  uint64_t phyKb = GetResidentKb () - residentKb;
+
+  SNRToBlockErrorRateManager manager;
+  manager.LoadTraces ();
+  double sum = 0;
+  time.Start ();
+  for (uint32_t i = 0; i < lookups; i++)
+    {
+      // SNRs from -5 to 40 dB, below, inside and above the tables
+      double snr = -5.0 + (i % 4500) * 0.01;
+      SNRToBlockErrorRateRecord record = manager.GetRecord (snr, i % 7);
+      sum += record.GetI1 () + record.GetI2 ();
+    }
+  uint64_t lookupMs = time.End ();
+
+  std::cout << nPhys << " PHYs: created in " << createMs << " ms, "
+            << phyKb << " kB resident (" << phyKb * 1024.0 / nPhys << " bytes per PHY); "
+            << lookups << " lookups in " << lookupMs << " ms"
+            << " (checksum " << sum << ")" << std::endl;
+
+  for (uint32_t i = 0; i < nPhys; i++)
+    {
+      phys[i]->Dispose ();
+    }
+  Simulator::Destroy ();
+  return 0;
+}